@@ -126,6 +126,8 @@ PublicDependencyModuleNames.AddRange(new string[]
                 "MeshUtilities", "MaterialUtilities", "PhysicsCore", "ClothingSystemRuntimeCommon",
                 // Phase 6: Geometry Script (GeometryScripting plugin dependency in .uplugin ensures availability)
                 "GeometryCore", "GeometryScriptingCore", "GeometryScriptingEditor", "GeometryFramework", "DynamicMesh", "MeshDescription", "StaticMeshDescription",
+                // Skin weight transfer / auto-skinning operates on the skeletal mesh description
+                "SkeletalMeshDescription", "AnimationCore",
                 // Phase 24: Navigation volumes
                 "NavigationSystem"
             });
@@ -8,6 +8,7 @@
 #include "Dom/JsonObject.h"
 #include "HAL/PlatformTime.h"
 #include "JsonObjectConverter.h"
+#include "McpReflectionIndex.h"
 #include "Misc/FileHelper.h"
 #include "Misc/OutputDevice.h"
 #include "Misc/Paths.h"
@@ -184,6 +185,21 @@
 #include "Editor/EditorAssetLibrary.h"
 #endif
 #include "Engine/Blueprint.h"
+
+/**
+ * Asset registry accessor usable from the worker-dispatched read handlers.
+ * LoadModuleChecked is game-thread only; off the game thread the module is
+ * already loaded (the worker path requires it) so a plain lookup is enough.
+ */
+static inline IAssetRegistry &McpGetAssetRegistry() {
+  if (IsInGameThread()) {
+    return FModuleManager::LoadModuleChecked<FAssetRegistryModule>(
+               "AssetRegistry")
+        .Get();
+  }
+  return FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry")
+      .Get();
+}
 #endif
 
 /**
@@ -623,10 +639,10 @@ static inline bool McpSafeAssetSave(UObject* Asset)
 #endif
 
 #if WITH_EDITOR
-// Resolve a UClass by a variety of heuristics: try full path lookup, attempt
-// to load an asset by path (UBlueprint or UClass), then fall back to scanning
-// loaded classes by name or path suffix. This replaces previous usages of
-// FindObject<...>(ANY_PACKAGE, ...) which is deprecated.
+// Resolve a UClass by a variety of heuristics: attempt to load an asset by
+// path (UBlueprint or UClass), then look the name up in FMcpReflectionIndex
+// (full path, short name, "Package.Name" or C++ prefixed name). This replaces
+// previous usages of FindObject<...>(ANY_PACKAGE, ...) which is deprecated.
 static inline UClass *ResolveClassByName(const FString &ClassNameOrPath) {
   if (ClassNameOrPath.IsEmpty())
     return nullptr;
@@ -649,64 +665,9 @@ static inline UClass *ResolveClassByName(const FString &ClassNameOrPath) {
     }
   }
 
-  // 2) Try a direct FindObject using nullptr/explicit outer (expects full path)
-  if (UClass *Direct = FindObject<UClass>(nullptr, *ClassNameOrPath))
-    return Direct;
-
-  // 2.5) Try guessing generic engine locations for common components (e.g.
-  // StaticMeshComponent -> /Script/Engine.StaticMeshComponent) This helps when
-  // the class has not been loaded yet so TObjectIterator won't find it.
-  if (!ClassNameOrPath.Contains(TEXT("/")) &&
-      !ClassNameOrPath.Contains(TEXT("."))) {
-    FString EnginePath =
-        FString::Printf(TEXT("/Script/Engine.%s"), *ClassNameOrPath);
-    if (UClass *EngineClass = FindObject<UClass>(nullptr, *EnginePath))
-      return EngineClass;
-
-    // Attempt load for engine class (unlikely to need load for native, but just
-    // in case)
-    if (UClass *EngineClassLoaded = LoadObject<UClass>(nullptr, *EnginePath))
-      return EngineClassLoaded;
-
-    FString UMGPath = FString::Printf(TEXT("/Script/UMG.%s"), *ClassNameOrPath);
-    if (UClass *UMGClass = FindObject<UClass>(nullptr, *UMGPath))
-      return UMGClass;
-  }
-
-  // Special handling for common ambiguous types
-  if (ClassNameOrPath.Equals(TEXT("NiagaraComponent"),
-                             ESearchCase::IgnoreCase)) {
-    if (UClass *NiagaraComp = FindObject<UClass>(
-            nullptr, TEXT("/Script/Niagara.NiagaraComponent"))) {
-      return NiagaraComp;
-    }
-  }
-
-  // 3) Fallback: iterate loaded classes and match by short name or path suffix
-  UClass *BestMatch = nullptr;
-  for (TObjectIterator<UClass> It; It; ++It) {
-    UClass *C = *It;
-    if (!C)
-      continue;
-
-    // Exact short name match
-    if (C->GetName().Equals(ClassNameOrPath, ESearchCase::IgnoreCase)) {
-      // Prefer /Script/ (native) classes over others if multiple match
-      if (C->GetPathName().StartsWith(TEXT("/Script/")))
-        return C;
-      if (!BestMatch)
-        BestMatch = C;
-    }
-    // Match on ".ClassName" suffix (path-based short form)
-    else if (C->GetPathName().EndsWith(
-                 FString::Printf(TEXT(".%s"), *ClassNameOrPath),
-                 ESearchCase::IgnoreCase)) {
-      if (!BestMatch)
-        BestMatch = C;
-    }
-  }
-
-  return BestMatch;
+  // 2) Native and already-loaded classes by path, short name,
+  // "Package.Name" or C++ prefixed name, without walking every UClass.
+  return FMcpReflectionIndex::Get().FindClass(ClassNameOrPath);
 }
 #endif
 
@@ -2216,54 +2177,16 @@ static inline UClass *ResolveUClass(const FString &Input) {
   if (Input.IsEmpty())
     return nullptr;
 
-  // 1. Try finding it directly (full path or already loaded)
-  UClass *Found = FindObject<UClass>(nullptr, *Input);
-  if (Found)
-    return Found;
-
-  // 2. Try loading it directly
-  Found = LoadObject<UClass>(nullptr, *Input);
-  if (Found)
-    return Found;
-
-  // 3. Handle Blueprint Generated Classes explicitly
-  // parsing "MyBP" -> "/Game/MyBP.MyBP_C" logic is hard without path,
-  // but if input ends in _C, treat as class path.
-  if (Input.EndsWith(TEXT("_C"))) {
-    // Already tried loading, maybe it needs a package path fix?
-    // Assuming the user provided a full path if they included _C.
-    return nullptr;
-  }
-
-  // 4. Short name resolution
-  // Check common script packages
-  const TArray<FString> ScriptPackages = {TEXT("/Script/Engine"),
-                                          TEXT("/Script/CoreUObject"),
-                                          TEXT("/Script/UMG"),
-                                          TEXT("/Script/AIModule"),
-                                          TEXT("/Script/NavigationSystem"),
-                                          TEXT("/Script/Niagara")};
-
-  for (const FString &Pkg : ScriptPackages) {
-    FString TryPath = FString::Printf(TEXT("%s.%s"), *Pkg, *Input);
-    Found = FindObject<UClass>(nullptr, *TryPath);
-    if (Found)
-      return Found;
-    Found = LoadObject<UClass>(nullptr, *TryPath);
-    if (Found)
+  // 1. Full paths: already loaded, or load it (blueprint classes)
+  if (Input.StartsWith(TEXT("/"))) {
+    if (UClass *Found = FindObject<UClass>(nullptr, *Input))
       return Found;
+    return LoadObject<UClass>(nullptr, *Input);
   }
 
-  // 5. Native class search by iteration (slow fallback, but useful for obscure
-  // plugins)
-  // Only doing this for exact short name matches to avoid false positives
-  for (TObjectIterator<UClass> It; It; ++It) {
-    if (It->GetName() == Input) {
-      return *It;
-    }
-  }
-
-  return nullptr;
+  // 2. Short, package-qualified or C++ prefixed names of loaded classes.
+  // Native classes win, so "Actor" still means /Script/Engine.Actor.
+  return FMcpReflectionIndex::Get().FindClass(Input);
 }
 
 // Standardized Response Helpers
@@ -1,6 +1,7 @@
 #include "ISettingsModule.h"
 #include "ISettingsSection.h"
 #include "McpAutomationBridgeSettings.h"
+#include "McpBridgeBenchmark.h"
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
@@ -25,6 +26,9 @@ public:
     {
         UE_LOG(LogMcpAutomationBridge, Log, TEXT("MCP Automation Bridge module initialized."));
 
+        // Swapping GMalloc is only safe this early, before any run relies on it.
+        FMcpBridgeBenchmark::InstallAllocationCounter();
+
 #if WITH_EDITOR
         // UDeveloperSettings (UMcpAutomationBridgeSettings) are auto-registered with the
         // Project Settings UI. Do not manually register them via ISettingsModule as this
@@ -25,6 +25,13 @@ UMcpAutomationBridgeSettings::UMcpAutomationBridgeSettings()
     bAllowNonLoopback = false; // Security: default to loopback-only binding
     MaxMessagesPerMinute = 600;
     MaxAutomationRequestsPerMinute = 600;
+
+    // Session resumption and duplicate request replay
+    SessionResumeWindowSeconds = 300.0f;
+    ResponseReplayWindowSeconds = 300.0f;
+    MaxReplayResponsesPerSession = 64;
+    MaxReplayBufferMB = 16;
+
     bEnableTls = false;
     TlsCertificatePath = TEXT("");
     TlsPrivateKeyPath = TEXT("");
@@ -34,8 +41,30 @@ UMcpAutomationBridgeSettings::UMcpAutomationBridgeSettings()
     HeartbeatTimeoutSeconds = 10.0f; // drop connections after 10s without heartbeat
     ListenBacklog = 10; // typical listen backlog
     AcceptSleepSeconds = 0.01f; // brief sleepers to reduce CPU when idle
+    bUseSocketReactor = true; // one I/O thread per listener
+    MaxSendQueueKB = 8 * 1024; // 8 MB waiting per slow client
     TickerIntervalSeconds = 0.1f; // subsystem tick every 100ms
 
+    // Request scheduling: drain queued requests within ~half a 60 Hz frame
+    RequestDrainBudgetMs = 8.0f;
+    BulkRequestAgingSeconds = 2.0f;
+    BackgroundRequestAgingSeconds = 10.0f;
+    BulkTaskBudgetMs = 8.0f;
+    MaxConcurrentReadRequests = 4;
+    MaxConcurrentProcesses = 2;
+
+    // Metrics file export is opt-in
+    MetricsExportPath = TEXT("");
+    MetricsExportIntervalSeconds = 15.0f;
+
+    // Editor health sampler: 10 minutes at 4 Hz
+    PerfSampleIntervalSeconds = 0.25f;
+    PerfHistorySeconds = 600.0f;
+
+    // Undo: keep the editor's behaviour unless a project opts in
+    TransactionPolicy = EMcpTransactionPolicy::Full;
+    UndoBufferMaxMB = 0;
+
     // Default logging behavior
     LogVerbosity = EMcpLogVerbosity::Log;
     bApplyLogVerbosityToAll = false;
@@ -15,6 +15,12 @@
 #include "McpAutomationBridgeSettings.h"
 #include "McpBridgeWebSocket.h"
 #include "McpConnectionManager.h"
+#include "McpMaterialEditSession.h"
+#include "McpPerfSampler.h"
+#include "McpReflectionIndex.h"
+#include "McpRequestScheduler.h"
+#include "McpSceneQuery.h"
+#include "McpTransactionPolicy.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Guid.h"
 #include "Misc/Paths.h"
@@ -106,6 +112,41 @@ void UMcpAutomationBridgeSubsystem::Initialize(
                        TSharedPtr<FMcpBridgeWebSocket> Socket) {
             ProcessAutomationRequest(RequestId, Action, Payload, Socket);
           }));
+  ConnectionManager->SetOnClientDisconnected(
+      FMcpClientDisconnectedCallback::CreateWeakLambda(
+          this, [this](const FMcpBridgeWebSocket *Socket) {
+            HandleClientDisconnected(Socket);
+          }));
+
+  // Request scheduler: priority lanes, per-client fairness, drain budget
+  {
+    const UMcpAutomationBridgeSettings *Settings =
+        GetDefault<UMcpAutomationBridgeSettings>();
+    RequestScheduler = MakeShared<FMcpRequestScheduler>();
+    RequestScheduler->SetAgingSeconds(EMcpRequestPriority::Bulk,
+                                      Settings->BulkRequestAgingSeconds);
+    RequestScheduler->SetAgingSeconds(EMcpRequestPriority::Background,
+                                      Settings->BackgroundRequestAgingSeconds);
+    RequestDrainBudgetSeconds =
+        FMath::Max(1.0f, Settings->RequestDrainBudgetMs) / 1000.0f;
+    TaskletBudgetSeconds =
+        FMath::Max(1.0f, Settings->BulkTaskBudgetMs) / 1000.0f;
+    MaxWorkerRequests = FMath::Max(0, Settings->MaxConcurrentReadRequests);
+
+    // Editor health ring; sampled from Tick
+    FMcpPerfSampler::Get().Configure(Settings->PerfSampleIntervalSeconds,
+                                     Settings->PerfHistorySeconds);
+
+    // Undo policy for automation requests and the undo buffer cap
+    FMcpTransactionPolicy::Get().Configure(Settings->TransactionPolicy,
+                                           Settings->UndoBufferMaxMB);
+  }
+
+  // Class/struct/enum name lookups; rebuilt lazily after module loads,
+  // hot reload and blueprint compiles
+  FMcpReflectionIndex::Get().Startup();
+  // Grid over actor bounds for spatial scene queries; built on first use
+  FMcpActorSpatialIndex::Get().Startup();
 
   // Initialize the handler registry
   InitializeHandlers();
@@ -143,6 +184,27 @@ void UMcpAutomationBridgeSubsystem::Deinitialize() {
     TickHandle.Reset();
   }
 
+  // Worker tasks use the subsystem directly; let them finish first.
+  bWorkersShuttingDown = true;
+  while (WorkerRequestsInFlight.load() > 0) {
+    FPlatformProcess::Sleep(0.001f);
+  }
+
+  ShutdownAutomationJobs();
+  ShutdownTasklets();
+  ShutdownWorldRegions();
+  ShutdownBatches();
+  FMcpMaterialEditSessions::Get().CommitAll();
+  FMcpActorSpatialIndex::Get().Shutdown();
+  FMcpPerfSampler::Get().Shutdown();
+  FMcpTransactionPolicy::Get().Shutdown();
+  FMcpReflectionIndex::Get().Shutdown();
+  RequestScheduler.Reset();
+  {
+    FScopeLock Lock(&ClientMutationsMutex);
+    ClientMutations.Empty();
+  }
+
   // Skip verbose logging during commandlet mode since we didn't fully
   // initialize
   if (!IsRunningCommandlet()) {
@@ -226,13 +288,26 @@ bool UMcpAutomationBridgeSubsystem::SendRawMessage(const FString &Message) {
 bool UMcpAutomationBridgeSubsystem::Tick(float DeltaTime) {
   // Check if we have pending requests that were deferred due to unsafe engine
   // states
-  if (bPendingRequestsScheduled && !GIsSavingPackage &&
-      !IsGarbageCollecting() && !IsAsyncLoading()) {
-    ProcessPendingAutomationRequests();
+  // Safety net for requests deferred during Serialization/GC/Loading: the
+  // drain bails out in those states, so retry it from here.
+  if (RequestScheduler.IsValid() && RequestScheduler->Num() > 0 &&
+      !GIsSavingPackage && !IsGarbageCollecting() && !IsAsyncLoading()) {
+    SchedulePendingAutomationRequests(false);
   }
+  FMcpPerfSampler::Get().Tick();
+  FMcpTransactionPolicy::Get().Tick();
+  FMcpMaterialEditSessions::Get().Tick();
   return true;
 }
 
+void UMcpAutomationBridgeSubsystem::HandleClientDisconnected(
+    const FMcpBridgeWebSocket *Socket) {
+  // A policy set by this client reverts to the settings default, and the
+  // material edit sessions it left open recompile now.
+  FMcpTransactionPolicy::Get().ClearClientPolicy(Socket);
+  FMcpMaterialEditSessions::Get().CommitOwnedBy(Socket);
+}
+
 // The in-file implementation of ProcessAutomationRequest was intentionally
 // removed from this translation unit. The function is now implemented in
 // McpAutomationBridge_ProcessRequest.cpp to avoid duplicate definitions and
@@ -250,12 +325,32 @@ bool UMcpAutomationBridgeSubsystem::Tick(float DeltaTime) {
  * response.
  * @param Result Optional JSON object containing result data; may be null.
  * @param ErrorCode Error code string to include when `bSuccess` is `false`.
+ *
+ * Responses from worker-dispatched handlers are forwarded to the game thread,
+ * where the connection manager's telemetry and socket bookkeeping live.
  */
 
 void UMcpAutomationBridgeSubsystem::SendAutomationResponse(
     TSharedPtr<FMcpBridgeWebSocket> TargetSocket, const FString &RequestId,
     const bool bSuccess, const FString &Message,
     const TSharedPtr<FJsonObject> &Result, const FString &ErrorCode) {
+  if (!IsInGameThread()) {
+    TWeakObjectPtr<UMcpAutomationBridgeSubsystem> WeakThis(this);
+    AsyncTask(ENamedThreads::GameThread, [WeakThis, TargetSocket, RequestId,
+                                          bSuccess, Message, Result,
+                                          ErrorCode]() {
+      if (UMcpAutomationBridgeSubsystem *Pinned = WeakThis.Get()) {
+        Pinned->SendAutomationResponse(TargetSocket, RequestId, bSuccess,
+                                       Message, Result, ErrorCode);
+      }
+    });
+    return;
+  }
+  EndClientMutation(TargetSocket.Get(), RequestId);
+  if (CaptureBatchItemResponse(RequestId, bSuccess, Message, Result,
+                               ErrorCode)) {
+    return;
+  }
   if (ConnectionManager.IsValid()) {
     ConnectionManager->SendAutomationResponse(TargetSocket, RequestId, bSuccess,
                                               Message, Result, ErrorCode);
@@ -302,9 +397,19 @@ void UMcpAutomationBridgeSubsystem::SendAutomationError(
  */
 void UMcpAutomationBridgeSubsystem::SendProgressUpdate(
     const FString &RequestId, float Percent, const FString &Message, bool bStillWorking) {
-  if (ConnectionManager.IsValid()) {
-    ConnectionManager->SendProgressUpdate(RequestId, Percent, Message, bStillWorking);
+  if (!ConnectionManager.IsValid()) {
+    return;
+  }
+  // Progress of a batch item keeps the enclosing batch request alive.
+  if (IsInGameThread()) {
+    if (const FString *BatchRequestId = BatchItemOwners.Find(RequestId)) {
+      ConnectionManager->SendProgressUpdate(
+          *BatchRequestId, -1.0f,
+          FString::Printf(TEXT("[%s] %s"), *RequestId, *Message), true);
+      return;
+    }
   }
+  ConnectionManager->SendProgressUpdate(RequestId, Percent, Message, bStillWorking);
 }
 
 /**
@@ -337,11 +442,18 @@ void UMcpAutomationBridgeSubsystem::RecordAutomationTelemetry(
  *
  * @param Action The action identifier string used to look up the handler.
  * @param Handler Callable invoked when the specified action is requested.
+ * @param Traits Dispatch traits; thread-safe handlers or subActions may be
+ * run on a worker thread (see CanDispatchOnWorker).
  */
 void UMcpAutomationBridgeSubsystem::RegisterHandler(
-    const FString &Action, FAutomationHandler Handler) {
+    const FString &Action, FAutomationHandler Handler, FHandlerTraits Traits) {
   if (Handler) {
     AutomationHandlers.Add(Action, Handler);
+    if (Traits.bThreadSafe || Traits.ThreadSafeSubActions.Num() > 0) {
+      AutomationHandlerTraits.Add(Action, MoveTemp(Traits));
+    } else {
+      AutomationHandlerTraits.Remove(Action);
+    }
   }
 }
 
@@ -524,6 +636,63 @@ void UMcpAutomationBridgeSubsystem::InitializeHandlers() {
                          TSharedPtr<FMcpBridgeWebSocket> S) {
                     return HandleBulkDeleteAssets(R, A, P, S);
                   });
+  RegisterHandler(TEXT("get_request_queue_stats"),
+                  [this](const FString &R, const FString &A,
+                         const TSharedPtr<FJsonObject> &P,
+                         TSharedPtr<FMcpBridgeWebSocket> S) {
+                    return HandleRequestQueueStats(R, A, P, S);
+                  });
+  RegisterHandler(TEXT("get_bridge_metrics"),
+                  [this](const FString &R, const FString &A,
+                         const TSharedPtr<FJsonObject> &P,
+                         TSharedPtr<FMcpBridgeWebSocket> S) {
+                    return HandleBridgeMetrics(R, A, P, S);
+                  });
+  RegisterHandler(TEXT("get_transaction_policy"),
+                  [this](const FString &R, const FString &A,
+                         const TSharedPtr<FJsonObject> &P,
+                         TSharedPtr<FMcpBridgeWebSocket> S) {
+                    return HandleTransactionPolicy(R, A, P, S);
+                  });
+  RegisterHandler(TEXT("set_transaction_policy"),
+                  [this](const FString &R, const FString &A,
+                         const TSharedPtr<FJsonObject> &P,
+                         TSharedPtr<FMcpBridgeWebSocket> S) {
+                    return HandleTransactionPolicy(R, A, P, S);
+                  });
+  FHandlerTraits EchoTraits;
+  EchoTraits.bThreadSafe = true;
+  RegisterHandler(TEXT("bridge_echo"),
+                  [this](const FString &R, const FString &A,
+                         const TSharedPtr<FJsonObject> &P,
+                         TSharedPtr<FMcpBridgeWebSocket> S) {
+                    return HandleBridgeEcho(R, A, P, S);
+                  },
+                  EchoTraits);
+  RegisterHandler(TEXT("batch"),
+                  [this](const FString &R, const FString &A,
+                         const TSharedPtr<FJsonObject> &P,
+                         TSharedPtr<FMcpBridgeWebSocket> S) {
+                    return HandleBatchAction(R, A, P, S);
+                  });
+  RegisterHandler(TEXT("get_job_status"),
+                  [this](const FString &R, const FString &A,
+                         const TSharedPtr<FJsonObject> &P,
+                         TSharedPtr<FMcpBridgeWebSocket> S) {
+                    return HandleJobAction(R, A, P, S);
+                  });
+  RegisterHandler(TEXT("list_jobs"),
+                  [this](const FString &R, const FString &A,
+                         const TSharedPtr<FJsonObject> &P,
+                         TSharedPtr<FMcpBridgeWebSocket> S) {
+                    return HandleJobAction(R, A, P, S);
+                  });
+  RegisterHandler(TEXT("batch_build_meshes"),
+                  [this](const FString &R, const FString &A,
+                         const TSharedPtr<FJsonObject> &P,
+                         TSharedPtr<FMcpBridgeWebSocket> S) {
+                    return HandleBatchBuildMeshes(R, A, P, S);
+                  });
   RegisterHandler(TEXT("generate_thumbnail"),
                   [this](const FString &R, const FString &A,
                          const TSharedPtr<FJsonObject> &P,
@@ -807,12 +976,43 @@ void UMcpAutomationBridgeSubsystem::InitializeHandlers() {
                     return HandleSequenceAction(R, A, P, S);
                   });
 
+  // Registry-only reads run on worker threads. get_metadata and exists go
+  // through UEditorAssetLibrary (loads / finds UObjects) and stay on the game
+  // thread.
+  FHandlerTraits AssetReadTraits;
+  AssetReadTraits.ThreadSafeSubActions = {
+      TEXT("get_dependencies"), TEXT("get_asset_graph"), TEXT("list"),
+      TEXT("list_assets")};
   RegisterHandler(TEXT("manage_asset"),
                   [this](const FString &R, const FString &A,
                          const TSharedPtr<FJsonObject> &P,
                          TSharedPtr<FMcpBridgeWebSocket> S) {
                     return HandleAssetAction(R, A, P, S);
-                  });
+                  },
+                  AssetReadTraits);
+
+  // find_by_tag loads every candidate asset to read its metadata, so only
+  // the pure registry queries are worker-safe.
+  FHandlerTraits AssetQueryTraits;
+  AssetQueryTraits.ThreadSafeSubActions = {TEXT("get_dependencies"),
+                                           TEXT("search_assets")};
+  RegisterHandler(TEXT("asset_query"),
+                  [this](const FString &R, const FString &A,
+                         const TSharedPtr<FJsonObject> &P,
+                         TSharedPtr<FMcpBridgeWebSocket> S) {
+                    return HandleAssetQueryAction(R, A, P, S);
+                  },
+                  AssetQueryTraits);
+
+  FHandlerTraits LogReadTraits;
+  LogReadTraits.ThreadSafeSubActions = {TEXT("tail")};
+  RegisterHandler(TEXT("manage_logs"),
+                  [this](const FString &R, const FString &A,
+                         const TSharedPtr<FJsonObject> &P,
+                         TSharedPtr<FMcpBridgeWebSocket> S) {
+                    return HandleLogAction(R, A, P, S);
+                  },
+                  LogReadTraits);
 
   RegisterHandler(TEXT("manage_material_authoring"),
                   [this](const FString &R, const FString &A,
@@ -1059,40 +1259,217 @@ void UMcpAutomationBridgeSubsystem::InitializeHandlers() {
                   });
 }
 
-// Drain and process any automation requests that were enqueued while the
-// subsystem was busy. This implementation lives in the primary subsystem
-// translation unit to ensure the symbol is available at link time for
 /**
- * @brief Processes all queued automation requests on the game thread.
+ * @brief Queue a game-thread drain of the request scheduler unless one is
+ * already pending.
  *
- * Ensures execution on the game thread (re-dispatches if called from another
- * thread), moves the shared pending-request queue into a local list under a
- * lock, clears the shared queue and the scheduled flag, then dispatches each
- * request to ProcessAutomationRequest.
+ * @param bNextFrame Run the drain from a one-shot core ticker (next frame)
+ * instead of the game-thread task queue. Used when the current frame's
+ * budget is spent so the editor gets to tick in between.
+ */
+void UMcpAutomationBridgeSubsystem::SchedulePendingAutomationRequests(
+    bool bNextFrame) {
+  if (bPendingRequestsScheduled.exchange(true)) {
+    return;
+  }
+  TWeakObjectPtr<UMcpAutomationBridgeSubsystem> WeakThis(this);
+  if (bNextFrame) {
+    FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateLambda([WeakThis](float) {
+          if (UMcpAutomationBridgeSubsystem *Pinned = WeakThis.Get()) {
+            Pinned->ProcessPendingAutomationRequests();
+          }
+          return false;
+        }));
+  } else {
+    AsyncTask(ENamedThreads::GameThread, [WeakThis]() {
+      if (UMcpAutomationBridgeSubsystem *Pinned = WeakThis.Get()) {
+        Pinned->ProcessPendingAutomationRequests();
+      }
+    });
+  }
+}
+
+/**
+ * @brief Drains queued automation requests on the game thread.
+ *
+ * Dispatches requests in scheduler order (priority lane, then round-robin
+ * across clients) until the per-frame drain budget is spent; at least one
+ * request is always dispatched. Leftovers are picked up on the next frame.
+ * Does nothing while the engine is saving, collecting garbage or async
+ * loading, while a handler is already running or while a transactional
+ * batch waits on an item; the subsystem Tick retries in that case.
  */
 void UMcpAutomationBridgeSubsystem::ProcessPendingAutomationRequests() {
   if (!IsInGameThread()) {
-    AsyncTask(ENamedThreads::GameThread,
-              [this]() { this->ProcessPendingAutomationRequests(); });
+    SchedulePendingAutomationRequests(false);
     return;
   }
+  bPendingRequestsScheduled = false;
 
-  TArray<FPendingAutomationRequest> LocalQueue;
-  {
-    FScopeLock Lock(&PendingAutomationRequestsMutex);
-    if (PendingAutomationRequests.Num() == 0) {
-      bPendingRequestsScheduled = false;
-      return;
+  if (!RequestScheduler.IsValid() || bProcessingAutomationRequest ||
+      OpenBatchTransactions > 0 || GIsSavingPackage || IsGarbageCollecting() || IsAsyncLoading()) {
+    return;
+  }
+
+  const double StartSeconds = FPlatformTime::Seconds();
+  FMcpScheduledRequest Request;
+  while (RequestScheduler->Dequeue(Request)) {
+    DispatchAutomationRequest(Request.RequestId, Request.Action,
+                              Request.Payload, Request.Socket);
+    if (FPlatformTime::Seconds() - StartSeconds >= RequestDrainBudgetSeconds ||
+        GIsSavingPackage || IsGarbageCollecting() || IsAsyncLoading()) {
+      break;
     }
-    LocalQueue = MoveTemp(PendingAutomationRequests);
-    PendingAutomationRequests.Empty();
-    bPendingRequestsScheduled = false;
   }
 
-  for (const FPendingAutomationRequest &Req : LocalQueue) {
-    ProcessAutomationRequest(Req.RequestId, Req.Action, Req.Payload,
-                             Req.RequestingSocket);
+  if (RequestScheduler->Num() > 0) {
+    SchedulePendingAutomationRequests(true);
+  }
+}
+
+/**
+ * @brief Reports request queue depth and wait times per priority lane and
+ * per client (action "get_request_queue_stats").
+ */
+bool UMcpAutomationBridgeSubsystem::HandleRequestQueueStats(
+    const FString &RequestId, const FString &Action,
+    const TSharedPtr<FJsonObject> &Payload,
+    TSharedPtr<FMcpBridgeWebSocket> RequestingSocket) {
+  if (!RequestScheduler.IsValid()) {
+    SendAutomationError(RequestingSocket, RequestId,
+                        TEXT("Request scheduler not initialized"),
+                        TEXT("NOT_INITIALIZED"));
+    return true;
   }
+  TSharedPtr<FJsonObject> Result = RequestScheduler->GetStatsJson();
+  Result->SetNumberField(TEXT("drainBudgetMs"),
+                         RequestDrainBudgetSeconds * 1000.0);
+  Result->SetNumberField(TEXT("workerInFlight"),
+                         WorkerRequestsInFlight.load());
+  Result->SetNumberField(TEXT("workerLimit"), MaxWorkerRequests);
+  Result->SetArrayField(TEXT("tasklets"), GetTaskletStatusJson());
+  Result->SetNumberField(TEXT("taskletBudgetMs"),
+                         TaskletBudgetSeconds * 1000.0);
+  SendAutomationResponse(RequestingSocket, RequestId, true,
+                         TEXT("Request queue stats"), Result);
+  return true;
+}
+
+/**
+ * @brief Reports per-action latency histograms by phase, byte counters and
+ * per-client throughput (action "get_bridge_metrics").
+ *
+ * Payload: "format": "json" (default) or "prometheus", optional "action"
+ * filter for JSON, "reset": true to start a new measurement window after
+ * reading. Both formats include the undo buffer size and policy counters.
+ */
+bool UMcpAutomationBridgeSubsystem::HandleBridgeMetrics(
+    const FString &RequestId, const FString &Action,
+    const TSharedPtr<FJsonObject> &Payload,
+    TSharedPtr<FMcpBridgeWebSocket> RequestingSocket) {
+  if (!ConnectionManager.IsValid()) {
+    SendAutomationError(RequestingSocket, RequestId,
+                        TEXT("Connection manager not initialized"),
+                        TEXT("NOT_INITIALIZED"));
+    return true;
+  }
+  const FString Format = GetJsonStringField(Payload, TEXT("format")).ToLower();
+  TSharedPtr<FJsonObject> Result;
+  if (Format == TEXT("prometheus")) {
+    Result = MakeShared<FJsonObject>();
+    Result->SetStringField(TEXT("format"), TEXT("prometheus"));
+    FString Text = ConnectionManager->GetMetricsPrometheusText();
+    FMcpTransactionPolicy::Get().AppendPrometheusText(Text);
+    Result->SetStringField(TEXT("text"), Text);
+  } else {
+    Result = ConnectionManager->GetMetricsJson(
+        GetJsonStringField(Payload, TEXT("action")));
+    if (RequestScheduler.IsValid()) {
+      Result->SetNumberField(TEXT("queued"), RequestScheduler->Num());
+    }
+    Result->SetNumberField(TEXT("workerInFlight"),
+                           WorkerRequestsInFlight.load());
+    Result->SetObjectField(TEXT("undo"),
+                           FMcpTransactionPolicy::Get().GetStatsJson());
+  }
+  if (GetJsonBoolField(Payload, TEXT("reset"), false)) {
+    ConnectionManager->ResetMetrics();
+  }
+  SendAutomationResponse(RequestingSocket, RequestId, true,
+                         TEXT("Bridge metrics"), Result);
+  return true;
+}
+
+/**
+ * @brief Reads or changes the requesting client's undo policy (actions
+ * "get_transaction_policy" and "set_transaction_policy").
+ *
+ * Payload for set: optional "policy" ("full", "coalesced" or "none"),
+ * "undoBufferMaxMB" (0 restores the editor's own limit) and
+ * "resetUndoBuffer": true to drop the existing history. The policy lasts
+ * until the client disconnects; the undo cap is editor-wide and lasts until
+ * a restart, when the settings' values apply again.
+ */
+bool UMcpAutomationBridgeSubsystem::HandleTransactionPolicy(
+    const FString &RequestId, const FString &Action,
+    const TSharedPtr<FJsonObject> &Payload,
+    TSharedPtr<FMcpBridgeWebSocket> RequestingSocket) {
+  FMcpTransactionPolicy &TransactionPolicy = FMcpTransactionPolicy::Get();
+  if (Action == TEXT("set_transaction_policy") && Payload.IsValid()) {
+    const FString PolicyName = GetJsonStringField(Payload, TEXT("policy"));
+    EMcpTransactionPolicy NewPolicy =
+        TransactionPolicy.GetPolicy(RequestingSocket.Get());
+    if (!PolicyName.IsEmpty() &&
+        !FMcpTransactionPolicy::ParsePolicy(PolicyName, NewPolicy)) {
+      SendAutomationError(
+          RequestingSocket, RequestId,
+          FString::Printf(TEXT("Unknown transaction policy '%s' (expected "
+                               "full, coalesced or none)."),
+                          *PolicyName),
+          TEXT("INVALID_ARGUMENT"));
+      return true;
+    }
+    TransactionPolicy.SetPolicy(RequestingSocket.Get(), NewPolicy);
+    if (Payload->HasField(TEXT("undoBufferMaxMB"))) {
+      TransactionPolicy.SetUndoBufferMaxMB(
+          GetJsonIntField(Payload, TEXT("undoBufferMaxMB"), 0));
+    }
+    if (GetJsonBoolField(Payload, TEXT("resetUndoBuffer"), false)) {
+      TransactionPolicy.ResetUndoBuffer(TEXT("MCP set_transaction_policy"));
+    }
+    TransactionPolicy.Tick();
+  }
+  SendAutomationResponse(
+      RequestingSocket, RequestId, true,
+      FString::Printf(TEXT("Transaction policy: %s"),
+                      FMcpTransactionPolicy::PolicyName(
+                          TransactionPolicy.GetPolicy(RequestingSocket.Get()))),
+      TransactionPolicy.GetStatsJson(RequestingSocket.Get()));
+  return true;
+}
+
+/**
+ * @brief Minimal round trip for measuring bridge overhead (action
+ * "bridge_echo"); the target of the benchmark's tiny_rpc and large_payload
+ * phases.
+ *
+ * Payload: optional "data" string, returned only with "echo": true so large
+ * uploads do not double as large downloads.
+ */
+bool UMcpAutomationBridgeSubsystem::HandleBridgeEcho(
+    const FString &RequestId, const FString &Action,
+    const TSharedPtr<FJsonObject> &Payload,
+    TSharedPtr<FMcpBridgeWebSocket> RequestingSocket) {
+  const FString Data = GetJsonStringField(Payload, TEXT("data"));
+  TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+  Result->SetNumberField(TEXT("dataChars"), Data.Len());
+  if (GetJsonBoolField(Payload, TEXT("echo"), false)) {
+    Result->SetStringField(TEXT("data"), Data);
+  }
+  SendAutomationResponse(RequestingSocket, RequestId, true, FString(),
+                         Result);
+  return true;
 }
 
 // ============================================================================
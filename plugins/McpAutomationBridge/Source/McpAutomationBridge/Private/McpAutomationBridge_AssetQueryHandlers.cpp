@@ -47,15 +47,12 @@ bool UMcpAutomationBridgeSubsystem::HandleAssetQueryAction(
     bool bRecursive = false;
     Payload->TryGetBoolField(TEXT("recursive"), bRecursive);
 
-    FAssetRegistryModule &AssetRegistryModule =
-        FModuleManager::LoadModuleChecked<FAssetRegistryModule>(
-            "AssetRegistry");
     TArray<FName> Dependencies;
     UE::AssetRegistry::EDependencyQuery Query =
         bRecursive ? UE::AssetRegistry::EDependencyQuery::Hard
                    : UE::AssetRegistry::EDependencyQuery::Hard; // Simplified
 
-    AssetRegistryModule.Get().GetDependencies(
+    McpGetAssetRegistry().GetDependencies(
         FName(*AssetPath), Dependencies,
         UE::AssetRegistry::EDependencyCategory::Package, Query);
 
@@ -280,12 +277,13 @@ bool UMcpAutomationBridgeSubsystem::HandleAssetQueryAction(
       Payload->TryGetBoolField(TEXT("recursiveClasses"), bRecursiveClasses);
     Filter.bRecursiveClasses = bRecursiveClasses;
 
+    // Worker-dispatched queries stick to on-disk registry data; enumerating
+    // loaded objects is game-thread only.
+    Filter.bIncludeOnlyOnDiskAssets = !IsInGameThread();
+
     // Execute Query
-    FAssetRegistryModule &AssetRegistryModule =
-        FModuleManager::LoadModuleChecked<FAssetRegistryModule>(
-            "AssetRegistry");
     TArray<FAssetData> AssetDataList;
-    AssetRegistryModule.Get().GetAssets(Filter, AssetDataList);
+    McpGetAssetRegistry().GetAssets(Filter, AssetDataList);
 
     // Apply Limit
     int32 Limit = 100;
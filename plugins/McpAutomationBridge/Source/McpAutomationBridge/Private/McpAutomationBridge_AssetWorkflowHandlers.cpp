@@ -107,6 +107,8 @@ bool UMcpAutomationBridgeSubsystem::HandleAssetAction(
     return HandleGenerateLODs(RequestId, Action, Payload, RequestingSocket);
   if (Lower == TEXT("nanite_rebuild_mesh"))
     return HandleNaniteRebuildMesh(RequestId, Action, Payload, RequestingSocket);
+  if (Lower == TEXT("batch_build_meshes"))
+    return HandleBatchBuildMeshes(RequestId, Lower, Payload, RequestingSocket);
   if (Lower == TEXT("source_control_checkout"))
     return HandleSourceControlCheckout(RequestId, Action, Payload, RequestingSocket);
   if (Lower == TEXT("source_control_submit"))
@@ -132,7 +134,9 @@ bool UMcpAutomationBridgeSubsystem::HandleAssetAction(
 #include "AssetToolsModule.h"
 #include "AssetViewUtils.h"
 #include "EditorAssetLibrary.h"
+#include "Containers/Ticker.h"
 #include "Engine/StaticMesh.h"
+#include "StaticMeshResources.h"
 #include "Factories/MaterialFactoryNew.h"
 #include "Factories/MaterialInstanceConstantFactoryNew.h"
 #include "FileHelpers.h"
@@ -153,6 +157,8 @@ bool UMcpAutomationBridgeSubsystem::HandleAssetAction(
 #include "Materials/MaterialExpressionVectorParameter.h"
 #include "Materials/MaterialInstanceConstant.h"
 #include "MaterialShared.h"
+#include "McpResponseStream.h"
+#include "McpTasklet.h"
 #include "Misc/FileHelper.h"
 #include "ObjectTools.h"
 #include "SourceControlHelpers.h"
@@ -195,73 +201,76 @@ bool UMcpAutomationBridgeSubsystem::HandleFixupRedirectors(
   bool bCheckoutFiles = false;
   Payload->TryGetBoolField(TEXT("checkoutFiles"), bCheckoutFiles);
 
-  AsyncTask(ENamedThreads::GameThread, [this, RequestId, DirectoryPath,
-                                        bCheckoutFiles, RequestingSocket]() {
-    FAssetRegistryModule &AssetRegistryModule =
-        FModuleManager::LoadModuleChecked<FAssetRegistryModule>(
-            TEXT("AssetRegistry"));
-    IAssetRegistry &AssetRegistry = AssetRegistryModule.Get();
+  int32 ChunkSize = 8;
+  Payload->TryGetNumberField(TEXT("chunkSize"), ChunkSize);
+  ChunkSize = FMath::Max(1, ChunkSize);
 
-    // Find all redirectors
-    FARFilter Filter;
+  IAssetRegistry &AssetRegistry = McpGetAssetRegistry();
+
+  // Find all redirectors
+  FARFilter Filter;
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1
-    Filter.ClassPaths.Add(FTopLevelAssetPath(TEXT("/Script/CoreUObject"),
-                                             TEXT("ObjectRedirector")));
+  Filter.ClassPaths.Add(FTopLevelAssetPath(TEXT("/Script/CoreUObject"),
+                                           TEXT("ObjectRedirector")));
 #else
-    Filter.ClassNames.Add(FName(TEXT("ObjectRedirector")));
+  Filter.ClassNames.Add(FName(TEXT("ObjectRedirector")));
 #endif
 
-    if (!DirectoryPath.IsEmpty()) {
-      FString NormalizedPath = DirectoryPath;
-      if (NormalizedPath.StartsWith(TEXT("/Content"),
-                                    ESearchCase::IgnoreCase)) {
-        NormalizedPath =
-            FString::Printf(TEXT("/Game%s"), *NormalizedPath.RightChop(8));
-      }
-      Filter.PackagePaths.Add(FName(*NormalizedPath));
-      Filter.bRecursivePaths = true;
+  if (!DirectoryPath.IsEmpty()) {
+    FString NormalizedPath = DirectoryPath;
+    if (NormalizedPath.StartsWith(TEXT("/Content"), ESearchCase::IgnoreCase)) {
+      NormalizedPath =
+          FString::Printf(TEXT("/Game%s"), *NormalizedPath.RightChop(8));
     }
+    Filter.PackagePaths.Add(FName(*NormalizedPath));
+    Filter.bRecursivePaths = true;
+  }
 
-    TArray<FAssetData> RedirectorAssets;
-    AssetRegistry.GetAssets(Filter, RedirectorAssets);
+  TSharedRef<TArray<FAssetData>> RedirectorAssets =
+      MakeShared<TArray<FAssetData>>();
+  AssetRegistry.GetAssets(Filter, *RedirectorAssets);
 
-    if (RedirectorAssets.Num() == 0) {
-      TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
-      Result->SetBoolField(TEXT("success"), true);
-      Result->SetNumberField(TEXT("redirectorsFound"), 0);
-      Result->SetNumberField(TEXT("redirectorsFixed"), 0);
-      SendAutomationResponse(RequestingSocket, RequestId, true,
-                             TEXT("No redirectors found"), Result, FString());
-      return;
-    }
+  if (RedirectorAssets->Num() == 0) {
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetBoolField(TEXT("success"), true);
+    Result->SetNumberField(TEXT("redirectorsFound"), 0);
+    Result->SetNumberField(TEXT("redirectorsFixed"), 0);
+    SendAutomationResponse(RequestingSocket, RequestId, true,
+                           TEXT("No redirectors found"), Result, FString());
+    return true;
+  }
 
-    // Convert to string paths for AssetTools
-    TArray<FString> RedirectorPaths;
-    for (const FAssetData &Asset : RedirectorAssets) {
-      RedirectorPaths.Add(Asset.ToSoftObjectPath().ToString());
+  // Checkout files if source control is enabled
+  if (bCheckoutFiles && ISourceControlModule::Get().IsEnabled()) {
+    TArray<FString> PackageNames;
+    for (const FAssetData &Asset : *RedirectorAssets) {
+      PackageNames.Add(Asset.PackageName.ToString());
     }
+    SourceControlHelpers::CheckOutFiles(PackageNames, true);
+  }
 
-    // Checkout files if source control is enabled
-    if (bCheckoutFiles && ISourceControlModule::Get().IsEnabled()) {
-      ISourceControlProvider &SourceControlProvider =
-          ISourceControlModule::Get().GetProvider();
-      TArray<FString> PackageNames;
-      for (const FAssetData &Asset : RedirectorAssets) {
-        PackageNames.Add(Asset.PackageName.ToString());
-      }
-      SourceControlHelpers::CheckOutFiles(PackageNames, true);
-    }
+  // Fix up and delete redirectors a chunk per step: FixupReferencers loads
+  // and resaves every referencing package, which can take minutes overall.
+  TSharedRef<int32> DeletedCount = MakeShared<int32>(0);
+  TSharedPtr<FMcpTasklet> Tasklet = MakeShared<FMcpTasklet>();
+  Tasklet->Name = TEXT("fixup_redirectors");
+  Tasklet->RequestId = RequestId;
+  Tasklet->Socket = RequestingSocket;
+  Tasklet->NumSteps =
+      FMath::DivideAndRoundUp(RedirectorAssets->Num(), ChunkSize);
+  Tasklet->Step = [RedirectorAssets, DeletedCount, ChunkSize](int32 StepIndex) {
+    const int32 First = StepIndex * ChunkSize;
+    const int32 Last =
+        FMath::Min(First + ChunkSize, RedirectorAssets->Num());
 
     // Convert FAssetData to UObjectRedirector* for AssetTools
     TArray<UObjectRedirector *> Redirectors;
-    for (const FAssetData &Asset : RedirectorAssets) {
+    for (int32 Index = First; Index < Last; ++Index) {
       if (UObjectRedirector *Redirector =
-              Cast<UObjectRedirector>(Asset.GetAsset())) {
+              Cast<UObjectRedirector>((*RedirectorAssets)[Index].GetAsset())) {
         Redirectors.Add(Redirector);
       }
     }
-
-    // Fixup redirectors using AssetTools
     if (Redirectors.Num() > 0) {
       IAssetTools &AssetTools =
           FModuleManager::LoadModuleChecked<FAssetToolsModule>(
@@ -271,28 +280,33 @@ bool UMcpAutomationBridgeSubsystem::HandleFixupRedirectors(
     }
 
     // Delete the now-unused redirectors
-    int32 DeletedCount = 0;
     TArray<UObject *> ObjectsToDelete;
-    for (const FAssetData &Asset : RedirectorAssets) {
-      if (UObject *Obj = Asset.GetAsset()) {
+    for (int32 Index = First; Index < Last; ++Index) {
+      if (UObject *Obj = (*RedirectorAssets)[Index].GetAsset()) {
         ObjectsToDelete.Add(Obj);
       }
     }
-
     if (ObjectsToDelete.Num() > 0) {
-      DeletedCount = ObjectTools::DeleteObjects(ObjectsToDelete, false);
+      *DeletedCount += ObjectTools::DeleteObjects(ObjectsToDelete, false);
     }
-
+    return true;
+  };
+  Tasklet->Finish = [this, RequestId, RequestingSocket, RedirectorAssets,
+                     DeletedCount](bool bAborted) {
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
-    Result->SetBoolField(TEXT("success"), true);
-    Result->SetNumberField(TEXT("redirectorsFound"), RedirectorAssets.Num());
-    Result->SetNumberField(TEXT("redirectorsFixed"), DeletedCount);
+    Result->SetBoolField(TEXT("success"), !bAborted);
+    Result->SetNumberField(TEXT("redirectorsFound"), RedirectorAssets->Num());
+    Result->SetNumberField(TEXT("redirectorsFixed"), *DeletedCount);
 
     SendAutomationResponse(
-        RequestingSocket, RequestId, true,
-        FString::Printf(TEXT("Fixed %d redirectors"), DeletedCount), Result,
-        FString());
-  });
+        RequestingSocket, RequestId, !bAborted,
+        bAborted ? FString::Printf(TEXT("Redirector fixup interrupted after "
+                                        "%d redirectors"),
+                                   *DeletedCount)
+                 : FString::Printf(TEXT("Fixed %d redirectors"), *DeletedCount),
+        Result, bAborted ? TEXT("ABORTED") : FString());
+  };
+  StartTasklet(Tasklet);
 
   return true;
 #else
@@ -558,21 +572,37 @@ bool UMcpAutomationBridgeSubsystem::HandleBulkRenameAssets(
     }
   }
 
-  TArray<FAssetRenameData> RenameData;
-
-  for (const FString &InputPath : AssetPaths) {
+  // One asset per step: loading and renaming (which fixes up referencers)
+  // dominate, so a 500-asset rename spreads over many frames.
+  struct FBulkRenameState {
+    TArray<TSharedPtr<FJsonValue>> RenamedAssets;
+    int32 Renamed = 0;
+    int32 Failed = 0;
+  };
+  TSharedRef<FBulkRenameState> State = MakeShared<FBulkRenameState>();
+  TSharedRef<TArray<FString>> Paths =
+      MakeShared<TArray<FString>>(MoveTemp(AssetPaths));
+
+  TSharedPtr<FMcpTasklet> Tasklet = MakeShared<FMcpTasklet>();
+  Tasklet->Name = TEXT("bulk_rename");
+  Tasklet->RequestId = RequestId;
+  Tasklet->Socket = RequestingSocket;
+  Tasklet->NumSteps = Paths->Num();
+  Tasklet->Step = [this, State, Paths, Prefix, Suffix, SearchText,
+                   ReplaceText, bCheckoutFiles](int32 StepIndex) {
+    const FString &InputPath = (*Paths)[StepIndex];
     FString AssetPath = ResolveAssetPath(InputPath);
     if (AssetPath.IsEmpty()) {
       AssetPath = InputPath;
     }
 
     if (!UEditorAssetLibrary::DoesAssetExist(AssetPath)) {
-      continue;
+      return true;
     }
 
     UObject *Asset = UEditorAssetLibrary::LoadAsset(AssetPath);
     if (!Asset) {
-      continue;
+      return true;
     }
 
     FString CurrentName = Asset->GetName();
@@ -591,57 +621,66 @@ bool UMcpAutomationBridgeSubsystem::HandleBulkRenameAssets(
     }
 
     if (NewName == CurrentName) {
-      continue;
+      return true;
     }
 
-    FString PackagePath =
-        FPackageName::GetLongPackagePath(Asset->GetOutermost()->GetName());
-    FAssetRenameData RenameEntry(Asset, PackagePath, NewName);
-    RenameData.Add(RenameEntry);
-  }
-
-  if (RenameData.Num() == 0) {
-    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
-    Result->SetBoolField(TEXT("success"), true);
-    Result->SetNumberField(TEXT("renamed"), 0);
-    Result->SetStringField(TEXT("message"),
-                           TEXT("No assets required renaming"));
-    SendAutomationResponse(RequestingSocket, RequestId, true,
-                           TEXT("No renames needed"), Result, FString());
-    return true;
-  }
-
-  if (bCheckoutFiles && ISourceControlModule::Get().IsEnabled()) {
-    TArray<FString> PackageNames;
-    for (const FAssetRenameData &Data : RenameData) {
-      PackageNames.Add(Data.Asset->GetOutermost()->GetName());
+    const FString PackageName = Asset->GetOutermost()->GetName();
+    if (bCheckoutFiles && ISourceControlModule::Get().IsEnabled()) {
+      SourceControlHelpers::CheckOutFiles({PackageName}, true);
     }
-    SourceControlHelpers::CheckOutFiles(PackageNames, true);
-  }
 
-  IAssetTools &AssetTools =
-      FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"))
-          .Get();
-  bool bSuccess = AssetTools.RenameAssets(RenameData);
+    const FString OldPath = Asset->GetPathName();
+    FString PackagePath = FPackageName::GetLongPackagePath(PackageName);
+    TArray<FAssetRenameData> RenameData;
+    RenameData.Emplace(Asset, PackagePath, NewName);
+
+    IAssetTools &AssetTools =
+        FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"))
+            .Get();
+    const bool bRenamed = AssetTools.RenameAssets(RenameData);
+    if (bRenamed) {
+      ++State->Renamed;
+    } else {
+      ++State->Failed;
+    }
 
-  TArray<TSharedPtr<FJsonValue>> RenamedAssets;
-  for (const FAssetRenameData &Data : RenameData) {
     TSharedPtr<FJsonObject> AssetInfo = MakeShared<FJsonObject>();
-    AssetInfo->SetStringField(TEXT("oldPath"), Data.Asset->GetPathName());
-    AssetInfo->SetStringField(TEXT("newName"), Data.NewName);
-    RenamedAssets.Add(MakeShared<FJsonValueObject>(AssetInfo));
-  }
+    AssetInfo->SetStringField(TEXT("oldPath"), OldPath);
+    AssetInfo->SetStringField(TEXT("newName"), NewName);
+    AssetInfo->SetBoolField(TEXT("success"), bRenamed);
+    State->RenamedAssets.Add(MakeShared<FJsonValueObject>(AssetInfo));
+    return true;
+  };
+  Tasklet->Finish = [this, RequestId, RequestingSocket, State](bool bAborted) {
+    const int32 Attempted = State->Renamed + State->Failed;
+    if (Attempted == 0 && !bAborted) {
+      TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+      Result->SetBoolField(TEXT("success"), true);
+      Result->SetNumberField(TEXT("renamed"), 0);
+      Result->SetStringField(TEXT("message"),
+                             TEXT("No assets required renaming"));
+      SendAutomationResponse(RequestingSocket, RequestId, true,
+                             TEXT("No renames needed"), Result, FString());
+      return;
+    }
 
-  TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
-  Result->SetBoolField(TEXT("success"), bSuccess);
-  Result->SetNumberField(TEXT("renamed"), RenameData.Num());
-  Result->SetArrayField(TEXT("assets"), RenamedAssets);
+    const bool bSuccess = !bAborted && State->Failed == 0;
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetBoolField(TEXT("success"), bSuccess);
+    Result->SetNumberField(TEXT("renamed"), State->Renamed);
+    Result->SetNumberField(TEXT("failed"), State->Failed);
+    Result->SetArrayField(TEXT("assets"), State->RenamedAssets);
 
-  SendAutomationResponse(
-      RequestingSocket, RequestId, bSuccess,
-      bSuccess ? FString::Printf(TEXT("Renamed %d assets"), RenameData.Num())
-               : TEXT("Bulk rename failed"),
-      Result, bSuccess ? FString() : TEXT("BULK_RENAME_FAILED"));
+    SendAutomationResponse(
+        RequestingSocket, RequestId, bSuccess,
+        bSuccess ? FString::Printf(TEXT("Renamed %d assets"), State->Renamed)
+                 : FString::Printf(TEXT("Bulk rename %s: %d renamed, %d failed"),
+                                   bAborted ? TEXT("interrupted")
+                                            : TEXT("failed"),
+                                   State->Renamed, State->Failed),
+        Result, bSuccess ? FString() : TEXT("BULK_RENAME_FAILED"));
+  };
+  StartTasklet(Tasklet);
   return true;
 #else
   SendAutomationResponse(RequestingSocket, RequestId, false,
@@ -655,6 +694,78 @@ bool UMcpAutomationBridgeSubsystem::HandleBulkRenameAssets(
 // 5. BULK DELETE ASSETS
 // ============================================================================
 
+#if WITH_EDITOR
+// Reorders Paths so every asset comes before the assets it references within
+// the set, using the registry's package dependencies. Chunked deletes then
+// never leave a member referenced by one still waiting in a later chunk.
+// Returns false when members reference each other in a cycle; such a set
+// can only be deleted by a single DeleteObjects call.
+static bool McpOrderBulkDeleteByReferences(TArray<FString> &Paths) {
+  IAssetRegistry &AssetRegistry = McpGetAssetRegistry();
+  const int32 Num = Paths.Num();
+  TMap<FName, TArray<int32>> IndicesByPackage;
+  TArray<FName> Packages;
+  Packages.Reserve(Num);
+  for (int32 Index = 0; Index < Num; ++Index) {
+    const FName Package(*FPackageName::ObjectPathToPackageName(Paths[Index]));
+    Packages.Add(Package);
+    IndicesByPackage.FindOrAdd(Package).Add(Index);
+  }
+
+  // Referenced[i] lists the members that member i references.
+  TArray<TArray<int32>> Referenced;
+  Referenced.SetNum(Num);
+  TArray<int32> ReferencerCount;
+  ReferencerCount.SetNumZeroed(Num);
+  bool bInternalReferences = false;
+  for (int32 Index = 0; Index < Num; ++Index) {
+    TArray<FName> Dependencies;
+    AssetRegistry.GetDependencies(Packages[Index], Dependencies);
+    for (const FName &Dependency : Dependencies) {
+      if (Dependency == Packages[Index]) {
+        continue;
+      }
+      if (const TArray<int32> *Targets = IndicesByPackage.Find(Dependency)) {
+        for (int32 Target : *Targets) {
+          Referenced[Index].Add(Target);
+          ++ReferencerCount[Target];
+          bInternalReferences = true;
+        }
+      }
+    }
+  }
+  if (!bInternalReferences) {
+    return true;
+  }
+
+  TArray<int32> Order;
+  Order.Reserve(Num);
+  for (int32 Index = 0; Index < Num; ++Index) {
+    if (ReferencerCount[Index] == 0) {
+      Order.Add(Index);
+    }
+  }
+  for (int32 Cursor = 0; Cursor < Order.Num(); ++Cursor) {
+    for (int32 Target : Referenced[Order[Cursor]]) {
+      if (--ReferencerCount[Target] == 0) {
+        Order.Add(Target);
+      }
+    }
+  }
+  if (Order.Num() != Num) {
+    return false;
+  }
+
+  TArray<FString> Sorted;
+  Sorted.Reserve(Num);
+  for (int32 Index : Order) {
+    Sorted.Add(MoveTemp(Paths[Index]));
+  }
+  Paths = MoveTemp(Sorted);
+  return true;
+}
+#endif
+
 bool UMcpAutomationBridgeSubsystem::HandleBulkDeleteAssets(
     const FString &RequestId, const FString &Action,
     const TSharedPtr<FJsonObject> &Payload,
@@ -694,49 +805,53 @@ bool UMcpAutomationBridgeSubsystem::HandleBulkDeleteAssets(
     }
   }
 
-  TArray<UObject *> ObjectsToDelete;
-  TArray<FString> ValidPaths;
-
-  for (const FString &AssetPath : AssetPaths) {
-    if (UEditorAssetLibrary::DoesAssetExist(AssetPath)) {
-      if (UObject *Asset = UEditorAssetLibrary::LoadAsset(AssetPath)) {
-        ObjectsToDelete.Add(Asset);
-        ValidPaths.Add(AssetPath);
+  int32 ChunkSize = 16;
+  Payload->TryGetNumberField(TEXT("chunkSize"), ChunkSize);
+  // A confirmation dialog is modal anyway, so delete everything in one go.
+  // Members that reference each other in a cycle must also go in one call.
+  const bool bOrdered = McpOrderBulkDeleteByReferences(AssetPaths);
+  ChunkSize = FMath::Max(1, bShowConfirmation || !bOrdered ? AssetPaths.Num()
+                                                            : ChunkSize);
+
+  // Each step loads and deletes one chunk (DeleteObjects runs a reference
+  // check and GC per call), referencers before the members they reference;
+  // the last step fixes up leftover redirectors.
+  // Loaded assets are deleted in the step that loaded them so nothing is
+  // held across frames.
+  struct FBulkDeleteState {
+    TArray<TSharedPtr<FJsonValue>> Deleted;
+    int32 Requested = 0;
+    int32 DeletedCount = 0;
+  };
+  TSharedRef<FBulkDeleteState> State = MakeShared<FBulkDeleteState>();
+  TSharedRef<TArray<FString>> Paths =
+      MakeShared<TArray<FString>>(MoveTemp(AssetPaths));
+  const int32 NumChunks = FMath::DivideAndRoundUp(Paths->Num(), ChunkSize);
+
+  TSharedPtr<FMcpTasklet> Tasklet = MakeShared<FMcpTasklet>();
+  Tasklet->Name = TEXT("bulk_delete");
+  Tasklet->RequestId = RequestId;
+  Tasklet->Socket = RequestingSocket;
+  Tasklet->NumSteps = NumChunks + (bFixupRedirectors ? 1 : 0);
+  Tasklet->Step = [State, Paths, ChunkSize, NumChunks,
+                   bShowConfirmation](int32 StepIndex) {
+    if (StepIndex == NumChunks) {
+      if (State->DeletedCount == 0) {
+        return true;
       }
-    }
-  }
-
-  if (ObjectsToDelete.Num() == 0) {
-    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
-    Result->SetBoolField(TEXT("success"), false);
-    Result->SetStringField(TEXT("error"), TEXT("No valid assets found"));
-    SendAutomationResponse(RequestingSocket, RequestId, false,
-                           TEXT("No valid assets"), Result,
-                           TEXT("NO_VALID_ASSETS"));
-    return true;
-  }
-
-  int32 DeletedCount =
-      ObjectTools::DeleteObjects(ObjectsToDelete, bShowConfirmation);
+      IAssetRegistry &AssetRegistry = McpGetAssetRegistry();
 
-  if (bFixupRedirectors && DeletedCount > 0) {
-    FAssetRegistryModule &AssetRegistryModule =
-        FModuleManager::LoadModuleChecked<FAssetRegistryModule>(
-            TEXT("AssetRegistry"));
-    IAssetRegistry &AssetRegistry = AssetRegistryModule.Get();
-
-    FARFilter Filter;
+      FARFilter Filter;
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1
-    Filter.ClassPaths.Add(FTopLevelAssetPath(TEXT("/Script/CoreUObject"),
-                                             TEXT("ObjectRedirector")));
+      Filter.ClassPaths.Add(FTopLevelAssetPath(TEXT("/Script/CoreUObject"),
+                                               TEXT("ObjectRedirector")));
 #else
-    Filter.ClassNames.Add(FName(TEXT("ObjectRedirector")));
+      Filter.ClassNames.Add(FName(TEXT("ObjectRedirector")));
 #endif
 
-    TArray<FAssetData> RedirectorAssets;
-    AssetRegistry.GetAssets(Filter, RedirectorAssets);
+      TArray<FAssetData> RedirectorAssets;
+      AssetRegistry.GetAssets(Filter, RedirectorAssets);
 
-    if (RedirectorAssets.Num() > 0) {
       TArray<UObjectRedirector *> Redirectors;
       for (const FAssetData &Asset : RedirectorAssets) {
         if (UObjectRedirector *Redirector =
@@ -752,24 +867,59 @@ bool UMcpAutomationBridgeSubsystem::HandleBulkDeleteAssets(
                 .Get();
         AssetTools.FixupReferencers(Redirectors);
       }
+      return true;
     }
-  }
 
-  TArray<TSharedPtr<FJsonValue>> DeletedArray;
-  for (const FString &Path : ValidPaths) {
-    DeletedArray.Add(MakeShared<FJsonValueString>(Path));
-  }
+    const int32 First = StepIndex * ChunkSize;
+    const int32 Last = FMath::Min(First + ChunkSize, Paths->Num());
+    TArray<UObject *> ObjectsToDelete;
+    TArray<FString> ValidPaths;
+    for (int32 Index = First; Index < Last; ++Index) {
+      const FString &AssetPath = (*Paths)[Index];
+      if (UEditorAssetLibrary::DoesAssetExist(AssetPath)) {
+        if (UObject *Asset = UEditorAssetLibrary::LoadAsset(AssetPath)) {
+          ObjectsToDelete.Add(Asset);
+          ValidPaths.Add(AssetPath);
+        }
+      }
+    }
+    if (ObjectsToDelete.Num() == 0) {
+      return true;
+    }
 
-  TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
-  Result->SetBoolField(TEXT("success"), DeletedCount > 0);
-  Result->SetArrayField(TEXT("deleted"), DeletedArray);
-  Result->SetNumberField(TEXT("requested"), ObjectsToDelete.Num());
+    State->Requested += ObjectsToDelete.Num();
+    State->DeletedCount +=
+        ObjectTools::DeleteObjects(ObjectsToDelete, bShowConfirmation);
+    for (const FString &Path : ValidPaths) {
+      State->Deleted.Add(MakeShared<FJsonValueString>(Path));
+    }
+    return true;
+  };
+  Tasklet->Finish = [this, RequestId, RequestingSocket, State](bool bAborted) {
+    if (State->Requested == 0 && !bAborted) {
+      TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+      Result->SetBoolField(TEXT("success"), false);
+      Result->SetStringField(TEXT("error"), TEXT("No valid assets found"));
+      SendAutomationResponse(RequestingSocket, RequestId, false,
+                             TEXT("No valid assets"), Result,
+                             TEXT("NO_VALID_ASSETS"));
+      return;
+    }
 
-  SendAutomationResponse(
-      RequestingSocket, RequestId, DeletedCount > 0,
-      FString::Printf(TEXT("Deleted %d of %d assets"), DeletedCount,
-                      ObjectsToDelete.Num()),
-      Result, DeletedCount > 0 ? FString() : TEXT("BULK_DELETE_FAILED"));
+    const bool bSuccess = !bAborted && State->DeletedCount > 0;
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetBoolField(TEXT("success"), bSuccess);
+    Result->SetArrayField(TEXT("deleted"), State->Deleted);
+    Result->SetNumberField(TEXT("requested"), State->Requested);
+
+    SendAutomationResponse(
+        RequestingSocket, RequestId, bSuccess,
+        FString::Printf(TEXT("Deleted %d of %d assets%s"), State->DeletedCount,
+                        State->Requested,
+                        bAborted ? TEXT(" (interrupted)") : TEXT("")),
+        Result, bSuccess ? FString() : TEXT("BULK_DELETE_FAILED"));
+  };
+  StartTasklet(Tasklet);
   return true;
 #else
   SendAutomationResponse(RequestingSocket, RequestId, false,
@@ -1557,12 +1707,10 @@ bool UMcpAutomationBridgeSubsystem::HandleGetDependencies(
   bool bRecursive = false;
   Payload->TryGetBoolField(TEXT("recursive"), bRecursive);
 
-  FAssetRegistryModule &AssetRegistryModule =
-      FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
   TArray<FName> Dependencies;
   UE::AssetRegistry::EDependencyCategory Category =
       UE::AssetRegistry::EDependencyCategory::Package;
-  AssetRegistryModule.Get().GetDependencies(FName(*AssetPath), Dependencies);
+  McpGetAssetRegistry().GetDependencies(FName(*AssetPath), Dependencies);
 
   TArray<TSharedPtr<FJsonValue>> DepArray;
   for (const FName &Dep : Dependencies) {
@@ -1610,10 +1758,12 @@ bool UMcpAutomationBridgeSubsystem::HandleGetAssetGraph(
   int32 MaxDepth = 3;
   Payload->TryGetNumberField(TEXT("maxDepth"), MaxDepth);
 
-  FAssetRegistryModule &AssetRegistryModule =
-      FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-  IAssetRegistry &AssetRegistry = AssetRegistryModule.Get();
+  IAssetRegistry &AssetRegistry = McpGetAssetRegistry();
 
+  // Streamed graphs are sent as {asset, dependencies} entries per visited
+  // asset rather than one object keyed by asset path.
+  const TSharedPtr<FMcpResponseStream> Stream =
+      BeginResponseStream(RequestId, Payload, Socket, TEXT("graph"));
   TSharedPtr<FJsonObject> GraphObj = MakeShared<FJsonObject>();
 
   TArray<FString> Queue;
@@ -1649,11 +1799,25 @@ bool UMcpAutomationBridgeSubsystem::HandleGetAssetGraph(
         }
       }
     }
-    GraphObj->SetArrayField(Current, DepArray);
+    if (!Stream.IsValid()) {
+      GraphObj->SetArrayField(Current, DepArray);
+      continue;
+    }
+    TSharedPtr<FJsonObject> Node = MakeShared<FJsonObject>();
+    Node->SetStringField(TEXT("asset"), Current);
+    Node->SetArrayField(TEXT("dependencies"), DepArray);
+    if (!Stream->Add(Node)) {
+      break;
+    }
   }
 
   TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
   Resp->SetBoolField(TEXT("success"), true);
+  if (Stream.IsValid()) {
+    FinishResponseStream(Stream, Socket, RequestId,
+                         TEXT("Asset graph retrieved"), Resp);
+    return true;
+  }
   Resp->SetObjectField(TEXT("graph"), GraphObj);
   SendAutomationResponse(Socket, RequestId, true, TEXT("Asset graph retrieved"),
                          Resp, FString());
@@ -1864,13 +2028,17 @@ bool UMcpAutomationBridgeSubsystem::HandleListAssets(
     (*PaginationObj)->TryGetNumberField(TEXT("limit"), Limit);
   }
 
-  FAssetRegistryModule &AssetRegistryModule =
-      FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-  IAssetRegistry &AssetRegistry = AssetRegistryModule.Get();
+  IAssetRegistry &AssetRegistry = McpGetAssetRegistry();
+
+  // When dispatched to a worker thread this handler only reads the registry's
+  // on-disk state: in-memory enumeration touches UObjects and a synchronous
+  // scan would block on the game thread's gatherer.
+  const bool bOnWorker = !IsInGameThread();
 
   FARFilter Filter;
   Filter.bRecursivePaths = bRecursive;
   Filter.bRecursiveClasses = true;
+  Filter.bIncludeOnlyOnDiskAssets = bOnWorker;
 
   // Apply path filters
   if (!PathFilter.IsEmpty()) {
@@ -1887,11 +2055,13 @@ bool UMcpAutomationBridgeSubsystem::HandleListAssets(
   }
 
   // Ensure registry is up to date for the requested paths
-  TArray<FString> ScanPaths;
-  for (const FName &Path : Filter.PackagePaths) {
-    ScanPaths.Add(Path.ToString());
+  if (!bOnWorker) {
+    TArray<FString> ScanPaths;
+    for (const FName &Path : Filter.PackagePaths) {
+      ScanPaths.Add(Path.ToString());
+    }
+    AssetRegistry.ScanPathsSynchronous(ScanPaths, true);
   }
-  AssetRegistry.ScanPathsSynchronous(ScanPaths, true);
 
   if (!ClassFilter.IsEmpty()) {
     // Support both short class names and full paths (best effort)
@@ -2024,6 +2194,11 @@ bool UMcpAutomationBridgeSubsystem::HandleListAssets(
     // immediate subfolders of the requested path.
   }
 
+  // With "stream": true the asset entries go out in chunks as they are
+  // built instead of being collected into one response.
+  const TSharedPtr<FMcpResponseStream> Stream =
+      BeginResponseStream(RequestId, Payload, Socket, TEXT("assets"));
+
   TArray<TSharedPtr<FJsonValue>> AssetsArray;
   for (const FAssetData &Asset : AssetList) {
     TSharedPtr<FJsonObject> AssetObj = MakeShared<FJsonObject>();
@@ -2044,7 +2219,11 @@ bool UMcpAutomationBridgeSubsystem::HandleListAssets(
     }
     AssetObj->SetArrayField(TEXT("tags"), Tags);
 
-    AssetsArray.Add(MakeShared<FJsonValueObject>(AssetObj));
+    if (!Stream.IsValid()) {
+      AssetsArray.Add(MakeShared<FJsonValueObject>(AssetObj));
+    } else if (!Stream->Add(AssetObj)) {
+      break;
+    }
   }
 
   TArray<TSharedPtr<FJsonValue>> FoldersJson;
@@ -2054,12 +2233,19 @@ bool UMcpAutomationBridgeSubsystem::HandleListAssets(
 
   TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
   Resp->SetBoolField(TEXT("success"), true);
-  Resp->SetArrayField(TEXT("assets"), AssetsArray);
   Resp->SetArrayField(TEXT("folders"), FoldersJson);
   Resp->SetNumberField(TEXT("totalCount"), TotalCount);
-  Resp->SetNumberField(TEXT("count"), AssetsArray.Num());
   Resp->SetNumberField(TEXT("offset"), Offset);
 
+  if (Stream.IsValid()) {
+    Resp->SetNumberField(TEXT("count"), Stream->GetNumItems());
+    FinishResponseStream(Stream, Socket, RequestId, TEXT("Assets listed"),
+                         Resp);
+    return true;
+  }
+
+  Resp->SetArrayField(TEXT("assets"), AssetsArray);
+  Resp->SetNumberField(TEXT("count"), AssetsArray.Num());
   SendAutomationResponse(Socket, RequestId, true, TEXT("Assets listed"), Resp,
                          FString());
   return true;
@@ -2174,22 +2360,32 @@ bool UMcpAutomationBridgeSubsystem::HandleGenerateReport(
   FString OutputPath;
   Payload->TryGetStringField(TEXT("outputPath"), OutputPath);
 
-  AsyncTask(ENamedThreads::GameThread, [this, RequestId, Socket, Directory,
-                                        ReportType, OutputPath]() {
-    FAssetRegistryModule &AssetRegistryModule =
-        FModuleManager::LoadModuleChecked<FAssetRegistryModule>(
-            TEXT("AssetRegistry"));
-    FARFilter Filter;
-    Filter.bRecursivePaths = true;
-    if (!Directory.IsEmpty()) {
-      Filter.PackagePaths.Add(FName(*Directory));
-    }
-
-    TArray<FAssetData> AssetList;
-    AssetRegistryModule.Get().GetAssets(Filter, AssetList);
-
-    TArray<TSharedPtr<FJsonValue>> AssetsArray;
-    for (const FAssetData &Asset : AssetList) {
+  FARFilter Filter;
+  Filter.bRecursivePaths = true;
+  if (!Directory.IsEmpty()) {
+    Filter.PackagePaths.Add(FName(*Directory));
+  }
+
+  TSharedRef<TArray<FAssetData>> AssetList = MakeShared<TArray<FAssetData>>();
+  McpGetAssetRegistry().GetAssets(Filter, *AssetList);
+
+  // Serializing a whole project's registry is the slow part; do it in
+  // fixed-size slices so the editor keeps ticking.
+  constexpr int32 AssetsPerStep = 256;
+  TSharedRef<TArray<TSharedPtr<FJsonValue>>> AssetsArray =
+      MakeShared<TArray<TSharedPtr<FJsonValue>>>();
+  AssetsArray->Reserve(AssetList->Num());
+
+  TSharedPtr<FMcpTasklet> Tasklet = MakeShared<FMcpTasklet>();
+  Tasklet->Name = TEXT("generate_report");
+  Tasklet->RequestId = RequestId;
+  Tasklet->Socket = Socket;
+  Tasklet->NumSteps = FMath::DivideAndRoundUp(AssetList->Num(), AssetsPerStep);
+  Tasklet->Step = [AssetList, AssetsArray](int32 StepIndex) {
+    const int32 First = StepIndex * AssetsPerStep;
+    const int32 Last = FMath::Min(First + AssetsPerStep, AssetList->Num());
+    for (int32 Index = First; Index < Last; ++Index) {
+      const FAssetData &Asset = (*AssetList)[Index];
       TSharedPtr<FJsonObject> AssetObj = MakeShared<FJsonObject>();
       AssetObj->SetStringField(TEXT("name"), Asset.AssetName.ToString());
       AssetObj->SetStringField(TEXT("path"),
@@ -2200,7 +2396,17 @@ bool UMcpAutomationBridgeSubsystem::HandleGenerateReport(
                                Asset.ToSoftObjectPath().ToString());
       AssetObj->SetStringField(TEXT("class"), Asset.AssetClass.ToString());
 #endif
-      AssetsArray.Add(MakeShared<FJsonValueObject>(AssetObj));
+      AssetsArray->Add(MakeShared<FJsonValueObject>(AssetObj));
+    }
+    return true;
+  };
+  Tasklet->Finish = [this, RequestId, Socket, Directory, ReportType,
+                     OutputPath, AssetList, AssetsArray](bool bAborted) {
+    if (bAborted) {
+      SendAutomationError(Socket, RequestId,
+                          TEXT("Asset report generation was interrupted"),
+                          TEXT("ABORTED"));
+      return;
     }
 
     bool bFileWritten = false;
@@ -2226,8 +2432,8 @@ bool UMcpAutomationBridgeSubsystem::HandleGenerateReport(
     Resp->SetBoolField(TEXT("success"), true);
     Resp->SetStringField(TEXT("directory"), Directory);
     Resp->SetStringField(TEXT("reportType"), ReportType);
-    Resp->SetNumberField(TEXT("assetCount"), AssetList.Num());
-    Resp->SetArrayField(TEXT("assets"), AssetsArray);
+    Resp->SetNumberField(TEXT("assetCount"), AssetList->Num());
+    Resp->SetArrayField(TEXT("assets"), *AssetsArray);
     if (!OutputPath.IsEmpty()) {
       Resp->SetStringField(TEXT("outputPath"), OutputPath);
       Resp->SetBoolField(TEXT("fileWritten"), bFileWritten);
@@ -2235,7 +2441,8 @@ bool UMcpAutomationBridgeSubsystem::HandleGenerateReport(
 
     SendAutomationResponse(Socket, RequestId, true,
                            TEXT("Asset report generated"), Resp, FString());
-  });
+  };
+  StartTasklet(Tasklet);
   return true;
 #else
   SendAutomationError(RequestingSocket, RequestId, TEXT("Editor build required"), TEXT("NOT_SUPPORTED"));
@@ -2803,6 +3010,101 @@ bool UMcpAutomationBridgeSubsystem::HandleGetMaterialStats(
 #endif
 }
 
+#if WITH_EDITOR
+// Configure source models for NumLODs levels. LODPercents[i] is the triangle
+// fraction for LOD i+1; missing entries fall back to halving per level.
+static void McpConfigureStaticMeshLODs(UStaticMesh *Mesh, int32 NumLODs,
+                                       const TArray<float> &LODPercents) {
+  Mesh->SetNumSourceModels(NumLODs);
+  for (int32 LODIndex = 1; LODIndex < NumLODs; LODIndex++) {
+    FStaticMeshSourceModel &SourceModel = Mesh->GetSourceModel(LODIndex);
+    FMeshReductionSettings &ReductionSettings = SourceModel.ReductionSettings;
+
+    // Progressive reduction: 50%, 25%, 12.5%...
+    const float ReductionPercent =
+        LODPercents.IsValidIndex(LODIndex - 1)
+            ? FMath::Clamp(LODPercents[LODIndex - 1], 0.0f, 1.0f)
+            : 1.0f / FMath::Pow(2.0f, static_cast<float>(LODIndex));
+    ReductionSettings.PercentTriangles = ReductionPercent;
+    ReductionSettings.PercentVertices = ReductionPercent;
+
+    SourceModel.BuildSettings.bRecomputeNormals = false;
+    SourceModel.BuildSettings.bRecomputeTangents = false;
+    SourceModel.BuildSettings.bUseMikkTSpace = true;
+  }
+}
+
+// Apply Nanite settings across engine versions. Percents are 0-100.
+static void McpApplyStaticMeshNaniteSettings(UStaticMesh *StaticMesh,
+                                             bool bEnableNanite,
+                                             bool bPreserveArea,
+                                             double TrianglePercent,
+                                             double FallbackPercent) {
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 7
+  // UE 5.7+: Use accessor functions to avoid deprecation warnings
+  FMeshNaniteSettings Settings = StaticMesh->GetNaniteSettings();
+  Settings.bEnabled = bEnableNanite;
+  Settings.PositionPrecision = 8; // Default precision
+
+  // bPreserveArea replaced with ShapePreservation enum
+  if (bPreserveArea) {
+    Settings.ShapePreservation = ENaniteShapePreservation::PreserveArea;
+  } else {
+    Settings.ShapePreservation = ENaniteShapePreservation::None;
+  }
+  Settings.KeepPercentTriangles = static_cast<float>(TrianglePercent / 100.0);
+  Settings.FallbackPercentTriangles = static_cast<float>(FallbackPercent / 100.0);
+  if (FallbackPercent > 0.0) {
+    Settings.GenerateFallback = ENaniteGenerateFallback::Enabled;
+  } else {
+    Settings.GenerateFallback = ENaniteGenerateFallback::PlatformDefault;
+  }
+  StaticMesh->SetNaniteSettings(Settings);
+  StaticMesh->NotifyNaniteSettingsChanged();
+#elif ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1
+  // UE 5.1-5.6: Uses KeepPercentTriangles, FallbackPercentTriangles, and bPreserveArea
+  StaticMesh->NaniteSettings.bEnabled = bEnableNanite;
+  StaticMesh->NaniteSettings.PositionPrecision = 8;
+  StaticMesh->NaniteSettings.bPreserveArea = bPreserveArea;
+  StaticMesh->NaniteSettings.KeepPercentTriangles = static_cast<float>(TrianglePercent / 100.0);
+  StaticMesh->NaniteSettings.FallbackPercentTriangles = static_cast<float>(FallbackPercent / 100.0);
+#else
+  // UE 5.0: Uses KeepPercentTriangles (no bPreserveArea)
+  StaticMesh->NaniteSettings.bEnabled = bEnableNanite;
+  StaticMesh->NaniteSettings.PositionPrecision = 8;
+  StaticMesh->NaniteSettings.KeepPercentTriangles = static_cast<float>(TrianglePercent / 100.0);
+  StaticMesh->NaniteSettings.FallbackPercentTriangles = static_cast<float>(FallbackPercent / 100.0);
+#endif
+}
+
+static TArray<float> McpReadLODPercents(const TSharedPtr<FJsonObject> &Obj,
+                                        const TArray<float> &Default) {
+  const TArray<TSharedPtr<FJsonValue>> *PercentsArray = nullptr;
+  if (!Obj.IsValid() ||
+      !Obj->TryGetArrayField(TEXT("lodPercents"), PercentsArray) ||
+      !PercentsArray) {
+    return Default;
+  }
+  TArray<float> Percents;
+  for (const TSharedPtr<FJsonValue> &Val : *PercentsArray) {
+    if (Val.IsValid() && Val->Type == EJson::Number) {
+      // Accept either 0-1 fractions or 0-100 percentages
+      const double Raw = Val->AsNumber();
+      Percents.Add(static_cast<float>(Raw > 1.0 ? Raw / 100.0 : Raw));
+    }
+  }
+  return Percents;
+}
+
+static int32 McpCountStaticMeshTriangles(UStaticMesh *Mesh, int32 LODIndex) {
+  const FStaticMeshRenderData *RenderData = Mesh ? Mesh->GetRenderData() : nullptr;
+  if (!RenderData || !RenderData->LODResources.IsValidIndex(LODIndex)) {
+    return 0;
+  }
+  return RenderData->LODResources[LODIndex].GetNumTriangles();
+}
+#endif
+
 bool UMcpAutomationBridgeSubsystem::HandleGenerateLODs(
     const FString &RequestId, const FString &Action,
     const TSharedPtr<FJsonObject> &Payload,
@@ -2855,25 +3157,7 @@ bool UMcpAutomationBridgeSubsystem::HandleGenerateLODs(
                TEXT("Generating %d LODs for %s"), NumLODs, *Path);
 
         Mesh->Modify();
-        Mesh->SetNumSourceModels(NumLODs);
-
-        // Configure LOD reduction settings with progressive reduction
-        for (int32 LODIndex = 1; LODIndex < NumLODs; LODIndex++) {
-          FStaticMeshSourceModel &SourceModel = Mesh->GetSourceModel(LODIndex);
-          FMeshReductionSettings &ReductionSettings =
-              SourceModel.ReductionSettings;
-
-          // Progressive reduction: 50%, 25%, 12.5%...
-          float ReductionPercent =
-              1.0f / FMath::Pow(2.0f, static_cast<float>(LODIndex));
-          ReductionSettings.PercentTriangles = ReductionPercent;
-          ReductionSettings.PercentVertices = ReductionPercent;
-
-          // Enable reduction for this LOD level
-          SourceModel.BuildSettings.bRecomputeNormals = false;
-          SourceModel.BuildSettings.bRecomputeTangents = false;
-          SourceModel.BuildSettings.bUseMikkTSpace = true;
-        }
+        McpConfigureStaticMeshLODs(Mesh, NumLODs, TArray<float>());
 
         // Build the mesh with new LOD settings
         Mesh->Build();
@@ -2901,6 +3185,305 @@ bool UMcpAutomationBridgeSubsystem::HandleGenerateLODs(
 #endif
 }
 
+// ============================================================================
+// 7b. BATCH LOD + NANITE BUILD
+// ============================================================================
+
+#if WITH_EDITOR
+namespace {
+struct FMcpBatchMeshEntry {
+  FString Path;
+  TWeakObjectPtr<UStaticMesh> Mesh;
+  int32 NumLODs = 0;
+  bool bNanite = false;
+  int32 TrianglesBefore = 0;
+  double FinishedSeconds = -1.0;
+};
+
+struct FMcpBatchMeshBuildState {
+  FString RequestId;
+  TSharedPtr<FMcpBridgeWebSocket> Socket;
+  TArray<FMcpBatchMeshEntry> Entries;
+  TArray<TSharedPtr<FJsonValue>> Failures;
+  double StartSeconds = 0.0;
+  int32 Finished = 0;
+  bool bSave = false;
+};
+} // namespace
+#endif
+
+bool UMcpAutomationBridgeSubsystem::HandleBatchBuildMeshes(
+    const FString &RequestId, const FString &Action,
+    const TSharedPtr<FJsonObject> &Payload,
+    TSharedPtr<FMcpBridgeWebSocket> RequestingSocket) {
+  const FString Lower = Action.ToLower();
+  if (!Lower.Equals(TEXT("batch_build_meshes"), ESearchCase::IgnoreCase)) {
+    return false;
+  }
+
+#if WITH_EDITOR
+  if (!Payload.IsValid()) {
+    SendAutomationError(RequestingSocket, RequestId, TEXT("Payload missing"),
+                        TEXT("INVALID_PAYLOAD"));
+    return true;
+  }
+
+  // Targets: explicit assetPaths, or every static mesh under path matching
+  // an optional name wildcard.
+  TArray<FString> Paths;
+  const TArray<TSharedPtr<FJsonValue>> *AssetPathsArray = nullptr;
+  if (Payload->TryGetArrayField(TEXT("assetPaths"), AssetPathsArray) &&
+      AssetPathsArray) {
+    for (const auto &Val : *AssetPathsArray) {
+      if (Val.IsValid() && Val->Type == EJson::String)
+        Paths.Add(Val->AsString());
+    }
+  }
+
+  FString Folder;
+  Payload->TryGetStringField(TEXT("path"), Folder);
+  if (!Folder.IsEmpty()) {
+    FString NameFilter;
+    Payload->TryGetStringField(TEXT("filter"), NameFilter);
+    bool bRecursive = true;
+    Payload->TryGetBoolField(TEXT("recursive"), bRecursive);
+
+    FARFilter Filter;
+    Filter.PackagePaths.Add(FName(*Folder));
+    Filter.bRecursivePaths = bRecursive;
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 1
+    Filter.ClassPaths.Add(UStaticMesh::StaticClass()->GetClassPathName());
+#else
+    Filter.ClassNames.Add(UStaticMesh::StaticClass()->GetFName());
+#endif
+    FAssetRegistryModule &AssetRegistryModule =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>(
+            "AssetRegistry");
+    TArray<FAssetData> AssetDataList;
+    AssetRegistryModule.Get().GetAssets(Filter, AssetDataList);
+    for (const FAssetData &Data : AssetDataList) {
+      if (!NameFilter.IsEmpty() &&
+          !Data.AssetName.ToString().MatchesWildcard(NameFilter)) {
+        continue;
+      }
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 1
+      Paths.AddUnique(Data.GetSoftObjectPath().ToString());
+#else
+      Paths.AddUnique(Data.ObjectPath.ToString());
+#endif
+    }
+  }
+
+  if (Paths.Num() == 0) {
+    SendAutomationError(RequestingSocket, RequestId,
+                        TEXT("assetPaths or path must select at least one static mesh"),
+                        TEXT("INVALID_ARGUMENT"));
+    return true;
+  }
+
+  // Defaults, overridable per asset through overrides[assetPath]
+  int32 DefaultNumLODs = 4;
+  Payload->TryGetNumberField(TEXT("numLODs"), DefaultNumLODs);
+  const TArray<float> DefaultPercents =
+      McpReadLODPercents(Payload, TArray<float>());
+  bool bNaniteSpecified = Payload->HasField(TEXT("enableNanite"));
+  bool bDefaultNanite = false;
+  Payload->TryGetBoolField(TEXT("enableNanite"), bDefaultNanite);
+  double DefaultKeepPercent = 100.0;
+  double DefaultFallbackPercent = 0.0;
+  Payload->TryGetNumberField(TEXT("trianglePercent"), DefaultKeepPercent);
+  Payload->TryGetNumberField(TEXT("fallbackPercent"), DefaultFallbackPercent);
+  const TSharedPtr<FJsonObject> *OverridesObj = nullptr;
+  Payload->TryGetObjectField(TEXT("overrides"), OverridesObj);
+
+  TSharedRef<FMcpBatchMeshBuildState> State =
+      MakeShared<FMcpBatchMeshBuildState>();
+  State->RequestId = RequestId;
+  State->Socket = RequestingSocket;
+  State->bSave = GetJsonBoolField(Payload, TEXT("save"), false);
+
+  // Configure every mesh on the game thread; this only edits source model
+  // settings and is cheap compared to the build itself.
+  TArray<UStaticMesh *> MeshesToBuild;
+  for (const FString &Path : Paths) {
+    UStaticMesh *Mesh = LoadObject<UStaticMesh>(nullptr, *Path);
+    if (!Mesh) {
+      TSharedPtr<FJsonObject> Failure = MakeShared<FJsonObject>();
+      Failure->SetStringField(TEXT("assetPath"), Path);
+      Failure->SetStringField(TEXT("error"), TEXT("Static mesh not found"));
+      State->Failures.Add(MakeShared<FJsonValueObject>(Failure));
+      continue;
+    }
+
+    TSharedPtr<FJsonObject> Override;
+    if (OverridesObj && OverridesObj->IsValid()) {
+      const TSharedPtr<FJsonObject> *Found = nullptr;
+      if ((*OverridesObj)->TryGetObjectField(Path, Found) && Found) {
+        Override = *Found;
+      }
+    }
+
+    FMcpBatchMeshEntry &Entry = State->Entries.AddDefaulted_GetRef();
+    Entry.Path = Path;
+    Entry.Mesh = Mesh;
+    Entry.TrianglesBefore = McpCountStaticMeshTriangles(Mesh, 0);
+    Entry.NumLODs = FMath::Clamp(
+        Override.IsValid() ? static_cast<int32>(GetJsonNumberField(
+                                 Override, TEXT("numLODs"), DefaultNumLODs))
+                           : DefaultNumLODs,
+        1, MAX_STATIC_MESH_LODS);
+
+    const bool bNanite =
+        Override.IsValid() && Override->HasField(TEXT("enableNanite"))
+            ? GetJsonBoolField(Override, TEXT("enableNanite"))
+            : bDefaultNanite;
+    const bool bApplyNanite =
+        bNaniteSpecified ||
+        (Override.IsValid() && Override->HasField(TEXT("enableNanite")));
+
+    Mesh->Modify();
+    McpConfigureStaticMeshLODs(Mesh, Entry.NumLODs,
+                               McpReadLODPercents(Override, DefaultPercents));
+    if (bApplyNanite) {
+      McpApplyStaticMeshNaniteSettings(
+          Mesh, bNanite, true,
+          FMath::Clamp(GetJsonNumberField(Override, TEXT("trianglePercent"),
+                                          DefaultKeepPercent),
+                       0.0, 100.0),
+          FMath::Clamp(GetJsonNumberField(Override, TEXT("fallbackPercent"),
+                                          DefaultFallbackPercent),
+                       0.0, 100.0));
+    }
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 7
+    Entry.bNanite = Mesh->GetNaniteSettings().bEnabled;
+#else
+    Entry.bNanite = Mesh->NaniteSettings.bEnabled;
+#endif
+    MeshesToBuild.Add(Mesh);
+  }
+
+  if (MeshesToBuild.Num() == 0) {
+    TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
+    Resp->SetArrayField(TEXT("failures"), State->Failures);
+    SendAutomationResponse(RequestingSocket, RequestId, false,
+                           TEXT("No static meshes could be loaded"), Resp,
+                           TEXT("ASSET_NOT_FOUND"));
+    return true;
+  }
+
+  UE_LOG(LogMcpAutomationBridgeSubsystem, Log,
+         TEXT("batch_build_meshes: building %d static meshes"),
+         MeshesToBuild.Num());
+
+  // BatchBuild hands the meshes to the static mesh compiler, which builds
+  // independent meshes concurrently on worker threads and recreates render
+  // state for all affected components once rather than per mesh.
+  State->StartSeconds = FPlatformTime::Seconds();
+  UStaticMesh::BatchBuild(MeshesToBuild, /*bInSilent*/ true);
+
+  // Poll for completion so per-asset progress can stream while the editor
+  // keeps ticking; the final response is sent when the last mesh finishes.
+  TWeakObjectPtr<UMcpAutomationBridgeSubsystem> WeakSubsystem(this);
+  FTSTicker::GetCoreTicker().AddTicker(
+      FTickerDelegate::CreateLambda([WeakSubsystem, State](float) -> bool {
+        UMcpAutomationBridgeSubsystem *Subsystem = WeakSubsystem.Get();
+        if (!Subsystem) {
+          return false;
+        }
+
+        const double Now = FPlatformTime::Seconds();
+        for (FMcpBatchMeshEntry &Entry : State->Entries) {
+          if (Entry.FinishedSeconds >= 0.0) {
+            continue;
+          }
+          UStaticMesh *Mesh = Entry.Mesh.Get();
+          if (Mesh && Mesh->IsCompiling()) {
+            continue;
+          }
+          Entry.FinishedSeconds = Now - State->StartSeconds;
+          ++State->Finished;
+          Subsystem->SendProgressUpdate(
+              State->RequestId,
+              100.0f * State->Finished / State->Entries.Num(),
+              FString::Printf(TEXT("[%d/%d] %s: %d -> %d triangles"),
+                              State->Finished, State->Entries.Num(),
+                              *Entry.Path, Entry.TrianglesBefore,
+                              McpCountStaticMeshTriangles(Mesh, 0)),
+              State->Finished < State->Entries.Num());
+        }
+
+        if (State->Finished < State->Entries.Num()) {
+          return true;
+        }
+
+        TArray<UObject *> Built;
+        TArray<TSharedPtr<FJsonValue>> Results;
+        int64 TotalBefore = 0;
+        int64 TotalAfter = 0;
+        for (const FMcpBatchMeshEntry &Entry : State->Entries) {
+          UStaticMesh *Mesh = Entry.Mesh.Get();
+          TSharedPtr<FJsonObject> Item = MakeShared<FJsonObject>();
+          Item->SetStringField(TEXT("assetPath"), Entry.Path);
+          if (!Mesh) {
+            Item->SetStringField(TEXT("error"), TEXT("Mesh was unloaded during build"));
+            State->Failures.Add(MakeShared<FJsonValueObject>(Item));
+            continue;
+          }
+          Mesh->MarkPackageDirty();
+          Built.Add(Mesh);
+
+          const int32 After = McpCountStaticMeshTriangles(Mesh, 0);
+          TotalBefore += Entry.TrianglesBefore;
+          TotalAfter += After;
+          TArray<TSharedPtr<FJsonValue>> LodTriangles;
+          const FStaticMeshRenderData *RenderData = Mesh->GetRenderData();
+          const int32 NumBuiltLODs = RenderData ? RenderData->LODResources.Num() : 0;
+          for (int32 LODIndex = 0; LODIndex < NumBuiltLODs; ++LODIndex) {
+            LodTriangles.Add(MakeShared<FJsonValueNumber>(
+                McpCountStaticMeshTriangles(Mesh, LODIndex)));
+          }
+          Item->SetNumberField(TEXT("trianglesBefore"), Entry.TrianglesBefore);
+          Item->SetNumberField(TEXT("trianglesAfter"), After);
+          Item->SetArrayField(TEXT("lodTriangles"), LodTriangles);
+          Item->SetBoolField(TEXT("naniteEnabled"), Entry.bNanite);
+          Item->SetNumberField(TEXT("completedMs"), Entry.FinishedSeconds * 1000.0);
+          Results.Add(MakeShared<FJsonValueObject>(Item));
+        }
+
+        // One save pass for the whole batch instead of a save per mesh
+        if (State->bSave && Built.Num() > 0) {
+          UEditorAssetLibrary::SaveLoadedAssets(Built, true);
+        }
+
+        TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
+        Resp->SetBoolField(TEXT("success"), State->Failures.Num() == 0);
+        Resp->SetNumberField(TEXT("processed"), Results.Num());
+        Resp->SetNumberField(TEXT("failed"), State->Failures.Num());
+        Resp->SetNumberField(TEXT("totalTrianglesBefore"), static_cast<double>(TotalBefore));
+        Resp->SetNumberField(TEXT("totalTrianglesAfter"), static_cast<double>(TotalAfter));
+        Resp->SetNumberField(TEXT("elapsedMs"),
+                             (FPlatformTime::Seconds() - State->StartSeconds) * 1000.0);
+        Resp->SetBoolField(TEXT("saved"), State->bSave);
+        Resp->SetArrayField(TEXT("results"), Results);
+        Resp->SetArrayField(TEXT("failures"), State->Failures);
+        Subsystem->SendAutomationResponse(
+            State->Socket, State->RequestId, true,
+            FString::Printf(TEXT("Built %d static meshes (%d failed)"),
+                            Results.Num(), State->Failures.Num()),
+            Resp, FString());
+        return false;
+      }),
+      0.1f);
+
+  return true;
+#else
+  SendAutomationResponse(RequestingSocket, RequestId, false,
+                         TEXT("Requires editor"), nullptr,
+                         TEXT("NOT_IMPLEMENTED"));
+  return true;
+#endif
+}
+
 // ============================================================================
 // 8. METADATA
 // ============================================================================
@@ -3047,41 +3630,8 @@ bool UMcpAutomationBridgeSubsystem::HandleNaniteRebuildMesh(
   TrianglePercent = FMath::Clamp(TrianglePercent, 0.0, 100.0);
   FallbackPercent = FMath::Clamp(FallbackPercent, 0.0, 100.0);
 
-#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 7
-  // UE 5.7+: Use accessor functions to avoid deprecation warnings
-  FMeshNaniteSettings Settings = StaticMesh->GetNaniteSettings();
-  Settings.bEnabled = bEnableNanite;
-  Settings.PositionPrecision = 8; // Default precision
-  
-  // bPreserveArea replaced with ShapePreservation enum
-  if (bPreserveArea) {
-    Settings.ShapePreservation = ENaniteShapePreservation::PreserveArea;
-  } else {
-    Settings.ShapePreservation = ENaniteShapePreservation::None;
-  }
-  Settings.KeepPercentTriangles = static_cast<float>(TrianglePercent / 100.0);
-  Settings.FallbackPercentTriangles = static_cast<float>(FallbackPercent / 100.0);
-  if (FallbackPercent > 0.0) {
-    Settings.GenerateFallback = ENaniteGenerateFallback::Enabled;
-  } else {
-    Settings.GenerateFallback = ENaniteGenerateFallback::PlatformDefault;
-  }
-  StaticMesh->SetNaniteSettings(Settings);
-  StaticMesh->NotifyNaniteSettingsChanged();
-#elif ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1
-  // UE 5.1-5.6: Uses KeepPercentTriangles, FallbackPercentTriangles, and bPreserveArea
-  StaticMesh->NaniteSettings.bEnabled = bEnableNanite;
-  StaticMesh->NaniteSettings.PositionPrecision = 8;
-  StaticMesh->NaniteSettings.bPreserveArea = bPreserveArea;
-  StaticMesh->NaniteSettings.KeepPercentTriangles = static_cast<float>(TrianglePercent / 100.0);
-  StaticMesh->NaniteSettings.FallbackPercentTriangles = static_cast<float>(FallbackPercent / 100.0);
-#else
-  // UE 5.0: Uses KeepPercentTriangles (no bPreserveArea)
-  StaticMesh->NaniteSettings.bEnabled = bEnableNanite;
-  StaticMesh->NaniteSettings.PositionPrecision = 8;
-  StaticMesh->NaniteSettings.KeepPercentTriangles = static_cast<float>(TrianglePercent / 100.0);
-  StaticMesh->NaniteSettings.FallbackPercentTriangles = static_cast<float>(FallbackPercent / 100.0);
-#endif
+  McpApplyStaticMeshNaniteSettings(StaticMesh, bEnableNanite, bPreserveArea,
+                                   TrianglePercent, FallbackPercent);
 
   // Mark mesh as modified
   StaticMesh->MarkPackageDirty();
@@ -0,0 +1,655 @@
+#include "McpAutomationBridgeSubsystem.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "McpAutomationBridgeGlobals.h"
+#include "McpAutomationBridgeHelpers.h"
+#include "McpConnectionManager.h"
+#include "McpTransactionPolicy.h"
+
+#if WITH_EDITOR
+#include "Editor.h"
+#include "ScopedTransaction.h"
+#endif
+
+/**
+ * State of one batch envelope. Items run in order as sub-requests; an item
+ * whose handler answers later (jobs, tasklets, deferred game-thread work)
+ * parks the batch until its response is captured.
+ */
+struct FMcpBatchRun
+{
+    struct FItem
+    {
+        FString Id;
+        FString Action;
+        TSharedPtr<FJsonObject> Payload;
+        FString ItemRequestId;
+
+        bool bDispatched = false;
+        bool bDone = false;
+        bool bSkipped = false;
+        bool bSuccess = false;
+        FString Message;
+        FString ErrorCode;
+        TSharedPtr<FJsonObject> Result;
+        double StartSeconds = 0.0;
+        double EndSeconds = 0.0;
+    };
+
+    FString RequestId;
+    TSharedPtr<FMcpBridgeWebSocket> Socket;
+    /** Named values items can reference besides earlier items, e.g. "tile" for for_each_region. */
+    TSharedPtr<FJsonObject> Context;
+    /** Receives the aggregated result instead of the socket when set. */
+    UMcpAutomationBridgeSubsystem::FBatchCompletion OnComplete;
+    /** Id progress updates are reported under (the outer request for nested runs). */
+    FString ProgressRequestId;
+    TArray<FItem> Items;
+    TMap<FString, int32> IdToIndex;
+    int32 Current = 0;
+
+    bool bStopOnError = true;
+    bool bRollbackOnError = false;
+    bool bHalted = false;
+    bool bWaiting = false;
+    double ItemTimeoutSeconds = 300.0;
+    double StartSeconds = 0.0;
+
+#if WITH_EDITOR
+    TUniquePtr<FScopedTransaction> Transaction;
+#endif
+    bool bTransactional = false;
+    /**
+     * Opened inside another transaction: it only closes with the outer one,
+     * and the editor refuses to undo before then, so it cannot roll back.
+     */
+    bool bNestedTransaction = false;
+};
+
+namespace
+{
+    /** Upper bound on items in one envelope. */
+    constexpr int32 McpMaxBatchItems = 1000;
+
+    /** JSON view of a finished item that later items can reference. */
+    TSharedPtr<FJsonObject> McpBatchItemRefRoot(const FMcpBatchRun::FItem& Item)
+    {
+        TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+        Root->SetBoolField(TEXT("success"), Item.bSuccess);
+        Root->SetStringField(TEXT("message"), Item.Message);
+        Root->SetStringField(TEXT("error"), Item.ErrorCode);
+        Root->SetObjectField(TEXT("result"), Item.Result.IsValid() ? Item.Result : MakeShared<FJsonObject>());
+        return Root;
+    }
+
+    /** Walks "a.b.0.c" through objects and arrays. */
+    TSharedPtr<FJsonValue> McpResolveBatchPath(const TSharedPtr<FJsonObject>& Root, const TArray<FString>& Segments, int32 FirstSegment)
+    {
+        TSharedPtr<FJsonValue> Value = MakeShared<FJsonValueObject>(Root);
+        for (int32 Index = FirstSegment; Index < Segments.Num() && Value.IsValid(); ++Index)
+        {
+            const FString& Segment = Segments[Index];
+            if (Value->Type == EJson::Object)
+            {
+                const TSharedPtr<FJsonValue>* Field = Value->AsObject()->Values.Find(Segment);
+                Value = Field ? *Field : nullptr;
+            }
+            else if (Value->Type == EJson::Array && Segment.IsNumeric())
+            {
+                const TArray<TSharedPtr<FJsonValue>>& Array = Value->AsArray();
+                const int32 ArrayIndex = FCString::Atoi(*Segment);
+                Value = Array.IsValidIndex(ArrayIndex) ? Array[ArrayIndex] : nullptr;
+            }
+            else
+            {
+                Value = nullptr;
+            }
+        }
+        return Value;
+    }
+
+    /**
+     * Resolves "${ref.path}" where ref is an item id or index of an item that
+     * has already finished, e.g. "${spawn.result.actorName}" or "${0.result.path}",
+     * or the name of a context value such as "${tile.center}".
+     */
+    TSharedPtr<FJsonValue> McpResolveBatchRef(const FMcpBatchRun& Run, const FString& Ref, FString& OutError)
+    {
+        TArray<FString> Segments;
+        Ref.ParseIntoArray(Segments, TEXT("."), true);
+        if (Segments.Num() == 0)
+        {
+            OutError = TEXT("empty reference");
+            return nullptr;
+        }
+
+        if (Run.Context.IsValid() && Run.Context->HasField(Segments[0]))
+        {
+            TSharedPtr<FJsonValue> Value = McpResolveBatchPath(Run.Context, Segments, 0);
+            if (!Value.IsValid() || Value->IsNull())
+            {
+                OutError = FString::Printf(TEXT("'%s' not found in context"), *Ref);
+                return nullptr;
+            }
+            return Value;
+        }
+
+        int32 ItemIndex = INDEX_NONE;
+        if (const int32* Found = Run.IdToIndex.Find(Segments[0]))
+        {
+            ItemIndex = *Found;
+        }
+        else if (Segments[0].IsNumeric())
+        {
+            ItemIndex = FCString::Atoi(*Segments[0]);
+        }
+        if (ItemIndex == INDEX_NONE || ItemIndex >= Run.Current || !Run.Items.IsValidIndex(ItemIndex) || !Run.Items[ItemIndex].bDone)
+        {
+            OutError = FString::Printf(TEXT("'%s' does not name an earlier item"), *Segments[0]);
+            return nullptr;
+        }
+
+        TSharedPtr<FJsonValue> Value = McpResolveBatchPath(McpBatchItemRefRoot(Run.Items[ItemIndex]), Segments, 1);
+        if (!Value.IsValid() || Value->IsNull())
+        {
+            OutError = FString::Printf(TEXT("'%s' not found in item %d"), *Ref, ItemIndex);
+            return nullptr;
+        }
+        return Value;
+    }
+
+    /** Deep-copies Value with every "${...}" reference replaced. */
+    TSharedPtr<FJsonValue> McpSubstituteBatchRefs(const FMcpBatchRun& Run, const TSharedPtr<FJsonValue>& Value, FString& OutError)
+    {
+        if (!Value.IsValid())
+        {
+            return Value;
+        }
+        switch (Value->Type)
+        {
+        case EJson::String:
+        {
+            const FString Text = Value->AsString();
+            int32 Open = Text.Find(TEXT("${"));
+            if (Open == INDEX_NONE)
+            {
+                return Value;
+            }
+
+            // A string that is exactly one reference takes the referenced
+            // value as-is, so numbers, arrays and objects keep their type.
+            const int32 Close = Text.Find(TEXT("}"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Open);
+            if (Open == 0 && Close == Text.Len() - 1)
+            {
+                return McpResolveBatchRef(Run, Text.Mid(2, Close - 2), OutError);
+            }
+
+            FString Out;
+            int32 Cursor = 0;
+            while (Open != INDEX_NONE)
+            {
+                const int32 End = Text.Find(TEXT("}"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Open);
+                if (End == INDEX_NONE)
+                {
+                    break;
+                }
+                TSharedPtr<FJsonValue> Resolved = McpResolveBatchRef(Run, Text.Mid(Open + 2, End - Open - 2), OutError);
+                if (!Resolved.IsValid())
+                {
+                    return nullptr;
+                }
+                FString Piece;
+                if (!Resolved->TryGetString(Piece))
+                {
+                    OutError = FString::Printf(TEXT("'%s' is not a scalar and cannot be embedded in a string"), *Text.Mid(Open, End - Open + 1));
+                    return nullptr;
+                }
+                Out += Text.Mid(Cursor, Open - Cursor) + Piece;
+                Cursor = End + 1;
+                Open = Text.Find(TEXT("${"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Cursor);
+            }
+            Out += Text.Mid(Cursor);
+            return MakeShared<FJsonValueString>(Out);
+        }
+        case EJson::Array:
+        {
+            TArray<TSharedPtr<FJsonValue>> Copy;
+            for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+            {
+                TSharedPtr<FJsonValue> Substituted = McpSubstituteBatchRefs(Run, Element, OutError);
+                if (!Substituted.IsValid())
+                {
+                    return nullptr;
+                }
+                Copy.Add(Substituted);
+            }
+            return MakeShared<FJsonValueArray>(Copy);
+        }
+        case EJson::Object:
+        {
+            TSharedPtr<FJsonObject> Copy = MakeShared<FJsonObject>();
+            for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Value->AsObject()->Values)
+            {
+                TSharedPtr<FJsonValue> Substituted = McpSubstituteBatchRefs(Run, Pair.Value, OutError);
+                if (!Substituted.IsValid())
+                {
+                    return nullptr;
+                }
+                Copy->SetField(Pair.Key, Substituted);
+            }
+            return MakeShared<FJsonValueObject>(Copy);
+        }
+        default:
+            return Value;
+        }
+    }
+
+    void McpFailBatchItem(FMcpBatchRun::FItem& Item, const FString& Message, const FString& ErrorCode)
+    {
+        Item.bDone = true;
+        Item.bSuccess = false;
+        Item.Message = Message;
+        Item.ErrorCode = ErrorCode;
+        Item.EndSeconds = FPlatformTime::Seconds();
+    }
+}
+
+/**
+ * Runs a "batch" envelope: an ordered list of {action, payload, id?} items
+ * answered with one aggregated response carrying per-item status and timing.
+ *
+ * Options: "transaction" (bool or description) wraps all items in one undo
+ * transaction (on by default under the coalesced undo policy),
+ * "rollbackOnError" undoes it when any item failed (not possible when the
+ * batch starts inside another open transaction; the response then carries
+ * "rollbackUnavailable"), "stopOnError" (default
+ * true) skips the remaining items after a failure, "itemTimeoutSeconds"
+ * bounds items that answer asynchronously. String values of the form
+ * "${<id or index>.result.<field>}" are replaced with the result of an
+ * earlier item.
+ */
+bool UMcpAutomationBridgeSubsystem::HandleBatchAction(const FString& RequestId, const FString& Action, const TSharedPtr<FJsonObject>& Payload, TSharedPtr<FMcpBridgeWebSocket> RequestingSocket)
+{
+    FString Error;
+    if (!StartBatchRun(RequestId, Payload, RequestingSocket, nullptr, nullptr, Error))
+    {
+        SendAutomationError(RequestingSocket, RequestId, Error, ActiveBatches.Contains(RequestId) ? TEXT("DUPLICATE_REQUEST") : TEXT("INVALID_ARGUMENT"));
+    }
+    return true;
+}
+
+/**
+ * Validates a batch payload and starts running it. The aggregated result goes
+ * to OnComplete when set, otherwise to the socket as the response to RequestId.
+ * Returns false with OutError when the payload is rejected; nothing ran then.
+ */
+bool UMcpAutomationBridgeSubsystem::StartBatchRun(const FString& RequestId, const TSharedPtr<FJsonObject>& Payload, TSharedPtr<FMcpBridgeWebSocket> RequestingSocket,
+                                                  const TSharedPtr<FJsonObject>& Context, FBatchCompletion OnComplete, FString& OutError,
+                                                  const FString& ProgressRequestId)
+{
+    const TArray<TSharedPtr<FJsonValue>>* ItemValues = nullptr;
+    if (!Payload.IsValid() || !Payload->TryGetArrayField(TEXT("items"), ItemValues) || ItemValues->Num() == 0)
+    {
+        OutError = TEXT("items must be a non-empty array.");
+        return false;
+    }
+    if (ItemValues->Num() > McpMaxBatchItems)
+    {
+        OutError = FString::Printf(TEXT("A batch may hold at most %d items."), McpMaxBatchItems);
+        return false;
+    }
+    if (ActiveBatches.Contains(RequestId))
+    {
+        OutError = TEXT("A batch with this requestId is already running.");
+        return false;
+    }
+
+    TSharedPtr<FMcpBatchRun> Run = MakeShared<FMcpBatchRun>();
+    Run->RequestId = RequestId;
+    Run->Socket = RequestingSocket;
+    Run->Context = Context;
+    Run->OnComplete = MoveTemp(OnComplete);
+    Run->ProgressRequestId = ProgressRequestId.IsEmpty() ? RequestId : ProgressRequestId;
+    Run->bStopOnError = GetJsonBoolField(Payload, TEXT("stopOnError"), true);
+    Run->bRollbackOnError = GetJsonBoolField(Payload, TEXT("rollbackOnError"), false);
+    Run->ItemTimeoutSeconds = GetJsonNumberField(Payload, TEXT("itemTimeoutSeconds"), 300.0);
+    Run->StartSeconds = FPlatformTime::Seconds();
+
+    for (int32 Index = 0; Index < ItemValues->Num(); ++Index)
+    {
+        const TSharedPtr<FJsonObject>* ItemObject = nullptr;
+        if (!(*ItemValues)[Index].IsValid() || !(*ItemValues)[Index]->TryGetObject(ItemObject))
+        {
+            OutError = FString::Printf(TEXT("items[%d] must be an object."), Index);
+            return false;
+        }
+
+        FMcpBatchRun::FItem& Item = Run->Items.AddDefaulted_GetRef();
+        Item.Action = GetJsonStringField(*ItemObject, TEXT("action"));
+        Item.Id = GetJsonStringField(*ItemObject, TEXT("id"));
+        Item.ItemRequestId = FString::Printf(TEXT("%s#%d"), *RequestId, Index);
+        const TSharedPtr<FJsonObject>* ItemPayload = nullptr;
+        Item.Payload = (*ItemObject)->TryGetObjectField(TEXT("payload"), ItemPayload) ? *ItemPayload : MakeShared<FJsonObject>();
+
+        if (Item.Action.IsEmpty() || Item.Action.Equals(TEXT("batch"), ESearchCase::IgnoreCase))
+        {
+            OutError = FString::Printf(TEXT("items[%d] needs an action other than batch."), Index);
+            return false;
+        }
+        if (!Item.Id.IsEmpty())
+        {
+            if (Run->IdToIndex.Contains(Item.Id))
+            {
+                OutError = FString::Printf(TEXT("Duplicate item id '%s'."), *Item.Id);
+                return false;
+            }
+            Run->IdToIndex.Add(Item.Id, Index);
+        }
+    }
+
+#if WITH_EDITOR
+    // Under the coalesced undo policy an envelope is one transaction unless
+    // it opts out.
+    bool bTransaction = FMcpTransactionPolicy::Get().GetPolicy(RequestingSocket.Get()) == EMcpTransactionPolicy::Coalesced;
+    FString TransactionDescription = TEXT("MCP Batch");
+    if (const TSharedPtr<FJsonValue>* TransactionValue = Payload->Values.Find(TEXT("transaction")))
+    {
+        if ((*TransactionValue)->Type == EJson::String)
+        {
+            bTransaction = true;
+            TransactionDescription = (*TransactionValue)->AsString();
+        }
+        else if ((*TransactionValue)->Type == EJson::Boolean)
+        {
+            bTransaction = (*TransactionValue)->AsBool();
+        }
+    }
+    if (bTransaction && GEditor)
+    {
+        Run->bNestedTransaction = GEditor->IsTransactionActive();
+        Run->Transaction = MakeUnique<FScopedTransaction>(FText::FromString(TransactionDescription));
+        Run->bTransactional = true;
+    }
+#endif
+
+    UE_LOG(LogMcpAutomationBridgeSubsystem, Log, TEXT("Batch %s: %d item(s)%s"),
+           *RequestId, Run->Items.Num(), Run->bTransactional ? TEXT(" in one transaction") : TEXT(""));
+
+    ActiveBatches.Add(RequestId, Run);
+    RunBatch(Run);
+    return true;
+}
+
+void UMcpAutomationBridgeSubsystem::RunBatch(TSharedPtr<FMcpBatchRun> Run)
+{
+    check(IsInGameThread());
+    Run->bWaiting = false;
+
+    while (Run->Current < Run->Items.Num())
+    {
+        FMcpBatchRun::FItem& Item = Run->Items[Run->Current];
+        if (!Item.bDispatched)
+        {
+            if (Run->bHalted)
+            {
+                Item.bSkipped = true;
+                Item.bDone = true;
+                Run->Current++;
+                continue;
+            }
+
+            Item.bDispatched = true;
+            Item.StartSeconds = FPlatformTime::Seconds();
+
+            FString RefError;
+            TSharedPtr<FJsonValue> Resolved = McpSubstituteBatchRefs(*Run, MakeShared<FJsonValueObject>(Item.Payload), RefError);
+            if (!Resolved.IsValid())
+            {
+                McpFailBatchItem(Item, FString::Printf(TEXT("Unresolved reference: %s"), *RefError), TEXT("UNRESOLVED_REFERENCE"));
+            }
+            else
+            {
+                BatchItemOwners.Add(Item.ItemRequestId, Run->RequestId);
+                // The item may answer synchronously; its response lands in
+                // CaptureBatchItemResponse before this call returns.
+                DispatchAutomationRequest(Item.ItemRequestId, Item.Action, Resolved->AsObject(), Run->Socket);
+            }
+        }
+
+        if (!Item.bDone)
+        {
+            // Answered later; CaptureBatchItemResponse resumes the batch.
+            Run->bWaiting = true;
+            if (Run->bTransactional)
+            {
+                OpenBatchTransactions++;
+            }
+            if (!BatchTickHandle.IsValid())
+            {
+                BatchTickHandle = FTSTicker::GetCoreTicker().AddTicker(
+                    FTickerDelegate::CreateUObject(this, &UMcpAutomationBridgeSubsystem::TickBatches));
+            }
+            SendProgressUpdate(Run->ProgressRequestId, 100.0f * Run->Current / Run->Items.Num(),
+                               FString::Printf(TEXT("batch: waiting on item %d (%s)"), Run->Current, *Item.Action), true);
+            return;
+        }
+
+        if (!Item.bSuccess && Run->bStopOnError)
+        {
+            Run->bHalted = true;
+        }
+        Run->Current++;
+    }
+
+    FinishBatch(Run);
+}
+
+void UMcpAutomationBridgeSubsystem::FinishBatch(TSharedPtr<FMcpBatchRun> Run)
+{
+    ActiveBatches.Remove(Run->RequestId);
+
+    int32 Succeeded = 0;
+    int32 Failed = 0;
+    int32 Skipped = 0;
+    TArray<TSharedPtr<FJsonValue>> ItemResults;
+    for (int32 Index = 0; Index < Run->Items.Num(); ++Index)
+    {
+        const FMcpBatchRun::FItem& Item = Run->Items[Index];
+        TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetNumberField(TEXT("index"), Index);
+        if (!Item.Id.IsEmpty())
+        {
+            Entry->SetStringField(TEXT("id"), Item.Id);
+        }
+        Entry->SetStringField(TEXT("action"), Item.Action);
+        if (Item.bSkipped || !Item.bDone)
+        {
+            Entry->SetStringField(TEXT("status"), TEXT("skipped"));
+            Skipped++;
+        }
+        else
+        {
+            Entry->SetStringField(TEXT("status"), Item.bSuccess ? TEXT("succeeded") : TEXT("failed"));
+            Entry->SetBoolField(TEXT("success"), Item.bSuccess);
+            Entry->SetStringField(TEXT("message"), Item.Message);
+            if (!Item.ErrorCode.IsEmpty())
+            {
+                Entry->SetStringField(TEXT("error"), Item.ErrorCode);
+            }
+            if (Item.Result.IsValid())
+            {
+                Entry->SetObjectField(TEXT("result"), Item.Result);
+            }
+            Entry->SetNumberField(TEXT("durationMs"), (Item.EndSeconds - Item.StartSeconds) * 1000.0);
+            if (Item.bSuccess)
+            {
+                Succeeded++;
+            }
+            else
+            {
+                Failed++;
+            }
+        }
+        ItemResults.Add(MakeShared<FJsonValueObject>(Entry));
+    }
+
+    bool bRolledBack = false;
+    bool bRollbackUnavailable = false;
+#if WITH_EDITOR
+    if (Run->Transaction.IsValid())
+    {
+        Run->Transaction.Reset();
+        if (Failed > 0 && Run->bRollbackOnError && GEditor)
+        {
+            // Undoing here would hit whatever finished last before the outer
+            // transaction, or nothing at all while it is still open.
+            if (Run->bNestedTransaction)
+            {
+                bRollbackUnavailable = true;
+            }
+            else
+            {
+                bRolledBack = GEditor->UndoTransaction();
+            }
+        }
+    }
+#endif
+
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetArrayField(TEXT("items"), ItemResults);
+    Result->SetNumberField(TEXT("succeeded"), Succeeded);
+    Result->SetNumberField(TEXT("failed"), Failed);
+    Result->SetNumberField(TEXT("skipped"), Skipped);
+    Result->SetBoolField(TEXT("transaction"), Run->bTransactional);
+    Result->SetBoolField(TEXT("rolledBack"), bRolledBack);
+    if (bRollbackUnavailable)
+    {
+        Result->SetBoolField(TEXT("rollbackUnavailable"), true);
+    }
+    Result->SetNumberField(TEXT("totalMs"), (FPlatformTime::Seconds() - Run->StartSeconds) * 1000.0);
+
+    const bool bSuccess = Failed == 0 && Skipped == 0;
+    const FString Message = FString::Printf(TEXT("Batch: %d succeeded, %d failed, %d skipped%s"),
+                                            Succeeded, Failed, Skipped,
+                                            bRolledBack ? TEXT(" (rolled back)")
+                                            : bRollbackUnavailable ? TEXT(" (not rolled back: inside another transaction)")
+                                                                   : TEXT(""));
+    const FString ErrorCode = bSuccess ? FString() : TEXT("BATCH_PARTIAL_FAILURE");
+    if (Run->OnComplete)
+    {
+        Run->OnComplete(bSuccess, Message, Result, ErrorCode);
+        return;
+    }
+    SendAutomationResponse(Run->Socket, Run->RequestId, bSuccess, Message, Result, ErrorCode);
+}
+
+bool UMcpAutomationBridgeSubsystem::CaptureBatchItemResponse(const FString& RequestId, bool bSuccess, const FString& Message, const TSharedPtr<FJsonObject>& Result, const FString& ErrorCode)
+{
+    FString BatchRequestId;
+    if (!IsInGameThread() || !BatchItemOwners.RemoveAndCopyValue(RequestId, BatchRequestId))
+    {
+        return false;
+    }
+
+    if (ConnectionManager.IsValid())
+    {
+        ConnectionManager->RecordAutomationTelemetry(RequestId, bSuccess, Message, ErrorCode);
+        ConnectionManager->UnregisterRequestSocket(RequestId);
+    }
+
+    // Late answer from an item that already timed out, or a batch that was shut down.
+    TSharedPtr<FMcpBatchRun>* Found = ActiveBatches.Find(BatchRequestId);
+    if (!Found || !Found->IsValid())
+    {
+        return true;
+    }
+    TSharedPtr<FMcpBatchRun> Run = *Found;
+    if (!Run->Items.IsValidIndex(Run->Current) || Run->Items[Run->Current].ItemRequestId != RequestId || Run->Items[Run->Current].bDone)
+    {
+        return true;
+    }
+
+    FMcpBatchRun::FItem& Item = Run->Items[Run->Current];
+    Item.bDone = true;
+    Item.bSuccess = bSuccess;
+    Item.Message = Message;
+    Item.ErrorCode = ErrorCode;
+    Item.Result = Result;
+    Item.EndSeconds = FPlatformTime::Seconds();
+
+    if (Run->bWaiting)
+    {
+        // Resume outside the item's own response path.
+        if (Run->bTransactional)
+        {
+            OpenBatchTransactions--;
+        }
+        Run->bWaiting = false;
+        TWeakObjectPtr<UMcpAutomationBridgeSubsystem> WeakThis(this);
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Run]()
+        {
+            if (UMcpAutomationBridgeSubsystem* Pinned = WeakThis.Get())
+            {
+                if (Pinned->ActiveBatches.Contains(Run->RequestId))
+                {
+                    Pinned->RunBatch(Run);
+                }
+            }
+        });
+    }
+    return true;
+}
+
+bool UMcpAutomationBridgeSubsystem::TickBatches(float DeltaTime)
+{
+    const double Now = FPlatformTime::Seconds();
+    TArray<TSharedPtr<FMcpBatchRun>> TimedOut;
+    bool bAnyWaiting = false;
+    for (const TPair<FString, TSharedPtr<FMcpBatchRun>>& Pair : ActiveBatches)
+    {
+        const TSharedPtr<FMcpBatchRun>& Run = Pair.Value;
+        if (!Run->bWaiting)
+        {
+            continue;
+        }
+        bAnyWaiting = true;
+        const FMcpBatchRun::FItem& Item = Run->Items[Run->Current];
+        if (Run->ItemTimeoutSeconds > 0.0 && Now - Item.StartSeconds > Run->ItemTimeoutSeconds)
+        {
+            TimedOut.Add(Run);
+        }
+    }
+
+    for (const TSharedPtr<FMcpBatchRun>& Run : TimedOut)
+    {
+        // The owner mapping stays so the late answer is swallowed, not sent.
+        FMcpBatchRun::FItem& Item = Run->Items[Run->Current];
+        McpFailBatchItem(Item, FString::Printf(TEXT("%s did not answer within %.0fs"), *Item.Action, Run->ItemTimeoutSeconds), TEXT("BATCH_ITEM_TIMEOUT"));
+        if (Run->bTransactional)
+        {
+            OpenBatchTransactions--;
+        }
+        RunBatch(Run);
+    }
+
+    if (!bAnyWaiting)
+    {
+        BatchTickHandle.Reset();
+        return false;
+    }
+    return true;
+}
+
+void UMcpAutomationBridgeSubsystem::ShutdownBatches()
+{
+    if (BatchTickHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(BatchTickHandle);
+        BatchTickHandle.Reset();
+    }
+    // Close open transactions; no response is sent since the bridge is going away.
+    ActiveBatches.Empty();
+    BatchItemOwners.Empty();
+    OpenBatchTransactions = 0;
+}
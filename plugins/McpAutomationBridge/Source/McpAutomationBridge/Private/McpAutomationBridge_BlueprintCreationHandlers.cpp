@@ -464,15 +464,7 @@ bool FBlueprintCreationHandlers::HandleBlueprintCreate(
         }
       }
       if (!ResolvedParent) {
-        for (TObjectIterator<UClass> It; It; ++It) {
-          UClass *C = *It;
-          if (!C)
-            continue;
-          if (C->GetName().Equals(ParentClassSpec, ESearchCase::IgnoreCase)) {
-            ResolvedParent = C;
-            break;
-          }
-        }
+        ResolvedParent = FMcpReflectionIndex::Get().FindClass(ParentClassSpec);
       }
     }
   }
@@ -2,6 +2,7 @@
 #include "Dom/JsonObject.h"
 #include "McpAutomationBridgeHelpers.h"
 #include "McpAutomationBridgeSubsystem.h"
+#include "McpTransactionPolicy.h"
 #include "Misc/ScopeExit.h"
 
 #if WITH_EDITOR
@@ -10,6 +11,8 @@
 #include "EdGraph/EdGraphPin.h"
 #include "EdGraph/EdGraphSchema.h"
 #include "EdGraphNode_Comment.h"
+#include "EdGraphSchema_K2.h"
+#include "Editor.h"
 #include "Engine/Blueprint.h"
 #include "K2Node_BreakStruct.h"
 #include "K2Node_CallFunction.h"
@@ -24,11 +27,13 @@
 #include "K2Node_InputAxisEvent.h"
 #include "K2Node_Knot.h"
 #include "K2Node_Literal.h"
+#include "K2Node_MacroInstance.h"
 #include "K2Node_MakeArray.h"
 #include "K2Node_MakeStruct.h"
 #include "K2Node_PromotableOperator.h"
 #include "K2Node_Select.h"
 #include "K2Node_Self.h"
+#include "K2Node_SwitchEnum.h"
 #include "K2Node_Timeline.h"
 #include "K2Node_VariableGet.h"
 #include "K2Node_VariableSet.h"
@@ -41,6 +46,752 @@
 
 #endif
 
+#if WITH_EDITOR
+namespace {
+
+/** Resolves a user-facing node type ("Branch", "Gate", "K2Node_Gate") to a
+ * concrete graph node class. */
+UClass *McpFindNodeClassByName(const FString &TypeName) {
+  // Map user-friendly node names to their K2Node class names
+  static TMap<FString, FString> NodeTypeAliases = {
+      // Flow Control
+      {TEXT("Branch"), TEXT("K2Node_IfThenElse")},
+      {TEXT("IfThenElse"), TEXT("K2Node_IfThenElse")},
+      {TEXT("Sequence"), TEXT("K2Node_ExecutionSequence")},
+      {TEXT("ExecutionSequence"), TEXT("K2Node_ExecutionSequence")},
+      {TEXT("Select"), TEXT("K2Node_Select")},
+      {TEXT("Switch"), TEXT("K2Node_SwitchInteger")},
+      {TEXT("SwitchOnInt"), TEXT("K2Node_SwitchInteger")},
+      {TEXT("SwitchOnEnum"), TEXT("K2Node_SwitchEnum")},
+      {TEXT("SwitchOnString"), TEXT("K2Node_SwitchString")},
+      {TEXT("SwitchOnName"), TEXT("K2Node_SwitchName")},
+      // Flow Control
+      {TEXT("DoOnce"), TEXT("K2Node_DoOnce")},
+      {TEXT("DoN"), TEXT("K2Node_DoN")},
+      {TEXT("FlipFlop"), TEXT("K2Node_FlipFlop")},
+      {TEXT("Gate"), TEXT("K2Node_Gate")},
+      {TEXT("MultiGate"), TEXT("K2Node_MultiGate")},
+      // Loops
+      {TEXT("ForLoop"), TEXT("K2Node_ForLoop")},
+      {TEXT("ForLoopWithBreak"), TEXT("K2Node_ForLoopWithBreak")},
+      {TEXT("ForEachLoop"), TEXT("K2Node_ForEachElementInEnum")},
+      {TEXT("WhileLoop"), TEXT("K2Node_WhileLoop")},
+      // Data
+      {TEXT("MakeArray"), TEXT("K2Node_MakeArray")},
+      {TEXT("MakeStruct"), TEXT("K2Node_MakeStruct")},
+      {TEXT("BreakStruct"), TEXT("K2Node_BreakStruct")},
+      {TEXT("MakeMap"), TEXT("K2Node_MakeMap")},
+      {TEXT("MakeSet"), TEXT("K2Node_MakeSet")},
+      // Actor/Component
+      {TEXT("SpawnActorFromClass"), TEXT("K2Node_SpawnActorFromClass")},
+      {TEXT("GetAllActorsOfClass"), TEXT("K2Node_GetAllActorsOfClass")},
+      // Misc
+      {TEXT("Self"), TEXT("K2Node_Self")},
+      {TEXT("GetSelf"), TEXT("K2Node_Self")},
+      {TEXT("Timeline"), TEXT("K2Node_Timeline")},
+      {TEXT("Knot"), TEXT("K2Node_Knot")},
+      {TEXT("Reroute"), TEXT("K2Node_Knot")},
+      {TEXT("Comment"), TEXT("EdGraphNode_Comment")},
+      // Literals
+      {TEXT("Literal"), TEXT("K2Node_Literal")},
+  };
+
+  // First check for aliases
+  FString ResolvedName = TypeName;
+  if (const FString *Alias = NodeTypeAliases.Find(TypeName)) {
+    ResolvedName = *Alias;
+  }
+
+  TArray<FString> NamesToTry;
+  NamesToTry.Add(ResolvedName);
+  NamesToTry.Add(FString::Printf(TEXT("K2Node_%s"), *ResolvedName));
+  NamesToTry.Add(FString::Printf(TEXT("UK2Node_%s"), *ResolvedName));
+  // Also try the original name if different
+  if (ResolvedName != TypeName) {
+    NamesToTry.Add(TypeName);
+    NamesToTry.Add(FString::Printf(TEXT("K2Node_%s"), *TypeName));
+    NamesToTry.Add(FString::Printf(TEXT("UK2Node_%s"), *TypeName));
+  }
+
+  for (const FString &NameToMatch : NamesToTry) {
+    UClass *Found = FMcpReflectionIndex::Get().FindClass(
+        NameToMatch, UEdGraphNode::StaticClass());
+    if (Found && !Found->HasAnyClassFlags(CLASS_Abstract)) {
+      return Found;
+    }
+  }
+  return nullptr;
+}
+
+/** Function for a CallFunction node: memberClass::memberName, or memberName
+ * on the blueprint itself and then the common libraries. */
+UFunction *McpFindCallFunction(UBlueprint *Blueprint, const FString &MemberName,
+                               const FString &MemberClass) {
+  UFunction *Func = nullptr;
+  if (!MemberClass.IsEmpty()) {
+    if (UClass *Class = ResolveUClass(MemberClass))
+      Func = Class->FindFunctionByName(*MemberName);
+  } else {
+    if (Blueprint->GeneratedClass)
+      Func = Blueprint->GeneratedClass->FindFunctionByName(*MemberName);
+    if (!Func) {
+      if (UClass *KSL = UKismetSystemLibrary::StaticClass())
+        Func = KSL->FindFunctionByName(*MemberName);
+      if (!Func)
+        if (UClass *GPS = UGameplayStatics::StaticClass())
+          Func = GPS->FindFunctionByName(*MemberName);
+      if (!Func)
+        if (UClass *KML = UKismetMathLibrary::StaticClass())
+          Func = KML->FindFunctionByName(*MemberName);
+      // Any other library function, or "Class.Function"
+      if (!Func)
+        Func = FMcpReflectionIndex::Get().FindFunction(MemberName);
+    }
+  }
+  return Func;
+}
+
+/**
+ * Creates one node in Graph from a create_node style description (nodeType,
+ * x, y, comment and the type-specific fields). The blueprint is not marked
+ * modified, so callers adding many nodes can do that once. Returns nullptr
+ * with OutError/OutErrorCode set if the type or its member does not resolve.
+ */
+UEdGraphNode *McpCreateGraphNode(UBlueprint *Blueprint, UEdGraph *Graph,
+                                 const TSharedPtr<FJsonObject> &Spec,
+                                 FString &OutError, FString &OutErrorCode) {
+  FString NodeType;
+  Spec->TryGetStringField(TEXT("nodeType"), NodeType);
+  float X = 0.0f;
+  float Y = 0.0f;
+  Spec->TryGetNumberField(TEXT("x"), X);
+  Spec->TryGetNumberField(TEXT("y"), Y);
+  FString Comment;
+  Spec->TryGetStringField(TEXT("comment"), Comment);
+
+  auto Fail = [&](const FString &Message,
+                  const TCHAR *ErrorCode) -> UEdGraphNode * {
+    OutError = Message;
+    OutErrorCode = ErrorCode;
+    return nullptr;
+  };
+
+  auto Finalize = [&](auto &NodeCreator,
+                      UEdGraphNode *NewNode) -> UEdGraphNode * {
+    // Set position BEFORE finalization per FGraphNodeCreator pattern
+    NewNode->NodePosX = X;
+    NewNode->NodePosY = Y;
+    NewNode->NodeComment = Comment;
+
+    // Finalize() calls CreateNewGuid(), PostPlacedNewNode(), and
+    // AllocateDefaultPins() if pins are empty. Do NOT call
+    // AllocateDefaultPins() again after this!
+    NodeCreator.Finalize();
+    return NewNode;
+  };
+
+  auto HasVariable = [Blueprint](const FName VarFName) {
+    for (const FBPVariableDescription &VarDesc : Blueprint->NewVariables) {
+      if (VarDesc.VarName == VarFName) {
+        return true;
+      }
+    }
+    return Blueprint->GeneratedClass &&
+           Blueprint->GeneratedClass->FindPropertyByName(VarFName) != nullptr;
+  };
+
+  // variableName plus variableScope: "self" (default), "local" (a local of
+  // the function Graph belongs to) or "external" with memberClass.
+  auto ResolveVariable = [&](FMemberReference &OutReference) {
+    FString VarName, Scope, ScopeClass;
+    Spec->TryGetStringField(TEXT("variableName"), VarName);
+    Spec->TryGetStringField(TEXT("variableScope"), Scope);
+    Spec->TryGetStringField(TEXT("memberClass"), ScopeClass);
+    const FName VarFName(*VarName);
+    if (Scope == TEXT("local")) {
+      UEdGraph *FunctionGraph = FBlueprintEditorUtils::GetTopLevelGraph(Graph);
+      const FBPVariableDescription *LocalVar =
+          FBlueprintEditorUtils::FindLocalVariable(Blueprint, FunctionGraph,
+                                                   VarFName);
+      if (!LocalVar) {
+        Fail(FString::Printf(TEXT("Local variable '%s' not found in '%s'"),
+                             *VarName, *FunctionGraph->GetName()),
+             TEXT("VARIABLE_NOT_FOUND"));
+        return false;
+      }
+      OutReference.SetLocalMember(VarFName, FunctionGraph->GetName(),
+                                  LocalVar->VarGuid);
+      return true;
+    }
+    if (Scope == TEXT("external") || !ScopeClass.IsEmpty()) {
+      UClass *OwnerClass = ResolveUClass(ScopeClass);
+      if (!OwnerClass || !OwnerClass->FindPropertyByName(VarFName)) {
+        Fail(FString::Printf(TEXT("Variable '%s' not found on '%s'"), *VarName,
+                             *ScopeClass),
+             TEXT("VARIABLE_NOT_FOUND"));
+        return false;
+      }
+      OutReference.SetExternalMember(VarFName, OwnerClass);
+      return true;
+    }
+    if (!HasVariable(VarFName)) {
+      Fail(FString::Printf(TEXT("Variable '%s' not found"), *VarName),
+           TEXT("VARIABLE_NOT_FOUND"));
+      return false;
+    }
+    OutReference.SetSelfMember(VarFName);
+    return true;
+  };
+
+  // Map common Blueprint node names to their CallFunction equivalents
+  // This allows users to use nodeType="PrintString" instead of CallFunction
+  static TMap<FString, TTuple<FString, FString>> CommonFunctionNodes = {
+      {TEXT("PrintString"),
+       MakeTuple(TEXT("UKismetSystemLibrary"), TEXT("PrintString"))},
+      {TEXT("Print"),
+       MakeTuple(TEXT("UKismetSystemLibrary"), TEXT("PrintString"))},
+      {TEXT("PrintText"),
+       MakeTuple(TEXT("UKismetSystemLibrary"), TEXT("PrintText"))},
+      {TEXT("SetActorLocation"),
+       MakeTuple(TEXT("AActor"), TEXT("K2_SetActorLocation"))},
+      {TEXT("GetActorLocation"),
+       MakeTuple(TEXT("AActor"), TEXT("K2_GetActorLocation"))},
+      {TEXT("SetActorRotation"),
+       MakeTuple(TEXT("AActor"), TEXT("K2_SetActorRotation"))},
+      {TEXT("GetActorRotation"),
+       MakeTuple(TEXT("AActor"), TEXT("K2_GetActorRotation"))},
+      {TEXT("SetActorTransform"),
+       MakeTuple(TEXT("AActor"), TEXT("K2_SetActorTransform"))},
+      {TEXT("GetActorTransform"),
+       MakeTuple(TEXT("AActor"), TEXT("K2_GetActorTransform"))},
+      {TEXT("AddActorLocalOffset"),
+       MakeTuple(TEXT("AActor"), TEXT("K2_AddActorLocalOffset"))},
+      {TEXT("Delay"), MakeTuple(TEXT("UKismetSystemLibrary"), TEXT("Delay"))},
+      {TEXT("DestroyActor"),
+       MakeTuple(TEXT("AActor"), TEXT("K2_DestroyActor"))},
+      {TEXT("SpawnActor"),
+       MakeTuple(TEXT("UGameplayStatics"),
+                 TEXT("BeginDeferredActorSpawnFromClass"))},
+      {TEXT("GetPlayerPawn"),
+       MakeTuple(TEXT("UGameplayStatics"), TEXT("GetPlayerPawn"))},
+      {TEXT("GetPlayerController"),
+       MakeTuple(TEXT("UGameplayStatics"), TEXT("GetPlayerController"))},
+      {TEXT("PlaySound"),
+       MakeTuple(TEXT("UGameplayStatics"), TEXT("PlaySound2D"))},
+      {TEXT("PlaySound2D"),
+       MakeTuple(TEXT("UGameplayStatics"), TEXT("PlaySound2D"))},
+      {TEXT("PlaySoundAtLocation"),
+       MakeTuple(TEXT("UGameplayStatics"), TEXT("PlaySoundAtLocation"))},
+      {TEXT("GetWorldDeltaSeconds"),
+       MakeTuple(TEXT("UGameplayStatics"), TEXT("GetWorldDeltaSeconds"))},
+      {TEXT("SetTimerByFunctionName"),
+       MakeTuple(TEXT("UKismetSystemLibrary"), TEXT("K2_SetTimer"))},
+      {TEXT("ClearTimer"),
+       MakeTuple(TEXT("UKismetSystemLibrary"), TEXT("K2_ClearTimer"))},
+      {TEXT("IsValid"),
+       MakeTuple(TEXT("UKismetSystemLibrary"), TEXT("IsValid"))},
+      {TEXT("IsValidClass"),
+       MakeTuple(TEXT("UKismetSystemLibrary"), TEXT("IsValidClass"))},
+      // Math Nodes
+      {TEXT("Add_IntInt"),
+       MakeTuple(TEXT("UKismetMathLibrary"), TEXT("Add_IntInt"))},
+      {TEXT("Subtract_IntInt"),
+       MakeTuple(TEXT("UKismetMathLibrary"), TEXT("Subtract_IntInt"))},
+      {TEXT("Multiply_IntInt"),
+       MakeTuple(TEXT("UKismetMathLibrary"), TEXT("Multiply_IntInt"))},
+      {TEXT("Divide_IntInt"),
+       MakeTuple(TEXT("UKismetMathLibrary"), TEXT("Divide_IntInt"))},
+      {TEXT("Add_DoubleDouble"),
+       MakeTuple(TEXT("UKismetMathLibrary"), TEXT("Add_DoubleDouble"))},
+      {TEXT("Subtract_DoubleDouble"),
+       MakeTuple(TEXT("UKismetMathLibrary"), TEXT("Subtract_DoubleDouble"))},
+      {TEXT("Multiply_DoubleDouble"),
+       MakeTuple(TEXT("UKismetMathLibrary"), TEXT("Multiply_DoubleDouble"))},
+      {TEXT("Divide_DoubleDouble"),
+       MakeTuple(TEXT("UKismetMathLibrary"), TEXT("Divide_DoubleDouble"))},
+      {TEXT("FTrunc"), MakeTuple(TEXT("UKismetMathLibrary"), TEXT("FTrunc"))},
+      // Vector Ops
+      {TEXT("MakeVector"),
+       MakeTuple(TEXT("UKismetMathLibrary"), TEXT("MakeVector"))},
+      {TEXT("BreakVector"),
+       MakeTuple(TEXT("UKismetMathLibrary"), TEXT("BreakVector"))},
+      // Actor/Component Ops
+      {TEXT("GetComponentByClass"),
+       MakeTuple(TEXT("AActor"), TEXT("GetComponentByClass"))},
+      // Timer
+      {TEXT("GetWorldTimerManager"),
+       MakeTuple(TEXT("UKismetSystemLibrary"), TEXT("K2_GetTimerManager"))}};
+
+  // Check if this is a common function node shortcut
+  if (const auto *FuncInfo = CommonFunctionNodes.Find(NodeType)) {
+    FString ClassName = FuncInfo->Get<0>();
+    FString FuncName = FuncInfo->Get<1>();
+
+    // Find the class and function BEFORE creating NodeCreator
+    // (FGraphNodeCreator asserts in destructor if not finalized)
+    UClass *Class = nullptr;
+    if (ClassName == TEXT("UKismetSystemLibrary")) {
+      Class = UKismetSystemLibrary::StaticClass();
+    } else if (ClassName == TEXT("UGameplayStatics")) {
+      Class = UGameplayStatics::StaticClass();
+    } else if (ClassName == TEXT("AActor")) {
+      Class = AActor::StaticClass();
+    } else if (ClassName == TEXT("UKismetMathLibrary")) {
+      Class = UKismetMathLibrary::StaticClass();
+    } else {
+      Class = ResolveUClass(ClassName);
+    }
+
+    UFunction *Func = nullptr;
+    if (Class) {
+      Func = Class->FindFunctionByName(*FuncName);
+    }
+
+    // Return early with error if function not found (before NodeCreator)
+    if (!Func) {
+      return Fail(
+          FString::Printf(
+              TEXT("Could not find function '%s::%s' for node type '%s'"),
+              *ClassName, *FuncName, *NodeType),
+          TEXT("FUNCTION_NOT_FOUND"));
+    }
+
+    // Now safe to create NodeCreator since we know we'll finalize it
+    FGraphNodeCreator<UK2Node_CallFunction> NodeCreator(*Graph);
+    UK2Node_CallFunction *CallFuncNode = NodeCreator.CreateNode(false);
+    CallFuncNode->SetFromFunction(Func);
+    return Finalize(NodeCreator, CallFuncNode);
+  }
+
+  // Special nodes requiring extra parameters
+  if (NodeType == TEXT("VariableGet") ||
+      NodeType == TEXT("K2Node_VariableGet")) {
+    FMemberReference Reference;
+    if (!ResolveVariable(Reference)) {
+      return nullptr;
+    }
+    FGraphNodeCreator<UK2Node_VariableGet> NodeCreator(*Graph);
+    UK2Node_VariableGet *VarGet = NodeCreator.CreateNode(false);
+    VarGet->VariableReference = Reference;
+    return Finalize(NodeCreator, VarGet);
+  }
+
+  if (NodeType == TEXT("VariableSet") ||
+      NodeType == TEXT("K2Node_VariableSet")) {
+    FMemberReference Reference;
+    if (!ResolveVariable(Reference)) {
+      return nullptr;
+    }
+    FGraphNodeCreator<UK2Node_VariableSet> NodeCreator(*Graph);
+    UK2Node_VariableSet *VarSet = NodeCreator.CreateNode(false);
+    VarSet->VariableReference = Reference;
+    return Finalize(NodeCreator, VarSet);
+  }
+
+  FString MemberName, MemberClass;
+  Spec->TryGetStringField(TEXT("memberName"), MemberName);
+  Spec->TryGetStringField(TEXT("memberClass"), MemberClass);
+
+  if (NodeType == TEXT("CallFunction") ||
+      NodeType == TEXT("K2Node_CallFunction") ||
+      NodeType == TEXT("FunctionCall")) {
+    UFunction *Func = McpFindCallFunction(Blueprint, MemberName, MemberClass);
+    if (!Func) {
+      return Fail(FString::Printf(TEXT("Function '%s' not found"), *MemberName),
+                  TEXT("FUNCTION_NOT_FOUND"));
+    }
+    FGraphNodeCreator<UK2Node_CallFunction> NodeCreator(*Graph);
+    UK2Node_CallFunction *CallFuncNode = NodeCreator.CreateNode(false);
+    CallFuncNode->SetFromFunction(Func);
+    return Finalize(NodeCreator, CallFuncNode);
+  }
+
+  if (NodeType == TEXT("Event") || NodeType == TEXT("K2Node_Event")) {
+    FString EventName;
+    Spec->TryGetStringField(TEXT("eventName"), EventName);
+    if (EventName.IsEmpty()) {
+      return Fail(TEXT("eventName required"), TEXT("INVALID_ARGUMENT"));
+    }
+    static TMap<FString, FString> Aliases = {
+        {TEXT("BeginPlay"), TEXT("ReceiveBeginPlay")},
+        {TEXT("Tick"), TEXT("ReceiveTick")},
+        {TEXT("EndPlay"), TEXT("ReceiveEndPlay")}};
+    if (const FString *A = Aliases.Find(EventName))
+      EventName = *A;
+
+    UClass *TargetClass = nullptr;
+    UFunction *EventFunc = nullptr;
+    if (!MemberClass.IsEmpty()) {
+      TargetClass = ResolveUClass(MemberClass);
+      if (TargetClass)
+        EventFunc = TargetClass->FindFunctionByName(*EventName);
+    } else {
+      for (UClass *C = Blueprint->ParentClass; C && !EventFunc;
+           C = C->GetSuperClass()) {
+        EventFunc =
+            C->FindFunctionByName(*EventName, EIncludeSuperFlag::ExcludeSuper);
+        if (EventFunc)
+          TargetClass = C;
+      }
+    }
+    if (!EventFunc || !TargetClass) {
+      return Fail(FString::Printf(TEXT("Event '%s' not found"), *EventName),
+                  TEXT("EVENT_NOT_FOUND"));
+    }
+    FGraphNodeCreator<UK2Node_Event> NodeCreator(*Graph);
+    UK2Node_Event *EventNode = NodeCreator.CreateNode(false);
+    EventNode->EventReference.SetFromField<UFunction>(EventFunc, false);
+    EventNode->bOverrideFunction = true;
+    return Finalize(NodeCreator, EventNode);
+  }
+
+  if (NodeType == TEXT("CustomEvent") ||
+      NodeType == TEXT("K2Node_CustomEvent")) {
+    FString EventName;
+    Spec->TryGetStringField(TEXT("eventName"), EventName);
+    FGraphNodeCreator<UK2Node_CustomEvent> NodeCreator(*Graph);
+    UK2Node_CustomEvent *EventNode = NodeCreator.CreateNode(false);
+    EventNode->CustomFunctionName = FName(*EventName);
+    return Finalize(NodeCreator, EventNode);
+  }
+
+  if (NodeType == TEXT("Cast") || NodeType.StartsWith(TEXT("CastTo")) ||
+      NodeType == TEXT("K2Node_DynamicCast")) {
+    FString TargetClassName;
+    Spec->TryGetStringField(TEXT("targetClass"), TargetClassName);
+    if (TargetClassName.IsEmpty() && NodeType.StartsWith(TEXT("CastTo")))
+      TargetClassName = NodeType.Mid(6);
+    UClass *TargetClass = ResolveUClass(TargetClassName);
+    if (!TargetClass) {
+      return Fail(
+          FString::Printf(TEXT("Class '%s' not found"), *TargetClassName),
+          TEXT("CLASS_NOT_FOUND"));
+    }
+    FGraphNodeCreator<UK2Node_DynamicCast> NodeCreator(*Graph);
+    UK2Node_DynamicCast *CastNode = NodeCreator.CreateNode(false);
+    CastNode->TargetType = TargetClass;
+    return Finalize(NodeCreator, CastNode);
+  }
+
+  if (NodeType == TEXT("InputAxisEvent") ||
+      NodeType == TEXT("K2Node_InputAxisEvent")) {
+    FString InputAxisName;
+    Spec->TryGetStringField(TEXT("inputAxisName"), InputAxisName);
+    if (InputAxisName.IsEmpty()) {
+      return Fail(TEXT("inputAxisName required"), TEXT("INVALID_ARGUMENT"));
+    }
+    FGraphNodeCreator<UK2Node_InputAxisEvent> NodeCreator(*Graph);
+    UK2Node_InputAxisEvent *InputNode = NodeCreator.CreateNode(false);
+    InputNode->InputAxisName = FName(*InputAxisName);
+    return Finalize(NodeCreator, InputNode);
+  }
+
+  // ========== DYNAMIC FALLBACK: Create ANY node class by name ==========
+  UClass *NodeClass = McpFindNodeClassByName(NodeType);
+  if (!NodeClass) {
+    return Fail(FString::Printf(TEXT("Node type '%s' not found. Use "
+                                     "list_node_types to see available types."),
+                                *NodeType),
+                TEXT("NODE_TYPE_NOT_FOUND"));
+  }
+
+  // Function-call subclasses (operators, array functions) need their
+  // function before pins are allocated.
+  UFunction *Func = nullptr;
+  if (!MemberName.IsEmpty() &&
+      NodeClass->IsChildOf(UK2Node_CallFunction::StaticClass())) {
+    Func = McpFindCallFunction(Blueprint, MemberName, MemberClass);
+    if (!Func) {
+      return Fail(FString::Printf(TEXT("Function '%s' not found"), *MemberName),
+                  TEXT("FUNCTION_NOT_FOUND"));
+    }
+  }
+
+  // Likewise the macro, struct or enum that decides a node's pins.
+  UEdGraph *MacroGraph = nullptr;
+  if (NodeClass->IsChildOf(UK2Node_MacroInstance::StaticClass())) {
+    const FString MacroPath = GetJsonStringField(Spec, TEXT("macroGraph"));
+    MacroGraph = MacroPath.IsEmpty()
+                     ? nullptr
+                     : LoadObject<UEdGraph>(nullptr, *MacroPath);
+    if (!MacroGraph) {
+      return Fail(FString::Printf(TEXT("Macro graph '%s' not found"),
+                                  *MacroPath),
+                  TEXT("MACRO_NOT_FOUND"));
+    }
+  }
+  UScriptStruct *StructType = nullptr;
+  if (NodeClass->IsChildOf(UK2Node_StructOperation::StaticClass())) {
+    const FString StructName = GetJsonStringField(Spec, TEXT("structType"));
+    StructType = FMcpReflectionIndex::Get().FindStruct(StructName);
+    if (!StructType && StructName.StartsWith(TEXT("/"))) {
+      StructType = LoadObject<UScriptStruct>(nullptr, *StructName);
+    }
+    if (!StructType) {
+      return Fail(FString::Printf(TEXT("Struct '%s' not found"), *StructName),
+                  TEXT("STRUCT_NOT_FOUND"));
+    }
+  }
+  UEnum *SwitchEnum = nullptr;
+  if (NodeClass->IsChildOf(UK2Node_SwitchEnum::StaticClass())) {
+    const FString EnumName = GetJsonStringField(Spec, TEXT("enum"));
+    SwitchEnum = FMcpReflectionIndex::Get().FindEnum(EnumName);
+    if (!SwitchEnum && EnumName.StartsWith(TEXT("/"))) {
+      SwitchEnum = LoadObject<UEnum>(nullptr, *EnumName);
+    }
+    if (!SwitchEnum) {
+      return Fail(FString::Printf(TEXT("Enum '%s' not found"), *EnumName),
+                  TEXT("ENUM_NOT_FOUND"));
+    }
+  }
+
+  UEdGraphNode *NewNode = NewObject<UEdGraphNode>(Graph, NodeClass);
+  if (!NewNode) {
+    return Fail(TEXT("Failed to instantiate node."), TEXT("CREATE_FAILED"));
+  }
+  Graph->AddNode(NewNode, false, false);
+  NewNode->CreateNewGuid();
+  if (Func) {
+    CastChecked<UK2Node_CallFunction>(NewNode)->SetFromFunction(Func);
+  }
+  if (MacroGraph) {
+    CastChecked<UK2Node_MacroInstance>(NewNode)->SetMacroGraph(MacroGraph);
+  }
+  if (StructType) {
+    CastChecked<UK2Node_StructOperation>(NewNode)->StructType = StructType;
+  }
+  if (SwitchEnum) {
+    CastChecked<UK2Node_SwitchEnum>(NewNode)->SetEnum(SwitchEnum);
+  }
+  NewNode->PostPlacedNewNode();
+  NewNode->AllocateDefaultPins();
+  NewNode->NodePosX = X;
+  NewNode->NodePosY = Y;
+  NewNode->NodeComment = Comment;
+  return NewNode;
+}
+
+/** Path for memberClass fields; empty for members of the blueprint itself. */
+FString McpExportMemberClass(UBlueprint *Blueprint, UClass *Class) {
+  if (!Class || UBlueprint::GetBlueprintFromClass(Class) == Blueprint) {
+    return FString();
+  }
+  return Class->GetAuthoritativeClass()->GetPathName();
+}
+
+/** Writes variableName and, unless it is a member of self, variableScope. */
+void McpExportVariableReference(UBlueprint *Blueprint,
+                                const FMemberReference &Reference,
+                                const TSharedPtr<FJsonObject> &NodeObj) {
+  NodeObj->SetStringField(TEXT("variableName"),
+                          Reference.GetMemberName().ToString());
+  if (Reference.IsLocalScope()) {
+    NodeObj->SetStringField(TEXT("variableScope"), TEXT("local"));
+  } else if (!Reference.IsSelfContext()) {
+    const FString MemberClass =
+        McpExportMemberClass(Blueprint, Reference.GetMemberParentClass());
+    if (!MemberClass.IsEmpty()) {
+      NodeObj->SetStringField(TEXT("variableScope"), TEXT("external"));
+      NodeObj->SetStringField(TEXT("memberClass"), MemberClass);
+    }
+  }
+}
+
+/**
+ * Describes Node in the apply_graph_patch node format: the fields
+ * McpCreateGraphNode needs to recreate it, position, comment and the
+ * non-default values of unlinked input pins. Returns nullptr with OutError
+ * set for nodes whose state that format cannot carry (timelines, selects
+ * with an enum or extra options, bound events), so an export never silently
+ * loses them.
+ */
+TSharedPtr<FJsonObject> McpExportGraphNode(UBlueprint *Blueprint,
+                                           UEdGraphNode *Node,
+                                           FString &OutError) {
+  bool bCustomSelect = false;
+  if (UK2Node_Select *SelectNode = Cast<UK2Node_Select>(Node)) {
+    TArray<UEdGraphPin *> OptionPins;
+    SelectNode->GetOptionPins(OptionPins);
+    bCustomSelect = SelectNode->GetEnum() || OptionPins.Num() != 2;
+  }
+  if (Node->IsA<UK2Node_Timeline>() || bCustomSelect ||
+      (Node->IsA<UK2Node_Event>() &&
+       Node->GetClass() != UK2Node_Event::StaticClass() &&
+       !Node->IsA<UK2Node_CustomEvent>() &&
+       !Node->IsA<UK2Node_InputAxisEvent>())) {
+    OutError = FString::Printf(TEXT("%s (%s)"), *Node->GetName(),
+                               *Node->GetClass()->GetName());
+    return nullptr;
+  }
+
+  TSharedPtr<FJsonObject> NodeObj = MakeShared<FJsonObject>();
+  NodeObj->SetStringField(TEXT("id"), Node->NodeGuid.ToString());
+
+  FString NodeType = Node->GetClass()->GetName();
+  if (UK2Node_CallFunction *CallNode = Cast<UK2Node_CallFunction>(Node)) {
+    if (Node->GetClass() == UK2Node_CallFunction::StaticClass()) {
+      NodeType = TEXT("CallFunction");
+    }
+    if (UFunction *Func = CallNode->GetTargetFunction()) {
+      NodeObj->SetStringField(TEXT("memberName"), Func->GetName());
+      const FString MemberClass =
+          McpExportMemberClass(Blueprint, Func->GetOwnerClass());
+      if (!MemberClass.IsEmpty()) {
+        NodeObj->SetStringField(TEXT("memberClass"), MemberClass);
+      }
+    }
+  } else if (UK2Node_VariableGet *VarGet = Cast<UK2Node_VariableGet>(Node)) {
+    NodeType = TEXT("VariableGet");
+    McpExportVariableReference(Blueprint, VarGet->VariableReference, NodeObj);
+  } else if (UK2Node_VariableSet *VarSet = Cast<UK2Node_VariableSet>(Node)) {
+    NodeType = TEXT("VariableSet");
+    McpExportVariableReference(Blueprint, VarSet->VariableReference, NodeObj);
+  } else if (UK2Node_MacroInstance *MacroNode =
+                 Cast<UK2Node_MacroInstance>(Node)) {
+    if (UEdGraph *MacroGraph = MacroNode->GetMacroGraph()) {
+      NodeObj->SetStringField(TEXT("macroGraph"), MacroGraph->GetPathName());
+    }
+  } else if (UK2Node_StructOperation *StructNode =
+                 Cast<UK2Node_StructOperation>(Node)) {
+    if (StructNode->StructType) {
+      NodeObj->SetStringField(TEXT("structType"),
+                              StructNode->StructType->GetPathName());
+    }
+  } else if (UK2Node_SwitchEnum *SwitchNode = Cast<UK2Node_SwitchEnum>(Node)) {
+    if (SwitchNode->Enum) {
+      NodeObj->SetStringField(TEXT("enum"), SwitchNode->Enum->GetPathName());
+    }
+  } else if (UK2Node_CustomEvent *CustomEvent =
+                 Cast<UK2Node_CustomEvent>(Node)) {
+    NodeType = TEXT("CustomEvent");
+    NodeObj->SetStringField(TEXT("eventName"),
+                            CustomEvent->CustomFunctionName.ToString());
+  } else if (UK2Node_InputAxisEvent *AxisEvent =
+                 Cast<UK2Node_InputAxisEvent>(Node)) {
+    NodeType = TEXT("InputAxisEvent");
+    NodeObj->SetStringField(TEXT("inputAxisName"),
+                            AxisEvent->InputAxisName.ToString());
+  } else if (Node->GetClass() == UK2Node_Event::StaticClass()) {
+    UK2Node_Event *EventNode = CastChecked<UK2Node_Event>(Node);
+    NodeType = TEXT("Event");
+    NodeObj->SetStringField(
+        TEXT("eventName"),
+        EventNode->EventReference.GetMemberName().ToString());
+    const FString MemberClass = McpExportMemberClass(
+        Blueprint, EventNode->EventReference.GetMemberParentClass());
+    if (!MemberClass.IsEmpty()) {
+      NodeObj->SetStringField(TEXT("memberClass"), MemberClass);
+    }
+  } else if (Node->GetClass() == UK2Node_DynamicCast::StaticClass()) {
+    UK2Node_DynamicCast *CastNode = CastChecked<UK2Node_DynamicCast>(Node);
+    NodeType = TEXT("Cast");
+    if (CastNode->TargetType) {
+      NodeObj->SetStringField(TEXT("targetClass"),
+                              CastNode->TargetType->GetPathName());
+    }
+  }
+  NodeObj->SetStringField(TEXT("nodeType"), NodeType);
+  NodeObj->SetNumberField(TEXT("x"), Node->NodePosX);
+  NodeObj->SetNumberField(TEXT("y"), Node->NodePosY);
+  if (!Node->NodeComment.IsEmpty()) {
+    NodeObj->SetStringField(TEXT("comment"), Node->NodeComment);
+  }
+
+  TSharedPtr<FJsonObject> PinDefaults = MakeShared<FJsonObject>();
+  for (UEdGraphPin *Pin : Node->Pins) {
+    if (!Pin || Pin->Direction != EGPD_Input || Pin->bHidden ||
+        Pin->LinkedTo.Num() > 0 ||
+        Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec ||
+        Pin->DoesDefaultValueMatchAutogenerated()) {
+      continue;
+    }
+    PinDefaults->SetStringField(Pin->PinName.ToString(),
+                                Pin->GetDefaultAsString());
+  }
+  if (PinDefaults->Values.Num() > 0) {
+    NodeObj->SetObjectField(TEXT("pinDefaults"), PinDefaults);
+  }
+  return NodeObj;
+}
+
+/**
+ * { nodes, links } for Nodes in the format apply_graph_patch accepts. Links
+ * are listed once, from the output side; links into Nodes from nodes outside
+ * the set are kept and refer to those nodes by guid. Returns nullptr with
+ * OutError naming every node the format cannot describe.
+ */
+TSharedPtr<FJsonObject>
+McpExportGraphNodes(UBlueprint *Blueprint, const TArray<UEdGraphNode *> &Nodes,
+                    FString &OutError) {
+  TSet<UEdGraphNode *> NodeSet;
+  NodeSet.Append(Nodes);
+  TArray<TSharedPtr<FJsonValue>> NodesJson;
+  TArray<TSharedPtr<FJsonValue>> LinksJson;
+
+  auto AddLink = [&LinksJson](UEdGraphPin *From, UEdGraphPin *To) {
+    TSharedPtr<FJsonObject> LinkObj = MakeShared<FJsonObject>();
+    LinkObj->SetStringField(TEXT("from"),
+                            From->GetOwningNode()->NodeGuid.ToString());
+    LinkObj->SetStringField(TEXT("fromPin"), From->PinName.ToString());
+    LinkObj->SetStringField(TEXT("to"),
+                            To->GetOwningNode()->NodeGuid.ToString());
+    LinkObj->SetStringField(TEXT("toPin"), To->PinName.ToString());
+    LinksJson.Add(MakeShared<FJsonValueObject>(LinkObj));
+  };
+
+  for (UEdGraphNode *Node : Nodes) {
+    if (!Node) {
+      continue;
+    }
+    FString Unsupported;
+    TSharedPtr<FJsonObject> NodeObj =
+        McpExportGraphNode(Blueprint, Node, Unsupported);
+    if (!NodeObj.IsValid()) {
+      OutError += OutError.IsEmpty() ? Unsupported : TEXT(", ") + Unsupported;
+      continue;
+    }
+    NodesJson.Add(MakeShared<FJsonValueObject>(NodeObj));
+    for (UEdGraphPin *Pin : Node->Pins) {
+      if (!Pin) {
+        continue;
+      }
+      for (UEdGraphPin *LinkedPin : Pin->LinkedTo) {
+        if (!LinkedPin || !LinkedPin->GetOwningNode()) {
+          continue;
+        }
+        if (Pin->Direction == EGPD_Output) {
+          AddLink(Pin, LinkedPin);
+        } else if (!NodeSet.Contains(LinkedPin->GetOwningNode())) {
+          AddLink(LinkedPin, Pin);
+        }
+      }
+    }
+  }
+
+  if (!OutError.IsEmpty()) {
+    OutError = FString::Printf(
+        TEXT("Graph export cannot describe these nodes: %s"), *OutError);
+    return nullptr;
+  }
+
+  TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+  Result->SetArrayField(TEXT("nodes"), NodesJson);
+  Result->SetArrayField(TEXT("links"), LinksJson);
+  return Result;
+}
+
+/** Pin by name, preferring the given direction (some nodes reuse names). */
+UEdGraphPin *McpFindPatchPin(UEdGraphNode *Node, const FString &PinName,
+                             EEdGraphPinDirection Direction) {
+  if (UEdGraphPin *Pin = Node->FindPin(*PinName, Direction)) {
+    return Pin;
+  }
+  return Node->FindPin(*PinName);
+}
+
+} // namespace
+#endif
+
 /**
  * Process a "manage_blueprint_graph" automation request to inspect or modify a
  * Blueprint graph.
@@ -48,9 +799,11 @@
  * The Payload JSON controls the specific operation via the "subAction" field
  * (examples: create_node, connect_pins, get_nodes, break_pin_links,
  * delete_node, create_reroute_node, set_node_property, get_node_details,
- * get_graph_details, get_pin_details). In editor builds this function performs
- * graph/blueprint lookups and edits; in non-editor builds it reports an
- * editor-only error.
+ * get_graph_details, get_pin_details). apply_graph_patch applies a whole
+ * nodes/links/pinDefaults description with client-side ids in one transaction
+ * and compile; export_graph returns a graph in that same format. In editor
+ * builds this function performs graph/blueprint lookups and edits; in
+ * non-editor builds it reports an editor-only error.
  *
  * @param RequestId Unique identifier for the automation request (used in
  * responses).
@@ -192,470 +945,388 @@ bool UMcpAutomationBridgeSubsystem::HandleBlueprintGraphAction(
     Blueprint->Modify();
     TargetGraph->Modify();
 
-    FString NodeType;
-    Payload->TryGetStringField(TEXT("nodeType"), NodeType);
-    float X = 0.0f;
-    float Y = 0.0f;
-    Payload->TryGetNumberField(TEXT("x"), X);
-    Payload->TryGetNumberField(TEXT("y"), Y);
-
-    // Helper to finalize and report
-    auto FinalizeAndReport = [&](auto &NodeCreator, UEdGraphNode *NewNode) {
-      if (NewNode) {
-        // Set position BEFORE finalization per FGraphNodeCreator pattern
-        NewNode->NodePosX = X;
-        NewNode->NodePosY = Y;
-
-        // Finalize() calls CreateNewGuid(), PostPlacedNewNode(), and
-        // AllocateDefaultPins() if pins are empty. Do NOT call
-        // AllocateDefaultPins() again after this!
-        NodeCreator.Finalize();
-
-        FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+    FString Error, ErrorCode;
+    UEdGraphNode *NewNode =
+        McpCreateGraphNode(Blueprint, TargetGraph, Payload, Error, ErrorCode);
+    if (!NewNode) {
+      SendAutomationError(RequestingSocket, RequestId, Error, ErrorCode);
+      return true;
+    }
 
-        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
-        Result->SetStringField(TEXT("nodeId"), NewNode->NodeGuid.ToString());
-        Result->SetStringField(TEXT("nodeName"), NewNode->GetName());
-        SendAutomationResponse(RequestingSocket, RequestId, true,
-                               TEXT("Node created."), Result);
-      } else {
-        SendAutomationError(
-            RequestingSocket, RequestId,
-            TEXT("Failed to create node (unsupported type or internal error)."),
-            TEXT("CREATE_FAILED"));
-      }
-    };
+    FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
 
-    // Map common Blueprint node names to their CallFunction equivalents
-    // This allows users to use nodeType="PrintString" instead of CallFunction
-    static TMap<FString, TTuple<FString, FString>> CommonFunctionNodes = {
-        {TEXT("PrintString"),
-         MakeTuple(TEXT("UKismetSystemLibrary"), TEXT("PrintString"))},
-        {TEXT("Print"),
-         MakeTuple(TEXT("UKismetSystemLibrary"), TEXT("PrintString"))},
-        {TEXT("PrintText"),
-         MakeTuple(TEXT("UKismetSystemLibrary"), TEXT("PrintText"))},
-        {TEXT("SetActorLocation"),
-         MakeTuple(TEXT("AActor"), TEXT("K2_SetActorLocation"))},
-        {TEXT("GetActorLocation"),
-         MakeTuple(TEXT("AActor"), TEXT("K2_GetActorLocation"))},
-        {TEXT("SetActorRotation"),
-         MakeTuple(TEXT("AActor"), TEXT("K2_SetActorRotation"))},
-        {TEXT("GetActorRotation"),
-         MakeTuple(TEXT("AActor"), TEXT("K2_GetActorRotation"))},
-        {TEXT("SetActorTransform"),
-         MakeTuple(TEXT("AActor"), TEXT("K2_SetActorTransform"))},
-        {TEXT("GetActorTransform"),
-         MakeTuple(TEXT("AActor"), TEXT("K2_GetActorTransform"))},
-        {TEXT("AddActorLocalOffset"),
-         MakeTuple(TEXT("AActor"), TEXT("K2_AddActorLocalOffset"))},
-        {TEXT("Delay"), MakeTuple(TEXT("UKismetSystemLibrary"), TEXT("Delay"))},
-        {TEXT("DestroyActor"),
-         MakeTuple(TEXT("AActor"), TEXT("K2_DestroyActor"))},
-        {TEXT("SpawnActor"),
-         MakeTuple(TEXT("UGameplayStatics"),
-                   TEXT("BeginDeferredActorSpawnFromClass"))},
-        {TEXT("GetPlayerPawn"),
-         MakeTuple(TEXT("UGameplayStatics"), TEXT("GetPlayerPawn"))},
-        {TEXT("GetPlayerController"),
-         MakeTuple(TEXT("UGameplayStatics"), TEXT("GetPlayerController"))},
-        {TEXT("PlaySound"),
-         MakeTuple(TEXT("UGameplayStatics"), TEXT("PlaySound2D"))},
-        {TEXT("PlaySound2D"),
-         MakeTuple(TEXT("UGameplayStatics"), TEXT("PlaySound2D"))},
-        {TEXT("PlaySoundAtLocation"),
-         MakeTuple(TEXT("UGameplayStatics"), TEXT("PlaySoundAtLocation"))},
-        {TEXT("GetWorldDeltaSeconds"),
-         MakeTuple(TEXT("UGameplayStatics"), TEXT("GetWorldDeltaSeconds"))},
-        {TEXT("SetTimerByFunctionName"),
-         MakeTuple(TEXT("UKismetSystemLibrary"), TEXT("K2_SetTimer"))},
-        {TEXT("ClearTimer"),
-         MakeTuple(TEXT("UKismetSystemLibrary"), TEXT("K2_ClearTimer"))},
-        {TEXT("IsValid"),
-         MakeTuple(TEXT("UKismetSystemLibrary"), TEXT("IsValid"))},
-        {TEXT("IsValidClass"),
-         MakeTuple(TEXT("UKismetSystemLibrary"), TEXT("IsValidClass"))},
-        // Math Nodes
-        {TEXT("Add_IntInt"),
-         MakeTuple(TEXT("UKismetMathLibrary"), TEXT("Add_IntInt"))},
-        {TEXT("Subtract_IntInt"),
-         MakeTuple(TEXT("UKismetMathLibrary"), TEXT("Subtract_IntInt"))},
-        {TEXT("Multiply_IntInt"),
-         MakeTuple(TEXT("UKismetMathLibrary"), TEXT("Multiply_IntInt"))},
-        {TEXT("Divide_IntInt"),
-         MakeTuple(TEXT("UKismetMathLibrary"), TEXT("Divide_IntInt"))},
-        {TEXT("Add_DoubleDouble"),
-         MakeTuple(TEXT("UKismetMathLibrary"), TEXT("Add_DoubleDouble"))},
-        {TEXT("Subtract_DoubleDouble"),
-         MakeTuple(TEXT("UKismetMathLibrary"), TEXT("Subtract_DoubleDouble"))},
-        {TEXT("Multiply_DoubleDouble"),
-         MakeTuple(TEXT("UKismetMathLibrary"), TEXT("Multiply_DoubleDouble"))},
-        {TEXT("Divide_DoubleDouble"),
-         MakeTuple(TEXT("UKismetMathLibrary"), TEXT("Divide_DoubleDouble"))},
-        {TEXT("FTrunc"), MakeTuple(TEXT("UKismetMathLibrary"), TEXT("FTrunc"))},
-        // Vector Ops
-        {TEXT("MakeVector"),
-         MakeTuple(TEXT("UKismetMathLibrary"), TEXT("MakeVector"))},
-        {TEXT("BreakVector"),
-         MakeTuple(TEXT("UKismetMathLibrary"), TEXT("BreakVector"))},
-        // Actor/Component Ops
-        {TEXT("GetComponentByClass"),
-         MakeTuple(TEXT("AActor"), TEXT("GetComponentByClass"))},
-        // Timer
-        {TEXT("GetWorldTimerManager"),
-         MakeTuple(TEXT("UKismetSystemLibrary"), TEXT("K2_GetTimerManager"))}};
-
-    // Check if this is a common function node shortcut
-    if (const auto *FuncInfo = CommonFunctionNodes.Find(NodeType)) {
-      FString ClassName = FuncInfo->Get<0>();
-      FString FuncName = FuncInfo->Get<1>();
-
-      // Find the class and function BEFORE creating NodeCreator
-      // (FGraphNodeCreator asserts in destructor if not finalized)
-      UClass *Class = nullptr;
-      if (ClassName == TEXT("UKismetSystemLibrary")) {
-        Class = UKismetSystemLibrary::StaticClass();
-      } else if (ClassName == TEXT("UGameplayStatics")) {
-        Class = UGameplayStatics::StaticClass();
-      } else if (ClassName == TEXT("AActor")) {
-        Class = AActor::StaticClass();
-      } else if (ClassName == TEXT("UKismetMathLibrary")) {
-        Class = UKismetMathLibrary::StaticClass();
-      } else {
-        Class = ResolveUClass(ClassName);
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetStringField(TEXT("nodeId"), NewNode->NodeGuid.ToString());
+    Result->SetStringField(TEXT("nodeName"), NewNode->GetName());
+    Result->SetStringField(TEXT("nodeClass"), NewNode->GetClass()->GetName());
+    SendAutomationResponse(RequestingSocket, RequestId, true,
+                           TEXT("Node created."), Result);
+    return true;
+  } else if (SubAction == TEXT("apply_graph_patch")) {
+    // Builds or edits a graph in one request: removeNodes, then nodes
+    // (created when they carry nodeType, otherwise existing nodes to move),
+    // then links, then pinDefaults. Everything shares one transaction; the
+    // touched nodes are reconstructed once, the blueprint is marked
+    // structurally modified once and compiled once.
+    const TArray<TSharedPtr<FJsonValue>> *NodeSpecs = nullptr;
+    const TArray<TSharedPtr<FJsonValue>> *LinkSpecs = nullptr;
+    const TArray<TSharedPtr<FJsonValue>> *RemoveSpecs = nullptr;
+    Payload->TryGetArrayField(TEXT("nodes"), NodeSpecs);
+    Payload->TryGetArrayField(TEXT("links"), LinkSpecs);
+    Payload->TryGetArrayField(TEXT("removeNodes"), RemoveSpecs);
+    if (!NodeSpecs && !LinkSpecs && !RemoveSpecs) {
+      SendAutomationError(
+          RequestingSocket, RequestId,
+          TEXT("apply_graph_patch requires 'nodes', 'links' or 'removeNodes'."),
+          TEXT("INVALID_ARGUMENT"));
+      return true;
+    }
+    const bool bAtomic = GetJsonBoolField(Payload, TEXT("atomic"), true);
+    const bool bCompile = GetJsonBoolField(Payload, TEXT("compile"), true);
+
+    // Nested in another transaction (a batch item, usually) the editor
+    // will not undo ours until the outer one closes, so keep a copy of
+    // everything the patch can change to restore instead.
+    TUniquePtr<FMcpTransactionSnapshot> Snapshot;
+    if (bAtomic && GEditor && GEditor->IsTransactionActive()) {
+      Snapshot = MakeUnique<FMcpTransactionSnapshot>();
+      Snapshot->Save(Blueprint);
+      Snapshot->Save(TargetGraph);
+      for (UEdGraphNode *Node : TargetGraph->Nodes) {
+        Snapshot->Save(Node);
       }
+    }
 
-      UFunction *Func = nullptr;
-      if (Class) {
-        Func = Class->FindFunctionByName(*FuncName);
-      }
+    TUniquePtr<FScopedTransaction> Transaction =
+        MakeUnique<FScopedTransaction>(
+            FText::FromString(TEXT("Apply Blueprint Graph Patch")));
+    Blueprint->Modify();
+    TargetGraph->Modify();
+    const UEdGraphSchema *Schema = TargetGraph->GetSchema();
 
-      // Return early with error if function not found (before NodeCreator)
-      if (!Func) {
-        SendAutomationError(
-            RequestingSocket, RequestId,
-            FString::Printf(
-                TEXT("Could not find function '%s::%s' for node type '%s'"),
-                *ClassName, *FuncName, *NodeType),
-            TEXT("FUNCTION_NOT_FOUND"));
-        return true;
+    // Client ids from this patch win over guids/names already in the graph.
+    TMap<FString, UEdGraphNode *> PatchNodes;
+    TArray<UEdGraphNode *> PatchOrder;
+    TArray<UEdGraphNode *> TouchedNodes;
+    TArray<TPair<UEdGraphNode *, TSharedPtr<FJsonObject>>> PendingDefaults;
+    TArray<TSharedPtr<FJsonValue>> Errors;
+    int32 Created = 0, Updated = 0, Removed = 0, Linked = 0, DefaultsSet = 0;
+
+    auto AddError = [&](const TCHAR *Stage, int32 Index, const FString &Id,
+                        const FString &Message, const FString &ErrorCode) {
+      TSharedPtr<FJsonObject> ErrorObj = MakeShared<FJsonObject>();
+      ErrorObj->SetStringField(TEXT("stage"), Stage);
+      ErrorObj->SetNumberField(TEXT("index"), Index);
+      if (!Id.IsEmpty()) {
+        ErrorObj->SetStringField(TEXT("id"), Id);
       }
-
-      // Now safe to create NodeCreator since we know we'll finalize it
-      FGraphNodeCreator<UK2Node_CallFunction> NodeCreator(*TargetGraph);
-      UK2Node_CallFunction *CallFuncNode = NodeCreator.CreateNode(false);
-      CallFuncNode->SetFromFunction(Func);
-      FinalizeAndReport(NodeCreator, CallFuncNode);
-      return true;
-    }
-
-    // ========================================================================
-    // DYNAMIC NODE CREATION - Find node classes at runtime
-    // ========================================================================
-
-    // Map user-friendly node names to their K2Node class names
-    static TMap<FString, FString> NodeTypeAliases = {
-        // Flow Control
-        {TEXT("Branch"), TEXT("K2Node_IfThenElse")},
-        {TEXT("IfThenElse"), TEXT("K2Node_IfThenElse")},
-        {TEXT("Sequence"), TEXT("K2Node_ExecutionSequence")},
-        {TEXT("ExecutionSequence"), TEXT("K2Node_ExecutionSequence")},
-        {TEXT("Select"), TEXT("K2Node_Select")},
-        {TEXT("Switch"), TEXT("K2Node_SwitchInteger")},
-        {TEXT("SwitchOnInt"), TEXT("K2Node_SwitchInteger")},
-        {TEXT("SwitchOnEnum"), TEXT("K2Node_SwitchEnum")},
-        {TEXT("SwitchOnString"), TEXT("K2Node_SwitchString")},
-        {TEXT("SwitchOnName"), TEXT("K2Node_SwitchName")},
-        // Flow Control
-        {TEXT("DoOnce"), TEXT("K2Node_DoOnce")},
-        {TEXT("DoN"), TEXT("K2Node_DoN")},
-        {TEXT("FlipFlop"), TEXT("K2Node_FlipFlop")},
-        {TEXT("Gate"), TEXT("K2Node_Gate")},
-        {TEXT("MultiGate"), TEXT("K2Node_MultiGate")},
-        // Loops
-        {TEXT("ForLoop"), TEXT("K2Node_ForLoop")},
-        {TEXT("ForLoopWithBreak"), TEXT("K2Node_ForLoopWithBreak")},
-        {TEXT("ForEachLoop"), TEXT("K2Node_ForEachElementInEnum")},
-        {TEXT("WhileLoop"), TEXT("K2Node_WhileLoop")},
-        // Data
-        {TEXT("MakeArray"), TEXT("K2Node_MakeArray")},
-        {TEXT("MakeStruct"), TEXT("K2Node_MakeStruct")},
-        {TEXT("BreakStruct"), TEXT("K2Node_BreakStruct")},
-        {TEXT("MakeMap"), TEXT("K2Node_MakeMap")},
-        {TEXT("MakeSet"), TEXT("K2Node_MakeSet")},
-        // Actor/Component
-        {TEXT("SpawnActorFromClass"), TEXT("K2Node_SpawnActorFromClass")},
-        {TEXT("GetAllActorsOfClass"), TEXT("K2Node_GetAllActorsOfClass")},
-        // Misc
-        {TEXT("Self"), TEXT("K2Node_Self")},
-        {TEXT("GetSelf"), TEXT("K2Node_Self")},
-        {TEXT("Timeline"), TEXT("K2Node_Timeline")},
-        {TEXT("Knot"), TEXT("K2Node_Knot")},
-        {TEXT("Reroute"), TEXT("K2Node_Knot")},
-        {TEXT("Comment"), TEXT("EdGraphNode_Comment")},
-        // Literals
-        {TEXT("Literal"), TEXT("K2Node_Literal")},
+      ErrorObj->SetStringField(TEXT("message"), Message);
+      ErrorObj->SetStringField(TEXT("error"), ErrorCode);
+      Errors.Add(MakeShared<FJsonValueObject>(ErrorObj));
     };
-
-    // Helper: Try to find a UK2Node subclass by name
-    auto FindNodeClassByName = [](const FString &TypeName) -> UClass * {
-      // First check for aliases
-      FString ResolvedName = TypeName;
-      if (const FString *Alias = NodeTypeAliases.Find(TypeName)) {
-        ResolvedName = *Alias;
+    auto ShouldStop = [&]() { return bAtomic && Errors.Num() > 0; };
+    auto ResolveNode = [&](const FString &Id) -> UEdGraphNode * {
+      if (UEdGraphNode *const *Found = PatchNodes.Find(Id)) {
+        return *Found;
       }
+      return FindNodeByIdOrName(Id);
+    };
 
-      TArray<FString> NamesToTry;
-      NamesToTry.Add(ResolvedName);
-      NamesToTry.Add(FString::Printf(TEXT("K2Node_%s"), *ResolvedName));
-      NamesToTry.Add(FString::Printf(TEXT("UK2Node_%s"), *ResolvedName));
-      // Also try the original name if different
-      if (ResolvedName != TypeName) {
-        NamesToTry.Add(TypeName);
-        NamesToTry.Add(FString::Printf(TEXT("K2Node_%s"), *TypeName));
-        NamesToTry.Add(FString::Printf(TEXT("UK2Node_%s"), *TypeName));
+    if (RemoveSpecs) {
+      for (int32 Index = 0; Index < RemoveSpecs->Num() && !ShouldStop();
+           ++Index) {
+        const FString Id = (*RemoveSpecs)[Index]->AsString();
+        UEdGraphNode *Node = FindNodeByIdOrName(Id);
+        if (!Node) {
+          AddError(TEXT("removeNodes"), Index, Id, TEXT("Node not found."),
+                   TEXT("NODE_NOT_FOUND"));
+          continue;
+        }
+        FBlueprintEditorUtils::RemoveNode(Blueprint, Node, true);
+        ++Removed;
       }
+    }
 
-      for (TObjectIterator<UClass> It; It; ++It) {
-        if (!It->IsChildOf(UEdGraphNode::StaticClass()))
+    if (NodeSpecs) {
+      for (int32 Index = 0; Index < NodeSpecs->Num() && !ShouldStop();
+           ++Index) {
+        const TSharedPtr<FJsonObject> Spec = (*NodeSpecs)[Index]->AsObject();
+        if (!Spec.IsValid()) {
+          AddError(TEXT("nodes"), Index, FString(),
+                   TEXT("Node entry must be an object."),
+                   TEXT("INVALID_ARGUMENT"));
           continue;
-        if (It->HasAnyClassFlags(CLASS_Abstract))
+        }
+        const FString Id = GetJsonStringField(Spec, TEXT("id"));
+        if (!Id.IsEmpty() && PatchNodes.Contains(Id)) {
+          AddError(TEXT("nodes"), Index, Id,
+                   TEXT("Duplicate node id in patch."),
+                   TEXT("INVALID_ARGUMENT"));
           continue;
+        }
 
-        FString ClassName = It->GetName();
-        for (const FString &NameToMatch : NamesToTry) {
-          if (ClassName.Equals(NameToMatch, ESearchCase::IgnoreCase)) {
-            return *It;
+        UEdGraphNode *Node = nullptr;
+        bool bCreated = false;
+        if (Spec->HasField(TEXT("nodeType"))) {
+          // A function graph has exactly one entry node; map an exported
+          // entry/result onto the one already there instead of adding another.
+          const UClass *NodeClass = McpFindNodeClassByName(
+              GetJsonStringField(Spec, TEXT("nodeType")));
+          if (NodeClass &&
+              (NodeClass->IsChildOf(UK2Node_FunctionEntry::StaticClass()) ||
+               NodeClass->IsChildOf(UK2Node_FunctionResult::StaticClass()))) {
+            for (UEdGraphNode *Existing : TargetGraph->Nodes) {
+              if (Existing && Existing->IsA(NodeClass) &&
+                  !PatchOrder.Contains(Existing)) {
+                Node = Existing;
+                break;
+              }
+            }
           }
+          if (!Node) {
+            FString Error, ErrorCode;
+            Node = McpCreateGraphNode(Blueprint, TargetGraph, Spec, Error,
+                                      ErrorCode);
+            if (!Node) {
+              AddError(TEXT("nodes"), Index, Id, Error, ErrorCode);
+              continue;
+            }
+            ++Created;
+            bCreated = true;
+            TouchedNodes.Add(Node);
+          } else {
+            ++Updated;
+          }
+        } else {
+          Node = FindNodeByIdOrName(Id);
+          if (!Node) {
+            AddError(TEXT("nodes"), Index, Id,
+                     TEXT("Node not found (entries without nodeType refer to "
+                          "existing nodes)."),
+                     TEXT("NODE_NOT_FOUND"));
+            continue;
+          }
+          ++Updated;
         }
-      }
-      return nullptr;
-    };
 
-    // Special nodes requiring extra parameters
-    if (NodeType == TEXT("VariableGet") ||
-        NodeType == TEXT("K2Node_VariableGet")) {
-      FString VarName;
-      Payload->TryGetStringField(TEXT("variableName"), VarName);
-      FName VarFName(*VarName);
-      bool bFound = false;
-      for (const FBPVariableDescription &VarDesc : Blueprint->NewVariables) {
-        if (VarDesc.VarName == VarFName) {
-          bFound = true;
-          break;
+        if (!bCreated) {
+          // Existing node: only the fields that were sent change.
+          Node->Modify();
+          double Coord = 0.0;
+          if (Spec->TryGetNumberField(TEXT("x"), Coord)) {
+            Node->NodePosX = static_cast<int32>(Coord);
+          }
+          if (Spec->TryGetNumberField(TEXT("y"), Coord)) {
+            Node->NodePosY = static_cast<int32>(Coord);
+          }
+          FString Comment;
+          if (Spec->TryGetStringField(TEXT("comment"), Comment)) {
+            Node->NodeComment = Comment;
+          }
         }
-      }
-      if (!bFound && Blueprint->GeneratedClass &&
-          Blueprint->GeneratedClass->FindPropertyByName(VarFName)) {
-        bFound = true;
-      }
-      if (!bFound) {
-        SendAutomationError(
-            RequestingSocket, RequestId,
-            FString::Printf(TEXT("Variable '%s' not found"), *VarName),
-            TEXT("VARIABLE_NOT_FOUND"));
-        return true;
-      }
-      FGraphNodeCreator<UK2Node_VariableGet> NodeCreator(*TargetGraph);
-      UK2Node_VariableGet *VarGet = NodeCreator.CreateNode(false);
-      VarGet->VariableReference.SetSelfMember(VarFName);
-      FinalizeAndReport(NodeCreator, VarGet);
-      return true;
-    }
 
-    if (NodeType == TEXT("VariableSet") ||
-        NodeType == TEXT("K2Node_VariableSet")) {
-      FString VarName;
-      Payload->TryGetStringField(TEXT("variableName"), VarName);
-      FName VarFName(*VarName);
-      bool bFound = false;
-      for (const FBPVariableDescription &VarDesc : Blueprint->NewVariables) {
-        if (VarDesc.VarName == VarFName) {
-          bFound = true;
-          break;
+        PatchNodes.Add(Id.IsEmpty() ? Node->NodeGuid.ToString() : Id, Node);
+        PatchOrder.AddUnique(Node);
+        const TSharedPtr<FJsonObject> *PinDefaults = nullptr;
+        if (Spec->TryGetObjectField(TEXT("pinDefaults"), PinDefaults)) {
+          PendingDefaults.Emplace(Node, *PinDefaults);
         }
       }
-      if (!bFound && Blueprint->GeneratedClass &&
-          Blueprint->GeneratedClass->FindPropertyByName(VarFName)) {
-        bFound = true;
-      }
-      if (!bFound) {
-        SendAutomationError(
-            RequestingSocket, RequestId,
-            FString::Printf(TEXT("Variable '%s' not found"), *VarName),
-            TEXT("VARIABLE_NOT_FOUND"));
-        return true;
-      }
-      FGraphNodeCreator<UK2Node_VariableSet> NodeCreator(*TargetGraph);
-      UK2Node_VariableSet *VarSet = NodeCreator.CreateNode(false);
-      VarSet->VariableReference.SetSelfMember(VarFName);
-      FinalizeAndReport(NodeCreator, VarSet);
-      return true;
     }
 
-    if (NodeType == TEXT("CallFunction") ||
-        NodeType == TEXT("K2Node_CallFunction") ||
-        NodeType == TEXT("FunctionCall")) {
-      FString MemberName, MemberClass;
-      Payload->TryGetStringField(TEXT("memberName"), MemberName);
-      Payload->TryGetStringField(TEXT("memberClass"), MemberClass);
-      UFunction *Func = nullptr;
-      if (!MemberClass.IsEmpty()) {
-        if (UClass *Class = ResolveUClass(MemberClass))
-          Func = Class->FindFunctionByName(*MemberName);
-      } else {
-        Func = Blueprint->GeneratedClass->FindFunctionByName(*MemberName);
-        if (!Func) {
-          if (UClass *KSL = UKismetSystemLibrary::StaticClass())
-            Func = KSL->FindFunctionByName(*MemberName);
-          if (!Func)
-            if (UClass *GPS = UGameplayStatics::StaticClass())
-              Func = GPS->FindFunctionByName(*MemberName);
-          if (!Func)
-            if (UClass *KML = UKismetMathLibrary::StaticClass())
-              Func = KML->FindFunctionByName(*MemberName);
+    if (LinkSpecs) {
+      for (int32 Index = 0; Index < LinkSpecs->Num() && !ShouldStop();
+           ++Index) {
+        const TSharedPtr<FJsonObject> LinkObj = (*LinkSpecs)[Index]->AsObject();
+        if (!LinkObj.IsValid()) {
+          AddError(TEXT("links"), Index, FString(),
+                   TEXT("Link entry must be an object."),
+                   TEXT("INVALID_ARGUMENT"));
+          continue;
         }
+        // { from, fromPin, to, toPin } or { from: "id.pin", to: "id.pin" }
+        const FString From = GetJsonStringField(LinkObj, TEXT("from"));
+        const FString To = GetJsonStringField(LinkObj, TEXT("to"));
+        FString FromId = From;
+        FString FromPinName = GetJsonStringField(LinkObj, TEXT("fromPin"));
+        FString ToId = To;
+        FString ToPinName = GetJsonStringField(LinkObj, TEXT("toPin"));
+        if (FromPinName.IsEmpty()) {
+          From.Split(TEXT("."), &FromId, &FromPinName,
+                     ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+        }
+        if (ToPinName.IsEmpty()) {
+          To.Split(TEXT("."), &ToId, &ToPinName, ESearchCase::CaseSensitive,
+                   ESearchDir::FromEnd);
+        }
+        const FString LinkLabel = FString::Printf(
+            TEXT("%s.%s -> %s.%s"), *FromId, *FromPinName, *ToId, *ToPinName);
+
+        UEdGraphNode *FromNode = ResolveNode(FromId);
+        UEdGraphNode *ToNode = ResolveNode(ToId);
+        if (!FromNode || !ToNode) {
+          AddError(TEXT("links"), Index, LinkLabel,
+                   TEXT("Could not find source or target node."),
+                   TEXT("NODE_NOT_FOUND"));
+          continue;
+        }
+        UEdGraphPin *FromPin =
+            McpFindPatchPin(FromNode, FromPinName, EGPD_Output);
+        UEdGraphPin *ToPin = McpFindPatchPin(ToNode, ToPinName, EGPD_Input);
+        if (!FromPin || !ToPin) {
+          AddError(TEXT("links"), Index, LinkLabel,
+                   TEXT("Could not find source or target pin."),
+                   TEXT("PIN_NOT_FOUND"));
+          continue;
+        }
+
+        FromNode->Modify();
+        ToNode->Modify();
+        if (!Schema->TryCreateConnection(FromPin, ToPin)) {
+          AddError(TEXT("links"), Index, LinkLabel,
+                   Schema->CanCreateConnection(FromPin, ToPin)
+                       .Message.ToString(),
+                   TEXT("CONNECTION_FAILED"));
+          continue;
+        }
+        ++Linked;
+        TouchedNodes.AddUnique(FromNode);
+        TouchedNodes.AddUnique(ToNode);
       }
-      if (Func) {
-        FGraphNodeCreator<UK2Node_CallFunction> NodeCreator(*TargetGraph);
-        UK2Node_CallFunction *CallFuncNode = NodeCreator.CreateNode(false);
-        CallFuncNode->SetFromFunction(Func);
-        FinalizeAndReport(NodeCreator, CallFuncNode);
-      } else {
-        SendAutomationError(
-            RequestingSocket, RequestId,
-            FString::Printf(TEXT("Function '%s' not found"), *MemberName),
-            TEXT("FUNCTION_NOT_FOUND"));
-      }
-      return true;
     }
 
-    if (NodeType == TEXT("Event") || NodeType == TEXT("K2Node_Event")) {
-      FString EventName, MemberClass;
-      Payload->TryGetStringField(TEXT("eventName"), EventName);
-      Payload->TryGetStringField(TEXT("memberClass"), MemberClass);
-      if (EventName.IsEmpty()) {
-        SendAutomationError(RequestingSocket, RequestId,
-                            TEXT("eventName required"),
-                            TEXT("INVALID_ARGUMENT"));
-        return true;
+    if (!ShouldStop()) {
+      // Once per node, after all of its links exist, so wildcard and
+      // promotable pins settle on their final types before defaults land.
+      for (UEdGraphNode *Node : TouchedNodes) {
+        Node->ReconstructNode();
       }
-      static TMap<FString, FString> Aliases = {
-          {TEXT("BeginPlay"), TEXT("ReceiveBeginPlay")},
-          {TEXT("Tick"), TEXT("ReceiveTick")},
-          {TEXT("EndPlay"), TEXT("ReceiveEndPlay")}};
-      if (const FString *A = Aliases.Find(EventName))
-        EventName = *A;
-
-      UClass *TargetClass = nullptr;
-      UFunction *EventFunc = nullptr;
-      if (!MemberClass.IsEmpty()) {
-        TargetClass = ResolveUClass(MemberClass);
-        if (TargetClass)
-          EventFunc = TargetClass->FindFunctionByName(*EventName);
-      } else {
-        for (UClass *C = Blueprint->ParentClass; C && !EventFunc;
-             C = C->GetSuperClass()) {
-          EventFunc = C->FindFunctionByName(*EventName,
-                                            EIncludeSuperFlag::ExcludeSuper);
-          if (EventFunc)
-            TargetClass = C;
+    }
+
+    for (int32 Index = 0; Index < PendingDefaults.Num() && !ShouldStop();
+         ++Index) {
+      UEdGraphNode *Node = PendingDefaults[Index].Key;
+      for (const auto &Entry : PendingDefaults[Index].Value->Values) {
+        UEdGraphPin *Pin = McpFindPatchPin(Node, Entry.Key, EGPD_Input);
+        const FString Label = FString::Printf(
+            TEXT("%s.%s"), *Node->NodeGuid.ToString(), *Entry.Key);
+        FString Value;
+        if (!Pin || Pin->Direction != EGPD_Input) {
+          AddError(TEXT("pinDefaults"), Index, Label,
+                   TEXT("Input pin not found."), TEXT("PIN_NOT_FOUND"));
+        } else if (!Entry.Value.IsValid() ||
+                   !Entry.Value->TryGetString(Value)) {
+          AddError(TEXT("pinDefaults"), Index, Label,
+                   TEXT("Pin default must be a string, number or bool."),
+                   TEXT("INVALID_ARGUMENT"));
+        } else {
+          // Marking per pin would re-run the modified notifications this
+          // sub-action exists to batch.
+          Schema->TrySetDefaultValue(*Pin, Value, false);
+          ++DefaultsSet;
+        }
+        if (ShouldStop()) {
+          break;
         }
       }
-      if (EventFunc && TargetClass) {
-        FGraphNodeCreator<UK2Node_Event> NodeCreator(*TargetGraph);
-        UK2Node_Event *EventNode = NodeCreator.CreateNode(false);
-        EventNode->EventReference.SetFromField<UFunction>(EventFunc, false);
-        EventNode->bOverrideFunction = true;
-        FinalizeAndReport(NodeCreator, EventNode);
+    }
+
+    if (ShouldStop()) {
+      // Same rollback as batch transactions: close the transaction, then
+      // undo it as a whole, or restore the snapshot when it was nested.
+      const bool bRecorded = Transaction->IsOutstanding();
+      Transaction.Reset();
+      bool bRolledBack = false;
+      if (Snapshot.IsValid()) {
+        bRolledBack = Snapshot->Restore();
+        FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
       } else {
-        SendAutomationError(
-            RequestingSocket, RequestId,
-            FString::Printf(TEXT("Event '%s' not found"), *EventName),
-            TEXT("EVENT_NOT_FOUND"));
+        bRolledBack = bRecorded && GEditor && GEditor->UndoTransaction();
       }
+      TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+      Result->SetArrayField(TEXT("errors"), Errors);
+      Result->SetBoolField(TEXT("rolledBack"), bRolledBack);
+      SendAutomationResponse(
+          RequestingSocket, RequestId, false,
+          FString::Printf(TEXT("Graph patch failed%s: %s"),
+                          bRolledBack ? TEXT(" (rolled back)") : TEXT(""),
+                          *Errors[0]->AsObject()->GetStringField(
+                              TEXT("message"))),
+          Result, TEXT("GRAPH_PATCH_FAILED"));
       return true;
     }
 
-    if (NodeType == TEXT("CustomEvent") ||
-        NodeType == TEXT("K2Node_CustomEvent")) {
-      FString EventName;
-      Payload->TryGetStringField(TEXT("eventName"), EventName);
-      FGraphNodeCreator<UK2Node_CustomEvent> NodeCreator(*TargetGraph);
-      UK2Node_CustomEvent *EventNode = NodeCreator.CreateNode(false);
-      EventNode->CustomFunctionName = FName(*EventName);
-      FinalizeAndReport(NodeCreator, EventNode);
-      return true;
+    FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+    Transaction.Reset();
+    if (bCompile) {
+      FKismetEditorUtilities::CompileBlueprint(Blueprint);
     }
 
-    if (NodeType == TEXT("Cast") || NodeType.StartsWith(TEXT("CastTo"))) {
-      FString TargetClassName;
-      Payload->TryGetStringField(TEXT("targetClass"), TargetClassName);
-      if (TargetClassName.IsEmpty() && NodeType.StartsWith(TEXT("CastTo")))
-        TargetClassName = NodeType.Mid(6);
-      UClass *TargetClass = ResolveUClass(TargetClassName);
-      if (!TargetClass) {
-        SendAutomationError(
-            RequestingSocket, RequestId,
-            FString::Printf(TEXT("Class '%s' not found"), *TargetClassName),
-            TEXT("CLASS_NOT_FOUND"));
-        return true;
-      }
-      FGraphNodeCreator<UK2Node_DynamicCast> NodeCreator(*TargetGraph);
-      UK2Node_DynamicCast *CastNode = NodeCreator.CreateNode(false);
-      CastNode->TargetType = TargetClass;
-      FinalizeAndReport(NodeCreator, CastNode);
-      return true;
+    TSharedPtr<FJsonObject> IdMap = MakeShared<FJsonObject>();
+    for (const TPair<FString, UEdGraphNode *> &Pair : PatchNodes) {
+      IdMap->SetStringField(Pair.Key, Pair.Value->NodeGuid.ToString());
     }
 
-    if (NodeType == TEXT("InputAxisEvent") ||
-        NodeType == TEXT("K2Node_InputAxisEvent")) {
-      FString InputAxisName;
-      Payload->TryGetStringField(TEXT("inputAxisName"), InputAxisName);
-      if (InputAxisName.IsEmpty()) {
-        SendAutomationError(RequestingSocket, RequestId,
-                            TEXT("inputAxisName required"),
-                            TEXT("INVALID_ARGUMENT"));
-        return true;
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetStringField(TEXT("graphName"), TargetGraph->GetName());
+    Result->SetObjectField(TEXT("idMap"), IdMap);
+    Result->SetNumberField(TEXT("created"), Created);
+    Result->SetNumberField(TEXT("updated"), Updated);
+    Result->SetNumberField(TEXT("removed"), Removed);
+    Result->SetNumberField(TEXT("linked"), Linked);
+    Result->SetNumberField(TEXT("pinDefaultsSet"), DefaultsSet);
+    Result->SetBoolField(TEXT("compiled"), bCompile);
+    if (bCompile) {
+      Result->SetBoolField(TEXT("compileErrors"),
+                           Blueprint->Status == BS_Error);
+    }
+    if (GetJsonBoolField(Payload, TEXT("returnExport"), true)) {
+      // The patch is already applied; an unexportable node only costs the
+      // export, not the result.
+      FString ExportError;
+      if (TSharedPtr<FJsonObject> Export =
+              McpExportGraphNodes(Blueprint, PatchOrder, ExportError)) {
+        Result->SetObjectField(TEXT("export"), Export);
+      } else {
+        Result->SetStringField(TEXT("exportError"), ExportError);
       }
-      FGraphNodeCreator<UK2Node_InputAxisEvent> NodeCreator(*TargetGraph);
-      UK2Node_InputAxisEvent *InputNode = NodeCreator.CreateNode(false);
-      InputNode->InputAxisName = FName(*InputAxisName);
-      FinalizeAndReport(NodeCreator, InputNode);
-      return true;
+    }
+    if (Errors.Num() > 0) {
+      Result->SetArrayField(TEXT("errors"), Errors);
     }
 
-    // ========== DYNAMIC FALLBACK: Create ANY node class by name ==========
-    UClass *NodeClass = FindNodeClassByName(NodeType);
-    if (NodeClass) {
-      UEdGraphNode *NewNode = NewObject<UEdGraphNode>(TargetGraph, NodeClass);
-      if (NewNode) {
-        TargetGraph->AddNode(NewNode, false, false);
-        NewNode->CreateNewGuid();
-        NewNode->PostPlacedNewNode();
-        NewNode->AllocateDefaultPins();
-        NewNode->NodePosX = X;
-        NewNode->NodePosY = Y;
-        FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
-        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
-        Result->SetStringField(TEXT("nodeId"), NewNode->NodeGuid.ToString());
-        Result->SetStringField(TEXT("nodeName"), NewNode->GetName());
-        Result->SetStringField(TEXT("nodeClass"), NodeClass->GetName());
-        SendAutomationResponse(RequestingSocket, RequestId, true,
-                               TEXT("Node created."), Result);
-      } else {
-        SendAutomationError(RequestingSocket, RequestId,
-                            TEXT("Failed to instantiate node."),
-                            TEXT("CREATE_FAILED"));
+    const bool bSuccess = Errors.Num() == 0;
+    FString Message = FString::Printf(
+        TEXT("Graph patch applied: %d created, %d updated, %d removed, %d "
+             "linked"),
+        Created, Updated, Removed, Linked);
+    if (!bSuccess) {
+      Message += FString::Printf(TEXT(", %d errors"), Errors.Num());
+    }
+    SendAutomationResponse(RequestingSocket, RequestId, bSuccess, Message,
+                           Result,
+                           bSuccess ? FString() : TEXT("GRAPH_PATCH_PARTIAL"));
+    return true;
+  } else if (SubAction == TEXT("export_graph")) {
+    // The whole graph in apply_graph_patch form; applying it to another
+    // graph recreates the nodes, links and pin defaults.
+    TArray<UEdGraphNode *> Nodes;
+    for (UEdGraphNode *Node : TargetGraph->Nodes) {
+      if (Node) {
+        Nodes.Add(Node);
       }
-    } else {
-      SendAutomationError(
-          RequestingSocket, RequestId,
-          FString::Printf(TEXT("Node type '%s' not found. Use list_node_types "
-                               "to see available types."),
-                          *NodeType),
-          TEXT("NODE_TYPE_NOT_FOUND"));
     }
+    FString ExportError;
+    TSharedPtr<FJsonObject> Result =
+        McpExportGraphNodes(Blueprint, Nodes, ExportError);
+    if (!Result.IsValid()) {
+      SendAutomationError(RequestingSocket, RequestId, ExportError,
+                          TEXT("UNSUPPORTED_NODE"));
+      return true;
+    }
+    Result->SetStringField(TEXT("graphName"), TargetGraph->GetName());
+    SendAutomationResponse(RequestingSocket, RequestId, true,
+                           TEXT("Graph exported."), Result);
     return true;
   } else if (SubAction == TEXT("connect_pins")) {
     const FScopedTransaction Transaction(
@@ -1070,16 +1741,13 @@ bool UMcpAutomationBridgeSubsystem::HandleBlueprintGraphAction(
   } else if (SubAction == TEXT("list_node_types")) {
     // List all available UK2Node types for AI discoverability
     TArray<TSharedPtr<FJsonValue>> NodeTypes;
-    for (TObjectIterator<UClass> It; It; ++It) {
-      if (!It->IsChildOf(UK2Node::StaticClass()))
-        continue;
-      if (It->HasAnyClassFlags(CLASS_Abstract))
-        continue;
-
+    TArray<UClass *> NodeClasses;
+    FMcpReflectionIndex::GetDerivedClasses(UK2Node::StaticClass(), NodeClasses);
+    for (UClass *NodeClass : NodeClasses) {
       TSharedPtr<FJsonObject> TypeObj = MakeShared<FJsonObject>();
-      TypeObj->SetStringField(TEXT("className"), It->GetName());
+      TypeObj->SetStringField(TEXT("className"), NodeClass->GetName());
       TypeObj->SetStringField(TEXT("displayName"),
-                              It->GetDisplayNameText().ToString());
+                              NodeClass->GetDisplayNameText().ToString());
       NodeTypes.Add(MakeShared<FJsonValueObject>(TypeObj));
     }
 
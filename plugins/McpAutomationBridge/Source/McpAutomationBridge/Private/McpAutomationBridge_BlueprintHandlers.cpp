@@ -627,44 +627,32 @@ static FEdGraphPinType FMcpAutomationBridge_MakePinType(const FString &InType) {
       PinType.PinCategory = MCP_PC_Object;
       PinType.PinSubCategoryObject = ClassResolve;
     }
-    // 2. Try struct
+    // 2. Try struct (path, short or F-prefixed name)
     else if (UScriptStruct *StructResolve =
-                 FindObject<UScriptStruct>(nullptr, *CleanType)) {
+                 FMcpReflectionIndex::Get().FindStruct(CleanType)) {
       PinType.PinCategory = MCP_PC_Struct;
       PinType.PinSubCategoryObject = StructResolve;
     } else if (UScriptStruct *LoadedStruct =
-                   LoadObject<UScriptStruct>(nullptr, *CleanType)) {
+                   CleanType.StartsWith(TEXT("/"))
+                       ? LoadObject<UScriptStruct>(nullptr, *CleanType)
+                       : nullptr) {
       PinType.PinCategory = MCP_PC_Struct;
       PinType.PinSubCategoryObject = LoadedStruct;
+    }
+    // 3. Try enum
+    else if (UEnum *EnumResolve = FMcpReflectionIndex::Get().FindEnum(CleanType)) {
+      // Use Byte category with SubCategoryObject pointing to the Enum for
+      // maximum compatibility
+      PinType.PinCategory = MCP_PC_Byte;
+      PinType.PinSubCategoryObject = EnumResolve;
+    } else if (UEnum *LoadedEnum = CleanType.StartsWith(TEXT("/"))
+                                       ? LoadObject<UEnum>(nullptr, *CleanType)
+                                       : nullptr) {
+      PinType.PinCategory = MCP_PC_Byte;
+      PinType.PinSubCategoryObject = LoadedEnum;
     } else {
-      // Try short name loop for structs (fallback)
-      bool bFoundStruct = false;
-      if (!CleanType.Contains(TEXT("/")) && !CleanType.Contains(TEXT("."))) {
-        for (TObjectIterator<UScriptStruct> It; It; ++It) {
-          if (It->GetName().Equals(CleanType, ESearchCase::IgnoreCase)) {
-            PinType.PinCategory = MCP_PC_Struct;
-            PinType.PinSubCategoryObject = *It;
-            bFoundStruct = true;
-            break;
-          }
-        }
-      }
-
-      if (!bFoundStruct) {
-        // 3. Try Enum
-        if (UEnum *EnumResolve = FindObject<UEnum>(nullptr, *CleanType)) {
-          // Use Byte category with SubCategoryObject pointing to the Enum for
-          // maximum compatibility
-          PinType.PinCategory = MCP_PC_Byte;
-          PinType.PinSubCategoryObject = EnumResolve;
-        } else if (UEnum *LoadedEnum = LoadObject<UEnum>(nullptr, *CleanType)) {
-          PinType.PinCategory = MCP_PC_Byte;
-          PinType.PinSubCategoryObject = LoadedEnum;
-        } else {
-          // Default to wildcard if nothing matched
-          PinType.PinCategory = MCP_PC_Wildcard;
-        }
-      }
+      // Default to wildcard if nothing matched
+      PinType.PinCategory = MCP_PC_Wildcard;
     }
   }
   return PinType;
@@ -5,6 +5,9 @@
 #include "McpAutomationBridgeGlobals.h"
 #include "McpAutomationBridgeHelpers.h"
 #include "McpAutomationBridgeSubsystem.h"
+#include "McpAutomationJob.h"
+#include "McpLevelSnapshot.h"
+#include "Misc/Paths.h"
 #include "Misc/ScopeExit.h"
 
 #if WITH_EDITOR
@@ -1736,6 +1739,15 @@ bool UMcpAutomationBridgeSubsystem::HandleControlActorSetBlueprintVariables(
 #endif
 }
 
+// Named actor snapshots persist under Saved/ so they survive editor restarts.
+// One file per snapshot name, holding every actor captured under that name.
+static FString McpActorSnapshotFilePath(const FString &SnapshotName) {
+  return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("McpAutomationBridge"),
+                         TEXT("Snapshots"),
+                         FPaths::MakeValidFileName(SnapshotName) +
+                             TEXT(".mcpsnap"));
+}
+
 bool UMcpAutomationBridgeSubsystem::HandleControlActorCreateSnapshot(
     const FString &RequestId, const TSharedPtr<FJsonObject> &Payload,
     TSharedPtr<FMcpBridgeWebSocket> Socket) {
@@ -1766,11 +1778,36 @@ bool UMcpAutomationBridgeSubsystem::HandleControlActorCreateSnapshot(
 
   const FString SnapshotKey =
       FString::Printf(TEXT("%s::%s"), *Found->GetPathName(), *SnapshotName);
-  CachedActorSnapshots.Add(SnapshotKey, Found->GetActorTransform());
+  TSharedPtr<FMcpActorSnapshot> Record = MakeShared<FMcpActorSnapshot>();
+  Record->Capture(Found);
+  CachedActorSnapshots.Add(SnapshotKey, Record);
+
+  // Merge into the on-disk snapshot for this name (best effort)
+  const FString SnapshotFile = McpActorSnapshotFilePath(SnapshotName);
+  FMcpLevelSnapshot Persisted;
+  FString PersistError;
+  if (FPaths::FileExists(SnapshotFile)) {
+    Persisted.LoadFromFile(SnapshotFile, PersistError);
+  }
+  const int32 Existing = Persisted.FindActor(Record->ActorPath);
+  if (Existing != INDEX_NONE) {
+    Persisted.Actors[Existing] = *Record;
+  } else {
+    Persisted.Actors.Add(*Record);
+  }
+  Persisted.WorldPath = Found->GetWorld() ? Found->GetWorld()->GetPathName() : FString();
+  Persisted.Timestamp = FDateTime::UtcNow();
+  const bool bPersisted = Persisted.SaveToFile(SnapshotFile, PersistError);
+  if (!bPersisted) {
+    UE_LOG(LogMcpAutomationBridgeSubsystem, Warning,
+           TEXT("create_snapshot: %s"), *PersistError);
+  }
 
   TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
   Data->SetStringField(TEXT("snapshotName"), SnapshotName);
   Data->SetStringField(TEXT("actorName"), Found->GetActorLabel());
+  Data->SetStringField(TEXT("hash"), FString::Printf(TEXT("%016llx"), Record->Hash));
+  Data->SetBoolField(TEXT("persisted"), bPersisted);
   SendStandardSuccessResponse(this, Socket, RequestId, TEXT("Snapshot created"),
                               Data);
   return true;
@@ -1809,21 +1846,37 @@ bool UMcpAutomationBridgeSubsystem::HandleControlActorRestoreSnapshot(
 
   const FString SnapshotKey =
       FString::Printf(TEXT("%s::%s"), *Found->GetPathName(), *SnapshotName);
-  if (!CachedActorSnapshots.Contains(SnapshotKey)) {
+  TSharedPtr<FMcpActorSnapshot> Record = CachedActorSnapshots.FindRef(SnapshotKey);
+  if (!Record.IsValid()) {
+    // Fall back to the persisted snapshot from a previous editor session
+    FMcpLevelSnapshot Persisted;
+    FString LoadError;
+    const FString SnapshotFile = McpActorSnapshotFilePath(SnapshotName);
+    if (FPaths::FileExists(SnapshotFile) &&
+        Persisted.LoadFromFile(SnapshotFile, LoadError)) {
+      const int32 Index = Persisted.FindActor(Found->GetPathName());
+      if (Index != INDEX_NONE) {
+        Record = MakeShared<FMcpActorSnapshot>(Persisted.Actors[Index]);
+        CachedActorSnapshots.Add(SnapshotKey, Record);
+      }
+    }
+  }
+  if (!Record.IsValid()) {
     SendAutomationResponse(Socket, RequestId, false, TEXT("Snapshot not found"),
                            nullptr, TEXT("SNAPSHOT_NOT_FOUND"));
     return true;
   }
 
-  const FTransform &SavedTransform = CachedActorSnapshots[SnapshotKey];
-  Found->Modify();
-  Found->SetActorTransform(SavedTransform);
-  Found->MarkComponentsRenderStateDirty();
-  Found->MarkPackageDirty();
+  // Only the fields that differ from the live actor are written back
+  const bool bChanged = Record->Apply(Found, /*bTransact*/ true);
+  if (bChanged) {
+    Found->MarkPackageDirty();
+  }
 
   TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
   Data->SetStringField(TEXT("snapshotName"), SnapshotName);
   Data->SetStringField(TEXT("actorName"), Found->GetActorLabel());
+  Data->SetBoolField(TEXT("changed"), bChanged);
   SendStandardSuccessResponse(this, Socket, RequestId,
                               TEXT("Snapshot restored"), Data);
   return true;
@@ -2946,17 +2999,44 @@ bool UMcpAutomationBridgeSubsystem::HandleControlEditorScreenshot(
     return true;
   }
 
-  // Request a screenshot
-  bool bCaptured = false;
+  // Request a screenshot. The capture happens on the next viewport draw, so
+  // reply with a job id and push the completion event once the engine reports
+  // the request processed and the file is on disk.
+  IFileManager::Get().Delete(*FullPath, false, true, true);
   FScreenshotRequest::RequestScreenshot(FullPath, false, false);
-  
-  // Since screenshot is async, we respond with the expected path
+
+  TSharedPtr<FMcpAutomationJob> Job =
+      BeginAutomationJob(TEXT("screenshot"), RequestId, Socket, 30.0);
+  TSharedRef<bool> bProcessed = MakeShared<bool>(false);
+  const FDelegateHandle ProcessedHandle =
+      FScreenshotRequest::OnScreenshotRequestProcessed().AddLambda(
+          [bProcessed]() { *bProcessed = true; });
+  Job->OnFinished = [ProcessedHandle]() {
+    FScreenshotRequest::OnScreenshotRequestProcessed().Remove(ProcessedHandle);
+  };
+  Job->Poll = [bProcessed, FullPath, Filename](FMcpAutomationJob &RunningJob) {
+    const int64 FileSize = IFileManager::Get().FileSize(*FullPath);
+    if (!*bProcessed || FileSize <= 0) {
+      return false;
+    }
+    RunningJob.bSuccess = true;
+    RunningJob.Message = TEXT("Screenshot saved");
+    RunningJob.Result = MakeShared<FJsonObject>();
+    RunningJob.Result->SetStringField(TEXT("filename"), Filename);
+    RunningJob.Result->SetStringField(TEXT("path"), FullPath);
+    RunningJob.Result->SetNumberField(TEXT("sizeBytes"), (double)FileSize);
+    return true;
+  };
+  Viewport->Invalidate();
+  GEditor->RedrawAllViewports(false);
+
   TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
   Resp->SetBoolField(TEXT("success"), true);
   Resp->SetStringField(TEXT("filename"), Filename);
   Resp->SetStringField(TEXT("path"), FullPath);
+  Resp->SetStringField(TEXT("jobId"), Job->JobId);
   Resp->SetStringField(TEXT("message"), TEXT("Screenshot request submitted"));
-  
+
   SendAutomationResponse(Socket, RequestId, true,
                          TEXT("Screenshot requested"), Resp, FString());
   return true;
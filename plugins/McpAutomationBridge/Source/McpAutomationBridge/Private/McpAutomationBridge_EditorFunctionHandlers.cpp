@@ -858,17 +858,13 @@ bool UMcpAutomationBridgeSubsystem::HandleExecuteEditorFunction(
 #endif
     }
 
-    // Quick factory lookup by short name if full resolution failed
+    // Factory lookup by short name, also accepting "Texture" for "TextureFactory"
     if (!FactoryUClass) {
-      for (TObjectIterator<UClass> It; It; ++It) {
-        if (It->GetName().Equals(FactoryClass) ||
-            It->GetName().Equals(FactoryClass + TEXT("Factory"))) {
-          if (It->IsChildOf(UFactory::StaticClass())) {
-            FactoryUClass = *It;
-            break;
-          }
-        }
-      }
+      FMcpReflectionIndex &Index = FMcpReflectionIndex::Get();
+      FactoryUClass = Index.FindClass(FactoryClass, UFactory::StaticClass());
+      if (!FactoryUClass)
+        FactoryUClass = Index.FindClass(FactoryClass + TEXT("Factory"),
+                                        UFactory::StaticClass());
     }
 
     if (!FactoryUClass) {
@@ -3,6 +3,8 @@
 #include "McpAutomationBridgeGlobals.h"
 #include "McpAutomationBridgeHelpers.h"
 #include "McpAutomationBridgeSubsystem.h"
+#include "McpAutomationJob.h"
+#include "McpNiagaraBake.h"
 
 #if WITH_EDITOR
 #include "EditorAssetLibrary.h"
@@ -851,36 +853,22 @@ bool UMcpAutomationBridgeSubsystem::HandleEffectAction(
       LocalPayload->TryGetNumberField(TEXT("deltaTime"), DeltaTime);
       int32 Steps = 1;
       LocalPayload->TryGetNumberField(TEXT("steps"), Steps);
+      Steps = FMath::Max(1, Steps);
 
 #if WITH_EDITOR
-      UEditorActorSubsystem *ActorSS =
-          GEditor->GetEditorSubsystem<UEditorActorSubsystem>();
-      TArray<AActor *> AllActors = ActorSS->GetAllLevelActors();
-      bool bFound = false;
-      for (AActor *Actor : AllActors) {
-        if (!Actor)
-          continue;
-        if (!Actor->GetActorLabel().Equals(SystemName, ESearchCase::IgnoreCase))
-          continue;
-
+      AActor *Actor = FindActorByName(SystemName);
+      UNiagaraComponent *NiComp =
+          Actor ? Actor->FindComponentByClass<UNiagaraComponent>() : nullptr;
+      if (NiComp) {
         UE_LOG(LogMcpAutomationBridgeSubsystem, Verbose,
                TEXT("AdvanceSimulation: Found actor '%s'"), *SystemName);
-        UNiagaraComponent *NiComp =
-            Actor->FindComponentByClass<UNiagaraComponent>();
-        if (!NiComp)
-          continue;
-
-        for (int i = 0; i < Steps; i++) {
-          NiComp->AdvanceSimulation(Steps, DeltaTime);
-        }
-        bFound = true;
-        break;
-      }
-      if (bFound) {
+        // AdvanceSimulation runs all Steps ticks itself.
+        NiComp->AdvanceSimulation(Steps, DeltaTime);
         TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
         Resp->SetBoolField(TEXT("success"), true);
         Resp->SetStringField(TEXT("actorName"), SystemName);
         Resp->SetNumberField(TEXT("steps"), Steps);
+        Resp->SetNumberField(TEXT("simulatedSeconds"), Steps * DeltaTime);
         SendAutomationResponse(RequestingSocket, RequestId, true,
                                TEXT("Niagara simulation advanced."), Resp);
       } else
@@ -894,6 +882,162 @@ bool UMcpAutomationBridgeSubsystem::HandleEffectAction(
                              nullptr, TEXT("NOT_IMPLEMENTED"));
       return true;
 #endif
+    } else if (LowerSub.Equals(TEXT("bake_simulation"))) {
+      // Deterministic fixed-dt bake of the CPU emitters into a particle
+      // cache; see McpNiagaraBake.h for the payload and cache format. The
+      // reply carries a jobId and the cache summary arrives with
+      // job_completed; cancel_bake stops it early.
+#if MCP_HAS_NIAGARA_BAKE
+      TSharedPtr<FMcpNiagaraBake> Bake = MakeShared<FMcpNiagaraBake>();
+      FString Error;
+      if (!Bake->Parse(LocalPayload, Error)) {
+        SendAutomationError(RequestingSocket, RequestId, Error,
+                            TEXT("INVALID_ARGUMENT"));
+        return true;
+      }
+
+      FString SystemName = GetJsonStringField(LocalPayload, TEXT("systemName"));
+      if (SystemName.IsEmpty())
+        SystemName = GetJsonStringField(LocalPayload, TEXT("actorName"));
+      const FString SystemPath =
+          GetJsonStringField(LocalPayload, TEXT("systemPath"));
+
+      // A placed system bakes in place so its overrides apply; an asset path
+      // bakes on a transient component that is destroyed afterwards.
+      UNiagaraComponent *NiComp = nullptr;
+      bool bTransient = false;
+      if (!SystemName.IsEmpty()) {
+        AActor *Actor = FindActorByName(SystemName);
+        NiComp =
+            Actor ? Actor->FindComponentByClass<UNiagaraComponent>() : nullptr;
+        if (!NiComp) {
+          SendAutomationError(
+              RequestingSocket, RequestId,
+              FString::Printf(TEXT("Niagara system '%s' not found"),
+                              *SystemName),
+              TEXT("SYSTEM_NOT_FOUND"));
+          return true;
+        }
+      } else if (!SystemPath.IsEmpty()) {
+        UNiagaraSystem *System = LoadObject<UNiagaraSystem>(nullptr, *SystemPath);
+        UWorld *World =
+            GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+        if (!System || !World) {
+          SendAutomationError(
+              RequestingSocket, RequestId,
+              FString::Printf(TEXT("Niagara system asset '%s' not found"),
+                              *SystemPath),
+              TEXT("SYSTEM_NOT_FOUND"));
+          return true;
+        }
+        NiComp = UNiagaraFunctionLibrary::SpawnSystemAtLocation(
+            World, System,
+            ExtractVectorField(LocalPayload, TEXT("location"),
+                               FVector::ZeroVector),
+            FRotator::ZeroRotator, FVector::OneVector, false, false,
+            ENCPoolMethod::None, false);
+        bTransient = NiComp != nullptr;
+      }
+      if (!NiComp) {
+        SendAutomationError(RequestingSocket, RequestId,
+                            TEXT("bake_simulation requires systemName or "
+                                 "systemPath"),
+                            TEXT("INVALID_ARGUMENT"));
+        return true;
+      }
+
+      FString ErrorCode;
+      if (!Bake->Begin(NiComp, bTransient, Error, ErrorCode)) {
+        Bake->Restore();
+        SendAutomationError(RequestingSocket, RequestId, Error, ErrorCode);
+        return true;
+      }
+
+      // Frames are simulated within the tasklet frame budget from the job
+      // ticker, so a 10,000-frame bake no longer stalls the editor.
+      TSharedPtr<FMcpAutomationJob> Job =
+          BeginAutomationJob(TEXT("niagara_bake"), RequestId, RequestingSocket);
+      TSharedRef<double> LastProgressSeconds = MakeShared<double>(0.0);
+      Job->Poll = [this, Bake,
+                   LastProgressSeconds](FMcpAutomationJob &RunningJob) {
+        FString StepError;
+        FString StepErrorCode;
+        if (!Bake->Step(TaskletBudgetSeconds, StepError, StepErrorCode)) {
+          RunningJob.bSuccess = false;
+          RunningJob.ErrorCode = StepErrorCode;
+          RunningJob.Message = StepError;
+          return true;
+        }
+        if (!Bake->IsDone()) {
+          // Progress at most twice a second, as for material compiles.
+          const double Now = FPlatformTime::Seconds();
+          if (Now - *LastProgressSeconds >= 0.5) {
+            *LastProgressSeconds = Now;
+            TSharedPtr<FJsonObject> Event = MakeShared<FJsonObject>();
+            Event->SetStringField(TEXT("type"), TEXT("automation_event"));
+            Event->SetStringField(TEXT("event"), TEXT("niagara_bake_progress"));
+            Event->SetStringField(TEXT("jobId"), RunningJob.JobId);
+            Event->SetStringField(TEXT("requestId"), RunningJob.RequestId);
+            Event->SetNumberField(TEXT("frame"), Bake->GetFramesBaked());
+            Event->SetNumberField(TEXT("frames"), Bake->GetFrames());
+            Event->SetNumberField(TEXT("percent"),
+                                  100.0 * Bake->GetFramesBaked() /
+                                      Bake->GetFrames());
+            Event->SetNumberField(TEXT("elapsedSeconds"),
+                                  RunningJob.GetElapsedSeconds());
+            SendAutomationJobEvent(RunningJob, Event);
+          }
+          return false;
+        }
+        RunningJob.Result = MakeShared<FJsonObject>();
+        RunningJob.bSuccess =
+            Bake->Finish(RunningJob.Result, StepError, StepErrorCode);
+        RunningJob.ErrorCode = StepErrorCode;
+        RunningJob.Message =
+            RunningJob.bSuccess ? TEXT("Niagara simulation baked") : StepError;
+        return true;
+      };
+      // Also runs on cancel_bake, timeout and shutdown.
+      Job->OnFinished = [Bake]() { Bake->Restore(); };
+
+      TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
+      Resp->SetStringField(TEXT("jobId"), Job->JobId);
+      Resp->SetNumberField(TEXT("frames"), Bake->GetFrames());
+      SendAutomationResponse(RequestingSocket, RequestId, true,
+                             TEXT("Niagara bake started"), Resp);
+      return true;
+#else
+      SendAutomationResponse(RequestingSocket, RequestId, false,
+                             TEXT("bake_simulation requires editor build."),
+                             nullptr, TEXT("NOT_IMPLEMENTED"));
+      return true;
+#endif
+    } else if (LowerSub.Equals(TEXT("cancel_bake"))) {
+      const FString JobId = GetJsonStringField(LocalPayload, TEXT("jobId"));
+      if (JobId.IsEmpty()) {
+        SendAutomationError(RequestingSocket, RequestId,
+                            TEXT("jobId is required."),
+                            TEXT("INVALID_ARGUMENT"));
+        return true;
+      }
+      const TSharedPtr<FMcpAutomationJob> *Found = AutomationJobs.Find(JobId);
+      if (!Found || (*Found)->Kind != TEXT("niagara_bake") ||
+          (*Found)->bCompleted) {
+        SendAutomationError(
+            RequestingSocket, RequestId,
+            FString::Printf(TEXT("No running bake for job %s"), *JobId),
+            TEXT("NOT_FOUND"));
+        return true;
+      }
+      // Completing the job restores the component through OnFinished; no
+      // cache file is written.
+      CompleteAutomationJob(JobId, false, TEXT("Bake cancelled"), nullptr,
+                            TEXT("CANCELLED"));
+      TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
+      Resp->SetStringField(TEXT("jobId"), JobId);
+      SendAutomationResponse(RequestingSocket, RequestId, true,
+                             TEXT("Bake cancelled"), Resp);
+      return true;
     } else if (LowerSub.Equals(TEXT("create_dynamic_light"))) {
       FString LightName;
       LocalPayload->TryGetStringField(TEXT("lightName"), LightName);
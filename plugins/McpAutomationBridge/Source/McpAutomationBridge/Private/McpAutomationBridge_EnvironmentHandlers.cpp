@@ -37,8 +37,13 @@
 #include "FileHelpers.h"
 #include "GeneralProjectSettings.h"
 #include "KismetProceduralMeshLibrary.h"
+#include "HAL/FileManager.h"
+#include "McpLevelSnapshot.h"
+#include "McpPerfSampler.h"
+#include "McpSceneQuery.h"
 #include "Misc/FileHelper.h"
 #include "NiagaraComponent.h"
+#include "ScopedTransaction.h"
 #include "NiagaraSystem.h"
 #include "ProceduralMeshComponent.h"
 
@@ -181,46 +186,104 @@ bool UMcpAutomationBridgeSubsystem::HandleBuildEnvironmentAction(
   if (LowerSub == TEXT("export_snapshot")) {
     FString Path;
     Payload->TryGetStringField(TEXT("path"), Path);
+    UWorld *World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
     if (Path.IsEmpty()) {
       bSuccess = false;
       Message = TEXT("path required for export_snapshot");
       ErrorCode = TEXT("INVALID_ARGUMENT");
       Resp->SetStringField(TEXT("error"), Message);
+    } else if (!World) {
+      bSuccess = false;
+      Message = TEXT("No editor world available");
+      ErrorCode = TEXT("NO_WORLD");
+      Resp->SetStringField(TEXT("error"), Message);
     } else {
-      TSharedPtr<FJsonObject> Snapshot = MakeShared<FJsonObject>();
-      Snapshot->SetStringField(TEXT("timestamp"),
-                               FDateTime::UtcNow().ToString());
-      Snapshot->SetStringField(TEXT("type"), TEXT("environment_snapshot"));
-
-      FString JsonString;
-      TSharedRef<TJsonWriter<>> Writer =
-          TJsonWriterFactory<>::Create(&JsonString);
-      if (FJsonSerializer::Serialize(Snapshot.ToSharedRef(), Writer)) {
-        if (FFileHelper::SaveStringToFile(JsonString, *Path)) {
-          Resp->SetStringField(TEXT("exportPath"), Path);
-          Resp->SetStringField(TEXT("message"), TEXT("Snapshot exported"));
-        } else {
-          bSuccess = false;
-          Message = TEXT("Failed to write snapshot file");
-          ErrorCode = TEXT("WRITE_FAILED");
-          Resp->SetStringField(TEXT("error"), Message);
-        }
+      const double StartTime = FPlatformTime::Seconds();
+      FMcpLevelSnapshot Snapshot;
+      Snapshot.Capture(World);
+      FString SaveError;
+      if (Snapshot.SaveToFile(Path, SaveError)) {
+        Resp->SetStringField(TEXT("exportPath"), Path);
+        Resp->SetStringField(TEXT("world"), Snapshot.WorldPath);
+        Resp->SetNumberField(TEXT("actorCount"), Snapshot.Actors.Num());
+        Resp->SetNumberField(TEXT("fileSize"),
+                             static_cast<double>(IFileManager::Get().FileSize(*Path)));
+        Resp->SetNumberField(TEXT("elapsedMs"),
+                             (FPlatformTime::Seconds() - StartTime) * 1000.0);
+        Resp->SetStringField(TEXT("message"), TEXT("Snapshot exported"));
       } else {
         bSuccess = false;
-        Message = TEXT("Failed to serialize snapshot");
-        ErrorCode = TEXT("SERIALIZE_FAILED");
+        Message = SaveError;
+        ErrorCode = TEXT("WRITE_FAILED");
         Resp->SetStringField(TEXT("error"), Message);
       }
     }
   } else if (LowerSub == TEXT("import_snapshot")) {
     FString Path;
     Payload->TryGetStringField(TEXT("path"), Path);
+    UWorld *World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
     if (Path.IsEmpty()) {
       bSuccess = false;
       Message = TEXT("path required for import_snapshot");
       ErrorCode = TEXT("INVALID_ARGUMENT");
       Resp->SetStringField(TEXT("error"), Message);
+    } else if (FMcpLevelSnapshot::IsSnapshotFile(Path)) {
+      // Binary snapshot: diff against the live level and restore only what
+      // changed. dryRun reports the diff without touching the level.
+      FMcpLevelSnapshot Snapshot;
+      FString LoadError;
+      const double StartTime = FPlatformTime::Seconds();
+      if (!World) {
+        bSuccess = false;
+        Message = TEXT("No editor world available");
+        ErrorCode = TEXT("NO_WORLD");
+        Resp->SetStringField(TEXT("error"), Message);
+      } else if (!Snapshot.LoadFromFile(Path, LoadError)) {
+        bSuccess = false;
+        Message = LoadError;
+        ErrorCode = TEXT("PARSE_FAILED");
+        Resp->SetStringField(TEXT("error"), Message);
+      } else if (GetJsonBoolField(Payload, TEXT("dryRun"), false)) {
+        FMcpLevelSnapshot Current;
+        Current.Capture(World);
+        const FMcpLevelSnapshotDiff Delta = Snapshot.Diff(Current);
+        Resp->SetNumberField(TEXT("changed"), Delta.Changed.Num());
+        Resp->SetNumberField(TEXT("missing"), Delta.Missing.Num());
+        Resp->SetNumberField(TEXT("added"), Delta.Added.Num());
+        Resp->SetNumberField(TEXT("unchanged"), Delta.Unchanged);
+        Resp->SetBoolField(TEXT("dryRun"), true);
+        Resp->SetStringField(TEXT("message"), TEXT("Snapshot diffed"));
+      } else {
+        FMcpLevelSnapshotRestoreOptions Options;
+        Options.bTransact = GetJsonBoolField(Payload, TEXT("transact"), false);
+        Options.bRespawnMissing = GetJsonBoolField(Payload, TEXT("respawnMissing"), false);
+        Options.bDestroyAdded = GetJsonBoolField(Payload, TEXT("destroyAdded"), false);
+
+        TUniquePtr<FScopedTransaction> Transaction;
+        if (Options.bTransact) {
+          Transaction = MakeUnique<FScopedTransaction>(
+              FText::FromString(TEXT("Restore Level Snapshot")));
+        }
+        const FMcpLevelSnapshotRestoreResult Restored =
+            Snapshot.Restore(World, Options);
+        Transaction.Reset();
+
+        TArray<TSharedPtr<FJsonValue>> FailedArray;
+        for (const FString &Failed : Restored.Failed) {
+          FailedArray.Add(MakeShared<FJsonValueString>(Failed));
+        }
+        Resp->SetStringField(TEXT("importPath"), Path);
+        Resp->SetNumberField(TEXT("restored"), Restored.Restored);
+        Resp->SetNumberField(TEXT("unchanged"), Restored.Unchanged);
+        Resp->SetNumberField(TEXT("respawned"), Restored.Respawned);
+        Resp->SetNumberField(TEXT("destroyed"), Restored.Destroyed);
+        Resp->SetArrayField(TEXT("failed"), FailedArray);
+        Resp->SetNumberField(TEXT("elapsedMs"),
+                             (FPlatformTime::Seconds() - StartTime) * 1000.0);
+        Resp->SetStringField(TEXT("message"), TEXT("Snapshot restored"));
+      }
     } else {
+      // Legacy JSON snapshot files are still accepted and echoed back
       FString JsonString;
       if (!FFileHelper::LoadFileToString(JsonString, *Path)) {
         bSuccess = false;
@@ -243,6 +306,67 @@ bool UMcpAutomationBridgeSubsystem::HandleBuildEnvironmentAction(
         }
       }
     }
+  } else if (LowerSub == TEXT("diff_snapshot")) {
+    // Diff path (baseline) against comparePath, or against the live level
+    FString Path;
+    FString ComparePath;
+    Payload->TryGetStringField(TEXT("path"), Path);
+    Payload->TryGetStringField(TEXT("comparePath"), ComparePath);
+    int32 MaxListed = 100;
+    Payload->TryGetNumberField(TEXT("maxListed"), MaxListed);
+
+    FMcpLevelSnapshot Baseline;
+    FMcpLevelSnapshot Other;
+    FString LoadError;
+    UWorld *World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    if (Path.IsEmpty()) {
+      bSuccess = false;
+      Message = TEXT("path required for diff_snapshot");
+      ErrorCode = TEXT("INVALID_ARGUMENT");
+    } else if (!Baseline.LoadFromFile(Path, LoadError) ||
+               (!ComparePath.IsEmpty() &&
+                !Other.LoadFromFile(ComparePath, LoadError))) {
+      bSuccess = false;
+      Message = LoadError;
+      ErrorCode = TEXT("PARSE_FAILED");
+    } else if (ComparePath.IsEmpty() && !World) {
+      bSuccess = false;
+      Message = TEXT("No editor world available");
+      ErrorCode = TEXT("NO_WORLD");
+    } else {
+      if (ComparePath.IsEmpty()) {
+        Other.Capture(World);
+      }
+      const FMcpLevelSnapshotDiff Delta = Baseline.Diff(Other);
+
+      auto ListPaths = [&Baseline, MaxListed](const TArray<int32> &Indices) {
+        TArray<TSharedPtr<FJsonValue>> Out;
+        for (int32 Index : Indices) {
+          if (Out.Num() >= MaxListed)
+            break;
+          Out.Add(MakeShared<FJsonValueString>(Baseline.Actors[Index].ActorPath));
+        }
+        return Out;
+      };
+      TArray<TSharedPtr<FJsonValue>> AddedArray;
+      for (const FString &Added : Delta.Added) {
+        if (AddedArray.Num() >= MaxListed)
+          break;
+        AddedArray.Add(MakeShared<FJsonValueString>(Added));
+      }
+
+      Resp->SetNumberField(TEXT("changedCount"), Delta.Changed.Num());
+      Resp->SetNumberField(TEXT("missingCount"), Delta.Missing.Num());
+      Resp->SetNumberField(TEXT("addedCount"), Delta.Added.Num());
+      Resp->SetNumberField(TEXT("unchanged"), Delta.Unchanged);
+      Resp->SetArrayField(TEXT("changed"), ListPaths(Delta.Changed));
+      Resp->SetArrayField(TEXT("missing"), ListPaths(Delta.Missing));
+      Resp->SetArrayField(TEXT("added"), AddedArray);
+      Resp->SetBoolField(TEXT("identical"), Delta.IsEmpty());
+    }
+    if (!bSuccess) {
+      Resp->SetStringField(TEXT("error"), Message);
+    }
   } else if (LowerSub == TEXT("delete")) {
     const TArray<TSharedPtr<FJsonValue>> *NamesArray = nullptr;
     if (!Payload->TryGetArrayField(TEXT("names"), NamesArray) || !NamesArray) {
@@ -934,9 +1058,12 @@ bool UMcpAutomationBridgeSubsystem::HandleInspectAction(
     LowerSubAction.Equals(TEXT("get_scene_stats")) ||
     LowerSubAction.Equals(TEXT("get_performance_stats")) ||
     LowerSubAction.Equals(TEXT("get_memory_stats")) ||
+    LowerSubAction.Equals(TEXT("subscribe_performance_stats")) ||
+    LowerSubAction.Equals(TEXT("unsubscribe_performance_stats")) ||
     LowerSubAction.Equals(TEXT("list_objects")) ||
     LowerSubAction.Equals(TEXT("find_by_class")) ||
     LowerSubAction.Equals(TEXT("find_by_tag")) ||
+    LowerSubAction.Equals(TEXT("query_actors")) ||
     LowerSubAction.Equals(TEXT("inspect_class"));
 
   // Only require objectPath for non-global actions
@@ -1026,100 +1153,210 @@ bool UMcpAutomationBridgeSubsystem::HandleInspectAction(
       return true;
     }
     else if (LowerSubAction.Equals(TEXT("get_scene_stats"))) {
+      UWorld *World =
+          GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
       int32 ActorCount = 0;
-      if (GEditor && GEditor->GetEditorWorldContext().World()) {
-        UWorld* World = GEditor->GetEditorWorldContext().World();
+      int32 ComponentCount = 0;
+      TMap<const UClass *, int32> ActorsByClass;
+      if (World) {
         for (TActorIterator<AActor> It(World); It; ++It) {
           ActorCount++;
+          ComponentCount += It->GetComponents().Num();
+          ActorsByClass.FindOrAdd(It->GetClass())++;
         }
+        Resp->SetNumberField(TEXT("levelCount"), World->GetLevels().Num());
+      }
+      ActorsByClass.ValueSort([](int32 A, int32 B) { return A > B; });
+      const int32 TopN =
+          FMath::Clamp(GetJsonIntField(Payload, TEXT("topClasses"), 10), 0, 100);
+      TArray<TSharedPtr<FJsonValue>> ClassArray;
+      for (const TPair<const UClass *, int32> &Pair : ActorsByClass) {
+        if (ClassArray.Num() >= TopN) {
+          break;
+        }
+        TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetStringField(TEXT("class"), Pair.Key->GetName());
+        Entry->SetNumberField(TEXT("count"), Pair.Value);
+        ClassArray.Add(MakeShared<FJsonValueObject>(Entry));
       }
       Resp->SetNumberField(TEXT("actorCount"), ActorCount);
+      Resp->SetNumberField(TEXT("componentCount"), ComponentCount);
+      Resp->SetArrayField(TEXT("actorClasses"), ClassArray);
+      Resp->SetNumberField(TEXT("uobjectCount"),
+                           GUObjectArray.GetObjectArrayNumMinusAvailable());
       Resp->SetBoolField(TEXT("success"), true);
       SendAutomationResponse(RequestingSocket, RequestId, true,
                              TEXT("Scene stats retrieved"), Resp, FString());
       return true;
     }
-    else if (LowerSubAction.Equals(TEXT("get_performance_stats"))) {
+    else if (LowerSubAction.Equals(TEXT("get_performance_stats")) ||
+             LowerSubAction.Equals(TEXT("get_memory_stats"))) {
+      // Aggregates over the sampler's ring; windowSeconds defaults to 10s.
+      FMcpPerfSampler &Sampler = FMcpPerfSampler::Get();
+      const bool bMemory = LowerSubAction.Equals(TEXT("get_memory_stats"));
+      const uint8 DefaultGroups =
+          bMemory ? uint8(FMcpPerfSampler::EGroup::Memory)
+                  : uint8(FMcpPerfSampler::EGroup::Frame) |
+                        uint8(FMcpPerfSampler::EGroup::Streaming);
+      const double WindowSeconds = FMath::Max(
+          0.1, GetJsonNumberField(Payload, TEXT("windowSeconds"), 10.0));
+      Resp = Sampler.GetWindowJson(
+          WindowSeconds, FMcpPerfSampler::ParseGroups(Payload, DefaultGroups));
+      if (bMemory) {
+        const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+        TSharedPtr<FJsonObject> Current = MakeShared<FJsonObject>();
+        Current->SetNumberField(TEXT("usedPhysical"),
+                                (double)MemoryStats.UsedPhysical);
+        Current->SetNumberField(TEXT("peakUsedPhysical"),
+                                (double)MemoryStats.PeakUsedPhysical);
+        Current->SetNumberField(TEXT("usedVirtual"),
+                                (double)MemoryStats.UsedVirtual);
+        Current->SetNumberField(TEXT("peakUsedVirtual"),
+                                (double)MemoryStats.PeakUsedVirtual);
+        Current->SetNumberField(TEXT("availablePhysical"),
+                                (double)MemoryStats.AvailablePhysical);
+        Current->SetNumberField(TEXT("totalPhysical"),
+                                (double)MemoryStats.TotalPhysical);
+        Resp->SetObjectField(TEXT("current"), Current);
+        // Walks every UObject; cached for a few seconds.
+        if (GetJsonBoolField(Payload, TEXT("includeClassCounts"), false)) {
+          Resp->SetObjectField(
+              TEXT("classCounts"),
+              Sampler.GetClassCountsJson(
+                  FMath::Clamp(GetJsonIntField(Payload, TEXT("topClasses"), 25),
+                               1, 1000),
+                  5.0));
+        }
+      }
       Resp->SetBoolField(TEXT("success"), true);
-      Resp->SetStringField(TEXT("message"), TEXT("Performance stats placeholder - implement with actual metrics"));
       SendAutomationResponse(RequestingSocket, RequestId, true,
-                             TEXT("Performance stats retrieved"), Resp, FString());
+                             bMemory ? TEXT("Memory stats retrieved")
+                                     : TEXT("Performance stats retrieved"),
+                             Resp, FString());
       return true;
     }
-    else if (LowerSubAction.Equals(TEXT("get_memory_stats"))) {
+    else if (LowerSubAction.Equals(TEXT("subscribe_performance_stats"))) {
+      FMcpPerfSampler &Sampler = FMcpPerfSampler::Get();
+      if (!Sampler.IsEnabled()) {
+        SendAutomationError(RequestingSocket, RequestId,
+                            TEXT("Performance sampling is disabled "
+                                 "(PerfSampleIntervalSeconds is 0)"),
+                            TEXT("NOT_AVAILABLE"));
+        return true;
+      }
+      const double IntervalSeconds = FMath::Clamp(
+          GetJsonNumberField(Payload, TEXT("intervalSeconds"), 1.0), 0.1,
+          3600.0);
+      const double WindowSeconds = FMath::Max(
+          0.1, GetJsonNumberField(Payload, TEXT("windowSeconds"),
+                                  IntervalSeconds));
+      Sampler.Subscribe(
+          RequestingSocket, IntervalSeconds, WindowSeconds,
+          FMcpPerfSampler::ParseGroups(
+              Payload, uint8(FMcpPerfSampler::EGroup::All)));
+      Resp->SetBoolField(TEXT("subscribed"), true);
+      Resp->SetNumberField(TEXT("intervalSeconds"), IntervalSeconds);
+      Resp->SetNumberField(TEXT("windowSeconds"), WindowSeconds);
       Resp->SetBoolField(TEXT("success"), true);
-      Resp->SetStringField(TEXT("message"), TEXT("Memory stats placeholder - implement with actual metrics"));
       SendAutomationResponse(RequestingSocket, RequestId, true,
-                             TEXT("Memory stats retrieved"), Resp, FString());
+                             TEXT("Subscribed to performance stats"), Resp,
+                             FString());
       return true;
     }
-    else if (LowerSubAction.Equals(TEXT("list_objects"))) {
-      TArray<TSharedPtr<FJsonValue>> ObjectsArray;
-      if (GEditor && GEditor->GetEditorWorldContext().World()) {
-        UWorld* World = GEditor->GetEditorWorldContext().World();
-        for (TActorIterator<AActor> It(World); It; ++It) {
-          AActor* Actor = *It;
-          TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
-          Obj->SetStringField(TEXT("name"), Actor->GetName());
-          Obj->SetStringField(TEXT("path"), Actor->GetPathName());
-          Obj->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
-          ObjectsArray.Add(MakeShared<FJsonValueObject>(Obj));
-        }
-      }
-      Resp->SetArrayField(TEXT("objects"), ObjectsArray);
-      Resp->SetNumberField(TEXT("count"), ObjectsArray.Num());
+    else if (LowerSubAction.Equals(TEXT("unsubscribe_performance_stats"))) {
+      Resp->SetBoolField(
+          TEXT("wasSubscribed"),
+          FMcpPerfSampler::Get().Unsubscribe(RequestingSocket));
+      Resp->SetBoolField(TEXT("subscribed"), false);
       Resp->SetBoolField(TEXT("success"), true);
       SendAutomationResponse(RequestingSocket, RequestId, true,
-                             TEXT("Objects listed"), Resp, FString());
+                             TEXT("Unsubscribed from performance stats"),
+                             Resp, FString());
       return true;
     }
-    else if (LowerSubAction.Equals(TEXT("find_by_class"))) {
-      FString ClassName;
-      Payload->TryGetStringField(TEXT("className"), ClassName);
-      TArray<TSharedPtr<FJsonValue>> ObjectsArray;
-      if (GEditor && GEditor->GetEditorWorldContext().World() && !ClassName.IsEmpty()) {
-        UWorld* World = GEditor->GetEditorWorldContext().World();
-        for (TActorIterator<AActor> It(World); It; ++It) {
-          AActor* Actor = *It;
-          if (Actor->GetClass()->GetName().Equals(ClassName, ESearchCase::IgnoreCase) ||
-              Actor->GetClass()->GetPathName().Contains(ClassName)) {
-            TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
-            Obj->SetStringField(TEXT("name"), Actor->GetName());
-            Obj->SetStringField(TEXT("path"), Actor->GetPathName());
-            Obj->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
-            ObjectsArray.Add(MakeShared<FJsonValueObject>(Obj));
-          }
+    else if (LowerSubAction.Equals(TEXT("query_actors")) ||
+             LowerSubAction.Equals(TEXT("list_objects")) ||
+             LowerSubAction.Equals(TEXT("find_by_class")) ||
+             LowerSubAction.Equals(TEXT("find_by_tag"))) {
+      // list_objects / find_by_class / find_by_tag are fixed queries: same
+      // "objects" shape as before, unlimited unless the caller pages them.
+      const bool bLegacy = !LowerSubAction.Equals(TEXT("query_actors"));
+      const bool bByClass = LowerSubAction.Equals(TEXT("find_by_class"));
+      const bool bByTag = LowerSubAction.Equals(TEXT("find_by_tag"));
+      const FString ArrayField = bLegacy ? TEXT("objects") : TEXT("actors");
+      FString Message = TEXT("Actors queried");
+      if (bByClass) {
+        Message = TEXT("Objects found by class");
+      } else if (bByTag) {
+        Message = TEXT("Objects found by tag");
+      } else if (bLegacy) {
+        Message = TEXT("Objects listed");
+      }
+      auto SendEmpty = [&]() {
+        Resp->SetArrayField(ArrayField, TArray<TSharedPtr<FJsonValue>>());
+        Resp->SetNumberField(TEXT("count"), 0);
+        Resp->SetBoolField(TEXT("success"), true);
+        SendAutomationResponse(RequestingSocket, RequestId, true, Message,
+                               Resp, FString());
+      };
+      if ((bByClass &&
+           GetJsonStringField(Payload, TEXT("className")).IsEmpty()) ||
+          (bByTag && GetJsonStringField(Payload, TEXT("tag")).IsEmpty())) {
+        SendEmpty();
+        return true;
+      }
+
+      TSharedPtr<FJsonObject> QueryPayload = MakeShared<FJsonObject>();
+      QueryPayload->Values = Payload->Values;
+      if (bByClass && !Payload->HasField(TEXT("includeSubclasses"))) {
+        // As before the query engine: the class name or any part of the
+        // class path ("StaticMesh", "BP_Door"), no class lookup needed.
+        QueryPayload->SetStringField(
+            TEXT("classPathContains"),
+            GetJsonStringField(Payload, TEXT("className")));
+        QueryPayload->RemoveField(TEXT("className"));
+      }
+
+      FMcpSceneQuery Query;
+      FString QueryError;
+      FString QueryErrorCode;
+      if (!Query.Parse(QueryPayload, QueryError, QueryErrorCode)) {
+        if (bLegacy && QueryErrorCode == TEXT("CLASS_NOT_FOUND")) {
+          // An unknown class simply matched nothing here.
+          SendEmpty();
+        } else {
+          SendAutomationError(RequestingSocket, RequestId, QueryError,
+                              QueryErrorCode);
         }
+        return true;
       }
-      Resp->SetArrayField(TEXT("objects"), ObjectsArray);
-      Resp->SetNumberField(TEXT("count"), ObjectsArray.Num());
-      Resp->SetBoolField(TEXT("success"), true);
-      SendAutomationResponse(RequestingSocket, RequestId, true,
-                             TEXT("Objects found by class"), Resp, FString());
-      return true;
-    }
-    else if (LowerSubAction.Equals(TEXT("find_by_tag"))) {
-      FString Tag;
-      Payload->TryGetStringField(TEXT("tag"), Tag);
-      TArray<TSharedPtr<FJsonValue>> ObjectsArray;
-      if (GEditor && GEditor->GetEditorWorldContext().World() && !Tag.IsEmpty()) {
-        UWorld* World = GEditor->GetEditorWorldContext().World();
-        for (TActorIterator<AActor> It(World); It; ++It) {
-          AActor* Actor = *It;
-          if (Actor->ActorHasTag(FName(*Tag))) {
-            TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
-            Obj->SetStringField(TEXT("name"), Actor->GetName());
-            Obj->SetStringField(TEXT("path"), Actor->GetPathName());
-            Obj->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
-            ObjectsArray.Add(MakeShared<FJsonValueObject>(Obj));
-          }
+      if (Query.NeedsCenterActor()) {
+        AActor *NearActor = FindActorByName(Query.GetCenterActorName());
+        if (!NearActor) {
+          SendAutomationError(
+              RequestingSocket, RequestId,
+              FString::Printf(TEXT("Actor not found: %s"),
+                              *Query.GetCenterActorName()),
+              TEXT("ACTOR_NOT_FOUND"));
+          return true;
         }
+        Query.SetCenter(NearActor->GetActorLocation());
+      }
+      if (bLegacy) {
+        Query.SetDefaultLimit(0);
+      }
+
+      UWorld *World =
+          GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+      if (!Query.Execute(World, ArrayField, Resp, QueryError,
+                         QueryErrorCode)) {
+        SendAutomationError(RequestingSocket, RequestId, QueryError,
+                            QueryErrorCode);
+        return true;
       }
-      Resp->SetArrayField(TEXT("objects"), ObjectsArray);
-      Resp->SetNumberField(TEXT("count"), ObjectsArray.Num());
       Resp->SetBoolField(TEXT("success"), true);
-      SendAutomationResponse(RequestingSocket, RequestId, true,
-                             TEXT("Objects found by tag"), Resp, FString());
+      SendAutomationResponse(RequestingSocket, RequestId, true, Message, Resp,
+                             FString());
       return true;
     }
     else if (LowerSubAction.Equals(TEXT("inspect_class"))) {
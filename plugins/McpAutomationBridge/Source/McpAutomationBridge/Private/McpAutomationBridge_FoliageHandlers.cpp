@@ -2,6 +2,8 @@
 #include "Dom/JsonObject.h"
 #include "McpAutomationBridgeHelpers.h"
 #include "McpAutomationBridgeSubsystem.h"
+#include "McpResponseStream.h"
+#include "McpTasklet.h"
 
 #if WITH_EDITOR
 #include "EditorAssetLibrary.h"
@@ -177,35 +179,76 @@ bool UMcpAutomationBridgeSubsystem::HandlePaintFoliage(
     return true;
   }
 
-  TArray<FVector> PlacedLocations;
-  for (const FVector &Location : Locations) {
-    FFoliageInstance Instance;
-    Instance.Location = Location;
-    Instance.Rotation = FRotator::ZeroRotator;
-    Instance.DrawScale3D = FVector3f(1.0f);
-    Instance.ZOffset = 0.0f;
-
-    if (FFoliageInfo *Info = IFA->FindInfo(FoliageType)) {
-      Info->AddInstance(FoliageType, Instance, /*InBaseComponent*/ nullptr);
-    } else {
-      IFA->AddFoliageType(FoliageType);
-      if (FFoliageInfo *NewInfo = IFA->FindInfo(FoliageType)) {
-        NewInfo->AddInstance(FoliageType, Instance,
-                             /*InBaseComponent*/ nullptr);
-      }
-    }
-    PlacedLocations.Add(Location);
-  }
+  // Instances are added in slices so painting tens of thousands of points
+  // does not stall the editor; the actor and type are re-resolved each step
+  // in case they were deleted or collected in between.
+  constexpr int32 InstancesPerStep = 256;
+  TSharedRef<TArray<FVector>> PendingLocations =
+      MakeShared<TArray<FVector>>(MoveTemp(Locations));
+  TSharedRef<int32> PlacedCount = MakeShared<int32>(0);
+  TWeakObjectPtr<AInstancedFoliageActor> WeakIFA(IFA);
+  TWeakObjectPtr<UFoliageType> WeakFoliageType(FoliageType);
 
   IFA->Modify();
 
-  TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
-  Resp->SetBoolField(TEXT("success"), true);
-  Resp->SetStringField(TEXT("foliageTypePath"), FoliageTypePath);
-  Resp->SetNumberField(TEXT("instancesPlaced"), PlacedLocations.Num());
+  TSharedPtr<FMcpTasklet> Tasklet = MakeShared<FMcpTasklet>();
+  Tasklet->Name = TEXT("paint_foliage");
+  Tasklet->RequestId = RequestId;
+  Tasklet->Socket = RequestingSocket;
+  Tasklet->NumSteps =
+      FMath::DivideAndRoundUp(PendingLocations->Num(), InstancesPerStep);
+  Tasklet->Step = [WeakIFA, WeakFoliageType, PendingLocations,
+                   PlacedCount](int32 StepIndex) {
+    AInstancedFoliageActor *StepIFA = WeakIFA.Get();
+    UFoliageType *StepFoliageType = WeakFoliageType.Get();
+    if (!StepIFA || !StepFoliageType) {
+      return false;
+    }
 
-  SendAutomationResponse(RequestingSocket, RequestId, true,
-                         TEXT("Foliage painted successfully"), Resp, FString());
+    const int32 First = StepIndex * InstancesPerStep;
+    const int32 Last =
+        FMath::Min(First + InstancesPerStep, PendingLocations->Num());
+    for (int32 Index = First; Index < Last; ++Index) {
+      FFoliageInstance Instance;
+      Instance.Location = (*PendingLocations)[Index];
+      Instance.Rotation = FRotator::ZeroRotator;
+      Instance.DrawScale3D = FVector3f(1.0f);
+      Instance.ZOffset = 0.0f;
+
+      if (FFoliageInfo *Info = StepIFA->FindInfo(StepFoliageType)) {
+        Info->AddInstance(StepFoliageType, Instance,
+                          /*InBaseComponent*/ nullptr);
+      } else {
+        StepIFA->AddFoliageType(StepFoliageType);
+        if (FFoliageInfo *NewInfo = StepIFA->FindInfo(StepFoliageType)) {
+          NewInfo->AddInstance(StepFoliageType, Instance,
+                               /*InBaseComponent*/ nullptr);
+        }
+      }
+      ++(*PlacedCount);
+    }
+    return true;
+  };
+  Tasklet->Finish = [this, RequestId, RequestingSocket, FoliageTypePath,
+                     PlacedCount, PendingLocations](bool bAborted) {
+    TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
+    Resp->SetBoolField(TEXT("success"), !bAborted);
+    Resp->SetStringField(TEXT("foliageTypePath"), FoliageTypePath);
+    Resp->SetNumberField(TEXT("instancesPlaced"), *PlacedCount);
+    Resp->SetNumberField(TEXT("instancesRequested"), PendingLocations->Num());
+
+    if (bAborted) {
+      SendAutomationResponse(
+          RequestingSocket, RequestId, false,
+          TEXT("Foliage actor or type went away while painting"), Resp,
+          TEXT("FOLIAGE_ACTOR_FAILED"));
+      return;
+    }
+    SendAutomationResponse(RequestingSocket, RequestId, true,
+                           TEXT("Foliage painted successfully"), Resp,
+                           FString());
+  };
+  StartTasklet(Tasklet);
   return true;
 #else
   SendAutomationResponse(RequestingSocket, RequestId, false,
@@ -348,6 +391,16 @@ bool UMcpAutomationBridgeSubsystem::HandleGetFoliageInstances(
   }
 
   TArray<TSharedPtr<FJsonValue>> InstancesArray;
+  const TSharedPtr<FMcpResponseStream> Stream = BeginResponseStream(
+      RequestId, Payload, RequestingSocket, TEXT("instances"));
+  // Returns false once a streaming client cancelled.
+  auto EmitInstance = [&InstancesArray, &Stream](TSharedPtr<FJsonObject> InstObj) {
+    if (Stream.IsValid()) {
+      return Stream->Add(InstObj);
+    }
+    InstancesArray.Add(MakeShared<FJsonValueObject>(InstObj));
+    return true;
+  };
 
   if (!FoliageTypePath.IsEmpty()) {
     if (!UEditorAssetLibrary::DoesAssetExist(FoliageTypePath)) {
@@ -375,7 +428,9 @@ bool UMcpAutomationBridgeSubsystem::HandleGetFoliageInstances(
           InstObj->SetNumberField(TEXT("pitch"), Inst.Rotation.Pitch);
           InstObj->SetNumberField(TEXT("yaw"), Inst.Rotation.Yaw);
           InstObj->SetNumberField(TEXT("roll"), Inst.Rotation.Roll);
-          InstancesArray.Add(MakeShared<FJsonValueObject>(InstObj));
+          if (!EmitInstance(InstObj)) {
+            break;
+          }
         }
       }
     }
@@ -387,7 +442,9 @@ bool UMcpAutomationBridgeSubsystem::HandleGetFoliageInstances(
         InstObj->SetNumberField(TEXT("x"), Inst.Location.X);
         InstObj->SetNumberField(TEXT("y"), Inst.Location.Y);
         InstObj->SetNumberField(TEXT("z"), Inst.Location.Z);
-        InstancesArray.Add(MakeShared<FJsonValueObject>(InstObj));
+        if (!EmitInstance(InstObj)) {
+          return false;
+        }
       }
       return true;
     });
@@ -395,6 +452,12 @@ bool UMcpAutomationBridgeSubsystem::HandleGetFoliageInstances(
 
   TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
   Resp->SetBoolField(TEXT("success"), true);
+  if (Stream.IsValid()) {
+    Resp->SetNumberField(TEXT("count"), Stream->GetNumItems());
+    FinishResponseStream(Stream, RequestingSocket, RequestId,
+                         TEXT("Foliage instances retrieved"), Resp);
+    return true;
+  }
   Resp->SetArrayField(TEXT("instances"), InstancesArray);
   Resp->SetNumberField(TEXT("count"), InstancesArray.Num());
 
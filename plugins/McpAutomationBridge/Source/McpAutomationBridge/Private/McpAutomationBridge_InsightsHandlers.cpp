@@ -2,6 +2,46 @@
 #include "Dom/JsonObject.h"
 #include "McpAutomationBridgeHelpers.h"
 #include "McpAutomationBridgeGlobals.h"
+#include "McpBridgeTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "ProfilingDebugging/TraceAuxiliary.h"
+
+namespace
+{
+    /** Adds the bridge's own trace channel to a Trace.Start channel list unless already present. */
+    FString McpWithBridgeChannel(const FString& Channels)
+    {
+        const FString Base = Channels.IsEmpty() ? FString(TEXT("default")) : Channels;
+        TArray<FString> Parts;
+        Base.ParseIntoArray(Parts, TEXT(","), true);
+        for (const FString& Part : Parts)
+        {
+            if (Part.TrimStartAndEnd().Equals(TEXT("McpBridge"), ESearchCase::IgnoreCase))
+            {
+                return Base;
+            }
+        }
+        return Base + TEXT(",McpBridge");
+    }
+
+    bool McpIsTraceActive()
+    {
+#if UE_TRACE_ENABLED
+        return FTraceAuxiliary::IsConnected();
+#else
+        return false;
+#endif
+    }
+
+    FString McpTraceDestination()
+    {
+#if UE_TRACE_ENABLED && ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1
+        return FTraceAuxiliary::GetTraceDestinationString();
+#else
+        return FString();
+#endif
+    }
+}
 
 bool UMcpAutomationBridgeSubsystem::HandleInsightsAction(const FString& RequestId, const FString& Action, const TSharedPtr<FJsonObject>& Payload, TSharedPtr<FMcpBridgeWebSocket> RequestingSocket)
 {
@@ -21,22 +61,95 @@ bool UMcpAutomationBridgeSubsystem::HandleInsightsAction(const FString& RequestI
     if (SubAction == TEXT("start_session"))
     {
         // Start trace using console command which is the standard way to control trace from editor
-        // "Trace.Start"
-        
+        // "Trace.Start". The McpBridge channel is added unless includeBridgeChannel is false so
+        // automation requests show up next to the frames they ran in.
         FString Channels;
+        Payload->TryGetStringField(TEXT("channels"), Channels);
+        const bool bIncludeBridge = GetJsonBoolField(Payload, TEXT("includeBridgeChannel"), true);
+        if (bIncludeBridge)
+        {
+            Channels = McpWithBridgeChannel(Channels);
+        }
+
         TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
-        if (Payload->TryGetStringField(TEXT("channels"), Channels) && !Channels.IsEmpty())
+        const bool bWasActive = McpIsTraceActive();
+        if (bWasActive)
+        {
+            // Trace.Start refuses while a session is running; still make sure our channel is on.
+#if UE_TRACE_ENABLED
+            if (bIncludeBridge)
+            {
+                UE::Trace::ToggleChannel(TEXT("McpBridge"), true);
+            }
+#endif
+        }
+        else if (!Channels.IsEmpty())
         {
              GEngine->Exec(nullptr, *FString::Printf(TEXT("Trace.Start %s"), *Channels));
-             Result->SetStringField(TEXT("channels"), Channels);
         }
         else
         {
              GEngine->Exec(nullptr, TEXT("Trace.Start"));
         }
+        if (!Channels.IsEmpty())
+        {
+            Result->SetStringField(TEXT("channels"), Channels);
+        }
         Result->SetStringField(TEXT("action"), TEXT("start_trace"));
-        Result->SetStringField(TEXT("status"), TEXT("started"));
-        SendAutomationResponse(RequestingSocket, RequestId, true, TEXT("Trace session started."), Result);
+        Result->SetStringField(TEXT("status"), bWasActive ? TEXT("already_active") : TEXT("started"));
+        Result->SetBoolField(TEXT("active"), McpIsTraceActive());
+        Result->SetStringField(TEXT("destination"), McpTraceDestination());
+        Result->SetBoolField(TEXT("bridgeChannelEnabled"), McpTrace::IsChannelEnabled());
+        SendAutomationResponse(RequestingSocket, RequestId, true,
+                               bWasActive ? TEXT("Trace session already running.") : TEXT("Trace session started."), Result);
+        return true;
+    }
+
+    if (SubAction == TEXT("stop_session"))
+    {
+        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+        const bool bWasActive = McpIsTraceActive();
+        // Capture before stopping: the destination is cleared with the session.
+        Result->SetStringField(TEXT("destination"), McpTraceDestination());
+        if (bWasActive)
+        {
+            GEngine->Exec(nullptr, TEXT("Trace.Stop"));
+        }
+        Result->SetStringField(TEXT("action"), TEXT("stop_trace"));
+        Result->SetStringField(TEXT("status"), bWasActive ? TEXT("stopped") : TEXT("not_active"));
+        Result->SetBoolField(TEXT("active"), McpIsTraceActive());
+        SendAutomationResponse(RequestingSocket, RequestId, true,
+                               bWasActive ? TEXT("Trace session stopped.") : TEXT("No trace session was running."), Result);
+        return true;
+    }
+
+    if (SubAction == TEXT("status"))
+    {
+        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+        Result->SetBoolField(TEXT("traceEnabled"), UE_TRACE_ENABLED != 0);
+        Result->SetBoolField(TEXT("active"), McpIsTraceActive());
+        Result->SetStringField(TEXT("destination"), McpTraceDestination());
+        Result->SetBoolField(TEXT("bridgeChannelEnabled"), McpTrace::IsChannelEnabled());
+        SendAutomationResponse(RequestingSocket, RequestId, true, TEXT("Trace status retrieved."), Result);
+        return true;
+    }
+
+    if (SubAction == TEXT("bookmark"))
+    {
+        const FString Label = GetJsonStringField(Payload, TEXT("label"));
+        if (Label.IsEmpty())
+        {
+            SendAutomationError(RequestingSocket, RequestId, TEXT("bookmark requires 'label'."), TEXT("INVALID_ARGUMENT"));
+            return true;
+        }
+        // Bookmarks ride the Bookmark channel (part of the default set) and appear as
+        // vertical markers in the Timing view.
+        TRACE_BOOKMARK(TEXT("%s"), *Label);
+
+        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+        Result->SetStringField(TEXT("label"), Label);
+        Result->SetBoolField(TEXT("recorded"), McpIsTraceActive());
+        SendAutomationResponse(RequestingSocket, RequestId, true, TEXT("Trace bookmark added."), Result);
         return true;
     }
 
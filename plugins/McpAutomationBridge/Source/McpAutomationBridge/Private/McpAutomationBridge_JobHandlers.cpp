@@ -0,0 +1,291 @@
+#include "McpAutomationBridgeSubsystem.h"
+#include "Dom/JsonObject.h"
+#include "McpAutomationBridgeGlobals.h"
+#include "McpAutomationBridgeHelpers.h"
+#include "McpAutomationJob.h"
+#include "McpBridgeWebSocket.h"
+#include "McpConnectionManager.h"
+#include "McpTransactionPolicy.h"
+#include "Misc/Guid.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+    /** Finished jobs kept around for get_job_status before the oldest are pruned. */
+    constexpr int32 McpMaxRetainedJobs = 128;
+
+    const TCHAR* McpJobStateName(const FMcpAutomationJob& Job)
+    {
+        if (!Job.bCompleted)
+        {
+            return TEXT("running");
+        }
+        return Job.bSuccess ? TEXT("succeeded") : TEXT("failed");
+    }
+}
+
+double FMcpAutomationJob::GetElapsedSeconds() const
+{
+    const double End = bCompleted ? EndSeconds : FPlatformTime::Seconds();
+    return FMath::Max(0.0, End - StartSeconds);
+}
+
+TSharedPtr<FJsonObject> FMcpAutomationJob::ToJson() const
+{
+    TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetStringField(TEXT("jobId"), JobId);
+    Json->SetStringField(TEXT("kind"), Kind);
+    Json->SetStringField(TEXT("requestId"), RequestId);
+    Json->SetStringField(TEXT("state"), McpJobStateName(*this));
+    Json->SetNumberField(TEXT("elapsedMs"), GetElapsedSeconds() * 1000.0);
+    if (bCompleted)
+    {
+        Json->SetBoolField(TEXT("success"), bSuccess);
+        if (!Message.IsEmpty())
+        {
+            Json->SetStringField(TEXT("message"), Message);
+        }
+        if (!ErrorCode.IsEmpty())
+        {
+            Json->SetStringField(TEXT("error"), ErrorCode);
+        }
+        if (Result.IsValid())
+        {
+            Json->SetObjectField(TEXT("result"), Result);
+        }
+    }
+    return Json;
+}
+
+TSharedPtr<FMcpAutomationJob> UMcpAutomationBridgeSubsystem::BeginAutomationJob(
+    const FString& Kind, const FString& RequestId, TSharedPtr<FMcpBridgeWebSocket> Socket, double TimeoutSeconds)
+{
+    TSharedPtr<FMcpAutomationJob> Job = MakeShared<FMcpAutomationJob>();
+    Job->JobId = FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphensLower);
+    Job->Kind = Kind;
+    Job->RequestId = RequestId;
+    Job->Socket = Socket;
+    if (ConnectionManager.IsValid())
+    {
+        Job->ClientSessionId = ConnectionManager->GetClientSessionId(Socket.Get());
+    }
+    Job->TransactionPolicy = FMcpTransactionPolicy::Get().GetPolicy(Socket.Get());
+    Job->StartSeconds = FPlatformTime::Seconds();
+    Job->TimeoutSeconds = TimeoutSeconds;
+    AutomationJobs.Add(Job->JobId, Job);
+    // The job keeps mutating after its job_started reply; the client's reads
+    // stay off the worker path until it finishes.
+    BeginClientMutation(Socket, TEXT("job:") + Job->JobId);
+
+    // Jobs are polled every frame rather than on the 0.1s request tick: test latent
+    // commands and benchmark frame sampling both need per-frame updates.
+    if (!JobTickHandle.IsValid())
+    {
+        JobTickHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateUObject(this, &UMcpAutomationBridgeSubsystem::TickAutomationJobs));
+    }
+    return Job;
+}
+
+void UMcpAutomationBridgeSubsystem::CompleteAutomationJob(
+    const FString& JobId, bool bSuccess, const FString& Message, const TSharedPtr<FJsonObject>& Result, const FString& ErrorCode)
+{
+    TSharedPtr<FMcpAutomationJob>* Found = AutomationJobs.Find(JobId);
+    if (!Found || !Found->IsValid() || (*Found)->bCompleted)
+    {
+        return;
+    }
+    FMcpAutomationJob& Job = **Found;
+    Job.bSuccess = bSuccess;
+    Job.Message = Message;
+    Job.Result = Result;
+    Job.ErrorCode = ErrorCode;
+    FinishAutomationJob(*Found);
+}
+
+bool UMcpAutomationBridgeSubsystem::SendAutomationJobEvent(const FMcpAutomationJob& Job,
+                                                           const TSharedPtr<FJsonObject>& Event)
+{
+    FString Serialized;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Serialized);
+    FJsonSerializer::Serialize(Event.ToSharedRef(), Writer);
+
+    // The event goes to the requester's session only; while it is reconnecting the
+    // session buffers the event and delivers it on resume.
+    return ConnectionManager.IsValid() &&
+        ConnectionManager->SendSessionEvent(Job.ClientSessionId, Job.Socket.Pin(), Serialized);
+}
+
+void UMcpAutomationBridgeSubsystem::FinishAutomationJob(TSharedPtr<FMcpAutomationJob> Job)
+{
+    Job->bCompleted = true;
+    Job->EndSeconds = FPlatformTime::Seconds();
+    EndClientMutation(nullptr, TEXT("job:") + Job->JobId);
+    Job->Poll = nullptr;
+    if (Job->OnFinished)
+    {
+        TFunction<void()> OnFinished = MoveTemp(Job->OnFinished);
+        Job->OnFinished = nullptr;
+        OnFinished();
+    }
+
+    TSharedPtr<FJsonObject> Event = Job->ToJson();
+    Event->SetStringField(TEXT("type"), TEXT("automation_event"));
+    Event->SetStringField(TEXT("event"), TEXT("job_completed"));
+    if (!SendAutomationJobEvent(*Job, Event))
+    {
+        UE_LOG(LogMcpAutomationBridgeSubsystem, Verbose, TEXT("job_completed for %s not sent; held for resume or get_job_status"),
+               *Job->JobId);
+    }
+
+    UE_LOG(LogMcpAutomationBridgeSubsystem, Log, TEXT("Job %s (%s) %s after %.2fs"),
+           *Job->JobId, *Job->Kind, Job->bSuccess ? TEXT("succeeded") : TEXT("failed"), Job->GetElapsedSeconds());
+
+    PruneAutomationJobs();
+}
+
+void UMcpAutomationBridgeSubsystem::PruneAutomationJobs()
+{
+    TArray<TSharedPtr<FMcpAutomationJob>> Finished;
+    for (const TPair<FString, TSharedPtr<FMcpAutomationJob>>& Pair : AutomationJobs)
+    {
+        if (Pair.Value->bCompleted)
+        {
+            Finished.Add(Pair.Value);
+        }
+    }
+    if (Finished.Num() <= McpMaxRetainedJobs)
+    {
+        return;
+    }
+    Finished.Sort([](const TSharedPtr<FMcpAutomationJob>& A, const TSharedPtr<FMcpAutomationJob>& B)
+    {
+        return A->EndSeconds < B->EndSeconds;
+    });
+    for (int32 Index = 0; Index < Finished.Num() - McpMaxRetainedJobs; ++Index)
+    {
+        AutomationJobs.Remove(Finished[Index]->JobId);
+    }
+}
+
+bool UMcpAutomationBridgeSubsystem::TickAutomationJobs(float DeltaTime)
+{
+    const double Now = FPlatformTime::Seconds();
+
+    // Poll callbacks may start or finish other jobs, so work from a copy.
+    TArray<TSharedPtr<FMcpAutomationJob>> Running;
+    for (const TPair<FString, TSharedPtr<FMcpAutomationJob>>& Pair : AutomationJobs)
+    {
+        if (!Pair.Value->bCompleted)
+        {
+            Running.Add(Pair.Value);
+        }
+    }
+
+    for (const TSharedPtr<FMcpAutomationJob>& Job : Running)
+    {
+        if (Job->bCompleted)
+        {
+            continue;
+        }
+        bool bPolledDone = false;
+        if (Job->Poll)
+        {
+            const FMcpRequestTransactionScope TransactionScope(Job->Kind, Job->TransactionPolicy);
+            bPolledDone = Job->Poll(*Job);
+        }
+        if (bPolledDone)
+        {
+            FinishAutomationJob(Job);
+        }
+        else if (!Job->bCompleted && Job->TimeoutSeconds > 0.0 && Now - Job->StartSeconds > Job->TimeoutSeconds)
+        {
+            Job->bSuccess = false;
+            Job->ErrorCode = TEXT("JOB_TIMEOUT");
+            Job->Message = FString::Printf(TEXT("%s job did not complete within %.0fs"), *Job->Kind, Job->TimeoutSeconds);
+            FinishAutomationJob(Job);
+        }
+    }
+
+    for (const TPair<FString, TSharedPtr<FMcpAutomationJob>>& Pair : AutomationJobs)
+    {
+        if (!Pair.Value->bCompleted)
+        {
+            return true;
+        }
+    }
+    JobTickHandle.Reset();
+    return false;
+}
+
+void UMcpAutomationBridgeSubsystem::ShutdownAutomationJobs()
+{
+    if (JobTickHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(JobTickHandle);
+        JobTickHandle.Reset();
+    }
+    for (const TPair<FString, TSharedPtr<FMcpAutomationJob>>& Pair : AutomationJobs)
+    {
+        if (!Pair.Value->bCompleted && Pair.Value->OnFinished)
+        {
+            Pair.Value->OnFinished();
+        }
+    }
+    AutomationJobs.Empty();
+}
+
+bool UMcpAutomationBridgeSubsystem::HandleJobAction(const FString& RequestId, const FString& Action, const TSharedPtr<FJsonObject>& Payload, TSharedPtr<FMcpBridgeWebSocket> RequestingSocket)
+{
+    const FString Lower = Action.ToLower();
+    if (Lower == TEXT("get_job_status"))
+    {
+        const FString JobId = GetJsonStringField(Payload, TEXT("jobId"));
+        if (JobId.IsEmpty())
+        {
+            SendAutomationError(RequestingSocket, RequestId, TEXT("jobId is required."), TEXT("INVALID_ARGUMENT"));
+            return true;
+        }
+        const TSharedPtr<FMcpAutomationJob>* Found = AutomationJobs.Find(JobId);
+        if (!Found)
+        {
+            SendAutomationError(RequestingSocket, RequestId, FString::Printf(TEXT("Unknown job: %s"), *JobId), TEXT("NOT_FOUND"));
+            return true;
+        }
+        SendAutomationResponse(RequestingSocket, RequestId, true, FString::Printf(TEXT("Job is %s"), McpJobStateName(**Found)), (*Found)->ToJson());
+        return true;
+    }
+
+    if (Lower == TEXT("list_jobs"))
+    {
+        const bool bRunningOnly = GetJsonBoolField(Payload, TEXT("runningOnly"), false);
+        TArray<TSharedPtr<FMcpAutomationJob>> Jobs;
+        AutomationJobs.GenerateValueArray(Jobs);
+        Jobs.Sort([](const TSharedPtr<FMcpAutomationJob>& A, const TSharedPtr<FMcpAutomationJob>& B)
+        {
+            return A->StartSeconds > B->StartSeconds;
+        });
+
+        TArray<TSharedPtr<FJsonValue>> JobArray;
+        int32 RunningCount = 0;
+        for (const TSharedPtr<FMcpAutomationJob>& Job : Jobs)
+        {
+            RunningCount += Job->bCompleted ? 0 : 1;
+            if (bRunningOnly && Job->bCompleted)
+            {
+                continue;
+            }
+            JobArray.Add(MakeShared<FJsonValueObject>(Job->ToJson()));
+        }
+
+        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+        Result->SetArrayField(TEXT("jobs"), JobArray);
+        Result->SetNumberField(TEXT("running"), RunningCount);
+        Result->SetNumberField(TEXT("total"), Jobs.Num());
+        SendAutomationResponse(RequestingSocket, RequestId, true, FString::Printf(TEXT("%d job(s), %d running"), Jobs.Num(), RunningCount), Result);
+        return true;
+    }
+
+    return false;
+}
@@ -2,6 +2,8 @@
 #include "Dom/JsonObject.h"
 #include "McpAutomationBridgeHelpers.h"
 #include "McpAutomationBridgeSubsystem.h"
+#include "McpAutomationJob.h"
+#include "McpResponseStream.h"
 
 #if WITH_EDITOR
 #include "Editor.h"
@@ -1301,15 +1303,28 @@ bool UMcpAutomationBridgeSubsystem::HandleLevelAction(
       return true;
     }
     
+    const TSharedPtr<FMcpResponseStream> Stream =
+        BeginResponseStream(RequestId, Payload, RequestingSocket, TEXT("actors"));
     TArray<TSharedPtr<FJsonValue>> ActorsArray;
     for (AActor* Actor : TargetLevel->Actors) {
-      if (Actor) {
-        ActorsArray.Add(MakeShared<FJsonValueString>(Actor->GetName()));
+      if (!Actor) {
+        continue;
+      }
+      TSharedPtr<FJsonValue> Name = MakeShared<FJsonValueString>(Actor->GetName());
+      if (!Stream.IsValid()) {
+        ActorsArray.Add(Name);
+      } else if (!Stream->Add(Name)) {
+        break;
       }
     }
     
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
     Result->SetStringField(TEXT("levelPath"), TargetLevel->GetOutermost() ? TargetLevel->GetOutermost()->GetName() : TEXT(""));
+    if (Stream.IsValid()) {
+      Result->SetNumberField(TEXT("count"), Stream->GetNumItems());
+      FinishResponseStream(Stream, RequestingSocket, RequestId, TEXT("Level actors retrieved"), Result);
+      return true;
+    }
     Result->SetNumberField(TEXT("count"), ActorsArray.Num());
     Result->SetArrayField(TEXT("actors"), ActorsArray);
     
@@ -1397,10 +1412,12 @@ bool UMcpAutomationBridgeSubsystem::HandleLevelAction(
       return true;
     }
     
+    TSharedPtr<FMcpAutomationJob> Job = BeginLightingBuildJob(RequestId, RequestingSocket);
     FEditorBuildUtils::EditorBuild(World, FBuildOptions::BuildLighting);
     
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
     Result->SetBoolField(TEXT("buildStarted"), true);
+    Result->SetStringField(TEXT("jobId"), Job->JobId);
     
     SendAutomationResponse(RequestingSocket, RequestId, true, TEXT("Lighting build started"), Result);
     return true;
@@ -1414,9 +1431,11 @@ bool UMcpAutomationBridgeSubsystem::HandleLevelAction(
     }
     
     FEditorBuildUtils::EditorBuild(World, FBuildOptions::BuildAIPaths);
+    TSharedPtr<FMcpAutomationJob> Job = BeginNavigationBuildJob(World, RequestId, RequestingSocket);
     
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
     Result->SetBoolField(TEXT("buildStarted"), true);
+    Result->SetStringField(TEXT("jobId"), Job->JobId);
     
     SendAutomationResponse(RequestingSocket, RequestId, true, TEXT("Navigation build started"), Result);
     return true;
@@ -2,6 +2,7 @@
 #include "Dom/JsonObject.h"
 #include "McpAutomationBridgeHelpers.h"
 #include "McpAutomationBridgeSubsystem.h"
+#include "McpAutomationJob.h"
 #include "UObject/UObjectIterator.h"
 
 #include "Components/ExponentialHeightFogComponent.h"
@@ -83,12 +84,12 @@ bool UMcpAutomationBridgeSubsystem::HandleLightingAction(
     AddedNames.Add(TEXT("SpotLight"));
     AddedNames.Add(TEXT("RectLight"));
 
-    for (TObjectIterator<UClass> It; It; ++It) {
-      if (It->IsChildOf(ALight::StaticClass()) &&
-          !It->HasAnyClassFlags(CLASS_Abstract) &&
-          !AddedNames.Contains(It->GetName())) {
-        Types.Add(MakeShared<FJsonValueString>(It->GetName()));
-        AddedNames.Add(It->GetName());
+    TArray<UClass *> LightClasses;
+    FMcpReflectionIndex::GetDerivedClasses(ALight::StaticClass(), LightClasses);
+    for (UClass *LightClass : LightClasses) {
+      if (!AddedNames.Contains(LightClass->GetName())) {
+        Types.Add(MakeShared<FJsonValueString>(LightClass->GetName()));
+        AddedNames.Add(LightClass->GetName());
       }
     }
 
@@ -312,13 +313,22 @@ bool UMcpAutomationBridgeSubsystem::HandleLightingAction(
                            TEXT("SkyLight spawned"), Resp);
     return true;
   } else if (Lower == TEXT("build_lighting")) {
-    if (GEditor && GEditor->GetEditorWorldContext().World()) {
-      if (GEditor && GEditor->GetEditorWorldContext().World())
-        GEditor->Exec(GEditor->GetEditorWorldContext().World(),
-                      TEXT("BuildLighting Production"));
+    UWorld *World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    if (!World) {
+      SendAutomationError(RequestingSocket, RequestId,
+                          TEXT("No editor world available"), TEXT("NO_WORLD"));
+      return true;
     }
+    // Bind the completion delegates before kicking off the build so a build
+    // that finishes immediately still reports back.
+    TSharedPtr<FMcpAutomationJob> Job =
+        BeginLightingBuildJob(RequestId, RequestingSocket);
+    GEditor->Exec(World, TEXT("BuildLighting Production"));
+
+    TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
+    Resp->SetStringField(TEXT("jobId"), Job->JobId);
     SendAutomationResponse(RequestingSocket, RequestId, true,
-                           TEXT("Lighting build started"), nullptr);
+                           TEXT("Lighting build started"), Resp);
     return true;
   } else if (Lower == TEXT("ensure_single_sky_light")) {
     TArray<AActor *> AllActors = ActorSS->GetAllLevelActors();
@@ -663,3 +673,62 @@ bool UMcpAutomationBridgeSubsystem::HandleLightingAction(
   return true;
 #endif
 }
+
+#if WITH_EDITOR
+TSharedPtr<FMcpAutomationJob> UMcpAutomationBridgeSubsystem::BeginLightingBuildJob(
+    const FString &RequestId, TSharedPtr<FMcpBridgeWebSocket> Socket) {
+  TSharedPtr<FMcpAutomationJob> Job =
+      BeginAutomationJob(TEXT("lighting_build"), RequestId, Socket);
+  const FString JobId = Job->JobId;
+  const FString WorldName = GEditor && GEditor->GetEditorWorldContext().World()
+                                ? GEditor->GetEditorWorldContext().World()->GetName()
+                                : FString();
+  TWeakObjectPtr<UMcpAutomationBridgeSubsystem> WeakThis(this);
+
+  auto Complete = [WeakThis, JobId, WorldName](bool bSucceeded) {
+    if (!WeakThis.IsValid()) {
+      return;
+    }
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetStringField(TEXT("world"), WorldName);
+    Result->SetBoolField(TEXT("succeeded"), bSucceeded);
+    WeakThis->CompleteAutomationJob(
+        JobId, bSucceeded,
+        bSucceeded ? TEXT("Lighting build succeeded")
+                   : TEXT("Lighting build failed"),
+        Result, bSucceeded ? FString() : TEXT("LIGHTING_BUILD_FAILED"));
+  };
+  const FDelegateHandle SucceededHandle =
+      FEditorDelegates::OnLightingBuildSucceeded.AddLambda(
+          [Complete]() { Complete(true); });
+  const FDelegateHandle FailedHandle =
+      FEditorDelegates::OnLightingBuildFailed.AddLambda(
+          [Complete]() { Complete(false); });
+  Job->OnFinished = [SucceededHandle, FailedHandle]() {
+    FEditorDelegates::OnLightingBuildSucceeded.Remove(SucceededHandle);
+    FEditorDelegates::OnLightingBuildFailed.Remove(FailedHandle);
+  };
+
+  // Fallback when the build never starts (or is cancelled from the UI) and
+  // neither delegate fires: give up after a few idle seconds.
+  TSharedRef<double> IdleSince = MakeShared<double>(0.0);
+  Job->Poll = [IdleSince](FMcpAutomationJob &RunningJob) {
+    if (GEditor && GEditor->IsLightingBuildCurrentlyRunning()) {
+      *IdleSince = 0.0;
+      return false;
+    }
+    const double Now = FPlatformTime::Seconds();
+    if (*IdleSince == 0.0) {
+      *IdleSince = Now;
+    }
+    if (Now - *IdleSince < 5.0) {
+      return false;
+    }
+    RunningJob.bSuccess = false;
+    RunningJob.ErrorCode = TEXT("LIGHTING_BUILD_NOT_RUNNING");
+    RunningJob.Message = TEXT("Lighting build is not running");
+    return true;
+  };
+  return Job;
+}
+#endif
@@ -4,93 +4,266 @@
 #include "McpAutomationBridgeGlobals.h"
 #include "Misc/OutputDevice.h"
 #include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformOutputDevices.h"
+#include "Serialization/Archive.h"
+#include "Algo/Reverse.h"
+#include "HAL/Event.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Logging/LogVerbosity.h"
+#include "McpBoundedRing.h"
+#include "McpBridgeWebSocket.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
 
-// Define a custom output device to capture logs and stream them via the bridge
-class FMcpLogOutputDevice : public FOutputDevice
+namespace
+{
+    /** One captured log line waiting in the ring. */
+    struct FMcpLogLine
+    {
+        uint64 Sequence = 0;
+        FName Category;
+        ELogVerbosity::Type Verbosity = ELogVerbosity::Log;
+        FString Message;
+    };
+
+    /** Subscription options; fixed for the lifetime of a capture device. */
+    struct FMcpLogStreamOptions
+    {
+        /** When non-empty, only these categories are streamed. */
+        TSet<FName> IncludeCategories;
+        TSet<FName> ExcludeCategories;
+        /** Most verbose level streamed (Log streams Fatal..Log). */
+        ELogVerbosity::Type MaxVerbosity = ELogVerbosity::All;
+        uint32 BufferSize = 8192;
+        int32 FlushIntervalMs = 100;
+        int32 MaxBatchLines = 1000;
+    };
+}
+
+/**
+ * Captures log lines for manage_logs subscribe and streams them as batched log_batch frames.
+ *
+ * Serialize runs on whichever thread logs, so it only filters by FName and verbosity and pushes
+ * into a bounded ring; when the ring is full the oldest lines are dropped and counted. A flusher
+ * thread wakes every FlushIntervalMs, drains the ring and sends
+ * {type: "log_batch", lines: [{seq, category, verbosity, message}], dropped} directly to the
+ * subscribing socket, so neither the logging threads nor the game thread do any JSON or socket work.
+ */
+class FMcpLogOutputDevice : public FOutputDevice, public FRunnable
 {
 public:
-    FMcpLogOutputDevice(UMcpAutomationBridgeSubsystem* InSubsystem) 
-        : Subsystem(InSubsystem) 
+    FMcpLogOutputDevice(TSharedPtr<FMcpBridgeWebSocket> InSocket, FMcpLogStreamOptions&& InOptions)
+        : Socket(InSocket)
+        , Options(MoveTemp(InOptions))
+        , Ring(Options.BufferSize)
     {
+        // Our own category would feed back into the stream; these are too chatty to be useful.
+        Options.ExcludeCategories.Add(LogMcpAutomationBridgeSubsystem.GetCategoryName());
+        Options.ExcludeCategories.Add(FName(TEXT("LogRHI")));
+        Options.ExcludeCategories.Add(FName(TEXT("LogEOSSDK")));
+        Options.ExcludeCategories.Add(FName(TEXT("LogCsvProfiler")));
+
+        WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+        Thread = FRunnableThread::Create(this, TEXT("McpLogStreamFlusher"), 0, TPri_BelowNormal);
     }
 
+    virtual ~FMcpLogOutputDevice() override
+    {
+        StopFlusher();
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        WakeEvent = nullptr;
+    }
+
+    /** Stops the flusher after it has sent everything still in the ring. Call once removed from GLog. */
+    void StopFlusher()
+    {
+        if (Thread)
+        {
+            Thread->Kill(true);
+            delete Thread;
+            Thread = nullptr;
+        }
+    }
+
+    virtual bool CanBeUsedOnAnyThread() const override { return true; }
+    virtual bool CanBeUsedOnMultipleThreads() const override { return true; }
+
     virtual void Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category) override
     {
-        if (!Subsystem || !Subsystem->IsValidLowLevel())
+        const ELogVerbosity::Type Level = (ELogVerbosity::Type)(Verbosity & ELogVerbosity::VerbosityMask);
+        if (Level > Options.MaxVerbosity ||
+            Options.ExcludeCategories.Contains(Category) ||
+            (Options.IncludeCategories.Num() > 0 && !Options.IncludeCategories.Contains(Category)))
         {
             return;
         }
 
-        // Filter out very verbose logs if needed, but for now allow all
-        // Prevent infinite recursion if our own logging causes more logging
-        // Filter out highly verbose categories that clutter test output
-        // Use string comparison to be robust against FName issues
-        FString CategoryStr = Category.ToString();
+        // "Missing Resource from 'ProfileVisualizerStyle'" is a known engine warning during 'show collision'
+        static const FName NAME_LogSlateStyle(TEXT("LogSlateStyle"));
+        static const FName NAME_LogStats(TEXT("LogStats"));
+        if ((Level == ELogVerbosity::Warning && Category == NAME_LogSlateStyle &&
+             FCString::Strstr(V, TEXT("Missing Resource from 'ProfileVisualizerStyle'"))) ||
+            // "There is no thread with id" is noise during stat commands
+            (Category == NAME_LogStats && FCString::Strstr(V, TEXT("There is no thread with id"))))
+        {
+            return;
+        }
+
+        FMcpLogLine Line;
+        Line.Sequence = NextSequence.fetch_add(1, std::memory_order_relaxed);
+        Line.Category = Category;
+        Line.Verbosity = Level;
+        Line.Message = V;
+        if (const uint32 Evicted = Ring.Push(MoveTemp(Line)))
+        {
+            Dropped.fetch_add(Evicted, std::memory_order_relaxed);
+        }
+    }
 
-        if (Category == LogMcpAutomationBridgeSubsystem.GetCategoryName() ||
-            CategoryStr == TEXT("LogRHI") ||
-            CategoryStr == TEXT("LogEOSSDK") ||
-            CategoryStr == TEXT("LogCsvProfiler"))
+    virtual uint32 Run() override
+    {
+        while (!bStopping.load(std::memory_order_relaxed))
         {
-            return; 
+            WakeEvent->Wait(Options.FlushIntervalMs);
+            FlushPending();
         }
+        // Deliver whatever was captured before unsubscribe.
+        FlushPending();
+        return 0;
+    }
 
-        // Filter specific noisy warnings
-        if (Verbosity == ELogVerbosity::Warning && CategoryStr == TEXT("LogSlateStyle"))
+    virtual void Stop() override
+    {
+        bStopping = true;
+        WakeEvent->Trigger();
+    }
+
+    /** subscribe/unsubscribe/status summary. */
+    TSharedPtr<FJsonObject> GetStats() const
+    {
+        TSharedPtr<FJsonObject> Stats = MakeShared<FJsonObject>();
+        Stats->SetNumberField(TEXT("captured"), (double)NextSequence.load());
+        Stats->SetNumberField(TEXT("sent"), (double)Sent.load());
+        Stats->SetNumberField(TEXT("dropped"), (double)Dropped.load());
+        Stats->SetNumberField(TEXT("batches"), (double)Batches.load());
+        Stats->SetNumberField(TEXT("bufferSize"), Ring.GetCapacity());
+        Stats->SetNumberField(TEXT("flushIntervalMs"), Options.FlushIntervalMs);
+        Stats->SetStringField(TEXT("minVerbosity"), FString(ToString(Options.MaxVerbosity)));
+        return Stats;
+    }
+
+private:
+    void FlushPending()
+    {
+        TArray<FMcpLogLine> Lines;
+        FMcpLogLine Line;
+        while (Ring.TryPop(Line))
         {
-            // "Missing Resource from 'ProfileVisualizerStyle'" is a known engine warning during 'show collision'
-            if (FString(V).Contains(TEXT("Missing Resource from 'ProfileVisualizerStyle'")))
+            Lines.Add(MoveTemp(Line));
+            if (Lines.Num() >= Options.MaxBatchLines)
             {
-                return;
+                SendBatch(Lines);
+                Lines.Reset();
             }
         }
+        SendBatch(Lines);
+    }
 
-        if (CategoryStr == TEXT("LogStats")) 
+    void SendBatch(const TArray<FMcpLogLine>& Lines)
+    {
+        if (Lines.Num() == 0)
+        {
+            return;
+        }
+        if (!Socket.IsValid() || !Socket->IsConnected())
         {
-             // "There is no thread with id" is noise during stat commands
-             if (FString(V).Contains(TEXT("There is no thread with id")))
-             {
-                 return;
-             }
+            Dropped.fetch_add(Lines.Num(), std::memory_order_relaxed);
+            return;
         }
 
-        FString VerbosityString;
-        switch (Verbosity)
+        FString Serialized;
+        const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+            TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Serialized);
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("type"), TEXT("log_batch"));
+        Writer->WriteArrayStart(TEXT("lines"));
+        for (const FMcpLogLine& Entry : Lines)
         {
-            case ELogVerbosity::Fatal: VerbosityString = TEXT("Fatal"); break;
-            case ELogVerbosity::Error: VerbosityString = TEXT("Error"); break;
-            case ELogVerbosity::Warning: VerbosityString = TEXT("Warning"); break;
-            case ELogVerbosity::Display: VerbosityString = TEXT("Display"); break;
-            case ELogVerbosity::Log: VerbosityString = TEXT("Log"); break;
-            case ELogVerbosity::Verbose: VerbosityString = TEXT("Verbose"); break;
-            case ELogVerbosity::VeryVerbose: VerbosityString = TEXT("VeryVerbose"); break;
-            default: VerbosityString = TEXT("Log"); break;
+            Writer->WriteObjectStart();
+            Writer->WriteValue(TEXT("seq"), (int64)Entry.Sequence);
+            Writer->WriteValue(TEXT("category"), Entry.Category.ToString());
+            Writer->WriteValue(TEXT("verbosity"), FString(ToString(Entry.Verbosity)));
+            Writer->WriteValue(TEXT("message"), Entry.Message);
+            Writer->WriteObjectEnd();
         }
+        Writer->WriteArrayEnd();
+        // Cumulative, so a client can tell from any one batch whether it missed lines.
+        Writer->WriteValue(TEXT("dropped"), (int64)Dropped.load(std::memory_order_relaxed));
+        Writer->WriteObjectEnd();
+        Writer->Close();
 
-        FString Message = FString(V);
-        FString CategoryString = Category.ToString();
+        if (Socket->Send(Serialized))
+        {
+            Sent.fetch_add(Lines.Num(), std::memory_order_relaxed);
+            Batches.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            Dropped.fetch_add(Lines.Num(), std::memory_order_relaxed);
+        }
+    }
+
+    TSharedPtr<FMcpBridgeWebSocket> Socket;
+    FMcpLogStreamOptions Options;
+    TMcpBoundedRing<FMcpLogLine> Ring;
 
-        // Dispatch to game thread to ensure safe socket sending if not already there
-        // Actually, SendRawMessage might be thread safe, but let's be safe.
-        // Copy data for lambda capture
-        const FString PayloadJson = FString::Printf(TEXT("{\"event\":\"log\",\"category\":\"%s\",\"verbosity\":\"%s\",\"message\":\"%s\"}"), 
-            *CategoryString, *VerbosityString, *Message.ReplaceCharWithEscapedChar());
+    std::atomic<uint64> NextSequence{0};
+    std::atomic<uint64> Dropped{0};
+    std::atomic<uint64> Sent{0};
+    std::atomic<uint64> Batches{0};
+    std::atomic<bool> bStopping{false};
 
-        // Use a weak pointer to the subsystem to avoid crashing if it's destroyed
-        TWeakObjectPtr<UMcpAutomationBridgeSubsystem> WeakSubsystem(Subsystem);
+    FEvent* WakeEvent = nullptr;
+    FRunnableThread* Thread = nullptr;
+};
 
-        AsyncTask(ENamedThreads::GameThread, [WeakSubsystem, PayloadJson]()
+namespace
+{
+    void McpReadLogCategories(const TSharedPtr<FJsonObject>& Payload, const TCHAR* Field, TSet<FName>& OutCategories)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+        if (Payload->TryGetArrayField(Field, Values))
         {
-            if (UMcpAutomationBridgeSubsystem* StrongSubsystem = WeakSubsystem.Get())
+            for (const TSharedPtr<FJsonValue>& Value : *Values)
             {
-               StrongSubsystem->SendRawMessage(PayloadJson);
+                FString Name;
+                if (Value.IsValid() && Value->TryGetString(Name) && !Name.IsEmpty())
+                {
+                    OutCategories.Add(FName(*Name));
+                }
             }
-        });
+        }
     }
 
-private:
-    UMcpAutomationBridgeSubsystem* Subsystem;
-};
+    /** Removes the capture device from GLog and joins its flusher (which sends any remaining lines). */
+    TSharedPtr<FJsonObject> McpStopLogCapture(TSharedPtr<FOutputDevice>& Device)
+    {
+        if (!Device.IsValid())
+        {
+            return nullptr;
+        }
+        if (GLog)
+        {
+            GLog->RemoveOutputDevice(Device.Get());
+        }
+        TSharedPtr<FMcpLogOutputDevice> Capture = StaticCastSharedPtr<FMcpLogOutputDevice>(Device);
+        Device.Reset();
+        Capture->StopFlusher();
+        return Capture->GetStats();
+    }
+}
 
 bool UMcpAutomationBridgeSubsystem::HandleLogAction(const FString& RequestId, const FString& Action, const TSharedPtr<FJsonObject>& Payload, TSharedPtr<FMcpBridgeWebSocket> RequestingSocket)
 {
@@ -109,34 +282,113 @@ bool UMcpAutomationBridgeSubsystem::HandleLogAction(const FString& RequestId, co
 
     if (SubAction == TEXT("subscribe"))
     {
-        if (!LogCaptureDevice.IsValid())
+        FMcpLogStreamOptions Options;
+        McpReadLogCategories(Payload, TEXT("categories"), Options.IncludeCategories);
+        McpReadLogCategories(Payload, TEXT("excludeCategories"), Options.ExcludeCategories);
+        const FString MinVerbosity = GetJsonStringField(Payload, TEXT("minVerbosity"));
+        if (!MinVerbosity.IsEmpty())
         {
-            LogCaptureDevice = MakeShared<FMcpLogOutputDevice>(this);
-            GLog->AddOutputDevice(LogCaptureDevice.Get());
-            UE_LOG(LogMcpAutomationBridgeSubsystem, Display, TEXT("Log streaming enabled by client request."));
+            Options.MaxVerbosity = ParseLogVerbosityFromString(MinVerbosity);
         }
+        Options.BufferSize = (uint32)FMath::Clamp((int32)GetJsonNumberField(Payload, TEXT("bufferSize"), 8192.0), 256, 65536);
+        Options.FlushIntervalMs = FMath::Clamp((int32)GetJsonNumberField(Payload, TEXT("flushIntervalMs"), 100.0), 10, 5000);
+        Options.MaxBatchLines = FMath::Clamp((int32)GetJsonNumberField(Payload, TEXT("maxBatchLines"), 1000.0), 1, 10000);
 
-        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+        // Resubscribing replaces the previous capture so new filters take effect.
+        const bool bReplaced = LogCaptureDevice.IsValid();
+        McpStopLogCapture(LogCaptureDevice);
+
+        TSharedPtr<FMcpLogOutputDevice> Capture = MakeShared<FMcpLogOutputDevice>(RequestingSocket, MoveTemp(Options));
+        LogCaptureDevice = Capture;
+        GLog->AddOutputDevice(LogCaptureDevice.Get());
+        UE_LOG(LogMcpAutomationBridgeSubsystem, Display, TEXT("Log streaming enabled by client request."));
+
+        TSharedPtr<FJsonObject> Result = Capture->GetStats();
         Result->SetStringField(TEXT("action"), TEXT("subscribe"));
         Result->SetBoolField(TEXT("subscribed"), true);
+        Result->SetBoolField(TEXT("replaced"), bReplaced);
         SendAutomationResponse(RequestingSocket, RequestId, true, TEXT("Subscribed to editor logs."), Result);
         return true;
     }
     else if (SubAction == TEXT("unsubscribe"))
     {
-        if (LogCaptureDevice.IsValid())
+        TSharedPtr<FJsonObject> Result = McpStopLogCapture(LogCaptureDevice);
+        if (Result.IsValid())
         {
-            GLog->RemoveOutputDevice(LogCaptureDevice.Get());
-            LogCaptureDevice.Reset();
             UE_LOG(LogMcpAutomationBridgeSubsystem, Display, TEXT("Log streaming disabled by client request."));
         }
+        else
+        {
+            Result = MakeShared<FJsonObject>();
+        }
 
-        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
         Result->SetStringField(TEXT("action"), TEXT("unsubscribe"));
         Result->SetBoolField(TEXT("subscribed"), false);
         SendAutomationResponse(RequestingSocket, RequestId, true, TEXT("Unsubscribed from editor logs."), Result);
         return true;
     }
+    else if (SubAction == TEXT("status"))
+    {
+        TSharedPtr<FJsonObject> Result = LogCaptureDevice.IsValid()
+            ? StaticCastSharedPtr<FMcpLogOutputDevice>(LogCaptureDevice)->GetStats()
+            : MakeShared<FJsonObject>();
+        Result->SetStringField(TEXT("action"), TEXT("status"));
+        Result->SetBoolField(TEXT("subscribed"), LogCaptureDevice.IsValid());
+        SendAutomationResponse(RequestingSocket, RequestId, true, TEXT("Log streaming status."), Result);
+        return true;
+    }
+
+    else if (SubAction == TEXT("tail"))
+    {
+        // Read-only and registered as worker-safe: only touches the log file,
+        // which the engine keeps open with shared read access.
+        const int32 MaxLines = FMath::Clamp((int32)GetJsonNumberField(Payload, TEXT("lines"), 200.0), 1, 10000);
+        const int64 MaxBytes = FMath::Clamp((int64)GetJsonNumberField(Payload, TEXT("maxBytes"), 1024.0 * 1024.0), (int64)1024, (int64)16 * 1024 * 1024);
+        const FString Filter = GetJsonStringField(Payload, TEXT("filter"));
+        const FString LogPath = FPlatformOutputDevices::GetAbsoluteLogFilename();
+
+        TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*LogPath, FILEREAD_AllowWrite));
+        if (!Reader)
+        {
+            SendAutomationError(RequestingSocket, RequestId, FString::Printf(TEXT("Could not open log file: %s"), *LogPath), TEXT("FILE_NOT_FOUND"));
+            return true;
+        }
+
+        // Only the tail of the file is read; the first (possibly partial) line is dropped.
+        const int64 FileSize = Reader->TotalSize();
+        const int64 ReadOffset = FMath::Max<int64>(0, FileSize - MaxBytes);
+        TArray<uint8> Bytes;
+        Bytes.SetNumUninitialized(FileSize - ReadOffset);
+        Reader->Seek(ReadOffset);
+        Reader->Serialize(Bytes.GetData(), Bytes.Num());
+        Reader.Reset();
+
+        const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+        const FString Text(Converted.Length(), Converted.Get());
+        TArray<FString> AllLines;
+        Text.ParseIntoArrayLines(AllLines, false);
+        const int32 FirstLine = ReadOffset > 0 ? 1 : 0;
+
+        TArray<TSharedPtr<FJsonValue>> LineArray;
+        for (int32 Index = AllLines.Num() - 1; Index >= FirstLine && LineArray.Num() < MaxLines; --Index)
+        {
+            if (Filter.IsEmpty() || AllLines[Index].Contains(Filter))
+            {
+                LineArray.Add(MakeShared<FJsonValueString>(AllLines[Index]));
+            }
+        }
+        Algo::Reverse(LineArray);
+
+        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+        Result->SetStringField(TEXT("action"), TEXT("tail"));
+        Result->SetStringField(TEXT("logFile"), LogPath);
+        Result->SetNumberField(TEXT("fileSize"), (double)FileSize);
+        Result->SetBoolField(TEXT("truncated"), ReadOffset > 0);
+        Result->SetArrayField(TEXT("lines"), LineArray);
+        Result->SetNumberField(TEXT("count"), LineArray.Num());
+        SendAutomationResponse(RequestingSocket, RequestId, true, FString::Printf(TEXT("Read %d log line(s)."), LineArray.Num()), Result);
+        return true;
+    }
 
     SendAutomationError(RequestingSocket, RequestId, TEXT("Unknown subAction."), TEXT("INVALID_SUBACTION"));
     return true;
@@ -3,14 +3,21 @@
  *
  * Advanced material creation and shader authoring capabilities.
  * Implements: create_material, add expressions, connect nodes, material instances,
- * material functions, specialized materials (landscape, decal, post-process).
+ * material functions, specialized materials (landscape, decal, post-process),
+ * and edit sessions that defer recompilation to a single commit.
  */
 
 #include "McpAutomationBridgeGlobals.h"
 #include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
 #include "McpAutomationBridgeHelpers.h"
 #include "McpAutomationBridgeSubsystem.h"
+#include "McpAutomationJob.h"
+#include "McpBridgeWebSocket.h"
+#include "McpMaterialEditSession.h"
 #include "Misc/EngineVersionComparison.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
 
 #if WITH_EDITOR
 #include "AssetRegistry/AssetRegistryModule.h"
@@ -319,7 +326,7 @@ bool UMcpAutomationBridgeSubsystem::HandleManageMaterialAuthoringAction(
     else if (BlendMode == TEXT("AlphaHoldout"))
       Material->BlendMode = EBlendMode::BLEND_AlphaHoldout;
 
-    Material->PostEditChange();
+    McpMaterialPostEditChange(Material);
     Material->MarkPackageDirty();
 
     bool bSave = true;
@@ -381,7 +388,7 @@ bool UMcpAutomationBridgeSubsystem::HandleManageMaterialAuthoringAction(
     else if (ShadingModel == TEXT("ThinTranslucent"))
       Material->SetShadingModel(EMaterialShadingModel::MSM_ThinTranslucent);
 
-    Material->PostEditChange();
+    McpMaterialPostEditChange(Material);
     Material->MarkPackageDirty();
 
     bool bSave = true;
@@ -433,7 +440,7 @@ bool UMcpAutomationBridgeSubsystem::HandleManageMaterialAuthoringAction(
     else if (Domain == TEXT("UI"))
       Material->MaterialDomain = EMaterialDomain::MD_UI;
 
-    Material->PostEditChange();
+    McpMaterialPostEditChange(Material);
     Material->MarkPackageDirty();
 
     bool bSave = true;
@@ -525,7 +532,7 @@ bool UMcpAutomationBridgeSubsystem::HandleManageMaterialAuthoringAction(
       MCP_GET_MATERIAL_EXPRESSIONS(Material).Add(PlainSample);
 #endif
       
-      Material->PostEditChange();
+      McpMaterialPostEditChange(Material);
       Material->MarkPackageDirty();
       
       TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -565,7 +572,7 @@ bool UMcpAutomationBridgeSubsystem::HandleManageMaterialAuthoringAction(
     MCP_GET_MATERIAL_EXPRESSIONS(Material).Add(TexSample);
 #endif
 
-    Material->PostEditChange();
+    McpMaterialPostEditChange(Material);
     Material->MarkPackageDirty();
 
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -602,7 +609,7 @@ bool UMcpAutomationBridgeSubsystem::HandleManageMaterialAuthoringAction(
     MCP_GET_MATERIAL_EXPRESSIONS(Material).Add(TexCoord);
 #endif
 
-    Material->PostEditChange();
+    McpMaterialPostEditChange(Material);
     Material->MarkPackageDirty();
 
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -646,7 +653,7 @@ bool UMcpAutomationBridgeSubsystem::HandleManageMaterialAuthoringAction(
     MCP_GET_MATERIAL_EXPRESSIONS(Material).Add(ScalarParam);
 #endif
 
-    Material->PostEditChange();
+    McpMaterialPostEditChange(Material);
     Material->MarkPackageDirty();
 
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -701,7 +708,7 @@ bool UMcpAutomationBridgeSubsystem::HandleManageMaterialAuthoringAction(
     MCP_GET_MATERIAL_EXPRESSIONS(Material).Add(VecParam);
 #endif
 
-    Material->PostEditChange();
+    McpMaterialPostEditChange(Material);
     Material->MarkPackageDirty();
 
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -747,7 +754,7 @@ bool UMcpAutomationBridgeSubsystem::HandleManageMaterialAuthoringAction(
     MCP_GET_MATERIAL_EXPRESSIONS(Material).Add(SwitchParam);
 #endif
 
-    Material->PostEditChange();
+    McpMaterialPostEditChange(Material);
     Material->MarkPackageDirty();
 
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -828,7 +835,7 @@ bool UMcpAutomationBridgeSubsystem::HandleManageMaterialAuthoringAction(
     MCP_GET_MATERIAL_EXPRESSIONS(Material).Add(MathNode);
 #endif
 
-    Material->PostEditChange();
+    McpMaterialPostEditChange(Material);
     Material->MarkPackageDirty();
 
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -921,7 +928,7 @@ bool UMcpAutomationBridgeSubsystem::HandleManageMaterialAuthoringAction(
       MCP_GET_MATERIAL_EXPRESSIONS(Material).Add(NewExpr);
 #endif
 
-      Material->PostEditChange();
+      McpMaterialPostEditChange(Material);
       Material->MarkPackageDirty();
 
       TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -963,7 +970,7 @@ bool UMcpAutomationBridgeSubsystem::HandleManageMaterialAuthoringAction(
     MCP_GET_MATERIAL_EXPRESSIONS(Material).Add(NewExpr);
 #endif
 
-    Material->PostEditChange();
+    McpMaterialPostEditChange(Material);
     Material->MarkPackageDirty();
 
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -1002,7 +1009,7 @@ bool UMcpAutomationBridgeSubsystem::HandleManageMaterialAuthoringAction(
     MCP_GET_MATERIAL_EXPRESSIONS(Material).Add(MaskExpr);
 #endif
 
-    Material->PostEditChange();
+    McpMaterialPostEditChange(Material);
     Material->MarkPackageDirty();
 
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -1030,7 +1037,7 @@ bool UMcpAutomationBridgeSubsystem::HandleManageMaterialAuthoringAction(
     MCP_GET_MATERIAL_EXPRESSIONS(Material).Add(DotExpr);
 #endif
 
-    Material->PostEditChange();
+    McpMaterialPostEditChange(Material);
     Material->MarkPackageDirty();
 
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -1058,7 +1065,7 @@ bool UMcpAutomationBridgeSubsystem::HandleManageMaterialAuthoringAction(
     MCP_GET_MATERIAL_EXPRESSIONS(Material).Add(CrossExpr);
 #endif
 
-    Material->PostEditChange();
+    McpMaterialPostEditChange(Material);
     Material->MarkPackageDirty();
 
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -1097,7 +1104,7 @@ bool UMcpAutomationBridgeSubsystem::HandleManageMaterialAuthoringAction(
     MCP_GET_MATERIAL_EXPRESSIONS(Material).Add(DesatExpr);
 #endif
 
-    Material->PostEditChange();
+    McpMaterialPostEditChange(Material);
     Material->MarkPackageDirty();
 
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -1125,7 +1132,7 @@ bool UMcpAutomationBridgeSubsystem::HandleManageMaterialAuthoringAction(
     MCP_GET_MATERIAL_EXPRESSIONS(Material).Add(AppendExpr);
 #endif
 
-    Material->PostEditChange();
+    McpMaterialPostEditChange(Material);
     Material->MarkPackageDirty();
 
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -1182,7 +1189,7 @@ bool UMcpAutomationBridgeSubsystem::HandleManageMaterialAuthoringAction(
     MCP_GET_MATERIAL_EXPRESSIONS(Material).Add(CustomExpr);
 #endif
 
-    Material->PostEditChange();
+    McpMaterialPostEditChange(Material);
     Material->MarkPackageDirty();
 
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -1259,7 +1266,7 @@ MCP_GET_MATERIAL_INPUT(Material, WorldPositionOffset).Expression =
 #endif
 
       if (bFound) {
-        Material->PostEditChange();
+        McpMaterialPostEditChange(Material);
         Material->MarkPackageDirty();
         SendAutomationResponse(Socket, RequestId, true,
                                TEXT("Connected to main material node."));
@@ -1290,7 +1297,7 @@ MCP_GET_MATERIAL_INPUT(Material, WorldPositionOffset).Expression =
             StructProp->ContainerPtrToValuePtr<FExpressionInput>(TargetExpr);
         if (InputPtr) {
           InputPtr->Expression = SourceExpr;
-          Material->PostEditChange();
+          McpMaterialPostEditChange(Material);
           Material->MarkPackageDirty();
           SendAutomationResponse(Socket, RequestId, true,
                                  TEXT("Nodes connected."));
@@ -1355,7 +1362,7 @@ MCP_GET_MATERIAL_INPUT(Material, WorldPositionOffset).Expression =
 #endif
 
         if (bFound) {
-          Material->PostEditChange();
+          McpMaterialPostEditChange(Material);
           Material->MarkPackageDirty();
           SendAutomationResponse(Socket, RequestId, true,
                                  TEXT("Disconnected from main material pin."));
@@ -1569,7 +1576,7 @@ MCP_GET_MATERIAL_INPUT(Material, WorldPositionOffset).Expression =
     MCP_GET_MATERIAL_EXPRESSIONS(Material).Add(FuncCall);
 #endif
 
-    Material->PostEditChange();
+    McpMaterialPostEditChange(Material);
     Material->MarkPackageDirty();
 
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -2046,7 +2053,7 @@ PRAGMA_ENABLE_DEPRECATION_WARNINGS
       CreatedNodeIds.Add(WeightParam->MaterialExpressionGuid.ToString());
     }
     
-    Material->PostEditChange();
+    McpMaterialPostEditChange(Material);
     Material->MarkPackageDirty();
     
     // Save if requested
@@ -2077,6 +2084,107 @@ PRAGMA_ENABLE_DEPRECATION_WARNINGS
   // 8.6 Utilities
   // ==========================================================================
 
+  // Replies with the material's shader compile state. Shaders that are still
+  // compiling are tracked by a material_compile job unless waitForShaders is
+  // false; the reply then carries its jobId and job_completed carries the
+  // compile errors, instruction counts and sampler usage.
+  auto ReplyWithCompileState = [&](UMaterial *Material,
+                                   const TSharedPtr<FJsonObject> &Result,
+                                   const FString &Message) {
+    const bool bFinished = McpGetMaterialCompileStats(Material, Result);
+    if (!bFinished && GetJsonBoolField(Payload, TEXT("waitForShaders"), true)) {
+      TSharedPtr<FMcpAutomationJob> Job =
+          BeginMaterialCompileJob(Material, RequestId, Socket);
+      Result->SetStringField(TEXT("jobId"), Job->JobId);
+    }
+    SendAutomationResponse(Socket, RequestId, true, Message, Result);
+  };
+
+  // --------------------------------------------------------------------------
+  // begin_edit_session / commit_edit_session / list_edit_sessions
+  // --------------------------------------------------------------------------
+  // Between begin and commit, node, connection and property edits to the
+  // material (here and in manage_material_graph) skip PostEditChange; commit
+  // recompiles once. A session the client abandons is committed when its
+  // socket disconnects or after idleTimeoutSeconds (default 300, 0 = never)
+  // without an edit.
+  if (SubAction == TEXT("list_edit_sessions")) {
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetArrayField(TEXT("sessions"),
+                          FMcpMaterialEditSessions::Get().ListJson());
+    SendAutomationResponse(Socket, RequestId, true,
+                           TEXT("Material edit sessions listed."), Result);
+    return true;
+  }
+
+  if (SubAction == TEXT("begin_edit_session") ||
+      SubAction == TEXT("commit_edit_session")) {
+    FString AssetPath;
+    if (!Payload->TryGetStringField(TEXT("assetPath"), AssetPath) ||
+        AssetPath.IsEmpty()) {
+      SendAutomationError(Socket, RequestId, TEXT("Missing 'assetPath'."),
+                          TEXT("INVALID_ARGUMENT"));
+      return true;
+    }
+
+    UMaterial *Material = LoadObject<UMaterial>(nullptr, *AssetPath);
+    if (!Material) {
+      SendAutomationError(Socket, RequestId, TEXT("Could not load Material."),
+                          TEXT("ASSET_NOT_FOUND"));
+      return true;
+    }
+
+    if (SubAction == TEXT("begin_edit_session")) {
+      const double IdleTimeoutSeconds = GetJsonNumberField(
+          Payload, TEXT("idleTimeoutSeconds"),
+          FMcpMaterialEditSessions::DefaultIdleTimeoutSeconds);
+      if (!FMcpMaterialEditSessions::Get().Begin(Material, Socket.Get(),
+                                                 IdleTimeoutSeconds)) {
+        SendAutomationError(
+            Socket, RequestId,
+            TEXT("An edit session is already open for this material."),
+            TEXT("SESSION_ALREADY_OPEN"));
+        return true;
+      }
+      TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+      Result->SetStringField(TEXT("assetPath"), AssetPath);
+      Result->SetBoolField(TEXT("sessionOpen"), true);
+      Result->SetNumberField(TEXT("idleTimeoutSeconds"), IdleTimeoutSeconds);
+      SendAutomationResponse(Socket, RequestId, true,
+                             TEXT("Material edit session opened."), Result);
+      return true;
+    }
+
+    int32 DeferredEdits = 0;
+    if (!FMcpMaterialEditSessions::Get().End(Material, DeferredEdits)) {
+      SendAutomationError(Socket, RequestId,
+                          TEXT("No edit session is open for this material."),
+                          TEXT("SESSION_NOT_FOUND"));
+      return true;
+    }
+    if (DeferredEdits > 0) {
+      Material->PreEditChange(nullptr);
+      Material->PostEditChange();
+      Material->MarkPackageDirty();
+    }
+
+    bool bSave = false;
+    Payload->TryGetBoolField(TEXT("save"), bSave);
+    if (bSave) {
+      SaveMaterialAsset(Material);
+    }
+
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetStringField(TEXT("assetPath"), AssetPath);
+    Result->SetNumberField(TEXT("deferredEdits"), DeferredEdits);
+    Result->SetBoolField(TEXT("saved"), bSave);
+    ReplyWithCompileState(
+        Material, Result,
+        FString::Printf(TEXT("Material edit session committed (%d edits)."),
+                        DeferredEdits));
+    return true;
+  }
+
   // --------------------------------------------------------------------------
   // compile_material
   // --------------------------------------------------------------------------
@@ -2096,6 +2204,11 @@ PRAGMA_ENABLE_DEPRECATION_WARNINGS
       return true;
     }
 
+    // An explicit compile also closes any open edit session.
+    int32 DeferredEdits = 0;
+    const bool bHadSession =
+        FMcpMaterialEditSessions::Get().End(Material, DeferredEdits);
+
     // Force recompile
     Material->PreEditChange(nullptr);
     Material->PostEditChange();
@@ -2109,9 +2222,11 @@ PRAGMA_ENABLE_DEPRECATION_WARNINGS
 
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
     Result->SetStringField(TEXT("assetPath"), AssetPath);
-    Result->SetBoolField(TEXT("compiled"), true);
     Result->SetBoolField(TEXT("saved"), bSave);
-    SendAutomationResponse(Socket, RequestId, true, TEXT("Material compiled."), Result);
+    if (bHadSession) {
+      Result->SetNumberField(TEXT("deferredEdits"), DeferredEdits);
+    }
+    ReplyWithCompileState(Material, Result, TEXT("Material compiled."));
     return true;
   }
 
@@ -2368,7 +2483,7 @@ PRAGMA_ENABLE_DEPRECATION_WARNINGS
       }
     }
 
-    Material->PostEditChange();
+    McpMaterialPostEditChange(Material);
     Material->MarkPackageDirty();
 
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -2588,6 +2703,70 @@ static bool SaveMaterialInstanceAsset(UMaterialInstanceConstant *Instance) {
   return true;
 }
 
+TSharedPtr<FMcpAutomationJob>
+UMcpAutomationBridgeSubsystem::BeginMaterialCompileJob(
+    UMaterial *Material, const FString &RequestId,
+    TSharedPtr<FMcpBridgeWebSocket> Socket) {
+  TSharedPtr<FMcpAutomationJob> Job =
+      BeginAutomationJob(TEXT("material_compile"), RequestId, Socket, 1800.0);
+  TWeakObjectPtr<UMaterial> WeakMaterial(Material);
+  const FString AssetPath = Material->GetPathName();
+  TSharedRef<double> LastProgressSeconds = MakeShared<double>(0.0);
+  Job->Poll = [this, WeakMaterial, AssetPath,
+               LastProgressSeconds](FMcpAutomationJob &RunningJob) {
+    UMaterial *Material = WeakMaterial.Get();
+    if (!Material) {
+      RunningJob.bSuccess = false;
+      RunningJob.ErrorCode = TEXT("ASSET_NOT_FOUND");
+      RunningJob.Message = TEXT("Material was unloaded while compiling");
+      return true;
+    }
+
+    TSharedPtr<FJsonObject> Stats = MakeShared<FJsonObject>();
+    if (!McpGetMaterialCompileStats(Material, Stats)) {
+      // Progress at most twice a second; the request was already answered,
+      // so this goes out as an automation_event rather than progress_update.
+      const double Now = FPlatformTime::Seconds();
+      if (Now - *LastProgressSeconds >= 0.5) {
+        *LastProgressSeconds = Now;
+        TSharedPtr<FJsonObject> Event = MakeShared<FJsonObject>();
+        Event->SetStringField(TEXT("type"), TEXT("automation_event"));
+        Event->SetStringField(TEXT("event"), TEXT("material_compile_progress"));
+        Event->SetStringField(TEXT("jobId"), RunningJob.JobId);
+        Event->SetStringField(TEXT("requestId"), RunningJob.RequestId);
+        Event->SetStringField(TEXT("assetPath"), AssetPath);
+        Event->SetNumberField(TEXT("elapsedSeconds"),
+                              RunningJob.GetElapsedSeconds());
+        double Remaining = 0.0;
+        if (Stats->TryGetNumberField(TEXT("remainingShaderJobs"), Remaining)) {
+          Event->SetNumberField(TEXT("remainingShaderJobs"), Remaining);
+        }
+        SendAutomationJobEvent(RunningJob, Event);
+      }
+      return false;
+    }
+
+    const TArray<TSharedPtr<FJsonValue>> *Errors = nullptr;
+    const bool bHasErrors =
+        Stats->TryGetArrayField(TEXT("compileErrors"), Errors) &&
+        Errors->Num() > 0;
+    Stats->SetStringField(TEXT("assetPath"), AssetPath);
+    Stats->SetNumberField(TEXT("compileSeconds"),
+                          RunningJob.GetElapsedSeconds());
+    RunningJob.Result = Stats;
+    RunningJob.bSuccess = !bHasErrors;
+    if (bHasErrors) {
+      RunningJob.ErrorCode = TEXT("SHADER_COMPILE_FAILED");
+      RunningJob.Message = FString::Printf(
+          TEXT("Material compiled with %d error(s)"), Errors->Num());
+    } else {
+      RunningJob.Message = TEXT("Material shaders compiled");
+    }
+    return true;
+  };
+  return Job;
+}
+
 static UMaterialExpression *FindExpressionByIdOrName(UMaterial *Material,
                                                       const FString &IdOrName) {
   if (IdOrName.IsEmpty() || !Material) {
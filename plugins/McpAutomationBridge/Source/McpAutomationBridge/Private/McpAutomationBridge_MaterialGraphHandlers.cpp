@@ -2,6 +2,7 @@
 #include "Dom/JsonObject.h"
 #include "McpAutomationBridgeHelpers.h"
 #include "McpAutomationBridgeSubsystem.h"
+#include "McpMaterialEditSession.h"
 
 #if WITH_EDITOR
 #include "EdGraph/EdGraph.h"
@@ -27,6 +28,22 @@
 #define MCP_GET_MATERIAL_EXPRESSIONS(Material) (Material)->Expressions
 #define MCP_GET_MATERIAL_INPUT(Material, InputName) (Material)->InputName
 #endif
+
+/**
+ * Recompiles and saves Material after a graph edit. Inside an open edit
+ * session the edit is only counted and the package dirtied; committing the
+ * session recompiles, and saves when asked to.
+ */
+static void McpFinishMaterialGraphEdit(UMaterial *Material) {
+  if (FMcpMaterialEditSessions::Get().IsOpen(Material)) {
+    McpMaterialPostEditChange(Material);
+    Material->MarkPackageDirty();
+    return;
+  }
+  Material->PreEditChange(nullptr);
+  McpMaterialPostEditChange(Material);
+  McpSafeAssetSave(Material);
+}
 #endif
 
 bool UMcpAutomationBridgeSubsystem::HandleMaterialGraphAction(
@@ -181,7 +198,7 @@ bool UMcpAutomationBridgeSubsystem::HandleMaterialGraphAction(
         }
       }
 
-      Material->PostEditChange();
+      McpMaterialPostEditChange(Material);
       Material->MarkPackageDirty();
 
       TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -219,7 +236,7 @@ bool UMcpAutomationBridgeSubsystem::HandleMaterialGraphAction(
       Material->Expressions.Remove(TargetExpr);
 #endif
 #endif
-      Material->PostEditChange();
+      McpMaterialPostEditChange(Material);
       Material->MarkPackageDirty();
       TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
       Result->SetStringField(TEXT("nodeId"), RemovedNodeId);
@@ -287,7 +304,7 @@ bool UMcpAutomationBridgeSubsystem::HandleMaterialGraphAction(
 #endif
 
       if (bFound) {
-        Material->PostEditChange();
+        McpMaterialPostEditChange(Material);
         Material->MarkPackageDirty();
         SendAutomationResponse(Socket, RequestId, true,
                                TEXT("Connected to main material node."));
@@ -316,7 +333,7 @@ bool UMcpAutomationBridgeSubsystem::HandleMaterialGraphAction(
                       TargetExpr);
               if (InputPtr) {
                 InputPtr->Expression = SourceExpr;
-                Material->PostEditChange();
+                McpMaterialPostEditChange(Material);
                 Material->MarkPackageDirty();
                 SendAutomationResponse(Socket, RequestId, true,
                                        TEXT("Nodes connected."));
@@ -392,7 +409,7 @@ bool UMcpAutomationBridgeSubsystem::HandleMaterialGraphAction(
 #endif
 
         if (bFound) {
-          Material->PostEditChange();
+          McpMaterialPostEditChange(Material);
           Material->MarkPackageDirty();
           SendAutomationResponse(Socket, RequestId, true,
                                  TEXT("Disconnected from main material pin."));
@@ -416,7 +433,7 @@ bool UMcpAutomationBridgeSubsystem::HandleMaterialGraphAction(
       // reflection.
 
       // For now, just acknowledge but warn.
-      Material->PostEditChange();
+      McpMaterialPostEditChange(Material);
       Material->MarkPackageDirty();
       SendAutomationResponse(
           Socket, RequestId, true,
@@ -585,9 +602,7 @@ bool UMcpAutomationBridgeSubsystem::HandleAddMaterialTextureSample(
 #endif
 #endif
 
-  Material->PreEditChange(nullptr);
-  Material->PostEditChange();
-  McpSafeAssetSave(Material);
+  McpFinishMaterialGraphEdit(Material);
 
   TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
   Result->SetStringField(TEXT("nodeId"),
@@ -719,9 +734,7 @@ bool UMcpAutomationBridgeSubsystem::HandleAddMaterialExpression(
 #endif
 #endif
 
-  Material->PreEditChange(nullptr);
-  Material->PostEditChange();
-  McpSafeAssetSave(Material);
+  McpFinishMaterialGraphEdit(Material);
 
   TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
   Result->SetStringField(TEXT("nodeId"),
@@ -909,9 +922,7 @@ bool UMcpAutomationBridgeSubsystem::HandleCreateMaterialNodes(
     SuccessCount++;
   }
 
-  Material->PreEditChange(nullptr);
-  Material->PostEditChange();
-  McpSafeAssetSave(Material);
+  McpFinishMaterialGraphEdit(Material);
 
   TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
   Result->SetArrayField(TEXT("createdNodes"), CreatedNodes);
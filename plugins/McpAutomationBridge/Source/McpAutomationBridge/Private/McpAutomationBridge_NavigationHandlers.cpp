@@ -4,6 +4,7 @@
 
 #include "McpAutomationBridgeSubsystem.h"
 #include "McpAutomationBridgeHelpers.h"
+#include "McpAutomationJob.h"
 #include "McpBridgeWebSocket.h"
 #include "Misc/EngineVersionComparison.h"
 
@@ -303,6 +304,43 @@ static bool HandleSetNavAgentProperties(
     return true;
 }
 
+TSharedPtr<FMcpAutomationJob> UMcpAutomationBridgeSubsystem::BeginNavigationBuildJob(
+    UWorld* World, const FString& RequestId, TSharedPtr<FMcpBridgeWebSocket> Socket)
+{
+    TSharedPtr<FMcpAutomationJob> Job = BeginAutomationJob(TEXT("navigation_build"), RequestId, Socket, 600.0);
+    TWeakObjectPtr<UWorld> WeakWorld(World);
+    Job->Poll = [WeakWorld](FMcpAutomationJob& RunningJob)
+    {
+        UNavigationSystemV1* NavSys = WeakWorld.IsValid()
+            ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(WeakWorld.Get()) : nullptr;
+        if (!NavSys)
+        {
+            RunningJob.bSuccess = false;
+            RunningJob.ErrorCode = TEXT("NO_NAV_SYS");
+            RunningJob.Message = TEXT("Navigation system went away during the build");
+            return true;
+        }
+        if (NavSys->IsNavigationBuildInProgress())
+        {
+            return false;
+        }
+
+        TArray<TSharedPtr<FJsonValue>> NavDataArray;
+        for (TActorIterator<ANavigationData> It(WeakWorld.Get()); It; ++It)
+        {
+            NavDataArray.Add(MakeShared<FJsonValueString>(It->GetName()));
+        }
+        RunningJob.bSuccess = true;
+        RunningJob.Message = TEXT("Navigation build finished");
+        RunningJob.Result = MakeShared<FJsonObject>();
+        RunningJob.Result->SetStringField(TEXT("world"), WeakWorld->GetName());
+        RunningJob.Result->SetArrayField(TEXT("navData"), NavDataArray);
+        RunningJob.Result->SetNumberField(TEXT("buildSeconds"), RunningJob.GetElapsedSeconds());
+        return true;
+    };
+    return Job;
+}
+
 static bool HandleRebuildNavigation(
     UMcpAutomationBridgeSubsystem* Self,
     const FString& RequestId,
@@ -327,9 +365,11 @@ static bool HandleRebuildNavigation(
 
     // Trigger full navigation rebuild
     NavSys->Build();
+    TSharedPtr<FMcpAutomationJob> Job = Self->BeginNavigationBuildJob(World, RequestId, Socket);
 
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
     Result->SetBoolField(TEXT("rebuilding"), NavSys->IsNavigationBuildInProgress());
+    Result->SetStringField(TEXT("jobId"), Job->JobId);
 
     Self->SendAutomationResponse(Socket, RequestId, true,
         TEXT("Navigation rebuild initiated"), Result);
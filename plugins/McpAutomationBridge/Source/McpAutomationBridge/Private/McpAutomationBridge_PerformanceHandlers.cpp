@@ -2,6 +2,12 @@
 #include "Dom/JsonObject.h"
 #include "McpAutomationBridgeHelpers.h"
 #include "McpAutomationBridgeSubsystem.h"
+#include "McpAutomationJob.h"
+#include "McpBridgeBenchmark.h"
+#include "McpPerfSampler.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 
 
 #if WITH_EDITOR
@@ -18,6 +24,61 @@
 
 #endif
 
+namespace {
+/**
+ * Waits for the stats capture written by "stat stopfile" to be closed. The
+ * writer flushes on a background thread, so the file counts as closed once
+ * its size has stopped changing for a short settle window.
+ */
+struct FMcpStatFileWatch {
+  FDateTime Since;
+  FString Path;
+  int64 LastSize = -1;
+  double LastChangeSeconds = 0.0;
+
+  static constexpr double SettleSeconds = 0.5;
+
+  /** Returns true once the newest capture since Since has settled. */
+  bool Poll() {
+    TArray<FString> Files;
+    const FString Dir = FPaths::ProfilingDir() / TEXT("UnrealStats");
+    IFileManager::Get().FindFilesRecursive(Files, *Dir, TEXT("*stats"), true,
+                                           false);
+    FString Newest;
+    FDateTime NewestTime = Since;
+    for (const FString &File : Files) {
+      const FDateTime Stamp = IFileManager::Get().GetTimeStamp(*File);
+      if (Stamp >= NewestTime) {
+        NewestTime = Stamp;
+        Newest = File;
+      }
+    }
+    if (Newest.IsEmpty()) {
+      return false;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    const int64 Size = IFileManager::Get().FileSize(*Newest);
+    if (Newest != Path || Size != LastSize) {
+      Path = Newest;
+      LastSize = Size;
+      LastChangeSeconds = Now;
+      return false;
+    }
+    return Size > 0 && Now - LastChangeSeconds >= SettleSeconds;
+  }
+
+  void WriteResult(const TSharedPtr<FJsonObject> &Result) const {
+    Result->SetStringField(TEXT("statsFile"),
+                           FPaths::ConvertRelativePathToFull(Path));
+    Result->SetNumberField(TEXT("statsFileBytes"), (double)LastSize);
+  }
+};
+
+/** Seconds to wait for the stats file after stopfile before giving up on it. */
+constexpr double McpStatFileCloseTimeout = 30.0;
+} // namespace
+
 bool UMcpAutomationBridgeSubsystem::HandlePerformanceAction(
     const FString &RequestId, const FString &Action,
     const TSharedPtr<FJsonObject> &Payload,
@@ -69,14 +130,60 @@ bool UMcpAutomationBridgeSubsystem::HandlePerformanceAction(
         return true;
     }
 
+    const FDateTime StartTime = FDateTime::UtcNow();
     GEngine->Exec(GEditor->GetEditorWorldContext().World(), *Cmd);
 
-    // If output path provided, we might want to move the log file, but
-    // memreport writes to a specific location. For now, just acknowledge
-    // execution.
+    // memreport writes Saved/Profiling/MemReports/<stamp>/<map>.memreport
+    // synchronously; report the file it produced along with current memory.
+    TArray<FString> Reports;
+    IFileManager::Get().FindFilesRecursive(
+        Reports, *(FPaths::ProfilingDir() / TEXT("MemReports")),
+        TEXT("*.memreport"), true, false);
+    FString ReportFile;
+    FDateTime ReportTime = StartTime - FTimespan::FromSeconds(1.0);
+    for (const FString &File : Reports) {
+      const FDateTime Stamp = IFileManager::Get().GetTimeStamp(*File);
+      if (Stamp >= ReportTime) {
+        ReportTime = Stamp;
+        ReportFile = File;
+      }
+    }
+
+    TSharedPtr<FJsonObject> Result = FMcpPerfSampler::Get().GetWindowJson(
+        GetJsonNumberField(Payload, TEXT("windowSeconds"), 10.0),
+        uint8(FMcpPerfSampler::EGroup::Memory));
+    if (!ReportFile.IsEmpty()) {
+      ReportFile = FPaths::ConvertRelativePathToFull(ReportFile);
+      Result->SetStringField(TEXT("reportFile"), ReportFile);
+      Result->SetNumberField(TEXT("reportBytes"),
+                             (double)IFileManager::Get().FileSize(*ReportFile));
+      if (!OutputPath.IsEmpty()) {
+        const FString Target = FPaths::IsRelative(OutputPath)
+                                   ? FPaths::ProjectSavedDir() / OutputPath
+                                   : OutputPath;
+        if (IFileManager::Get().Copy(*Target, *ReportFile) != COPY_OK) {
+          SendAutomationError(
+              RequestingSocket, RequestId,
+              FString::Printf(TEXT("Could not copy memory report to %s"),
+                              *Target),
+              TEXT("WRITE_FAILED"));
+          return true;
+        }
+        Result->SetStringField(TEXT("outputPath"),
+                               FPaths::ConvertRelativePathToFull(Target));
+      }
+    }
+    if (GetJsonBoolField(Payload, TEXT("includeClassCounts"), true)) {
+      Result->SetObjectField(
+          TEXT("classCounts"),
+          FMcpPerfSampler::Get().GetClassCountsJson(
+              FMath::Clamp(GetJsonIntField(Payload, TEXT("topClasses"), 25), 1,
+                           1000),
+              0.0));
+    }
 
     SendAutomationResponse(RequestingSocket, RequestId, true,
-                           TEXT("Memory report generated"), nullptr);
+                           TEXT("Memory report generated"), Result);
     return true;
   } else if (Lower == TEXT("start_profiling")) {
     // "stat startfile"
@@ -99,10 +206,31 @@ bool UMcpAutomationBridgeSubsystem::HandlePerformanceAction(
         return true;
     }
 
+    const FDateTime StopTime = FDateTime::UtcNow();
     GEngine->Exec(GEditor->GetEditorWorldContext().World(),
                   TEXT("stat stopfile"));
+
+    // Report the capture file once the stats writer has closed it.
+    TSharedRef<FMcpStatFileWatch> Watch = MakeShared<FMcpStatFileWatch>();
+    Watch->Since = StopTime - FTimespan::FromMinutes(1.0);
+    TSharedPtr<FMcpAutomationJob> Job =
+        BeginAutomationJob(TEXT("stat_capture"), RequestId, RequestingSocket,
+                           McpStatFileCloseTimeout);
+    Job->Poll = [Watch](FMcpAutomationJob &RunningJob) {
+      if (!Watch->Poll()) {
+        return false;
+      }
+      RunningJob.bSuccess = true;
+      RunningJob.Message = TEXT("Stats file closed");
+      RunningJob.Result = MakeShared<FJsonObject>();
+      Watch->WriteResult(RunningJob.Result);
+      return true;
+    };
+
+    TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
+    Resp->SetStringField(TEXT("jobId"), Job->JobId);
     SendAutomationResponse(RequestingSocket, RequestId, true,
-                           TEXT("Profiling stopped"), nullptr);
+                           TEXT("Profiling stopped"), Resp);
     return true;
   } else if (Lower == TEXT("show_fps")) {
     bool bEnabled = true;
@@ -459,6 +587,64 @@ bool UMcpAutomationBridgeSubsystem::HandlePerformanceAction(
     FString BenchmarkType = TEXT("all");
     Payload->TryGetStringField(TEXT("type"), BenchmarkType);
 
+    // type "bridge" load-tests the bridge itself over loopback connections
+    // instead of sampling editor frame times; see McpBridgeBenchmark.h.
+    if (BenchmarkType.Equals(TEXT("bridge"), ESearchCase::IgnoreCase)) {
+      FString BenchmarkError;
+      TSharedPtr<FMcpBridgeBenchmark> Benchmark =
+          FMcpBridgeBenchmark::Create(Payload, ConnectionManager,
+                                      BenchmarkError);
+      if (!Benchmark.IsValid()) {
+        SendAutomationError(RequestingSocket, RequestId, BenchmarkError,
+                            TEXT("INVALID_ARGUMENT"));
+        return true;
+      }
+      const FString OutputPath =
+          GetJsonStringField(Payload, TEXT("outputPath"));
+      TSharedPtr<FMcpAutomationJob> Job = BeginAutomationJob(
+          TEXT("bridge_benchmark"), RequestId, RequestingSocket,
+          GetJsonNumberField(Payload, TEXT("timeoutSeconds"), 0.0));
+      Job->Poll = [Benchmark, OutputPath](FMcpAutomationJob &RunningJob) {
+        if (!Benchmark->Tick()) {
+          return false;
+        }
+        RunningJob.bSuccess = Benchmark->Succeeded();
+        RunningJob.Result = Benchmark->GetReport();
+        if (RunningJob.bSuccess) {
+          RunningJob.Message = TEXT("Bridge benchmark complete");
+        } else {
+          RunningJob.Message = Benchmark->GetError();
+          RunningJob.ErrorCode = TEXT("BENCHMARK_FAILED");
+        }
+        if (!OutputPath.IsEmpty()) {
+          FString ReportText;
+          const TSharedRef<TJsonWriter<>> Writer =
+              TJsonWriterFactory<>::Create(&ReportText);
+          FJsonSerializer::Serialize(RunningJob.Result.ToSharedRef(), Writer);
+          const FString FullPath = FPaths::ConvertRelativePathToFull(
+              FPaths::IsRelative(OutputPath)
+                  ? FPaths::Combine(FPaths::ProjectSavedDir(), OutputPath)
+                  : OutputPath);
+          if (FFileHelper::SaveStringToFile(ReportText, *FullPath)) {
+            RunningJob.Result->SetStringField(TEXT("reportPath"), FullPath);
+          }
+        }
+        return true;
+      };
+      Job->OnFinished = [Benchmark]() {
+        Benchmark->Cancel(TEXT("Benchmark job ended before the run finished"));
+      };
+      Benchmark->Start();
+
+      TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
+      Resp->SetStringField(TEXT("type"), TEXT("bridge"));
+      Resp->SetStringField(TEXT("status"), TEXT("started"));
+      Resp->SetStringField(TEXT("jobId"), Job->JobId);
+      SendAutomationResponse(RequestingSocket, RequestId, true,
+                             TEXT("Bridge benchmark started"), Resp);
+      return true;
+    }
+
     // Start profiling for benchmark
     if (!GEditor)
     {
@@ -469,10 +655,86 @@ bool UMcpAutomationBridgeSubsystem::HandlePerformanceAction(
     GEngine->Exec(GEditor->GetEditorWorldContext().World(),
                   TEXT("stat startfile"));
 
+    // Sample frame times every frame for the requested duration, then stop the
+    // capture and complete once the stats file is closed.
+    struct FBenchmarkState {
+      TArray<float> FrameMs;
+      bool bStopped = false;
+      double StopSeconds = 0.0;
+      FMcpStatFileWatch Watch;
+    };
+    TSharedRef<FBenchmarkState> State = MakeShared<FBenchmarkState>();
+    State->Watch.Since = FDateTime::UtcNow();
+    State->FrameMs.Reserve(FMath::CeilToInt(Duration * 120.0));
+
+    TSharedPtr<FMcpAutomationJob> Job = BeginAutomationJob(
+        TEXT("benchmark"), RequestId, RequestingSocket,
+        Duration + McpStatFileCloseTimeout);
+    Job->Poll = [State, Duration, BenchmarkType](FMcpAutomationJob &RunningJob) {
+      if (!State->bStopped) {
+        State->FrameMs.Add((float)(FApp::GetDeltaTime() * 1000.0));
+        if (RunningJob.GetElapsedSeconds() < Duration) {
+          return false;
+        }
+        if (GEngine && GEditor) {
+          GEngine->Exec(GEditor->GetEditorWorldContext().World(),
+                        TEXT("stat stopfile"));
+        }
+        State->bStopped = true;
+        State->StopSeconds = FPlatformTime::Seconds();
+      }
+
+      const bool bFileClosed = State->Watch.Poll();
+      if (!bFileClosed && FPlatformTime::Seconds() - State->StopSeconds <
+                              McpStatFileCloseTimeout - 1.0) {
+        return false;
+      }
+
+      TArray<float> &Frames = State->FrameMs;
+      Frames.Sort();
+      double TotalMs = 0.0;
+      for (const float Ms : Frames) {
+        TotalMs += Ms;
+      }
+      const int32 Count = Frames.Num();
+      const double AvgMs = Count > 0 ? TotalMs / Count : 0.0;
+
+      RunningJob.bSuccess = true;
+      RunningJob.Message = bFileClosed
+                               ? TEXT("Benchmark complete")
+                               : TEXT("Benchmark complete; stats file not found");
+      RunningJob.Result = MakeShared<FJsonObject>();
+      RunningJob.Result->SetStringField(TEXT("type"), BenchmarkType);
+      RunningJob.Result->SetNumberField(TEXT("duration"), Duration);
+      RunningJob.Result->SetNumberField(TEXT("frames"), Count);
+      RunningJob.Result->SetNumberField(TEXT("avgFrameMs"), AvgMs);
+      RunningJob.Result->SetNumberField(TEXT("avgFps"),
+                                        AvgMs > 0.0 ? 1000.0 / AvgMs : 0.0);
+      if (Count > 0) {
+        RunningJob.Result->SetNumberField(TEXT("minFrameMs"), Frames[0]);
+        RunningJob.Result->SetNumberField(TEXT("maxFrameMs"), Frames.Last());
+        RunningJob.Result->SetNumberField(
+            TEXT("p95FrameMs"),
+            Frames[FMath::Min(Count - 1, (int32)(Count * 0.95))]);
+      }
+      if (bFileClosed) {
+        State->Watch.WriteResult(RunningJob.Result);
+      }
+      return true;
+    };
+    Job->OnFinished = [State]() {
+      // Do not leave the capture running if the job is dropped mid-sample.
+      if (!State->bStopped && GEngine && GEditor) {
+        GEngine->Exec(GEditor->GetEditorWorldContext().World(),
+                      TEXT("stat stopfile"));
+      }
+    };
+
     TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
     Resp->SetNumberField(TEXT("duration"), Duration);
     Resp->SetStringField(TEXT("type"), BenchmarkType);
     Resp->SetStringField(TEXT("status"), TEXT("started"));
+    Resp->SetStringField(TEXT("jobId"), Job->JobId);
 
     SendAutomationResponse(
         RequestingSocket, RequestId, true,
@@ -14,6 +14,199 @@
 #include "Misc/App.h"
 #include "Kismet/GameplayStatics.h"
 #include "Editor.h"
+#include "McpAutomationBridgeSettings.h"
+#include "McpAutomationJob.h"
+#include "McpBridgeWebSocket.h"
+#include "McpProcessRunner.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+    /** Output lines are batched into one process_output event at most this often. */
+    constexpr double McpProcessOutputIntervalSeconds = 0.1;
+    /** ...unless this many lines are waiting. */
+    constexpr int32 McpProcessOutputBatchLines = 500;
+
+    int32 McpMaxConcurrentProcesses()
+    {
+        return FMath::Max(1, GetDefault<UMcpAutomationBridgeSettings>()->MaxConcurrentProcesses);
+    }
+
+    /** UBT platform name of the machine the editor runs on. */
+    const TCHAR* McpHostUbtPlatform()
+    {
+#if PLATFORM_WINDOWS
+        return TEXT("Win64");
+#elif PLATFORM_MAC
+        return TEXT("Mac");
+#else
+        return TEXT("Linux");
+#endif
+    }
+
+    /**
+     * Windows ships a UnrealBuildTool.exe apphost; elsewhere RunUBT.sh sets up the
+     * bundled dotnet runtime and runs UnrealBuildTool.dll.
+     */
+    FString McpUbtExecutable()
+    {
+#if PLATFORM_WINDOWS
+        return FPaths::ConvertRelativePathToFull(FPaths::EngineDir() / TEXT("Binaries/DotNET/UnrealBuildTool/UnrealBuildTool.exe"));
+#else
+        return FPaths::ConvertRelativePathToFull(FPaths::EngineDir() / TEXT("Build/BatchFiles/RunUBT.sh"));
+#endif
+    }
+
+    /** An automation_event carrying a batch of output lines for the job's requester. */
+    TSharedPtr<FJsonObject> McpMakeProcessOutputEvent(const FMcpAutomationJob& Job, const TArray<FMcpProcessLine>& Lines,
+                                                      uint64 Dropped)
+    {
+
+        TArray<TSharedPtr<FJsonValue>> LineArray;
+        LineArray.Reserve(Lines.Num());
+        for (const FMcpProcessLine& Line : Lines)
+        {
+            TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+            Entry->SetNumberField(TEXT("seq"), (double)Line.Seq);
+            Entry->SetStringField(TEXT("stream"), Line.Stream == EMcpProcessStream::Stderr ? TEXT("stderr") : TEXT("stdout"));
+            Entry->SetStringField(TEXT("text"), Line.Text);
+            LineArray.Add(MakeShared<FJsonValueObject>(Entry));
+        }
+
+        TSharedPtr<FJsonObject> Event = MakeShared<FJsonObject>();
+        Event->SetStringField(TEXT("type"), TEXT("automation_event"));
+        Event->SetStringField(TEXT("event"), TEXT("process_output"));
+        Event->SetStringField(TEXT("jobId"), Job.JobId);
+        Event->SetStringField(TEXT("requestId"), Job.RequestId);
+        Event->SetArrayField(TEXT("lines"), LineArray);
+        Event->SetNumberField(TEXT("dropped"), (double)Dropped);
+        return Event;
+    }
+}
+
+bool UMcpAutomationBridgeSubsystem::StartManagedProcess(
+    const FString& RequestId, TSharedPtr<FMcpBridgeWebSocket> RequestingSocket, const FString& Kind,
+    const FString& Executable, const FString& Arguments, const FString& WorkingDirectory,
+    const TSharedPtr<FJsonObject>& Payload, const TSharedPtr<FJsonObject>& ResponseFields)
+{
+    const int32 MaxConcurrent = McpMaxConcurrentProcesses();
+    if (ManagedProcesses.Num() >= MaxConcurrent)
+    {
+        SendAutomationError(RequestingSocket, RequestId,
+            FString::Printf(TEXT("%d managed process(es) already running (limit %d). Cancel one or wait for its job to complete."), ManagedProcesses.Num(), MaxConcurrent),
+            TEXT("BUSY"));
+        return false;
+    }
+
+    const double TimeoutSeconds = GetNumberFieldPipe(Payload, TEXT("timeoutSeconds"), Kind == TEXT("ubt") ? 3600.0 : 600.0);
+    const bool bStreamOutput = GetBoolFieldPipe(Payload, TEXT("streamOutput"), true);
+    const int32 MaxDiagnostics = FMath::Max(0, GetJsonIntField(Payload, TEXT("maxDiagnostics"), 200));
+    const int32 TailLines = FMath::Clamp(GetJsonIntField(Payload, TEXT("tailLines"), 50), 0, 200);
+
+    TSharedPtr<FMcpProcessRunner> Runner = MakeShared<FMcpProcessRunner>(
+        (uint32)FMath::Clamp(GetJsonIntField(Payload, TEXT("bufferLines"), 8192), 256, 1 << 20),
+        GetBoolFieldPipe(Payload, TEXT("parseDiagnostics"), true));
+    FString Error;
+    if (!Runner->Launch(Executable, Arguments, WorkingDirectory, Error))
+    {
+        SendAutomationError(RequestingSocket, RequestId, Error, TEXT("LAUNCH_FAILED"));
+        return false;
+    }
+
+    // The process enforces its own timeout so the completion event still carries
+    // the diagnostics and output tail; the registry timeout would drop them.
+    TSharedPtr<FMcpAutomationJob> Job = BeginAutomationJob(Kind, RequestId, RequestingSocket);
+    ManagedProcesses.Add(Job->JobId, Runner);
+
+    struct FOutputState
+    {
+        TArray<FMcpProcessLine> Pending;
+        double LastSendSeconds = 0.0;
+        uint64 ReportedDropped = 0;
+        bool bTimedOut = false;
+    };
+    TSharedRef<FOutputState> State = MakeShared<FOutputState>();
+
+    Job->Poll = [this, Runner, State, bStreamOutput, TimeoutSeconds, MaxDiagnostics, TailLines](FMcpAutomationJob& RunningJob)
+    {
+        // Read the finished flag first: once set, every line is already in the ring.
+        const bool bFinished = Runner->IsFinished();
+        const double Now = FPlatformTime::Seconds();
+
+        do
+        {
+            Runner->DrainLines(State->Pending, McpProcessOutputBatchLines);
+            const bool bFlush = bFinished || State->Pending.Num() >= McpProcessOutputBatchLines ||
+                                Now - State->LastSendSeconds >= McpProcessOutputIntervalSeconds;
+            if (!bFlush || State->Pending.Num() == 0)
+            {
+                break;
+            }
+            if (bStreamOutput)
+            {
+                const uint64 Dropped = Runner->GetDroppedLines();
+                SendAutomationJobEvent(
+                    RunningJob, McpMakeProcessOutputEvent(RunningJob, State->Pending, Dropped - State->ReportedDropped));
+                State->ReportedDropped = Dropped;
+            }
+            State->Pending.Reset();
+            State->LastSendSeconds = Now;
+        }
+        while (bFinished);
+
+        if (!bFinished)
+        {
+            if (TimeoutSeconds > 0.0 && !State->bTimedOut && RunningJob.GetElapsedSeconds() > TimeoutSeconds)
+            {
+                State->bTimedOut = true;
+                Runner->Terminate();
+            }
+            return false;
+        }
+
+        const int32 ExitCode = Runner->GetExitCode();
+        RunningJob.Result = Runner->GetSummaryJson(MaxDiagnostics, TailLines);
+        RunningJob.Result->SetStringField(TEXT("commandLine"), Runner->GetCommandLine());
+        RunningJob.Result->SetBoolField(TEXT("timedOut"), State->bTimedOut);
+        RunningJob.bSuccess = ExitCode == 0 && !Runner->WasTerminated();
+        if (State->bTimedOut)
+        {
+            RunningJob.ErrorCode = TEXT("JOB_TIMEOUT");
+            RunningJob.Message = FString::Printf(TEXT("Process killed after %.0fs timeout"), TimeoutSeconds);
+        }
+        else if (Runner->WasTerminated())
+        {
+            RunningJob.ErrorCode = TEXT("CANCELLED");
+            RunningJob.Message = TEXT("Process cancelled");
+        }
+        else
+        {
+            RunningJob.ErrorCode = RunningJob.bSuccess ? FString() : TEXT("PROCESS_FAILED");
+            RunningJob.Message = FString::Printf(TEXT("Process exited with code %d (%d error(s), %d warning(s))"),
+                                                 ExitCode, Runner->GetErrorCount(), Runner->GetWarningCount());
+        }
+        return true;
+    };
+    const FString JobId = Job->JobId;
+    Job->OnFinished = [this, JobId]()
+    {
+        // Dropping the runner kills the process tree if it is still alive
+        // (registry shutdown) and joins the reader thread.
+        ManagedProcesses.Remove(JobId);
+    };
+
+    TSharedPtr<FJsonObject> Result = ResponseFields.IsValid() ? ResponseFields : MakeShared<FJsonObject>();
+    Result->SetStringField(TEXT("jobId"), Job->JobId);
+    Result->SetNumberField(TEXT("pid"), Runner->GetProcessId());
+    Result->SetStringField(TEXT("commandLine"), Runner->GetCommandLine());
+    Result->SetBoolField(TEXT("processStarted"), true);
+    Result->SetBoolField(TEXT("streamOutput"), bStreamOutput);
+    SendAutomationResponse(RequestingSocket, RequestId, true,
+        FString::Printf(TEXT("Process started (pid %u); output streams as process_output events and the result arrives as job_completed."), Runner->GetProcessId()),
+        Result);
+    return true;
+}
 
 bool UMcpAutomationBridgeSubsystem::HandlePipelineAction(const FString& RequestId, const FString& Action, const TSharedPtr<FJsonObject>& Payload, TSharedPtr<FMcpBridgeWebSocket> RequestingSocket)
 {
@@ -32,50 +225,142 @@ bool UMcpAutomationBridgeSubsystem::HandlePipelineAction(const FString& RequestI
 
     if (SubAction == TEXT("run_ubt"))
     {
-        FString Target;
-        Payload->TryGetStringField(TEXT("target"), Target);
-        FString Platform;
-        Payload->TryGetStringField(TEXT("platform"), Platform);
-        FString Configuration;
-        Payload->TryGetStringField(TEXT("configuration"), Configuration);
-        FString ExtraArgs;
-        Payload->TryGetStringField(TEXT("extraArgs"), ExtraArgs);
-
-        // Construct UBT command line
-        // Path to UBT... usually in Engine/Binaries/DotNET/UnrealBuildTool/UnrealBuildTool.exe
-        FString UBTPath = FPaths::ConvertRelativePathToFull(FPaths::EngineDir() / TEXT("Binaries/DotNET/UnrealBuildTool/UnrealBuildTool.exe"));
-        
-        FString Params = FString::Printf(TEXT("%s %s %s %s"), *Target, *Platform, *Configuration, *ExtraArgs);
-
-        // Spawn process
-        FProcHandle ProcHandle = FPlatformProcess::CreateProc(
-            *UBTPath,
-            *Params,
-            true, // bLaunchDetached
-            false, // bLaunchHidden
-            false, // bLaunchReallyHidden
-            nullptr, // ProcessID
-            0, // PriorityModifier
-            nullptr, // OptionalWorkingDirectory
-            nullptr // PipeWriteChild
-        );
-
-        if (ProcHandle.IsValid())
-        {
-             // We can't easily get the PID on all platforms from the handle immediately without more code,
-             // but we know it started.
-             TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
-             Result->SetStringField(TEXT("action"), TEXT("run_ubt"));
-             Result->SetStringField(TEXT("target"), Target);
-             Result->SetStringField(TEXT("platform"), Platform);
-             Result->SetStringField(TEXT("configuration"), Configuration);
-             Result->SetBoolField(TEXT("processStarted"), true);
-             SendAutomationResponse(RequestingSocket, RequestId, true, TEXT("UBT process started."), Result);
+        FString Target = GetStringFieldPipe(Payload, TEXT("target"));
+        if (Target.IsEmpty())
+        {
+            Target = FString(FApp::GetProjectName()) + TEXT("Editor");
         }
-        else
+        FString Platform = GetStringFieldPipe(Payload, TEXT("platform"));
+        if (Platform.IsEmpty())
+        {
+            Platform = McpHostUbtPlatform();
+        }
+        FString Configuration = GetStringFieldPipe(Payload, TEXT("configuration"));
+        if (Configuration.IsEmpty())
+        {
+            Configuration = TEXT("Development");
+        }
+        const FString ExtraArgs = GetStringFieldPipe(Payload, TEXT("extraArgs"));
+
+        FString Params = FString::Printf(TEXT("%s %s %s"), *Target, *Platform, *Configuration);
+        if (FPaths::IsProjectFilePathSet() && !ExtraArgs.Contains(TEXT("-Project="), ESearchCase::IgnoreCase))
+        {
+            Params += FString::Printf(TEXT(" -Project=\"%s\""), *FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()));
+        }
+        // Queue behind another UBT instance (e.g. Live Coding) instead of failing outright.
+        if (GetBoolFieldPipe(Payload, TEXT("waitMutex"), true) && !ExtraArgs.Contains(TEXT("-WaitMutex"), ESearchCase::IgnoreCase))
+        {
+            Params += TEXT(" -WaitMutex");
+        }
+        if (!ExtraArgs.IsEmpty())
+        {
+            Params += TEXT(" ") + ExtraArgs;
+        }
+
+        TSharedPtr<FJsonObject> Fields = MakeShared<FJsonObject>();
+        Fields->SetStringField(TEXT("action"), TEXT("run_ubt"));
+        Fields->SetStringField(TEXT("target"), Target);
+        Fields->SetStringField(TEXT("platform"), Platform);
+        Fields->SetStringField(TEXT("configuration"), Configuration);
+        StartManagedProcess(RequestId, RequestingSocket, TEXT("ubt"), McpUbtExecutable(), Params,
+                            FPaths::ConvertRelativePathToFull(FPaths::EngineDir()), Payload, Fields);
+        return true;
+    }
+
+    // ==========================================================================
+    // run_process - Run any external tool with streamed output
+    // ==========================================================================
+    if (SubAction == TEXT("run_process"))
+    {
+        FString Executable = GetStringFieldPipe(Payload, TEXT("executable"));
+        if (Executable.IsEmpty())
+        {
+            SendAutomationError(RequestingSocket, RequestId, TEXT("executable is required."), TEXT("INVALID_ARGUMENT"));
+            return true;
+        }
+        if (FPaths::IsRelative(Executable))
+        {
+            // Tools shipped with the project or engine can be named relative to them.
+            const FString Roots[] = {FPaths::ProjectDir(), FPaths::EngineDir()};
+            for (const FString& Root : Roots)
+            {
+                const FString Candidate = FPaths::ConvertRelativePathToFull(Root / Executable);
+                if (FPaths::FileExists(Candidate))
+                {
+                    Executable = Candidate;
+                    break;
+                }
+            }
+        }
+        FString WorkingDirectory = GetStringFieldPipe(Payload, TEXT("workingDirectory"));
+        if (WorkingDirectory.IsEmpty())
+        {
+            WorkingDirectory = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+        }
+
+        TSharedPtr<FJsonObject> Fields = MakeShared<FJsonObject>();
+        Fields->SetStringField(TEXT("action"), TEXT("run_process"));
+        StartManagedProcess(RequestId, RequestingSocket, TEXT("process"), Executable,
+                            GetStringFieldPipe(Payload, TEXT("arguments")), WorkingDirectory, Payload, Fields);
+        return true;
+    }
+
+    // ==========================================================================
+    // cancel_process - Kill a managed process tree; its job reports CANCELLED
+    // ==========================================================================
+    if (SubAction == TEXT("cancel_process"))
+    {
+        const FString JobId = GetStringFieldPipe(Payload, TEXT("jobId"));
+        if (JobId.IsEmpty())
+        {
+            SendAutomationError(RequestingSocket, RequestId, TEXT("jobId is required."), TEXT("INVALID_ARGUMENT"));
+            return true;
+        }
+        const TSharedPtr<FMcpProcessRunner>* Found = ManagedProcesses.Find(JobId);
+        if (!Found)
         {
-             SendAutomationError(RequestingSocket, RequestId, TEXT("Failed to launch UBT."), TEXT("LAUNCH_FAILED"));
+            SendAutomationError(RequestingSocket, RequestId, FString::Printf(TEXT("No running process for job %s"), *JobId), TEXT("NOT_FOUND"));
+            return true;
         }
+        (*Found)->Terminate();
+
+        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+        Result->SetStringField(TEXT("jobId"), JobId);
+        Result->SetNumberField(TEXT("pid"), (*Found)->GetProcessId());
+        SendAutomationResponse(RequestingSocket, RequestId, true, TEXT("Termination requested; the job reports CANCELLED once the process exits."), Result);
+        return true;
+    }
+
+    // ==========================================================================
+    // list_processes - Managed processes still running
+    // ==========================================================================
+    if (SubAction == TEXT("list_processes"))
+    {
+        TArray<TSharedPtr<FJsonValue>> Processes;
+        for (const TPair<FString, TSharedPtr<FMcpProcessRunner>>& Pair : ManagedProcesses)
+        {
+            const FMcpProcessRunner& Runner = *Pair.Value;
+            TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+            Entry->SetStringField(TEXT("jobId"), Pair.Key);
+            Entry->SetNumberField(TEXT("pid"), Runner.GetProcessId());
+            Entry->SetStringField(TEXT("commandLine"), Runner.GetCommandLine());
+            Entry->SetNumberField(TEXT("lines"), (double)Runner.GetTotalLines());
+            Entry->SetNumberField(TEXT("errorCount"), Runner.GetErrorCount());
+            Entry->SetNumberField(TEXT("warningCount"), Runner.GetWarningCount());
+            Entry->SetBoolField(TEXT("terminating"), Runner.WasTerminated());
+            if (const TSharedPtr<FMcpAutomationJob>* Job = AutomationJobs.Find(Pair.Key))
+            {
+                Entry->SetStringField(TEXT("kind"), (*Job)->Kind);
+                Entry->SetNumberField(TEXT("elapsedMs"), (*Job)->GetElapsedSeconds() * 1000.0);
+            }
+            Processes.Add(MakeShared<FJsonValueObject>(Entry));
+        }
+
+        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+        Result->SetArrayField(TEXT("processes"), Processes);
+        Result->SetNumberField(TEXT("count"), Processes.Num());
+        Result->SetNumberField(TEXT("maxConcurrent"), McpMaxConcurrentProcesses());
+        SendAutomationResponse(RequestingSocket, RequestId, true, FString::Printf(TEXT("%d managed process(es) running"), Processes.Num()), Result);
         return true;
     }
 
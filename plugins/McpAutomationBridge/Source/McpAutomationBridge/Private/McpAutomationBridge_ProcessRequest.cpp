@@ -1,10 +1,14 @@
+#include "AssetRegistry/IAssetRegistry.h"
 #include "Async/Async.h"
 #include "Dom/JsonObject.h"
 #include "HAL/PlatformTime.h"
 #include "McpAutomationBridgeGlobals.h"
 #include "McpAutomationBridgeHelpers.h"
 #include "McpAutomationBridgeSubsystem.h"
+#include "McpBridgeTrace.h"
 #include "McpConnectionManager.h"
+#include "McpRequestScheduler.h"
+#include "McpTransactionPolicy.h"
 #include "Misc/ScopeExit.h"
 #include "Misc/ScopeLock.h"
 
@@ -12,72 +16,218 @@ void UMcpAutomationBridgeSubsystem::ProcessAutomationRequest(
     const FString &RequestId, const FString &Action,
     const TSharedPtr<FJsonObject> &Payload,
     TSharedPtr<FMcpBridgeWebSocket> RequestingSocket) {
+  MCP_TRACE_SCOPE(McpBridge_ProcessAutomationRequest);
+
   // This large implementation was extracted from the original subsystem
   // translation unit to keep the core file smaller and focused. It
   // contains the main dispatcher that delegates to specialized handler
   // functions (property/blueprint/sequence/asset handlers) and retains
   // the queuing/scope-exit safety logic expected by callers.
 
-  // Ensure automation processing happens on the game thread
   // This trace is intentionally verbose — routine requests can be high
   // frequency and will otherwise flood the logs. Developers can enable
   // Verbose logging to see these messages when required.
   UE_LOG(LogMcpAutomationBridgeSubsystem, Verbose,
          TEXT(">>> ProcessAutomationRequest ENTRY: RequestId=%s action='%s' "
-              "(thread=%s)"),
+              "(thread=%s) activeSockets=%d pendingQueue=%d"),
          *RequestId, *Action,
-         IsInGameThread() ? TEXT("GameThread") : TEXT("SocketThread"));
-  UE_LOG(LogMcpAutomationBridgeSubsystem, Verbose,
-         TEXT("ProcessAutomationRequest invoked (thread=%s) RequestId=%s "
-              "action=%s activeSockets=%d pendingQueue=%d"),
          IsInGameThread() ? TEXT("GameThread") : TEXT("SocketThread"),
-         *RequestId, *Action,
          ConnectionManager.IsValid() ? ConnectionManager->GetActiveSocketCount()
                                      : 0,
-         PendingAutomationRequests.Num());
-  if (!IsInGameThread()) {
-    UE_LOG(LogMcpAutomationBridgeSubsystem, Verbose,
-           TEXT("Scheduling ProcessAutomationRequest on GameThread: "
-                "RequestId=%s action=%s"),
-           *RequestId, *Action);
-    AsyncTask(ENamedThreads::GameThread,
-              [WeakThis = TWeakObjectPtr<UMcpAutomationBridgeSubsystem>(this),
-               RequestId, Action, Payload, RequestingSocket]() {
-                if (UMcpAutomationBridgeSubsystem *Pinned = WeakThis.Get()) {
-                  Pinned->ProcessAutomationRequest(RequestId, Action, Payload,
-                                                   RequestingSocket);
-                }
-              });
+         RequestScheduler.IsValid() ? RequestScheduler->Num() : 0);
+
+  // Read-only queries from handlers registered as thread-safe run on a
+  // worker thread so they neither wait behind nor stall game-thread work.
+  if (CanDispatchOnWorker(Action, Payload) &&
+      !HasClientMutations(RequestingSocket.Get())) {
+    DispatchAutomationRequestOnWorker(RequestId, Action, Payload,
+                                      RequestingSocket);
+    return;
+  }
+  BeginClientMutation(RequestingSocket, RequestId);
+
+  // Everything else from the socket threads goes through the scheduler so
+  // it is served by priority and fairly across clients. Game-thread
+  // callers dispatch inline unless that would jump the queue, reenter a
+  // running handler or an open batch transaction, or run during
+  // Serialization/GC/Loading (calling StaticFindObject via
+  // ResolveClassByName in those states can crash).
+  const bool bMustQueue =
+      !IsInGameThread() || bProcessingAutomationRequest ||
+      OpenBatchTransactions > 0 || GIsSavingPackage ||
+      IsGarbageCollecting() || IsAsyncLoading() ||
+      (RequestScheduler.IsValid() && RequestScheduler->Num() > 0);
+  if (bMustQueue) {
+    EnqueueAutomationRequest(RequestId, Action, Payload, RequestingSocket);
+    return;
+  }
+
+  DispatchAutomationRequest(RequestId, Action, Payload, RequestingSocket);
+}
+
+void UMcpAutomationBridgeSubsystem::BeginClientMutation(
+    const TSharedPtr<FMcpBridgeWebSocket> &Socket, const FString &Id) {
+  if (!Socket.IsValid() || Id.IsEmpty()) {
+    return;
+  }
+  FScopeLock Lock(&ClientMutationsMutex);
+  FClientMutations &Mutations = ClientMutations.FindOrAdd(Socket.Get());
+  if (!Mutations.Socket.HasSameObject(Socket.Get())) {
+    // A new socket at the address of one that is gone.
+    Mutations.Socket = Socket;
+    Mutations.Ids.Reset();
+  }
+  Mutations.Ids.Add(Id);
+}
+
+void UMcpAutomationBridgeSubsystem::EndClientMutation(
+    const FMcpBridgeWebSocket *Socket, const FString &Id) {
+  FScopeLock Lock(&ClientMutationsMutex);
+  for (auto It = ClientMutations.CreateIterator(); It; ++It) {
+    if (Socket && It.Key() != Socket) {
+      continue;
+    }
+    if (It.Value().Ids.RemoveSingle(Id) > 0) {
+      if (It.Value().Ids.Num() == 0) {
+        It.RemoveCurrent();
+      }
+      return;
+    }
+  }
+}
+
+bool UMcpAutomationBridgeSubsystem::HasClientMutations(
+    const FMcpBridgeWebSocket *Socket) {
+  FScopeLock Lock(&ClientMutationsMutex);
+  const FClientMutations *Mutations = ClientMutations.Find(Socket);
+  if (!Mutations) {
+    return false;
+  }
+  if (!Mutations->Socket.IsValid()) {
+    // Left over from a socket that is gone.
+    ClientMutations.Remove(Socket);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Whether a request may be dispatched on a worker thread.
+ *
+ * True when the action's handler (or the payload's subAction) was registered
+ * as thread-safe, the worker limit has room and the asset registry has
+ * finished its initial scan. A client's request is never moved ahead of its
+ * own earlier requests; the caller checks that against ClientMutations.
+ */
+bool UMcpAutomationBridgeSubsystem::CanDispatchOnWorker(
+    const FString &Action, const TSharedPtr<FJsonObject> &Payload) const {
+  const FHandlerTraits *Traits = AutomationHandlerTraits.Find(Action);
+  if (!Traits || MaxWorkerRequests <= 0 ||
+      WorkerRequestsInFlight.load() >= MaxWorkerRequests) {
+    return false;
+  }
+  if (!Traits->bThreadSafe &&
+      !Traits->ThreadSafeSubActions.Contains(
+          GetJsonStringField(Payload, TEXT("subAction")).ToLower())) {
+    return false;
+  }
+  // Registry queries during the initial scan would report partial results
+  // and ScanPathsSynchronous is not available off the game thread, so
+  // serve them from the game thread until discovery has finished.
+  const IAssetRegistry *AssetRegistry = IAssetRegistry::Get();
+  return AssetRegistry && !AssetRegistry->IsLoadingAssets();
+}
+
+/**
+ * @brief Runs a thread-safe handler on a background task.
+ *
+ * The handler sends its response through SendAutomationResponse, which
+ * forwards to the game thread, so telemetry and socket bookkeeping stay
+ * single-threaded. The task uses the subsystem directly: Deinitialize waits
+ * for WorkerRequestsInFlight to drain before the subsystem goes away.
+ */
+void UMcpAutomationBridgeSubsystem::DispatchAutomationRequestOnWorker(
+    const FString &RequestId, const FString &Action,
+    const TSharedPtr<FJsonObject> &Payload,
+    TSharedPtr<FMcpBridgeWebSocket> RequestingSocket) {
+  const FAutomationHandler *Handler = AutomationHandlers.Find(Action);
+  if (!Handler) {
+    EnqueueAutomationRequest(RequestId, Action, Payload, RequestingSocket);
     return;
   }
 
-  // Guard against unsafe engine states (Saving, GC, Async Loading)
-  // Calling StaticFindObject (via ResolveClassByName) during these states can
-  // cause crashes.
-  if (GIsSavingPackage || IsGarbageCollecting() || IsAsyncLoading()) {
-    UE_LOG(LogMcpAutomationBridgeSubsystem, Verbose,
-           TEXT("Deferring ProcessAutomationRequest due to active "
-                "Serialization/GC/Loading: RequestId=%s Action=%s"),
-           *RequestId, *Action);
-
-    FPendingAutomationRequest P;
-    P.RequestId = RequestId;
-    P.Action = Action;
-    P.Payload = Payload;
-    P.RequestingSocket = RequestingSocket;
-    {
-      FScopeLock Lock(&PendingAutomationRequestsMutex);
-      PendingAutomationRequests.Add(MoveTemp(P));
-      bPendingRequestsScheduled = true;
+  if (ConnectionManager.IsValid()) {
+    ConnectionManager->StartRequestTelemetry(RequestId, Action);
+    if (!RequestId.IsEmpty() && RequestingSocket.IsValid()) {
+      ConnectionManager->RegisterRequestSocket(RequestId, RequestingSocket);
     }
+  }
+
+  ++WorkerRequestsInFlight;
+  if (bWorkersShuttingDown.load()) {
+    --WorkerRequestsInFlight;
     return;
   }
+  UE_LOG(LogMcpAutomationBridgeSubsystem, Verbose,
+         TEXT("Dispatching RequestId=%s action='%s' on worker (%d in flight)"),
+         *RequestId, *Action, WorkerRequestsInFlight.load());
+
+  AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+            [Pinned = this, Handler = *Handler, RequestId, Action, Payload,
+             RequestingSocket]() {
+              MCP_TRACE_SCOPE(McpBridge_DispatchOnWorker);
+              MCP_TRACE_SCOPE_TEXT(*Action);
+              McpTrace::MarkRequest(EMcpTracePhase::Dispatched, RequestId,
+                                    Action);
+              const double StartSeconds = FPlatformTime::Seconds();
+              const bool bHandled =
+                  Handler(RequestId, Action, Payload, RequestingSocket);
+              if (!bHandled) {
+                Pinned->SendAutomationError(
+                    RequestingSocket, RequestId,
+                    FString::Printf(TEXT("No handler consumed action '%s'"),
+                                    *Action),
+                    TEXT("UNKNOWN_ACTION"));
+              }
+              --Pinned->WorkerRequestsInFlight;
+              UE_LOG(LogMcpAutomationBridgeSubsystem, Verbose,
+                     TEXT("Worker completed RequestId=%s action='%s' "
+                          "(%.3f ms)"),
+                     *RequestId, *Action,
+                     (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+            });
+}
 
+void UMcpAutomationBridgeSubsystem::EnqueueAutomationRequest(
+    const FString &RequestId, const FString &Action,
+    const TSharedPtr<FJsonObject> &Payload,
+    TSharedPtr<FMcpBridgeWebSocket> RequestingSocket) {
+  if (!RequestScheduler.IsValid()) {
+    return;
+  }
+  FMcpScheduledRequest Request;
+  Request.RequestId = RequestId;
+  Request.Action = Action;
+  Request.Payload = Payload;
+  Request.Socket = RequestingSocket;
+  Request.Priority = FMcpRequestScheduler::Classify(Action, Payload);
   UE_LOG(LogMcpAutomationBridgeSubsystem, Verbose,
-         TEXT("Starting ProcessAutomationRequest on GameThread: RequestId=%s "
-              "action=%s bProcessingAutomationRequest=%s"),
+         TEXT("Enqueued automation request %s for action %s (lane=%s)."),
          *RequestId, *Action,
-         bProcessingAutomationRequest ? TEXT("true") : TEXT("false"));
+         FMcpRequestScheduler::PriorityName(Request.Priority));
+  McpTrace::MarkRequest(EMcpTracePhase::Queued, RequestId, Action);
+  RequestScheduler->Enqueue(MoveTemp(Request));
+  SchedulePendingAutomationRequests(false);
+}
+
+void UMcpAutomationBridgeSubsystem::DispatchAutomationRequest(
+    const FString &RequestId, const FString &Action,
+    const TSharedPtr<FJsonObject> &Payload,
+    TSharedPtr<FMcpBridgeWebSocket> RequestingSocket) {
+  check(IsInGameThread());
+  MCP_TRACE_SCOPE(McpBridge_Dispatch);
+  MCP_TRACE_SCOPE_TEXT(*Action);
+  McpTrace::MarkRequest(EMcpTracePhase::Dispatched, RequestId, Action);
 
   const FString LowerAction = Action.ToLower();
 
@@ -85,25 +235,9 @@ void UMcpAutomationBridgeSubsystem::ProcessAutomationRequest(
     ConnectionManager->StartRequestTelemetry(RequestId, Action);
   }
 
-  // Reentrancy guard / enqueue
-  if (bProcessingAutomationRequest) {
-    FPendingAutomationRequest P;
-    P.RequestId = RequestId;
-    P.Action = Action;
-    P.Payload = Payload;
-    P.RequestingSocket = RequestingSocket;
-    {
-      FScopeLock Lock(&PendingAutomationRequestsMutex);
-      PendingAutomationRequests.Add(MoveTemp(P));
-      bPendingRequestsScheduled = true;
-    }
-    UE_LOG(LogMcpAutomationBridgeSubsystem, Verbose,
-           TEXT("Enqueued automation request %s for action %s (processing in "
-                "progress)."),
-           *RequestId, *Action);
-    return;
-  }
-
+  // Batch items are dispatched from inside the batch handler, so restore the
+  // outer request's state rather than clearing it on exit.
+  const bool bWasProcessingAutomationRequest = bProcessingAutomationRequest;
   bProcessingAutomationRequest = true;
   bool bDispatchHandled = false;
   FString ConsumedHandlerLabel = TEXT("unknown-handler");
@@ -120,7 +254,7 @@ void UMcpAutomationBridgeSubsystem::ProcessAutomationRequest(
 
   {
     ON_SCOPE_EXIT {
-      bProcessingAutomationRequest = false;
+      bProcessingAutomationRequest = bWasProcessingAutomationRequest;
       const double DispatchEndSeconds = FPlatformTime::Seconds();
       const double DurationMs =
           (DispatchEndSeconds - DispatchStartSeconds) * 1000.0;
@@ -136,12 +270,18 @@ void UMcpAutomationBridgeSubsystem::ProcessAutomationRequest(
                *RequestId, *Action, DurationMs);
       }
 
-      if (bPendingRequestsScheduled) {
-        bPendingRequestsScheduled = false;
-        ProcessPendingAutomationRequests();
+      // Anything queued while this handler ran (nested requests) is drained
+      // by the scheduler on a later frame rather than recursively here.
+      if (RequestScheduler.IsValid() && RequestScheduler->Num() > 0) {
+        SchedulePendingAutomationRequests(true);
       }
     };
 
+    // Coalesced/none undo policy; closed before the scope exit above runs.
+    const FMcpRequestTransactionScope TransactionScope(
+        Action, Payload, !bWasProcessingAutomationRequest,
+        RequestingSocket.Get());
+
     try {
       // Map this requestId to the requesting socket so responses can be
       // delivered reliably
@@ -614,6 +754,7 @@ void UMcpAutomationBridgeSubsystem::ProcessAutomationRequest(
   }
 }
 
-// ProcessPendingAutomationRequests() intentionally implemented in the
-// primary subsystem translation unit (McpAutomationBridgeSubsystem.cpp)
-// to ensure the linker emits the symbol into the module's object file.
+// ProcessPendingAutomationRequests() and SchedulePendingAutomationRequests()
+// are intentionally implemented in the primary subsystem translation unit
+// (McpAutomationBridgeSubsystem.cpp) to ensure the linker emits the symbols
+// into the module's object file.
@@ -1519,6 +1519,219 @@ bool UMcpAutomationBridgeSubsystem::HandleSequenceGetMetadata(
 #endif
 }
 
+#if WITH_EDITOR
+/**
+ * Resolve a sequence binding either from an explicit GUID string or by
+ * matching the possessable/spawnable display name (case-insensitive).
+ * Returns an invalid GUID when nothing matches.
+ */
+static FGuid McpFindSequenceBindingGuid(UMovieScene *MovieScene,
+                                        const FString &BindingIdStr,
+                                        const FString &ActorName) {
+  FGuid BindingGuid;
+  if (!MovieScene)
+    return BindingGuid;
+  if (!BindingIdStr.IsEmpty()) {
+    FGuid::Parse(BindingIdStr, BindingGuid);
+    return BindingGuid;
+  }
+  if (ActorName.IsEmpty())
+    return BindingGuid;
+
+  for (const FMovieSceneBinding &Binding :
+       const_cast<const UMovieScene *>(MovieScene)->GetBindings()) {
+    FString BindingName;
+    if (FMovieScenePossessable *Possessable =
+            MovieScene->FindPossessable(Binding.GetObjectGuid())) {
+      BindingName = Possessable->GetName();
+    } else if (FMovieSceneSpawnable *Spawnable =
+                   MovieScene->FindSpawnable(Binding.GetObjectGuid())) {
+      BindingName = Spawnable->GetName();
+    }
+
+    if (BindingName.Equals(ActorName, ESearchCase::IgnoreCase)) {
+      return Binding.GetObjectGuid();
+    }
+  }
+  return BindingGuid;
+}
+
+/**
+ * Map a transform channel name ("location.x", "rotation.yaw", "scale.z", ...)
+ * to its index in UMovieScene3DTransformSection's double channel proxy.
+ * Layout: 0-2 location XYZ, 3-5 rotation Roll/Pitch/Yaw, 6-8 scale XYZ.
+ */
+static int32 McpTransformChannelIndex(const FString &ChannelName) {
+  static const TCHAR *Names[] = {
+      TEXT("location.x"), TEXT("location.y"),    TEXT("location.z"),
+      TEXT("rotation.roll"), TEXT("rotation.pitch"), TEXT("rotation.yaw"),
+      TEXT("scale.x"),    TEXT("scale.y"),       TEXT("scale.z")};
+  FString Normalized = ChannelName.ToLower();
+  Normalized.ReplaceInline(TEXT("_"), TEXT("."));
+  if (Normalized.StartsWith(TEXT("translation.")))
+    Normalized = TEXT("location.") + Normalized.RightChop(12);
+  for (int32 Index = 0; Index < UE_ARRAY_COUNT(Names); ++Index) {
+    if (Normalized == Names[Index])
+      return Index;
+  }
+  return INDEX_NONE;
+}
+
+/**
+ * Dense sample reduction for sequencer curves.
+ *
+ * Slopes are estimated at every sample by finite differences, then a
+ * Douglas-Peucker style split is run where each candidate segment is
+ * evaluated with the same interpolation the channel will use (linear or
+ * cubic Hermite with the fitted slopes). A segment is split at its worst
+ * sample until every dropped sample is within Tolerance of the curve, so
+ * the reduced keys are error-bounded against the input rather than against
+ * a straight-line approximation.
+ */
+struct FMcpSampledCurve {
+  TArray<double> Frames;
+  TArray<double> Values;
+  TArray<double> Slopes;
+
+  void ComputeSlopes() {
+    const int32 Num = Frames.Num();
+    Slopes.SetNumZeroed(Num);
+    if (Num < 2)
+      return;
+    for (int32 i = 0; i < Num; ++i) {
+      const int32 Prev = FMath::Max(0, i - 1);
+      const int32 Next = FMath::Min(Num - 1, i + 1);
+      const double Dt = Frames[Next] - Frames[Prev];
+      Slopes[i] = Dt > UE_DOUBLE_SMALL_NUMBER
+                      ? (Values[Next] - Values[Prev]) / Dt
+                      : 0.0;
+    }
+  }
+
+  double Evaluate(int32 A, int32 B, double Frame, bool bCubic) const {
+    const double Dt = Frames[B] - Frames[A];
+    if (Dt <= UE_DOUBLE_SMALL_NUMBER)
+      return Values[A];
+    const double T = (Frame - Frames[A]) / Dt;
+    if (!bCubic)
+      return FMath::Lerp(Values[A], Values[B], T);
+    const double T2 = T * T;
+    const double T3 = T2 * T;
+    return (2.0 * T3 - 3.0 * T2 + 1.0) * Values[A] +
+           (T3 - 2.0 * T2 + T) * Slopes[A] * Dt +
+           (-2.0 * T3 + 3.0 * T2) * Values[B] + (T3 - T2) * Slopes[B] * Dt;
+  }
+
+  void Reduce(double Tolerance, bool bCubic, TArray<int32> &OutKept) const {
+    OutKept.Reset();
+    const int32 Num = Frames.Num();
+    if (Num == 0)
+      return;
+    if (Num <= 2 || Tolerance <= 0.0) {
+      for (int32 i = 0; i < Num; ++i)
+        OutKept.Add(i);
+      return;
+    }
+
+    TArray<bool> Keep;
+    Keep.SetNumZeroed(Num);
+    Keep[0] = true;
+    Keep[Num - 1] = true;
+
+    // Explicit stack instead of recursion: dense bakes can contain tens of
+    // thousands of samples per channel.
+    TArray<TPair<int32, int32>> Stack;
+    Stack.Emplace(0, Num - 1);
+    while (Stack.Num() > 0) {
+      const TPair<int32, int32> Segment = Stack.Pop(EAllowShrinking::No);
+      const int32 A = Segment.Key;
+      const int32 B = Segment.Value;
+      if (B - A < 2)
+        continue;
+
+      double MaxError = 0.0;
+      int32 MaxIndex = INDEX_NONE;
+      for (int32 i = A + 1; i < B; ++i) {
+        const double Error =
+            FMath::Abs(Evaluate(A, B, Frames[i], bCubic) - Values[i]);
+        if (Error > MaxError) {
+          MaxError = Error;
+          MaxIndex = i;
+        }
+      }
+
+      if (MaxIndex != INDEX_NONE && MaxError > Tolerance) {
+        Keep[MaxIndex] = true;
+        Stack.Emplace(A, MaxIndex);
+        Stack.Emplace(MaxIndex, B);
+      }
+    }
+
+    for (int32 i = 0; i < Num; ++i) {
+      if (Keep[i])
+        OutKept.Add(i);
+    }
+  }
+};
+
+/**
+ * Merge new keys into an existing channel in one rebuild pass. Existing
+ * keys inside [first, last] of the new keys are dropped when bReplaceRange is
+ * set; otherwise only keys at identical times are overwritten.
+ */
+template <typename ChannelType, typename ValueType>
+static void McpMergeChannelKeys(ChannelType *Channel,
+                                const TArray<FFrameNumber> &NewTimes,
+                                const TArray<ValueType> &NewValues,
+                                bool bReplaceRange) {
+  if (!Channel || NewTimes.Num() == 0)
+    return;
+
+  const FFrameNumber RangeStart = NewTimes[0];
+  const FFrameNumber RangeEnd = NewTimes.Last();
+
+  auto ChannelData = Channel->GetData();
+  const TArray<FFrameNumber> OldTimes(ChannelData.GetTimes());
+  const TArray<ValueType> OldValues(ChannelData.GetValues());
+
+  TArray<FFrameNumber> MergedTimes;
+  TArray<ValueType> MergedValues;
+  MergedTimes.Reserve(OldTimes.Num() + NewTimes.Num());
+  MergedValues.Reserve(OldTimes.Num() + NewTimes.Num());
+
+  int32 OldIndex = 0;
+  int32 NewIndex = 0;
+  while (OldIndex < OldTimes.Num() || NewIndex < NewTimes.Num()) {
+    if (OldIndex < OldTimes.Num()) {
+      const FFrameNumber OldTime = OldTimes[OldIndex];
+      const bool bInReplacedRange =
+          bReplaceRange && OldTime >= RangeStart && OldTime <= RangeEnd;
+      const bool bOverwritten =
+          NewIndex < NewTimes.Num() && OldTime == NewTimes[NewIndex];
+      if (bInReplacedRange || bOverwritten) {
+        ++OldIndex;
+        continue;
+      }
+      if (NewIndex >= NewTimes.Num() || OldTime < NewTimes[NewIndex]) {
+        MergedTimes.Add(OldTime);
+        MergedValues.Add(OldValues[OldIndex]);
+        ++OldIndex;
+        continue;
+      }
+    }
+    MergedTimes.Add(NewTimes[NewIndex]);
+    MergedValues.Add(NewValues[NewIndex]);
+    ++NewIndex;
+  }
+
+  // Keys are re-added in ascending order so each AddKey appends at the end.
+  ChannelData.Reset();
+  for (int32 i = 0; i < MergedTimes.Num(); ++i) {
+    ChannelData.AddKey(MergedTimes[i], MergedValues[i]);
+  }
+}
+#endif
+
 bool UMcpAutomationBridgeSubsystem::HandleSequenceAddKeyframe(
     const FString &RequestId, const TSharedPtr<FJsonObject> &Payload,
     TSharedPtr<FMcpBridgeWebSocket> Socket) {
@@ -1572,27 +1785,8 @@ bool UMcpAutomationBridgeSubsystem::HandleSequenceAddKeyframe(
   if (ULevelSequence *LevelSeq = Cast<ULevelSequence>(SeqObj)) {
     UMovieScene *MovieScene = LevelSeq->GetMovieScene();
     if (MovieScene) {
-      FGuid BindingGuid;
-      if (!BindingIdStr.IsEmpty()) {
-        FGuid::Parse(BindingIdStr, BindingGuid);
-      } else if (!ActorName.IsEmpty()) {
-        for (const FMovieSceneBinding &Binding :
-             const_cast<const UMovieScene *>(MovieScene)->GetBindings()) {
-          FString BindingName;
-          if (FMovieScenePossessable *Possessable =
-                  MovieScene->FindPossessable(Binding.GetObjectGuid())) {
-            BindingName = Possessable->GetName();
-          } else if (FMovieSceneSpawnable *Spawnable =
-                         MovieScene->FindSpawnable(Binding.GetObjectGuid())) {
-            BindingName = Spawnable->GetName();
-          }
-
-          if (BindingName.Equals(ActorName, ESearchCase::IgnoreCase)) {
-            BindingGuid = Binding.GetObjectGuid();
-            break;
-          }
-        }
-      }
+      const FGuid BindingGuid =
+          McpFindSequenceBindingGuid(MovieScene, BindingIdStr, ActorName);
 
       if (!BindingGuid.IsValid()) {
         FString Target = !BindingIdStr.IsEmpty() ? BindingIdStr : ActorName;
@@ -1814,6 +2008,413 @@ bool UMcpAutomationBridgeSubsystem::HandleSequenceAddKeyframe(
 #endif
 }
 
+/**
+ * Bulk keyframe ingestion for a single binding.
+ *
+ * Payload:
+ *   path / bindingId / actorName - same resolution as sequence_add_keyframe
+ *   channels: [{ property: "Transform", channel: "location.x",
+ *                frames: [...], values: [...] },
+ *              { property: "Intensity", frames: [...], values: [...] }]
+ *   reduce (bool, default true), tolerance (default 0.001),
+ *   interpolation ("cubic" | "linear" | "constant", default "cubic"),
+ *   replaceRange (bool, default true)
+ *
+ * Frames are expressed in display-rate frames (fractional frames allowed).
+ * The binding, tracks and sections are resolved once per request, keys are
+ * merged into each channel in one pass, and the sections/movie scene
+ * are modified once regardless of the number of samples.
+ */
+bool UMcpAutomationBridgeSubsystem::HandleSequenceAddKeyframes(
+    const FString &RequestId, const TSharedPtr<FJsonObject> &Payload,
+    TSharedPtr<FMcpBridgeWebSocket> Socket) {
+  TSharedPtr<FJsonObject> LocalPayload =
+      Payload.IsValid() ? Payload : MakeShared<FJsonObject>();
+  FString SeqPath = ResolveSequencePath(LocalPayload);
+  if (SeqPath.IsEmpty()) {
+    SendAutomationResponse(
+        Socket, RequestId, false,
+        TEXT("sequence_add_keyframes requires a sequence path"), nullptr,
+        TEXT("INVALID_SEQUENCE"));
+    return true;
+  }
+
+  FString BindingIdStr;
+  LocalPayload->TryGetStringField(TEXT("bindingId"), BindingIdStr);
+  FString ActorName;
+  LocalPayload->TryGetStringField(TEXT("actorName"), ActorName);
+  if (BindingIdStr.IsEmpty() && ActorName.IsEmpty()) {
+    SendAutomationResponse(Socket, RequestId, false,
+                           TEXT("Either bindingId or actorName must be "
+                                "provided."),
+                           nullptr, TEXT("INVALID_ARGUMENT"));
+    return true;
+  }
+
+  const TArray<TSharedPtr<FJsonValue>> *ChannelsArray = nullptr;
+  if (!LocalPayload->TryGetArrayField(TEXT("channels"), ChannelsArray) ||
+      !ChannelsArray || ChannelsArray->Num() == 0) {
+    SendAutomationResponse(
+        Socket, RequestId, false,
+        TEXT("channels array is required. Example: {\"channels\": "
+             "[{\"property\": \"Transform\", \"channel\": \"location.z\", "
+             "\"frames\": [0,1,2], \"values\": [0,5,10]}]}"),
+        nullptr, TEXT("INVALID_ARGUMENT"));
+    return true;
+  }
+
+  const bool bReduce = GetJsonBoolField(LocalPayload, TEXT("reduce"), true);
+  const double Tolerance =
+      FMath::Max(0.0, GetJsonNumberField(LocalPayload, TEXT("tolerance"), 0.001));
+  const bool bReplaceRange =
+      GetJsonBoolField(LocalPayload, TEXT("replaceRange"), true);
+  const FString Interpolation =
+      GetJsonStringField(LocalPayload, TEXT("interpolation"), TEXT("cubic"))
+          .ToLower();
+  const bool bConstant = Interpolation == TEXT("constant");
+  const bool bCubic = !bConstant && Interpolation != TEXT("linear");
+
+#if WITH_EDITOR
+  ULevelSequence *LevelSeq =
+      Cast<ULevelSequence>(UEditorAssetLibrary::LoadAsset(SeqPath));
+  UMovieScene *MovieScene = LevelSeq ? LevelSeq->GetMovieScene() : nullptr;
+  if (!MovieScene) {
+    SendAutomationResponse(Socket, RequestId, false,
+                           TEXT("Sequence not found or not a LevelSequence"),
+                           nullptr, TEXT("INVALID_SEQUENCE"));
+    return true;
+  }
+
+  const FGuid BindingGuid =
+      McpFindSequenceBindingGuid(MovieScene, BindingIdStr, ActorName);
+  if (!BindingGuid.IsValid() || !MovieScene->FindBinding(BindingGuid)) {
+    const FString Target = !BindingIdStr.IsEmpty() ? BindingIdStr : ActorName;
+    SendAutomationResponse(
+        Socket, RequestId, false,
+        FString::Printf(TEXT("Binding not found for '%s'. Ensure actor is "
+                             "bound to sequence."),
+                        *Target),
+        nullptr, TEXT("BINDING_NOT_FOUND"));
+    return true;
+  }
+
+  const FFrameRate TickResolution = MovieScene->GetTickResolution();
+  const FFrameRate DisplayRate = MovieScene->GetDisplayRate();
+  // Slopes are fitted per display frame; channel tangents are per tick.
+  const double TicksPerDisplayFrame =
+      FMath::Max(UE_DOUBLE_SMALL_NUMBER,
+                 TickResolution.AsDecimal() / DisplayRate.AsDecimal());
+
+  auto ToTickFrame = [&](double DisplayFrame) {
+    return FFrameRate::TransformTime(FFrameTime::FromDecimal(DisplayFrame),
+                                     DisplayRate, TickResolution)
+        .RoundToFrame();
+  };
+
+  const FScopedTransaction Transaction(
+      NSLOCTEXT("McpAutomationBridge", "SequenceAddKeyframes",
+                "Add Sequencer Keyframes"));
+  MovieScene->Modify();
+
+  // Tracks/sections are resolved once per property and reused across all
+  // channels that target them.
+  UMovieScene3DTransformSection *TransformSection = nullptr;
+  TMap<FString, UMovieSceneSection *> PropertySections;
+  TSet<UMovieSceneSection *> ModifiedSections;
+
+  auto GetTransformSection = [&]() -> UMovieScene3DTransformSection * {
+    if (TransformSection)
+      return TransformSection;
+    UMovieScene3DTransformTrack *Track =
+        MovieScene->FindTrack<UMovieScene3DTransformTrack>(
+            BindingGuid, FName("Transform"));
+    if (!Track)
+      Track = MovieScene->AddTrack<UMovieScene3DTransformTrack>(BindingGuid);
+    if (!Track)
+      return nullptr;
+    bool bSectionAdded = false;
+    TransformSection = Cast<UMovieScene3DTransformSection>(
+        Track->FindOrAddSection(0, bSectionAdded));
+    return TransformSection;
+  };
+
+  auto GetPropertySection = [&](const FString &PropertyName,
+                                bool bBool) -> UMovieSceneSection * {
+    const FString Key = (bBool ? TEXT("b:") : TEXT("f:")) + PropertyName;
+    if (UMovieSceneSection **Found = PropertySections.Find(Key))
+      return *Found;
+    UMovieSceneSection *Section = nullptr;
+    bool bSectionAdded = false;
+    if (bBool) {
+      UMovieSceneBoolTrack *Track = MovieScene->FindTrack<UMovieSceneBoolTrack>(
+          BindingGuid, FName(*PropertyName));
+      if (!Track) {
+        Track = MovieScene->AddTrack<UMovieSceneBoolTrack>(BindingGuid);
+        if (Track)
+          Track->SetPropertyNameAndPath(FName(*PropertyName), PropertyName);
+      }
+      if (Track)
+        Section = Track->FindOrAddSection(0, bSectionAdded);
+    } else {
+      UMovieSceneFloatTrack *Track =
+          MovieScene->FindTrack<UMovieSceneFloatTrack>(BindingGuid,
+                                                       FName(*PropertyName));
+      if (!Track) {
+        Track = MovieScene->AddTrack<UMovieSceneFloatTrack>(BindingGuid);
+        if (Track)
+          Track->SetPropertyNameAndPath(FName(*PropertyName), PropertyName);
+      }
+      if (Track)
+        Section = Track->FindOrAddSection(0, bSectionAdded);
+    }
+    PropertySections.Add(Key, Section);
+    return Section;
+  };
+
+  auto MarkSectionModified = [&](UMovieSceneSection *Section) {
+    if (Section && !ModifiedSections.Contains(Section)) {
+      Section->Modify();
+      ModifiedSections.Add(Section);
+    }
+  };
+
+  TArray<TSharedPtr<FJsonValue>> ChannelResults;
+  int32 TotalInputSamples = 0;
+  int32 TotalKeysWritten = 0;
+  int32 FailedChannels = 0;
+
+  for (const TSharedPtr<FJsonValue> &ChannelVal : *ChannelsArray) {
+    const TSharedPtr<FJsonObject> ChannelObj =
+        ChannelVal.IsValid() ? ChannelVal->AsObject() : nullptr;
+    TSharedPtr<FJsonObject> ChannelResult = MakeShared<FJsonObject>();
+    ChannelResults.Add(MakeShared<FJsonValueObject>(ChannelResult));
+    if (!ChannelObj.IsValid()) {
+      ChannelResult->SetBoolField(TEXT("success"), false);
+      ChannelResult->SetStringField(TEXT("error"), TEXT("INVALID_CHANNEL"));
+      ++FailedChannels;
+      continue;
+    }
+
+    const FString PropertyName =
+        GetJsonStringField(ChannelObj, TEXT("property"));
+    const FString ChannelName = GetJsonStringField(ChannelObj, TEXT("channel"));
+    ChannelResult->SetStringField(TEXT("property"), PropertyName);
+    if (!ChannelName.IsEmpty())
+      ChannelResult->SetStringField(TEXT("channel"), ChannelName);
+
+    const TArray<TSharedPtr<FJsonValue>> *FramesArr = nullptr;
+    const TArray<TSharedPtr<FJsonValue>> *ValuesArr = nullptr;
+    if (PropertyName.IsEmpty() ||
+        !ChannelObj->TryGetArrayField(TEXT("frames"), FramesArr) ||
+        !ChannelObj->TryGetArrayField(TEXT("values"), ValuesArr) ||
+        FramesArr->Num() != ValuesArr->Num() || FramesArr->Num() == 0) {
+      ChannelResult->SetBoolField(TEXT("success"), false);
+      ChannelResult->SetStringField(
+          TEXT("error"),
+          TEXT("property, frames and values (same length) are required"));
+      ++FailedChannels;
+      continue;
+    }
+
+    const bool bBoolChannel = (*ValuesArr)[0]->Type == EJson::Boolean;
+    TotalInputSamples += FramesArr->Num();
+
+    // Sort samples by frame so unordered client input still produces a
+    // valid channel.
+    TArray<int32> Order;
+    Order.Reserve(FramesArr->Num());
+    for (int32 i = 0; i < FramesArr->Num(); ++i)
+      Order.Add(i);
+    Order.StableSort([FramesArr](int32 A, int32 B) {
+      return (*FramesArr)[A]->AsNumber() < (*FramesArr)[B]->AsNumber();
+    });
+
+    if (bBoolChannel) {
+      UMovieSceneBoolSection *Section = Cast<UMovieSceneBoolSection>(
+          GetPropertySection(PropertyName, true));
+      FMovieSceneBoolChannel *Channel =
+          Section ? Section->GetChannelProxy().GetChannel<FMovieSceneBoolChannel>(0)
+                  : nullptr;
+      if (!Channel) {
+        ChannelResult->SetBoolField(TEXT("success"), false);
+        ChannelResult->SetStringField(TEXT("error"), TEXT("TRACK_UNAVAILABLE"));
+        ++FailedChannels;
+        continue;
+      }
+
+      // Step curves only need a key where the value changes.
+      TArray<FFrameNumber> Times;
+      TArray<bool> Values;
+      for (int32 Idx : Order) {
+        const bool bValue = (*ValuesArr)[Idx]->AsBool();
+        const FFrameNumber Tick = ToTickFrame((*FramesArr)[Idx]->AsNumber());
+        if (Times.Num() > 0 && Times.Last() == Tick) {
+          Values.Last() = bValue;
+          continue;
+        }
+        if (bReduce && Values.Num() > 0 && Values.Last() == bValue)
+          continue;
+        Times.Add(Tick);
+        Values.Add(bValue);
+      }
+
+      MarkSectionModified(Section);
+      McpMergeChannelKeys(Channel, Times, Values, bReplaceRange);
+      TotalKeysWritten += Times.Num();
+      ChannelResult->SetBoolField(TEXT("success"), true);
+      ChannelResult->SetNumberField(TEXT("inputSamples"), FramesArr->Num());
+      ChannelResult->SetNumberField(TEXT("keysWritten"), Times.Num());
+      continue;
+    }
+
+    FMcpSampledCurve Curve;
+    Curve.Frames.Reserve(Order.Num());
+    Curve.Values.Reserve(Order.Num());
+    for (int32 Idx : Order) {
+      const double Frame = (*FramesArr)[Idx]->AsNumber();
+      const double Value = (*ValuesArr)[Idx]->AsNumber();
+      if (Curve.Frames.Num() > 0 &&
+          FMath::IsNearlyEqual(Curve.Frames.Last(), Frame)) {
+        Curve.Values.Last() = Value;
+        continue;
+      }
+      Curve.Frames.Add(Frame);
+      Curve.Values.Add(Value);
+    }
+    Curve.ComputeSlopes();
+
+    TArray<int32> Kept;
+    Curve.Reduce(bReduce ? Tolerance : 0.0, bCubic, Kept);
+
+    TArray<FFrameNumber> Times;
+    Times.Reserve(Kept.Num());
+    for (int32 Idx : Kept)
+      Times.Add(ToTickFrame(Curve.Frames[Idx]));
+
+    auto FillKey = [&](auto &Key, int32 SampleIdx) {
+      if (bConstant) {
+        Key.InterpMode = RCIM_Constant;
+      } else if (bCubic) {
+        Key.InterpMode = RCIM_Cubic;
+        Key.TangentMode = RCTM_User;
+        const float Tangent =
+            static_cast<float>(Curve.Slopes[SampleIdx] / TicksPerDisplayFrame);
+        Key.Tangent.ArriveTangent = Tangent;
+        Key.Tangent.LeaveTangent = Tangent;
+      } else {
+        Key.InterpMode = RCIM_Linear;
+      }
+    };
+
+    bool bWritten = false;
+    if (PropertyName.Equals(TEXT("Transform"), ESearchCase::IgnoreCase)) {
+      const int32 ChannelIndex = McpTransformChannelIndex(ChannelName);
+      UMovieScene3DTransformSection *Section =
+          ChannelIndex != INDEX_NONE ? GetTransformSection() : nullptr;
+      if (Section) {
+        TArrayView<FMovieSceneDoubleChannel *> Channels =
+            Section->GetChannelProxy().GetChannels<FMovieSceneDoubleChannel>();
+        if (Channels.IsValidIndex(ChannelIndex)) {
+          TArray<FMovieSceneDoubleValue> Values;
+          Values.Reserve(Kept.Num());
+          for (int32 Idx : Kept) {
+            FMovieSceneDoubleValue Key(Curve.Values[Idx]);
+            FillKey(Key, Idx);
+            Values.Add(Key);
+          }
+          MarkSectionModified(Section);
+          McpMergeChannelKeys(Channels[ChannelIndex], Times, Values,
+                              bReplaceRange);
+          bWritten = true;
+        }
+      }
+    } else {
+      UMovieSceneFloatSection *Section = Cast<UMovieSceneFloatSection>(
+          GetPropertySection(PropertyName, false));
+      FMovieSceneFloatChannel *Channel =
+          Section
+              ? Section->GetChannelProxy().GetChannel<FMovieSceneFloatChannel>(0)
+              : nullptr;
+      if (Channel) {
+        TArray<FMovieSceneFloatValue> Values;
+        Values.Reserve(Kept.Num());
+        for (int32 Idx : Kept) {
+          FMovieSceneFloatValue Key(static_cast<float>(Curve.Values[Idx]));
+          FillKey(Key, Idx);
+          Values.Add(Key);
+        }
+        MarkSectionModified(Section);
+        McpMergeChannelKeys(Channel, Times, Values, bReplaceRange);
+        bWritten = true;
+      }
+    }
+
+    if (!bWritten) {
+      ChannelResult->SetBoolField(TEXT("success"), false);
+      ChannelResult->SetStringField(
+          TEXT("error"), PropertyName.Equals(TEXT("Transform"),
+                                             ESearchCase::IgnoreCase)
+                             ? TEXT("INVALID_TRANSFORM_CHANNEL")
+                             : TEXT("TRACK_UNAVAILABLE"));
+      ++FailedChannels;
+      continue;
+    }
+
+    TotalKeysWritten += Times.Num();
+    ChannelResult->SetBoolField(TEXT("success"), true);
+    ChannelResult->SetNumberField(TEXT("inputSamples"), FramesArr->Num());
+    ChannelResult->SetNumberField(TEXT("keysWritten"), Times.Num());
+  }
+
+  // Expand sections so every written key is inside the section range.
+  for (UMovieSceneSection *Section : ModifiedSections) {
+    TRange<FFrameNumber> KeyRange = TRange<FFrameNumber>::Empty();
+    for (const FMovieSceneChannelEntry &Entry :
+         Section->GetChannelProxy().GetAllEntries()) {
+      for (FMovieSceneChannel *Channel : Entry.GetChannels()) {
+        if (Channel) {
+          KeyRange = TRange<FFrameNumber>::Hull(KeyRange,
+                                                Channel->ComputeEffectiveRange());
+        }
+      }
+    }
+    if (!KeyRange.IsEmpty() && Section->HasStartFrame() &&
+        Section->HasEndFrame()) {
+      Section->SetRange(TRange<FFrameNumber>::Hull(Section->GetRange(), KeyRange));
+    }
+  }
+
+  TSharedPtr<FJsonObject> Resp = MakeShared<FJsonObject>();
+  Resp->SetStringField(TEXT("sequencePath"), SeqPath);
+  Resp->SetStringField(TEXT("bindingId"), BindingGuid.ToString());
+  Resp->SetNumberField(TEXT("inputSamples"), TotalInputSamples);
+  Resp->SetNumberField(TEXT("keysWritten"), TotalKeysWritten);
+  Resp->SetNumberField(TEXT("reductionRatio"),
+                       TotalInputSamples > 0
+                           ? static_cast<double>(TotalKeysWritten) /
+                                 TotalInputSamples
+                           : 1.0);
+  Resp->SetBoolField(TEXT("reduced"), bReduce);
+  Resp->SetNumberField(TEXT("tolerance"), Tolerance);
+  Resp->SetArrayField(TEXT("channels"), ChannelResults);
+
+  const bool bAnyWritten = FailedChannels < ChannelsArray->Num();
+  SendAutomationResponse(
+      Socket, RequestId, bAnyWritten,
+      bAnyWritten
+          ? FString::Printf(TEXT("Wrote %d keys from %d samples"),
+                            TotalKeysWritten, TotalInputSamples)
+          : FString(TEXT("No channels could be written")),
+      Resp, bAnyWritten ? FString() : TEXT("UNSUPPORTED_PROPERTY"));
+  return true;
+#else
+  SendAutomationResponse(Socket, RequestId, false,
+                         TEXT("sequence_add_keyframes requires editor build."),
+                         nullptr, TEXT("NOT_IMPLEMENTED"));
+  return true;
+#endif
+}
+
 bool UMcpAutomationBridgeSubsystem::HandleSequenceAddSection(
     const FString &RequestId, const TSharedPtr<FJsonObject> &Payload,
     TSharedPtr<FMcpBridgeWebSocket> Socket) {
@@ -2406,6 +3007,10 @@ bool UMcpAutomationBridgeSubsystem::HandleSequenceAction(
     return HandleSequenceGetMetadata(RequestId, LocalPayload, RequestingSocket);
   if (EffectiveAction == TEXT("sequence_add_keyframe"))
     return HandleSequenceAddKeyframe(RequestId, LocalPayload, RequestingSocket);
+  if (EffectiveAction == TEXT("sequence_add_keyframes") ||
+      EffectiveAction == TEXT("sequence_bake_keyframes"))
+    return HandleSequenceAddKeyframes(RequestId, LocalPayload,
+                                      RequestingSocket);
 
   // New handlers
   if (EffectiveAction == TEXT("sequence_add_section"))
@@ -2444,12 +3049,13 @@ bool UMcpAutomationBridgeSubsystem::HandleSequenceAction(
     AddedNames.Add(TEXT("audio"));
     AddedNames.Add(TEXT("event"));
 
-    for (TObjectIterator<UClass> It; It; ++It) {
-      if (It->IsChildOf(UMovieSceneTrack::StaticClass()) &&
-          !It->HasAnyClassFlags(CLASS_Abstract) &&
-          !AddedNames.Contains(It->GetName())) {
-        Types.Add(MakeShared<FJsonValueString>(It->GetName()));
-        AddedNames.Add(It->GetName());
+    TArray<UClass *> TrackClasses;
+    FMcpReflectionIndex::GetDerivedClasses(UMovieSceneTrack::StaticClass(),
+                                           TrackClasses);
+    for (UClass *TrackClass : TrackClasses) {
+      if (!AddedNames.Contains(TrackClass->GetName())) {
+        Types.Add(MakeShared<FJsonValueString>(TrackClass->GetName()));
+        AddedNames.Add(TrackClass->GetName());
       }
     }
 
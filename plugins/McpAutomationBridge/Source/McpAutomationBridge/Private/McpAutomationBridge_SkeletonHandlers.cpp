@@ -9,6 +9,7 @@
 #include "McpAutomationBridgeGlobals.h"
 #include "McpAutomationBridgeHelpers.h"
 #include "McpAutomationBridgeSubsystem.h"
+#include "McpResponseStream.h"
 
 #if WITH_EDITOR
 
@@ -39,6 +40,17 @@
 #include "Modules/ModuleManager.h"
 #include "UObject/Package.h"
 #include "UObject/SavePackage.h"
+#include "Async/ParallelFor.h"
+
+// Skeletal mesh description (UE 5.1+) - source of truth for skin weight edits
+#if __has_include("SkeletalMeshAttributes.h") && __has_include("BoneWeights.h")
+#include "MeshDescription.h"
+#include "SkeletalMeshAttributes.h"
+#include "BoneWeights.h"
+#define MCP_HAS_SKELETAL_MESH_DESCRIPTION 1
+#else
+#define MCP_HAS_SKELETAL_MESH_DESCRIPTION 0
+#endif
 
 // Helper macros for JSON field access
 #define GetStringFieldSkel GetJsonStringField
@@ -217,6 +229,702 @@ static FRotator ParseRotatorFromJson(const TSharedPtr<FJsonObject>& JsonObj, con
     return Default;
 }
 
+#if MCP_HAS_SKELETAL_MESH_DESCRIPTION
+
+/** Sparse per-vertex skin weights: (reference skeleton bone index, weight). */
+using FMcpSkinWeightList = TArray<TPair<int32, float>, TInlineAllocator<MAX_TOTAL_INFLUENCES>>;
+
+/**
+ * Helper: Add Weight for Bone into a sparse weight list, merging duplicates
+ */
+static void McpAccumulateSkinWeight(FMcpSkinWeightList& Weights, int32 Bone, float Weight)
+{
+    for (TPair<int32, float>& Entry : Weights)
+    {
+        if (Entry.Key == Bone)
+        {
+            Entry.Value += Weight;
+            return;
+        }
+    }
+    Weights.Emplace(Bone, Weight);
+}
+
+/**
+ * Helper: Keep the strongest MaxInfluences weights, drop those below MinWeight and renormalize to 1
+ */
+static void McpNormalizeSkinWeights(FMcpSkinWeightList& Weights, int32 MaxInfluences, float MinWeight)
+{
+    Weights.Sort([](const TPair<int32, float>& A, const TPair<int32, float>& B) { return A.Value > B.Value; });
+    while (Weights.Num() > MaxInfluences)
+    {
+        Weights.Pop();
+    }
+    // Always keep the dominant influence so no vertex ends up unweighted
+    for (int32 Index = Weights.Num() - 1; Index > 0; --Index)
+    {
+        if (Weights[Index].Value < MinWeight)
+        {
+            Weights.RemoveAt(Index);
+        }
+    }
+
+    float Total = 0.0f;
+    for (const TPair<int32, float>& Entry : Weights)
+    {
+        Total += FMath::Max(Entry.Value, 0.0f);
+    }
+    if (Total <= KINDA_SMALL_NUMBER)
+    {
+        Weights.Reset();
+        return;
+    }
+    for (TPair<int32, float>& Entry : Weights)
+    {
+        Entry.Value = FMath::Max(Entry.Value, 0.0f) / Total;
+    }
+}
+
+/**
+ * Dense copy of one skeletal mesh description LOD used by the weight solvers.
+ * Vertex IDs in a mesh description may be sparse, so everything is re-indexed 0..N-1.
+ */
+struct FMcpSkinMeshData
+{
+    TArray<FVertexID> VertexIds;
+    TArray<FVector3f> Positions;
+    TArray<FIntVector> Triangles;
+    TArray<FMcpSkinWeightList> Weights;
+    TArray<TArray<int32, TInlineAllocator<8>>> Neighbors;
+};
+
+/**
+ * Helper: Read positions, triangles and optionally base skin weights / one-ring adjacency
+ */
+static void McpReadSkinMeshData(const FMeshDescription& MeshDesc, bool bReadWeights, bool bBuildAdjacency, FMcpSkinMeshData& Out)
+{
+    FSkeletalMeshConstAttributes Attributes(MeshDesc);
+    TVertexAttributesConstRef<FVector3f> VertexPositions = Attributes.GetVertexPositions();
+
+    TArray<int32> DenseIndex;
+    DenseIndex.Init(INDEX_NONE, MeshDesc.Vertices().GetArraySize());
+    Out.VertexIds.Reserve(MeshDesc.Vertices().Num());
+    Out.Positions.Reserve(MeshDesc.Vertices().Num());
+    for (const FVertexID VertexID : MeshDesc.Vertices().GetElementIDs())
+    {
+        DenseIndex[VertexID.GetValue()] = Out.VertexIds.Add(VertexID);
+        Out.Positions.Add(VertexPositions[VertexID]);
+    }
+
+    Out.Triangles.Reserve(MeshDesc.Triangles().Num());
+    for (const FTriangleID TriangleID : MeshDesc.Triangles().GetElementIDs())
+    {
+        TArrayView<const FVertexID> TriVerts = MeshDesc.GetTriangleVertices(TriangleID);
+        Out.Triangles.Add(FIntVector(
+            DenseIndex[TriVerts[0].GetValue()],
+            DenseIndex[TriVerts[1].GetValue()],
+            DenseIndex[TriVerts[2].GetValue()]));
+    }
+
+    if (bReadWeights)
+    {
+        FSkinWeightsVertexAttributesConstRef SkinWeights = Attributes.GetVertexSkinWeights();
+        Out.Weights.SetNum(Out.VertexIds.Num());
+        for (int32 Index = 0; Index < Out.VertexIds.Num(); ++Index)
+        {
+            FVertexBoneWeightsConst BoneWeights = SkinWeights.Get(Out.VertexIds[Index]);
+            for (int32 Influence = 0; Influence < BoneWeights.Num(); ++Influence)
+            {
+                Out.Weights[Index].Emplace(BoneWeights[Influence].GetBoneIndex(), BoneWeights[Influence].GetWeight());
+            }
+        }
+    }
+
+    if (bBuildAdjacency)
+    {
+        Out.Neighbors.SetNum(Out.VertexIds.Num());
+        for (const FIntVector& Tri : Out.Triangles)
+        {
+            for (int32 Corner = 0; Corner < 3; ++Corner)
+            {
+                const int32 A = Tri[Corner];
+                const int32 B = Tri[(Corner + 1) % 3];
+                Out.Neighbors[A].AddUnique(B);
+                Out.Neighbors[B].AddUnique(A);
+            }
+        }
+    }
+}
+
+/**
+ * Helper: Write sparse weights into the base weights (NAME_None) or a named skin weight profile
+ */
+static void McpWriteSkinWeights(FMeshDescription& MeshDesc, FName ProfileName, const TArray<FVertexID>& VertexIds, const TArray<FMcpSkinWeightList>& Weights)
+{
+    FSkeletalMeshAttributes Attributes(MeshDesc);
+    if (!ProfileName.IsNone() && !Attributes.GetSkinWeightProfileNames().Contains(ProfileName))
+    {
+        Attributes.RegisterSkinWeightAttribute(ProfileName);
+    }
+
+    FSkinWeightsVertexAttributesRef SkinWeights = Attributes.GetVertexSkinWeights(ProfileName);
+    TArray<UE::AnimationCore::FBoneWeight> BoneWeights;
+    for (int32 Index = 0; Index < VertexIds.Num(); ++Index)
+    {
+        BoneWeights.Reset();
+        for (const TPair<int32, float>& Entry : Weights[Index])
+        {
+            BoneWeights.Add(UE::AnimationCore::FBoneWeight(static_cast<FBoneIndexType>(Entry.Key), Entry.Value));
+        }
+        SkinWeights.Set(VertexIds[Index], BoneWeights);
+    }
+}
+
+/**
+ * Helper: Closest point on triangle ABC to P (Ericson, Real-Time Collision Detection 5.1.5).
+ * OutBary receives the barycentric weights of A, B and C.
+ */
+static FVector3f McpClosestPointOnSkinTriangle(const FVector3f& P, const FVector3f& A, const FVector3f& B, const FVector3f& C, FVector3f& OutBary)
+{
+    const FVector3f AB = B - A;
+    const FVector3f AC = C - A;
+    const FVector3f AP = P - A;
+    const float D1 = AB | AP;
+    const float D2 = AC | AP;
+    if (D1 <= 0.0f && D2 <= 0.0f)
+    {
+        OutBary = FVector3f(1.0f, 0.0f, 0.0f);
+        return A;
+    }
+
+    const FVector3f BP = P - B;
+    const float D3 = AB | BP;
+    const float D4 = AC | BP;
+    if (D3 >= 0.0f && D4 <= D3)
+    {
+        OutBary = FVector3f(0.0f, 1.0f, 0.0f);
+        return B;
+    }
+
+    const float VC = D1 * D4 - D3 * D2;
+    if (VC <= 0.0f && D1 >= 0.0f && D3 <= 0.0f)
+    {
+        const float V = D1 / (D1 - D3);
+        OutBary = FVector3f(1.0f - V, V, 0.0f);
+        return A + AB * V;
+    }
+
+    const FVector3f CP = P - C;
+    const float D5 = AB | CP;
+    const float D6 = AC | CP;
+    if (D6 >= 0.0f && D5 <= D6)
+    {
+        OutBary = FVector3f(0.0f, 0.0f, 1.0f);
+        return C;
+    }
+
+    const float VB = D5 * D2 - D1 * D6;
+    if (VB <= 0.0f && D2 >= 0.0f && D6 <= 0.0f)
+    {
+        const float W = D2 / (D2 - D6);
+        OutBary = FVector3f(1.0f - W, 0.0f, W);
+        return A + AC * W;
+    }
+
+    const float VA = D3 * D6 - D5 * D4;
+    if (VA <= 0.0f && (D4 - D3) >= 0.0f && (D5 - D6) >= 0.0f)
+    {
+        const float W = (D4 - D3) / ((D4 - D3) + (D5 - D6));
+        OutBary = FVector3f(0.0f, 1.0f - W, W);
+        return B + (C - B) * W;
+    }
+
+    const float Sum = VA + VB + VC;
+    if (Sum <= SMALL_NUMBER)
+    {
+        // Degenerate triangle
+        OutBary = FVector3f(1.0f, 0.0f, 0.0f);
+        return A;
+    }
+    const float V = VB / Sum;
+    const float W = VC / Sum;
+    OutBary = FVector3f(1.0f - V - W, V, W);
+    return A + AB * V + AC * W;
+}
+
+/**
+ * Median-split AABB tree over mesh triangles for closest-point queries.
+ * Read-only after Build(), so FindClosest() is safe to call from ParallelFor.
+ */
+struct FMcpSkinTriangleBVH
+{
+    static constexpr int32 LeafSize = 4;
+
+    struct FNode
+    {
+        FBox3f Bounds = FBox3f(ForceInit);
+        int32 Left = INDEX_NONE;
+        int32 Right = INDEX_NONE;
+        int32 First = 0;
+        int32 Count = 0;
+    };
+
+    const TArray<FVector3f>* Positions = nullptr;
+    const TArray<FIntVector>* Triangles = nullptr;
+    TArray<FNode> Nodes;
+    TArray<int32> TriangleOrder;
+
+    void Build(const TArray<FVector3f>& InPositions, const TArray<FIntVector>& InTriangles)
+    {
+        Positions = &InPositions;
+        Triangles = &InTriangles;
+        Nodes.Reset();
+        TriangleOrder.SetNum(InTriangles.Num());
+
+        TArray<FVector3f> Centroids;
+        Centroids.SetNum(InTriangles.Num());
+        for (int32 Tri = 0; Tri < InTriangles.Num(); ++Tri)
+        {
+            TriangleOrder[Tri] = Tri;
+            const FIntVector& T = InTriangles[Tri];
+            Centroids[Tri] = (InPositions[T.X] + InPositions[T.Y] + InPositions[T.Z]) / 3.0f;
+        }
+
+        if (InTriangles.Num() > 0)
+        {
+            Nodes.Reserve(2 * (InTriangles.Num() / LeafSize + 1));
+            BuildNode(Centroids, 0, InTriangles.Num());
+        }
+    }
+
+    int32 BuildNode(const TArray<FVector3f>& Centroids, int32 First, int32 Count)
+    {
+        const int32 NodeIndex = Nodes.AddDefaulted();
+        FBox3f Bounds(ForceInit);
+        FBox3f CentroidBounds(ForceInit);
+        for (int32 Index = First; Index < First + Count; ++Index)
+        {
+            const FIntVector& T = (*Triangles)[TriangleOrder[Index]];
+            Bounds += (*Positions)[T.X];
+            Bounds += (*Positions)[T.Y];
+            Bounds += (*Positions)[T.Z];
+            CentroidBounds += Centroids[TriangleOrder[Index]];
+        }
+        Nodes[NodeIndex].Bounds = Bounds;
+
+        if (Count <= LeafSize)
+        {
+            Nodes[NodeIndex].First = First;
+            Nodes[NodeIndex].Count = Count;
+            return NodeIndex;
+        }
+
+        const FVector3f Extent = CentroidBounds.GetExtent();
+        const int32 Axis = (Extent.X >= Extent.Y && Extent.X >= Extent.Z) ? 0 : (Extent.Y >= Extent.Z ? 1 : 2);
+        MakeArrayView(TriangleOrder.GetData() + First, Count).Sort([&Centroids, Axis](int32 A, int32 B)
+        {
+            return Centroids[A][Axis] < Centroids[B][Axis];
+        });
+
+        const int32 Half = Count / 2;
+        const int32 Left = BuildNode(Centroids, First, Half);
+        const int32 Right = BuildNode(Centroids, First + Half, Count - Half);
+        // Nodes may have reallocated during recursion - index again rather than holding a reference
+        Nodes[NodeIndex].Left = Left;
+        Nodes[NodeIndex].Right = Right;
+        return NodeIndex;
+    }
+
+    /** Find the closest surface point within sqrt(MaxDistSq). Returns false when nothing is in range. */
+    bool FindClosest(const FVector3f& Point, float MaxDistSq, int32& OutTriangle, FVector3f& OutBary, float& OutDistSq) const
+    {
+        OutTriangle = INDEX_NONE;
+        OutDistSq = MaxDistSq;
+        if (Nodes.Num() == 0)
+        {
+            return false;
+        }
+
+        int32 Stack[64];
+        int32 StackSize = 0;
+        Stack[StackSize++] = 0;
+        while (StackSize > 0)
+        {
+            const FNode& Node = Nodes[Stack[--StackSize]];
+            if (Node.Bounds.ComputeSquaredDistanceToPoint(Point) >= OutDistSq)
+            {
+                continue;
+            }
+
+            if (Node.Left == INDEX_NONE)
+            {
+                for (int32 Index = Node.First; Index < Node.First + Node.Count; ++Index)
+                {
+                    const int32 Tri = TriangleOrder[Index];
+                    const FIntVector& T = (*Triangles)[Tri];
+                    FVector3f Bary;
+                    const FVector3f Closest = McpClosestPointOnSkinTriangle(
+                        Point, (*Positions)[T.X], (*Positions)[T.Y], (*Positions)[T.Z], Bary);
+                    const float DistSq = FVector3f::DistSquared(Point, Closest);
+                    if (DistSq < OutDistSq)
+                    {
+                        OutDistSq = DistSq;
+                        OutTriangle = Tri;
+                        OutBary = Bary;
+                    }
+                }
+                continue;
+            }
+
+            // Push the farther child first so the nearer one is visited next and tightens the bound
+            const float LeftDistSq = Nodes[Node.Left].Bounds.ComputeSquaredDistanceToPoint(Point);
+            const float RightDistSq = Nodes[Node.Right].Bounds.ComputeSquaredDistanceToPoint(Point);
+            if (LeftDistSq < RightDistSq)
+            {
+                Stack[StackSize++] = Node.Right;
+                Stack[StackSize++] = Node.Left;
+            }
+            else
+            {
+                Stack[StackSize++] = Node.Left;
+                Stack[StackSize++] = Node.Right;
+            }
+        }
+        return OutTriangle != INDEX_NONE;
+    }
+};
+
+/**
+ * Helper: Give unweighted vertices the average of their weighted neighbours, growing inwards
+ * from the weighted region one ring per wave. Returns the number of vertices filled.
+ */
+static int32 McpFillMissingSkinWeights(TArray<FMcpSkinWeightList>& Weights, const FMcpSkinMeshData& Mesh, int32 MaxInfluences)
+{
+    int32 Filled = 0;
+    TArray<int32> Frontier;
+    TArray<FMcpSkinWeightList> FrontierWeights;
+    for (;;)
+    {
+        Frontier.Reset();
+        for (int32 Vertex = 0; Vertex < Weights.Num(); ++Vertex)
+        {
+            if (Weights[Vertex].Num() > 0)
+            {
+                continue;
+            }
+            for (int32 Neighbor : Mesh.Neighbors[Vertex])
+            {
+                if (Weights[Neighbor].Num() > 0)
+                {
+                    Frontier.Add(Vertex);
+                    break;
+                }
+            }
+        }
+        if (Frontier.Num() == 0)
+        {
+            break;
+        }
+
+        FrontierWeights.Reset();
+        FrontierWeights.SetNum(Frontier.Num());
+        ParallelFor(Frontier.Num(), [&](int32 Index)
+        {
+            FMcpSkinWeightList& Out = FrontierWeights[Index];
+            for (int32 Neighbor : Mesh.Neighbors[Frontier[Index]])
+            {
+                for (const TPair<int32, float>& Entry : Weights[Neighbor])
+                {
+                    McpAccumulateSkinWeight(Out, Entry.Key, Entry.Value);
+                }
+            }
+            McpNormalizeSkinWeights(Out, MaxInfluences, 0.0f);
+        });
+
+        for (int32 Index = 0; Index < Frontier.Num(); ++Index)
+        {
+            Weights[Frontier[Index]] = MoveTemp(FrontierWeights[Index]);
+        }
+        Filled += Frontier.Num();
+    }
+    return Filled;
+}
+
+/**
+ * Helper: Laplacian smoothing of sparse weights over the one-ring (Jacobi, double-buffered)
+ */
+static void McpSmoothSkinWeights(TArray<FMcpSkinWeightList>& Weights, const FMcpSkinMeshData& Mesh, int32 Iterations, float Strength, int32 MaxInfluences, float MinWeight)
+{
+    if (Iterations <= 0 || Strength <= 0.0f)
+    {
+        return;
+    }
+
+    TArray<FMcpSkinWeightList> Scratch;
+    Scratch.SetNum(Weights.Num());
+    for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        ParallelFor(Weights.Num(), [&](int32 Vertex)
+        {
+            FMcpSkinWeightList& Out = Scratch[Vertex];
+            Out.Reset();
+            const auto& Ring = Mesh.Neighbors[Vertex];
+            if (Ring.Num() == 0)
+            {
+                Out = Weights[Vertex];
+                return;
+            }
+
+            const float SelfWeight = 1.0f - Strength;
+            const float RingWeight = Strength / Ring.Num();
+            for (const TPair<int32, float>& Entry : Weights[Vertex])
+            {
+                McpAccumulateSkinWeight(Out, Entry.Key, Entry.Value * SelfWeight);
+            }
+            for (int32 Neighbor : Ring)
+            {
+                for (const TPair<int32, float>& Entry : Weights[Neighbor])
+                {
+                    McpAccumulateSkinWeight(Out, Entry.Key, Entry.Value * RingWeight);
+                }
+            }
+            McpNormalizeSkinWeights(Out, MaxInfluences, MinWeight);
+        });
+        Swap(Weights, Scratch);
+    }
+}
+
+/** A bone segment in reference pose component space, owned by the bone that drives it. */
+struct FMcpSkinBoneSegment
+{
+    int32 Bone = INDEX_NONE;
+    FVector3f Start = FVector3f::ZeroVector;
+    FVector3f End = FVector3f::ZeroVector;
+};
+
+/**
+ * Helper: Build parent->child segments (and points for leaf bones) from the reference pose
+ */
+static void McpBuildSkinBoneSegments(const FReferenceSkeleton& RefSkeleton, const TArray<bool>& ExcludedBones, TArray<FMcpSkinBoneSegment>& OutSegments)
+{
+    const TArray<FTransform>& LocalPose = RefSkeleton.GetRefBonePose();
+    const int32 NumBones = RefSkeleton.GetNum();
+
+    // Bones are stored parent-first, so one forward pass yields component space
+    TArray<FTransform> ComponentPose;
+    ComponentPose.SetNum(NumBones);
+    TArray<bool> HasChild;
+    HasChild.Init(false, NumBones);
+    for (int32 Bone = 0; Bone < NumBones; ++Bone)
+    {
+        const int32 Parent = RefSkeleton.GetParentIndex(Bone);
+        ComponentPose[Bone] = Parent == INDEX_NONE ? LocalPose[Bone] : LocalPose[Bone] * ComponentPose[Parent];
+        if (Parent != INDEX_NONE)
+        {
+            HasChild[Parent] = true;
+            if (!ExcludedBones[Parent])
+            {
+                FMcpSkinBoneSegment& Segment = OutSegments.AddDefaulted_GetRef();
+                Segment.Bone = Parent;
+                Segment.Start = FVector3f(ComponentPose[Parent].GetLocation());
+                Segment.End = FVector3f(ComponentPose[Bone].GetLocation());
+            }
+        }
+    }
+
+    for (int32 Bone = 0; Bone < NumBones; ++Bone)
+    {
+        if (!HasChild[Bone] && !ExcludedBones[Bone])
+        {
+            FMcpSkinBoneSegment& Segment = OutSegments.AddDefaulted_GetRef();
+            Segment.Bone = Bone;
+            Segment.Start = FVector3f(ComponentPose[Bone].GetLocation());
+            Segment.End = Segment.Start;
+        }
+    }
+}
+
+/**
+ * Helper: Squared distance from P to segment AB
+ */
+static float McpPointSkinSegmentDistSq(const FVector3f& P, const FVector3f& A, const FVector3f& B)
+{
+    const FVector3f AB = B - A;
+    const float LengthSq = AB.SizeSquared();
+    const float T = LengthSq > KINDA_SMALL_NUMBER ? FMath::Clamp(((P - A) | AB) / LengthSq, 0.0f, 1.0f) : 0.0f;
+    return FVector3f::DistSquared(P, A + AB * T);
+}
+
+/**
+ * Helper: Bone-heat style automatic weights (Baran & Popovic 2007) on the CPU.
+ *
+ * Solves (D - A + H) w_b = H p_b per bone with Gauss-Seidel over the uniform graph Laplacian, where
+ * H is a per-vertex heat term falling off with the squared distance to the nearest bone and p_b marks
+ * vertices whose nearest bone is b. Each vertex only carries its CandidateCount nearest bones, so every
+ * bone's system is small and bones are solved in parallel on disjoint slots. No visibility test is
+ * performed, so bones passing through unrelated geometry can still bleed weight into it.
+ */
+static void McpSolveBoneHeatWeights(
+    const FMcpSkinMeshData& Mesh,
+    const TArray<FMcpSkinBoneSegment>& Segments,
+    int32 NumBones,
+    int32 CandidateCount,
+    int32 Iterations,
+    float HeatScale,
+    int32 MaxInfluences,
+    float MinWeight,
+    TArray<FMcpSkinWeightList>& OutWeights)
+{
+    const int32 NumVertices = Mesh.Positions.Num();
+    OutWeights.Reset();
+    OutWeights.SetNum(NumVertices);
+    if (NumVertices == 0 || Segments.Num() == 0)
+    {
+        return;
+    }
+
+    // Mean edge length makes the heat term scale-independent against the unit-weight Laplacian
+    double EdgeLengthSum = 0.0;
+    int32 EdgeCount = 0;
+    for (int32 Vertex = 0; Vertex < NumVertices; ++Vertex)
+    {
+        for (int32 Neighbor : Mesh.Neighbors[Vertex])
+        {
+            EdgeLengthSum += FVector3f::Dist(Mesh.Positions[Vertex], Mesh.Positions[Neighbor]);
+            ++EdgeCount;
+        }
+    }
+    const float MeanEdge = EdgeCount > 0 ? static_cast<float>(EdgeLengthSum / EdgeCount) : 1.0f;
+    const float MinDistSq = FMath::Square(0.1f * MeanEdge);
+
+    // Candidate bones per vertex: CandidateCount nearest by segment distance. Slot 0 is the nearest.
+    TArray<int32> CandidateBones;
+    TArray<float> CandidateWeights;
+    TArray<float> Heat;
+    CandidateBones.Init(INDEX_NONE, NumVertices * CandidateCount);
+    CandidateWeights.Init(0.0f, NumVertices * CandidateCount);
+    Heat.SetNumZeroed(NumVertices);
+
+    ParallelFor(NumVertices, [&](int32 Vertex)
+    {
+        TArray<float, TInlineAllocator<256>> BoneDistSq;
+        BoneDistSq.Init(TNumericLimits<float>::Max(), NumBones);
+        for (const FMcpSkinBoneSegment& Segment : Segments)
+        {
+            BoneDistSq[Segment.Bone] = FMath::Min(BoneDistSq[Segment.Bone],
+                McpPointSkinSegmentDistSq(Mesh.Positions[Vertex], Segment.Start, Segment.End));
+        }
+
+        int32* Slots = CandidateBones.GetData() + Vertex * CandidateCount;
+        float SlotDistSq[MAX_TOTAL_INFLUENCES];
+        for (int32 Slot = 0; Slot < CandidateCount; ++Slot)
+        {
+            SlotDistSq[Slot] = TNumericLimits<float>::Max();
+        }
+        for (int32 Bone = 0; Bone < NumBones; ++Bone)
+        {
+            float DistSq = BoneDistSq[Bone];
+            if (DistSq >= SlotDistSq[CandidateCount - 1])
+            {
+                continue;
+            }
+            // Insertion into the sorted candidate slots
+            int32 Slot = CandidateCount - 1;
+            while (Slot > 0 && SlotDistSq[Slot - 1] > DistSq)
+            {
+                SlotDistSq[Slot] = SlotDistSq[Slot - 1];
+                Slots[Slot] = Slots[Slot - 1];
+                --Slot;
+            }
+            SlotDistSq[Slot] = DistSq;
+            Slots[Slot] = Bone;
+        }
+
+        if (Slots[0] != INDEX_NONE)
+        {
+            Heat[Vertex] = HeatScale * FMath::Square(MeanEdge) / FMath::Max(SlotDistSq[0], MinDistSq);
+            // Initial guess: rigid binding to the nearest bone
+            CandidateWeights[Vertex * CandidateCount] = 1.0f;
+        }
+    });
+
+    // Per-bone list of (vertex, slot) it participates in
+    TArray<TArray<TPair<int32, int32>>> BoneSlots;
+    BoneSlots.SetNum(NumBones);
+    for (int32 Vertex = 0; Vertex < NumVertices; ++Vertex)
+    {
+        for (int32 Slot = 0; Slot < CandidateCount; ++Slot)
+        {
+            const int32 Bone = CandidateBones[Vertex * CandidateCount + Slot];
+            if (Bone != INDEX_NONE)
+            {
+                BoneSlots[Bone].Emplace(Vertex, Slot);
+            }
+        }
+    }
+
+    auto FindSlot = [&CandidateBones, CandidateCount](int32 Vertex, int32 Bone) -> int32
+    {
+        const int32* Slots = CandidateBones.GetData() + Vertex * CandidateCount;
+        for (int32 Slot = 0; Slot < CandidateCount; ++Slot)
+        {
+            if (Slots[Slot] == Bone)
+            {
+                return Slot;
+            }
+        }
+        return INDEX_NONE;
+    };
+
+    // Each bone only reads and writes its own slots, so bones can be solved concurrently
+    ParallelFor(NumBones, [&](int32 Bone)
+    {
+        const TArray<TPair<int32, int32>>& Active = BoneSlots[Bone];
+        if (Active.Num() == 0)
+        {
+            return;
+        }
+
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            for (const TPair<int32, int32>& Entry : Active)
+            {
+                const int32 Vertex = Entry.Key;
+                const auto& Ring = Mesh.Neighbors[Vertex];
+                float NeighborSum = 0.0f;
+                for (int32 Neighbor : Ring)
+                {
+                    const int32 NeighborSlot = FindSlot(Neighbor, Bone);
+                    if (NeighborSlot != INDEX_NONE)
+                    {
+                        NeighborSum += CandidateWeights[Neighbor * CandidateCount + NeighborSlot];
+                    }
+                }
+                const float Target = (Entry.Value == 0) ? Heat[Vertex] : 0.0f;
+                const float Denominator = Ring.Num() + Heat[Vertex];
+                CandidateWeights[Vertex * CandidateCount + Entry.Value] =
+                    Denominator > KINDA_SMALL_NUMBER ? (Target + NeighborSum) / Denominator : (Entry.Value == 0 ? 1.0f : 0.0f);
+            }
+        }
+    });
+
+    ParallelFor(NumVertices, [&](int32 Vertex)
+    {
+        FMcpSkinWeightList& Out = OutWeights[Vertex];
+        for (int32 Slot = 0; Slot < CandidateCount; ++Slot)
+        {
+            const int32 Bone = CandidateBones[Vertex * CandidateCount + Slot];
+            if (Bone != INDEX_NONE)
+            {
+                Out.Emplace(Bone, CandidateWeights[Vertex * CandidateCount + Slot]);
+            }
+        }
+        McpNormalizeSkinWeights(Out, MaxInfluences, MinWeight);
+    });
+}
+
+#endif // MCP_HAS_SKELETAL_MESH_DESCRIPTION
+
 } // anonymous namespace
 
 
@@ -309,6 +1017,7 @@ bool UMcpAutomationBridgeSubsystem::HandleListBones(
     }
 
     const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
+    const TSharedPtr<FMcpResponseStream> Stream = BeginResponseStream(RequestId, Payload, RequestingSocket, TEXT("bones"));
     TArray<TSharedPtr<FJsonValue>> BoneArray;
 
     for (int32 i = 0; i < RefSkeleton.GetRawBoneNum(); ++i)
@@ -332,10 +1041,23 @@ bool UMcpAutomationBridgeSubsystem::HandleListBones(
         TransformObj->SetNumberField(TEXT("z"), RefPose.GetLocation().Z);
         BoneObj->SetObjectField(TEXT("location"), TransformObj);
 
-        BoneArray.Add(MakeShareable(new FJsonValueObject(BoneObj)));
+        if (!Stream.IsValid())
+        {
+            BoneArray.Add(MakeShareable(new FJsonValueObject(BoneObj)));
+        }
+        else if (!Stream->Add(BoneObj))
+        {
+            break;
+        }
     }
 
     TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject());
+    if (Stream.IsValid())
+    {
+        Result->SetNumberField(TEXT("count"), Stream->GetNumItems());
+        FinishResponseStream(Stream, RequestingSocket, RequestId, TEXT("Bones listed"), Result);
+        return true;
+    }
     Result->SetArrayField(TEXT("bones"), BoneArray);
     Result->SetNumberField(TEXT("count"), BoneArray.Num());
 
@@ -3461,9 +4183,17 @@ bool UMcpAutomationBridgeSubsystem::HandleManageSkeleton(
     }
     else if (SubAction == TEXT("auto_skin_weights"))
     {
-        // Auto skin weights computation - typically done during import
-        // We trigger a mesh rebuild which recalculates default weights
+        // Bone-heat automatic skinning against the reference pose. Writes base weights unless a
+        // profileName is given, in which case the result lands in that skin weight profile.
         FString SkeletalMeshPath = GetStringFieldSkel(Payload, TEXT("skeletalMeshPath"));
+        FString ProfileName = GetStringFieldSkel(Payload, TEXT("profileName"));
+        const int32 LODIndex = GetIntFieldSkel(Payload, TEXT("lodIndex"), 0);
+        const int32 MaxInfluences = FMath::Clamp(GetIntFieldSkel(Payload, TEXT("maxInfluences"), 4), 1, MAX_TOTAL_INFLUENCES);
+        const int32 Iterations = FMath::Clamp(GetIntFieldSkel(Payload, TEXT("iterations"), 64), 1, 4096);
+        const int32 SmoothIterations = FMath::Clamp(GetIntFieldSkel(Payload, TEXT("smoothIterations"), 0), 0, 64);
+        const float HeatScale = static_cast<float>(GetNumberFieldSkel(Payload, TEXT("heatScale"), 1.0));
+        const float MinWeight = static_cast<float>(GetNumberFieldSkel(Payload, TEXT("minWeight"), 0.01));
+        const bool bIncludeRoot = GetBoolFieldSkel(Payload, TEXT("includeRoot"), false);
         
         if (SkeletalMeshPath.IsEmpty())
         {
@@ -3479,17 +4209,88 @@ bool UMcpAutomationBridgeSubsystem::HandleManageSkeleton(
             return true;
         }
         
-        // Rebuild the mesh - this recalculates skin weights based on bone positions
+#if MCP_HAS_SKELETAL_MESH_DESCRIPTION
+        FMeshDescription* MeshDesc = Mesh->GetMeshDescription(LODIndex);
+        if (!MeshDesc)
+        {
+            SendAutomationError(RequestingSocket, RequestId, 
+                FString::Printf(TEXT("LOD %d has no mesh description"), LODIndex), TEXT("INVALID_LOD"));
+            return true;
+        }
+        
+        const double StartTime = FPlatformTime::Seconds();
+        const FReferenceSkeleton& RefSkeleton = Mesh->GetRefSkeleton();
+        const int32 NumBones = RefSkeleton.GetNum();
+        
+        TArray<bool> ExcludedBones;
+        ExcludedBones.Init(false, NumBones);
+        if (!bIncludeRoot && NumBones > 1)
+        {
+            ExcludedBones[0] = true;
+        }
+        const TArray<TSharedPtr<FJsonValue>>* ExcludeArray = nullptr;
+        if (Payload->TryGetArrayField(TEXT("excludeBones"), ExcludeArray) && ExcludeArray)
+        {
+            for (const TSharedPtr<FJsonValue>& Value : *ExcludeArray)
+            {
+                const int32 BoneIndex = RefSkeleton.FindBoneIndex(FName(*Value->AsString()));
+                if (BoneIndex != INDEX_NONE)
+                {
+                    ExcludedBones[BoneIndex] = true;
+                }
+            }
+        }
+        
+        TArray<FMcpSkinBoneSegment> Segments;
+        McpBuildSkinBoneSegments(RefSkeleton, ExcludedBones, Segments);
+        if (Segments.Num() == 0)
+        {
+            SendAutomationError(RequestingSocket, RequestId, TEXT("No bones left to bind after exclusions"), TEXT("NO_BONES"));
+            return true;
+        }
+        
+        FMcpSkinMeshData MeshData;
+        McpReadSkinMeshData(*MeshDesc, false, true, MeshData);
+        
+        const int32 CandidateCount = FMath::Clamp(
+            GetIntFieldSkel(Payload, TEXT("candidateBones"), FMath::Max(MaxInfluences, 4)), 1, FMath::Min(NumBones, (int32)MAX_TOTAL_INFLUENCES));
+        
+        TArray<FMcpSkinWeightList> Weights;
+        McpSolveBoneHeatWeights(MeshData, Segments, NumBones, CandidateCount, Iterations, HeatScale, MaxInfluences, MinWeight, Weights);
+        McpSmoothSkinWeights(Weights, MeshData, SmoothIterations, 0.5f, MaxInfluences, MinWeight);
+        
+        const FName ProfileFName = ProfileName.IsEmpty() ? NAME_None : FName(*ProfileName);
+        if (!ProfileFName.IsNone() && !Mesh->GetSkinWeightProfiles().ContainsByPredicate(
+                [&ProfileFName](const FSkinWeightProfileInfo& Info) { return Info.Name == ProfileFName; }))
+        {
+            FSkinWeightProfileInfo NewProfile;
+            NewProfile.Name = ProfileFName;
+            Mesh->AddSkinWeightProfile(NewProfile);
+        }
+        
+        Mesh->Modify();
+        McpWriteSkinWeights(*MeshDesc, ProfileFName, MeshData.VertexIds, Weights);
+        Mesh->CommitMeshDescription(LODIndex);
         Mesh->Build();
         McpSafeAssetSave(Mesh);
         
         TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject());
         Result->SetStringField(TEXT("skeletalMeshPath"), SkeletalMeshPath);
-        Result->SetBoolField(TEXT("rebuilt"), true);
+        Result->SetStringField(TEXT("target"), ProfileFName.IsNone() ? TEXT("base") : *ProfileName);
+        Result->SetNumberField(TEXT("lodIndex"), LODIndex);
+        Result->SetNumberField(TEXT("vertexCount"), MeshData.Positions.Num());
+        Result->SetNumberField(TEXT("boneSegments"), Segments.Num());
+        Result->SetNumberField(TEXT("candidateBones"), CandidateCount);
+        Result->SetNumberField(TEXT("iterations"), Iterations);
+        Result->SetNumberField(TEXT("elapsedMs"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
         
         SendAutomationResponse(RequestingSocket, RequestId, true, 
-            TEXT("Mesh rebuilt with recalculated skin weights"), Result);
+            FString::Printf(TEXT("Computed automatic skin weights for %d vertices"), MeshData.Positions.Num()), Result);
         return true;
+#else
+        SendAutomationError(RequestingSocket, RequestId, TEXT("auto_skin_weights requires skeletal mesh description support (UE 5.1+)"), TEXT("NOT_SUPPORTED"));
+        return true;
+#endif
     }
     else if (SubAction == TEXT("copy_weights"))
     {
@@ -3526,53 +4327,153 @@ bool UMcpAutomationBridgeSubsystem::HandleManageSkeleton(
             return true;
         }
         
-#if WITH_EDITORONLY_DATA
-        FSkeletalMeshModel* SourceModel = SourceMesh->GetImportedModel();
-        FSkeletalMeshModel* TargetModel = TargetMesh->GetImportedModel();
+#if WITH_EDITORONLY_DATA && MCP_HAS_SKELETAL_MESH_DESCRIPTION
+        const bool bApplyToBase = GetBoolFieldSkel(Payload, TEXT("applyToBase"), false);
+        const double MaxDistance = GetNumberFieldSkel(Payload, TEXT("maxDistance"), 0.0);
+        const int32 MaxInfluences = FMath::Clamp(GetIntFieldSkel(Payload, TEXT("maxInfluences"), 8), 1, MAX_TOTAL_INFLUENCES);
+        const int32 SmoothIterations = FMath::Clamp(GetIntFieldSkel(Payload, TEXT("smoothIterations"), 1), 0, 64);
+        const float SmoothStrength = FMath::Clamp(static_cast<float>(GetNumberFieldSkel(Payload, TEXT("smoothStrength"), 0.5)), 0.0f, 1.0f);
+        const float MinWeight = static_cast<float>(GetNumberFieldSkel(Payload, TEXT("minWeight"), 0.001));
         
-        if (!SourceModel || !TargetModel || 
-            LODIndex >= SourceModel->LODModels.Num() || 
-            LODIndex >= TargetModel->LODModels.Num())
+        FMeshDescription* SourceDesc = SourceMesh->GetMeshDescription(LODIndex);
+        FMeshDescription* TargetDesc = TargetMesh->GetMeshDescription(LODIndex);
+        if (!SourceDesc || !TargetDesc)
         {
-            SendAutomationError(RequestingSocket, RequestId, TEXT("Invalid LOD models"), TEXT("INVALID_LOD"));
+            SendAutomationError(RequestingSocket, RequestId, 
+                FString::Printf(TEXT("LOD %d has no mesh description on source or target"), LODIndex), TEXT("INVALID_LOD"));
             return true;
         }
         
-        FSkeletalMeshLODModel& SourceLOD = SourceModel->LODModels[LODIndex];
-        FSkeletalMeshLODModel& TargetLOD = TargetModel->LODModels[LODIndex];
+        const double StartTime = FPlatformTime::Seconds();
+        FMcpSkinMeshData SourceData;
+        FMcpSkinMeshData TargetData;
+        McpReadSkinMeshData(*SourceDesc, true, false, SourceData);
+        McpReadSkinMeshData(*TargetDesc, false, true, TargetData);
         
-        // Create skin weight profile on target
-        FSkinWeightProfileInfo NewProfile;
-        NewProfile.Name = FName(*ProfileName);
-        TargetMesh->AddSkinWeightProfile(NewProfile);
+        if (SourceData.Triangles.Num() == 0)
+        {
+            SendAutomationError(RequestingSocket, RequestId, TEXT("Source LOD has no triangles"), TEXT("INVALID_LOD"));
+            return true;
+        }
+        
+        // Remap source bones to target bones by name; unmatched bones fall back to their nearest mapped ancestor
+        const FReferenceSkeleton& SourceSkeleton = SourceMesh->GetRefSkeleton();
+        const FReferenceSkeleton& TargetSkeleton = TargetMesh->GetRefSkeleton();
+        TArray<int32> BoneRemap;
+        BoneRemap.Init(INDEX_NONE, SourceSkeleton.GetNum());
+        int32 UnmatchedBones = 0;
+        for (int32 Bone = 0; Bone < SourceSkeleton.GetNum(); ++Bone)
+        {
+            BoneRemap[Bone] = TargetSkeleton.FindBoneIndex(SourceSkeleton.GetBoneName(Bone));
+            if (BoneRemap[Bone] == INDEX_NONE)
+            {
+                ++UnmatchedBones;
+                const int32 Parent = SourceSkeleton.GetParentIndex(Bone);
+                BoneRemap[Bone] = Parent != INDEX_NONE ? BoneRemap[Parent] : 0;
+            }
+        }
+        for (FMcpSkinWeightList& VertexWeights : SourceData.Weights)
+        {
+            FMcpSkinWeightList Remapped;
+            for (const TPair<int32, float>& Entry : VertexWeights)
+            {
+                if (BoneRemap.IsValidIndex(Entry.Key))
+                {
+                    McpAccumulateSkinWeight(Remapped, BoneRemap[Entry.Key], Entry.Value);
+                }
+            }
+            VertexWeights = MoveTemp(Remapped);
+        }
         
-        FImportedSkinWeightProfileData& ProfileData = TargetLOD.SkinWeightProfiles.FindOrAdd(FName(*ProfileName));
+        FMcpSkinTriangleBVH BVH;
+        BVH.Build(SourceData.Positions, SourceData.Triangles);
         
-        // Copy weights from source (limited by vertex count)
-        uint32 VertsToCopy = FMath::Min(SourceLOD.NumVertices, TargetLOD.NumVertices);
-        ProfileData.SkinWeights.SetNum(TargetLOD.NumVertices);
+        // Project every target vertex onto the source surface and blend the corner weights barycentrically
+        const float MaxDistSq = MaxDistance > 0.0 ? static_cast<float>(MaxDistance * MaxDistance) : TNumericLimits<float>::Max();
+        TArray<FMcpSkinWeightList> Weights;
+        TArray<float> Distances;
+        Weights.SetNum(TargetData.Positions.Num());
+        Distances.Init(-1.0f, TargetData.Positions.Num());
+        ParallelFor(TargetData.Positions.Num(), [&](int32 Vertex)
+        {
+            int32 Triangle = INDEX_NONE;
+            FVector3f Bary;
+            float DistSq = 0.0f;
+            if (!BVH.FindClosest(TargetData.Positions[Vertex], MaxDistSq, Triangle, Bary, DistSq))
+            {
+                return;
+            }
+            const FIntVector& Tri = SourceData.Triangles[Triangle];
+            FMcpSkinWeightList& Out = Weights[Vertex];
+            for (int32 Corner = 0; Corner < 3; ++Corner)
+            {
+                if (Bary[Corner] <= 0.0f)
+                {
+                    continue;
+                }
+                for (const TPair<int32, float>& Entry : SourceData.Weights[Tri[Corner]])
+                {
+                    McpAccumulateSkinWeight(Out, Entry.Key, Entry.Value * Bary[Corner]);
+                }
+            }
+            McpNormalizeSkinWeights(Out, MaxInfluences, MinWeight);
+            Distances[Vertex] = FMath::Sqrt(DistSq);
+        });
         
-        // Initialize with zeros
-        for (uint32 i = 0; i < TargetLOD.NumVertices; ++i)
+        int32 Projected = 0;
+        double DistanceSum = 0.0;
+        float MaxFound = 0.0f;
+        for (float Distance : Distances)
         {
-            FMemory::Memzero(&ProfileData.SkinWeights[i], sizeof(FRawSkinWeight));
+            if (Distance >= 0.0f)
+            {
+                ++Projected;
+                DistanceSum += Distance;
+                MaxFound = FMath::Max(MaxFound, Distance);
+            }
         }
         
-        // Note: Direct weight copying requires accessing the source vertex buffer
-        // For now we indicate the profile was created and user should use the editor for precise transfer
+        // Vertices beyond maxDistance inherit from their projected neighbours, then everything is smoothed
+        const int32 Filled = McpFillMissingSkinWeights(Weights, TargetData, MaxInfluences);
+        McpSmoothSkinWeights(Weights, TargetData, SmoothIterations, SmoothStrength, MaxInfluences, MinWeight);
         
+        const FName ProfileFName = bApplyToBase ? NAME_None : FName(*ProfileName);
+        if (!bApplyToBase && !TargetMesh->GetSkinWeightProfiles().ContainsByPredicate(
+                [&ProfileFName](const FSkinWeightProfileInfo& Info) { return Info.Name == ProfileFName; }))
+        {
+            FSkinWeightProfileInfo NewProfile;
+            NewProfile.Name = ProfileFName;
+            TargetMesh->AddSkinWeightProfile(NewProfile);
+        }
+        
+        TargetMesh->Modify();
+        McpWriteSkinWeights(*TargetDesc, ProfileFName, TargetData.VertexIds, Weights);
+        TargetMesh->CommitMeshDescription(LODIndex);
         TargetMesh->Build();
         McpSafeAssetSave(TargetMesh);
         
         TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject());
         Result->SetStringField(TEXT("sourceMeshPath"), SourceMeshPath);
         Result->SetStringField(TEXT("targetMeshPath"), TargetMeshPath);
+        Result->SetStringField(TEXT("target"), bApplyToBase ? TEXT("base") : *ProfileName);
         Result->SetStringField(TEXT("profileName"), ProfileName);
         Result->SetNumberField(TEXT("lodIndex"), LODIndex);
-        Result->SetStringField(TEXT("note"), TEXT("Skin weight profile created. Use FSkinWeightProfileHelpers::ImportSkinWeightProfile for precise transfer."));
+        Result->SetNumberField(TEXT("sourceTriangles"), SourceData.Triangles.Num());
+        Result->SetNumberField(TEXT("targetVertices"), TargetData.Positions.Num());
+        Result->SetNumberField(TEXT("projectedVertices"), Projected);
+        Result->SetNumberField(TEXT("filledVertices"), Filled);
+        Result->SetNumberField(TEXT("unmatchedBones"), UnmatchedBones);
+        Result->SetNumberField(TEXT("averageDistance"), Projected > 0 ? DistanceSum / Projected : 0.0);
+        Result->SetNumberField(TEXT("maxDistanceFound"), MaxFound);
+        Result->SetNumberField(TEXT("smoothIterations"), SmoothIterations);
+        Result->SetNumberField(TEXT("elapsedMs"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
         
         SendAutomationResponse(RequestingSocket, RequestId, true, 
-            FString::Printf(TEXT("Skin weight profile '%s' created on target mesh"), *ProfileName), Result);
+            FString::Printf(TEXT("Transferred skin weights to %d vertices (%d projected, %d filled)"), 
+                TargetData.Positions.Num(), Projected, Filled), Result);
+        return true;
+#elif WITH_EDITORONLY_DATA
+        SendAutomationError(RequestingSocket, RequestId, TEXT("copy_weights requires skeletal mesh description support (UE 5.1+)"), TEXT("NOT_SUPPORTED"));
         return true;
 #else
         SendAutomationError(RequestingSocket, RequestId, TEXT("copy_weights requires editor mode"), TEXT("NOT_EDITOR"));
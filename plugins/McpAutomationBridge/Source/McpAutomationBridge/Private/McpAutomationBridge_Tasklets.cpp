@@ -0,0 +1,141 @@
+#include "McpAutomationBridgeSubsystem.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "McpAutomationBridgeGlobals.h"
+#include "McpAutomationBridgeHelpers.h"
+#include "McpTasklet.h"
+#include "McpTransactionPolicy.h"
+
+namespace
+{
+    /** Minimum spacing of progress_update messages per tasklet. */
+    constexpr double McpTaskletProgressIntervalSeconds = 1.0;
+}
+
+TSharedPtr<FJsonObject> FMcpTasklet::ToJson() const
+{
+    TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetStringField(TEXT("name"), Name);
+    Json->SetStringField(TEXT("requestId"), RequestId);
+    Json->SetNumberField(TEXT("step"), NextStep);
+    Json->SetNumberField(TEXT("steps"), NumSteps);
+    Json->SetNumberField(TEXT("percent"), GetPercent());
+    Json->SetNumberField(TEXT("elapsedMs"), (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+    return Json;
+}
+
+void UMcpAutomationBridgeSubsystem::StartTasklet(TSharedPtr<FMcpTasklet> Tasklet)
+{
+    check(IsInGameThread());
+    Tasklet->StartSeconds = FPlatformTime::Seconds();
+    Tasklet->LastProgressSeconds = Tasklet->StartSeconds;
+    Tasklet->TransactionPolicy = FMcpTransactionPolicy::Get().GetPolicy(Tasklet->Socket.Get());
+
+    // Run the first slice inline so small requests still answer in the same call.
+    const double Deadline = Tasklet->StartSeconds + TaskletBudgetSeconds;
+    bool bAborted = false;
+    while (!Tasklet->IsDone() && !bAborted)
+    {
+        bAborted = !Tasklet->Step(Tasklet->NextStep++);
+        if (FPlatformTime::Seconds() >= Deadline)
+        {
+            break;
+        }
+    }
+    if (Tasklet->IsDone() || bAborted)
+    {
+        Tasklet->Finish(bAborted);
+        return;
+    }
+
+    UE_LOG(LogMcpAutomationBridgeSubsystem, Log, TEXT("%s (%s): continuing over multiple frames, %d/%d steps done"),
+           *Tasklet->Name, *Tasklet->RequestId, Tasklet->NextStep, Tasklet->NumSteps);
+    SendProgressUpdate(Tasklet->RequestId, Tasklet->GetPercent(),
+                       FString::Printf(TEXT("%s: %d/%d"), *Tasklet->Name, Tasklet->NextStep, Tasklet->NumSteps), true);
+
+    ActiveTasklets.Add(Tasklet);
+    if (!TaskletTickHandle.IsValid())
+    {
+        TaskletTickHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateUObject(this, &UMcpAutomationBridgeSubsystem::TickTasklets));
+    }
+}
+
+bool UMcpAutomationBridgeSubsystem::TickTasklets(float DeltaTime)
+{
+    // One budget per frame shared by all running tasklets, handed out one step
+    // at a time round-robin so a long job cannot starve a later one. At least
+    // one step runs per frame so every tasklet makes progress.
+    const double Start = FPlatformTime::Seconds();
+    const double Deadline = Start + TaskletBudgetSeconds;
+    bool bRanStep = false;
+    while (ActiveTasklets.Num() > 0 && (!bRanStep || FPlatformTime::Seconds() < Deadline))
+    {
+        TaskletCursor %= ActiveTasklets.Num();
+        TSharedPtr<FMcpTasklet> Tasklet = ActiveTasklets[TaskletCursor];
+        bool bContinue = false;
+        {
+            // The request's own transaction scope closed with the first slice.
+            const FMcpRequestTransactionScope TransactionScope(Tasklet->Name, Tasklet->TransactionPolicy);
+            bContinue = Tasklet->Step(Tasklet->NextStep++);
+        }
+        bRanStep = true;
+
+        if (!bContinue || Tasklet->IsDone())
+        {
+            // Remove before Finish: the response may start a new tasklet.
+            ActiveTasklets.RemoveAt(TaskletCursor);
+            UE_LOG(LogMcpAutomationBridgeSubsystem, Log, TEXT("%s (%s): %s after %.2fs"),
+                   *Tasklet->Name, *Tasklet->RequestId, bContinue ? TEXT("completed") : TEXT("stopped"),
+                   FPlatformTime::Seconds() - Tasklet->StartSeconds);
+            Tasklet->Finish(!bContinue);
+        }
+        else
+        {
+            ++TaskletCursor;
+        }
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    for (const TSharedPtr<FMcpTasklet>& Tasklet : ActiveTasklets)
+    {
+        if (Now - Tasklet->LastProgressSeconds >= McpTaskletProgressIntervalSeconds)
+        {
+            Tasklet->LastProgressSeconds = Now;
+            SendProgressUpdate(Tasklet->RequestId, Tasklet->GetPercent(),
+                               FString::Printf(TEXT("%s: %d/%d"), *Tasklet->Name, Tasklet->NextStep, Tasklet->NumSteps), true);
+        }
+    }
+
+    if (ActiveTasklets.Num() == 0)
+    {
+        TaskletTickHandle.Reset();
+        return false;
+    }
+    return true;
+}
+
+void UMcpAutomationBridgeSubsystem::ShutdownTasklets()
+{
+    if (TaskletTickHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TaskletTickHandle);
+        TaskletTickHandle.Reset();
+    }
+    TArray<TSharedPtr<FMcpTasklet>> Remaining = MoveTemp(ActiveTasklets);
+    ActiveTasklets.Reset();
+    for (const TSharedPtr<FMcpTasklet>& Tasklet : Remaining)
+    {
+        Tasklet->Finish(true);
+    }
+}
+
+TArray<TSharedPtr<FJsonValue>> UMcpAutomationBridgeSubsystem::GetTaskletStatusJson() const
+{
+    TArray<TSharedPtr<FJsonValue>> Entries;
+    for (const TSharedPtr<FMcpTasklet>& Tasklet : ActiveTasklets)
+    {
+        Entries.Add(MakeShared<FJsonValueObject>(Tasklet->ToJson()));
+    }
+    return Entries;
+}
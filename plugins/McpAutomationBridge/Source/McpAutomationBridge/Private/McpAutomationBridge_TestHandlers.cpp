@@ -2,8 +2,50 @@
 #include "Dom/JsonObject.h"
 #include "McpAutomationBridgeHelpers.h"
 #include "McpAutomationBridgeGlobals.h"
+#include "McpAutomationJob.h"
 #include "Misc/AutomationTest.h"
 
+namespace
+{
+    /** Maximum error messages reported per test in the job result. */
+    constexpr int32 McpMaxReportedTestErrors = 20;
+
+    /** Sequential run over the tests matched by a run_tests filter. */
+    struct FMcpTestRunState
+    {
+        TArray<FString> Queue;
+        int32 Next = 0;
+        bool bRunning = false;
+        int32 Passed = 0;
+        int32 Failed = 0;
+        TArray<TSharedPtr<FJsonValue>> Results;
+    };
+
+    TSharedPtr<FJsonObject> McpDescribeTestResult(const FString& TestName, bool bPassed, const FAutomationTestExecutionInfo& Info)
+    {
+        TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+        Json->SetStringField(TEXT("name"), TestName);
+        Json->SetBoolField(TEXT("passed"), bPassed);
+        Json->SetNumberField(TEXT("durationMs"), Info.Duration * 1000.0);
+        Json->SetNumberField(TEXT("errors"), Info.GetErrorTotal());
+        Json->SetNumberField(TEXT("warnings"), Info.GetWarningTotal());
+
+        TArray<TSharedPtr<FJsonValue>> Messages;
+        for (const FAutomationExecutionEntry& Entry : Info.GetEntries())
+        {
+            if (Entry.Event.Type == EAutomationEventType::Error && Messages.Num() < McpMaxReportedTestErrors)
+            {
+                Messages.Add(MakeShared<FJsonValueString>(Entry.Event.Message));
+            }
+        }
+        if (Messages.Num() > 0)
+        {
+            Json->SetArrayField(TEXT("errorMessages"), Messages);
+        }
+        return Json;
+    }
+}
+
 bool UMcpAutomationBridgeSubsystem::HandleTestAction(const FString& RequestId, const FString& Action, const TSharedPtr<FJsonObject>& Payload, TSharedPtr<FMcpBridgeWebSocket> RequestingSocket)
 {
     if (Action != TEXT("manage_tests"))
@@ -23,18 +65,94 @@ bool UMcpAutomationBridgeSubsystem::HandleTestAction(const FString& RequestId, c
     {
         FString Filter;
         Payload->TryGetStringField(TEXT("filter"), Filter);
-        
-        // FAutomationTestFramework::Get().StartTestByName(Filter, ...);
-        // We will start the test. Results are async, but we can confirm start.
-        // To get results, we would need to bind to OnTestEnd, which is a global delegate.
-        // For this bridge, we'll just start it.
-        
-        FAutomationTestFramework::Get().StartTestByName(Filter, 0);
+        if (Filter.IsEmpty())
+        {
+            SendAutomationError(RequestingSocket, RequestId, TEXT("filter is required."), TEXT("INVALID_ARGUMENT"));
+            return true;
+        }
+
+        FAutomationTestFramework& Framework = FAutomationTestFramework::Get();
+        if (Framework.GetCurrentTest() != nullptr)
+        {
+            SendAutomationError(RequestingSocket, RequestId, TEXT("An automation test is already running."), TEXT("BUSY"));
+            return true;
+        }
+
+        // Match the filter against registered tests (exact name or full path substring);
+        // fall back to the raw filter as a test name when nothing matches.
+        TSharedRef<FMcpTestRunState> State = MakeShared<FMcpTestRunState>();
+        TArray<FAutomationTestInfo> TestInfos;
+        Framework.GetValidTestNames(TestInfos);
+        for (const FAutomationTestInfo& Info : TestInfos)
+        {
+            if (Info.GetTestName() == Filter || Info.GetFullTestPath().Contains(Filter))
+            {
+                State->Queue.Add(Info.GetTestName());
+            }
+        }
+        if (State->Queue.Num() == 0)
+        {
+            State->Queue.Add(Filter);
+        }
+
+        // Tests are driven from the job's per-frame poll: start one, pump its latent
+        // commands until they drain, then StopTest (which fires OnTestEndEvent) and
+        // collect the execution info before moving on to the next.
+        const double TimeoutSeconds = GetJsonNumberField(Payload, TEXT("timeoutSeconds"), 600.0);
+        TSharedPtr<FMcpAutomationJob> Job = BeginAutomationJob(TEXT("tests"), RequestId, RequestingSocket, TimeoutSeconds);
+        Job->Poll = [State, Filter](FMcpAutomationJob& RunningJob)
+        {
+            FAutomationTestFramework& TestFramework = FAutomationTestFramework::Get();
+            if (State->bRunning)
+            {
+                if (!TestFramework.ExecuteLatentCommands())
+                {
+                    return false;
+                }
+                FAutomationTestExecutionInfo Info;
+                const bool bPassed = TestFramework.StopTest(Info);
+                (bPassed ? State->Passed : State->Failed)++;
+                State->Results.Add(MakeShared<FJsonValueObject>(McpDescribeTestResult(State->Queue[State->Next - 1], bPassed, Info)));
+                State->bRunning = false;
+            }
+            if (State->Next < State->Queue.Num())
+            {
+                TestFramework.StartTestByName(State->Queue[State->Next++], 0);
+                State->bRunning = true;
+                return false;
+            }
+
+            RunningJob.bSuccess = State->Failed == 0;
+            RunningJob.Message = FString::Printf(TEXT("%d passed, %d failed"), State->Passed, State->Failed);
+            if (!RunningJob.bSuccess)
+            {
+                RunningJob.ErrorCode = TEXT("TESTS_FAILED");
+            }
+            RunningJob.Result = MakeShared<FJsonObject>();
+            RunningJob.Result->SetStringField(TEXT("filter"), Filter);
+            RunningJob.Result->SetNumberField(TEXT("passed"), State->Passed);
+            RunningJob.Result->SetNumberField(TEXT("failed"), State->Failed);
+            RunningJob.Result->SetArrayField(TEXT("tests"), State->Results);
+            return true;
+        };
+        Job->OnFinished = [State]()
+        {
+            // Timed out or shut down mid-test: stop it so the framework is not left busy.
+            if (State->bRunning)
+            {
+                FAutomationTestExecutionInfo Info;
+                FAutomationTestFramework::Get().StopTest(Info);
+                State->bRunning = false;
+            }
+        };
+
         TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
         Result->SetStringField(TEXT("action"), TEXT("run_tests"));
         Result->SetStringField(TEXT("filter"), Filter);
+        Result->SetStringField(TEXT("jobId"), Job->JobId);
+        Result->SetNumberField(TEXT("testCount"), State->Queue.Num());
         Result->SetBoolField(TEXT("started"), true);
-        SendAutomationResponse(RequestingSocket, RequestId, true, TEXT("Tests started. Check logs for results."), Result);
+        SendAutomationResponse(RequestingSocket, RequestId, true, FString::Printf(TEXT("Started %d test(s); results follow in a job_completed event."), State->Queue.Num()), Result);
         return true;
     }
 
@@ -67,6 +67,193 @@
 #include "WorldPartition/DataLayer/DataLayerManager.h"
 #include "WorldPartition/DataLayer/DataLayerAsset.h"
 #endif
+
+#if MCP_HAS_WP_LOADER_ADAPTER && ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+#include "WorldPartition/WorldPartitionActorDescInstance.h"
+#include "WorldPartition/WorldPartitionHelpers.h"
+#define MCP_HAS_WP_PREFETCH 1
+#endif
+#endif
+
+#ifndef MCP_HAS_WP_LOADER_ADAPTER
+#define MCP_HAS_WP_LOADER_ADAPTER 0
+#endif
+#ifndef MCP_HAS_WP_PREFETCH
+#define MCP_HAS_WP_PREFETCH 0
+#endif
+
+#include "Async/Async.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_EDITOR
+/** A region loaded through manage_world_partition, addressed by handle until unloaded or evicted. */
+struct FMcpWorldRegion
+{
+    FString Id;
+    FString Label;
+    FBox Bounds = FBox(ForceInit);
+    TWeakObjectPtr<UWorld> World;
+#if MCP_HAS_WP_LOADER_ADAPTER
+    TWeakObjectPtr<UWorldPartitionEditorLoaderAdapter> Adapter;
+#endif
+    double LoadedSeconds = 0.0;
+    double LastUsedSeconds = 0.0;
+    /** Change in process physical memory across the load; a rough per-region cost. */
+    int64 MemoryDeltaBytes = 0;
+    /** Pinned regions are never evicted (tiles of a running traversal). */
+    bool bPinned = false;
+};
+
+/**
+ * State of one for_each_region walk: tiles are loaded one at a time, the
+ * request's batch items run against each tile, then the tile is unloaded.
+ */
+struct FMcpRegionTraversal
+{
+    FString RequestId;
+    TSharedPtr<FMcpBridgeWebSocket> Socket;
+    TWeakObjectPtr<UWorld> World;
+    TArray<FBox> Tiles;
+    TArray<FIntPoint> TileCoords;
+    int32 Current = 0;
+    /** items plus batch options, run once per tile with "${tile.*}" in context. */
+    TSharedPtr<FJsonObject> BatchPayload;
+    bool bStopOnError = false;
+    bool bPrefetch = true;
+    bool bIncludeResults = false;
+    bool bCancelled = false;
+    bool bHalted = false;
+    FString CurrentRegionId;
+    /** The tile loaded CurrentRegionId itself; otherwise it was already loaded and stays. */
+    bool bOwnsCurrentRegion = false;
+    /** Pin state of a reused region, restored when the tile is done. */
+    bool bCurrentRegionWasPinned = false;
+    double TileStartSeconds = 0.0;
+    double TileLoadMs = 0.0;
+    int32 TilesSucceeded = 0;
+    int32 TilesFailed = 0;
+    int32 PrefetchedPackages = 0;
+    TArray<TSharedPtr<FJsonValue>> TileResults;
+    double StartSeconds = 0.0;
+};
+
+namespace
+{
+    /** Upper bound on tiles in one for_each_region walk. */
+    constexpr int32 McpMaxRegionTiles = 10000;
+
+    TSharedPtr<FJsonValue> McpRegionVectorJson(const FVector& V)
+    {
+        TArray<TSharedPtr<FJsonValue>> Components;
+        Components.Add(MakeShared<FJsonValueNumber>(V.X));
+        Components.Add(MakeShared<FJsonValueNumber>(V.Y));
+        Components.Add(MakeShared<FJsonValueNumber>(V.Z));
+        return MakeShared<FJsonValueArray>(Components);
+    }
+
+    int64 McpUsedPhysicalBytes()
+    {
+        return (int64)FPlatformMemory::GetStats().UsedPhysical;
+    }
+
+    /** origin/extent, or min/max, or the fallback when neither is given. */
+    FBox McpReadRegionBounds(const TSharedPtr<FJsonObject>& Payload, const FBox& Fallback)
+    {
+        if (Payload->HasField(TEXT("min")) && Payload->HasField(TEXT("max")))
+        {
+            return FBox(ExtractVectorField(Payload, TEXT("min"), FVector::ZeroVector),
+                        ExtractVectorField(Payload, TEXT("max"), FVector::ZeroVector));
+        }
+        if (Payload->HasField(TEXT("origin")) || Payload->HasField(TEXT("extent")))
+        {
+            const FVector Origin = ExtractVectorField(Payload, TEXT("origin"), FVector::ZeroVector);
+            // Default to a 500m box, as load_cells always has.
+            const FVector Extent = ExtractVectorField(Payload, TEXT("extent"), FVector(25000.0, 25000.0, 25000.0));
+            return FBox(Origin - Extent, Origin + Extent);
+        }
+        return Fallback;
+    }
+
+    TSharedPtr<FJsonObject> McpWorldRegionJson(const FMcpWorldRegion& Region, double Now)
+    {
+        TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+        Json->SetStringField(TEXT("regionId"), Region.Id);
+        Json->SetStringField(TEXT("label"), Region.Label);
+        Json->SetField(TEXT("min"), McpRegionVectorJson(Region.Bounds.Min));
+        Json->SetField(TEXT("max"), McpRegionVectorJson(Region.Bounds.Max));
+        Json->SetBoolField(TEXT("pinned"), Region.bPinned);
+#if MCP_HAS_WP_LOADER_ADAPTER
+        Json->SetBoolField(TEXT("loaded"), Region.Adapter.IsValid());
+#endif
+        Json->SetNumberField(TEXT("ageSeconds"), Now - Region.LoadedSeconds);
+        Json->SetNumberField(TEXT("idleSeconds"), Now - Region.LastUsedSeconds);
+        Json->SetNumberField(TEXT("memoryDeltaMB"), Region.MemoryDeltaBytes / (1024.0 * 1024.0));
+        return Json;
+    }
+
+    /**
+     * Splits Bounds into TileSize squares in XY (full Z range), ordered in a
+     * serpentine so consecutive tiles are neighbours and prefetch stays local.
+     * OutTileCount is always set; when it exceeds MaxTiles nothing is built
+     * and false is returned.
+     */
+    bool McpBuildRegionTiles(const FBox& Bounds, double TileSize, int32 MaxTiles, TArray<FBox>& OutTiles,
+                             TArray<FIntPoint>& OutCoords, int64& OutTileCount)
+    {
+        // Counted in doubles first: huge bounds over a small tile overflow int32.
+        const FVector Size = Bounds.GetSize();
+        const double CountXExact = FMath::Max(1.0, FMath::CeilToDouble(Size.X / TileSize));
+        const double CountYExact = FMath::Max(1.0, FMath::CeilToDouble(Size.Y / TileSize));
+        if (CountXExact * CountYExact > static_cast<double>(MaxTiles))
+        {
+            OutTileCount = static_cast<int64>(FMath::Min(CountXExact * CountYExact, static_cast<double>(MAX_int64)));
+            return false;
+        }
+        const int32 CountX = static_cast<int32>(CountXExact);
+        const int32 CountY = static_cast<int32>(CountYExact);
+        OutTileCount = static_cast<int64>(CountX) * CountY;
+        OutTiles.Reserve(OutTileCount);
+        OutCoords.Reserve(OutTileCount);
+        for (int32 Y = 0; Y < CountY; ++Y)
+        {
+            for (int32 Step = 0; Step < CountX; ++Step)
+            {
+                const int32 X = (Y % 2 == 0) ? Step : CountX - 1 - Step;
+                const FVector Min(Bounds.Min.X + X * TileSize, Bounds.Min.Y + Y * TileSize, Bounds.Min.Z);
+                const FVector Max(FMath::Min(Min.X + TileSize, Bounds.Max.X), FMath::Min(Min.Y + TileSize, Bounds.Max.Y), Bounds.Max.Z);
+                OutTiles.Add(FBox(Min, Max));
+                OutCoords.Add(FIntPoint(X, Y));
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Starts async loads of the actor packages inside Bounds. Editor region
+     * loading itself is synchronous, but it finds already-loaded packages
+     * instead of reading them from disk, so the next tile's Load() is mostly
+     * object setup. Returns the number of packages requested.
+     */
+    int32 McpPrefetchRegionPackages(UWorldPartition* WorldPartition, const FBox& Bounds)
+    {
+        int32 Requested = 0;
+#if MCP_HAS_WP_PREFETCH
+        FWorldPartitionHelpers::ForEachIntersectingActorDescInstance(WorldPartition, Bounds, [&Requested](const FWorldPartitionActorDescInstance* ActorDescInstance)
+        {
+            const FName PackageName = ActorDescInstance->GetActorPackage();
+            if (!PackageName.IsNone() && !FindPackage(nullptr, *PackageName.ToString()))
+            {
+                LoadPackageAsync(PackageName.ToString());
+                ++Requested;
+            }
+            return true;
+        });
+#endif
+        return Requested;
+    }
+}
 #endif
 
 bool UMcpAutomationBridgeSubsystem::HandleWorldPartitionAction(const FString& RequestId, const FString& Action, const TSharedPtr<FJsonObject>& Payload, TSharedPtr<FMcpBridgeWebSocket> RequestingSocket)
@@ -99,29 +286,19 @@ bool UMcpAutomationBridgeSubsystem::HandleWorldPartitionAction(const FString& Re
 
     FString SubAction = GetJsonStringField(Payload, TEXT("subAction"));
 
-    if (SubAction == TEXT("load_cells"))
+    // Handles from a previous map are dead: its adapters went with the world.
+    for (auto It = WorldRegions.CreateIterator(); It; ++It)
     {
-        // Default to a reasonable area if no bounds provided
-        FVector Origin = FVector::ZeroVector;
-        FVector Extent = FVector(25000.0f, 25000.0f, 25000.0f); // 500m box
-
-        const TArray<TSharedPtr<FJsonValue>>* OriginArr;
-        if (Payload->TryGetArrayField(TEXT("origin"), OriginArr) && OriginArr && OriginArr->Num() >= 3)
-        {
-            Origin.X = (*OriginArr)[0]->AsNumber();
-            Origin.Y = (*OriginArr)[1]->AsNumber();
-            Origin.Z = (*OriginArr)[2]->AsNumber();
-        }
-        
-        const TArray<TSharedPtr<FJsonValue>>* ExtentArr;
-        if (Payload->TryGetArrayField(TEXT("extent"), ExtentArr) && ExtentArr && ExtentArr->Num() >= 3)
+        if (It.Value()->World != World)
         {
-            Extent.X = (*ExtentArr)[0]->AsNumber();
-            Extent.Y = (*ExtentArr)[1]->AsNumber();
-            Extent.Z = (*ExtentArr)[2]->AsNumber();
+            It.RemoveCurrent();
         }
-        
-        FBox Bounds(Origin - Extent, Origin + Extent);
+    }
+
+    if (SubAction == TEXT("load_cells") || SubAction == TEXT("load_region"))
+    {
+        // Default to a reasonable area if no bounds provided
+        const FBox Bounds = McpReadRegionBounds(Payload, FBox(FVector(-25000.0), FVector(25000.0))); // 500m box
 
 #if MCP_HAS_WP_EDITOR_SUBSYSTEM
         // Old method (UE 5.0-5.3)
@@ -139,29 +316,179 @@ bool UMcpAutomationBridgeSubsystem::HandleWorldPartitionAction(const FString& Re
 #endif
 
 #if MCP_HAS_WP_LOADER_ADAPTER
-        // New method (UE 5.4+)
-        if (WorldPartition)
-        {
-             // Create a user-created loader adapter to load the region
-             UWorldPartitionEditorLoaderAdapter* EditorLoaderAdapter = WorldPartition->CreateEditorLoaderAdapter<FLoaderAdapterShape>(World, Bounds, TEXT("MCP Loaded Region"));
-             if (EditorLoaderAdapter && EditorLoaderAdapter->GetLoaderAdapter())
-             {
-                 EditorLoaderAdapter->GetLoaderAdapter()->SetUserCreated(true);
-                 EditorLoaderAdapter->GetLoaderAdapter()->Load();
-                 TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
-                 Result->SetStringField(TEXT("action"), TEXT("load_region"));
-                 Result->SetStringField(TEXT("method"), TEXT("LoaderAdapter"));
-                 Result->SetBoolField(TEXT("requested"), true);
-                 SendAutomationResponse(RequestingSocket, RequestId, true, TEXT("Region load requested via LoaderAdapter."), Result);
-                 return true;
-             }
+        // New method (UE 5.4+): a managed region that can be unloaded by handle or evicted under memory pressure
+        const double CallSeconds = FPlatformTime::Seconds();
+        FString Label = GetJsonStringField(Payload, TEXT("label"));
+        if (Label.IsEmpty())
+        {
+            Label = TEXT("MCP Loaded Region");
         }
-#endif
-
+        FString Error;
+        TSharedPtr<FMcpWorldRegion> Region = LoadWorldRegion(World, Bounds, Label, GetJsonBoolField(Payload, TEXT("pinned"), false), Error);
+        if (Region.IsValid())
+        {
+            TSharedPtr<FJsonObject> Result = McpWorldRegionJson(*Region, FPlatformTime::Seconds());
+            Result->SetStringField(TEXT("action"), TEXT("load_region"));
+            Result->SetStringField(TEXT("method"), TEXT("LoaderAdapter"));
+            Result->SetBoolField(TEXT("requested"), true);
+            Result->SetBoolField(TEXT("reused"), Region->LoadedSeconds < CallSeconds);
+            Result->SetNumberField(TEXT("regionCount"), WorldRegions.Num());
+            SendAutomationResponse(RequestingSocket, RequestId, true, TEXT("Region load requested via LoaderAdapter."), Result);
+            return true;
+        }
+        SendAutomationError(RequestingSocket, RequestId, Error, TEXT("REGION_LOAD_FAILED"));
+#else
         // If we reach here, neither subsystem nor adapter logic was available/successful
         // But we should avoid sending error if it was just a fallback case; however if both failed it means not supported.
         // Since we are refactoring to SUPPORT it, failure here is real failure.
         SendAutomationError(RequestingSocket, RequestId, TEXT("WorldPartition region loading not supported or failed in this engine version."), TEXT("NOT_SUPPORTED"));
+#endif
+        return true;
+    }
+    else if (SubAction == TEXT("unload_region"))
+    {
+        TArray<FString> Ids;
+        const FString RegionId = GetJsonStringField(Payload, TEXT("regionId"));
+        if (GetJsonBoolField(Payload, TEXT("all"), false))
+        {
+            WorldRegions.GetKeys(Ids);
+        }
+        else if (!RegionId.IsEmpty())
+        {
+            Ids.Add(RegionId);
+        }
+        else
+        {
+            SendAutomationError(RequestingSocket, RequestId, TEXT("unload_region requires 'regionId' or 'all': true."), TEXT("INVALID_ARGUMENT"));
+            return true;
+        }
+
+        TArray<TSharedPtr<FJsonValue>> Unloaded;
+        for (const FString& Id : Ids)
+        {
+            const TSharedPtr<FMcpWorldRegion>* Found = WorldRegions.Find(Id);
+            if (Found && (*Found)->bPinned && ActiveRegionTraversal.IsValid() && ActiveRegionTraversal->CurrentRegionId == Id)
+            {
+                continue; // the running traversal unloads its own tile
+            }
+            if (UnloadWorldRegion(Id))
+            {
+                Unloaded.Add(MakeShared<FJsonValueString>(Id));
+            }
+        }
+        if (Unloaded.Num() == 0 && !RegionId.IsEmpty())
+        {
+            SendAutomationError(RequestingSocket, RequestId, FString::Printf(TEXT("Unknown or busy region: %s"), *RegionId), TEXT("REGION_NOT_FOUND"));
+            return true;
+        }
+        if (GetJsonBoolField(Payload, TEXT("collectGarbage"), true))
+        {
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+        }
+
+        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+        Result->SetStringField(TEXT("action"), TEXT("unload_region"));
+        Result->SetArrayField(TEXT("unloaded"), Unloaded);
+        Result->SetNumberField(TEXT("regionCount"), WorldRegions.Num());
+        SendAutomationResponse(RequestingSocket, RequestId, true, FString::Printf(TEXT("Unloaded %d region(s)."), Unloaded.Num()), Result);
+        return true;
+    }
+    else if (SubAction == TEXT("list_regions") || SubAction == TEXT("set_region_budget"))
+    {
+        if (SubAction == TEXT("set_region_budget"))
+        {
+            WorldRegionBudgetMB = FMath::Max(0.0, GetJsonNumberField(Payload, TEXT("budgetMB"), WorldRegionBudgetMB));
+            MaxWorldRegions = FMath::Clamp(GetJsonIntField(Payload, TEXT("maxRegions"), MaxWorldRegions), 1, 4096);
+            EnforceWorldRegionBudget();
+        }
+
+        const double Now = FPlatformTime::Seconds();
+        TArray<TSharedPtr<FMcpWorldRegion>> Sorted;
+        WorldRegions.GenerateValueArray(Sorted);
+        // Most recently used first; the tail is what eviction takes next.
+        Sorted.Sort([](const TSharedPtr<FMcpWorldRegion>& A, const TSharedPtr<FMcpWorldRegion>& B) { return A->LastUsedSeconds > B->LastUsedSeconds; });
+        TArray<TSharedPtr<FJsonValue>> Regions;
+        for (const TSharedPtr<FMcpWorldRegion>& Region : Sorted)
+        {
+            Regions.Add(MakeShared<FJsonValueObject>(McpWorldRegionJson(*Region, Now)));
+        }
+
+        const FPlatformMemoryStats Stats = FPlatformMemory::GetStats();
+        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+        Result->SetStringField(TEXT("action"), SubAction);
+        Result->SetArrayField(TEXT("regions"), Regions);
+        Result->SetNumberField(TEXT("regionCount"), Regions.Num());
+        Result->SetNumberField(TEXT("maxRegions"), MaxWorldRegions);
+        Result->SetNumberField(TEXT("budgetMB"), WorldRegionBudgetMB);
+        Result->SetNumberField(TEXT("effectiveBudgetMB"), (WorldRegionBudgetMB > 0.0 ? WorldRegionBudgetMB : Stats.TotalPhysical * 0.75 / (1024.0 * 1024.0)));
+        Result->SetNumberField(TEXT("usedPhysicalMB"), Stats.UsedPhysical / (1024.0 * 1024.0));
+        Result->SetBoolField(TEXT("traversalRunning"), ActiveRegionTraversal.IsValid());
+        SendAutomationResponse(RequestingSocket, RequestId, true, FString::Printf(TEXT("%d region(s) loaded."), Regions.Num()), Result);
+        return true;
+    }
+    else if (SubAction == TEXT("for_each_region"))
+    {
+#if MCP_HAS_WP_LOADER_ADAPTER
+        if (ActiveRegionTraversal.IsValid())
+        {
+            SendAutomationError(RequestingSocket, RequestId, FString::Printf(TEXT("for_each_region %s is already running."), *ActiveRegionTraversal->RequestId), TEXT("BUSY"));
+            return true;
+        }
+        const TArray<TSharedPtr<FJsonValue>>* Items = nullptr;
+        if (!Payload->TryGetArrayField(TEXT("items"), Items) || Items->Num() == 0)
+        {
+            SendAutomationError(RequestingSocket, RequestId, TEXT("for_each_region requires a non-empty 'items' batch."), TEXT("INVALID_ARGUMENT"));
+            return true;
+        }
+
+        const FBox Bounds = McpReadRegionBounds(Payload, WorldPartition->GetEditorWorldBounds());
+        if (!Bounds.IsValid || Bounds.GetVolume() <= 0.0)
+        {
+            SendAutomationError(RequestingSocket, RequestId, TEXT("Traversal bounds are empty."), TEXT("INVALID_ARGUMENT"));
+            return true;
+        }
+
+        TSharedPtr<FMcpRegionTraversal> Traversal = MakeShared<FMcpRegionTraversal>();
+        const double TileSize = FMath::Clamp(GetJsonNumberField(Payload, TEXT("tileSize"), 51200.0), 1000.0, 10000000.0);
+        int64 TileCount = 0;
+        if (!McpBuildRegionTiles(Bounds, TileSize, McpMaxRegionTiles, Traversal->Tiles, Traversal->TileCoords, TileCount))
+        {
+            SendAutomationError(RequestingSocket, RequestId, FString::Printf(TEXT("%lld tiles exceed the limit of %d; use a larger tileSize."), TileCount, McpMaxRegionTiles), TEXT("INVALID_ARGUMENT"));
+            return true;
+        }
+
+        Traversal->RequestId = RequestId;
+        Traversal->Socket = RequestingSocket;
+        Traversal->World = World;
+        // Batch options (stopOnError, transaction, itemTimeoutSeconds) apply within each tile.
+        Traversal->BatchPayload = Payload;
+        Traversal->bStopOnError = GetJsonBoolField(Payload, TEXT("stopOnTileError"), false);
+        Traversal->bPrefetch = GetJsonBoolField(Payload, TEXT("prefetch"), true);
+        Traversal->bIncludeResults = GetJsonBoolField(Payload, TEXT("includeResults"), false);
+        Traversal->StartSeconds = FPlatformTime::Seconds();
+
+        UE_LOG(LogMcpAutomationBridgeSubsystem, Log, TEXT("for_each_region %s: %d tile(s) of %.0f cm"), *RequestId, Traversal->Tiles.Num(), TileSize);
+        ActiveRegionTraversal = Traversal;
+        RunRegionTraversalTile(Traversal);
+#else
+        SendAutomationError(RequestingSocket, RequestId, TEXT("for_each_region requires World Partition loader adapters (UE 5.4+)."), TEXT("NOT_SUPPORTED"));
+#endif
+        return true;
+    }
+    else if (SubAction == TEXT("cancel_for_each_region"))
+    {
+        if (!ActiveRegionTraversal.IsValid())
+        {
+            SendAutomationError(RequestingSocket, RequestId, TEXT("No for_each_region traversal is running."), TEXT("NOT_FOUND"));
+            return true;
+        }
+        // Takes effect once the current tile's batch has finished.
+        ActiveRegionTraversal->bCancelled = true;
+        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+        Result->SetStringField(TEXT("traversalRequestId"), ActiveRegionTraversal->RequestId);
+        Result->SetNumberField(TEXT("completedTiles"), ActiveRegionTraversal->Current);
+        Result->SetNumberField(TEXT("tileCount"), ActiveRegionTraversal->Tiles.Num());
+        SendAutomationResponse(RequestingSocket, RequestId, true, TEXT("Traversal cancellation requested."), Result);
         return true;
     }
     else if (SubAction == TEXT("create_datalayer"))
@@ -368,3 +695,341 @@ bool UMcpAutomationBridgeSubsystem::HandleWorldPartitionAction(const FString& Re
 #endif
 }
 
+
+/**
+ * Loads Bounds as a managed region, or returns the live region with the same
+ * bounds (bOutCreated tells which). Makes room first so the budget holds
+ * after the load.
+ */
+TSharedPtr<FMcpWorldRegion> UMcpAutomationBridgeSubsystem::LoadWorldRegion(UWorld* World, const FBox& Bounds, const FString& Label, bool bPinned, FString& OutError,
+                                                                           bool* bOutCreated)
+{
+    if (bOutCreated)
+    {
+        *bOutCreated = false;
+    }
+#if MCP_HAS_WP_LOADER_ADAPTER
+    const double Now = FPlatformTime::Seconds();
+    for (const TPair<FString, TSharedPtr<FMcpWorldRegion>>& Pair : WorldRegions)
+    {
+        const TSharedPtr<FMcpWorldRegion>& Existing = Pair.Value;
+        if (Existing->World == World && Existing->Adapter.IsValid() && Existing->Bounds.Equals(Bounds, 1.0))
+        {
+            Existing->LastUsedSeconds = Now;
+            Existing->bPinned |= bPinned;
+            return Existing;
+        }
+    }
+
+    UWorldPartition* WorldPartition = World ? World->GetWorldPartition() : nullptr;
+    if (!WorldPartition)
+    {
+        OutError = TEXT("World is not partitioned.");
+        return nullptr;
+    }
+
+    EnforceWorldRegionBudget(1);
+
+    const int64 BytesBefore = McpUsedPhysicalBytes();
+    UWorldPartitionEditorLoaderAdapter* EditorLoaderAdapter = WorldPartition->CreateEditorLoaderAdapter<FLoaderAdapterShape>(World, Bounds, Label);
+    if (!EditorLoaderAdapter || !EditorLoaderAdapter->GetLoaderAdapter())
+    {
+        OutError = TEXT("CreateEditorLoaderAdapter failed.");
+        return nullptr;
+    }
+    EditorLoaderAdapter->GetLoaderAdapter()->SetUserCreated(true);
+    EditorLoaderAdapter->GetLoaderAdapter()->Load();
+
+    TSharedPtr<FMcpWorldRegion> Region = MakeShared<FMcpWorldRegion>();
+    Region->Id = FString::Printf(TEXT("region_%d"), NextWorldRegionId++);
+    Region->Label = Label;
+    Region->Bounds = Bounds;
+    Region->World = World;
+    Region->Adapter = EditorLoaderAdapter;
+    Region->LoadedSeconds = FPlatformTime::Seconds();
+    Region->LastUsedSeconds = Region->LoadedSeconds;
+    Region->MemoryDeltaBytes = FMath::Max<int64>(0, McpUsedPhysicalBytes() - BytesBefore);
+    Region->bPinned = bPinned;
+    WorldRegions.Add(Region->Id, Region);
+    if (bOutCreated)
+    {
+        *bOutCreated = true;
+    }
+    return Region;
+#else
+    OutError = TEXT("Managed regions require World Partition loader adapters (UE 5.4+).");
+    return nullptr;
+#endif
+}
+
+bool UMcpAutomationBridgeSubsystem::UnloadWorldRegion(const FString& RegionId)
+{
+    TSharedPtr<FMcpWorldRegion> Region;
+    if (!WorldRegions.RemoveAndCopyValue(RegionId, Region))
+    {
+        return false;
+    }
+#if MCP_HAS_WP_LOADER_ADAPTER
+    if (UWorldPartitionEditorLoaderAdapter* EditorLoaderAdapter = Region->Adapter.Get())
+    {
+        if (auto* LoaderAdapter = EditorLoaderAdapter->GetLoaderAdapter())
+        {
+            LoaderAdapter->Unload();
+        }
+        UWorld* World = Region->World.Get();
+        if (UWorldPartition* WorldPartition = World ? World->GetWorldPartition() : nullptr)
+        {
+            WorldPartition->ReleaseEditorLoaderAdapter(EditorLoaderAdapter);
+        }
+    }
+#endif
+    return true;
+}
+
+/**
+ * Evicts least-recently-used unpinned regions while there are too many or the
+ * editor's physical memory is over budget. Unloaded actors are only freed by
+ * GC, so memory is re-measured after a collection before evicting more.
+ */
+void UMcpAutomationBridgeSubsystem::EnforceWorldRegionBudget(int32 IncomingRegions)
+{
+#if WITH_EDITOR
+    const int64 BudgetBytes = WorldRegionBudgetMB > 0.0
+        ? (int64)(WorldRegionBudgetMB * 1024.0 * 1024.0)
+        : (int64)(FPlatformMemory::GetStats().TotalPhysical * 0.75);
+
+    bool bCollected = false;
+    for (;;)
+    {
+        const bool bOverCount = WorldRegions.Num() + IncomingRegions > MaxWorldRegions;
+        const bool bOverMemory = McpUsedPhysicalBytes() > BudgetBytes;
+        if (!bOverCount && !bOverMemory)
+        {
+            return;
+        }
+        if (!bOverCount && !bCollected)
+        {
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+            bCollected = true;
+            continue;
+        }
+
+        FString VictimId;
+        double OldestUse = TNumericLimits<double>::Max();
+        for (const TPair<FString, TSharedPtr<FMcpWorldRegion>>& Pair : WorldRegions)
+        {
+            if (!Pair.Value->bPinned && Pair.Value->LastUsedSeconds < OldestUse)
+            {
+                OldestUse = Pair.Value->LastUsedSeconds;
+                VictimId = Pair.Key;
+            }
+        }
+        if (VictimId.IsEmpty())
+        {
+            return;
+        }
+        UE_LOG(LogMcpAutomationBridgeSubsystem, Log, TEXT("Evicting world region %s (%s)"),
+               *VictimId, bOverCount ? TEXT("region limit") : TEXT("memory budget"));
+        UnloadWorldRegion(VictimId);
+        bCollected = false;
+    }
+#endif
+}
+
+void UMcpAutomationBridgeSubsystem::RunRegionTraversalTile(TSharedPtr<FMcpRegionTraversal> Traversal)
+{
+#if MCP_HAS_WP_LOADER_ADAPTER
+    check(IsInGameThread());
+    if (Traversal->bCancelled)
+    {
+        FinishRegionTraversal(Traversal, TEXT("CANCELLED"));
+        return;
+    }
+    if (Traversal->bHalted || Traversal->Current >= Traversal->Tiles.Num())
+    {
+        FinishRegionTraversal(Traversal, FString());
+        return;
+    }
+    UWorld* World = Traversal->World.Get();
+    if (!World || !World->GetWorldPartition())
+    {
+        FinishRegionTraversal(Traversal, TEXT("NO_WORLD"));
+        return;
+    }
+
+    const int32 Index = Traversal->Current;
+    const FBox& Tile = Traversal->Tiles[Index];
+    const FIntPoint Coord = Traversal->TileCoords[Index];
+    Traversal->TileStartSeconds = FPlatformTime::Seconds();
+
+    FString Error;
+    bool bCreated = false;
+    TSharedPtr<FMcpWorldRegion> Region = LoadWorldRegion(World, Tile, FString::Printf(TEXT("MCP Tile %d,%d"), Coord.X, Coord.Y), false, Error, &bCreated);
+    Traversal->TileLoadMs = (FPlatformTime::Seconds() - Traversal->TileStartSeconds) * 1000.0;
+    if (!Region.IsValid())
+    {
+        CompleteRegionTraversalTile(Traversal, false, Error, nullptr, TEXT("REGION_LOAD_FAILED"));
+        return;
+    }
+    Traversal->CurrentRegionId = Region->Id;
+    Traversal->bOwnsCurrentRegion = bCreated;
+    Traversal->bCurrentRegionWasPinned = Region->bPinned;
+    Region->bPinned = true;
+
+    // Warm the next tile's packages while this tile's batch runs.
+    if (Traversal->bPrefetch && Traversal->Tiles.IsValidIndex(Index + 1))
+    {
+        Traversal->PrefetchedPackages += McpPrefetchRegionPackages(World->GetWorldPartition(), Traversal->Tiles[Index + 1]);
+    }
+
+    TSharedPtr<FJsonObject> TileJson = MakeShared<FJsonObject>();
+    TileJson->SetNumberField(TEXT("index"), Index);
+    TileJson->SetNumberField(TEXT("x"), Coord.X);
+    TileJson->SetNumberField(TEXT("y"), Coord.Y);
+    TileJson->SetField(TEXT("min"), McpRegionVectorJson(Tile.Min));
+    TileJson->SetField(TEXT("max"), McpRegionVectorJson(Tile.Max));
+    TileJson->SetField(TEXT("center"), McpRegionVectorJson(Tile.GetCenter()));
+    TileJson->SetField(TEXT("extent"), McpRegionVectorJson(Tile.GetExtent()));
+    TileJson->SetStringField(TEXT("regionId"), Region->Id);
+    TSharedPtr<FJsonObject> Context = MakeShared<FJsonObject>();
+    Context->SetObjectField(TEXT("tile"), TileJson);
+
+    SendProgressUpdate(Traversal->RequestId, 100.0f * Index / Traversal->Tiles.Num(),
+                       FString::Printf(TEXT("for_each_region: tile %d/%d (%d,%d)"), Index + 1, Traversal->Tiles.Num(), Coord.X, Coord.Y), true);
+
+    TWeakObjectPtr<UMcpAutomationBridgeSubsystem> WeakThis(this);
+    const FString TileRequestId = FString::Printf(TEXT("%s@tile%d"), *Traversal->RequestId, Index);
+    const bool bStarted = StartBatchRun(TileRequestId, Traversal->BatchPayload, Traversal->Socket, Context,
+        [WeakThis, Traversal](bool bSuccess, const FString& Message, const TSharedPtr<FJsonObject>& Result, const FString& ErrorCode)
+        {
+            if (UMcpAutomationBridgeSubsystem* Pinned = WeakThis.Get())
+            {
+                Pinned->CompleteRegionTraversalTile(Traversal, bSuccess, Message, Result, ErrorCode);
+            }
+        },
+        Error, Traversal->RequestId);
+    if (!bStarted)
+    {
+        // The items are the same for every tile, so a rejected batch ends the walk.
+        Traversal->bHalted = true;
+        CompleteRegionTraversalTile(Traversal, false, Error, nullptr, TEXT("INVALID_ARGUMENT"));
+    }
+#endif
+}
+
+void UMcpAutomationBridgeSubsystem::CompleteRegionTraversalTile(TSharedPtr<FMcpRegionTraversal> Traversal, bool bSuccess, const FString& Message,
+                                                                const TSharedPtr<FJsonObject>& Result, const FString& ErrorCode)
+{
+#if WITH_EDITOR
+    const int32 Index = Traversal->Current;
+    TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+    Entry->SetNumberField(TEXT("index"), Index);
+    Entry->SetNumberField(TEXT("x"), Traversal->TileCoords[Index].X);
+    Entry->SetNumberField(TEXT("y"), Traversal->TileCoords[Index].Y);
+    Entry->SetBoolField(TEXT("success"), bSuccess);
+    Entry->SetStringField(TEXT("message"), Message);
+    if (!ErrorCode.IsEmpty())
+    {
+        Entry->SetStringField(TEXT("error"), ErrorCode);
+    }
+    Entry->SetNumberField(TEXT("loadMs"), Traversal->TileLoadMs);
+    Entry->SetNumberField(TEXT("totalMs"), (FPlatformTime::Seconds() - Traversal->TileStartSeconds) * 1000.0);
+    if (const TSharedPtr<FMcpWorldRegion>* Region = WorldRegions.Find(Traversal->CurrentRegionId))
+    {
+        Entry->SetNumberField(TEXT("regionMemoryMB"), (*Region)->MemoryDeltaBytes / (1024.0 * 1024.0));
+    }
+    // Failed tiles always keep their batch result so the failure can be diagnosed.
+    if (Result.IsValid() && (Traversal->bIncludeResults || !bSuccess))
+    {
+        Entry->SetObjectField(TEXT("result"), Result);
+    }
+    Traversal->TileResults.Add(MakeShared<FJsonValueObject>(Entry));
+
+    if (bSuccess)
+    {
+        Traversal->TilesSucceeded++;
+    }
+    else
+    {
+        Traversal->TilesFailed++;
+        if (Traversal->bStopOnError)
+        {
+            Traversal->bHalted = true;
+        }
+    }
+
+    ReleaseTraversalRegion(*Traversal);
+    Traversal->Current++;
+
+    // Next tile on a later frame: outside the finishing batch's call stack,
+    // and the editor gets to tick between tiles.
+    TWeakObjectPtr<UMcpAutomationBridgeSubsystem> WeakThis(this);
+    AsyncTask(ENamedThreads::GameThread, [WeakThis, Traversal]()
+    {
+        UMcpAutomationBridgeSubsystem* Pinned = WeakThis.Get();
+        if (Pinned && Pinned->ActiveRegionTraversal == Traversal)
+        {
+            Pinned->RunRegionTraversalTile(Traversal);
+        }
+    });
+#endif
+}
+
+/**
+ * Unloads the current tile's region, unless the tile reused a region that
+ * was already loaded; that one only gets its pin state back.
+ */
+void UMcpAutomationBridgeSubsystem::ReleaseTraversalRegion(FMcpRegionTraversal& Traversal)
+{
+#if WITH_EDITOR
+    if (Traversal.CurrentRegionId.IsEmpty())
+    {
+        return;
+    }
+    if (Traversal.bOwnsCurrentRegion)
+    {
+        UnloadWorldRegion(Traversal.CurrentRegionId);
+    }
+    else if (const TSharedPtr<FMcpWorldRegion>* Region = WorldRegions.Find(Traversal.CurrentRegionId))
+    {
+        (*Region)->bPinned = Traversal.bCurrentRegionWasPinned;
+    }
+    Traversal.CurrentRegionId.Reset();
+    Traversal.bOwnsCurrentRegion = false;
+#endif
+}
+
+void UMcpAutomationBridgeSubsystem::FinishRegionTraversal(TSharedPtr<FMcpRegionTraversal> Traversal, const FString& ErrorCode)
+{
+    if (ActiveRegionTraversal == Traversal)
+    {
+        ActiveRegionTraversal.Reset();
+    }
+#if WITH_EDITOR
+    ReleaseTraversalRegion(*Traversal);
+
+    const int32 Skipped = Traversal->Tiles.Num() - Traversal->Current;
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetArrayField(TEXT("tiles"), Traversal->TileResults);
+    Result->SetNumberField(TEXT("tileCount"), Traversal->Tiles.Num());
+    Result->SetNumberField(TEXT("succeeded"), Traversal->TilesSucceeded);
+    Result->SetNumberField(TEXT("failed"), Traversal->TilesFailed);
+    Result->SetNumberField(TEXT("skipped"), Skipped);
+    Result->SetBoolField(TEXT("cancelled"), Traversal->bCancelled);
+    Result->SetNumberField(TEXT("prefetchedPackages"), Traversal->PrefetchedPackages);
+    Result->SetNumberField(TEXT("totalMs"), (FPlatformTime::Seconds() - Traversal->StartSeconds) * 1000.0);
+
+    const bool bSuccess = ErrorCode.IsEmpty() && Traversal->TilesFailed == 0 && Skipped == 0;
+    const FString Message = FString::Printf(TEXT("for_each_region: %d succeeded, %d failed, %d skipped"),
+                                            Traversal->TilesSucceeded, Traversal->TilesFailed, Skipped);
+    SendAutomationResponse(Traversal->Socket, Traversal->RequestId, bSuccess, Message, Result,
+                           !ErrorCode.IsEmpty() ? ErrorCode : (bSuccess ? FString() : FString(TEXT("REGION_PARTIAL_FAILURE"))));
+#endif
+}
+
+void UMcpAutomationBridgeSubsystem::ShutdownWorldRegions()
+{
+    // The editor is going away with its worlds; just drop the handles.
+    ActiveRegionTraversal.Reset();
+    WorldRegions.Empty();
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "McpAutomationBridgeSettings.h"
+
+class FMcpBridgeWebSocket;
+
+/**
+ * A long-running editor operation tracked by the bridge job registry.
+ *
+ * Handlers that kick off work the engine finishes later (screenshots, automation tests,
+ * lighting/navigation builds, stat captures) register a job, reply immediately with its
+ * id, and the registry pushes a "job_completed" automation_event to the requesting client
+ * session once the job reports completion. See McpAutomationBridge_JobHandlers.cpp.
+ */
+struct FMcpAutomationJob
+{
+    FString JobId;
+    FString Kind;
+    FString RequestId;
+    TWeakPtr<FMcpBridgeWebSocket> Socket;
+    /** Client session of the requester; the event follows it across reconnects. */
+    FString ClientSessionId;
+    /** The requester's undo policy when the job began; each Poll runs under it. */
+    EMcpTransactionPolicy TransactionPolicy = EMcpTransactionPolicy::Full;
+
+    double StartSeconds = 0.0;
+    double EndSeconds = 0.0;
+    /** Fail the job with JOB_TIMEOUT after this many seconds. <= 0 waits forever. */
+    double TimeoutSeconds = 0.0;
+
+    bool bCompleted = false;
+    bool bSuccess = false;
+    FString Message;
+    FString ErrorCode;
+    TSharedPtr<FJsonObject> Result;
+
+    /**
+     * Polled once per frame while the job is running. Return true once the work has
+     * finished and bSuccess / Message / Result / ErrorCode have been filled in.
+     * Jobs completed from an engine delegate can leave this unset and call
+     * UMcpAutomationBridgeSubsystem::CompleteAutomationJob instead.
+     */
+    TFunction<bool(FMcpAutomationJob&)> Poll;
+
+    /** Runs exactly once when the job finishes, times out or is dropped. Unbind delegates here. */
+    TFunction<void()> OnFinished;
+
+    double GetElapsedSeconds() const;
+
+    /** Status record used by both the completion event and get_job_status. */
+    TSharedPtr<FJsonObject> ToJson() const;
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+
+#include <atomic>
+
+/**
+ * Bounded lock-free ring buffer for many producers and one draining consumer.
+ *
+ * Each cell carries a sequence number (Vyukov's bounded queue), so producers
+ * only contend on one atomic and never block each other or the consumer.
+ * When the ring is full, Push evicts the oldest element instead of waiting or
+ * growing, which keeps producers wait-free in practice and memory fixed.
+ * Because evicting is a pop, TryPop is also safe from producer threads.
+ *
+ * Capacity is rounded up to a power of two.
+ */
+template <typename T>
+class TMcpBoundedRing
+{
+public:
+    explicit TMcpBoundedRing(uint32 InCapacity)
+        : Capacity(FMath::RoundUpToPowerOfTwo(FMath::Max<uint32>(InCapacity, 2)))
+        , Mask(Capacity - 1)
+        , Cells(MakeUnique<FCell[]>(Capacity))
+    {
+        for (uint32 Index = 0; Index < Capacity; ++Index)
+        {
+            Cells[Index].Sequence.store(Index, std::memory_order_relaxed);
+        }
+    }
+
+    TMcpBoundedRing(const TMcpBoundedRing&) = delete;
+    TMcpBoundedRing& operator=(const TMcpBoundedRing&) = delete;
+
+    /** Enqueues without evicting. Returns false (leaving Value untouched) when full. */
+    bool TryPush(T&& Value)
+    {
+        uint64 Pos = EnqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            FCell& Cell = Cells[Pos & Mask];
+            const uint64 Seq = Cell.Sequence.load(std::memory_order_acquire);
+            const int64 Diff = (int64)Seq - (int64)Pos;
+            if (Diff == 0)
+            {
+                if (EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+                {
+                    Cell.Value = MoveTemp(Value);
+                    Cell.Sequence.store(Pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (Diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                Pos = EnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /** Dequeues the oldest element. Returns false when empty. */
+    bool TryPop(T& OutValue)
+    {
+        uint64 Pos = DequeuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            FCell& Cell = Cells[Pos & Mask];
+            const uint64 Seq = Cell.Sequence.load(std::memory_order_acquire);
+            const int64 Diff = (int64)Seq - (int64)(Pos + 1);
+            if (Diff == 0)
+            {
+                if (DequeuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+                {
+                    OutValue = MoveTemp(Cell.Value);
+                    Cell.Sequence.store(Pos + Capacity, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (Diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                Pos = DequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /** Enqueues, evicting the oldest elements while full. Returns how many were evicted. */
+    uint32 Push(T&& Value)
+    {
+        uint32 Evicted = 0;
+        while (!TryPush(MoveTemp(Value)))
+        {
+            T Oldest;
+            if (TryPop(Oldest))
+            {
+                ++Evicted;
+            }
+        }
+        return Evicted;
+    }
+
+    uint32 GetCapacity() const { return Capacity; }
+
+private:
+    struct FCell
+    {
+        std::atomic<uint64> Sequence{0};
+        T Value;
+    };
+
+    const uint32 Capacity;
+    const uint64 Mask;
+    TUniquePtr<FCell[]> Cells;
+
+    // Separate cache lines so producers and the consumer do not false-share.
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> EnqueuePos{0};
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> DequeuePos{0};
+};
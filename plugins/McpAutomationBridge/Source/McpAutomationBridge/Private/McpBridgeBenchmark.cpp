@@ -0,0 +1,1144 @@
+#include "McpBridgeBenchmark.h"
+
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+#include "McpAutomationBridgeHelpers.h"
+#include "McpAutomationBridgeSubsystem.h"
+#include "McpBridgeWebSocket.h"
+#include "McpConnectionManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include <atomic>
+
+#if WITH_EDITOR
+#include "Editor.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#endif
+
+#ifndef MCP_BENCHMARK_COUNT_ALLOCATIONS
+#define MCP_BENCHMARK_COUNT_ALLOCATIONS !UE_BUILD_SHIPPING
+#endif
+
+namespace
+{
+    const TCHAR* const McpBenchmarkIdToken = TEXT("@@MCP_BENCH_ID@@");
+    const TCHAR* const McpBenchmarkActorTag = TEXT("McpBenchmark");
+    constexpr double McpBenchmarkActorSpacing = 500.0;
+    constexpr int32 McpBenchmarkMaxConnections = 64;
+    constexpr int32 McpBenchmarkMaxConcurrency = 1024;
+    constexpr int32 McpBenchmarkMaxActors = 200000;
+    constexpr int32 McpBenchmarkMaxPayloadBytes = 64 * 1024 * 1024;
+
+    FString McpBenchmarkSerialize(const TSharedRef<FJsonObject>& Object)
+    {
+        FString Out;
+        const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+            TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Out);
+        FJsonSerializer::Serialize(Object, Writer);
+        return Out;
+    }
+
+    /**
+     * Reads type, requestId and success from a bridge frame. The bridge
+     * pretty-prints its replies, so frames are parsed rather than matched.
+     */
+    bool McpBenchmarkReadFrame(const FString& Message, FString& OutType, FString& OutRequestId, bool& bOutSuccess)
+    {
+        TSharedPtr<FJsonObject> Object;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
+        if (!FJsonSerializer::Deserialize(Reader, Object) || !Object.IsValid())
+        {
+            return false;
+        }
+        OutType = GetJsonStringField(Object, TEXT("type"));
+        OutRequestId = GetJsonStringField(Object, TEXT("requestId"));
+        bOutSuccess = GetJsonBoolField(Object, TEXT("success"), false);
+        return true;
+    }
+
+#if MCP_BENCHMARK_COUNT_ALLOCATIONS
+    /**
+     * Forwards to the allocator it wraps and counts Malloc/Realloc calls on
+     * every thread while enabled. Installed over GMalloc only at module
+     * startup behind -McpBenchmarkCountAllocations, never while a run is in
+     * flight, and never removed, so blocks from either side of the swap are
+     * always freed by the allocator that owns them.
+     */
+    class FMcpCountingMalloc final : public FMalloc
+    {
+    public:
+        explicit FMcpCountingMalloc(FMalloc* InInner)
+            : Inner(InInner)
+        {
+        }
+
+        std::atomic<int32> Enabled{0};
+        std::atomic<uint64> Allocations{0};
+
+        virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+        {
+            Note();
+            return Inner->Malloc(Count, Alignment);
+        }
+        virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+        {
+            Note();
+            return Inner->TryMalloc(Count, Alignment);
+        }
+        virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            if (Count > 0)
+            {
+                Note();
+            }
+            return Inner->Realloc(Original, Count, Alignment);
+        }
+        virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            if (Count > 0)
+            {
+                Note();
+            }
+            return Inner->TryRealloc(Original, Count, Alignment);
+        }
+        virtual void Free(void* Original) override { Inner->Free(Original); }
+        virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+        virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+        virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+        virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+        virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+        virtual void InitializeStatsMetadata() override { Inner->InitializeStatsMetadata(); }
+        virtual void UpdateStats() override { Inner->UpdateStats(); }
+        virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+        virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+        virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+        virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+        virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+    private:
+        void Note()
+        {
+            if (Enabled.load(std::memory_order_relaxed) > 0)
+            {
+                Allocations.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        FMalloc* Inner;
+    };
+
+    FMcpCountingMalloc* McpCountingMalloc = nullptr;
+#endif
+
+    /** Starts counting for one run; false when the proxy is not installed. Game thread. */
+    bool McpBeginAllocationCounting()
+    {
+#if MCP_BENCHMARK_COUNT_ALLOCATIONS
+        if (McpCountingMalloc)
+        {
+            McpCountingMalloc->Enabled.fetch_add(1);
+            return true;
+        }
+#endif
+        return false;
+    }
+
+    void McpEndAllocationCounting()
+    {
+#if MCP_BENCHMARK_COUNT_ALLOCATIONS
+        if (McpCountingMalloc)
+        {
+            McpCountingMalloc->Enabled.fetch_sub(1);
+        }
+#endif
+    }
+
+    uint64 McpAllocationCount()
+    {
+#if MCP_BENCHMARK_COUNT_ALLOCATIONS
+        return McpCountingMalloc ? McpCountingMalloc->Allocations.load(std::memory_order_relaxed) : 0;
+#else
+        return 0;
+#endif
+    }
+
+    TSharedRef<FJsonObject> McpBenchmarkPhaseSpec(const TCHAR* Name, const TCHAR* Kind, int32 Requests, int32 Concurrency)
+    {
+        TSharedRef<FJsonObject> Phase = MakeShared<FJsonObject>();
+        Phase->SetStringField(TEXT("name"), Name);
+        Phase->SetStringField(TEXT("kind"), Kind);
+        Phase->SetNumberField(TEXT("requests"), Requests);
+        Phase->SetNumberField(TEXT("concurrency"), Concurrency);
+        Phase->SetNumberField(TEXT("connections"), FMath::Min(Concurrency, 4));
+        Phase->SetNumberField(TEXT("warmup"), FMath::Max(1, Requests / 20));
+        return Phase;
+    }
+}
+
+void FMcpBridgeBenchmark::InstallAllocationCounter()
+{
+#if MCP_BENCHMARK_COUNT_ALLOCATIONS
+    if (!McpCountingMalloc && GMalloc && FParse::Param(FCommandLine::Get(), TEXT("McpBenchmarkCountAllocations")))
+    {
+        McpCountingMalloc = new FMcpCountingMalloc(GMalloc);
+        GMalloc = McpCountingMalloc;
+        UE_LOG(LogMcpAutomationBridgeSubsystem, Log, TEXT("Bridge benchmark allocation counting installed."));
+    }
+#endif
+}
+
+TSharedPtr<FJsonObject> FMcpBridgeBenchmark::MakeDefaultSpec()
+{
+    TArray<TSharedPtr<FJsonValue>> Phases;
+    Phases.Add(MakeShared<FJsonValueObject>(McpBenchmarkPhaseSpec(TEXT("tiny_rpc_serial"), TEXT("tiny_rpc"), 1000, 1)));
+    Phases.Add(MakeShared<FJsonValueObject>(McpBenchmarkPhaseSpec(TEXT("tiny_rpc"), TEXT("tiny_rpc"), 5000, 16)));
+
+    TSharedRef<FJsonObject> Large = McpBenchmarkPhaseSpec(TEXT("large_payload"), TEXT("large_payload"), 200, 4);
+    Large->SetNumberField(TEXT("payloadBytes"), 1024 * 1024);
+    Phases.Add(MakeShared<FJsonValueObject>(Large));
+
+    TSharedRef<FJsonObject> Query = McpBenchmarkPhaseSpec(TEXT("list_query"), TEXT("list_query"), 500, 4);
+    Query->SetNumberField(TEXT("actorCount"), 5000);
+    Query->SetNumberField(TEXT("queryLimit"), 100);
+    Phases.Add(MakeShared<FJsonValueObject>(Query));
+
+    TSharedPtr<FJsonObject> Spec = MakeShared<FJsonObject>();
+    Spec->SetArrayField(TEXT("phases"), Phases);
+    return Spec;
+}
+
+TSharedPtr<FMcpBridgeBenchmark> FMcpBridgeBenchmark::Create(const TSharedPtr<FJsonObject>& Spec,
+                                                           const TSharedPtr<FMcpConnectionManager>& InConnectionManager,
+                                                           FString& OutError)
+{
+    if (!InConnectionManager.IsValid())
+    {
+        OutError = TEXT("Connection manager not initialized");
+        return nullptr;
+    }
+    const FString LoopbackUrl = InConnectionManager->GetLoopbackUrl();
+    if (LoopbackUrl.IsEmpty())
+    {
+        OutError = TEXT("The bridge is not listening; the benchmark needs a listen port (bAlwaysListen)");
+        return nullptr;
+    }
+
+    TSharedPtr<FJsonObject> EffectiveSpec = Spec;
+    const TArray<TSharedPtr<FJsonValue>>* PhaseValues = nullptr;
+    if (!EffectiveSpec.IsValid() || !EffectiveSpec->TryGetArrayField(TEXT("phases"), PhaseValues) || PhaseValues->Num() == 0)
+    {
+        const TSharedPtr<FJsonObject> Defaults = MakeDefaultSpec();
+        if (EffectiveSpec.IsValid())
+        {
+            // Keep top-level options (countAllocations, timeouts) from the caller.
+            for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : EffectiveSpec->Values)
+            {
+                if (Pair.Key != TEXT("phases"))
+                {
+                    Defaults->Values.Add(Pair.Key, Pair.Value);
+                }
+            }
+        }
+        EffectiveSpec = Defaults;
+        EffectiveSpec->TryGetArrayField(TEXT("phases"), PhaseValues);
+    }
+
+    TSharedPtr<FMcpBridgeBenchmark> Benchmark = MakeShared<FMcpBridgeBenchmark>();
+    Benchmark->ConnectionManager = InConnectionManager;
+    Benchmark->Url = LoopbackUrl;
+    Benchmark->bCountAllocations = GetJsonBoolField(EffectiveSpec, TEXT("countAllocations"), false);
+    Benchmark->ConnectTimeoutSeconds = FMath::Max(1.0, GetJsonNumberField(EffectiveSpec, TEXT("connectTimeoutSeconds"), 10.0));
+    Benchmark->StallTimeoutSeconds = FMath::Max(1.0, GetJsonNumberField(EffectiveSpec, TEXT("stallTimeoutSeconds"), 30.0));
+
+    for (int32 Index = 0; Index < PhaseValues->Num(); ++Index)
+    {
+        const TSharedPtr<FJsonObject>* PhaseObject = nullptr;
+        if (!(*PhaseValues)[Index].IsValid() || !(*PhaseValues)[Index]->TryGetObject(PhaseObject))
+        {
+            OutError = FString::Printf(TEXT("phases[%d] must be an object"), Index);
+            return nullptr;
+        }
+        if (!Benchmark->ParsePhase(*PhaseObject, Index, OutError))
+        {
+            return nullptr;
+        }
+    }
+    return Benchmark;
+}
+
+bool FMcpBridgeBenchmark::ParsePhase(const TSharedPtr<FJsonObject>& Object, int32 Index, FString& OutError)
+{
+    FPhase& Phase = Phases.AddDefaulted_GetRef();
+    Phase.Kind = GetJsonStringField(Object, TEXT("kind")).ToLower();
+    Phase.Name = GetJsonStringField(Object, TEXT("name"));
+    if (Phase.Name.IsEmpty())
+    {
+        Phase.Name = FString::Printf(TEXT("%s_%d"), *Phase.Kind, Index);
+    }
+    Phase.Requests = FMath::Max(0, GetJsonIntField(Object, TEXT("requests"), 0));
+    Phase.DurationSeconds = FMath::Max(0.0, GetJsonNumberField(Object, TEXT("durationSeconds"), 0.0));
+    if (Phase.Requests == 0 && Phase.DurationSeconds <= 0.0)
+    {
+        Phase.Requests = 1000;
+    }
+    Phase.WarmupRequests = FMath::Max(0, GetJsonIntField(Object, TEXT("warmup"), 0));
+    Phase.Concurrency = FMath::Clamp(GetJsonIntField(Object, TEXT("concurrency"), 1), 1, McpBenchmarkMaxConcurrency);
+    Phase.Connections = FMath::Clamp(GetJsonIntField(Object, TEXT("connections"), 1), 1,
+                                     FMath::Min(Phase.Concurrency, McpBenchmarkMaxConnections));
+    Phase.PayloadBytes = FMath::Clamp(GetJsonIntField(Object, TEXT("payloadBytes"), 1024 * 1024), 0, McpBenchmarkMaxPayloadBytes);
+    Phase.ActorCount = FMath::Clamp(GetJsonIntField(Object, TEXT("actorCount"), 1000), 0, McpBenchmarkMaxActors);
+    Phase.QueryLimit = FMath::Max(0, GetJsonIntField(Object, TEXT("queryLimit"), 100));
+    const TSharedPtr<FJsonObject>* Query = nullptr;
+    if (Object->TryGetObjectField(TEXT("query"), Query))
+    {
+        Phase.Query = *Query;
+    }
+    Phase.ReplayFile = GetJsonStringField(Object, TEXT("file"));
+    const TArray<TSharedPtr<FJsonValue>>* Requests = nullptr;
+    if (Object->TryGetArrayField(TEXT("requests"), Requests))
+    {
+        Phase.ReplayRequests = *Requests;
+    }
+
+    if (!BuildTemplates(Phase, OutError))
+    {
+        OutError = FString::Printf(TEXT("phases[%d] (%s): %s"), Index, *Phase.Name, *OutError);
+        return false;
+    }
+    return true;
+}
+
+bool FMcpBridgeBenchmark::AddTemplate(FPhase& Phase, const FString& Action, const TSharedPtr<FJsonObject>& Payload)
+{
+    if (Action.IsEmpty())
+    {
+        return false;
+    }
+    TSharedRef<FJsonObject> Envelope = MakeShared<FJsonObject>();
+    Envelope->SetStringField(TEXT("type"), TEXT("automation_request"));
+    Envelope->SetStringField(TEXT("requestId"), McpBenchmarkIdToken);
+    Envelope->SetStringField(TEXT("action"), Action);
+    Envelope->SetObjectField(TEXT("payload"), Payload.IsValid() ? Payload : MakeShared<FJsonObject>());
+
+    const FString Serialized = McpBenchmarkSerialize(Envelope);
+    FString Prefix;
+    FString Suffix;
+    if (!Serialized.Split(McpBenchmarkIdToken, &Prefix, &Suffix, ESearchCase::CaseSensitive))
+    {
+        return false;
+    }
+    Phase.Templates.Emplace(MoveTemp(Prefix), MoveTemp(Suffix));
+    return true;
+}
+
+bool FMcpBridgeBenchmark::BuildTemplates(FPhase& Phase, FString& OutError)
+{
+    if (Phase.Kind == TEXT("tiny_rpc"))
+    {
+        AddTemplate(Phase, TEXT("bridge_echo"), nullptr);
+        return true;
+    }
+    if (Phase.Kind == TEXT("large_payload"))
+    {
+        TSharedPtr<FJsonObject> Payload = MakeShared<FJsonObject>();
+        Payload->SetStringField(TEXT("data"), FString::ChrN(Phase.PayloadBytes, TEXT('x')));
+        AddTemplate(Phase, TEXT("bridge_echo"), Payload);
+        return true;
+    }
+    if (Phase.Kind == TEXT("list_query"))
+    {
+#if WITH_EDITOR
+        if (Phase.Query.IsValid())
+        {
+            AddTemplate(Phase, TEXT("query_actors"), Phase.Query);
+            return true;
+        }
+        TArray<TSharedPtr<FJsonValue>> Fields;
+        Fields.Add(MakeShared<FJsonValueString>(TEXT("name")));
+        Fields.Add(MakeShared<FJsonValueString>(TEXT("location")));
+
+        TSharedPtr<FJsonObject> ByTag = MakeShared<FJsonObject>();
+        TArray<TSharedPtr<FJsonValue>> Tags;
+        Tags.Add(MakeShared<FJsonValueString>(McpBenchmarkActorTag));
+        ByTag->SetArrayField(TEXT("tags"), Tags);
+        ByTag->SetArrayField(TEXT("fields"), Fields);
+        ByTag->SetNumberField(TEXT("limit"), Phase.QueryLimit);
+        AddTemplate(Phase, TEXT("query_actors"), ByTag);
+
+        // A radius around the middle of the spawned grid covering ~50 actors.
+        const int32 Side = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(double(Phase.ActorCount))));
+        const double Middle = (Side - 1) * McpBenchmarkActorSpacing * 0.5;
+        TSharedPtr<FJsonObject> Center = MakeShared<FJsonObject>();
+        Center->SetNumberField(TEXT("x"), Middle);
+        Center->SetNumberField(TEXT("y"), Middle);
+        Center->SetNumberField(TEXT("z"), 0.0);
+        TSharedPtr<FJsonObject> ByRadius = MakeShared<FJsonObject>();
+        ByRadius->SetObjectField(TEXT("center"), Center);
+        ByRadius->SetNumberField(TEXT("radius"), McpBenchmarkActorSpacing * 4.0);
+        ByRadius->SetArrayField(TEXT("fields"), Fields);
+        ByRadius->SetNumberField(TEXT("limit"), Phase.QueryLimit);
+        ByRadius->SetStringField(TEXT("sort"), TEXT("distance"));
+        AddTemplate(Phase, TEXT("query_actors"), ByRadius);
+        return true;
+#else
+        OutError = TEXT("list_query requires an editor build");
+        return false;
+#endif
+    }
+    if (Phase.Kind == TEXT("replay"))
+    {
+        TArray<TSharedPtr<FJsonObject>> Recorded;
+        for (const TSharedPtr<FJsonValue>& Value : Phase.ReplayRequests)
+        {
+            const TSharedPtr<FJsonObject>* Object = nullptr;
+            if (Value.IsValid() && Value->TryGetObject(Object))
+            {
+                Recorded.Add(*Object);
+            }
+        }
+        if (!Phase.ReplayFile.IsEmpty())
+        {
+            FString Path = Phase.ReplayFile;
+            if (FPaths::IsRelative(Path))
+            {
+                Path = FPaths::Combine(FPaths::ProjectDir(), Path);
+            }
+            TArray<FString> Lines;
+            if (!FFileHelper::LoadFileToStringArray(Lines, *Path))
+            {
+                OutError = FString::Printf(TEXT("could not read replay file %s"), *Path);
+                return false;
+            }
+            for (const FString& Line : Lines)
+            {
+                const FString Trimmed = Line.TrimStartAndEnd();
+                if (Trimmed.IsEmpty() || Trimmed.StartsWith(TEXT("#")))
+                {
+                    continue;
+                }
+                TSharedPtr<FJsonObject> Object;
+                const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Trimmed);
+                if (FJsonSerializer::Deserialize(Reader, Object) && Object.IsValid())
+                {
+                    Recorded.Add(Object);
+                }
+            }
+        }
+        for (const TSharedPtr<FJsonObject>& Object : Recorded)
+        {
+            const FString Type = GetJsonStringField(Object, TEXT("type"));
+            if (!Type.IsEmpty() && !Type.Equals(TEXT("automation_request"), ESearchCase::IgnoreCase))
+            {
+                continue;
+            }
+            const TSharedPtr<FJsonObject>* Payload = nullptr;
+            Object->TryGetObjectField(TEXT("payload"), Payload);
+            AddTemplate(Phase, GetJsonStringField(Object, TEXT("action")), Payload ? *Payload : nullptr);
+        }
+        if (Phase.Templates.Num() == 0)
+        {
+            OutError = TEXT("replay needs a file or requests array with at least one {action, payload}");
+            return false;
+        }
+        return true;
+    }
+    OutError = FString::Printf(TEXT("unknown kind '%s' (tiny_rpc, large_payload, list_query, replay)"), *Phase.Kind);
+    return false;
+}
+
+FMcpBridgeBenchmark::~FMcpBridgeBenchmark()
+{
+    if (!bFinished && State != EState::Idle && !IsEngineExitRequested())
+    {
+        Finish(TEXT("Benchmark dropped"));
+    }
+}
+
+void FMcpBridgeBenchmark::Start()
+{
+    check(IsInGameThread());
+    if (State != EState::Idle)
+    {
+        return;
+    }
+    TSharedPtr<FMcpConnectionManager> Manager = ConnectionManager.Pin();
+    if (!Manager.IsValid())
+    {
+        Finish(TEXT("Connection manager not initialized"));
+        return;
+    }
+
+    StartSeconds = FPlatformTime::Seconds();
+    LastProgressSeconds = StartSeconds;
+    IdPrefix = FString::Printf(TEXT("mcpbench-%s-"), *FGuid::NewGuid().ToString(EGuidFormats::Short));
+    if (bCountAllocations)
+    {
+        bCountAllocations = McpBeginAllocationCounting();
+    }
+
+    int32 NumClients = 1;
+    for (const FPhase& Phase : Phases)
+    {
+        NumClients = FMath::Max(NumClients, Phase.Connections);
+    }
+
+    State = EState::Connecting;
+    TWeakPtr<FMcpBridgeBenchmark> WeakSelf = AsShared();
+    const bool bTls = Url.StartsWith(TEXT("wss://"));
+    for (int32 ClientIndex = 0; ClientIndex < NumClients; ++ClientIndex)
+    {
+        FClient& Client = Clients.AddDefaulted_GetRef();
+        Client.LoopbackKey = Manager->IssueLoopbackKey();
+        Client.Socket = MakeShared<FMcpBridgeWebSocket>(Url, TEXT("mcp-automation"), TMap<FString, FString>(), bTls);
+        Client.Socket->InitializeWeakSelf(Client.Socket);
+        Client.Socket->OnConnected().AddLambda([WeakSelf, ClientIndex](TSharedPtr<FMcpBridgeWebSocket>)
+        {
+            if (TSharedPtr<FMcpBridgeBenchmark> Self = WeakSelf.Pin())
+            {
+                Self->OnClientConnected(ClientIndex);
+            }
+        });
+        Client.Socket->OnMessage().AddLambda([WeakSelf, ClientIndex](TSharedPtr<FMcpBridgeWebSocket>, const FString& Message)
+        {
+            if (TSharedPtr<FMcpBridgeBenchmark> Self = WeakSelf.Pin())
+            {
+                Self->OnClientMessage(ClientIndex, Message);
+            }
+        });
+        Client.Socket->OnClosed().AddLambda([WeakSelf, ClientIndex](TSharedPtr<FMcpBridgeWebSocket>, int32 Code, const FString& Reason, bool)
+        {
+            if (TSharedPtr<FMcpBridgeBenchmark> Self = WeakSelf.Pin())
+            {
+                Self->OnClientClosed(ClientIndex, FString::Printf(TEXT("%d %s"), Code, *Reason));
+            }
+        });
+        Client.Socket->OnConnectionError().AddLambda([WeakSelf, ClientIndex](const FString& Reason)
+        {
+            if (TSharedPtr<FMcpBridgeBenchmark> Self = WeakSelf.Pin())
+            {
+                Self->OnClientClosed(ClientIndex, Reason);
+            }
+        });
+        Client.Socket->Connect();
+    }
+}
+
+void FMcpBridgeBenchmark::OnClientConnected(int32 ClientIndex)
+{
+    if (State != EState::Connecting || !Clients.IsValidIndex(ClientIndex))
+    {
+        return;
+    }
+    TSharedRef<FJsonObject> Hello = MakeShared<FJsonObject>();
+    Hello->SetStringField(TEXT("type"), TEXT("bridge_hello"));
+    Hello->SetStringField(TEXT("loopbackKey"), Clients[ClientIndex].LoopbackKey);
+    Clients[ClientIndex].Socket->Send(McpBenchmarkSerialize(Hello));
+}
+
+void FMcpBridgeBenchmark::OnClientMessage(int32 ClientIndex, const FString& Message)
+{
+    if (bFinished || !Clients.IsValidIndex(ClientIndex))
+    {
+        return;
+    }
+    // Stamped before parsing so large replies do not charge the client's parse to the bridge.
+    const double Now = FPlatformTime::Seconds();
+    FClient& Client = Clients[ClientIndex];
+
+    FString Type;
+    FString RequestId;
+    bool bSuccess = false;
+    if (!McpBenchmarkReadFrame(Message, Type, RequestId, bSuccess))
+    {
+        return;
+    }
+    if (Type == TEXT("bridge_ack"))
+    {
+        Client.bReady = true;
+        return;
+    }
+    if (Type == TEXT("bridge_error"))
+    {
+        Finish(FString::Printf(TEXT("Bridge rejected benchmark client: %s"), *Message.Left(200)));
+        return;
+    }
+    if (Type != TEXT("automation_response"))
+    {
+        return;
+    }
+
+    int64 Sequence = 0;
+    if (!RequestId.StartsWith(IdPrefix) || !LexTryParseString(Sequence, *RequestId.RightChop(IdPrefix.Len())))
+    {
+        return;
+    }
+    FInFlight Sent;
+    if (!InFlight.RemoveAndCopyValue(Sequence, Sent))
+    {
+        return;
+    }
+    Client.InFlight = FMath::Max(0, Client.InFlight - 1);
+    if (!Phases.IsValidIndex(PhaseIndex))
+    {
+        return;
+    }
+
+    LastProgressSeconds = Now;
+    FPhase& Phase = Phases[PhaseIndex];
+    ++Phase.Completed;
+    if (Sent.bMeasured)
+    {
+        Phase.Latency.Record(Now - Sent.SentSeconds);
+        ++Phase.Measured;
+    }
+    if (!bSuccess)
+    {
+        ++Phase.Errors;
+        if (Phase.FirstError.IsEmpty())
+        {
+            Phase.FirstError = Message.Left(300);
+        }
+    }
+    Pump();
+}
+
+void FMcpBridgeBenchmark::OnClientClosed(int32 ClientIndex, const FString& Reason)
+{
+    if (bFinished)
+    {
+        return;
+    }
+    Finish(FString::Printf(TEXT("Benchmark connection %d closed: %s"), ClientIndex, *Reason));
+}
+
+bool FMcpBridgeBenchmark::Tick()
+{
+    if (bFinished)
+    {
+        return true;
+    }
+    const double Now = FPlatformTime::Seconds();
+    if (State == EState::Connecting)
+    {
+        bool bAllReady = true;
+        for (const FClient& Client : Clients)
+        {
+            bAllReady &= Client.bReady;
+        }
+        if (bAllReady)
+        {
+            State = EState::Running;
+            BeginPhase(0);
+        }
+        else if (Now - StartSeconds > ConnectTimeoutSeconds)
+        {
+            Finish(FString::Printf(TEXT("Benchmark clients did not connect to %s within %.0fs"), *Url, ConnectTimeoutSeconds));
+        }
+        return bFinished;
+    }
+    if (State == EState::Running)
+    {
+        // Duration-bound phases end on the clock even if no response arrives this frame.
+        Pump();
+        if (!bFinished && InFlight.Num() > 0 && Now - LastProgressSeconds > StallTimeoutSeconds)
+        {
+            Finish(FString::Printf(TEXT("Phase %s stalled: no response for %.0fs with %d in flight"),
+                                   *Phases[PhaseIndex].Name, StallTimeoutSeconds, InFlight.Num()));
+        }
+    }
+    return bFinished;
+}
+
+void FMcpBridgeBenchmark::BeginPhase(int32 Index)
+{
+    PhaseIndex = Index;
+    if (!Phases.IsValidIndex(Index))
+    {
+        Finish(FString());
+        return;
+    }
+    FPhase& Phase = Phases[Index];
+    if (Phase.Kind == TEXT("list_query"))
+    {
+        SpawnQueryActors(Phase);
+    }
+    Phase.bRan = true;
+    Phase.StartSeconds = FPlatformTime::Seconds();
+    Phase.MeasureStartSeconds = Phase.StartSeconds;
+    Phase.AllocationsAtMeasureStart = McpAllocationCount();
+    LastProgressSeconds = Phase.StartSeconds;
+    UE_LOG(LogMcpAutomationBridgeSubsystem, Log, TEXT("Bridge benchmark: phase %s (%s, %d requests, %.1fs, concurrency %d over %d connections)"),
+           *Phase.Name, *Phase.Kind, Phase.Requests, Phase.DurationSeconds, Phase.Concurrency, Phase.Connections);
+    Pump();
+}
+
+void FMcpBridgeBenchmark::Pump()
+{
+    if (bFinished || State != EState::Running || !Phases.IsValidIndex(PhaseIndex))
+    {
+        return;
+    }
+    FPhase& Phase = Phases[PhaseIndex];
+    while (InFlight.Num() < Phase.Concurrency && SendNext())
+    {
+    }
+    if (!bFinished && InFlight.Num() == 0)
+    {
+        EndPhase();
+    }
+}
+
+bool FMcpBridgeBenchmark::SendNext()
+{
+    FPhase& Phase = Phases[PhaseIndex];
+    const double Now = FPlatformTime::Seconds();
+    const int32 Total = Phase.WarmupRequests + Phase.Requests;
+    if (Phase.Requests > 0 && Phase.Issued >= Total)
+    {
+        return false;
+    }
+    if (Phase.DurationSeconds > 0.0 && Phase.Issued >= Phase.WarmupRequests &&
+        Now - Phase.MeasureStartSeconds >= Phase.DurationSeconds)
+    {
+        return false;
+    }
+
+    const bool bMeasured = Phase.Issued >= Phase.WarmupRequests;
+    if (bMeasured && Phase.Issued == Phase.WarmupRequests && Phase.WarmupRequests > 0)
+    {
+        Phase.MeasureStartSeconds = Now;
+        Phase.AllocationsAtMeasureStart = McpAllocationCount();
+    }
+
+    FClient& Client = Clients[Phase.Issued % Phase.Connections];
+    const TPair<FString, FString>& Template = Phase.Templates[Phase.Issued % Phase.Templates.Num()];
+    const int64 Sequence = NextSequence++;
+    const FString Message = Template.Key + IdPrefix + LexToString(Sequence) + Template.Value;
+
+    FInFlight& Entry = InFlight.Add(Sequence);
+    Entry.SentSeconds = FPlatformTime::Seconds();
+    Entry.bMeasured = bMeasured;
+    ++Client.InFlight;
+    ++Phase.Issued;
+    if (bMeasured)
+    {
+        Phase.RequestBytes += Message.Len();
+    }
+    if (!Client.Socket->Send(Message))
+    {
+        Finish(FString::Printf(TEXT("Send failed during phase %s"), *Phase.Name));
+        return false;
+    }
+    return true;
+}
+
+void FMcpBridgeBenchmark::EndPhase()
+{
+    FPhase& Phase = Phases[PhaseIndex];
+    Phase.EndSeconds = FPlatformTime::Seconds();
+    Phase.Allocations = McpAllocationCount() - Phase.AllocationsAtMeasureStart;
+    DestroyQueryActors();
+    UE_LOG(LogMcpAutomationBridgeSubsystem, Log, TEXT("Bridge benchmark: phase %s done, %d requests, %d errors, p50 %.2fms p99 %.2fms"),
+           *Phase.Name, Phase.Measured, Phase.Errors, Phase.Latency.Percentile(50.0) * 1000.0,
+           Phase.Latency.Percentile(99.0) * 1000.0);
+    BeginPhase(PhaseIndex + 1);
+}
+
+void FMcpBridgeBenchmark::SpawnQueryActors(FPhase& Phase)
+{
+#if WITH_EDITOR
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    if (!World)
+    {
+        return;
+    }
+    const int32 Side = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(double(Phase.ActorCount))));
+    FActorSpawnParameters Params;
+    Params.ObjectFlags |= RF_Transient;
+    Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    QueryActors.Reserve(Phase.ActorCount);
+    for (int32 Index = 0; Index < Phase.ActorCount; ++Index)
+    {
+        const FVector Location((Index % Side) * McpBenchmarkActorSpacing, (Index / Side) * McpBenchmarkActorSpacing, 0.0);
+        AStaticMeshActor* Actor = World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator, Params);
+        if (Actor)
+        {
+            Actor->Tags.Add(McpBenchmarkActorTag);
+            QueryActors.Add(Actor);
+        }
+    }
+#endif
+}
+
+void FMcpBridgeBenchmark::DestroyQueryActors()
+{
+#if WITH_EDITOR
+    for (const TWeakObjectPtr<AActor>& Actor : QueryActors)
+    {
+        if (AActor* Live = Actor.Get())
+        {
+            if (UWorld* World = Live->GetWorld())
+            {
+                World->DestroyActor(Live);
+            }
+        }
+    }
+#endif
+    QueryActors.Reset();
+}
+
+void FMcpBridgeBenchmark::Cancel(const FString& Reason)
+{
+    if (!bFinished)
+    {
+        Finish(Reason.IsEmpty() ? TEXT("Benchmark cancelled") : Reason);
+    }
+}
+
+void FMcpBridgeBenchmark::Finish(const FString& FailureReason)
+{
+    if (bFinished)
+    {
+        return;
+    }
+    bFinished = true;
+    State = EState::Done;
+    Error = FailureReason;
+    EndSeconds = FPlatformTime::Seconds();
+    if (Phases.IsValidIndex(PhaseIndex) && Phases[PhaseIndex].EndSeconds <= 0.0)
+    {
+        Phases[PhaseIndex].EndSeconds = EndSeconds;
+        Phases[PhaseIndex].Allocations = McpAllocationCount() - Phases[PhaseIndex].AllocationsAtMeasureStart;
+    }
+    DestroyQueryActors();
+    InFlight.Reset();
+
+    for (FClient& Client : Clients)
+    {
+        if (Client.Socket.IsValid())
+        {
+            Client.Socket->OnConnected().Clear();
+            Client.Socket->OnMessage().Clear();
+            Client.Socket->OnClosed().Clear();
+            Client.Socket->OnConnectionError().Clear();
+            Client.Socket->Close(1000, TEXT("Benchmark finished"));
+        }
+    }
+    if (TSharedPtr<FMcpConnectionManager> Manager = ConnectionManager.Pin())
+    {
+        for (const FClient& Client : Clients)
+        {
+            Manager->RevokeLoopbackKey(Client.LoopbackKey);
+        }
+    }
+    if (bCountAllocations)
+    {
+        McpEndAllocationCounting();
+    }
+    if (!Error.IsEmpty())
+    {
+        UE_LOG(LogMcpAutomationBridgeSubsystem, Warning, TEXT("Bridge benchmark failed: %s"), *Error);
+    }
+}
+
+float FMcpBridgeBenchmark::GetProgressPercent() const
+{
+    if (bFinished)
+    {
+        return 100.0f;
+    }
+    if (Phases.Num() == 0 || !Phases.IsValidIndex(PhaseIndex))
+    {
+        return 0.0f;
+    }
+    const FPhase& Phase = Phases[PhaseIndex];
+    double Fraction = 0.0;
+    if (Phase.Requests > 0)
+    {
+        Fraction = double(Phase.Completed) / double(Phase.WarmupRequests + Phase.Requests);
+    }
+    else if (Phase.DurationSeconds > 0.0)
+    {
+        Fraction = (FPlatformTime::Seconds() - Phase.MeasureStartSeconds) / Phase.DurationSeconds;
+    }
+    return float(100.0 * (PhaseIndex + FMath::Clamp(Fraction, 0.0, 1.0)) / Phases.Num());
+}
+
+TSharedPtr<FJsonObject> FMcpBridgeBenchmark::GetReport() const
+{
+    TSharedPtr<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetStringField(TEXT("loopbackUrl"), Url);
+    Report->SetBoolField(TEXT("completed"), Succeeded());
+    if (!Error.IsEmpty())
+    {
+        Report->SetStringField(TEXT("error"), Error);
+    }
+    const double End = bFinished ? EndSeconds : FPlatformTime::Seconds();
+    Report->SetNumberField(TEXT("totalSeconds"), StartSeconds > 0.0 ? End - StartSeconds : 0.0);
+    Report->SetBoolField(TEXT("allocationCounting"), bCountAllocations);
+
+    TArray<TSharedPtr<FJsonValue>> PhaseArray;
+    for (const FPhase& Phase : Phases)
+    {
+        TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetStringField(TEXT("name"), Phase.Name);
+        Entry->SetStringField(TEXT("kind"), Phase.Kind);
+        Entry->SetBoolField(TEXT("ran"), Phase.bRan);
+        Entry->SetNumberField(TEXT("concurrency"), Phase.Concurrency);
+        Entry->SetNumberField(TEXT("connections"), Phase.Connections);
+        Entry->SetNumberField(TEXT("warmup"), Phase.WarmupRequests);
+        Entry->SetNumberField(TEXT("requests"), Phase.Measured);
+        Entry->SetNumberField(TEXT("errors"), Phase.Errors);
+        if (!Phase.FirstError.IsEmpty())
+        {
+            Entry->SetStringField(TEXT("firstError"), Phase.FirstError);
+        }
+        if (Phase.Kind == TEXT("large_payload"))
+        {
+            Entry->SetNumberField(TEXT("payloadBytes"), Phase.PayloadBytes);
+        }
+        if (Phase.Kind == TEXT("list_query"))
+        {
+            Entry->SetNumberField(TEXT("actorCount"), Phase.ActorCount);
+            Entry->SetNumberField(TEXT("queryLimit"), Phase.QueryLimit);
+        }
+        const double PhaseEnd = Phase.EndSeconds > 0.0 ? Phase.EndSeconds : End;
+        const double Seconds = Phase.bRan ? FMath::Max(0.0, PhaseEnd - Phase.MeasureStartSeconds) : 0.0;
+        Entry->SetNumberField(TEXT("seconds"), Seconds);
+        Entry->SetNumberField(TEXT("requestsPerSecond"), Seconds > 0.0 ? Phase.Measured / Seconds : 0.0);
+        Entry->SetNumberField(TEXT("meanRequestChars"), Phase.Measured > 0 ? double(Phase.RequestBytes) / Phase.Measured : 0.0);
+        Entry->SetObjectField(TEXT("latency"), Phase.Latency.ToJson());
+        if (bCountAllocations && Phase.Measured > 0)
+        {
+            Entry->SetNumberField(TEXT("allocations"), double(Phase.Allocations));
+            Entry->SetNumberField(TEXT("allocationsPerRequest"), double(Phase.Allocations) / Phase.Measured);
+        }
+        PhaseArray.Add(MakeShared<FJsonValueObject>(Entry));
+    }
+    Report->SetArrayField(TEXT("phases"), PhaseArray);
+    return Report;
+}
+
+#if WITH_EDITOR
+namespace
+{
+    /** The run started by Mcp.Benchmark; one at a time. */
+    TSharedPtr<FMcpBridgeBenchmark> McpConsoleBenchmark;
+    FTSTicker::FDelegateHandle McpConsoleBenchmarkTicker;
+
+    void McpWriteBenchmarkReport(const TSharedPtr<FJsonObject>& Report, const FString& ReportPath)
+    {
+        FString Text;
+        const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Text);
+        FJsonSerializer::Serialize(Report.ToSharedRef(), Writer);
+        if (FFileHelper::SaveStringToFile(Text, *ReportPath))
+        {
+            UE_LOG(LogMcpAutomationBridgeSubsystem, Display, TEXT("Bridge benchmark report written to %s"), *ReportPath);
+        }
+        else
+        {
+            UE_LOG(LogMcpAutomationBridgeSubsystem, Error, TEXT("Could not write bridge benchmark report to %s"), *ReportPath);
+        }
+    }
+
+    /**
+     * Mcp.Benchmark [SpecFile.json] [ReportFile.json]
+     *
+     * Runs the bridge benchmark from the console or -ExecCmds, so CI can run
+     * it headless (-nullrhi -unattended). With -McpBenchmarkExit on the
+     * command line the editor exits afterwards, with status 1 on failure.
+     */
+    void McpRunBenchmarkCommand(const TArray<FString>& Args)
+    {
+        if (McpConsoleBenchmark.IsValid())
+        {
+            UE_LOG(LogMcpAutomationBridgeSubsystem, Warning, TEXT("A bridge benchmark is already running"));
+            return;
+        }
+
+        TSharedPtr<FJsonObject> Spec;
+        if (Args.Num() > 0 && !Args[0].IsEmpty() && Args[0] != TEXT("default"))
+        {
+            FString Text;
+            if (!FFileHelper::LoadFileToString(Text, *Args[0]))
+            {
+                UE_LOG(LogMcpAutomationBridgeSubsystem, Error, TEXT("Could not read benchmark spec %s"), *Args[0]);
+                return;
+            }
+            const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+            if (!FJsonSerializer::Deserialize(Reader, Spec) || !Spec.IsValid())
+            {
+                UE_LOG(LogMcpAutomationBridgeSubsystem, Error, TEXT("Benchmark spec %s is not a JSON object"), *Args[0]);
+                return;
+            }
+        }
+        const FString ReportPath = Args.Num() > 1
+            ? Args[1]
+            : FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("McpBenchmark"),
+                              FString::Printf(TEXT("bridge-%s.json"), *FDateTime::Now().ToString()));
+        const bool bExitWhenDone = FParse::Param(FCommandLine::Get(), TEXT("McpBenchmarkExit"));
+        const double StartSeconds = FPlatformTime::Seconds();
+
+        // The listen socket may still be coming up when run from -ExecCmds.
+        McpConsoleBenchmarkTicker = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+            [Spec, ReportPath, bExitWhenDone, StartSeconds](float) -> bool
+            {
+                auto Done = [bExitWhenDone](bool bSuccess)
+                {
+                    McpConsoleBenchmark.Reset();
+                    McpConsoleBenchmarkTicker = FTSTicker::FDelegateHandle();
+                    if (bExitWhenDone)
+                    {
+                        FPlatformMisc::RequestExitWithStatus(false, bSuccess ? 0 : 1);
+                    }
+                    return false;
+                };
+
+                if (!McpConsoleBenchmark.IsValid())
+                {
+                    UMcpAutomationBridgeSubsystem* Subsystem =
+                        GEditor ? GEditor->GetEditorSubsystem<UMcpAutomationBridgeSubsystem>() : nullptr;
+                    TSharedPtr<FMcpConnectionManager> Manager = Subsystem ? Subsystem->GetConnectionManager() : nullptr;
+                    if (!Manager.IsValid() || Manager->GetLoopbackUrl().IsEmpty())
+                    {
+                        if (FPlatformTime::Seconds() - StartSeconds < 30.0)
+                        {
+                            return true;
+                        }
+                        UE_LOG(LogMcpAutomationBridgeSubsystem, Error, TEXT("Bridge benchmark: the bridge is not listening"));
+                        return Done(false);
+                    }
+                    FString Error;
+                    McpConsoleBenchmark = FMcpBridgeBenchmark::Create(Spec, Manager, Error);
+                    if (!McpConsoleBenchmark.IsValid())
+                    {
+                        UE_LOG(LogMcpAutomationBridgeSubsystem, Error, TEXT("Bridge benchmark: %s"), *Error);
+                        return Done(false);
+                    }
+                    McpConsoleBenchmark->Start();
+                }
+
+                if (!McpConsoleBenchmark->Tick())
+                {
+                    return true;
+                }
+                McpWriteBenchmarkReport(McpConsoleBenchmark->GetReport(), ReportPath);
+                return Done(McpConsoleBenchmark->Succeeded());
+            }));
+    }
+
+    FAutoConsoleCommand McpBenchmarkCommand(
+        TEXT("Mcp.Benchmark"),
+        TEXT("Runs the automation bridge load benchmark. Usage: Mcp.Benchmark [SpecFile.json|default] [ReportFile.json]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&McpRunBenchmarkCommand));
+}
+#endif
+
+#if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
+namespace
+{
+    /**
+     * Waits for the bridge to listen, runs the benchmark to completion and
+     * checks that every phase ran and answered every measured request.
+     */
+    class FMcpBenchmarkLatentCommand final : public IAutomationLatentCommand
+    {
+    public:
+        FMcpBenchmarkLatentCommand(FAutomationTestBase* InTest, const TSharedPtr<FJsonObject>& InSpec)
+            : Test(InTest)
+            , Spec(InSpec)
+            , StartSeconds(FPlatformTime::Seconds())
+        {
+        }
+
+        virtual bool Update() override
+        {
+            if (!Benchmark.IsValid())
+            {
+                UMcpAutomationBridgeSubsystem* Subsystem =
+                    GEditor ? GEditor->GetEditorSubsystem<UMcpAutomationBridgeSubsystem>() : nullptr;
+                TSharedPtr<FMcpConnectionManager> Manager = Subsystem ? Subsystem->GetConnectionManager() : nullptr;
+                if (!Manager.IsValid() || Manager->GetLoopbackUrl().IsEmpty())
+                {
+                    if (FPlatformTime::Seconds() - StartSeconds < 30.0)
+                    {
+                        return false;
+                    }
+                    Test->AddError(TEXT("The bridge is not listening; the benchmark test needs bAlwaysListen"));
+                    return true;
+                }
+                FString Error;
+                Benchmark = FMcpBridgeBenchmark::Create(Spec, Manager, Error);
+                if (!Benchmark.IsValid())
+                {
+                    Test->AddError(Error);
+                    return true;
+                }
+                Benchmark->Start();
+            }
+            if (!Benchmark->Tick())
+            {
+                return false;
+            }
+
+            Test->TestTrue(FString::Printf(TEXT("Benchmark succeeded (%s)"), *Benchmark->GetError()), Benchmark->Succeeded());
+            const TSharedPtr<FJsonObject> Report = Benchmark->GetReport();
+            const TArray<TSharedPtr<FJsonValue>>* Reported = nullptr;
+            const TArray<TSharedPtr<FJsonValue>>* Requested = nullptr;
+            if (!Report->TryGetArrayField(TEXT("phases"), Reported) || !Spec->TryGetArrayField(TEXT("phases"), Requested) ||
+                !Test->TestEqual(TEXT("Reported phases"), Reported->Num(), Requested->Num()))
+            {
+                return true;
+            }
+            for (int32 Index = 0; Index < Reported->Num(); ++Index)
+            {
+                const TSharedPtr<FJsonObject> Phase = (*Reported)[Index]->AsObject();
+                const TSharedPtr<FJsonObject> Asked = (*Requested)[Index]->AsObject();
+                const FString Name = GetJsonStringField(Phase, TEXT("name"));
+                Test->TestTrue(FString::Printf(TEXT("Phase %s ran"), *Name), GetJsonBoolField(Phase, TEXT("ran"), false));
+                Test->TestEqual(FString::Printf(TEXT("Phase %s requests"), *Name), GetJsonIntField(Phase, TEXT("requests"), 0),
+                                GetJsonIntField(Asked, TEXT("requests"), -1));
+                Test->TestEqual(FString::Printf(TEXT("Phase %s errors"), *Name), GetJsonIntField(Phase, TEXT("errors"), -1), 0);
+            }
+            return true;
+        }
+
+    private:
+        FAutomationTestBase* Test;
+        TSharedPtr<FJsonObject> Spec;
+        TSharedPtr<FMcpBridgeBenchmark> Benchmark;
+        double StartSeconds;
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMcpBridgeBenchmarkLoopbackTest, "McpAutomationBridge.Benchmark.Loopback",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMcpBridgeBenchmarkLoopbackTest::RunTest(const FString& Parameters)
+{
+    // A short run of the framing-sensitive phases; works under -nullrhi.
+    TArray<TSharedPtr<FJsonValue>> Phases;
+    Phases.Add(MakeShared<FJsonValueObject>(McpBenchmarkPhaseSpec(TEXT("tiny_rpc"), TEXT("tiny_rpc"), 100, 4)));
+    TSharedRef<FJsonObject> Large = McpBenchmarkPhaseSpec(TEXT("large_payload"), TEXT("large_payload"), 10, 2);
+    Large->SetNumberField(TEXT("payloadBytes"), 256 * 1024);
+    Phases.Add(MakeShared<FJsonValueObject>(Large));
+
+    TSharedPtr<FJsonObject> Spec = MakeShared<FJsonObject>();
+    Spec->SetArrayField(TEXT("phases"), Phases);
+    Spec->SetNumberField(TEXT("stallTimeoutSeconds"), 10.0);
+    ADD_LATENT_AUTOMATION_COMMAND(FMcpBenchmarkLatentCommand(this, Spec));
+    return true;
+}
+#endif
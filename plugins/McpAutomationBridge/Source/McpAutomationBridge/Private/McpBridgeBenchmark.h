@@ -0,0 +1,169 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "McpLatencyHistogram.h"
+#include "UObject/WeakObjectPtr.h"
+
+class AActor;
+class FMcpBridgeWebSocket;
+class FMcpConnectionManager;
+
+/**
+ * Load generator for the bridge itself.
+ *
+ * Opens in-process WebSocket clients against the bridge's own listening
+ * socket (a loopback key lets them past the capability token and rate limits)
+ * and drives each phase of a spec as a closed loop: every response sends the
+ * next request until the phase's request count or duration is reached, with
+ * Concurrency requests in flight spread over Connections sockets.
+ *
+ * Phase kinds:
+ *  - tiny_rpc: empty bridge_echo requests (dispatch and framing overhead)
+ *  - large_payload: bridge_echo carrying payloadBytes of data
+ *  - list_query: query_actors against actorCount transient actors spawned in
+ *    the editor world for the phase, alternating tag and radius queries, or
+ *    the phase's own "query" payload
+ *  - replay: a recorded request mix, from "file" (JSON lines of {action,
+ *    payload} or full automation_request envelopes) or an inline "requests"
+ *    array, sent round-robin
+ *
+ * Each phase reports requests/sec, a latency histogram (p50/p99 and friends),
+ * errors and, with countAllocations, process-wide allocations per request
+ * (every thread's, not just the bridge's). Counting needs the editor started
+ * with -McpBenchmarkCountAllocations; otherwise the report has
+ * allocationCounting false.
+ * Runs on the game thread; the owner calls Tick every frame until it returns
+ * true. Used by run_benchmark (type "bridge"), the Mcp.Benchmark console
+ * command and the McpAutomationBridge.Benchmark.Loopback automation test.
+ */
+class FMcpBridgeBenchmark : public TSharedFromThis<FMcpBridgeBenchmark>
+{
+public:
+    /** The suite run when a spec has no "phases". */
+    static TSharedPtr<FJsonObject> MakeDefaultSpec();
+
+    /**
+     * With -McpBenchmarkCountAllocations on the command line, wraps GMalloc in
+     * the counting proxy. Called once from module startup; the proxy is never
+     * removed.
+     */
+    static void InstallAllocationCounter();
+
+    /** Parses Spec; returns null with an error when it is invalid or the bridge is not listening. */
+    static TSharedPtr<FMcpBridgeBenchmark> Create(const TSharedPtr<FJsonObject>& Spec,
+                                                  const TSharedPtr<FMcpConnectionManager>& ConnectionManager,
+                                                  FString& OutError);
+
+    ~FMcpBridgeBenchmark();
+
+    void Start();
+    /** Advances the run; returns true once it has finished or failed. */
+    bool Tick();
+    /** Stops issuing requests, cleans up and fails the run with Reason. */
+    void Cancel(const FString& Reason);
+
+    bool Succeeded() const { return bFinished && Error.IsEmpty(); }
+    const FString& GetError() const { return Error; }
+    /** Progress in 0..100 for progress updates. */
+    float GetProgressPercent() const;
+
+    /** {loopbackUrl, totalSeconds, allocationCounting, phases: [...]} */
+    TSharedPtr<FJsonObject> GetReport() const;
+
+private:
+    struct FPhase
+    {
+        FString Name;
+        FString Kind;
+        int32 Requests = 0;
+        double DurationSeconds = 0.0;
+        int32 WarmupRequests = 0;
+        int32 Concurrency = 1;
+        int32 Connections = 1;
+        int32 PayloadBytes = 0;
+        int32 ActorCount = 0;
+        int32 QueryLimit = 100;
+        TSharedPtr<FJsonObject> Query;
+        FString ReplayFile;
+        TArray<TSharedPtr<FJsonValue>> ReplayRequests;
+
+        /** Serialized requests split around the request id: Prefix + Id + Suffix. */
+        TArray<TPair<FString, FString>> Templates;
+
+        // Results
+        FMcpLatencyHistogram Latency;
+        int32 Issued = 0;
+        int32 Completed = 0;
+        int32 Measured = 0;
+        int32 Errors = 0;
+        FString FirstError;
+        int64 RequestBytes = 0;
+        double StartSeconds = 0.0;
+        double MeasureStartSeconds = 0.0;
+        double EndSeconds = 0.0;
+        uint64 AllocationsAtMeasureStart = 0;
+        uint64 Allocations = 0;
+        bool bRan = false;
+    };
+
+    struct FClient
+    {
+        TSharedPtr<FMcpBridgeWebSocket> Socket;
+        /** Single-use: the bridge accepts it for one bridge_hello. */
+        FString LoopbackKey;
+        bool bReady = false;
+        int32 InFlight = 0;
+    };
+
+    struct FInFlight
+    {
+        double SentSeconds = 0.0;
+        bool bMeasured = false;
+    };
+
+    enum class EState : uint8
+    {
+        Idle,
+        Connecting,
+        Running,
+        Done,
+    };
+
+    bool ParsePhase(const TSharedPtr<FJsonObject>& Object, int32 Index, FString& OutError);
+    bool BuildTemplates(FPhase& Phase, FString& OutError);
+    static bool AddTemplate(FPhase& Phase, const FString& Action, const TSharedPtr<FJsonObject>& Payload);
+
+    void OnClientConnected(int32 ClientIndex);
+    void OnClientMessage(int32 ClientIndex, const FString& Message);
+    void OnClientClosed(int32 ClientIndex, const FString& Reason);
+
+    void BeginPhase(int32 Index);
+    void EndPhase();
+    void Pump();
+    bool SendNext();
+    void SpawnQueryActors(FPhase& Phase);
+    void DestroyQueryActors();
+    void Finish(const FString& FailureReason);
+
+    TWeakPtr<FMcpConnectionManager> ConnectionManager;
+    FString Url;
+    FString IdPrefix;
+    bool bCountAllocations = false;
+    double ConnectTimeoutSeconds = 10.0;
+    double StallTimeoutSeconds = 30.0;
+
+    TArray<FPhase> Phases;
+    TArray<FClient> Clients;
+    TMap<int64, FInFlight> InFlight;
+    TArray<TWeakObjectPtr<AActor>> QueryActors;
+
+    EState State = EState::Idle;
+    int32 PhaseIndex = INDEX_NONE;
+    int64 NextSequence = 0;
+    double StartSeconds = 0.0;
+    double EndSeconds = 0.0;
+    double LastProgressSeconds = 0.0;
+    bool bFinished = false;
+    FString Error;
+};
@@ -0,0 +1,39 @@
+#include "McpBridgeTrace.h"
+
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformTLS.h"
+#include "Trace/Trace.inl"
+
+UE_TRACE_CHANNEL_DEFINE(McpBridgeChannel)
+
+UE_TRACE_EVENT_BEGIN(McpBridge, RequestPhase)
+    UE_TRACE_EVENT_FIELD(uint64, Cycle)
+    UE_TRACE_EVENT_FIELD(uint32, ThreadId)
+    UE_TRACE_EVENT_FIELD(uint8, Phase)
+    UE_TRACE_EVENT_FIELD(int64, Bytes)
+    UE_TRACE_EVENT_FIELD(UE::Trace::WideString, RequestId)
+    UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Action)
+UE_TRACE_EVENT_END()
+
+namespace McpTrace
+{
+    void MarkRequest(EMcpTracePhase Phase, const FString& RequestId, const FString& Action, int64 Bytes)
+    {
+        UE_TRACE_LOG(McpBridge, RequestPhase, McpBridgeChannel)
+            << RequestPhase.Cycle(FPlatformTime::Cycles64())
+            << RequestPhase.ThreadId(FPlatformTLS::GetCurrentThreadId())
+            << RequestPhase.Phase(static_cast<uint8>(Phase))
+            << RequestPhase.Bytes(Bytes)
+            << RequestPhase.RequestId(*RequestId, RequestId.Len())
+            << RequestPhase.Action(*Action, Action.Len());
+    }
+
+    bool IsChannelEnabled()
+    {
+#if UE_TRACE_ENABLED
+        return UE_TRACE_CHANNELEXPR_IS_ENABLED(McpBridgeChannel);
+#else
+        return false;
+#endif
+    }
+}
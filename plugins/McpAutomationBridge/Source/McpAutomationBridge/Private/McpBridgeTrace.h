@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+
+/**
+ * Unreal Insights instrumentation for the automation pipeline.
+ *
+ * Everything goes through the "McpBridge" trace channel, so it costs one
+ * branch per site unless a capture enables it (start_session adds it by
+ * default, or pass "-trace=default,McpBridge" on the command line).
+ *
+ * Two kinds of data are emitted:
+ *  - CPU scopes for socket receive/send, message parsing, request routing and
+ *    handler dispatch. Dispatch scopes are named after the action, so the
+ *    Timing view shows which request was running during a hitch.
+ *  - McpBridge.RequestPhase events carrying requestId, action, phase and
+ *    payload size with a Cycles64 timestamp, so a capture can be joined back
+ *    to client-side request ids.
+ */
+UE_TRACE_CHANNEL_EXTERN(McpBridgeChannel)
+
+/** CPU scope with a static name on the McpBridge channel. */
+#define MCP_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, McpBridgeChannel)
+
+/** CPU scope named by a runtime TCHAR string (e.g. the action) on the McpBridge channel. */
+#define MCP_TRACE_SCOPE_TEXT(Name) TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(Name, McpBridgeChannel)
+
+/** Request lifecycle points recorded in McpBridge.RequestPhase. Values are stable in captures. */
+enum class EMcpTracePhase : uint8
+{
+    Received = 0,
+    Queued = 1,
+    Dispatched = 2,
+    Responded = 3,
+};
+
+namespace McpTrace
+{
+    /** Emits McpBridge.RequestPhase when the channel is enabled. Bytes is 0 when not applicable. */
+    void MarkRequest(EMcpTracePhase Phase, const FString& RequestId, const FString& Action, int64 Bytes = 0);
+
+    /** True while the McpBridge channel is enabled in the current trace session. */
+    bool IsChannelEnabled();
+}
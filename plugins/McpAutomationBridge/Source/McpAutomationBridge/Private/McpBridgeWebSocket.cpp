@@ -2,12 +2,15 @@
 #include "Dom/JsonObject.h"
 #include "McpAutomationBridgeSubsystem.h"
 #include "McpAutomationBridgeSettings.h"
+#include "McpBridgeTrace.h"
+#include "McpSocketReactor.h"
 
 #include "Async/Async.h"
 #include "Containers/StringConv.h"
 #include "HAL/Event.h"
 #include "HAL/PlatformAtomics.h"
 #include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
 #include "HAL/RunnableThread.h"
 #include "IPAddress.h"
 #include "Logging/LogMacros.h"
@@ -67,6 +70,13 @@ constexpr uint8 OpCodePong = 0xA;
 constexpr uint64 MaxWebSocketMessageBytes = 5ULL * 1024ULL * 1024ULL;
 constexpr uint64 MaxWebSocketFramePayloadBytes = MaxWebSocketMessageBytes;
 constexpr int32 WebSocketCloseCodeMessageTooBig = 1009;
+constexpr int32 WebSocketCloseCodeTryAgainLater = 1013;
+
+// Socket reactor connections
+constexpr double UpgradeRequestTimeoutSeconds = 10.0;
+constexpr double HandlerRegistrationWaitSeconds = 0.5;
+constexpr double CloseFlushSeconds = 2.0;
+constexpr int32 MaxUpgradeRequestBytes = 16 * 1024;
 
 struct FParsedWebSocketUrl {
   FString Host;
@@ -226,6 +236,83 @@ void DispatchOnGameThread(TFunction<void()> &&Fn) {
   AsyncTask(ENamedThreads::GameThread, MoveTemp(Fn));
 }
 
+void RemoveLeadingBytes(TArray<uint8> &Buffer, int32 Count) {
+  Buffer.RemoveAt(0, Count
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+                  , EAllowShrinking::No
+#elif ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1
+                  , false
+#endif
+  );
+}
+
+enum class EBufferedFrame : uint8 { Incomplete, Ready, Unmasked, TooLarge };
+
+// Non-blocking counterpart of ReceiveFrame's header/payload reads: parses one
+// frame from the front of Buffer when it is complete.
+EBufferedFrame ParseBufferedFrame(const TArray<uint8> &Buffer, bool bRequireMask,
+                                  bool &bOutFinal, uint8 &OutOpCode,
+                                  TArray<uint8> &OutPayload,
+                                  int32 &OutFrameBytes) {
+  const int32 Available = Buffer.Num();
+  if (Available < 2) {
+    return EBufferedFrame::Incomplete;
+  }
+  const uint8 *Data = Buffer.GetData();
+  bOutFinal = (Data[0] & 0x80) != 0;
+  OutOpCode = Data[0] & 0x0F;
+  const bool bMasked = (Data[1] & 0x80) != 0;
+  if (bRequireMask && !bMasked) {
+    return EBufferedFrame::Unmasked;
+  }
+
+  uint64 PayloadLength = Data[1] & 0x7F;
+  int32 Offset = 2;
+  if (PayloadLength == 126) {
+    if (Available < Offset + 2) {
+      return EBufferedFrame::Incomplete;
+    }
+    uint16 ShortVal = 0;
+    FMemory::Memcpy(&ShortVal, Data + Offset, sizeof(uint16));
+    PayloadLength = FromNetwork16(ShortVal);
+    Offset += 2;
+  } else if (PayloadLength == 127) {
+    if (Available < Offset + 8) {
+      return EBufferedFrame::Incomplete;
+    }
+    uint64 LongVal = 0;
+    FMemory::Memcpy(&LongVal, Data + Offset, sizeof(uint64));
+    PayloadLength = FromNetwork64(LongVal);
+    Offset += 8;
+  }
+  if (PayloadLength > MaxWebSocketFramePayloadBytes) {
+    return EBufferedFrame::TooLarge;
+  }
+
+  const uint8 *MaskKey = nullptr;
+  if (bMasked) {
+    if (Available < Offset + 4) {
+      return EBufferedFrame::Incomplete;
+    }
+    MaskKey = Data + Offset;
+    Offset += 4;
+  }
+  if (static_cast<uint64>(Available - Offset) < PayloadLength) {
+    return EBufferedFrame::Incomplete;
+  }
+
+  const int32 Length = static_cast<int32>(PayloadLength);
+  OutPayload.SetNumUninitialized(Length);
+  FMemory::Memcpy(OutPayload.GetData(), Data + Offset, Length);
+  if (MaskKey) {
+    for (int32 Index = 0; Index < Length; ++Index) {
+      OutPayload[Index] ^= MaskKey[Index % 4];
+    }
+  }
+  OutFrameBytes = Offset + Length;
+  return EBufferedFrame::Ready;
+}
+
 FString DescribeSocketError(ISocketSubsystem *SocketSubsystem,
                             const TCHAR *Context) {
   if (!SocketSubsystem) {
@@ -621,6 +708,9 @@ void FMcpBridgeWebSocket::NotifyMessageHandlerRegistered() {
   if (HandlerReadyEvent) {
     HandlerReadyEvent->Trigger();
   }
+  if (TSharedPtr<FMcpSocketReactor> PinnedReactor = OwningReactor.Pin()) {
+    PinnedReactor->Wake();
+  }
 }
 
 void FMcpBridgeWebSocket::InitializeWeakSelf(
@@ -648,11 +738,35 @@ void FMcpBridgeWebSocket::Connect() {
 }
 
 void FMcpBridgeWebSocket::Listen() {
-  if (Thread || !bServerMode) {
+  if (Thread || Reactor || !bServerMode) {
     return;
   }
 
   bStopping = false;
+#if MCP_WITH_SOCKET_REACTOR
+  const UMcpAutomationBridgeSettings *Settings =
+      GetDefault<UMcpAutomationBridgeSettings>();
+  if (Settings && Settings->bUseSocketReactor && !bUseTls) {
+    UE_LOG(LogMcpAutomationBridgeSubsystem, Log,
+           TEXT("Spawning MCP automation socket reactor for %s:%d"),
+           *ListenHost, Port);
+    Reactor = MakeShared<FMcpSocketReactor>(
+        SelfWeakPtr.Pin(), static_cast<int64>(Settings->MaxSendQueueKB) * 1024);
+    bool bListenFailed = false;
+    if (Reactor->Start(bListenFailed)) {
+      return;
+    }
+    Reactor.Reset();
+    if (bListenFailed) {
+      // Already reported; a worker thread could not open it either.
+      return;
+    }
+    UE_LOG(LogMcpAutomationBridgeSubsystem, Warning,
+           TEXT("Failed to start the socket reactor; falling back to a "
+                "worker thread per connection."));
+  }
+#endif
+
   StopEvent = FPlatformProcess::GetSynchEventFromPool(true);
   UE_LOG(LogMcpAutomationBridgeSubsystem, Log,
          TEXT("Spawning MCP automation server thread for %s:%d"), *ListenHost,
@@ -672,6 +786,12 @@ void FMcpBridgeWebSocket::Listen() {
 }
 
 void FMcpBridgeWebSocket::Close(int32 StatusCode, const FString &Reason) {
+  if (bReactorConnection) {
+    // The reactor owns the handle; it closes it once queued sends are out.
+    RequestReactorClose(StatusCode, Reason);
+    return;
+  }
+
   bStopping = true;
   if (StopEvent) {
     StopEvent->Trigger();
@@ -681,11 +801,17 @@ void FMcpBridgeWebSocket::Close(int32 StatusCode, const FString &Reason) {
   // IMPORTANT: We only close here, NOT destroy. RunServer() owns the socket and
   // will destroy it after its loop exits. This avoids a TOCTOU race where we
   // destroy the socket while RunServer() is between checking ListenSocket and
-  // calling Accept().
-  if (ListenSocket) {
+  // calling Accept(). A reactor owns its listen socket outright.
+  if (ListenSocket && !Reactor) {
     ListenSocket->Close();
   }
 
+  // Stopping the reactor tears down every connection it serves.
+  if (Reactor) {
+    Reactor->Shutdown();
+    Reactor.Reset();
+  }
+
   // Close any client sockets that were accepted by this server
   TArray<TSharedPtr<FMcpBridgeWebSocket>> SocketsToClose;
   {
@@ -722,7 +848,7 @@ bool FMcpBridgeWebSocket::Send(const void *Data, SIZE_T Length) {
     if (!SslHandle) {
       return false;
     }
-  } else if (!Socket) {
+  } else if (!Socket && !bReactorConnection) {
     return false;
   }
 
@@ -733,6 +859,15 @@ bool FMcpBridgeWebSocket::IsConnected() const { return bConnected; }
 
 bool FMcpBridgeWebSocket::IsListening() const { return bListening; }
 
+bool FMcpBridgeWebSocket::GetReactorStats(
+    FMcpSocketReactorStats &OutStats) const {
+  if (!Reactor) {
+    return false;
+  }
+  Reactor->GetStats(OutStats);
+  return true;
+}
+
 void FMcpBridgeWebSocket::SendHeartbeatPing() {
   SendControlFrame(OpCodePing, TArray<uint8>());
 }
@@ -809,13 +944,13 @@ uint32 FMcpBridgeWebSocket::RunClient() {
   return 0;
 }
 
-uint32 FMcpBridgeWebSocket::RunServer() {
+bool FMcpBridgeWebSocket::OpenListenSocket() {
   // Determine if we need IPv6 socket based on host address
   const bool bIsIpv6Host = ListenHost.Contains(TEXT(":"));
   
   ISocketSubsystem *SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
   UE_LOG(LogMcpAutomationBridgeSubsystem, Log,
-         TEXT("FMcpBridgeWebSocket::RunServer begin (host=%s, port=%d, IPv6=%s)"),
+         TEXT("FMcpBridgeWebSocket::OpenListenSocket begin (host=%s, port=%d, IPv6=%s)"),
          *ListenHost, Port, bIsIpv6Host ? TEXT("true") : TEXT("false"));
   
   // Create socket with proper protocol family for IPv6 support
@@ -832,7 +967,7 @@ uint32 FMcpBridgeWebSocket::RunServer() {
         Pinned->ConnectionErrorDelegate.Broadcast(ErrorMessage);
       }
     });
-    return 0;
+    return false;
   }
 
   ListenSocket->SetReuseAddr(true);
@@ -874,7 +1009,7 @@ uint32 FMcpBridgeWebSocket::RunServer() {
           NAME_Stream, TEXT("McpAutomationBridgeListenSocket"), FName());
       if (!ListenSocket) {
         UE_LOG(LogMcpAutomationBridgeSubsystem, Error, TEXT("Failed to re-create IPv4 socket for fallback."));
-        return 0;
+        return false;
       }
       ListenSocket->SetReuseAddr(true);
       ListenSocket->SetNonBlocking(false);
@@ -933,7 +1068,7 @@ uint32 FMcpBridgeWebSocket::RunServer() {
           if (!ListenSocket) {
             UE_LOG(LogMcpAutomationBridgeSubsystem, Error, 
                    TEXT("Failed to re-create socket for resolved address family."));
-            return 0;
+            return false;
           }
           ListenSocket->SetReuseAddr(true);
           ListenSocket->SetNonBlocking(false);
@@ -961,7 +1096,7 @@ uint32 FMcpBridgeWebSocket::RunServer() {
           NAME_Stream, TEXT("McpAutomationBridgeListenSocket"), FName());
       if (!ListenSocket) {
         UE_LOG(LogMcpAutomationBridgeSubsystem, Error, TEXT("Failed to re-create IPv4 socket for fallback."));
-        return 0;
+        return false;
       }
       ListenSocket->SetReuseAddr(true);
       ListenSocket->SetNonBlocking(false);
@@ -984,7 +1119,7 @@ uint32 FMcpBridgeWebSocket::RunServer() {
         Pinned->ConnectionErrorDelegate.Broadcast(ErrorMessage);
       }
     });
-    return 0;
+    return false;
   }
   UE_LOG(LogMcpAutomationBridgeSubsystem, Log,
          TEXT("Listen socket bound to %s."), *ListenAddr->ToString(false));
@@ -998,7 +1133,7 @@ uint32 FMcpBridgeWebSocket::RunServer() {
         Pinned->ConnectionErrorDelegate.Broadcast(ErrorMessage);
       }
     });
-    return 0;
+    return false;
   }
 
   bListening = true;
@@ -1010,7 +1145,15 @@ uint32 FMcpBridgeWebSocket::RunServer() {
       Pinned->ConnectedDelegate.Broadcast(Pinned); // Server ready event
     }
   });
+  return true;
+}
+
+uint32 FMcpBridgeWebSocket::RunServer() {
+  if (!OpenListenSocket()) {
+    return 0;
+  }
 
+  ISocketSubsystem *SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
   while (!bStopping && ListenSocket) {
     // Note: Accept() blocks until a connection arrives or the socket is closed.
     // Close() calls ListenSocket->Close() to unblock this call during shutdown.
@@ -1104,6 +1247,7 @@ uint32 FMcpBridgeWebSocket::RunServer() {
     SocketSubsystem->DestroySocket(ListenSocket);
     ListenSocket = nullptr;
   }
+  bListening = false;
 
   return 0;
 }
@@ -1330,7 +1474,6 @@ bool FMcpBridgeWebSocket::PerformServerHandshake() {
   constexpr int32 TempSize = 256;
   uint8 Temp[TempSize];
   bool bRequestComplete = false;
-  FString ClientKey;
 
   int32 HeaderEndIndex = -1;
   if (bUseTls) {
@@ -1380,8 +1523,19 @@ bool FMcpBridgeWebSocket::PerformServerHandshake() {
     }
   }
 
-  FString RequestString = FString(
-      ANSI_TO_TCHAR(reinterpret_cast<const char *>(RequestBuffer.GetData())));
+  return CompleteServerHandshake(RequestBuffer, HeaderEndIndex);
+}
+
+bool FMcpBridgeWebSocket::CompleteServerHandshake(
+    const TArray<uint8> &RequestBuffer, int32 HeaderEndIndex) {
+  FString ClientKey;
+  // Only the header section: the buffer is not null-terminated and may
+  // already hold the first frame.
+  const FUTF8ToTCHAR RequestConverter(
+      reinterpret_cast<const ANSICHAR *>(RequestBuffer.GetData()),
+      HeaderEndIndex > 0 ? HeaderEndIndex : RequestBuffer.Num());
+  FString RequestString =
+      FString(RequestConverter.Length(), RequestConverter.Get());
   TArray<FString> RequestLines;
   RequestString.ParseIntoArrayLines(RequestLines, false);
 
@@ -1515,9 +1669,21 @@ bool FMcpBridgeWebSocket::PerformServerHandshake() {
 
   FTCHARToUTF8 ResponseUtf8(*Response);
   int32 BytesSent = 0;
-  if (!SendRaw(reinterpret_cast<const uint8 *>(ResponseUtf8.Get()),
-               ResponseUtf8.Length(), BytesSent) ||
-      BytesSent != ResponseUtf8.Length()) {
+  bool bResponseSent = false;
+  if (bReactorConnection) {
+    // Queued like a frame; the reactor flushes whatever the kernel defers.
+    const TArray<uint8> ResponseBytes(
+        reinterpret_cast<const uint8 *>(ResponseUtf8.Get()),
+        ResponseUtf8.Length());
+    FScopeLock Guard(&SendMutex);
+    bResponseSent = QueueReactorFrame(ResponseBytes);
+    BytesSent = bResponseSent ? ResponseUtf8.Length() : 0;
+  } else {
+    bResponseSent = SendRaw(reinterpret_cast<const uint8 *>(ResponseUtf8.Get()),
+                            ResponseUtf8.Length(), BytesSent) &&
+                    BytesSent == ResponseUtf8.Length();
+  }
+  if (!bResponseSent) {
     UE_LOG(LogMcpAutomationBridgeSubsystem, Warning,
            TEXT("Server handshake failed: unable to send upgrade response "
                 "(sent %d expected %d)."),
@@ -1556,6 +1722,10 @@ bool FMcpBridgeWebSocket::ResolveEndpoint(TSharedPtr<FInternetAddr> &OutAddr) {
 }
 
 bool FMcpBridgeWebSocket::SendFrame(const TArray<uint8> &Frame) {
+  if (bReactorConnection) {
+    return QueueReactorFrame(Frame);
+  }
+
   if (!Socket && !(bUseTls && SslHandle)) {
     return false;
   }
@@ -1608,6 +1778,7 @@ bool FMcpBridgeWebSocket::SendCloseFrame(int32 StatusCode,
 }
 
 bool FMcpBridgeWebSocket::SendTextFrame(const void *Data, SIZE_T Length) {
+  MCP_TRACE_SCOPE(McpBridge_SendFrame);
   const uint8 *Raw = static_cast<const uint8 *>(Data);
   TArray<uint8> Frame;
 
@@ -1650,7 +1821,7 @@ bool FMcpBridgeWebSocket::SendTextFrame(const void *Data, SIZE_T Length) {
 
 bool FMcpBridgeWebSocket::SendControlFrame(const uint8 ControlOpCode,
                                            const TArray<uint8> &Payload) {
-  if (!Socket && !(bUseTls && SslHandle)) {
+  if (!Socket && !(bUseTls && SslHandle) && !bReactorConnection) {
     return false;
   }
 
@@ -1686,6 +1857,7 @@ bool FMcpBridgeWebSocket::SendControlFrame(const uint8 ControlOpCode,
 }
 
 void FMcpBridgeWebSocket::HandleTextPayload(const TArray<uint8> &Payload) {
+  MCP_TRACE_SCOPE(McpBridge_ReceiveMessage);
   const FString Message = BytesToStringView(Payload);
   // Dispatch message handling to the game thread.
   // Many automation handlers touch editor/world state and must run on the
@@ -1767,6 +1939,11 @@ bool FMcpBridgeWebSocket::ReceiveFrame() {
     }
   }
 
+  return HandleFrame(bFinalFrame, OpCode, Payload);
+}
+
+bool FMcpBridgeWebSocket::HandleFrame(bool bFinalFrame, uint8 OpCode,
+                                      const TArray<uint8> &Payload) {
   if (OpCode == OpCodeClose) {
     TearDown(TEXT("WebSocket closed by peer."), true, 1000);
     return false;
@@ -1930,3 +2107,393 @@ bool FMcpBridgeWebSocket::ReceiveExact(uint8 *Buffer, SIZE_T Length) {
 
   return true;
 }
+
+UPTRINT FMcpBridgeWebSocket::ReleaseListenSocket() {
+#if MCP_WITH_SOCKET_REACTOR
+  if (!ListenSocket) {
+    return 0;
+  }
+  const UPTRINT Handle = ListenSocket->ReleaseNativeSocket();
+  ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ListenSocket);
+  ListenSocket = nullptr;
+  return Handle;
+#else
+  return 0;
+#endif
+}
+
+TSharedPtr<FMcpBridgeWebSocket> FMcpBridgeWebSocket::CreateReactorConnection(
+    UPTRINT Handle, int32 ListenPort,
+    const TWeakPtr<FMcpBridgeWebSocket> &Listener,
+    const TWeakPtr<FMcpSocketReactor> &InReactor, double NowSeconds) {
+  TSharedPtr<FMcpBridgeWebSocket> Connection =
+      MakeShared<FMcpBridgeWebSocket>(static_cast<FSocket *>(nullptr));
+  Connection->InitializeWeakSelf(Connection);
+  Connection->Port = ListenPort;
+  Connection->bConnected = false;
+  Connection->bReactorConnection = true;
+  Connection->ReactorHandle = Handle;
+  Connection->OwningReactor = InReactor;
+  Connection->PhaseDeadlineSeconds = NowSeconds + UpgradeRequestTimeoutSeconds;
+
+  // Same announcement as a worker-thread connection, without the listener
+  // tracking it: stopping the reactor already tears down its connections.
+  TWeakPtr<FMcpBridgeWebSocket> WeakConnection = Connection;
+  Connection->OnConnected().AddLambda(
+      [Listener, WeakConnection](TSharedPtr<FMcpBridgeWebSocket>) {
+        TSharedPtr<FMcpBridgeWebSocket> PinnedListener = Listener.Pin();
+        TSharedPtr<FMcpBridgeWebSocket> PinnedConnection = WeakConnection.Pin();
+        if (PinnedListener.IsValid() && PinnedConnection.IsValid()) {
+          UE_LOG(LogMcpAutomationBridgeSubsystem, Log,
+                 TEXT("Broadcasting client connected delegate."));
+          PinnedListener->ClientConnectedDelegate.Broadcast(PinnedConnection);
+        }
+      });
+  return Connection;
+}
+
+bool FMcpBridgeWebSocket::HandleReactorReadable(double NowSeconds,
+                                                int32 MaxBytes) {
+  uint8 Buffer[16 * 1024];
+  int32 TotalRead = 0;
+  bool bPeerClosed = false;
+  while (TotalRead < MaxBytes) {
+    int32 BytesRead = 0;
+    const FMcpSocketReactor::EIoResult Result = FMcpSocketReactor::RecvNative(
+        ReactorHandle, Buffer, sizeof(Buffer), BytesRead);
+    if (Result == FMcpSocketReactor::EIoResult::WouldBlock) {
+      break;
+    }
+    if (Result == FMcpSocketReactor::EIoResult::Closed) {
+      // Frames that arrived before the FIN are still delivered below.
+      bPeerClosed = true;
+      break;
+    }
+    if (Result == FMcpSocketReactor::EIoResult::Error) {
+      TearDown(TEXT("Failed to read from WebSocket connection."), false, 4001);
+      return false;
+    }
+    {
+      FScopeLock Guard(&ReceiveMutex);
+      PendingReceived.Append(Buffer, BytesRead);
+    }
+    TotalRead += BytesRead;
+  }
+
+  if (!bReactorHandshakeDone) {
+    int32 HeaderEndIndex = INDEX_NONE;
+    TArray<uint8> RequestBuffer;
+    {
+      FScopeLock Guard(&ReceiveMutex);
+      for (int32 Idx = 0; Idx + 3 < PendingReceived.Num(); ++Idx) {
+        if (PendingReceived[Idx] == '\r' && PendingReceived[Idx + 1] == '\n' &&
+            PendingReceived[Idx + 2] == '\r' &&
+            PendingReceived[Idx + 3] == '\n') {
+          HeaderEndIndex = Idx + 4;
+          break;
+        }
+      }
+      if (HeaderEndIndex == INDEX_NONE &&
+          PendingReceived.Num() > MaxUpgradeRequestBytes) {
+        PendingReceived.Reset();
+        HeaderEndIndex = 0;
+      }
+      if (HeaderEndIndex != INDEX_NONE) {
+        // CompleteServerHandshake puts back whatever follows the headers.
+        RequestBuffer = MoveTemp(PendingReceived);
+        PendingReceived.Reset();
+      }
+    }
+
+    if (HeaderEndIndex == 0) {
+      TearDown(TEXT("WebSocket upgrade request too large."), false, 4000);
+      return false;
+    }
+    if (HeaderEndIndex == INDEX_NONE) {
+      if (bPeerClosed) {
+        TearDown(TEXT("Failed to read WebSocket upgrade request."), false,
+                 4000);
+        return false;
+      }
+      return true;
+    }
+    if (!CompleteServerHandshake(RequestBuffer, HeaderEndIndex)) {
+      return false;
+    }
+
+    bReactorHandshakeDone = true;
+    bConnected = true;
+    // As in RunClient: hold frames back briefly until the game thread has
+    // attached its message handler so bridge_hello is not lost.
+    bAwaitingHandler = true;
+    PhaseDeadlineSeconds = NowSeconds + HandlerRegistrationWaitSeconds;
+    UE_LOG(LogMcpAutomationBridgeSubsystem, Log,
+           TEXT("FMcpBridgeWebSocket connection established (serverAccepted=true, "
+                "reactor=true)."));
+    DispatchOnGameThread([WeakThis = SelfWeakPtr] {
+      if (TSharedPtr<FMcpBridgeWebSocket> Pinned = WeakThis.Pin()) {
+        Pinned->ConnectedDelegate.Broadcast(Pinned);
+      }
+    });
+  }
+
+  if (!bAwaitingHandler && !DrainBufferedFrames()) {
+    return false;
+  }
+  if (bPeerClosed) {
+    TearDown(TEXT("WebSocket connection closed by peer."), false, 4001);
+    return false;
+  }
+  return true;
+}
+
+bool FMcpBridgeWebSocket::HandleReactorWritable() {
+  bool bFlushed = false;
+  {
+    FScopeLock Guard(&SendMutex);
+    bFlushed = FlushSendQueue();
+  }
+  if (!bFlushed) {
+    TearDown(TEXT("Failed to write to WebSocket connection."), false, 4001);
+  }
+  return bFlushed;
+}
+
+bool FMcpBridgeWebSocket::PumpReactor(double NowSeconds, bool &bOutWantsWrite,
+                                      double &InOutWaitSeconds) {
+  if (bSendFailed) {
+    TearDown(TEXT("Failed to write to WebSocket connection."), false, 4001);
+    return false;
+  }
+
+  bool bClosing = false;
+  bool bQueueEmpty = true;
+  double CloseDeadline = 0.0;
+  int32 StatusCode = 1000;
+  FString Reason;
+  {
+    FScopeLock Guard(&SendMutex);
+    bQueueEmpty = SendQueueHead >= SendQueue.Num();
+    bClosing = bCloseRequested;
+    CloseDeadline = CloseDeadlineSeconds;
+    StatusCode = CloseStatusCode;
+    Reason = CloseReason;
+  }
+
+  if (bClosing) {
+    // Let a response sent just before Close() reach the client first.
+    if (bQueueEmpty || NowSeconds >= CloseDeadline) {
+      TearDown(Reason.IsEmpty() ? TEXT("Connection closed locally.") : Reason,
+               false, StatusCode);
+      return false;
+    }
+    InOutWaitSeconds = FMath::Min(InOutWaitSeconds, CloseDeadline - NowSeconds);
+  }
+
+  if (!bReactorHandshakeDone) {
+    if (NowSeconds >= PhaseDeadlineSeconds) {
+      TearDown(TEXT("Timed out waiting for the WebSocket upgrade request."),
+               false, 4000);
+      return false;
+    }
+    InOutWaitSeconds =
+        FMath::Min(InOutWaitSeconds, PhaseDeadlineSeconds - NowSeconds);
+  } else if (bAwaitingHandler) {
+    if (bHandlerRegistered || NowSeconds >= PhaseDeadlineSeconds) {
+      bAwaitingHandler = false;
+      if (!bHandlerRegistered) {
+        UE_LOG(LogMcpAutomationBridgeSubsystem, Verbose,
+               TEXT("Message handler registration not observed in time; "
+                    "proceeding without explicit synchronization."));
+      }
+      if (!DrainBufferedFrames()) {
+        return false;
+      }
+    } else {
+      InOutWaitSeconds =
+          FMath::Min(InOutWaitSeconds, PhaseDeadlineSeconds - NowSeconds);
+    }
+  }
+
+  FScopeLock Guard(&SendMutex);
+  bOutWantsWrite = SendQueueHead < SendQueue.Num();
+  return true;
+}
+
+bool FMcpBridgeWebSocket::DrainBufferedFrames() {
+  for (;;) {
+    bool bFinalFrame = false;
+    uint8 OpCode = 0;
+    TArray<uint8> Payload;
+    int32 FrameBytes = 0;
+    EBufferedFrame Parsed = EBufferedFrame::Incomplete;
+    {
+      FScopeLock Guard(&ReceiveMutex);
+      Parsed = ParseBufferedFrame(PendingReceived, bServerAcceptedConnection,
+                                  bFinalFrame, OpCode, Payload, FrameBytes);
+      if (Parsed == EBufferedFrame::Ready) {
+        RemoveLeadingBytes(PendingReceived, FrameBytes);
+      }
+    }
+
+    switch (Parsed) {
+    case EBufferedFrame::Incomplete:
+      return true;
+    case EBufferedFrame::Unmasked:
+      TearDown(TEXT("Client frames must be masked."), false, 1002);
+      return false;
+    case EBufferedFrame::TooLarge:
+      TearDown(TEXT("WebSocket message too large."), false,
+               WebSocketCloseCodeMessageTooBig);
+      return false;
+    case EBufferedFrame::Ready:
+      break;
+    }
+
+    if (!HandleFrame(bFinalFrame, OpCode, Payload)) {
+      return false;
+    }
+  }
+}
+
+bool FMcpBridgeWebSocket::QueueReactorFrame(const TArray<uint8> &Frame) {
+  if (ReactorHandle == 0 || bCloseRequested || bSendFailed) {
+    return false;
+  }
+  TSharedPtr<FMcpSocketReactor> PinnedReactor = OwningReactor.Pin();
+  if (!PinnedReactor.IsValid()) {
+    return false;
+  }
+
+  // A frame is queued whole or not at all, and an empty queue always takes
+  // it, so responses larger than the cap still go out.
+  const int64 Queued = SendQueue.Num() - SendQueueHead;
+  if (Queued > 0 &&
+      Queued + Frame.Num() > PinnedReactor->GetMaxSendQueueBytes()) {
+    // Dropping the frame would leave a client that is still connected
+    // waiting forever, so close it instead: it reconnects and resumes its
+    // session, whose buffer holds what it missed.
+    PinnedReactor->CountBackpressureReject();
+    UE_LOG(LogMcpAutomationBridgeSubsystem, Warning,
+           TEXT("Client is not reading (%lld bytes queued); refusing a %d "
+                "byte frame and closing the connection."),
+           static_cast<long long>(Queued), Frame.Num());
+    bBackpressured = true;
+    bCloseRequested = true;
+    CloseStatusCode = WebSocketCloseCodeTryAgainLater;
+    CloseReason = TEXT("Client is not reading; reconnect to resume");
+    CloseDeadlineSeconds = FPlatformTime::Seconds() + CloseFlushSeconds;
+    PinnedReactor->Wake();
+    return false;
+  }
+
+  int32 Offset = 0;
+  if (Queued == 0) {
+    // Nothing is waiting, so write straight from the calling thread.
+    while (Offset < Frame.Num()) {
+      int32 BytesSent = 0;
+      const FMcpSocketReactor::EIoResult Result =
+          FMcpSocketReactor::SendNative(ReactorHandle, Frame.GetData() + Offset,
+                                        Frame.Num() - Offset, BytesSent);
+      if (Result == FMcpSocketReactor::EIoResult::WouldBlock) {
+        break;
+      }
+      if (Result != FMcpSocketReactor::EIoResult::Done) {
+        UE_LOG(LogMcpAutomationBridgeSubsystem, Error,
+               TEXT("Socket Send failed after sending %d / %d bytes"), Offset,
+               Frame.Num());
+        bSendFailed = true;
+        PinnedReactor->Wake();
+        return false;
+      }
+      Offset += BytesSent;
+    }
+    if (Offset == Frame.Num()) {
+      return true;
+    }
+  }
+
+  if (SendQueueHead > 0) {
+    RemoveLeadingBytes(SendQueue, SendQueueHead);
+    SendQueueHead = 0;
+  }
+  SendQueue.Append(Frame.GetData() + Offset, Frame.Num() - Offset);
+  PinnedReactor->AddQueuedSendBytes(Frame.Num() - Offset);
+  if (Queued == 0) {
+    PinnedReactor->Wake();
+  }
+  return true;
+}
+
+bool FMcpBridgeWebSocket::FlushSendQueue() {
+  TSharedPtr<FMcpSocketReactor> PinnedReactor = OwningReactor.Pin();
+  while (SendQueueHead < SendQueue.Num()) {
+    int32 BytesSent = 0;
+    const FMcpSocketReactor::EIoResult Result = FMcpSocketReactor::SendNative(
+        ReactorHandle, SendQueue.GetData() + SendQueueHead,
+        SendQueue.Num() - SendQueueHead, BytesSent);
+    if (Result == FMcpSocketReactor::EIoResult::WouldBlock) {
+      break;
+    }
+    if (Result != FMcpSocketReactor::EIoResult::Done) {
+      return false;
+    }
+    SendQueueHead += BytesSent;
+    if (PinnedReactor.IsValid()) {
+      PinnedReactor->AddQueuedSendBytes(-BytesSent);
+    }
+  }
+  if (SendQueueHead >= SendQueue.Num()) {
+    SendQueue.Reset();
+    SendQueueHead = 0;
+  }
+  return true;
+}
+
+void FMcpBridgeWebSocket::RequestReactorClose(int32 StatusCode,
+                                              const FString &Reason) {
+  {
+    FScopeLock Guard(&SendMutex);
+    if (bCloseRequested) {
+      return;
+    }
+    bCloseRequested = true;
+    CloseStatusCode = StatusCode;
+    CloseReason = Reason;
+    CloseDeadlineSeconds = FPlatformTime::Seconds() + CloseFlushSeconds;
+  }
+  if (TSharedPtr<FMcpSocketReactor> PinnedReactor = OwningReactor.Pin()) {
+    PinnedReactor->Wake();
+  }
+}
+
+void FMcpBridgeWebSocket::TearDownFromReactor(const FString &Reason) {
+  int32 StatusCode = 1001;
+  FString CloseMessage = Reason;
+  {
+    FScopeLock Guard(&SendMutex);
+    FlushSendQueue();
+    if (bCloseRequested) {
+      StatusCode = CloseStatusCode;
+      if (!CloseReason.IsEmpty()) {
+        CloseMessage = CloseReason;
+      }
+    }
+  }
+  TearDown(CloseMessage, false, StatusCode);
+}
+
+UPTRINT FMcpBridgeWebSocket::ReleaseReactorHandle() {
+  FScopeLock Guard(&SendMutex);
+  const int64 Unsent = SendQueue.Num() - SendQueueHead;
+  if (Unsent > 0) {
+    if (TSharedPtr<FMcpSocketReactor> PinnedReactor = OwningReactor.Pin()) {
+      PinnedReactor->AddQueuedSendBytes(-Unsent);
+    }
+  }
+  SendQueue.Empty();
+  SendQueueHead = 0;
+  const UPTRINT Handle = ReactorHandle;
+  ReactorHandle = 0;
+  return Handle;
+}
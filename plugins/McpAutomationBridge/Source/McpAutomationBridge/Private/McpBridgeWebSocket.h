@@ -12,6 +12,8 @@ class FSocket;
 class FInternetAddr;
 class FRunnableThread;
 class FEvent;
+class FMcpSocketReactor;
+struct FMcpSocketReactorStats;
 
 #if WITH_SSL
 struct ssl_ctx_st;
@@ -32,6 +34,10 @@ DECLARE_MULTICAST_DELEGATE_OneParam(FMcpBridgeWebSocketClientConnectedEvent, TSh
 /**
  * Minimal WebSocket client/server used by the MCP Automation Bridge subsystem.
  * Supports text frames over ws:// and optional wss:// transports for local automation traffic.
+ *
+ * A listener either serves every accepted connection from one socket reactor
+ * thread (bUseSocketReactor, plain ws:// only) or gives each connection its
+ * own worker thread.
  */
 class FMcpBridgeWebSocket final : public TSharedFromThis<FMcpBridgeWebSocket>, public FRunnable
 {
@@ -50,10 +56,17 @@ public:
     bool Send(const void* Data, SIZE_T Length);
     bool IsConnected() const;
     bool IsListening() const;
+    /**
+     * True once a send was refused because the client stopped reading; the
+     * connection is closing and the frame was not delivered anywhere.
+     */
+    bool IsBackpressured() const { return bBackpressured; }
 
     // Accessors for diagnostics
     FString GetListenHost() const { return ListenHost; }
     int32 GetPort() const { return Port; }
+    /** Fills OutStats and returns true when this listener serves its clients from a socket reactor. */
+    bool GetReactorStats(FMcpSocketReactorStats& OutStats) const;
 
     void SendHeartbeatPing();
 
@@ -90,11 +103,15 @@ public:
     virtual void Stop() override;
 
 private:
+    friend class FMcpSocketReactor;
+
     uint32 RunClient();
     uint32 RunServer();
+    bool OpenListenSocket();
     void TearDown(const FString& Reason, bool bWasClean, int32 StatusCode);
     bool PerformHandshake();
     bool PerformServerHandshake();
+    bool CompleteServerHandshake(const TArray<uint8>& RequestBuffer, int32 HeaderEndIndex);
     bool ResolveEndpoint(TSharedPtr<FInternetAddr>& OutAddr);
     bool SendFrame(const TArray<uint8>& Frame);
     bool SendCloseFrame(int32 StatusCode, const FString& Reason);
@@ -103,6 +120,7 @@ private:
     void HandleTextPayload(const TArray<uint8>& Payload);
     void ResetFragmentState();
     bool ReceiveFrame();
+    bool HandleFrame(bool bFinalFrame, uint8 OpCode, const TArray<uint8>& Payload);
     bool ReceiveExact(uint8* Buffer, SIZE_T Length);
     bool SendRaw(const uint8* Data, int32 Length, int32& OutBytesSent);
     bool RecvRaw(uint8* Data, int32 Length, int32& OutBytesRead);
@@ -114,6 +132,24 @@ private:
     void CloseNativeSocket();
     FSocket* DetachSocket();
 
+    // Socket reactor: the listener side runs on the caller, the connection
+    // side on the reactor thread unless noted.
+    UPTRINT ReleaseListenSocket();
+    static TSharedPtr<FMcpBridgeWebSocket> CreateReactorConnection(UPTRINT Handle, int32 ListenPort,
+        const TWeakPtr<FMcpBridgeWebSocket>& Listener, const TWeakPtr<FMcpSocketReactor>& InReactor,
+        double NowSeconds);
+    bool HandleReactorReadable(double NowSeconds, int32 MaxBytes);
+    bool HandleReactorWritable();
+    /** Close requests, handler wait and send errors; false once the connection is finished. */
+    bool PumpReactor(double NowSeconds, bool& bOutWantsWrite, double& InOutWaitSeconds);
+    bool DrainBufferedFrames();
+    /** Any thread, SendMutex held. */
+    bool QueueReactorFrame(const TArray<uint8>& Frame);
+    bool FlushSendQueue();
+    void RequestReactorClose(int32 StatusCode, const FString& Reason);
+    void TearDownFromReactor(const FString& Reason);
+    UPTRINT ReleaseReactorHandle();
+
     FString Url;
     FSocket* Socket;
     int32 Port;
@@ -177,4 +213,26 @@ private:
     // Set to true by the game thread when it has registered the message
     // handler for this client connection.
     TAtomic<bool> bHandlerRegistered;
+
+    // Socket reactor. A listener owns its reactor; the connections it accepts
+    // hold it weakly and borrow their native handle from it.
+    TSharedPtr<FMcpSocketReactor> Reactor;
+    TWeakPtr<FMcpSocketReactor> OwningReactor;
+    bool bReactorConnection = false;
+    // Guarded by SendMutex: the handle, the queued bytes not yet written
+    // (from SendQueueHead on) and a pending close.
+    UPTRINT ReactorHandle = 0;
+    TArray<uint8> SendQueue;
+    int32 SendQueueHead = 0;
+    bool bCloseRequested = false;
+    int32 CloseStatusCode = 1000;
+    FString CloseReason;
+    double CloseDeadlineSeconds = 0.0;
+    TAtomic<bool> bSendFailed{false};
+    TAtomic<bool> bBackpressured{false};
+    // Reactor thread only. The deadline bounds the wait for the upgrade
+    // request, then the wait for the game thread's message handler.
+    bool bReactorHandshakeDone = false;
+    bool bAwaitingHandler = false;
+    double PhaseDeadlineSeconds = 0.0;
 };
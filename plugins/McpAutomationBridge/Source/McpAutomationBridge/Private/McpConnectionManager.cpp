@@ -1,10 +1,16 @@
 #include "McpConnectionManager.h"
 #include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
 #include "HAL/PlatformTime.h"
 #include "McpAutomationBridgeSettings.h"
 #include "McpAutomationBridgeSubsystem.h"
+#include "McpBridgeTrace.h"
 #include "McpBridgeWebSocket.h"
+#include "McpSessionStore.h"
+#include "McpSocketReactor.h"
+#include "Misc/FileHelper.h"
 #include "Misc/Guid.h"
+#include "Misc/Paths.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 
@@ -28,7 +34,42 @@ static inline FString SanitizeForLogConnMgr(const FString &In) {
   return Out;
 }
 
-FMcpConnectionManager::FMcpConnectionManager() {}
+/** UTF-8 size of a message as it goes over the wire. */
+static inline int64 McpUtf8Length(const FString &In) {
+  return FPlatformString::ConvertedLength<UTF8CHAR>(*In, In.Len());
+}
+
+/** Bucket bounds (seconds) for the Prometheus histogram export. */
+static const double McpPrometheusBounds[] = {
+    0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1,
+    0.25,   0.5,   1.0,    2.5,   5.0,  10.0,  30.0, 60.0};
+
+static FString McpPrometheusLabel(const FString &In) {
+  return In.Replace(TEXT("\\"), TEXT("\\\\"))
+      .Replace(TEXT("\""), TEXT("\\\""))
+      .Replace(TEXT("\n"), TEXT("\\n"));
+}
+
+/** Sums the reactor counters of every listener; returns how many use one. */
+static int32
+McpSumReactorStats(const TArray<TSharedPtr<FMcpBridgeWebSocket>> &Sockets,
+                   FMcpSocketReactorStats &Out) {
+  int32 Reactors = 0;
+  for (const TSharedPtr<FMcpBridgeWebSocket> &Sock : Sockets) {
+    FMcpSocketReactorStats Stats;
+    if (!Sock.IsValid() || !Sock->GetReactorStats(Stats))
+      continue;
+    ++Reactors;
+    Out.Connections += Stats.Connections;
+    Out.QueuedSendBytes += Stats.QueuedSendBytes;
+    Out.AcceptedConnections += Stats.AcceptedConnections;
+    Out.BackpressureRejects += Stats.BackpressureRejects;
+  }
+  return Reactors;
+}
+
+FMcpConnectionManager::FMcpConnectionManager()
+    : Sessions(MakeUnique<FMcpSessionStore>()) {}
 
 FMcpConnectionManager::~FMcpConnectionManager() { Stop(); }
 
@@ -59,6 +100,14 @@ void FMcpConnectionManager::Initialize(
       TlsCertificatePath = Settings->TlsCertificatePath;
     if (!Settings->TlsPrivateKeyPath.IsEmpty())
       TlsPrivateKeyPath = Settings->TlsPrivateKeyPath;
+    MetricsStartSeconds = FPlatformTime::Seconds();
+    MetricsExportPath = Settings->MetricsExportPath;
+    if (Settings->MetricsExportIntervalSeconds > 0.0f)
+      MetricsExportIntervalSeconds = Settings->MetricsExportIntervalSeconds;
+    Sessions->Configure(Settings->SessionResumeWindowSeconds,
+                        Settings->ResponseReplayWindowSeconds,
+                        Settings->MaxReplayResponsesPerSession,
+                        (int64)Settings->MaxReplayBufferMB * 1024 * 1024);
   }
 }
 
@@ -113,13 +162,16 @@ void FMcpConnectionManager::Stop() {
   }
   ActiveSockets.Empty();
   AuthenticatedSockets.Empty();
+  Sessions->Reset();
   {
     FScopeLock Lock(&RateLimitMutex);
     SocketRateLimits.Empty();
+    LoopbackSockets.Empty();
   }
   {
     FScopeLock Lock(&PendingRequestsMutex);
     PendingRequestsToSockets.Empty();
+    CancelledStreams.Empty();
   }
 
   UE_LOG(LogMcpAutomationBridgeSubsystem, Log,
@@ -139,6 +191,11 @@ void FMcpConnectionManager::SetOnMessageReceived(
   OnMessageReceived = InCallback;
 }
 
+void FMcpConnectionManager::SetOnClientDisconnected(
+    FMcpClientDisconnectedCallback InCallback) {
+  OnClientDisconnected = InCallback;
+}
+
 bool FMcpConnectionManager::Tick(float DeltaTime) {
   // Handle reconnect countdown
   if (bReconnectEnabled && TimeUntilReconnect > 0.0f) {
@@ -162,8 +219,12 @@ bool FMcpConnectionManager::Tick(float DeltaTime) {
     }
   }
 
-  // Telemetry summary
+  // Expire detached sessions and aged replay entries
+  Sessions->Tick(FPlatformTime::Seconds());
+
+  // Telemetry summary and metrics file
   EmitAutomationTelemetrySummaryIfNeeded(FPlatformTime::Seconds());
+  ExportMetricsIfNeeded(FPlatformTime::Seconds());
 
   return true;
 }
@@ -323,7 +384,9 @@ void FMcpConnectionManager::ForceReconnect(const FString &Reason,
 
   for (TSharedPtr<FMcpBridgeWebSocket> &Socket : ActiveSockets) {
     if (Socket.IsValid()) {
+      Sessions->Detach(Socket.Get(), false);
       Socket->Close();
+      OnClientDisconnected.ExecuteIfBound(Socket.Get());
     }
   }
   ActiveSockets.Empty();
@@ -334,6 +397,7 @@ void FMcpConnectionManager::ForceReconnect(const FString &Reason,
   {
     FScopeLock Lock(&PendingRequestsMutex);
     PendingRequestsToSockets.Empty();
+    CancelledStreams.Empty();
   }
 
   bBridgeAvailable = false;
@@ -367,6 +431,7 @@ void FMcpConnectionManager::HandleClientConnected(
   if (!ClientSocket.IsValid())
     return;
   AuthenticatedSockets.Remove(ClientSocket.Get());
+  Sessions->Detach(ClientSocket.Get(), false);
   UE_LOG(LogMcpAutomationBridgeSubsystem, Log,
          TEXT("Client socket connected (port=%d)"), ClientSocket->GetPort());
 
@@ -422,9 +487,11 @@ void FMcpConnectionManager::HandleConnectionError(
 
   if (Socket.IsValid()) {
     AuthenticatedSockets.Remove(Socket.Get());
+    Sessions->Detach(Socket.Get(), false);
     {
       FScopeLock Lock(&RateLimitMutex);
       SocketRateLimits.Remove(Socket.Get());
+      LoopbackSockets.Remove(Socket.Get());
     }
     Socket->OnMessage().RemoveAll(this);
     Socket->OnClosed().RemoveAll(this);
@@ -432,6 +499,7 @@ void FMcpConnectionManager::HandleConnectionError(
     Socket->OnHeartbeat().RemoveAll(this);
     Socket->Close();
     ActiveSockets.Remove(Socket);
+    OnClientDisconnected.ExecuteIfBound(Socket.Get());
   }
 
   if (ActiveSockets.Num() == 0) {
@@ -459,11 +527,18 @@ void FMcpConnectionManager::HandleClosed(TSharedPtr<FMcpBridgeWebSocket> Socket,
          StatusCode, *Reason, bWasClean ? TEXT("true") : TEXT("false"));
   if (Socket.IsValid()) {
     AuthenticatedSockets.Remove(Socket.Get());
+    Sessions->Detach(Socket.Get(), bWasClean);
     {
       FScopeLock Lock(&RateLimitMutex);
       SocketRateLimits.Remove(Socket.Get());
+      LoopbackSockets.Remove(Socket.Get());
+    }
+    {
+      FScopeLock Lock(&MetricsMutex);
+      SocketTraffic.Remove(Socket.Get());
     }
     ActiveSockets.Remove(Socket);
+    OnClientDisconnected.ExecuteIfBound(Socket.Get());
   }
   if (ActiveSockets.Num() == 0 && bReconnectEnabled) {
     TimeUntilReconnect = AutoReconnectDelaySeconds;
@@ -484,7 +559,11 @@ void FMcpConnectionManager::HandleMessage(
     TSharedPtr<FMcpBridgeWebSocket> Socket, const FString &Message) {
   if (!Socket.IsValid())
     return;
+  MCP_TRACE_SCOPE(McpBridge_HandleMessage);
   FMcpBridgeWebSocket *SocketPtr = Socket.Get();
+  const double ReceivedSeconds = FPlatformTime::Seconds();
+  const int64 MessageBytes = McpUtf8Length(Message);
+  RecordTraffic(SocketPtr, false, MessageBytes);
   FString RateLimitReason;
   if (!UpdateRateLimit(SocketPtr, true, false, RateLimitReason)) {
     UE_LOG(LogMcpAutomationBridgeSubsystem, Warning,
@@ -507,7 +586,10 @@ void FMcpConnectionManager::HandleMessage(
 
   TSharedPtr<FJsonObject> RootObj;
   TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
-  if (!FJsonSerializer::Deserialize(Reader, RootObj) || !RootObj.IsValid()) {
+  const bool bParsed =
+      FJsonSerializer::Deserialize(Reader, RootObj) && RootObj.IsValid();
+  const double ParseSeconds = FPlatformTime::Seconds() - ReceivedSeconds;
+  if (!bParsed) {
     UE_LOG(LogMcpAutomationBridgeSubsystem, Warning,
            TEXT("Failed to parse incoming automation message JSON: %s"),
            *SanitizeForLogConnMgr(Message));
@@ -522,7 +604,11 @@ void FMcpConnectionManager::HandleMessage(
     return;
   }
 
-  if (Type.Equals(TEXT("automation_request"), ESearchCase::IgnoreCase)) {
+  // A batch envelope is an automation request for the reserved "batch"
+  // action whose payload is the envelope itself (items, transaction, ...).
+  const bool bIsBatch = Type.Equals(TEXT("batch"), ESearchCase::IgnoreCase);
+  if (bIsBatch ||
+      Type.Equals(TEXT("automation_request"), ESearchCase::IgnoreCase)) {
     if (!UpdateRateLimit(SocketPtr, false, true, RateLimitReason)) {
       UE_LOG(LogMcpAutomationBridgeSubsystem, Warning,
              TEXT("Rate limit exceeded for automation requests: %s"),
@@ -545,10 +631,15 @@ void FMcpConnectionManager::HandleMessage(
     FString RequestId;
     FString Action;
     RootObj->TryGetStringField(TEXT("requestId"), RequestId);
-    RootObj->TryGetStringField(TEXT("action"), Action);
     TSharedPtr<FJsonObject> Payload = nullptr;
     const TSharedPtr<FJsonValue> *PayloadVal =
-        RootObj->Values.Find(TEXT("payload"));
+        bIsBatch ? nullptr : RootObj->Values.Find(TEXT("payload"));
+    if (bIsBatch) {
+      Action = TEXT("batch");
+      Payload = RootObj;
+    } else {
+      RootObj->TryGetStringField(TEXT("action"), Action);
+    }
     if (PayloadVal && (*PayloadVal)->Type == EJson::Object) {
       Payload = (*PayloadVal)->AsObject();
     } else if (PayloadVal) {
@@ -587,6 +678,33 @@ void FMcpConnectionManager::HandleMessage(
       return;
     }
 
+    // A requestId the client's session already knows is never run twice:
+    // answered ones are replayed from the buffer, running ones answer here.
+    FString BufferedResponse;
+    const FMcpSessionStore::EAdmission Admission =
+        Sessions->Admit(SocketPtr, RequestId, BufferedResponse);
+    if (Admission == FMcpSessionStore::EAdmission::Replay) {
+      UE_LOG(LogMcpAutomationBridgeSubsystem, Log,
+             TEXT("Request %s (%s) already answered; replaying response."),
+             *RequestId, *Action);
+      if (Socket->IsConnected() && Socket->Send(BufferedResponse)) {
+        RecordTraffic(SocketPtr, true, McpUtf8Length(BufferedResponse));
+      }
+      return;
+    }
+    if (Admission == FMcpSessionStore::EAdmission::Attach) {
+      UE_LOG(LogMcpAutomationBridgeSubsystem, Log,
+             TEXT("Request %s (%s) is still running; attached duplicate."),
+             *RequestId, *Action);
+      {
+        FScopeLock Lock(&PendingRequestsMutex);
+        PendingRequestsToSockets.Add(RequestId, Socket);
+      }
+      SendProgressUpdate(RequestId, -1.0f,
+                         TEXT("Attached to the running request"));
+      return;
+    }
+
     // Skip logging for console_command - Unreal already logs the command
     const bool bSkipLogging = Action.Equals(TEXT("console_command"), ESearchCase::IgnoreCase);
 
@@ -623,6 +741,10 @@ void FMcpConnectionManager::HandleMessage(
       FScopeLock Lock(&PendingRequestsMutex);
       PendingRequestsToSockets.Add(RequestId, Socket);
     }
+    NoteRequestReceived(RequestId, Action, ReceivedSeconds, ParseSeconds,
+                        MessageBytes);
+    McpTrace::MarkRequest(EMcpTracePhase::Received, RequestId, Action,
+                          MessageBytes);
 
     // Dispatch to subsystem via callback
     if (OnMessageReceived.IsBound()) {
@@ -631,10 +753,40 @@ void FMcpConnectionManager::HandleMessage(
     return;
   }
 
+  if (Type.Equals(TEXT("cancel_stream"), ESearchCase::IgnoreCase)) {
+    FString RequestId;
+    RootObj->TryGetStringField(TEXT("requestId"), RequestId);
+    if (!SocketPtr || !AuthenticatedSockets.Contains(SocketPtr) ||
+        RequestId.IsEmpty()) {
+      return;
+    }
+    // Only the client that owns the request may cancel it, and only while
+    // it is still open.
+    FScopeLock Lock(&PendingRequestsMutex);
+    const TSharedPtr<FMcpBridgeWebSocket> *Owner =
+        PendingRequestsToSockets.Find(RequestId);
+    if (Owner && Owner->Get() == SocketPtr) {
+      CancelledStreams.Add(RequestId);
+      UE_LOG(LogMcpAutomationBridgeSubsystem, Log,
+             TEXT("Client cancelled streamed response %s"), *RequestId);
+    }
+    return;
+  }
+
   if (Type.Equals(TEXT("bridge_hello"), ESearchCase::IgnoreCase)) {
     FString ReceivedToken;
     RootObj->TryGetStringField(TEXT("capabilityToken"), ReceivedToken);
-    if (bRequireCapabilityToken &&
+    FString LoopbackKey;
+    bool bLoopback = false;
+    if (RootObj->TryGetStringField(TEXT("loopbackKey"), LoopbackKey) &&
+        !LoopbackKey.IsEmpty() && SocketPtr) {
+      FScopeLock Lock(&RateLimitMutex);
+      if (LoopbackKeys.Remove(LoopbackKey) > 0) {
+        LoopbackSockets.Add(SocketPtr, LoopbackKey);
+        bLoopback = true;
+      }
+    }
+    if (bRequireCapabilityToken && !bLoopback &&
         (ReceivedToken.IsEmpty() || ReceivedToken != CapabilityToken)) {
       UE_LOG(LogMcpAutomationBridgeSubsystem, Warning,
              TEXT("Capability token mismatch."));
@@ -659,6 +811,34 @@ void FMcpConnectionManager::HandleMessage(
       AuthenticatedSockets.Add(SocketPtr);
     }
 
+    // Resume the client's earlier session when it names one that is still
+    // held; its running requests answer on this socket from now on.
+    FString ResumeSessionId;
+    RootObj->TryGetStringField(TEXT("resumeSessionId"), ResumeSessionId);
+    bool bResumed = false;
+    TArray<FString> Undelivered;
+    TArray<FString> Running;
+    TArray<FString> NotReplayable;
+    const FString ClientSessionId = Sessions->Attach(
+        Socket, ResumeSessionId, bResumed, Undelivered, Running, NotReplayable);
+    if (bResumed) {
+      {
+        FScopeLock Lock(&PendingRequestsMutex);
+        for (const FString &RunningId : Running) {
+          PendingRequestsToSockets.Add(RunningId, Socket);
+        }
+      }
+      UE_LOG(LogMcpAutomationBridgeSubsystem, Log,
+             TEXT("Client resumed session %s: %d response(s) to deliver, %d "
+                  "request(s) still running, %d not replayable."),
+             *ClientSessionId, Undelivered.Num(), Running.Num(),
+             NotReplayable.Num());
+    } else if (!ResumeSessionId.IsEmpty()) {
+      UE_LOG(LogMcpAutomationBridgeSubsystem, Log,
+             TEXT("Session %s is no longer held; started a new session."),
+             *SanitizeForLogConnMgr(ResumeSessionId));
+    }
+
     TSharedRef<FJsonObject> Ack = MakeShared<FJsonObject>();
     Ack->SetStringField(TEXT("type"), TEXT("bridge_ack"));
     Ack->SetStringField(TEXT("message"), TEXT("Automation bridge ready"));
@@ -672,19 +852,36 @@ void FMcpConnectionManager::HandleMessage(
     if (ActiveSessionId.IsEmpty())
       ActiveSessionId = FGuid::NewGuid().ToString();
     Ack->SetStringField(TEXT("sessionId"), ActiveSessionId);
+    Ack->SetStringField(TEXT("clientSessionId"), ClientSessionId);
+    Ack->SetBoolField(TEXT("resumed"), bResumed);
+    Ack->SetNumberField(TEXT("pendingResponses"), Undelivered.Num());
+    Ack->SetNumberField(TEXT("runningRequests"), Running.Num());
+    // Streamed requests whose earlier chunks are not kept; re-issue them.
+    TArray<TSharedPtr<FJsonValue>> NotReplayableIds;
+    for (const FString &RequestId : NotReplayable) {
+      NotReplayableIds.Add(MakeShared<FJsonValueString>(RequestId));
+    }
+    Ack->SetArrayField(TEXT("notReplayable"), NotReplayableIds);
+    Ack->SetNumberField(TEXT("resumeWindowSeconds"),
+                        Sessions->GetResumeWindowSeconds());
     Ack->SetNumberField(TEXT("protocolVersion"), 1);
 
     TArray<TSharedPtr<FJsonValue>> SupportedOps;
     SupportedOps.Add(MakeShared<FJsonValueString>(TEXT("automation_request")));
+    SupportedOps.Add(MakeShared<FJsonValueString>(TEXT("batch")));
+    SupportedOps.Add(MakeShared<FJsonValueString>(TEXT("cancel_stream")));
     Ack->SetArrayField(TEXT("supportedOpcodes"), SupportedOps);
 
     TArray<TSharedPtr<FJsonValue>> ExpectedOps;
     ExpectedOps.Add(MakeShared<FJsonValueString>(TEXT("automation_response")));
+    ExpectedOps.Add(
+        MakeShared<FJsonValueString>(TEXT("automation_response_chunk")));
     Ack->SetArrayField(TEXT("expectedResponseOpcodes"), ExpectedOps);
 
     TArray<TSharedPtr<FJsonValue>> Caps;
     Caps.Add(MakeShared<FJsonValueString>(TEXT("console_commands")));
     Caps.Add(MakeShared<FJsonValueString>(TEXT("native_plugin")));
+    Caps.Add(MakeShared<FJsonValueString>(TEXT("session_resume")));
     Ack->SetArrayField(TEXT("capabilities"), Caps);
 
     Ack->SetNumberField(TEXT("heartbeatIntervalMs"), 0);
@@ -694,6 +891,14 @@ void FMcpConnectionManager::HandleMessage(
         TJsonWriterFactory<>::Create(&Serialized);
     FJsonSerializer::Serialize(Ack, Writer);
     Socket->Send(Serialized);
+
+    // Responses that completed while the client was away, oldest first
+    for (const FString &Response : Undelivered) {
+      if (!Socket->IsConnected() || !Socket->Send(Response)) {
+        break;
+      }
+      RecordTraffic(SocketPtr, true, McpUtf8Length(Response));
+    }
   }
 }
 
@@ -710,6 +915,9 @@ bool FMcpConnectionManager::UpdateRateLimit(FMcpBridgeWebSocket* SocketPtr,
   }
 
   FScopeLock Lock(&RateLimitMutex);
+  if (LoopbackSockets.Contains(SocketPtr)) {
+    return true;
+  }
 
   const double NowSeconds = FPlatformTime::Seconds();
   FSocketRateState& State = SocketRateLimits.FindOrAdd(SocketPtr);
@@ -773,10 +981,41 @@ void FMcpConnectionManager::SendControlMessage(
   SendRawMessage(Serialized);
 }
 
+FString FMcpConnectionManager::GetClientSessionId(
+    const FMcpBridgeWebSocket *Socket) const {
+  return Socket ? Sessions->FindSession(Socket) : FString();
+}
+
+/**
+ * @brief Sends an event that outlives its request (job_completed).
+ *
+ * A session's events go to its current socket only and are buffered for
+ * resume; without a session the event goes to Socket or nowhere, never to
+ * another client.
+ */
+bool FMcpConnectionManager::SendSessionEvent(
+    const FString &ClientSessionId, TSharedPtr<FMcpBridgeWebSocket> Socket,
+    const FString &Serialized) {
+  const bool bSessionEvent =
+      !ClientSessionId.IsEmpty() &&
+      Sessions->ResolveSessionSocket(ClientSessionId, Socket);
+  const bool bSent =
+      Socket.IsValid() && Socket->IsConnected() && Socket->Send(Serialized);
+  if (bSent) {
+    RecordTraffic(Socket.Get(), true, McpUtf8Length(Serialized));
+  }
+  if (bSessionEvent) {
+    Sessions->AddEvent(ClientSessionId, Serialized, bSent);
+  }
+  return bSent;
+}
+
 void FMcpConnectionManager::SendAutomationResponse(
     TSharedPtr<FMcpBridgeWebSocket> TargetSocket, const FString &RequestId,
     bool bSuccess, const FString &Message,
     const TSharedPtr<FJsonObject> &Result, const FString &ErrorCode) {
+  MCP_TRACE_SCOPE(McpBridge_SendResponse);
+  const double ResponseSeconds = FPlatformTime::Seconds();
   TSharedRef<FJsonObject> Response = MakeShared<FJsonObject>();
   Response->SetStringField(TEXT("type"), TEXT("automation_response"));
   Response->SetStringField(TEXT("requestId"), RequestId);
@@ -792,11 +1031,15 @@ void FMcpConnectionManager::SendAutomationResponse(
   const TSharedRef<TJsonWriter<>> Writer =
       TJsonWriterFactory<>::Create(&Serialized);
   FJsonSerializer::Serialize(Response, Writer);
+  const double SerializeSeconds = FPlatformTime::Seconds() - ResponseSeconds;
 
   // Get action from telemetry for better logging context
   FString ActionName = TEXT("unknown");
-  if (FAutomationRequestTelemetry* Entry = ActiveRequestTelemetry.Find(RequestId)) {
-    ActionName = Entry->Action;
+  {
+    FScopeLock Lock(&TelemetryMutex);
+    if (FAutomationRequestTelemetry* Entry = ActiveRequestTelemetry.Find(RequestId)) {
+      ActionName = Entry->Action;
+    }
   }
 
   // Skip logging for console_command - Unreal already logs the command
@@ -834,9 +1077,12 @@ void FMcpConnectionManager::SendAutomationResponse(
            *ResultPreview);
   }
 
-  RecordAutomationTelemetry(RequestId, bSuccess, Message, ErrorCode);
-
+  const double SendStartSeconds = FPlatformTime::Seconds();
+  const FMcpBridgeWebSocket *SentVia = nullptr;
   bool bSent = false;
+  // The client stopped reading and is being disconnected; the response is
+  // never handed to another client.
+  bool bBackpressured = false;
   TArray<FString> AttemptDetails;
   const int MaxAttempts = 3;
 
@@ -849,10 +1095,27 @@ void FMcpConnectionManager::SendAutomationResponse(
     }
   }
 
-  for (int Attempt = 1; Attempt <= MaxAttempts && !bSent; ++Attempt) {
+  // A session's responses go to its current socket only; while it is
+  // disconnected they wait in the replay buffer for the client to resume.
+  TSharedPtr<FMcpBridgeWebSocket> SessionSocket;
+  FString RequestSessionId;
+  const bool bSessionRequest = Sessions->ResolveSocket(
+      TargetSocket.Get(), RequestId, SessionSocket, RequestSessionId);
+  if (bSessionRequest) {
+    TargetSocket = SessionSocket;
+    MappedSocket.Reset();
+  }
+
+  for (int Attempt = 1; Attempt <= MaxAttempts && !bSent && !bBackpressured;
+       ++Attempt) {
     if (TargetSocket.IsValid() && TargetSocket->IsConnected()) {
       if (TargetSocket->Send(Serialized)) {
         bSent = true;
+        SentVia = TargetSocket.Get();
+        break;
+      }
+      if (TargetSocket->IsBackpressured()) {
+        bBackpressured = true;
         break;
       }
     }
@@ -860,11 +1123,16 @@ void FMcpConnectionManager::SendAutomationResponse(
     if (!bSent && MappedSocket.IsValid() && MappedSocket->IsConnected()) {
       if (MappedSocket->Send(Serialized)) {
         bSent = true;
+        SentVia = MappedSocket.Get();
+        break;
+      }
+      if (MappedSocket->IsBackpressured()) {
+        bBackpressured = true;
         break;
       }
     }
 
-    if (!bSent) {
+    if (!bSent && !bSessionRequest) {
       for (const TSharedPtr<FMcpBridgeWebSocket> &Sock : ActiveSockets) {
         if (!Sock.IsValid() || !Sock->IsConnected())
           continue;
@@ -874,13 +1142,38 @@ void FMcpConnectionManager::SendAutomationResponse(
           continue;
         if (Sock->Send(Serialized)) {
           bSent = true;
+          SentVia = Sock.Get();
           break;
         }
       }
     }
   }
 
-  if (!bSent) {
+  const double SendSeconds = FPlatformTime::Seconds() - SendStartSeconds;
+  const int64 ResponseBytes = McpUtf8Length(Serialized);
+  if (SentVia) {
+    RecordTraffic(SentVia, true, ResponseBytes);
+  }
+  RecordRequestTimings(RequestId, bSuccess, ResponseSeconds, SerializeSeconds,
+                       SendSeconds, ResponseBytes);
+  McpTrace::MarkRequest(EMcpTracePhase::Responded, RequestId, ActionName,
+                        ResponseBytes);
+
+  if (bSessionRequest) {
+    Sessions->Complete(RequestSessionId, RequestId, Serialized, bSent);
+    if (!bSent) {
+      UE_LOG(LogMcpAutomationBridgeSubsystem, Log,
+             TEXT("Client of RequestId=%s is %s; response held for "
+                  "session resume."),
+             *RequestId,
+             bBackpressured ? TEXT("not reading") : TEXT("disconnected"));
+    }
+  } else if (bBackpressured) {
+    UE_LOG(LogMcpAutomationBridgeSubsystem, Warning,
+           TEXT("Client of RequestId=%s is not reading; its connection is "
+                "closing and the response was dropped."),
+           *RequestId);
+  } else if (!bSent) {
     UE_LOG(LogMcpAutomationBridgeSubsystem, Warning,
            TEXT("Failed to deliver automation_response for RequestId=%s"),
            *RequestId);
@@ -906,7 +1199,59 @@ void FMcpConnectionManager::SendAutomationResponse(
   {
     FScopeLock Lock(&PendingRequestsMutex);
     PendingRequestsToSockets.Remove(RequestId);
+    CancelledStreams.Remove(RequestId);
+  }
+}
+
+/**
+ * @brief Sends one automation_response_chunk of a streamed response.
+ *
+ * Chunks go to the requesting socket only: a stream is meaningless to any
+ * other client. A session's chunks follow it to its current socket but are
+ * not buffered, so the request is marked as streamed for resume. Returns
+ * false when the socket is gone so the producer can stop iterating.
+ */
+bool FMcpConnectionManager::SendResponseChunk(
+    TSharedPtr<FMcpBridgeWebSocket> TargetSocket, const FString &RequestId,
+    int32 Sequence, const FString &Field,
+    const TArray<TSharedPtr<FJsonValue>> &Items) {
+  MCP_TRACE_SCOPE(McpBridge_SendResponseChunk);
+  TSharedRef<FJsonObject> Chunk = MakeShared<FJsonObject>();
+  Chunk->SetStringField(TEXT("type"), TEXT("automation_response_chunk"));
+  Chunk->SetStringField(TEXT("requestId"), RequestId);
+  Chunk->SetNumberField(TEXT("seq"), Sequence);
+  Chunk->SetStringField(TEXT("field"), Field);
+  Chunk->SetArrayField(TEXT("items"), Items);
+
+  FString Serialized;
+  const TSharedRef<TJsonWriter<>> Writer =
+      TJsonWriterFactory<>::Create(&Serialized);
+  FJsonSerializer::Serialize(Chunk, Writer);
+
+  TSharedPtr<FMcpBridgeWebSocket> SessionSocket;
+  FString RequestSessionId;
+  if (Sessions->ResolveSocket(TargetSocket.Get(), RequestId, SessionSocket,
+                              RequestSessionId)) {
+    Sessions->MarkStreamed(RequestSessionId, RequestId);
+    TargetSocket = SessionSocket;
+  } else if (!TargetSocket.IsValid()) {
+    FScopeLock Lock(&PendingRequestsMutex);
+    if (TSharedPtr<FMcpBridgeWebSocket> *Found =
+            PendingRequestsToSockets.Find(RequestId)) {
+      TargetSocket = *Found;
+    }
   }
+  if (!TargetSocket.IsValid() || !TargetSocket->IsConnected() ||
+      !TargetSocket->Send(Serialized)) {
+    return false;
+  }
+  RecordTraffic(TargetSocket.Get(), true, McpUtf8Length(Serialized));
+  return true;
+}
+
+bool FMcpConnectionManager::IsStreamCancelled(const FString &RequestId) const {
+  FScopeLock Lock(&PendingRequestsMutex);
+  return CancelledStreams.Contains(RequestId);
 }
 
 void FMcpConnectionManager::SendProgressUpdate(
@@ -953,6 +1298,7 @@ void FMcpConnectionManager::SendProgressUpdate(
              TEXT("Failed to send progress update for RequestId=%s"),
              *RequestId);
     } else {
+      RecordTraffic(TargetSocket.Get(), true, McpUtf8Length(Serialized));
       // Verbose logging only for progress updates to avoid flooding logs
       UE_LOG(LogMcpAutomationBridgeSubsystem, Verbose,
              TEXT("Progress update for %s: %.1f%% %s"),
@@ -964,20 +1310,41 @@ void FMcpConnectionManager::SendProgressUpdate(
 void FMcpConnectionManager::RecordAutomationTelemetry(
     const FString &RequestId, bool bSuccess, const FString &Message,
     const FString &ErrorCode) {
-  const double NowSeconds = FPlatformTime::Seconds();
+  RecordRequestTimings(RequestId, bSuccess, FPlatformTime::Seconds(), 0.0,
+                       0.0, 0);
+}
 
+/**
+ * @brief Closes a request's telemetry entry and folds its phase timings into
+ * the per-action stats.
+ *
+ * Phases: parse (JSON decode on the socket thread), queue (arrival to
+ * dispatch), handler (dispatch to response), serialize and send. Serialize
+ * and send are zero for responses consumed inside the editor (batch items).
+ */
+void FMcpConnectionManager::RecordRequestTimings(
+    const FString &RequestId, bool bSuccess, double ResponseSeconds,
+    double SerializeSeconds, double SendSeconds, int64 ResponseBytes) {
   FAutomationRequestTelemetry Entry;
-  if (!ActiveRequestTelemetry.RemoveAndCopyValue(RequestId, Entry)) {
-    return;
+  {
+    FScopeLock Lock(&TelemetryMutex);
+    if (!ActiveRequestTelemetry.RemoveAndCopyValue(RequestId, Entry)) {
+      return;
+    }
   }
 
   const FString ActionKey =
       Entry.Action.IsEmpty() ? TEXT("unknown") : Entry.Action;
+  const double DispatchSeconds =
+      Entry.StartTimeSeconds > 0.0 ? Entry.StartTimeSeconds : ResponseSeconds;
+  const double ArrivalSeconds =
+      Entry.ReceivedSeconds > 0.0 ? Entry.ReceivedSeconds : DispatchSeconds;
+  const double DurationSeconds =
+      FMath::Max(0.0, ResponseSeconds - DispatchSeconds);
+
+  FScopeLock Lock(&MetricsMutex);
   FAutomationActionStats &Stats =
       AutomationActionTelemetry.FindOrAdd(ActionKey);
-
-  const double DurationSeconds =
-      FMath::Max(0.0, NowSeconds - Entry.StartTimeSeconds);
   if (bSuccess) {
     ++Stats.SuccessCount;
     Stats.TotalSuccessDurationSeconds += DurationSeconds;
@@ -987,7 +1354,332 @@ void FMcpConnectionManager::RecordAutomationTelemetry(
   }
 
   Stats.LastDurationSeconds = DurationSeconds;
-  Stats.LastUpdatedSeconds = NowSeconds;
+  Stats.LastUpdatedSeconds = ResponseSeconds;
+
+  if (Entry.ReceivedSeconds > 0.0) {
+    Stats.ParseLatency.Record(Entry.ParseSeconds);
+    Stats.QueueLatency.Record(DispatchSeconds - Entry.ReceivedSeconds);
+  }
+  Stats.HandlerLatency.Record(DurationSeconds);
+  if (ResponseBytes > 0) {
+    Stats.SerializeLatency.Record(SerializeSeconds);
+    Stats.SendLatency.Record(SendSeconds);
+  }
+  Stats.TotalLatency.Record(ResponseSeconds + SerializeSeconds + SendSeconds -
+                            ArrivalSeconds);
+  Stats.RequestBytes += Entry.RequestBytes;
+  Stats.ResponseBytes += ResponseBytes;
+}
+
+void FMcpConnectionManager::NoteRequestReceived(const FString &RequestId,
+                                                const FString &Action,
+                                                double ReceivedSeconds,
+                                                double ParseSeconds,
+                                                int64 RequestBytes) {
+  FScopeLock Lock(&TelemetryMutex);
+  FAutomationRequestTelemetry &Entry =
+      ActiveRequestTelemetry.FindOrAdd(RequestId);
+  const FString LowerAction = Action.ToLower();
+  Entry.Action = LowerAction.IsEmpty() ? Action : LowerAction;
+  Entry.ReceivedSeconds = ReceivedSeconds;
+  Entry.ParseSeconds = ParseSeconds;
+  Entry.RequestBytes = RequestBytes;
+}
+
+void FMcpConnectionManager::RecordTraffic(const FMcpBridgeWebSocket *SocketPtr,
+                                          bool bOutgoing, int64 Bytes) {
+  FScopeLock Lock(&MetricsMutex);
+  if (bOutgoing) {
+    ++TotalMessagesOut;
+    TotalBytesOut += Bytes;
+  } else {
+    ++TotalMessagesIn;
+    TotalBytesIn += Bytes;
+  }
+  if (!SocketPtr) {
+    return;
+  }
+  FSocketTrafficStats *Traffic = SocketTraffic.Find(SocketPtr);
+  if (!Traffic) {
+    Traffic = &SocketTraffic.Add(SocketPtr);
+    Traffic->Label = FString::Printf(TEXT("client-%d"), NextTrafficClientIndex++);
+    Traffic->FirstSeenSeconds = FPlatformTime::Seconds();
+  }
+  if (bOutgoing) {
+    ++Traffic->MessagesOut;
+    Traffic->BytesOut += Bytes;
+  } else {
+    ++Traffic->MessagesIn;
+    Traffic->BytesIn += Bytes;
+  }
+}
+
+TSharedPtr<FJsonObject>
+FMcpConnectionManager::GetMetricsJson(const FString &ActionFilter) const {
+  const double Now = FPlatformTime::Seconds();
+  FScopeLock Lock(&MetricsMutex);
+
+  TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+  Json->SetNumberField(TEXT("uptimeSeconds"), Now - MetricsStartSeconds);
+
+  TSharedPtr<FJsonObject> Traffic = MakeShared<FJsonObject>();
+  Traffic->SetNumberField(TEXT("messagesIn"), (double)TotalMessagesIn);
+  Traffic->SetNumberField(TEXT("messagesOut"), (double)TotalMessagesOut);
+  Traffic->SetNumberField(TEXT("bytesIn"), (double)TotalBytesIn);
+  Traffic->SetNumberField(TEXT("bytesOut"), (double)TotalBytesOut);
+  Json->SetObjectField(TEXT("traffic"), Traffic);
+
+  TArray<TSharedPtr<FJsonValue>> Clients;
+  for (const TPair<const FMcpBridgeWebSocket *, FSocketTrafficStats> &Pair :
+       SocketTraffic) {
+    const FSocketTrafficStats &Stats = Pair.Value;
+    const double Elapsed = FMath::Max(1.0, Now - Stats.FirstSeenSeconds);
+    TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+    Entry->SetStringField(TEXT("client"), Stats.Label);
+    Entry->SetNumberField(TEXT("messagesIn"), (double)Stats.MessagesIn);
+    Entry->SetNumberField(TEXT("messagesOut"), (double)Stats.MessagesOut);
+    Entry->SetNumberField(TEXT("bytesIn"), (double)Stats.BytesIn);
+    Entry->SetNumberField(TEXT("bytesOut"), (double)Stats.BytesOut);
+    Entry->SetNumberField(TEXT("messagesPerSecond"),
+                          (Stats.MessagesIn + Stats.MessagesOut) / Elapsed);
+    Entry->SetNumberField(TEXT("bytesPerSecond"),
+                          (Stats.BytesIn + Stats.BytesOut) / Elapsed);
+    Clients.Add(MakeShared<FJsonValueObject>(Entry));
+  }
+  Json->SetArrayField(TEXT("clients"), Clients);
+
+  TSharedPtr<FJsonObject> Actions = MakeShared<FJsonObject>();
+  for (const TPair<FString, FAutomationActionStats> &Pair :
+       AutomationActionTelemetry) {
+    if (!ActionFilter.IsEmpty() &&
+        !Pair.Key.Equals(ActionFilter, ESearchCase::IgnoreCase)) {
+      continue;
+    }
+    const FAutomationActionStats &Stats = Pair.Value;
+    TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+    Entry->SetNumberField(TEXT("success"), Stats.SuccessCount);
+    Entry->SetNumberField(TEXT("failure"), Stats.FailureCount);
+    Entry->SetNumberField(TEXT("requestBytes"), (double)Stats.RequestBytes);
+    Entry->SetNumberField(TEXT("responseBytes"), (double)Stats.ResponseBytes);
+
+    TSharedPtr<FJsonObject> Phases = MakeShared<FJsonObject>();
+    Phases->SetObjectField(TEXT("parse"), Stats.ParseLatency.ToJson());
+    Phases->SetObjectField(TEXT("queue"), Stats.QueueLatency.ToJson());
+    Phases->SetObjectField(TEXT("handler"), Stats.HandlerLatency.ToJson());
+    Phases->SetObjectField(TEXT("serialize"), Stats.SerializeLatency.ToJson());
+    Phases->SetObjectField(TEXT("send"), Stats.SendLatency.ToJson());
+    Phases->SetObjectField(TEXT("total"), Stats.TotalLatency.ToJson());
+    Entry->SetObjectField(TEXT("phases"), Phases);
+    Actions->SetObjectField(Pair.Key, Entry);
+  }
+  Json->SetObjectField(TEXT("actions"), Actions);
+  Json->SetObjectField(TEXT("sessions"), Sessions->GetStatsJson());
+
+  FMcpSocketReactorStats ReactorStats;
+  const int32 Reactors = McpSumReactorStats(ActiveSockets, ReactorStats);
+  TSharedPtr<FJsonObject> Transport = MakeShared<FJsonObject>();
+  Transport->SetStringField(TEXT("mode"),
+                            Reactors > 0 ? TEXT("reactor") : TEXT("threads"));
+  Transport->SetNumberField(TEXT("reactorThreads"), Reactors);
+  Transport->SetNumberField(TEXT("connections"), ReactorStats.Connections);
+  Transport->SetNumberField(TEXT("queuedSendBytes"),
+                            (double)ReactorStats.QueuedSendBytes);
+  Transport->SetNumberField(TEXT("acceptedConnections"),
+                            (double)ReactorStats.AcceptedConnections);
+  Transport->SetNumberField(TEXT("backpressureRejects"),
+                            (double)ReactorStats.BackpressureRejects);
+  Json->SetObjectField(TEXT("transport"), Transport);
+  return Json;
+}
+
+FString FMcpConnectionManager::GetMetricsPrometheusText() const {
+  FScopeLock Lock(&MetricsMutex);
+  FString Out;
+
+  Out += TEXT("# HELP mcp_bridge_requests_total Automation requests answered.\n");
+  Out += TEXT("# TYPE mcp_bridge_requests_total counter\n");
+  for (const TPair<FString, FAutomationActionStats> &Pair :
+       AutomationActionTelemetry) {
+    const FString Action = McpPrometheusLabel(Pair.Key);
+    Out += FString::Printf(
+        TEXT("mcp_bridge_requests_total{action=\"%s\",outcome=\"success\"} %d\n"),
+        *Action, Pair.Value.SuccessCount);
+    Out += FString::Printf(
+        TEXT("mcp_bridge_requests_total{action=\"%s\",outcome=\"failure\"} %d\n"),
+        *Action, Pair.Value.FailureCount);
+  }
+
+  Out += TEXT("# HELP mcp_bridge_request_phase_seconds Request latency by action and phase.\n");
+  Out += TEXT("# TYPE mcp_bridge_request_phase_seconds histogram\n");
+  for (const TPair<FString, FAutomationActionStats> &Pair :
+       AutomationActionTelemetry) {
+    const FString Action = McpPrometheusLabel(Pair.Key);
+    struct FPhase {
+      const TCHAR *Key;
+      const FMcpLatencyHistogram *Value;
+    };
+    const FPhase Phases[] = {
+        {TEXT("parse"), &Pair.Value.ParseLatency},
+        {TEXT("queue"), &Pair.Value.QueueLatency},
+        {TEXT("handler"), &Pair.Value.HandlerLatency},
+        {TEXT("serialize"), &Pair.Value.SerializeLatency},
+        {TEXT("send"), &Pair.Value.SendLatency},
+        {TEXT("total"), &Pair.Value.TotalLatency}};
+    for (const FPhase &Phase : Phases) {
+      const FMcpLatencyHistogram &Histogram = *Phase.Value;
+      if (Histogram.Count == 0) {
+        continue;
+      }
+      for (const double Bound : McpPrometheusBounds) {
+        Out += FString::Printf(
+            TEXT("mcp_bridge_request_phase_seconds_bucket{action=\"%s\",phase=\"%s\",le=\"%g\"} %llu\n"),
+            *Action, Phase.Key, Bound,
+            (unsigned long long)Histogram.CountAtOrBelow(Bound));
+      }
+      Out += FString::Printf(
+          TEXT("mcp_bridge_request_phase_seconds_bucket{action=\"%s\",phase=\"%s\",le=\"+Inf\"} %llu\n"),
+          *Action, Phase.Key, (unsigned long long)Histogram.Count);
+      Out += FString::Printf(
+          TEXT("mcp_bridge_request_phase_seconds_sum{action=\"%s\",phase=\"%s\"} %f\n"),
+          *Action, Phase.Key, Histogram.SumSeconds);
+      Out += FString::Printf(
+          TEXT("mcp_bridge_request_phase_seconds_count{action=\"%s\",phase=\"%s\"} %llu\n"),
+          *Action, Phase.Key, (unsigned long long)Histogram.Count);
+    }
+  }
+
+  Out += TEXT("# HELP mcp_bridge_action_bytes_total Request and response payload bytes by action.\n");
+  Out += TEXT("# TYPE mcp_bridge_action_bytes_total counter\n");
+  for (const TPair<FString, FAutomationActionStats> &Pair :
+       AutomationActionTelemetry) {
+    const FString Action = McpPrometheusLabel(Pair.Key);
+    Out += FString::Printf(
+        TEXT("mcp_bridge_action_bytes_total{action=\"%s\",direction=\"request\"} %lld\n"),
+        *Action, (long long)Pair.Value.RequestBytes);
+    Out += FString::Printf(
+        TEXT("mcp_bridge_action_bytes_total{action=\"%s\",direction=\"response\"} %lld\n"),
+        *Action, (long long)Pair.Value.ResponseBytes);
+  }
+
+  Out += TEXT("# HELP mcp_bridge_bytes_total WebSocket text payload bytes.\n");
+  Out += TEXT("# TYPE mcp_bridge_bytes_total counter\n");
+  Out += FString::Printf(TEXT("mcp_bridge_bytes_total{direction=\"in\"} %lld\n"), (long long)TotalBytesIn);
+  Out += FString::Printf(TEXT("mcp_bridge_bytes_total{direction=\"out\"} %lld\n"), (long long)TotalBytesOut);
+  Out += TEXT("# HELP mcp_bridge_messages_total WebSocket text messages.\n");
+  Out += TEXT("# TYPE mcp_bridge_messages_total counter\n");
+  Out += FString::Printf(TEXT("mcp_bridge_messages_total{direction=\"in\"} %lld\n"), (long long)TotalMessagesIn);
+  Out += FString::Printf(TEXT("mcp_bridge_messages_total{direction=\"out\"} %lld\n"), (long long)TotalMessagesOut);
+
+  Out += TEXT("# HELP mcp_bridge_client_bytes_total WebSocket payload bytes per connected client.\n");
+  Out += TEXT("# TYPE mcp_bridge_client_bytes_total counter\n");
+  for (const TPair<const FMcpBridgeWebSocket *, FSocketTrafficStats> &Pair :
+       SocketTraffic) {
+    const FString Client = McpPrometheusLabel(Pair.Value.Label);
+    Out += FString::Printf(
+        TEXT("mcp_bridge_client_bytes_total{client=\"%s\",direction=\"in\"} %lld\n"),
+        *Client, (long long)Pair.Value.BytesIn);
+    Out += FString::Printf(
+        TEXT("mcp_bridge_client_bytes_total{client=\"%s\",direction=\"out\"} %lld\n"),
+        *Client, (long long)Pair.Value.BytesOut);
+  }
+
+  Sessions->AppendPrometheusText(Out);
+
+  FMcpSocketReactorStats ReactorStats;
+  McpSumReactorStats(ActiveSockets, ReactorStats);
+  Out += TEXT("# HELP mcp_bridge_reactor_connections Client connections served by socket reactors.\n");
+  Out += TEXT("# TYPE mcp_bridge_reactor_connections gauge\n");
+  Out += FString::Printf(TEXT("mcp_bridge_reactor_connections %d\n"), ReactorStats.Connections);
+  Out += TEXT("# HELP mcp_bridge_send_queue_bytes Outgoing bytes waiting on clients that are not reading.\n");
+  Out += TEXT("# TYPE mcp_bridge_send_queue_bytes gauge\n");
+  Out += FString::Printf(TEXT("mcp_bridge_send_queue_bytes %lld\n"), (long long)ReactorStats.QueuedSendBytes);
+  Out += TEXT("# HELP mcp_bridge_send_backpressure_total Sends refused because a client's send queue was full.\n");
+  Out += TEXT("# TYPE mcp_bridge_send_backpressure_total counter\n");
+  Out += FString::Printf(TEXT("mcp_bridge_send_backpressure_total %llu\n"),
+                         (unsigned long long)ReactorStats.BackpressureRejects);
+  return Out;
+}
+
+void FMcpConnectionManager::ResetMetrics() {
+  FScopeLock Lock(&MetricsMutex);
+  AutomationActionTelemetry.Empty();
+  for (TPair<const FMcpBridgeWebSocket *, FSocketTrafficStats> &Pair :
+       SocketTraffic) {
+    const FString Label = Pair.Value.Label;
+    Pair.Value = FSocketTrafficStats();
+    Pair.Value.Label = Label;
+    Pair.Value.FirstSeenSeconds = FPlatformTime::Seconds();
+  }
+  TotalMessagesIn = TotalMessagesOut = 0;
+  TotalBytesIn = TotalBytesOut = 0;
+  MetricsStartSeconds = FPlatformTime::Seconds();
+}
+
+/**
+ * @brief Address in-process clients use to reach the first listening socket.
+ *
+ * Wildcard binds (empty, 0.0.0.0, ::) are reached through 127.0.0.1.
+ */
+FString FMcpConnectionManager::GetLoopbackUrl() const {
+  for (const TSharedPtr<FMcpBridgeWebSocket> &Sock : ActiveSockets) {
+    if (!Sock.IsValid() || !Sock->IsListening())
+      continue;
+    FString Host = EnvListenHost.TrimStartAndEnd();
+    if (Host.IsEmpty() || Host == TEXT("0.0.0.0") || Host == TEXT("::")) {
+      Host = TEXT("127.0.0.1");
+    } else if (Host.Contains(TEXT(":")) && !Host.StartsWith(TEXT("["))) {
+      Host = FString::Printf(TEXT("[%s]"), *Host);
+    }
+    return FString::Printf(TEXT("%s://%s:%d"),
+                           bEnableTls ? TEXT("wss") : TEXT("ws"), *Host,
+                           Sock->GetPort());
+  }
+  return FString();
+}
+
+FString FMcpConnectionManager::IssueLoopbackKey() {
+  const FString Key = FGuid::NewGuid().ToString(EGuidFormats::Digits);
+  FScopeLock Lock(&RateLimitMutex);
+  LoopbackKeys.Add(Key);
+  return Key;
+}
+
+void FMcpConnectionManager::RevokeLoopbackKey(const FString &Key) {
+  FScopeLock Lock(&RateLimitMutex);
+  LoopbackKeys.Remove(Key);
+  for (auto It = LoopbackSockets.CreateIterator(); It; ++It) {
+    if (It.Value() == Key) {
+      It.RemoveCurrent();
+    }
+  }
+}
+
+/**
+ * @brief Writes the Prometheus text exposition to MetricsExportPath for a
+ * node_exporter textfile collector or similar scraper.
+ *
+ * Relative paths resolve against the project's Saved directory. The file is
+ * written next to the target and moved into place so scrapers never read a
+ * partial file.
+ */
+void FMcpConnectionManager::ExportMetricsIfNeeded(double NowSeconds) {
+  if (MetricsExportPath.IsEmpty() ||
+      NowSeconds - LastMetricsExportSeconds < MetricsExportIntervalSeconds) {
+    return;
+  }
+  LastMetricsExportSeconds = NowSeconds;
+
+  const FString Target =
+      FPaths::IsRelative(MetricsExportPath)
+          ? FPaths::Combine(FPaths::ProjectSavedDir(), MetricsExportPath)
+          : MetricsExportPath;
+  const FString Temp = Target + TEXT(".tmp");
+  if (!FFileHelper::SaveStringToFile(GetMetricsPrometheusText(), *Temp,
+                                     FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM) ||
+      !IFileManager::Get().Move(*Target, *Temp, true, true)) {
+    UE_LOG(LogMcpAutomationBridgeSubsystem, Warning,
+           TEXT("Failed to write bridge metrics to %s"), *Target);
+  }
 }
 
 void FMcpConnectionManager::EmitAutomationTelemetrySummaryIfNeeded(
@@ -999,6 +1691,7 @@ void FMcpConnectionManager::EmitAutomationTelemetrySummaryIfNeeded(
     return;
 
   LastTelemetrySummaryLogSeconds = NowSeconds;
+  FScopeLock Lock(&MetricsMutex);
   if (AutomationActionTelemetry.Num() == 0)
     return;
 
@@ -1018,10 +1711,13 @@ void FMcpConnectionManager::EmitAutomationTelemetrySummaryIfNeeded(
             ? (Stats.TotalFailureDurationSeconds / Stats.FailureCount)
             : 0.0;
     Lines.Add(FString::Printf(TEXT("%s success=%d failure=%d last=%.3fs "
-                                   "avgSuccess=%.3fs avgFailure=%.3fs"),
+                                   "avgSuccess=%.3fs avgFailure=%.3fs "
+                                   "p50=%.3fs p99=%.3fs"),
                               *ActionKey, Stats.SuccessCount,
                               Stats.FailureCount, Stats.LastDurationSeconds,
-                              AvgSuccess, AvgFailure));
+                              AvgSuccess, AvgFailure,
+                              Stats.TotalLatency.Percentile(50.0),
+                              Stats.TotalLatency.Percentile(99.0)));
   }
   Lines.Sort();
   UE_LOG(LogMcpAutomationBridgeSubsystem, Log,
@@ -1041,15 +1737,27 @@ void FMcpConnectionManager::RegisterRequestSocket(
   }
 }
 
+void FMcpConnectionManager::UnregisterRequestSocket(const FString &RequestId) {
+  FScopeLock Lock(&PendingRequestsMutex);
+  PendingRequestsToSockets.Remove(RequestId);
+}
+
 void FMcpConnectionManager::StartRequestTelemetry(const FString &RequestId,
                                                   const FString &Action) {
-  if (!ActiveRequestTelemetry.Contains(RequestId)) {
+  FScopeLock Lock(&TelemetryMutex);
+  FAutomationRequestTelemetry *Existing = ActiveRequestTelemetry.Find(RequestId);
+  if (Existing && !Existing->bDispatched) {
+    // Arrived over the socket: the gap since arrival is queue time.
+    Existing->StartTimeSeconds = FPlatformTime::Seconds();
+    Existing->bDispatched = true;
+  } else if (!Existing) {
     FAutomationRequestTelemetry Entry;
     // Store lowercase action for consistent aggregation, similar to original
     // logic
     const FString LowerAction = Action.ToLower();
     Entry.Action = LowerAction.IsEmpty() ? Action : LowerAction;
     Entry.StartTimeSeconds = FPlatformTime::Seconds();
+    Entry.bDispatched = true;
     ActiveRequestTelemetry.Add(RequestId, Entry);
   }
 }
@@ -0,0 +1,70 @@
+#include "McpLatencyHistogram.h"
+
+void FMcpLatencyHistogram::Record(double Seconds)
+{
+    Seconds = FMath::Max(0.0, Seconds);
+    const double Micros = Seconds * 1000000.0;
+    const int32 Index = Micros < 1.0
+        ? 0
+        : FMath::Clamp(FMath::FloorToInt(FMath::Log2(Micros) * BucketsPerOctave), 0, NumBuckets - 1);
+    ++Buckets[Index];
+
+    MinSeconds = Count == 0 ? Seconds : FMath::Min(MinSeconds, Seconds);
+    MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+    SumSeconds += Seconds;
+    ++Count;
+}
+
+void FMcpLatencyHistogram::Reset()
+{
+    *this = FMcpLatencyHistogram();
+}
+
+double FMcpLatencyHistogram::BucketUpperSeconds(int32 Index)
+{
+    return FMath::Pow(2.0, double(Index + 1) / BucketsPerOctave) / 1000000.0;
+}
+
+double FMcpLatencyHistogram::Percentile(double Percent) const
+{
+    if (Count == 0)
+    {
+        return 0.0;
+    }
+    const uint64 Rank = FMath::Max<uint64>(1, (uint64)FMath::CeilToDouble(FMath::Clamp(Percent, 0.0, 100.0) / 100.0 * Count));
+    uint64 Seen = 0;
+    for (int32 Index = 0; Index < NumBuckets; ++Index)
+    {
+        Seen += Buckets[Index];
+        if (Seen >= Rank)
+        {
+            // The bucket bound can overshoot the largest sample; never report above it.
+            return FMath::Min(BucketUpperSeconds(Index), MaxSeconds);
+        }
+    }
+    return MaxSeconds;
+}
+
+uint64 FMcpLatencyHistogram::CountAtOrBelow(double Seconds) const
+{
+    uint64 Total = 0;
+    for (int32 Index = 0; Index < NumBuckets && BucketUpperSeconds(Index) <= Seconds; ++Index)
+    {
+        Total += Buckets[Index];
+    }
+    return Total;
+}
+
+TSharedPtr<FJsonObject> FMcpLatencyHistogram::ToJson() const
+{
+    TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetNumberField(TEXT("count"), (double)Count);
+    Json->SetNumberField(TEXT("meanMs"), Count > 0 ? SumSeconds / Count * 1000.0 : 0.0);
+    Json->SetNumberField(TEXT("minMs"), MinSeconds * 1000.0);
+    Json->SetNumberField(TEXT("maxMs"), MaxSeconds * 1000.0);
+    Json->SetNumberField(TEXT("p50Ms"), Percentile(50.0) * 1000.0);
+    Json->SetNumberField(TEXT("p90Ms"), Percentile(90.0) * 1000.0);
+    Json->SetNumberField(TEXT("p99Ms"), Percentile(99.0) * 1000.0);
+    Json->SetNumberField(TEXT("p999Ms"), Percentile(99.9) * 1000.0);
+    return Json;
+}
@@ -0,0 +1,511 @@
+#include "McpLevelSnapshot.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Components/SceneComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "Hash/CityHash.h"
+#include "Materials/MaterialInterface.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+/** Serialize everything that contributes to the content hash (i.e. all fields except Hash). */
+void McpSerializeActorSnapshotState(FArchive& Ar, FMcpActorSnapshot& Actor)
+{
+    Ar << Actor.ActorPath;
+    Ar << Actor.ClassPath;
+    Ar << Actor.Label;
+    Ar << Actor.FolderPath;
+    Ar << Actor.Transform;
+    Ar << Actor.bHidden;
+
+    // Names go through strings so the format does not depend on the name table
+    TArray<FString> TagStrings;
+    if (Ar.IsSaving())
+    {
+        for (const FName& Tag : Actor.Tags)
+        {
+            TagStrings.Add(Tag.ToString());
+        }
+    }
+    Ar << TagStrings;
+    if (Ar.IsLoading())
+    {
+        Actor.Tags.Reset(TagStrings.Num());
+        for (const FString& Tag : TagStrings)
+        {
+            Actor.Tags.Add(FName(*Tag));
+        }
+    }
+
+    Ar << Actor.Components;
+}
+
+FString McpObjectPathOrEmpty(const UObject* Object)
+{
+    return Object ? Object->GetPathName() : FString();
+}
+}
+
+FArchive& operator<<(FArchive& Ar, FMcpComponentSnapshot& Component)
+{
+    Ar << Component.Name;
+    Ar << Component.RelativeTransform;
+    Ar << Component.bVisible;
+    Ar << Component.bHiddenInGame;
+    Ar << Component.StaticMesh;
+    Ar << Component.Materials;
+    return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FMcpActorSnapshot& Actor)
+{
+    McpSerializeActorSnapshotState(Ar, Actor);
+    Ar << Actor.Hash;
+    return Ar;
+}
+
+void FMcpActorSnapshot::ComputeHash()
+{
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+    McpSerializeActorSnapshotState(Writer, *this);
+    Hash = CityHash64(reinterpret_cast<const char*>(Bytes.GetData()), Bytes.Num());
+}
+
+void FMcpActorSnapshot::Capture(AActor* Actor)
+{
+    ActorPath = Actor->GetPathName();
+    ClassPath = Actor->GetClass()->GetPathName();
+    Transform = Actor->GetActorTransform();
+    bHidden = Actor->IsHidden();
+    Tags = Actor->Tags;
+#if WITH_EDITOR
+    Label = Actor->GetActorLabel();
+    FolderPath = Actor->GetFolderPath().ToString();
+#endif
+
+    TInlineComponentArray<USceneComponent*> SceneComponents(Actor);
+    SceneComponents.Sort([](const USceneComponent& A, const USceneComponent& B)
+    {
+        return A.GetName() < B.GetName();
+    });
+
+    Components.Reset(SceneComponents.Num());
+    for (USceneComponent* SceneComponent : SceneComponents)
+    {
+        FMcpComponentSnapshot& Component = Components.AddDefaulted_GetRef();
+        Component.Name = SceneComponent->GetName();
+        Component.RelativeTransform = SceneComponent->GetRelativeTransform();
+        Component.bVisible = SceneComponent->IsVisible();
+        Component.bHiddenInGame = SceneComponent->bHiddenInGame;
+
+        if (const UStaticMeshComponent* MeshComponent = Cast<UStaticMeshComponent>(SceneComponent))
+        {
+            Component.StaticMesh = McpObjectPathOrEmpty(MeshComponent->GetStaticMesh());
+        }
+        if (const UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(SceneComponent))
+        {
+            const int32 NumMaterials = Primitive->GetNumMaterials();
+            Component.Materials.Reset(NumMaterials);
+            for (int32 Slot = 0; Slot < NumMaterials; ++Slot)
+            {
+                Component.Materials.Add(McpObjectPathOrEmpty(Primitive->GetMaterial(Slot)));
+            }
+        }
+    }
+
+    ComputeHash();
+}
+
+bool FMcpActorSnapshot::Apply(AActor* Actor, bool bTransact) const
+{
+    if (!Actor)
+    {
+        return false;
+    }
+
+    bool bChanged = false;
+    auto Touch = [&bChanged, bTransact](UObject* Object)
+    {
+        if (bTransact)
+        {
+            Object->Modify();
+        }
+        bChanged = true;
+    };
+
+    if (!Actor->GetActorTransform().Equals(Transform))
+    {
+        Touch(Actor);
+        Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+    }
+    if (Actor->IsHidden() != bHidden)
+    {
+        Touch(Actor);
+        Actor->SetActorHiddenInGame(bHidden);
+    }
+    if (Actor->Tags != Tags)
+    {
+        Touch(Actor);
+        Actor->Tags = Tags;
+    }
+#if WITH_EDITOR
+    if (!Label.IsEmpty() && Actor->GetActorLabel() != Label)
+    {
+        Touch(Actor);
+        Actor->SetActorLabel(Label);
+    }
+    if (Actor->GetFolderPath().ToString() != FolderPath)
+    {
+        Touch(Actor);
+        Actor->SetFolderPath(FolderPath.IsEmpty() ? NAME_None : FName(*FolderPath));
+    }
+#endif
+
+    TInlineComponentArray<USceneComponent*> SceneComponents(Actor);
+    for (const FMcpComponentSnapshot& Component : Components)
+    {
+        USceneComponent* const* Found = SceneComponents.FindByPredicate([&Component](const USceneComponent* Candidate)
+        {
+            return Candidate->GetName() == Component.Name;
+        });
+        if (!Found || !*Found)
+        {
+            continue;
+        }
+        USceneComponent* SceneComponent = *Found;
+
+        if (!SceneComponent->GetRelativeTransform().Equals(Component.RelativeTransform))
+        {
+            Touch(SceneComponent);
+            SceneComponent->SetRelativeTransform(Component.RelativeTransform, false, nullptr, ETeleportType::TeleportPhysics);
+        }
+        if (SceneComponent->IsVisible() != Component.bVisible)
+        {
+            Touch(SceneComponent);
+            SceneComponent->SetVisibility(Component.bVisible);
+        }
+        if (SceneComponent->bHiddenInGame != Component.bHiddenInGame)
+        {
+            Touch(SceneComponent);
+            SceneComponent->SetHiddenInGame(Component.bHiddenInGame);
+        }
+
+        if (UStaticMeshComponent* MeshComponent = Cast<UStaticMeshComponent>(SceneComponent))
+        {
+            if (McpObjectPathOrEmpty(MeshComponent->GetStaticMesh()) != Component.StaticMesh)
+            {
+                Touch(MeshComponent);
+                MeshComponent->SetStaticMesh(Component.StaticMesh.IsEmpty()
+                    ? nullptr
+                    : LoadObject<UStaticMesh>(nullptr, *Component.StaticMesh));
+            }
+        }
+        if (UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(SceneComponent))
+        {
+            const int32 NumSlots = FMath::Min(Primitive->GetNumMaterials(), Component.Materials.Num());
+            for (int32 Slot = 0; Slot < NumSlots; ++Slot)
+            {
+                if (McpObjectPathOrEmpty(Primitive->GetMaterial(Slot)) != Component.Materials[Slot])
+                {
+                    Touch(Primitive);
+                    Primitive->SetMaterial(Slot, Component.Materials[Slot].IsEmpty()
+                        ? nullptr
+                        : LoadObject<UMaterialInterface>(nullptr, *Component.Materials[Slot]));
+                }
+            }
+        }
+    }
+
+    if (bChanged)
+    {
+        Actor->MarkComponentsRenderStateDirty();
+    }
+    return bChanged;
+}
+
+FArchive& operator<<(FArchive& Ar, FMcpLevelSnapshot& Snapshot)
+{
+    Ar << Snapshot.WorldPath;
+    Ar << Snapshot.Timestamp;
+    Ar << Snapshot.Actors;
+    return Ar;
+}
+
+void FMcpLevelSnapshot::Capture(UWorld* World, TArray<AActor*>* OutActors)
+{
+    Actors.Reset();
+    if (OutActors)
+    {
+        OutActors->Reset();
+    }
+    Timestamp = FDateTime::UtcNow();
+    WorldPath = World ? World->GetPathName() : FString();
+    if (!World)
+    {
+        return;
+    }
+
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        AActor* Actor = *It;
+        if (!IsValid(Actor) || Actor->HasAnyFlags(RF_Transient))
+        {
+            continue;
+        }
+        Actors.AddDefaulted_GetRef().Capture(Actor);
+        if (OutActors)
+        {
+            OutActors->Add(Actor);
+        }
+    }
+}
+
+FMcpLevelSnapshotRestoreResult FMcpLevelSnapshot::Restore(UWorld* World, const FMcpLevelSnapshotRestoreOptions& Options) const
+{
+    FMcpLevelSnapshotRestoreResult Result;
+    if (!World)
+    {
+        return Result;
+    }
+
+    // Hash the live world once; only actors whose hash differs are touched
+    FMcpLevelSnapshot Current;
+    TArray<AActor*> LiveActors;
+    Current.Capture(World, &LiveActors);
+    const FMcpLevelSnapshotDiff Delta = Diff(Current);
+    Result.Unchanged = Delta.Unchanged;
+
+    TMap<FString, AActor*> LiveByPath;
+    LiveByPath.Reserve(LiveActors.Num());
+    for (int32 Index = 0; Index < LiveActors.Num(); ++Index)
+    {
+        LiveByPath.Add(Current.Actors[Index].ActorPath, LiveActors[Index]);
+    }
+
+    for (int32 Index : Delta.Changed)
+    {
+        const FMcpActorSnapshot& Record = Actors[Index];
+        if (Record.Apply(LiveByPath.FindRef(Record.ActorPath), Options.bTransact))
+        {
+            ++Result.Restored;
+        }
+        else
+        {
+            // Hash differs but nothing restorable changed (e.g. a component that no longer exists)
+            ++Result.Unchanged;
+        }
+    }
+
+    if (Options.bRespawnMissing)
+    {
+        for (int32 Index : Delta.Missing)
+        {
+            const FMcpActorSnapshot& Record = Actors[Index];
+            UClass* ActorClass = LoadObject<UClass>(nullptr, *Record.ClassPath);
+            if (!ActorClass)
+            {
+                Result.Failed.Add(Record.ActorPath);
+                continue;
+            }
+
+            FActorSpawnParameters SpawnParams;
+            FString ShortName;
+            if (Record.ActorPath.Split(TEXT("."), nullptr, &ShortName, ESearchCase::CaseSensitive, ESearchDir::FromEnd))
+            {
+                SpawnParams.Name = FName(*ShortName);
+                SpawnParams.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+            }
+            AActor* Spawned = World->SpawnActor<AActor>(ActorClass, Record.Transform, SpawnParams);
+            if (!Spawned)
+            {
+                Result.Failed.Add(Record.ActorPath);
+                continue;
+            }
+            Record.Apply(Spawned, Options.bTransact);
+            ++Result.Respawned;
+        }
+    }
+    else
+    {
+        for (int32 Index : Delta.Missing)
+        {
+            Result.Failed.Add(Actors[Index].ActorPath);
+        }
+    }
+
+    if (Options.bDestroyAdded)
+    {
+        for (const FString& ActorPath : Delta.Added)
+        {
+            AActor* Actor = LiveByPath.FindRef(ActorPath);
+            if (!Actor)
+            {
+                continue;
+            }
+#if WITH_EDITOR
+            const bool bDestroyed = World->EditorDestroyActor(Actor, true);
+#else
+            const bool bDestroyed = Actor->Destroy();
+#endif
+            if (bDestroyed)
+            {
+                ++Result.Destroyed;
+            }
+        }
+    }
+
+    return Result;
+}
+
+int32 FMcpLevelSnapshot::FindActor(const FString& ActorPath) const
+{
+    return Actors.IndexOfByPredicate([&ActorPath](const FMcpActorSnapshot& Actor)
+    {
+        return Actor.ActorPath == ActorPath;
+    });
+}
+
+FMcpLevelSnapshotDiff FMcpLevelSnapshot::Diff(const FMcpLevelSnapshot& Other) const
+{
+    FMcpLevelSnapshotDiff Result;
+
+    TMap<FString, int32> OtherIndex;
+    OtherIndex.Reserve(Other.Actors.Num());
+    for (int32 Index = 0; Index < Other.Actors.Num(); ++Index)
+    {
+        OtherIndex.Add(Other.Actors[Index].ActorPath, Index);
+    }
+
+    TBitArray<> Matched(false, Other.Actors.Num());
+    for (int32 Index = 0; Index < Actors.Num(); ++Index)
+    {
+        const int32* Found = OtherIndex.Find(Actors[Index].ActorPath);
+        if (!Found)
+        {
+            Result.Missing.Add(Index);
+            continue;
+        }
+        Matched[*Found] = true;
+        if (Other.Actors[*Found].Hash != Actors[Index].Hash)
+        {
+            Result.Changed.Add(Index);
+        }
+        else
+        {
+            ++Result.Unchanged;
+        }
+    }
+
+    for (int32 Index = 0; Index < Other.Actors.Num(); ++Index)
+    {
+        if (!Matched[Index])
+        {
+            Result.Added.Add(Other.Actors[Index].ActorPath);
+        }
+    }
+    return Result;
+}
+
+bool FMcpLevelSnapshot::SaveToFile(const FString& Path, FString& OutError) const
+{
+    TArray<uint8> Raw;
+    FMemoryWriter Writer(Raw);
+    Writer << const_cast<FMcpLevelSnapshot&>(*this);
+
+    int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Raw.Num());
+    TArray<uint8> Compressed;
+    Compressed.SetNumUninitialized(CompressedSize);
+    if (!FCompression::CompressMemory(NAME_Zlib, Compressed.GetData(), CompressedSize, Raw.GetData(), Raw.Num()))
+    {
+        OutError = TEXT("Failed to compress snapshot");
+        return false;
+    }
+    Compressed.SetNum(CompressedSize);
+
+    TArray<uint8> FileBytes;
+    FMemoryWriter FileWriter(FileBytes);
+    uint32 Magic = FileMagic;
+    uint32 Version = FileVersion;
+    int64 RawSize = Raw.Num();
+    FileWriter << Magic << Version << RawSize;
+    FileWriter << Compressed;
+
+    if (!FFileHelper::SaveArrayToFile(FileBytes, *Path))
+    {
+        OutError = FString::Printf(TEXT("Failed to write snapshot file: %s"), *Path);
+        return false;
+    }
+    return true;
+}
+
+bool FMcpLevelSnapshot::LoadFromFile(const FString& Path, FString& OutError)
+{
+    TArray<uint8> FileBytes;
+    if (!FFileHelper::LoadFileToArray(FileBytes, *Path))
+    {
+        OutError = FString::Printf(TEXT("Failed to read snapshot file: %s"), *Path);
+        return false;
+    }
+
+    FMemoryReader FileReader(FileBytes);
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    int64 RawSize = 0;
+    TArray<uint8> Compressed;
+    FileReader << Magic << Version << RawSize;
+    if (Magic != FileMagic)
+    {
+        OutError = TEXT("Not an MCP level snapshot");
+        return false;
+    }
+    if (Version > FileVersion)
+    {
+        OutError = FString::Printf(TEXT("Snapshot version %u is newer than supported version %u"), Version, FileVersion);
+        return false;
+    }
+    FileReader << Compressed;
+    if (FileReader.IsError() || RawSize < 0 || RawSize > MAX_int32)
+    {
+        OutError = TEXT("Corrupt snapshot header");
+        return false;
+    }
+
+    TArray<uint8> Raw;
+    Raw.SetNumUninitialized(static_cast<int32>(RawSize));
+    if (!FCompression::UncompressMemory(NAME_Zlib, Raw.GetData(), Raw.Num(), Compressed.GetData(), Compressed.Num()))
+    {
+        OutError = TEXT("Failed to decompress snapshot");
+        return false;
+    }
+
+    FMemoryReader Reader(Raw);
+    Reader << *this;
+    if (Reader.IsError())
+    {
+        OutError = TEXT("Corrupt snapshot payload");
+        return false;
+    }
+    return true;
+}
+
+bool FMcpLevelSnapshot::IsSnapshotFile(const FString& Path)
+{
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path));
+    if (!Reader || Reader->TotalSize() < static_cast<int64>(sizeof(uint32)))
+    {
+        return false;
+    }
+    uint32 Magic = 0;
+    *Reader << Magic;
+    return Magic == FileMagic;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UWorld;
+
+/**
+ * Compact, hash-addressed level snapshots.
+ *
+ * A snapshot is a list of per-actor records keyed by actor path. Each record carries
+ * the actor transform, a handful of key editor properties and the state of its scene
+ * components, plus a 64-bit content hash over all of it. Two snapshots (or a snapshot
+ * and the live world) are diffed by comparing hashes, so a restore only touches the
+ * actors whose state actually changed.
+ *
+ * On disk the records are serialized with FArchive and zlib-compressed behind a small
+ * versioned header (see FMcpLevelSnapshot::SaveToFile).
+ */
+
+/** Scene component state captured per actor, matched by component name on restore. */
+struct FMcpComponentSnapshot
+{
+    FString Name;
+    FTransform RelativeTransform = FTransform::Identity;
+    bool bVisible = true;
+    bool bHiddenInGame = false;
+    /** Static mesh asset path (static mesh components only). */
+    FString StaticMesh;
+    /** Material path per slot (primitive components only). */
+    TArray<FString> Materials;
+
+    friend FArchive& operator<<(FArchive& Ar, FMcpComponentSnapshot& Component);
+};
+
+/** One actor in a snapshot. */
+struct FMcpActorSnapshot
+{
+    FString ActorPath;
+    FString ClassPath;
+    FString Label;
+    FString FolderPath;
+    FTransform Transform = FTransform::Identity;
+    bool bHidden = false;
+    TArray<FName> Tags;
+    TArray<FMcpComponentSnapshot> Components;
+    uint64 Hash = 0;
+
+    /** Fill this record from a live actor and compute its hash. */
+    void Capture(AActor* Actor);
+
+    /** Push the recorded state back onto Actor. Returns false if nothing needed changing. */
+    bool Apply(AActor* Actor, bool bTransact) const;
+
+    friend FArchive& operator<<(FArchive& Ar, FMcpActorSnapshot& Actor);
+
+private:
+    void ComputeHash();
+};
+
+/** Result of comparing a baseline snapshot against another snapshot or the live world. */
+struct FMcpLevelSnapshotDiff
+{
+    /** Indices into the baseline whose hash differs from the other side. */
+    TArray<int32> Changed;
+    /** Indices into the baseline with no matching actor on the other side. */
+    TArray<int32> Missing;
+    /** Actor paths present on the other side only. */
+    TArray<FString> Added;
+    int32 Unchanged = 0;
+
+    bool IsEmpty() const { return Changed.Num() == 0 && Missing.Num() == 0 && Added.Num() == 0; }
+};
+
+struct FMcpLevelSnapshotRestoreOptions
+{
+    /** Record an undo transaction for the restore. Off by default: it dominates the cost on large levels. */
+    bool bTransact = false;
+    /** Respawn actors that exist in the snapshot but not in the world (class + recorded state only). */
+    bool bRespawnMissing = false;
+    /** Destroy actors that exist in the world but not in the snapshot. */
+    bool bDestroyAdded = false;
+};
+
+struct FMcpLevelSnapshotRestoreResult
+{
+    int32 Restored = 0;
+    int32 Unchanged = 0;
+    int32 Respawned = 0;
+    int32 Destroyed = 0;
+    TArray<FString> Failed;
+};
+
+class FMcpLevelSnapshot
+{
+public:
+    static constexpr uint32 FileMagic = 0x5350434D; // "MCPS"
+    static constexpr uint32 FileVersion = 1;
+
+    FString WorldPath;
+    FDateTime Timestamp;
+    TArray<FMcpActorSnapshot> Actors;
+
+    /** Capture every non-transient actor in World. When OutActors is given it receives the actor for each record. */
+    void Capture(UWorld* World, TArray<AActor*>* OutActors = nullptr);
+
+    /** Compare this (baseline) snapshot against Other by actor path and content hash. */
+    FMcpLevelSnapshotDiff Diff(const FMcpLevelSnapshot& Other) const;
+
+    /** Bring World back to this snapshot, touching only actors whose hash differs. */
+    FMcpLevelSnapshotRestoreResult Restore(UWorld* World, const FMcpLevelSnapshotRestoreOptions& Options) const;
+
+    int32 FindActor(const FString& ActorPath) const;
+
+    bool SaveToFile(const FString& Path, FString& OutError) const;
+    bool LoadFromFile(const FString& Path, FString& OutError);
+
+    /** True if the file starts with the binary snapshot magic. Used to keep reading legacy JSON snapshots. */
+    static bool IsSnapshotFile(const FString& Path);
+
+    friend FArchive& operator<<(FArchive& Ar, FMcpLevelSnapshot& Snapshot);
+};
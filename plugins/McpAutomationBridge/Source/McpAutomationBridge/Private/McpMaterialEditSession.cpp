@@ -0,0 +1,203 @@
+#include "McpMaterialEditSession.h"
+
+#include "HAL/PlatformTime.h"
+#include "Materials/Material.h"
+#include "McpAutomationBridgeSubsystem.h"
+
+#if WITH_EDITOR
+#include "MaterialShared.h"
+#include "MaterialStatsCommon.h"
+#include "RHI.h"
+#include "ShaderCompiler.h"
+#endif
+
+FMcpMaterialEditSessions& FMcpMaterialEditSessions::Get()
+{
+    static FMcpMaterialEditSessions Instance;
+    return Instance;
+}
+
+bool FMcpMaterialEditSessions::Begin(UMaterial* Material, const FMcpBridgeWebSocket* Owner, double IdleTimeoutSeconds)
+{
+    if (!Material || Sessions.Contains(Material))
+    {
+        return false;
+    }
+    FSession& Session = Sessions.Add(Material);
+    Session.Owner = Owner;
+    Session.StartSeconds = FPlatformTime::Seconds();
+    Session.LastEditSeconds = Session.StartSeconds;
+    Session.IdleTimeoutSeconds = IdleTimeoutSeconds;
+    return true;
+}
+
+bool FMcpMaterialEditSessions::IsOpen(UMaterial* Material) const
+{
+    return Material && Sessions.Contains(Material);
+}
+
+bool FMcpMaterialEditSessions::End(UMaterial* Material, int32& OutDeferredEdits)
+{
+    OutDeferredEdits = 0;
+    FSession Session;
+    if (!Material || !Sessions.RemoveAndCopyValue(Material, Session))
+    {
+        return false;
+    }
+    OutDeferredEdits = Session.DeferredEdits;
+    return true;
+}
+
+void FMcpMaterialEditSessions::PostEditChange(UMaterial* Material)
+{
+    if (!Material)
+    {
+        return;
+    }
+    if (FSession* Session = Sessions.Find(Material))
+    {
+        Session->DeferredEdits++;
+        Session->LastEditSeconds = FPlatformTime::Seconds();
+        return;
+    }
+    Material->PostEditChange();
+}
+
+TArray<TSharedPtr<FJsonValue>> FMcpMaterialEditSessions::ListJson() const
+{
+    const double Now = FPlatformTime::Seconds();
+    TArray<TSharedPtr<FJsonValue>> Out;
+    for (const TPair<TWeakObjectPtr<UMaterial>, FSession>& Pair : Sessions)
+    {
+        UMaterial* Material = Pair.Key.Get();
+        if (!Material)
+        {
+            continue;
+        }
+        TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetStringField(TEXT("assetPath"), Material->GetPathName());
+        Entry->SetNumberField(TEXT("deferredEdits"), Pair.Value.DeferredEdits);
+        Entry->SetNumberField(TEXT("openSeconds"), Now - Pair.Value.StartSeconds);
+        Entry->SetNumberField(TEXT("idleSeconds"), Now - Pair.Value.LastEditSeconds);
+        Entry->SetNumberField(TEXT("idleTimeoutSeconds"), Pair.Value.IdleTimeoutSeconds);
+        Out.Add(MakeShared<FJsonValueObject>(Entry));
+    }
+    return Out;
+}
+
+int32 FMcpMaterialEditSessions::CommitWhere(TFunctionRef<bool(const FSession&)> Match, const TCHAR* Reason)
+{
+    // Collect first: PostEditChange can reach handlers that open sessions.
+    TArray<TPair<TWeakObjectPtr<UMaterial>, FSession>> Closing;
+    for (auto It = Sessions.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().IsValid())
+        {
+            It.RemoveCurrent();
+        }
+        else if (Match(It.Value()))
+        {
+            Closing.Emplace(It.Key(), It.Value());
+            It.RemoveCurrent();
+        }
+    }
+    for (const TPair<TWeakObjectPtr<UMaterial>, FSession>& Pair : Closing)
+    {
+        UMaterial* Material = Pair.Key.Get();
+        if (Material && Pair.Value.DeferredEdits > 0)
+        {
+            Material->PreEditChange(nullptr);
+            Material->PostEditChange();
+            Material->MarkPackageDirty();
+        }
+        UE_LOG(LogMcpAutomationBridgeSubsystem, Log, TEXT("Material edit session for %s committed (%s, %d edits)"),
+               Material ? *Material->GetPathName() : TEXT("<unloaded>"), Reason, Pair.Value.DeferredEdits);
+    }
+    return Closing.Num();
+}
+
+int32 FMcpMaterialEditSessions::CommitOwnedBy(const FMcpBridgeWebSocket* Owner)
+{
+    if (!Owner)
+    {
+        return 0;
+    }
+    return CommitWhere([Owner](const FSession& Session) { return Session.Owner == Owner; }, TEXT("owner disconnected"));
+}
+
+void FMcpMaterialEditSessions::Tick()
+{
+    if (Sessions.Num() == 0)
+    {
+        return;
+    }
+    const double Now = FPlatformTime::Seconds();
+    CommitWhere(
+        [Now](const FSession& Session)
+        {
+            return Session.IdleTimeoutSeconds > 0.0 && Now - Session.LastEditSeconds > Session.IdleTimeoutSeconds;
+        },
+        TEXT("idle timeout"));
+}
+
+void FMcpMaterialEditSessions::CommitAll()
+{
+    CommitWhere([](const FSession&) { return true; }, TEXT("shutdown"));
+}
+
+bool McpGetMaterialCompileStats(UMaterial* Material, const TSharedPtr<FJsonObject>& OutStats)
+{
+#if WITH_EDITOR
+    FMaterialResource* Resource = Material ? Material->GetMaterialResource(GMaxRHIFeatureLevel) : nullptr;
+    if (!Resource)
+    {
+        // Nothing to compile at this feature level (or the material is gone).
+        OutStats->SetBoolField(TEXT("compiled"), false);
+        return true;
+    }
+
+    if (!Resource->IsCompilationFinished())
+    {
+        OutStats->SetBoolField(TEXT("compiled"), false);
+        OutStats->SetBoolField(TEXT("compiling"), true);
+        if (GShaderCompilingManager)
+        {
+            OutStats->SetNumberField(TEXT("remainingShaderJobs"), GShaderCompilingManager->GetNumRemainingJobs());
+        }
+        return false;
+    }
+
+    const TArray<FString>& CompileErrors = Resource->GetCompileErrors();
+    TArray<TSharedPtr<FJsonValue>> ErrorArray;
+    for (const FString& Error : CompileErrors)
+    {
+        ErrorArray.Add(MakeShared<FJsonValueString>(Error));
+    }
+    OutStats->SetBoolField(TEXT("compiled"), CompileErrors.Num() == 0);
+    OutStats->SetBoolField(TEXT("compiling"), false);
+    OutStats->SetArrayField(TEXT("compileErrors"), ErrorArray);
+
+    TArray<FShaderInstructionInfo> InstructionInfo;
+    FMaterialStatsUtils::GetRepresentativeInstructionCounts(InstructionInfo, Resource);
+    TArray<TSharedPtr<FJsonValue>> InstructionArray;
+    for (const FShaderInstructionInfo& Info : InstructionInfo)
+    {
+        TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetStringField(TEXT("shader"), Info.ShaderDescription);
+        Entry->SetNumberField(TEXT("instructions"), Info.InstructionCount);
+        InstructionArray.Add(MakeShared<FJsonValueObject>(Entry));
+    }
+    OutStats->SetArrayField(TEXT("instructionCounts"), InstructionArray);
+
+    uint32 VertexSamples = 0;
+    uint32 PixelSamples = 0;
+    Resource->GetEstimatedNumTextureSamples(VertexSamples, PixelSamples);
+    OutStats->SetNumberField(TEXT("samplers"), Resource->GetSamplerUsage());
+    OutStats->SetNumberField(TEXT("vertexTextureSamples"), VertexSamples);
+    OutStats->SetNumberField(TEXT("pixelTextureSamples"), PixelSamples);
+    return true;
+#else
+    OutStats->SetBoolField(TEXT("compiled"), false);
+    return true;
+#endif
+}
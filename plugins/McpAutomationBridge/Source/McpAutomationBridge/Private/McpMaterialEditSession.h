@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "UObject/WeakObjectPtr.h"
+
+class FMcpBridgeWebSocket;
+class UMaterial;
+
+/**
+ * Open material edit sessions.
+ *
+ * Every material authoring/graph edit ends in PostEditChange, and each one can
+ * re-translate the material and queue a full shader compile. While a session
+ * is open for a material, McpMaterialPostEditChange only counts the edit; the
+ * single PostEditChange runs when the session is committed. Expressions and
+ * connections are still written immediately, so reads inside a session see
+ * the edited graph.
+ *
+ * A session belongs to the socket that opened it. It is committed when that
+ * socket disconnects, when it sees no edits for its idle timeout, or when the
+ * subsystem shuts down.
+ */
+class FMcpMaterialEditSessions
+{
+public:
+    static FMcpMaterialEditSessions& Get();
+
+    /** Default idle timeout: commit after this long without an edit. */
+    static constexpr double DefaultIdleTimeoutSeconds = 300.0;
+
+    /**
+     * Opens a session owned by Owner (identity only, may be null). Returns
+     * false if one is already open for Material.
+     */
+    bool Begin(UMaterial* Material, const FMcpBridgeWebSocket* Owner,
+               double IdleTimeoutSeconds = DefaultIdleTimeoutSeconds);
+    bool IsOpen(UMaterial* Material) const;
+    /**
+     * Closes Material's session without recompiling. Returns false if none was
+     * open; OutDeferredEdits is the number of PostEditChange calls it absorbed.
+     */
+    bool End(UMaterial* Material, int32& OutDeferredEdits);
+
+    /** PostEditChange now, or count it against Material's open session. */
+    void PostEditChange(UMaterial* Material);
+
+    /** assetPath, deferredEdits, age and idle time of each open session. */
+    TArray<TSharedPtr<FJsonValue>> ListJson() const;
+
+    /** Commits the sessions Owner opened; returns how many. */
+    int32 CommitOwnedBy(const FMcpBridgeWebSocket* Owner);
+    /** Commits sessions idle past their timeout and forgets unloaded materials. */
+    void Tick();
+    /** Recompiles every material with deferred edits and closes all sessions. */
+    void CommitAll();
+
+private:
+    struct FSession
+    {
+        const FMcpBridgeWebSocket* Owner = nullptr;
+        int32 DeferredEdits = 0;
+        double StartSeconds = 0.0;
+        double LastEditSeconds = 0.0;
+        double IdleTimeoutSeconds = DefaultIdleTimeoutSeconds;
+    };
+
+    /** Removes the sessions Match accepts and recompiles their materials. */
+    int32 CommitWhere(TFunctionRef<bool(const FSession&)> Match, const TCHAR* Reason);
+
+    TMap<TWeakObjectPtr<UMaterial>, FSession> Sessions;
+};
+
+/** PostEditChange for material graph edits; deferred while a session is open. */
+inline void McpMaterialPostEditChange(UMaterial* Material)
+{
+    FMcpMaterialEditSessions::Get().PostEditChange(Material);
+}
+
+/**
+ * Shader compile state of Material at the editor's feature level: remaining
+ * compile jobs while compiling; once finished, compile errors, representative
+ * instruction counts and sampler/texture-sample usage. Returns true when the
+ * material's shader map has finished compiling.
+ */
+bool McpGetMaterialCompileStats(UMaterial* Material, const TSharedPtr<FJsonObject>& OutStats);
@@ -0,0 +1,533 @@
+#include "McpNiagaraBake.h"
+
+#include "HAL/PlatformTime.h"
+#include "McpAutomationBridgeHelpers.h"
+#include "Misc/Base64.h"
+#include "Misc/Crc.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if MCP_HAS_NIAGARA_BAKE
+#include "NiagaraComponent.h"
+#include "NiagaraEmitter.h"
+#include "NiagaraEmitterHandle.h"
+#include "NiagaraSystem.h"
+#endif
+
+namespace
+{
+    constexpr int32 McpNiagaraBakeVersion = 1;
+    constexpr uint16 McpNiagaraBakeFlagDelta = 1 << 0;
+    constexpr int32 McpNiagaraBakeMaxFrames = 10000;
+    constexpr int64 McpNiagaraBakeMaxBytes = 256ll * 1024 * 1024;
+    /** Caches larger than this are written to disk but not returned inline. */
+    constexpr int64 McpNiagaraBakeMaxInlineBytes = 8ll * 1024 * 1024;
+
+    template <typename T>
+    void McpBakeWritePod(TArray<uint8>& Out, T Value)
+    {
+        Out.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+    }
+
+    void McpBakeWriteVarint(TArray<uint8>& Out, uint64 Value)
+    {
+        while (Value >= 0x80)
+        {
+            Out.Add(uint8(Value) | 0x80);
+            Value >>= 7;
+        }
+        Out.Add(uint8(Value));
+    }
+
+    void McpBakeWriteSigned(TArray<uint8>& Out, int64 Value)
+    {
+        McpBakeWriteVarint(Out, (uint64(Value) << 1) ^ uint64(Value >> 63));
+    }
+
+    void McpBakeWriteName(TArray<uint8>& Out, const FString& Name)
+    {
+        const FTCHARToUTF8 Utf8(*Name);
+        const int32 Length = FMath::Min(Utf8.Length(), 255);
+        Out.Add(uint8(Length));
+        Out.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Length);
+    }
+
+    /** Attributes read as three components; anything else is read as a float. */
+    bool McpBakeIsVectorAttribute(const FString& Name)
+    {
+        return Name.Equals(TEXT("Position"), ESearchCase::IgnoreCase) ||
+               Name.Equals(TEXT("Velocity"), ESearchCase::IgnoreCase) ||
+               Name.Equals(TEXT("Scale"), ESearchCase::IgnoreCase) ||
+               Name.Equals(TEXT("MeshScale"), ESearchCase::IgnoreCase) ||
+               Name.Equals(TEXT("SpriteSize"), ESearchCase::IgnoreCase);
+    }
+
+    TSharedPtr<FJsonObject> McpBakeBoxJson(const FBox& Box)
+    {
+        TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+        Object->SetBoolField(TEXT("valid"), Box.IsValid != 0);
+        if (Box.IsValid)
+        {
+            Object->SetArrayField(TEXT("min"), {MakeShared<FJsonValueNumber>(Box.Min.X), MakeShared<FJsonValueNumber>(Box.Min.Y),
+                                               MakeShared<FJsonValueNumber>(Box.Min.Z)});
+            Object->SetArrayField(TEXT("max"), {MakeShared<FJsonValueNumber>(Box.Max.X), MakeShared<FJsonValueNumber>(Box.Max.Y),
+                                               MakeShared<FJsonValueNumber>(Box.Max.Z)});
+        }
+        return Object;
+    }
+
+    TArray<TSharedPtr<FJsonValue>> McpBakeStringArray(const TArray<FString>& Values)
+    {
+        TArray<TSharedPtr<FJsonValue>> Array;
+        for (const FString& Value : Values)
+        {
+            Array.Add(MakeShared<FJsonValueString>(Value));
+        }
+        return Array;
+    }
+}
+
+bool FMcpNiagaraBake::Parse(const TSharedPtr<FJsonObject>& Payload, FString& OutError)
+{
+    Frames = GetJsonIntField(Payload, TEXT("frames"), Frames);
+    if (Frames < 1 || Frames > McpNiagaraBakeMaxFrames)
+    {
+        OutError = FString::Printf(TEXT("frames must be between 1 and %d"), McpNiagaraBakeMaxFrames);
+        return false;
+    }
+    DeltaSeconds = GetJsonNumberField(Payload, TEXT("deltaSeconds"), GetJsonNumberField(Payload, TEXT("deltaTime"), DeltaSeconds));
+    if (!(DeltaSeconds > 0.0) || DeltaSeconds > 1.0)
+    {
+        OutError = TEXT("deltaSeconds must be in (0, 1]");
+        return false;
+    }
+    bHasSeed = Payload.IsValid() && Payload->HasField(TEXT("seed"));
+    Seed = GetJsonIntField(Payload, TEXT("seed"), 0);
+    bDeltaEncode = GetJsonBoolField(Payload, TEXT("deltaEncode"), true);
+    bFrameBounds = GetJsonBoolField(Payload, TEXT("frameBounds"), false);
+    bIncludeData = GetJsonBoolField(Payload, TEXT("includeData"), false);
+    OutputPath = GetJsonStringField(Payload, TEXT("outputPath"));
+
+    Attributes.Reset();
+    const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+    if (Payload.IsValid() && Payload->TryGetArrayField(TEXT("attributes"), Values))
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *Values)
+        {
+            FAttribute Attribute;
+            const TSharedPtr<FJsonObject>* Object = nullptr;
+            if (Value.IsValid() && Value->TryGetObject(Object))
+            {
+                Attribute.Name = GetJsonStringField(*Object, TEXT("name"));
+                const FString Type = GetJsonStringField(*Object, TEXT("type")).ToLower();
+                if (Type.IsEmpty())
+                {
+                    Attribute.Components = McpBakeIsVectorAttribute(Attribute.Name) ? 3 : 1;
+                }
+                else if (Type == TEXT("vec3") || Type == TEXT("vector"))
+                {
+                    Attribute.Components = 3;
+                }
+                else if (Type == TEXT("float"))
+                {
+                    Attribute.Components = 1;
+                }
+                else
+                {
+                    OutError = FString::Printf(TEXT("attribute '%s': type must be float or vec3"), *Attribute.Name);
+                    return false;
+                }
+                Attribute.Step = GetJsonNumberField(*Object, TEXT("precision"), Attribute.Components == 3 ? 0.1 : 0.001);
+            }
+            else if (Value.IsValid() && Value->TryGetString(Attribute.Name))
+            {
+                Attribute.Components = McpBakeIsVectorAttribute(Attribute.Name) ? 3 : 1;
+                Attribute.Step = Attribute.Components == 3 ? 0.1 : 0.001;
+            }
+            if (Attribute.Name.IsEmpty() || !(Attribute.Step > 0.0))
+            {
+                OutError = TEXT("attributes entries need a name and a positive precision");
+                return false;
+            }
+            Attributes.Add(Attribute);
+        }
+    }
+    if (Attributes.Num() == 0)
+    {
+        FAttribute Position;
+        Position.Name = TEXT("Position");
+        Position.Components = 3;
+        Position.Step = 0.1;
+        Attributes.Add(Position);
+    }
+    if (Attributes.Num() > 32)
+    {
+        OutError = TEXT("at most 32 attributes can be baked");
+        return false;
+    }
+    return true;
+}
+
+bool FMcpNiagaraBake::Begin(UNiagaraComponent* InComponent, bool bInDestroyComponent, FString& OutError,
+                            FString& OutErrorCode)
+{
+#if MCP_HAS_NIAGARA_BAKE
+    Component = InComponent;
+    bDestroyComponent = bInDestroyComponent;
+    UNiagaraSystem* System = InComponent ? InComponent->GetAsset() : nullptr;
+    if (!System)
+    {
+        OutError = TEXT("Niagara component has no system asset");
+        OutErrorCode = TEXT("SYSTEM_NOT_FOUND");
+        return false;
+    }
+    SystemPath = System->GetPathName();
+    SystemName = System->GetName();
+
+    Emitters.Reset();
+    GpuEmitters.Reset();
+    NonDeterministic.Reset();
+    for (const FNiagaraEmitterHandle& Handle : System->GetEmitterHandles())
+    {
+        if (!Handle.GetIsEnabled())
+        {
+            continue;
+        }
+        const FString Name = Handle.GetUniqueInstanceName();
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1
+        const FVersionedNiagaraEmitterData* EmitterData = Handle.GetEmitterData();
+#else
+        const UNiagaraEmitter* EmitterData = Handle.GetInstance();
+#endif
+        if (!EmitterData)
+        {
+            continue;
+        }
+        if (EmitterData->SimTarget == ENiagaraSimTarget::GPUComputeSim)
+        {
+            GpuEmitters.Add(Name);
+            continue;
+        }
+        if (!EmitterData->bDeterminism)
+        {
+            NonDeterministic.Add(Name);
+        }
+        Emitters.Add(Name);
+    }
+    if (Emitters.Num() == 0)
+    {
+        OutError = TEXT("System has no enabled CPU emitters to bake");
+        OutErrorCode = TEXT("NO_CPU_EMITTERS");
+        return false;
+    }
+
+    NumColumns = 0;
+    for (const FAttribute& Attribute : Attributes)
+    {
+        NumColumns += Attribute.Components;
+    }
+
+    Cache.Reset();
+    Cache.Append(reinterpret_cast<const uint8*>("MNPC"), 4);
+    McpBakeWritePod<uint16>(Cache, uint16(McpNiagaraBakeVersion));
+    McpBakeWritePod<uint16>(Cache, bDeltaEncode ? McpNiagaraBakeFlagDelta : uint16(0));
+    McpBakeWritePod<uint32>(Cache, uint32(Frames));
+    McpBakeWritePod<float>(Cache, float(DeltaSeconds));
+    McpBakeWritePod<int32>(Cache, Seed);
+    McpBakeWritePod<uint16>(Cache, uint16(Emitters.Num()));
+    McpBakeWritePod<uint16>(Cache, uint16(Attributes.Num()));
+    for (const FAttribute& Attribute : Attributes)
+    {
+        McpBakeWriteName(Cache, Attribute.Name);
+        Cache.Add(uint8(Attribute.Components));
+        McpBakeWritePod<double>(Cache, Attribute.Step);
+    }
+    for (const FString& Emitter : Emitters)
+    {
+        McpBakeWriteName(Cache, Emitter);
+    }
+
+    Previous.Reset();
+    Previous.SetNum(Emitters.Num());
+    for (TArray<TArray<int64>>& Columns : Previous)
+    {
+        Columns.SetNum(NumColumns);
+    }
+    Counts.Reset();
+    Counts.SetNum(Emitters.Num());
+    EmitterSampled.Init(false, Emitters.Num());
+    EmitterBounds.Init(FBox(ForceInit), Emitters.Num());
+    FrameBounds.Reset();
+    MissingAttributes.Reset();
+    Bounds = FBox(ForceInit);
+    RawBytes = 0;
+    SimulationSeconds = 0.0;
+    FramesBaked = 0;
+
+    SavedSeed = InComponent->GetRandomSeedOffset();
+    bWasActive = InComponent->IsActive();
+    bWasTickEnabled = InComponent->IsComponentTickEnabled();
+    bStarted = true;
+    bRestored = false;
+    if (bHasSeed)
+    {
+        InComponent->SetRandomSeedOffset(Seed);
+    }
+    // Only Step advances the system: a placed component would otherwise also
+    // tick with the editor world between frames and break determinism.
+    InComponent->SetComponentTickEnabled(false);
+    InComponent->ResetSystem();
+    return true;
+#else
+    OutError = TEXT("Niagara baking requires an editor build with Niagara");
+    OutErrorCode = TEXT("NOT_IMPLEMENTED");
+    return false;
+#endif
+}
+
+bool FMcpNiagaraBake::Step(double BudgetSeconds, FString& OutError, FString& OutErrorCode)
+{
+#if MCP_HAS_NIAGARA_BAKE
+    UNiagaraComponent* Target = Component.Get();
+    if (!bStarted || !Target)
+    {
+        OutError = TEXT("Niagara component was destroyed during the bake");
+        OutErrorCode = TEXT("SYSTEM_NOT_FOUND");
+        return false;
+    }
+
+    const double StartSeconds = FPlatformTime::Seconds();
+    const double Deadline = StartSeconds + BudgetSeconds;
+    do
+    {
+        Target->AdvanceSimulation(1, float(DeltaSeconds));
+        FBox FrameBox(ForceInit);
+        for (int32 EmitterIndex = 0; EmitterIndex < Emitters.Num(); ++EmitterIndex)
+        {
+            const FString& Emitter = Emitters[EmitterIndex];
+            const TArray<FVector> Positions = Target->GetNiagaraParticlePositions_DebugOnly(Emitter);
+            const int32 Count = Positions.Num();
+            Counts[EmitterIndex].Add(Count);
+            for (const FVector& Position : Positions)
+            {
+                FrameBox += Position;
+                EmitterBounds[EmitterIndex] += Position;
+            }
+            McpBakeWriteVarint(Cache, uint64(Count));
+
+            // Most emitters spawn nothing on frame 0, so attributes are checked
+            // on the first frame the emitter actually has particles.
+            const bool bCheckAttributes = Count > 0 && !EmitterSampled[EmitterIndex];
+            EmitterSampled[EmitterIndex] |= Count > 0;
+
+            int32 Column = 0;
+            for (const FAttribute& Attribute : Attributes)
+            {
+                TArray<FVector> Vectors;
+                TArray<float> Floats;
+                if (Attribute.Components == 3)
+                {
+                    Vectors = Attribute.Name.Equals(TEXT("Position"), ESearchCase::IgnoreCase)
+                        ? Positions
+                        : Target->GetNiagaraParticleValueVec3_DebugOnly(Emitter, Attribute.Name);
+                }
+                else
+                {
+                    Floats = Target->GetNiagaraParticleValues_DebugOnly(Emitter, Attribute.Name);
+                }
+                const bool bPresent = Attribute.Components == 3 ? Vectors.Num() == Count : Floats.Num() == Count;
+                if (!bPresent && bCheckAttributes)
+                {
+                    MissingAttributes.Add(Emitter + TEXT(".") + Attribute.Name);
+                }
+
+                for (int32 Axis = 0; Axis < Attribute.Components; ++Axis, ++Column)
+                {
+                    TArray<int64>& Prev = Previous[EmitterIndex][Column];
+                    TArray<int64> Current;
+                    Current.SetNumUninitialized(Count);
+                    for (int32 Index = 0; Index < Count; ++Index)
+                    {
+                        double Value = 0.0;
+                        if (bPresent)
+                        {
+                            Value = Attribute.Components == 3 ? Vectors[Index][Axis] : double(Floats[Index]);
+                        }
+                        const int64 Quantized = FMath::IsFinite(Value) ? int64(FMath::RoundHalfFromZero(Value / Attribute.Step)) : 0;
+                        Current[Index] = Quantized;
+                        McpBakeWriteSigned(Cache, bDeltaEncode && Index < Prev.Num() ? Quantized - Prev[Index] : Quantized);
+                    }
+                    Prev = MoveTemp(Current);
+                    RawBytes += int64(Count) * sizeof(float);
+                }
+            }
+        }
+        Bounds += FrameBox;
+        if (bFrameBounds)
+        {
+            FrameBounds.Add(FrameBox);
+        }
+        ++FramesBaked;
+        if (Cache.Num() > McpNiagaraBakeMaxBytes)
+        {
+            OutError = FString::Printf(TEXT("Cache exceeded %lld MB; bake fewer frames or attributes"), McpNiagaraBakeMaxBytes / (1024 * 1024));
+            OutErrorCode = TEXT("CACHE_TOO_LARGE");
+            return false;
+        }
+    }
+    while (!IsDone() && FPlatformTime::Seconds() < Deadline);
+    SimulationSeconds += FPlatformTime::Seconds() - StartSeconds;
+    return true;
+#else
+    OutError = TEXT("Niagara baking requires an editor build with Niagara");
+    OutErrorCode = TEXT("NOT_IMPLEMENTED");
+    return false;
+#endif
+}
+
+void FMcpNiagaraBake::Restore()
+{
+#if MCP_HAS_NIAGARA_BAKE
+    if (bRestored)
+    {
+        return;
+    }
+    bRestored = true;
+    UNiagaraComponent* Target = Component.Get();
+    if (!Target)
+    {
+        return;
+    }
+    if (bDestroyComponent)
+    {
+        Target->DestroyComponent();
+        return;
+    }
+    if (!bStarted)
+    {
+        return;
+    }
+    Target->SetRandomSeedOffset(SavedSeed);
+    Target->SetComponentTickEnabled(bWasTickEnabled);
+    if (bWasActive)
+    {
+        Target->ResetSystem();
+    }
+    else
+    {
+        Target->DeactivateImmediate();
+    }
+#endif
+}
+
+bool FMcpNiagaraBake::Finish(const TSharedPtr<FJsonObject>& OutResult, FString& OutError, FString& OutErrorCode)
+{
+#if MCP_HAS_NIAGARA_BAKE
+    Restore();
+    if (!bStarted || !IsDone())
+    {
+        OutError = TEXT("Bake finished before all frames were simulated");
+        OutErrorCode = TEXT("INTERNAL_ERROR");
+        return false;
+    }
+
+    FString Path = OutputPath;
+    if (Path.IsEmpty())
+    {
+        Path = FPaths::Combine(TEXT("McpAutomationBridge"), TEXT("NiagaraBakes"),
+                               FString::Printf(TEXT("%s_%s.mnpc"), *SystemName, *FDateTime::Now().ToString()));
+    }
+    if (FPaths::IsRelative(Path))
+    {
+        Path = FPaths::Combine(FPaths::ProjectSavedDir(), Path);
+    }
+    Path = FPaths::ConvertRelativePathToFull(Path);
+    if (!FFileHelper::SaveArrayToFile(Cache, *Path))
+    {
+        OutError = FString::Printf(TEXT("Could not write cache to %s"), *Path);
+        OutErrorCode = TEXT("WRITE_FAILED");
+        return false;
+    }
+
+    OutResult->SetStringField(TEXT("system"), SystemPath);
+    OutResult->SetStringField(TEXT("cachePath"), Path);
+    OutResult->SetNumberField(TEXT("cacheBytes"), Cache.Num());
+    OutResult->SetNumberField(TEXT("rawBytes"), double(RawBytes));
+    OutResult->SetStringField(TEXT("crc32"), FString::Printf(TEXT("%08x"), FCrc::MemCrc32(Cache.GetData(), Cache.Num())));
+    OutResult->SetNumberField(TEXT("version"), McpNiagaraBakeVersion);
+    OutResult->SetNumberField(TEXT("frames"), Frames);
+    OutResult->SetNumberField(TEXT("deltaSeconds"), DeltaSeconds);
+    OutResult->SetNumberField(TEXT("seed"), bHasSeed ? Seed : SavedSeed);
+    OutResult->SetBoolField(TEXT("deltaEncoded"), bDeltaEncode);
+    OutResult->SetNumberField(TEXT("simulationMs"), SimulationSeconds * 1000.0);
+    OutResult->SetObjectField(TEXT("bounds"), McpBakeBoxJson(Bounds));
+
+    TArray<TSharedPtr<FJsonValue>> AttributeArray;
+    for (const FAttribute& Attribute : Attributes)
+    {
+        TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetStringField(TEXT("name"), Attribute.Name);
+        Entry->SetStringField(TEXT("type"), Attribute.Components == 3 ? TEXT("vec3") : TEXT("float"));
+        Entry->SetNumberField(TEXT("precision"), Attribute.Step);
+        AttributeArray.Add(MakeShared<FJsonValueObject>(Entry));
+    }
+    OutResult->SetArrayField(TEXT("attributes"), AttributeArray);
+
+    TArray<TSharedPtr<FJsonValue>> EmitterArray;
+    for (int32 EmitterIndex = 0; EmitterIndex < Emitters.Num(); ++EmitterIndex)
+    {
+        TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetStringField(TEXT("name"), Emitters[EmitterIndex]);
+        TArray<TSharedPtr<FJsonValue>> Curve;
+        int32 MaxParticles = 0;
+        for (const int32 Count : Counts[EmitterIndex])
+        {
+            Curve.Add(MakeShared<FJsonValueNumber>(Count));
+            MaxParticles = FMath::Max(MaxParticles, Count);
+        }
+        Entry->SetArrayField(TEXT("particleCounts"), Curve);
+        Entry->SetNumberField(TEXT("maxParticles"), MaxParticles);
+        Entry->SetObjectField(TEXT("bounds"), McpBakeBoxJson(EmitterBounds[EmitterIndex]));
+        EmitterArray.Add(MakeShared<FJsonValueObject>(Entry));
+    }
+    OutResult->SetArrayField(TEXT("emitters"), EmitterArray);
+    if (bFrameBounds)
+    {
+        TArray<TSharedPtr<FJsonValue>> FrameBoundsArray;
+        for (const FBox& FrameBox : FrameBounds)
+        {
+            FrameBoundsArray.Add(MakeShared<FJsonValueObject>(McpBakeBoxJson(FrameBox)));
+        }
+        OutResult->SetArrayField(TEXT("frameBounds"), FrameBoundsArray);
+    }
+    if (GpuEmitters.Num() > 0)
+    {
+        OutResult->SetArrayField(TEXT("skippedGpuEmitters"), McpBakeStringArray(GpuEmitters));
+    }
+    if (NonDeterministic.Num() > 0)
+    {
+        OutResult->SetArrayField(TEXT("nonDeterministicEmitters"), McpBakeStringArray(NonDeterministic));
+    }
+    if (MissingAttributes.Num() > 0)
+    {
+        OutResult->SetArrayField(TEXT("missingAttributes"), McpBakeStringArray(MissingAttributes));
+    }
+    if (bIncludeData)
+    {
+        if (Cache.Num() <= McpNiagaraBakeMaxInlineBytes)
+        {
+            OutResult->SetStringField(TEXT("data"), FBase64::Encode(Cache));
+        }
+        else
+        {
+            OutResult->SetStringField(TEXT("dataOmitted"), TEXT("Cache too large to return inline; read cachePath"));
+        }
+    }
+    return true;
+#else
+    OutError = TEXT("Niagara baking requires an editor build with Niagara");
+    OutErrorCode = TEXT("NOT_IMPLEMENTED");
+    return false;
+#endif
+}
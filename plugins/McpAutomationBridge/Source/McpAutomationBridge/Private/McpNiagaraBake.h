@@ -0,0 +1,112 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+#if WITH_EDITOR && __has_include("NiagaraComponent.h")
+#define MCP_HAS_NIAGARA_BAKE 1
+#else
+#define MCP_HAS_NIAGARA_BAKE 0
+#endif
+
+class UNiagaraComponent;
+
+/**
+ * Deterministic bake of a Niagara system's CPU emitters into a compact
+ * particle cache (the create_effect "bake_simulation" sub-action).
+ *
+ * The component is reset (with an optional random seed offset) and stepped at
+ * a fixed dt, a frame budget at a time from the automation job ticker; after
+ * every step the selected attributes of each CPU emitter are read back and
+ * appended to the cache. GPU emitters are
+ * skipped and reported, so no GPU is needed. Emitters without "Deterministic"
+ * enabled are reported too: their caches are only repeatable with it on.
+ *
+ * Cache layout (little-endian), version 1:
+ *   "MNPC" | u16 version | u16 flags (1 = delta) | u32 frames | f32 dt |
+ *   i32 seed | u16 emitters | u16 attributes |
+ *   attributes: { u8 nameLen, utf8 name, u8 components, f64 step } |
+ *   emitters: { u8 nameLen, utf8 name } |
+ *   frames: for each emitter { varint count, then per attribute component a
+ *   column of count zigzag varints }
+ * Values are quantized to round(value / step). With delta encoding a value is
+ * stored relative to the same particle slot in the previous frame when that
+ * slot existed.
+ */
+class FMcpNiagaraBake
+{
+public:
+    /** Reads frames, deltaSeconds, seed, attributes, deltaEncode, frameBounds, outputPath and includeData. */
+    bool Parse(const TSharedPtr<FJsonObject>& Payload, FString& OutError);
+
+    /**
+     * Resets Component and writes the cache header. Call Step until IsDone,
+     * then Finish; Restore must run however the bake ends. With
+     * bDestroyComponent the (transient) component is destroyed on Restore.
+     */
+    bool Begin(UNiagaraComponent* Component, bool bDestroyComponent, FString& OutError, FString& OutErrorCode);
+
+    /** Simulates frames until BudgetSeconds have passed, at least one per call. */
+    bool Step(double BudgetSeconds, FString& OutError, FString& OutErrorCode);
+
+    bool IsDone() const { return FramesBaked >= Frames; }
+    int32 GetFramesBaked() const { return FramesBaked; }
+    int32 GetFrames() const { return Frames; }
+
+    /**
+     * Restores the component and writes the cache. Fills OutResult with the
+     * cache location, size, CRC and per-emitter particle count curves and
+     * bounds.
+     */
+    bool Finish(const TSharedPtr<FJsonObject>& OutResult, FString& OutError, FString& OutErrorCode);
+
+    /** Puts back the component's seed, ticking and activation. Safe to call more than once. */
+    void Restore();
+
+private:
+    struct FAttribute
+    {
+        FString Name;
+        int32 Components = 1;
+        double Step = 0.001;
+    };
+
+    int32 Frames = 60;
+    double DeltaSeconds = 1.0 / 30.0;
+    int32 Seed = 0;
+    bool bHasSeed = false;
+    bool bDeltaEncode = true;
+    bool bFrameBounds = false;
+    bool bIncludeData = false;
+    FString OutputPath;
+    TArray<FAttribute> Attributes;
+
+    // Bake state, kept between Step calls. The component is held weakly since
+    // garbage collection can run between frames.
+    TWeakObjectPtr<UNiagaraComponent> Component;
+    bool bDestroyComponent = false;
+    bool bStarted = false;
+    bool bRestored = false;
+    int32 SavedSeed = 0;
+    bool bWasActive = false;
+    bool bWasTickEnabled = false;
+    FString SystemPath;
+    FString SystemName;
+    TArray<FString> Emitters;
+    TArray<FString> GpuEmitters;
+    TArray<FString> NonDeterministic;
+    int32 NumColumns = 0;
+    TArray<uint8> Cache;
+    int32 FramesBaked = 0;
+    /** Previous frame's quantized columns per emitter, for delta encoding. */
+    TArray<TArray<TArray<int64>>> Previous;
+    TArray<TArray<int32>> Counts;
+    /** Whether each emitter has had particles yet; attributes are checked on that frame. */
+    TArray<bool> EmitterSampled;
+    TArray<FBox> EmitterBounds;
+    TArray<FBox> FrameBounds;
+    TArray<FString> MissingAttributes;
+    FBox Bounds = FBox(ForceInit);
+    int64 RawBytes = 0;
+    double SimulationSeconds = 0.0;
+};
@@ -0,0 +1,320 @@
+#include "McpPerfSampler.h"
+
+#include "ContentStreaming.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "McpBridgeWebSocket.h"
+#include "Misc/App.h"
+#include "Misc/CoreGlobals.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectIterator.h"
+
+#if WITH_EDITOR
+#include "RHI.h"
+#include "RenderCore.h"
+#endif
+
+namespace
+{
+    struct FMcpPerfMetric
+    {
+        const TCHAR* Name;
+        FMcpPerfSampler::EGroup Group;
+        float FMcpPerfSample::*Field;
+    };
+
+    const FMcpPerfMetric McpPerfMetrics[] = {
+        {TEXT("frameMs"), FMcpPerfSampler::EGroup::Frame, &FMcpPerfSample::FrameMs},
+        {TEXT("fps"), FMcpPerfSampler::EGroup::Frame, &FMcpPerfSample::Fps},
+        {TEXT("gameThreadMs"), FMcpPerfSampler::EGroup::Frame, &FMcpPerfSample::GameThreadMs},
+        {TEXT("renderThreadMs"), FMcpPerfSampler::EGroup::Frame, &FMcpPerfSample::RenderThreadMs},
+        {TEXT("rhiThreadMs"), FMcpPerfSampler::EGroup::Frame, &FMcpPerfSample::RHIThreadMs},
+        {TEXT("gpuMs"), FMcpPerfSampler::EGroup::Frame, &FMcpPerfSample::GpuMs},
+        {TEXT("usedPhysicalMB"), FMcpPerfSampler::EGroup::Memory, &FMcpPerfSample::UsedPhysicalMB},
+        {TEXT("usedVirtualMB"), FMcpPerfSampler::EGroup::Memory, &FMcpPerfSample::UsedVirtualMB},
+        {TEXT("availablePhysicalMB"), FMcpPerfSampler::EGroup::Memory, &FMcpPerfSample::AvailablePhysicalMB},
+        {TEXT("uobjects"), FMcpPerfSampler::EGroup::Memory, &FMcpPerfSample::UObjectCount},
+        {TEXT("streamingWantingResources"), FMcpPerfSampler::EGroup::Streaming, &FMcpPerfSample::StreamingWantingResources},
+        {TEXT("streamingOverBudgetMB"), FMcpPerfSampler::EGroup::Streaming, &FMcpPerfSample::StreamingOverBudgetMB},
+        {TEXT("asyncPackages"), FMcpPerfSampler::EGroup::Streaming, &FMcpPerfSample::AsyncPackages},
+    };
+
+    float McpBytesToMB(uint64 Bytes)
+    {
+        return float(double(Bytes) / (1024.0 * 1024.0));
+    }
+
+    FString McpSerializeCondensed(const TSharedPtr<FJsonObject>& Object)
+    {
+        FString Out;
+        const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+            TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Out);
+        FJsonSerializer::Serialize(Object.ToSharedRef(), Writer);
+        return Out;
+    }
+}
+
+FMcpPerfSampler& FMcpPerfSampler::Get()
+{
+    static FMcpPerfSampler Instance;
+    return Instance;
+}
+
+void FMcpPerfSampler::Configure(double InIntervalSeconds, double HistorySeconds)
+{
+    IntervalSeconds = InIntervalSeconds;
+    Samples.Reset();
+    Head = 0;
+    Count = 0;
+    if (IntervalSeconds > 0.0)
+    {
+        const int32 Capacity = FMath::Clamp(FMath::CeilToInt32(HistorySeconds / IntervalSeconds), 16, 1 << 16);
+        Samples.SetNum(Capacity);
+    }
+    NextSampleSeconds = 0.0;
+    LastSampleSeconds = FPlatformTime::Seconds();
+    LastFrameCounter = GFrameCounter;
+}
+
+void FMcpPerfSampler::Shutdown()
+{
+    Subscribers.Reset();
+    CachedClassCounts.Reset();
+    IntervalSeconds = 0.0;
+    Samples.Empty();
+    Head = 0;
+    Count = 0;
+}
+
+void FMcpPerfSampler::Tick()
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+    const double Now = FPlatformTime::Seconds();
+    if (Now >= NextSampleSeconds)
+    {
+        TakeSample(Now);
+        NextSampleSeconds = Now + IntervalSeconds;
+    }
+    if (Subscribers.Num() > 0)
+    {
+        PushToSubscribers(Now);
+    }
+}
+
+void FMcpPerfSampler::TakeSample(double Now)
+{
+    FMcpPerfSample& Sample = Samples[Head];
+    Sample = FMcpPerfSample();
+    Sample.TimeSeconds = Now;
+
+    // Average over every frame since the previous sample rather than the last frame only,
+    // so hitches between samples still move the number.
+    const uint64 Frames = GFrameCounter - LastFrameCounter;
+    const double Elapsed = Now - LastSampleSeconds;
+    const double FrameSeconds = Frames > 0 ? Elapsed / double(Frames) : FApp::GetDeltaTime();
+    Sample.FrameMs = float(FrameSeconds * 1000.0);
+    Sample.Fps = FrameSeconds > 0.0 ? float(1.0 / FrameSeconds) : 0.0f;
+    LastFrameCounter = GFrameCounter;
+    LastSampleSeconds = Now;
+
+#if WITH_EDITOR
+    Sample.GameThreadMs = float(FPlatformTime::ToMilliseconds(GGameThreadTime));
+    Sample.RenderThreadMs = float(FPlatformTime::ToMilliseconds(GRenderThreadTime));
+    Sample.RHIThreadMs = float(FPlatformTime::ToMilliseconds(GRHIThreadTime));
+    Sample.GpuMs = float(FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles(0)));
+#endif
+
+    const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+    Sample.UsedPhysicalMB = McpBytesToMB(MemoryStats.UsedPhysical);
+    Sample.UsedVirtualMB = McpBytesToMB(MemoryStats.UsedVirtual);
+    Sample.AvailablePhysicalMB = McpBytesToMB(MemoryStats.AvailablePhysical);
+    Sample.UObjectCount = float(GUObjectArray.GetObjectArrayNumMinusAvailable());
+
+    if (IStreamingManager* Streaming = IStreamingManager::Get_Concurrent())
+    {
+        Sample.StreamingWantingResources = float(Streaming->GetNumWantingResources());
+        Sample.StreamingOverBudgetMB =
+            McpBytesToMB(uint64(FMath::Max<int64>(0, Streaming->GetRenderAssetStreamingManager().GetMemoryOverBudget())));
+    }
+    Sample.AsyncPackages = float(GetNumAsyncPackages());
+
+    Head = (Head + 1) % Samples.Num();
+    Count = FMath::Min(Count + 1, Samples.Num());
+}
+
+TSharedPtr<FJsonObject> FMcpPerfSampler::GetWindowJson(double WindowSeconds, uint8 Groups) const
+{
+    TSharedPtr<FJsonObject> Out = MakeShared<FJsonObject>();
+    Out->SetBoolField(TEXT("sampling"), IsEnabled());
+    Out->SetNumberField(TEXT("intervalSeconds"), IntervalSeconds);
+    Out->SetNumberField(TEXT("windowSeconds"), WindowSeconds);
+
+    // Newest first, back to the edge of the window.
+    TArray<const FMcpPerfSample*, TInlineAllocator<256>> InWindow;
+    const double Now = FPlatformTime::Seconds();
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        const FMcpPerfSample& Sample = Samples[(Head - 1 - Index + Samples.Num()) % Samples.Num()];
+        if (Now - Sample.TimeSeconds > WindowSeconds)
+        {
+            break;
+        }
+        InWindow.Add(&Sample);
+    }
+    Out->SetNumberField(TEXT("samples"), InWindow.Num());
+
+    TSharedPtr<FJsonObject> Metrics = MakeShared<FJsonObject>();
+    TArray<float> Values;
+    Values.Reserve(InWindow.Num());
+    for (const FMcpPerfMetric& Metric : McpPerfMetrics)
+    {
+        if (!(Groups & uint8(Metric.Group)) || InWindow.Num() == 0)
+        {
+            continue;
+        }
+        Values.Reset();
+        double Sum = 0.0;
+        for (const FMcpPerfSample* Sample : InWindow)
+        {
+            const float Value = Sample->*Metric.Field;
+            Values.Add(Value);
+            Sum += Value;
+        }
+        Values.Sort();
+        const int32 P95Index = FMath::Clamp(FMath::CeilToInt32(0.95 * Values.Num()) - 1, 0, Values.Num() - 1);
+
+        TSharedPtr<FJsonObject> Stats = MakeShared<FJsonObject>();
+        Stats->SetNumberField(TEXT("min"), Values[0]);
+        Stats->SetNumberField(TEXT("avg"), Sum / Values.Num());
+        Stats->SetNumberField(TEXT("p95"), Values[P95Index]);
+        Stats->SetNumberField(TEXT("max"), Values.Last());
+        Stats->SetNumberField(TEXT("last"), InWindow[0]->*Metric.Field);
+        Metrics->SetObjectField(Metric.Name, Stats);
+    }
+    Out->SetObjectField(TEXT("metrics"), Metrics);
+    return Out;
+}
+
+TSharedPtr<FJsonObject> FMcpPerfSampler::GetClassCountsJson(int32 TopN, double MaxAgeSeconds)
+{
+    const double Now = FPlatformTime::Seconds();
+    if (CachedClassCounts.IsValid() && CachedClassCountsTopN >= TopN && Now - CachedClassCountsSeconds <= MaxAgeSeconds)
+    {
+        return CachedClassCounts;
+    }
+
+    TMap<const UClass*, int32> PerClass;
+    int32 Total = 0;
+    for (FThreadSafeObjectIterator It; It; ++It)
+    {
+        PerClass.FindOrAdd(It->GetClass())++;
+        ++Total;
+    }
+    PerClass.ValueSort([](int32 A, int32 B)
+    {
+        return A > B;
+    });
+
+    TArray<TSharedPtr<FJsonValue>> Classes;
+    for (const TPair<const UClass*, int32>& Pair : PerClass)
+    {
+        if (Classes.Num() >= TopN)
+        {
+            break;
+        }
+        TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetStringField(TEXT("class"), Pair.Key->GetName());
+        Entry->SetNumberField(TEXT("count"), Pair.Value);
+        Classes.Add(MakeShared<FJsonValueObject>(Entry));
+    }
+
+    CachedClassCounts = MakeShared<FJsonObject>();
+    CachedClassCounts->SetNumberField(TEXT("totalObjects"), Total);
+    CachedClassCounts->SetNumberField(TEXT("distinctClasses"), PerClass.Num());
+    CachedClassCounts->SetArrayField(TEXT("topClasses"), Classes);
+    CachedClassCounts->SetNumberField(TEXT("computeMs"), (FPlatformTime::Seconds() - Now) * 1000.0);
+    CachedClassCountsTopN = TopN;
+    CachedClassCountsSeconds = Now;
+    return CachedClassCounts;
+}
+
+void FMcpPerfSampler::Subscribe(TSharedPtr<FMcpBridgeWebSocket> Socket, double PushIntervalSeconds, double WindowSeconds,
+                                uint8 Groups)
+{
+    Unsubscribe(Socket);
+    FSubscriber& Subscriber = Subscribers.AddDefaulted_GetRef();
+    Subscriber.Socket = Socket;
+    Subscriber.PushIntervalSeconds = PushIntervalSeconds;
+    Subscriber.WindowSeconds = WindowSeconds;
+    Subscriber.Groups = Groups;
+    Subscriber.NextPushSeconds = FPlatformTime::Seconds() + PushIntervalSeconds;
+}
+
+bool FMcpPerfSampler::Unsubscribe(const TSharedPtr<FMcpBridgeWebSocket>& Socket)
+{
+    return Subscribers.RemoveAll([&Socket](const FSubscriber& Subscriber)
+    {
+        return Subscriber.Socket == Socket;
+    }) > 0;
+}
+
+void FMcpPerfSampler::PushToSubscribers(double Now)
+{
+    for (int32 Index = Subscribers.Num() - 1; Index >= 0; --Index)
+    {
+        FSubscriber& Subscriber = Subscribers[Index];
+        if (!Subscriber.Socket.IsValid() || !Subscriber.Socket->IsConnected())
+        {
+            Subscribers.RemoveAtSwap(Index);
+            continue;
+        }
+        if (Now < Subscriber.NextPushSeconds)
+        {
+            continue;
+        }
+        Subscriber.NextPushSeconds = Now + Subscriber.PushIntervalSeconds;
+
+        TSharedPtr<FJsonObject> Frame = GetWindowJson(Subscriber.WindowSeconds, Subscriber.Groups);
+        Frame->SetStringField(TEXT("type"), TEXT("perf_stats"));
+        Frame->SetNumberField(TEXT("seq"), double(Subscriber.Sequence++));
+        Subscriber.Socket->Send(McpSerializeCondensed(Frame));
+    }
+}
+
+uint8 FMcpPerfSampler::ParseGroups(const TSharedPtr<FJsonObject>& Payload, uint8 Default)
+{
+    const TArray<TSharedPtr<FJsonValue>>* Names = nullptr;
+    if (!Payload.IsValid() || !Payload->TryGetArrayField(TEXT("groups"), Names))
+    {
+        return Default;
+    }
+    uint8 Groups = 0;
+    for (const TSharedPtr<FJsonValue>& Name : *Names)
+    {
+        const FString Group = Name.IsValid() ? Name->AsString().ToLower() : FString();
+        if (Group == TEXT("frame"))
+        {
+            Groups |= uint8(EGroup::Frame);
+        }
+        else if (Group == TEXT("memory"))
+        {
+            Groups |= uint8(EGroup::Memory);
+        }
+        else if (Group == TEXT("streaming"))
+        {
+            Groups |= uint8(EGroup::Streaming);
+        }
+        else if (Group == TEXT("all"))
+        {
+            Groups |= uint8(EGroup::All);
+        }
+    }
+    return Groups != 0 ? Groups : Default;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+class FMcpBridgeWebSocket;
+
+/** One editor health sample; memory figures are in MB, times in ms. */
+struct FMcpPerfSample
+{
+    double TimeSeconds = 0.0;
+
+    float FrameMs = 0.0f;
+    float Fps = 0.0f;
+    float GameThreadMs = 0.0f;
+    float RenderThreadMs = 0.0f;
+    float RHIThreadMs = 0.0f;
+    float GpuMs = 0.0f;
+
+    float UsedPhysicalMB = 0.0f;
+    float UsedVirtualMB = 0.0f;
+    float AvailablePhysicalMB = 0.0f;
+    float UObjectCount = 0.0f;
+
+    float StreamingWantingResources = 0.0f;
+    float StreamingOverBudgetMB = 0.0f;
+    float AsyncPackages = 0.0f;
+};
+
+/**
+ * Continuous editor health sampler.
+ *
+ * Ticked from the subsystem ticker; every sample interval it records frame
+ * time (averaged over the frames since the previous sample), game/render/RHI
+ * thread and GPU time, process memory (FPlatformMemory::GetStats), the live
+ * UObject count and streaming state into a fixed-size ring covering the
+ * configured history. Nothing is allocated after Configure.
+ *
+ * Reads aggregate a trailing window into min/avg/p95/max per metric. Clients
+ * can also subscribe: each subscriber gets a perf_stats frame with its window's
+ * aggregates every interval until it unsubscribes or disconnects.
+ *
+ * Per-class UObject counts walk the object array, so they are not sampled;
+ * GetClassCountsJson computes them on request and caches the result briefly.
+ *
+ * Game thread only.
+ */
+class FMcpPerfSampler
+{
+public:
+    /** Metric groups selectable in reads and subscriptions. */
+    enum class EGroup : uint8
+    {
+        Frame = 1 << 0,
+        Memory = 1 << 1,
+        Streaming = 1 << 2,
+        All = Frame | Memory | Streaming,
+    };
+
+    static FMcpPerfSampler& Get();
+
+    /** Sizes the ring for HistorySeconds of samples taken every IntervalSeconds; <= 0 disables sampling. */
+    void Configure(double IntervalSeconds, double HistorySeconds);
+    /** Drops samples, subscribers and cached class counts. */
+    void Shutdown();
+
+    /** Takes a sample when one is due and serves due subscribers. */
+    void Tick();
+
+    bool IsEnabled() const { return IntervalSeconds > 0.0; }
+
+    /**
+     * {windowSeconds, samples, intervalSeconds, metrics: {name: {min, avg, p95,
+     * max, last}}} over the samples taken in the last WindowSeconds.
+     */
+    TSharedPtr<FJsonObject> GetWindowJson(double WindowSeconds, uint8 Groups) const;
+
+    /** The TopN classes by live object count, recomputed when older than MaxAgeSeconds. */
+    TSharedPtr<FJsonObject> GetClassCountsJson(int32 TopN, double MaxAgeSeconds);
+
+    /** Replaces Socket's subscription if it has one. */
+    void Subscribe(TSharedPtr<FMcpBridgeWebSocket> Socket, double PushIntervalSeconds, double WindowSeconds, uint8 Groups);
+    /** Returns false when Socket had no subscription. */
+    bool Unsubscribe(const TSharedPtr<FMcpBridgeWebSocket>& Socket);
+    int32 GetNumSubscribers() const { return Subscribers.Num(); }
+
+    /** Parses a "groups" array ("frame", "memory", "streaming"); Default when absent or empty. */
+    static uint8 ParseGroups(const TSharedPtr<FJsonObject>& Payload, uint8 Default);
+
+private:
+    struct FSubscriber
+    {
+        TSharedPtr<FMcpBridgeWebSocket> Socket;
+        double PushIntervalSeconds = 1.0;
+        double WindowSeconds = 10.0;
+        uint8 Groups = uint8(EGroup::All);
+        double NextPushSeconds = 0.0;
+        int64 Sequence = 0;
+    };
+
+    void TakeSample(double Now);
+    void PushToSubscribers(double Now);
+
+    double IntervalSeconds = 0.0;
+    double NextSampleSeconds = 0.0;
+    double LastSampleSeconds = 0.0;
+    uint64 LastFrameCounter = 0;
+
+    /** Ring of samples; Head is the next slot written. */
+    TArray<FMcpPerfSample> Samples;
+    int32 Head = 0;
+    int32 Count = 0;
+
+    TArray<FSubscriber> Subscribers;
+
+    TSharedPtr<FJsonObject> CachedClassCounts;
+    int32 CachedClassCountsTopN = 0;
+    double CachedClassCountsSeconds = 0.0;
+};
@@ -0,0 +1,489 @@
+#include "McpProcessRunner.h"
+
+#include "HAL/RunnableThread.h"
+#include "Internationalization/Regex.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+#if PLATFORM_UNIX || PLATFORM_MAC
+#include <signal.h>
+#endif
+
+// The CreateProc overload with a separate stderr pipe. Older engines get
+// stdout and stderr merged into one pipe, all reported as stdout.
+#ifndef MCP_HAS_PROC_STDERR_PIPE
+  #if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3)
+    #define MCP_HAS_PROC_STDERR_PIPE 1
+  #else
+    #define MCP_HAS_PROC_STDERR_PIPE 0
+  #endif
+#endif
+
+namespace
+{
+    FString McpNormalizeSeverity(const FString& Severity)
+    {
+        return Severity.Contains(TEXT("error"), ESearchCase::IgnoreCase) ? TEXT("error") : TEXT("warning");
+    }
+}
+
+TSharedPtr<FJsonObject> FMcpProcessDiagnostic::ToJson() const
+{
+    TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetStringField(TEXT("severity"), Severity);
+    if (!File.IsEmpty())
+    {
+        Json->SetStringField(TEXT("file"), File);
+    }
+    if (Line > 0)
+    {
+        Json->SetNumberField(TEXT("line"), Line);
+    }
+    if (Column > 0)
+    {
+        Json->SetNumberField(TEXT("column"), Column);
+    }
+    if (!Code.IsEmpty())
+    {
+        Json->SetStringField(TEXT("code"), Code);
+    }
+    Json->SetStringField(TEXT("message"), Message);
+    return Json;
+}
+
+bool FMcpProcessDiagnostic::Parse(const FString& Line, FMcpProcessDiagnostic& Out)
+{
+    // Nearly every line of a build is neither; skip the regex engine for those.
+    if (!Line.Contains(TEXT("error"), ESearchCase::IgnoreCase) && !Line.Contains(TEXT("warning"), ESearchCase::IgnoreCase))
+    {
+        return false;
+    }
+
+    // MSVC: Foo.cpp(12,5): error C2065: 'x': undeclared identifier
+    static const FRegexPattern MsvcPattern(TEXT("^\\s*(.+?)\\((\\d+)(?:,(\\d+))?\\)\\s*:\\s*(fatal error|error|warning)\\s+([A-Za-z]+\\d+)\\s*:\\s*(.*)$"));
+    // MSVC without a location: LINK : fatal error LNK1104: cannot open file 'x.lib'
+    static const FRegexPattern MsvcToolPattern(TEXT("^\\s*(\\S+)\\s*:\\s*(fatal error|error|warning)\\s+([A-Za-z]+\\d+)\\s*:\\s*(.*)$"));
+    // clang/gcc: Foo.cpp:12:5: error: use of undeclared identifier 'x' [-Wflag]
+    static const FRegexPattern ClangPattern(TEXT("^(.+?):(\\d+):(\\d+):\\s*(fatal error|error|warning):\\s*(.*?)(?:\\s+\\[(-W[^\\]]+)\\])?$"));
+    // Tools without a location: ld.lld: error: undefined symbol: Foo
+    static const FRegexPattern ToolPattern(TEXT("^([\\w.+\\-]+):\\s*(fatal error|error|warning):\\s*(.*)$"));
+    // UnrealBuildTool: ERROR: Could not find definition for module 'Foo'
+    static const FRegexPattern UbtPattern(TEXT("^\\s*(ERROR|Error|WARNING|Warning):\\s*(.+)$"));
+
+    {
+        FRegexMatcher Matcher(MsvcPattern, Line);
+        if (Matcher.FindNext())
+        {
+            Out.File = Matcher.GetCaptureGroup(1);
+            Out.Line = FCString::Atoi(*Matcher.GetCaptureGroup(2));
+            Out.Column = FCString::Atoi(*Matcher.GetCaptureGroup(3));
+            Out.Severity = McpNormalizeSeverity(Matcher.GetCaptureGroup(4));
+            Out.Code = Matcher.GetCaptureGroup(5);
+            Out.Message = Matcher.GetCaptureGroup(6);
+            return true;
+        }
+    }
+    {
+        FRegexMatcher Matcher(ClangPattern, Line);
+        if (Matcher.FindNext())
+        {
+            Out.File = Matcher.GetCaptureGroup(1);
+            Out.Line = FCString::Atoi(*Matcher.GetCaptureGroup(2));
+            Out.Column = FCString::Atoi(*Matcher.GetCaptureGroup(3));
+            Out.Severity = McpNormalizeSeverity(Matcher.GetCaptureGroup(4));
+            Out.Message = Matcher.GetCaptureGroup(5);
+            Out.Code = Matcher.GetCaptureGroup(6);
+            return true;
+        }
+    }
+    {
+        FRegexMatcher Matcher(MsvcToolPattern, Line);
+        if (Matcher.FindNext())
+        {
+            Out.File = Matcher.GetCaptureGroup(1);
+            Out.Severity = McpNormalizeSeverity(Matcher.GetCaptureGroup(2));
+            Out.Code = Matcher.GetCaptureGroup(3);
+            Out.Message = Matcher.GetCaptureGroup(4);
+            return true;
+        }
+    }
+    {
+        FRegexMatcher Matcher(ToolPattern, Line);
+        if (Matcher.FindNext())
+        {
+            Out.File = Matcher.GetCaptureGroup(1);
+            Out.Severity = McpNormalizeSeverity(Matcher.GetCaptureGroup(2));
+            Out.Message = Matcher.GetCaptureGroup(3);
+            return true;
+        }
+    }
+    {
+        FRegexMatcher Matcher(UbtPattern, Line);
+        if (Matcher.FindNext())
+        {
+            Out.Severity = McpNormalizeSeverity(Matcher.GetCaptureGroup(1));
+            Out.Message = Matcher.GetCaptureGroup(2);
+            return true;
+        }
+    }
+    return false;
+}
+
+FMcpProcessRunner::FMcpProcessRunner(uint32 LineBufferSize, bool bInParseDiagnostics)
+    : bParseDiagnostics(bInParseDiagnostics)
+    , Lines(LineBufferSize)
+{
+}
+
+FMcpProcessRunner::~FMcpProcessRunner()
+{
+    Terminate();
+    Stop();
+    if (Thread)
+    {
+        Thread->Kill(true);
+        delete Thread;
+        Thread = nullptr;
+    }
+    if (ProcessHandle.IsValid())
+    {
+        FPlatformProcess::CloseProc(ProcessHandle);
+    }
+    ClosePipes();
+}
+
+bool FMcpProcessRunner::Launch(const FString& Executable, const FString& Arguments, const FString& WorkingDirectory, FString& OutError)
+{
+    check(!ProcessHandle.IsValid() && !Thread);
+
+    if (!FPaths::FileExists(Executable))
+    {
+        OutError = FString::Printf(TEXT("Executable not found: %s"), *Executable);
+        return false;
+    }
+    CommandLine = FString::Printf(TEXT("\"%s\" %s"), *Executable, *Arguments).TrimEnd();
+    if (!FPlatformProcess::CreatePipe(StdoutRead, StdoutWrite))
+    {
+        OutError = TEXT("Failed to create stdout pipe.");
+        return false;
+    }
+
+#if MCP_HAS_PROC_STDERR_PIPE
+    bSeparateStderr = FPlatformProcess::CreatePipe(StderrRead, StderrWrite);
+    ProcessHandle = FPlatformProcess::CreateProc(
+        *Executable, *Arguments,
+        false, // bLaunchDetached
+        true, // bLaunchHidden
+        true, // bLaunchReallyHidden
+        &ProcessId, 0,
+        WorkingDirectory.IsEmpty() ? nullptr : *WorkingDirectory,
+        StdoutWrite, nullptr, bSeparateStderr ? StderrWrite : nullptr);
+#else
+    ProcessHandle = FPlatformProcess::CreateProc(
+        *Executable, *Arguments,
+        false, // bLaunchDetached
+        true, // bLaunchHidden
+        true, // bLaunchReallyHidden
+        &ProcessId, 0,
+        WorkingDirectory.IsEmpty() ? nullptr : *WorkingDirectory,
+        StdoutWrite, nullptr);
+#endif
+
+    if (!ProcessHandle.IsValid())
+    {
+        ClosePipes();
+        OutError = FString::Printf(TEXT("Failed to launch %s"), *Executable);
+        return false;
+    }
+
+    Thread = FRunnableThread::Create(this, TEXT("McpProcessReader"), 0, TPri_BelowNormal);
+    if (!Thread)
+    {
+        FPlatformProcess::TerminateProc(ProcessHandle, true);
+        FPlatformProcess::CloseProc(ProcessHandle);
+        ClosePipes();
+        OutError = TEXT("Failed to start the output reader thread.");
+        return false;
+    }
+    return true;
+}
+
+void FMcpProcessRunner::Terminate()
+{
+    bTerminateRequested.store(true, std::memory_order_relaxed);
+}
+
+void FMcpProcessRunner::Stop()
+{
+    bStopRequested.store(true, std::memory_order_relaxed);
+}
+
+uint32 FMcpProcessRunner::Run()
+{
+    TArray<uint8> PendingStdout;
+    TArray<uint8> PendingStderr;
+    bool bKilled = false;
+
+    while (!bStopRequested.load(std::memory_order_relaxed))
+    {
+        if (!bKilled && bTerminateRequested.load(std::memory_order_relaxed))
+        {
+            KillProcessTree();
+            bKilled = true;
+        }
+
+        // Sample liveness before reading so output written just before exit is
+        // still picked up by the reads below.
+        const bool bRunning = FPlatformProcess::IsProcRunning(ProcessHandle);
+        bool bReadAny = ReadOutput(StdoutRead, EMcpProcessStream::Stdout, PendingStdout);
+        bReadAny |= ReadOutput(StderrRead, EMcpProcessStream::Stderr, PendingStderr);
+
+        if (!bRunning)
+        {
+            // Drain what is buffered, but do not wait for EOF: grandchildren that
+            // inherited the pipe (compilers, dotnet) may keep it open.
+            while (ReadOutput(StdoutRead, EMcpProcessStream::Stdout, PendingStdout) ||
+                   ReadOutput(StderrRead, EMcpProcessStream::Stderr, PendingStderr))
+            {
+            }
+            break;
+        }
+        if (!bReadAny)
+        {
+            FPlatformProcess::Sleep(0.01f);
+        }
+    }
+
+    // Stopped (runner destroyed) while the process was still alive.
+    if (!bKilled && bTerminateRequested.load(std::memory_order_relaxed) && FPlatformProcess::IsProcRunning(ProcessHandle))
+    {
+        KillProcessTree();
+    }
+
+    FlushPending(EMcpProcessStream::Stdout, PendingStdout);
+    FlushPending(EMcpProcessStream::Stderr, PendingStderr);
+
+    int32 Code = -1;
+    if (!FPlatformProcess::IsProcRunning(ProcessHandle))
+    {
+        FPlatformProcess::GetProcReturnCode(ProcessHandle, &Code);
+    }
+    ExitCode.store(Code, std::memory_order_release);
+    bFinished.store(true, std::memory_order_release);
+    return 0;
+}
+
+bool FMcpProcessRunner::ReadOutput(void* Pipe, EMcpProcessStream Stream, TArray<uint8>& Pending)
+{
+    if (!Pipe)
+    {
+        return false;
+    }
+
+    TArray<uint8> Chunk;
+    if (!FPlatformProcess::ReadPipeToArray(Pipe, Chunk) || Chunk.Num() == 0)
+    {
+        return false;
+    }
+
+    // Split on raw bytes and decode whole lines, so multi-byte UTF-8
+    // sequences that straddle two reads are never mangled.
+    int32 LineStart = 0;
+    for (int32 Index = 0; Index < Chunk.Num(); ++Index)
+    {
+        if (Chunk[Index] != '\n')
+        {
+            continue;
+        }
+        if (Pending.Num() > 0)
+        {
+            Pending.Append(Chunk.GetData() + LineStart, Index - LineStart);
+            EmitLine(Stream, Pending.GetData(), Pending.Num());
+            Pending.Reset();
+        }
+        else
+        {
+            EmitLine(Stream, Chunk.GetData() + LineStart, Index - LineStart);
+        }
+        LineStart = Index + 1;
+    }
+    Pending.Append(Chunk.GetData() + LineStart, Chunk.Num() - LineStart);
+    if (Pending.Num() >= MaxLineBytes)
+    {
+        FlushPending(Stream, Pending);
+    }
+    return true;
+}
+
+void FMcpProcessRunner::FlushPending(EMcpProcessStream Stream, TArray<uint8>& Pending)
+{
+    if (Pending.Num() > 0)
+    {
+        EmitLine(Stream, Pending.GetData(), Pending.Num());
+        Pending.Reset();
+    }
+}
+
+void FMcpProcessRunner::EmitLine(EMcpProcessStream Stream, const uint8* Bytes, int32 Num)
+{
+    if (Num > 0 && Bytes[Num - 1] == '\r')
+    {
+        --Num;
+    }
+
+    FMcpProcessLine Line;
+    Line.Seq = TotalLines.fetch_add(1, std::memory_order_relaxed);
+    Line.Stream = Stream;
+    const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes), Num);
+    Line.Text = FString(Converted.Length(), Converted.Get());
+
+    {
+        FMcpProcessDiagnostic Diagnostic;
+        const bool bIsDiagnostic = bParseDiagnostics && FMcpProcessDiagnostic::Parse(Line.Text, Diagnostic);
+
+        FScopeLock Lock(&SummaryMutex);
+        if (bIsDiagnostic)
+        {
+            (Diagnostic.Severity == TEXT("error") ? ErrorCount : WarningCount)++;
+            if (Diagnostics.Num() < MaxRetainedDiagnostics)
+            {
+                Diagnostics.Add(MoveTemp(Diagnostic));
+            }
+        }
+        if (Tail.Num() < MaxRetainedTailLines)
+        {
+            Tail.Add(Line.Text);
+        }
+        else
+        {
+            Tail[TailStart] = Line.Text;
+            TailStart = (TailStart + 1) % MaxRetainedTailLines;
+        }
+    }
+
+    DroppedLines.fetch_add(Lines.Push(MoveTemp(Line)), std::memory_order_relaxed);
+}
+
+int32 FMcpProcessRunner::DrainLines(TArray<FMcpProcessLine>& OutLines, int32 MaxLines)
+{
+    int32 Drained = 0;
+    FMcpProcessLine Line;
+    while (Drained < MaxLines && Lines.TryPop(Line))
+    {
+        OutLines.Add(MoveTemp(Line));
+        ++Drained;
+    }
+    return Drained;
+}
+
+int32 FMcpProcessRunner::GetErrorCount() const
+{
+    FScopeLock Lock(&SummaryMutex);
+    return ErrorCount;
+}
+
+int32 FMcpProcessRunner::GetWarningCount() const
+{
+    FScopeLock Lock(&SummaryMutex);
+    return WarningCount;
+}
+
+TSharedPtr<FJsonObject> FMcpProcessRunner::GetSummaryJson(int32 MaxDiagnostics, int32 TailLines) const
+{
+    TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetNumberField(TEXT("pid"), ProcessId);
+    if (IsFinished())
+    {
+        Json->SetNumberField(TEXT("exitCode"), GetExitCode());
+    }
+    Json->SetBoolField(TEXT("terminated"), WasTerminated());
+    Json->SetBoolField(TEXT("separateStderr"), bSeparateStderr);
+    Json->SetNumberField(TEXT("lines"), (double)GetTotalLines());
+    Json->SetNumberField(TEXT("droppedLines"), (double)GetDroppedLines());
+
+    FScopeLock Lock(&SummaryMutex);
+    Json->SetNumberField(TEXT("errorCount"), ErrorCount);
+    Json->SetNumberField(TEXT("warningCount"), WarningCount);
+
+    // Errors first so a truncated list still shows what broke the build.
+    TArray<TSharedPtr<FJsonValue>> DiagnosticArray;
+    for (int32 Pass = 0; Pass < 2; ++Pass)
+    {
+        for (const FMcpProcessDiagnostic& Diagnostic : Diagnostics)
+        {
+            if (DiagnosticArray.Num() >= MaxDiagnostics)
+            {
+                break;
+            }
+            if ((Diagnostic.Severity == TEXT("error")) == (Pass == 0))
+            {
+                DiagnosticArray.Add(MakeShared<FJsonValueObject>(Diagnostic.ToJson()));
+            }
+        }
+    }
+    Json->SetArrayField(TEXT("diagnostics"), DiagnosticArray);
+
+    TArray<TSharedPtr<FJsonValue>> TailArray;
+    const int32 Count = FMath::Min(TailLines, Tail.Num());
+    for (int32 Index = Tail.Num() - Count; Index < Tail.Num(); ++Index)
+    {
+        TailArray.Add(MakeShared<FJsonValueString>(Tail[(TailStart + Index) % Tail.Num()]));
+    }
+    Json->SetArrayField(TEXT("tail"), TailArray);
+    return Json;
+}
+
+void FMcpProcessRunner::KillProcessTree()
+{
+#if PLATFORM_UNIX || PLATFORM_MAC
+    // TerminateProc ignores KillTree here, and UBT runs under a shell script
+    // that spawns dotnet and the compilers. Snapshot the descendants before
+    // the root dies and they are reparented, then signal all of them.
+    TMap<uint32, TArray<uint32>> Children;
+    {
+        FPlatformProcess::FProcEnumerator Enumerator;
+        while (Enumerator.MoveNext())
+        {
+            FPlatformProcess::FProcEnumInfo Info = Enumerator.GetCurrent();
+            Children.FindOrAdd(Info.GetParentPID()).Add(Info.GetPID());
+        }
+    }
+    TArray<uint32> Descendants;
+    TArray<uint32> Frontier = {ProcessId};
+    while (Frontier.Num() > 0)
+    {
+        const uint32 Pid = Frontier.Pop();
+        if (const TArray<uint32>* Found = Children.Find(Pid))
+        {
+            for (uint32 Child : *Found)
+            {
+                if (!Descendants.Contains(Child))
+                {
+                    Descendants.Add(Child);
+                    Frontier.Add(Child);
+                }
+            }
+        }
+    }
+
+    FPlatformProcess::TerminateProc(ProcessHandle, false);
+    for (uint32 Pid : Descendants)
+    {
+        kill((pid_t)Pid, SIGTERM);
+    }
+#else
+    FPlatformProcess::TerminateProc(ProcessHandle, true);
+#endif
+}
+
+void FMcpProcessRunner::ClosePipes()
+{
+    FPlatformProcess::ClosePipe(StdoutRead, StdoutWrite);
+    StdoutRead = StdoutWrite = nullptr;
+    if (StderrRead || StderrWrite)
+    {
+        FPlatformProcess::ClosePipe(StderrRead, StderrWrite);
+        StderrRead = StderrWrite = nullptr;
+    }
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/Runnable.h"
+#include "McpBoundedRing.h"
+
+#include <atomic>
+
+class FRunnableThread;
+
+enum class EMcpProcessStream : uint8
+{
+    Stdout,
+    Stderr,
+};
+
+/** One line of child output, numbered in the order the reader saw it. */
+struct FMcpProcessLine
+{
+    uint64 Seq = 0;
+    EMcpProcessStream Stream = EMcpProcessStream::Stdout;
+    FString Text;
+};
+
+/** A compiler, linker or UnrealBuildTool diagnostic parsed from an output line. */
+struct FMcpProcessDiagnostic
+{
+    /** "error" or "warning" ("fatal error" is reported as "error"). */
+    FString Severity;
+    /** Source file, or the reporting tool (e.g. "ld.lld", "LINK") when there is no file. */
+    FString File;
+    int32 Line = 0;
+    int32 Column = 0;
+    /** MSVC code (C2065, LNK2019) or clang warning flag (-Wunused-variable). */
+    FString Code;
+    FString Message;
+
+    TSharedPtr<FJsonObject> ToJson() const;
+
+    /**
+     * Recognises MSVC "file(line[,col]): error C1234: msg", clang/gcc
+     * "file:line:col: error: msg [-Wflag]", "tool: error: msg" and UBT
+     * "ERROR: msg" lines. Returns false for anything else.
+     */
+    static bool Parse(const FString& Line, FMcpProcessDiagnostic& Out);
+};
+
+/**
+ * Runs one external tool with its stdout/stderr connected to pipes.
+ *
+ * A reader thread owns the process handle: it drains both pipes into whole
+ * lines, parses diagnostics as it goes and pushes lines into a bounded ring
+ * the game thread empties with DrainLines. Output the consumer does not keep
+ * up with is dropped oldest-first and counted, so a chatty build can never
+ * stall on a full pipe or grow memory without bound. Diagnostics and a short
+ * tail are kept separately and survive drops.
+ *
+ * Terminate is asynchronous; the reader kills the whole process tree and
+ * reports IsFinished once the root process has exited.
+ */
+class FMcpProcessRunner : public FRunnable
+{
+public:
+    explicit FMcpProcessRunner(uint32 LineBufferSize = 8192, bool bInParseDiagnostics = true);
+    virtual ~FMcpProcessRunner();
+
+    FMcpProcessRunner(const FMcpProcessRunner&) = delete;
+    FMcpProcessRunner& operator=(const FMcpProcessRunner&) = delete;
+
+    /** Starts the process hidden with piped output. Call once. */
+    bool Launch(const FString& Executable, const FString& Arguments, const FString& WorkingDirectory, FString& OutError);
+
+    /** Asks the reader thread to kill the process tree. Safe to call repeatedly. */
+    void Terminate();
+
+    /** True once the process has exited and every pipe has been drained. */
+    bool IsFinished() const { return bFinished.load(std::memory_order_acquire); }
+
+    /** Exit code; only meaningful once IsFinished. */
+    int32 GetExitCode() const { return ExitCode.load(std::memory_order_acquire); }
+    uint32 GetProcessId() const { return ProcessId; }
+    /** Executable and arguments as launched, for status reports. */
+    const FString& GetCommandLine() const { return CommandLine; }
+    bool WasTerminated() const { return bTerminateRequested.load(std::memory_order_relaxed); }
+
+    /** Moves up to MaxLines buffered lines into OutLines. Returns how many were moved. */
+    int32 DrainLines(TArray<FMcpProcessLine>& OutLines, int32 MaxLines);
+
+    uint64 GetTotalLines() const { return TotalLines.load(std::memory_order_relaxed); }
+    uint64 GetDroppedLines() const { return DroppedLines.load(std::memory_order_relaxed); }
+
+    /** exitCode, pid, line counts, error/warning counts, diagnostics and output tail. */
+    TSharedPtr<FJsonObject> GetSummaryJson(int32 MaxDiagnostics, int32 TailLines) const;
+
+    int32 GetErrorCount() const;
+    int32 GetWarningCount() const;
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    /** Reads what is available from Pipe into Pending and emits complete lines. Returns true if any bytes were read. */
+    bool ReadOutput(void* Pipe, EMcpProcessStream Stream, TArray<uint8>& Pending);
+    void EmitLine(EMcpProcessStream Stream, const uint8* Bytes, int32 Num);
+    void FlushPending(EMcpProcessStream Stream, TArray<uint8>& Pending);
+    void KillProcessTree();
+    void ClosePipes();
+
+    static constexpr int32 MaxRetainedDiagnostics = 1000;
+    static constexpr int32 MaxRetainedTailLines = 200;
+    /** Longer runs without a newline are split so one line cannot grow unbounded. */
+    static constexpr int32 MaxLineBytes = 64 * 1024;
+
+    FProcHandle ProcessHandle;
+    uint32 ProcessId = 0;
+    FString CommandLine;
+    bool bParseDiagnostics = true;
+    bool bSeparateStderr = false;
+
+    void* StdoutRead = nullptr;
+    void* StdoutWrite = nullptr;
+    void* StderrRead = nullptr;
+    void* StderrWrite = nullptr;
+
+    FRunnableThread* Thread = nullptr;
+    std::atomic<bool> bStopRequested{false};
+    std::atomic<bool> bTerminateRequested{false};
+    std::atomic<bool> bFinished{false};
+    std::atomic<int32> ExitCode{-1};
+
+    TMcpBoundedRing<FMcpProcessLine> Lines;
+    std::atomic<uint64> TotalLines{0};
+    std::atomic<uint64> DroppedLines{0};
+
+    mutable FCriticalSection SummaryMutex;
+    TArray<FMcpProcessDiagnostic> Diagnostics;
+    int32 ErrorCount = 0;
+    int32 WarningCount = 0;
+    /** Circular; TailStart is the oldest entry once the tail is full. */
+    TArray<FString> Tail;
+    int32 TailStart = 0;
+};
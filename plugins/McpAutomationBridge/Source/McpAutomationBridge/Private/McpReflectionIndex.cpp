@@ -0,0 +1,513 @@
+#include "McpReflectionIndex.h"
+
+#include "Engine/Blueprint.h"
+#include "HAL/PlatformTime.h"
+#include "McpAutomationBridgeSubsystem.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopeLock.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/Class.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UObjectIterator.h"
+
+#include <type_traits>
+
+#if WITH_EDITOR
+#include "Editor.h"
+#endif
+
+namespace
+{
+    /** Blueprint compilation and hot reload leave these behind next to the real type. */
+    bool McpIsShadowTypeName(const FString& Name)
+    {
+        return Name.StartsWith(TEXT("SKEL_")) || Name.StartsWith(TEXT("REINST_")) ||
+               Name.StartsWith(TEXT("TRASHCLASS_")) || Name.StartsWith(TEXT("HOTRELOADED_")) ||
+               Name.StartsWith(TEXT("PLACEHOLDER-CLASS"));
+    }
+
+    bool McpIsLiveType(const UObject* Object)
+    {
+        return IsValid(Object) && !Object->HasAnyFlags(RF_NewerVersionExists);
+    }
+
+    bool McpIsCompiledIn(const UObject* Object)
+    {
+        return Object->GetOutermost()->HasAnyPackageFlags(PKG_CompiledIn);
+    }
+
+    /** Splits "Outer::Name" or "Outer.Name"; Outer is empty for an unqualified name. */
+    void McpSplitQualifiedName(const FString& In, FString& OutOuter, FString& OutShort)
+    {
+        int32 Index = In.Find(TEXT("::"), ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+        int32 SeparatorLen = 2;
+        if (Index == INDEX_NONE)
+        {
+            In.FindLastChar(TEXT('.'), Index);
+            SeparatorLen = 1;
+        }
+        if (Index == INDEX_NONE)
+        {
+            OutOuter.Reset();
+            OutShort = In;
+            return;
+        }
+        OutOuter = In.Left(Index);
+        OutShort = In.Mid(Index + SeparatorLen);
+    }
+
+    /** Adds Object to its bucket, keeping compiled-in types ahead of blueprint/user ones. */
+    template <typename T, typename MapT>
+    void McpAddToBucket(MapT& Map, T* Object)
+    {
+        auto& Bucket = Map.FindOrAdd(Object->GetFName());
+        const TWeakObjectPtr<T> Weak(Object);
+        if (Bucket.Contains(Weak))
+        {
+            return;
+        }
+        int32 InsertAt = Bucket.Num();
+        if (McpIsCompiledIn(Object))
+        {
+            InsertAt = 0;
+            while (InsertAt < Bucket.Num() && Bucket[InsertAt].IsValid() && McpIsCompiledIn(Bucket[InsertAt].Get()))
+            {
+                ++InsertAt;
+            }
+        }
+        Bucket.Insert(Weak, InsertAt);
+    }
+
+    template <typename T, typename MapT, typename FilterT>
+    T* McpFindInBucket(const MapT& Map, const FString& Short, const FilterT& Filter)
+    {
+        // FNAME_Find never adds caller input to the name table; FName compares case-insensitively.
+        const FName Key(*Short, FNAME_Find);
+        if (Key.IsNone())
+        {
+            return nullptr;
+        }
+        const auto* Bucket = Map.Find(Key);
+        if (!Bucket)
+        {
+            return nullptr;
+        }
+        for (const TWeakObjectPtr<T>& Weak : *Bucket)
+        {
+            T* Object = Weak.Get();
+            if (McpIsLiveType(Object) && Filter(Object))
+            {
+                return Object;
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename T, typename MapT, typename FilterT>
+    T* McpLookupType(const MapT& Map, const FString& Name, const FilterT& Filter)
+    {
+        FString Outer;
+        FString Short;
+        McpSplitQualifiedName(Name, Outer, Short);
+        auto Matches = [&Outer, &Filter](T* Object)
+        {
+            return (Outer.IsEmpty() ||
+                    FPackageName::GetShortName(Object->GetOutermost()->GetName()).Equals(Outer, ESearchCase::IgnoreCase)) &&
+                   Filter(Object);
+        };
+        if (T* Found = McpFindInBucket<T>(Map, Short, Matches))
+        {
+            return Found;
+        }
+
+        // "UStaticMeshComponent", "AActor", "FVector": strip the C++ prefix when it is
+        // the one the type would have been declared with.
+        if constexpr (std::is_base_of_v<UStruct, T>)
+        {
+            if (Short.Len() > 1 && FChar::IsUpper(Short[1]))
+            {
+                const TCHAR Prefix = Short[0];
+                return McpFindInBucket<T>(Map, Short.Mid(1), [Prefix, &Matches](T* Object)
+                {
+                    return Object->GetPrefixCPP()[0] == Prefix && Matches(Object);
+                });
+            }
+        }
+        return nullptr;
+    }
+}
+
+FMcpReflectionIndex& FMcpReflectionIndex::Get()
+{
+    static FMcpReflectionIndex Instance;
+    return Instance;
+}
+
+void FMcpReflectionIndex::Startup()
+{
+    if (!ModulesChangedHandle.IsValid())
+    {
+        ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddLambda(
+            [this](FName, EModuleChangeReason Reason)
+            {
+                if (Reason == EModuleChangeReason::ModuleLoaded || Reason == EModuleChangeReason::ModuleUnloaded)
+                {
+                    Invalidate();
+                }
+            });
+    }
+    if (!ReloadCompleteHandle.IsValid())
+    {
+        ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda(
+            [this](EReloadCompleteReason)
+            {
+                Invalidate();
+            });
+    }
+    if (!AssetLoadedHandle.IsValid())
+    {
+        AssetLoadedHandle = FCoreUObjectDelegates::OnAssetLoaded.AddRaw(this, &FMcpReflectionIndex::HandleAssetLoaded);
+    }
+#if WITH_EDITOR
+    if (GEditor && !BlueprintCompiledHandle.IsValid())
+    {
+        BlueprintPreCompileHandle =
+            GEditor->OnBlueprintPreCompile().AddRaw(this, &FMcpReflectionIndex::HandleBlueprintPreCompile);
+        BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FMcpReflectionIndex::HandleBlueprintCompiled);
+    }
+#endif
+}
+
+void FMcpReflectionIndex::Shutdown()
+{
+    if (ModulesChangedHandle.IsValid())
+    {
+        FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+        ModulesChangedHandle.Reset();
+    }
+    if (ReloadCompleteHandle.IsValid())
+    {
+        FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+        ReloadCompleteHandle.Reset();
+    }
+    if (AssetLoadedHandle.IsValid())
+    {
+        FCoreUObjectDelegates::OnAssetLoaded.Remove(AssetLoadedHandle);
+        AssetLoadedHandle.Reset();
+    }
+#if WITH_EDITOR
+    if (BlueprintCompiledHandle.IsValid())
+    {
+        if (GEditor)
+        {
+            GEditor->OnBlueprintPreCompile().Remove(BlueprintPreCompileHandle);
+            GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+        }
+        BlueprintPreCompileHandle.Reset();
+        BlueprintCompiledHandle.Reset();
+    }
+#endif
+    Invalidate();
+}
+
+void FMcpReflectionIndex::Invalidate()
+{
+    FScopeLock Lock(&Mutex);
+    bTypesBuilt = false;
+    bFunctionsBuilt = false;
+    Classes.Empty();
+    Structs.Empty();
+    Enums.Empty();
+    Functions.Empty();
+    CompilingBlueprints.Empty();
+}
+
+void FMcpReflectionIndex::AddType(UObject* Object)
+{
+    if (!McpIsLiveType(Object) || McpIsShadowTypeName(Object->GetName()))
+    {
+        return;
+    }
+    if (UClass* Class = Cast<UClass>(Object))
+    {
+        if (!Class->HasAnyClassFlags(CLASS_NewerVersionExists))
+        {
+            McpAddToBucket(Classes, Class);
+        }
+    }
+    else if (UScriptStruct* Struct = Cast<UScriptStruct>(Object))
+    {
+        McpAddToBucket(Structs, Struct);
+    }
+    else if (UEnum* Enum = Cast<UEnum>(Object))
+    {
+        McpAddToBucket(Enums, Enum);
+    }
+}
+
+void FMcpReflectionIndex::EnsureTypesBuilt()
+{
+    if (bTypesBuilt)
+    {
+        return;
+    }
+    const double StartSeconds = FPlatformTime::Seconds();
+    for (TObjectIterator<UClass> It; It; ++It)
+    {
+        AddType(*It);
+    }
+    for (TObjectIterator<UScriptStruct> It; It; ++It)
+    {
+        AddType(*It);
+    }
+    for (TObjectIterator<UEnum> It; It; ++It)
+    {
+        AddType(*It);
+    }
+    bTypesBuilt = true;
+    UE_LOG(LogMcpAutomationBridgeSubsystem, Verbose,
+           TEXT("Reflection index built: %d class, %d struct, %d enum names in %.1f ms"),
+           Classes.Num(), Structs.Num(), Enums.Num(), (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+}
+
+void FMcpReflectionIndex::EnsureFunctionsBuilt()
+{
+    if (bFunctionsBuilt)
+    {
+        return;
+    }
+    const double StartSeconds = FPlatformTime::Seconds();
+    for (TObjectIterator<UFunction> It; It; ++It)
+    {
+        UFunction* Function = *It;
+        const UClass* Owner = Function->GetOwnerClass();
+        if (!Owner || Function->HasAnyFunctionFlags(FUNC_Delegate) ||
+            Owner->HasAnyClassFlags(CLASS_NewerVersionExists) || McpIsShadowTypeName(Owner->GetName()))
+        {
+            continue;
+        }
+        McpAddToBucket(Functions, Function);
+    }
+    bFunctionsBuilt = true;
+    UE_LOG(LogMcpAutomationBridgeSubsystem, Verbose, TEXT("Reflection index built: %d function names in %.1f ms"),
+           Functions.Num(), (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+}
+
+void FMcpReflectionIndex::HandleAssetLoaded(UObject* Asset)
+{
+    UObject* Type = Asset;
+    if (const UBlueprint* Blueprint = Cast<UBlueprint>(Asset))
+    {
+        Type = Blueprint->GeneratedClass;
+    }
+    if (!Type)
+    {
+        return;
+    }
+
+    FScopeLock Lock(&Mutex);
+    AddLoadedType(Type);
+}
+
+void FMcpReflectionIndex::AddLoadedType(UObject* Type)
+{
+    if (bTypesBuilt)
+    {
+        AddType(Type);
+    }
+    if (bFunctionsBuilt)
+    {
+        if (UClass* Class = Cast<UClass>(Type))
+        {
+            for (TFieldIterator<UFunction> It(Class, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+            {
+                McpAddToBucket(Functions, *It);
+            }
+        }
+    }
+}
+
+void FMcpReflectionIndex::HandleBlueprintPreCompile(UBlueprint* Blueprint)
+{
+    if (Blueprint)
+    {
+        FScopeLock Lock(&Mutex);
+        CompilingBlueprints.AddUnique(Blueprint);
+    }
+}
+
+void FMcpReflectionIndex::HandleBlueprintCompiled()
+{
+    FScopeLock Lock(&Mutex);
+    TArray<TWeakObjectPtr<UBlueprint>> Compiled = MoveTemp(CompilingBlueprints);
+    CompilingBlueprints.Reset();
+    for (const TWeakObjectPtr<UBlueprint>& Weak : Compiled)
+    {
+        const UBlueprint* Blueprint = Weak.Get();
+        if (Blueprint && Blueprint->GeneratedClass)
+        {
+            ReplaceClass(Blueprint->GeneratedClass);
+        }
+    }
+}
+
+void FMcpReflectionIndex::ReplaceClass(UClass* Class)
+{
+    // A recompile may keep the class object or reinstance it; either way the
+    // previous version has the same name and package. Drop it and the
+    // functions it owned, then index the class as if it had just loaded.
+    const UPackage* Package = Class->GetOutermost();
+    const FName ClassName = Class->GetFName();
+    auto IsStaleClass = [Class, Package, ClassName](const UClass* Other)
+    {
+        return !McpIsLiveType(Other) || Other == Class || Other->HasAnyClassFlags(CLASS_NewerVersionExists) ||
+               McpIsShadowTypeName(Other->GetName()) ||
+               (Other->GetOutermost() == Package && Other->GetFName() == ClassName);
+    };
+
+    if (bTypesBuilt)
+    {
+        if (auto* Bucket = Classes.Find(ClassName))
+        {
+            Bucket->RemoveAll([&IsStaleClass](const TWeakObjectPtr<UClass>& Weak)
+            {
+                return IsStaleClass(Weak.Get());
+            });
+        }
+    }
+    if (bFunctionsBuilt)
+    {
+        for (auto It = Functions.CreateIterator(); It; ++It)
+        {
+            It->Value.RemoveAll([&IsStaleClass](const TWeakObjectPtr<UFunction>& Weak)
+            {
+                const UFunction* Function = Weak.Get();
+                return !Function || IsStaleClass(Function->GetOwnerClass());
+            });
+            if (It->Value.Num() == 0)
+            {
+                It.RemoveCurrent();
+            }
+        }
+    }
+    AddLoadedType(Class);
+}
+
+UClass* FMcpReflectionIndex::FindClass(const FString& Name, const UClass* RequiredBase)
+{
+    auto Filter = [RequiredBase](const UClass* Class)
+    {
+        return !RequiredBase || Class->IsChildOf(RequiredBase);
+    };
+    if (Name.IsEmpty())
+    {
+        return nullptr;
+    }
+    if (Name.StartsWith(TEXT("/")))
+    {
+        UClass* Found = FindObject<UClass>(nullptr, *Name);
+        return Found && Filter(Found) ? Found : nullptr;
+    }
+
+    FScopeLock Lock(&Mutex);
+    EnsureTypesBuilt();
+    return McpLookupType<UClass>(Classes, Name, Filter);
+}
+
+UScriptStruct* FMcpReflectionIndex::FindStruct(const FString& Name)
+{
+    if (Name.IsEmpty())
+    {
+        return nullptr;
+    }
+    if (Name.StartsWith(TEXT("/")))
+    {
+        return FindObject<UScriptStruct>(nullptr, *Name);
+    }
+
+    FScopeLock Lock(&Mutex);
+    EnsureTypesBuilt();
+    return McpLookupType<UScriptStruct>(Structs, Name, [](const UScriptStruct*) { return true; });
+}
+
+UEnum* FMcpReflectionIndex::FindEnum(const FString& Name)
+{
+    if (Name.IsEmpty())
+    {
+        return nullptr;
+    }
+    if (Name.StartsWith(TEXT("/")))
+    {
+        return FindObject<UEnum>(nullptr, *Name);
+    }
+
+    FScopeLock Lock(&Mutex);
+    EnsureTypesBuilt();
+    return McpLookupType<UEnum>(Enums, Name, [](const UEnum*) { return true; });
+}
+
+UFunction* FMcpReflectionIndex::FindFunction(const FString& Name)
+{
+    if (Name.IsEmpty())
+    {
+        return nullptr;
+    }
+    if (Name.StartsWith(TEXT("/")))
+    {
+        return FindObject<UFunction>(nullptr, *Name);
+    }
+
+    FString Owner;
+    FString Short;
+    McpSplitQualifiedName(Name, Owner, Short);
+    if (!Owner.IsEmpty())
+    {
+        UClass* OwnerClass = FindClass(Owner);
+        // Like the bucket lookups, FNAME_Find keeps caller input out of the name table.
+        const FName FunctionName(*Short, FNAME_Find);
+        return OwnerClass && !FunctionName.IsNone() ? OwnerClass->FindFunctionByName(FunctionName) : nullptr;
+    }
+
+    FScopeLock Lock(&Mutex);
+    EnsureFunctionsBuilt();
+    // Library helpers (static + BlueprintCallable) are what an unqualified name almost
+    // always means; fall back to any callable, then to anything with that name.
+    const EFunctionFlags Passes[] = {FUNC_Static | FUNC_BlueprintCallable, FUNC_BlueprintCallable, FUNC_None};
+    for (const EFunctionFlags Required : Passes)
+    {
+        auto HasFlags = [Required](const UFunction* Function)
+        {
+            return Function->HasAllFunctionFlags(Required);
+        };
+        if (UFunction* Found = McpFindInBucket<UFunction>(Functions, Short, HasFlags))
+        {
+            return Found;
+        }
+    }
+    return nullptr;
+}
+
+void FMcpReflectionIndex::GetDerivedClasses(const UClass* Base, TArray<UClass*>& OutClasses, bool bIncludeAbstract)
+{
+    OutClasses.Reset();
+    if (!Base)
+    {
+        return;
+    }
+    TArray<UClass*> Derived;
+    ::GetDerivedClasses(Base, Derived, true);
+    for (UClass* Class : Derived)
+    {
+        if (McpIsLiveType(Class) && !Class->HasAnyClassFlags(CLASS_NewerVersionExists) &&
+            (bIncludeAbstract || !Class->HasAnyClassFlags(CLASS_Abstract)) && !McpIsShadowTypeName(Class->GetName()))
+        {
+            OutClasses.Add(Class);
+        }
+    }
+    OutClasses.Sort([](const UClass& A, const UClass& B)
+    {
+        return A.GetName() < B.GetName();
+    });
+}
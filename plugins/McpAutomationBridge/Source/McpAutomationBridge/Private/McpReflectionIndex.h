@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UBlueprint;
+class UClass;
+class UEnum;
+class UFunction;
+class UScriptStruct;
+
+/**
+ * Name index over reflected types, built once instead of walking every UClass
+ * per lookup.
+ *
+ * Classes, script structs and enums are keyed by their short FName, so lookups
+ * are case-insensitive hash hits. Lookup accepts:
+ *  - full object paths ("/Script/Engine.StaticMeshComponent", "/Game/BP.BP_C")
+ *  - short names ("StaticMeshComponent")
+ *  - package-qualified names ("Engine.StaticMeshComponent")
+ *  - C++ prefixed names ("UStaticMeshComponent", "AActor", "FVector")
+ * Native (compiled-in) types win over blueprint/user types with the same name.
+ * Functions get their own index, built on first use, and also accept
+ * "Class.Function" / "Class::Function".
+ *
+ * The index is rebuilt lazily after a module load or unload, a hot reload or
+ * live coding patch. Assets loaded in the meantime (blueprint classes, user
+ * structs and enums) are added incrementally, and a blueprint compile
+ * replaces only that blueprint's generated class and its functions.
+ * Entries are weak, so a type collected since the last rebuild is skipped
+ * rather than returned.
+ */
+class FMcpReflectionIndex
+{
+public:
+    static FMcpReflectionIndex& Get();
+
+    /** Binds the invalidation delegates. Called from the subsystem's Initialize. */
+    void Startup();
+    /** Unbinds the delegates and frees the index. */
+    void Shutdown();
+
+    /** Resolves a class; with RequiredBase, only subclasses of it are considered. */
+    UClass* FindClass(const FString& Name, const UClass* RequiredBase = nullptr);
+    UScriptStruct* FindStruct(const FString& Name);
+    UEnum* FindEnum(const FString& Name);
+    /** Unqualified names prefer static BlueprintCallable library functions. */
+    UFunction* FindFunction(const FString& Name);
+
+    /**
+     * Loaded subclasses of Base (not Base itself) from the engine's class
+     * hierarchy hash, minus skeleton/reinstanced classes, sorted by name.
+     */
+    static void GetDerivedClasses(const UClass* Base, TArray<UClass*>& OutClasses, bool bIncludeAbstract = false);
+
+    /** Drops the index; the next lookup rebuilds it. */
+    void Invalidate();
+
+private:
+    template <typename T>
+    using TBucketMap = TMap<FName, TArray<TWeakObjectPtr<T>, TInlineAllocator<1>>>;
+
+    void EnsureTypesBuilt();
+    void EnsureFunctionsBuilt();
+    void AddType(UObject* Object);
+    /** Adds a type, and a class's own functions, to whichever indexes are built. */
+    void AddLoadedType(UObject* Type);
+    void ReplaceClass(UClass* Class);
+    void HandleAssetLoaded(UObject* Asset);
+    void HandleBlueprintPreCompile(UBlueprint* Blueprint);
+    void HandleBlueprintCompiled();
+
+    FCriticalSection Mutex;
+    bool bTypesBuilt = false;
+    bool bFunctionsBuilt = false;
+    TBucketMap<UClass> Classes;
+    TBucketMap<UScriptStruct> Structs;
+    TBucketMap<UEnum> Enums;
+    TBucketMap<UFunction> Functions;
+    /** Blueprints seen by OnBlueprintPreCompile, replaced once OnBlueprintCompiled fires. */
+    TArray<TWeakObjectPtr<UBlueprint>> CompilingBlueprints;
+
+    FDelegateHandle ModulesChangedHandle;
+    FDelegateHandle ReloadCompleteHandle;
+    FDelegateHandle AssetLoadedHandle;
+    FDelegateHandle BlueprintPreCompileHandle;
+    FDelegateHandle BlueprintCompiledHandle;
+};
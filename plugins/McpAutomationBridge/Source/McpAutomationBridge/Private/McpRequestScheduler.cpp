@@ -0,0 +1,314 @@
+#include "McpRequestScheduler.h"
+
+#include "HAL/PlatformTime.h"
+#include "McpAutomationBridgeHelpers.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    /** Compact a client FIFO once this many consumed entries have piled up at its front. */
+    constexpr int32 McpSchedulerCompactThreshold = 64;
+
+    /** Action or subAction names that always go to the bulk lane (in addition to bulk_* / batch_*). */
+    const TCHAR* const McpBulkActions[] = {
+        TEXT("fixup_redirectors"),
+        TEXT("generate_report"),
+        TEXT("paint_foliage"),
+        TEXT("import_asset"),
+        TEXT("rebuild_nanite"),
+        TEXT("nanite_rebuild_mesh"),
+        TEXT("generate_lods"),
+    };
+
+    /** Names that go to the background lane unless the payload says otherwise. */
+    const TCHAR* const McpBackgroundActions[] = {
+        TEXT("generate_thumbnail"),
+        TEXT("export_snapshot"),
+    };
+
+    bool McpIsBulkName(const FString& Name)
+    {
+        if (Name.StartsWith(TEXT("bulk_")) || Name.StartsWith(TEXT("batch_")))
+        {
+            return true;
+        }
+        for (const TCHAR* Bulk : McpBulkActions)
+        {
+            if (Name == Bulk)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool McpIsBackgroundName(const FString& Name)
+    {
+        for (const TCHAR* Background : McpBackgroundActions)
+        {
+            if (Name == Background)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+FMcpRequestScheduler::FMcpRequestScheduler()
+{
+    AgingSeconds[(int32)EMcpRequestPriority::Bulk] = 2.0;
+    AgingSeconds[(int32)EMcpRequestPriority::Background] = 10.0;
+}
+
+EMcpRequestPriority FMcpRequestScheduler::Classify(const FString& Action, const TSharedPtr<FJsonObject>& Payload)
+{
+    const FString Explicit = GetJsonStringField(Payload, TEXT("priority")).ToLower();
+    if (Explicit == TEXT("interactive"))
+    {
+        return EMcpRequestPriority::Interactive;
+    }
+    if (Explicit == TEXT("bulk"))
+    {
+        return EMcpRequestPriority::Bulk;
+    }
+    if (Explicit == TEXT("background"))
+    {
+        return EMcpRequestPriority::Background;
+    }
+
+    const FString LowerAction = Action.ToLower();
+    const FString LowerSub = GetJsonStringField(Payload, TEXT("subAction")).ToLower();
+    if (McpIsBulkName(LowerAction) || McpIsBulkName(LowerSub))
+    {
+        return EMcpRequestPriority::Bulk;
+    }
+    if (McpIsBackgroundName(LowerAction) || McpIsBackgroundName(LowerSub))
+    {
+        return EMcpRequestPriority::Background;
+    }
+    return EMcpRequestPriority::Interactive;
+}
+
+const TCHAR* FMcpRequestScheduler::PriorityName(EMcpRequestPriority Priority)
+{
+    switch (Priority)
+    {
+    case EMcpRequestPriority::Interactive:
+        return TEXT("interactive");
+    case EMcpRequestPriority::Bulk:
+        return TEXT("bulk");
+    case EMcpRequestPriority::Background:
+        return TEXT("background");
+    default:
+        return TEXT("unknown");
+    }
+}
+
+void FMcpRequestScheduler::SetAgingSeconds(EMcpRequestPriority Priority, double Seconds)
+{
+    FScopeLock Lock(&Mutex);
+    AgingSeconds[(int32)Priority] = Seconds;
+}
+
+void FMcpRequestScheduler::Enqueue(FMcpScheduledRequest&& Request)
+{
+    Request.EnqueueSeconds = FPlatformTime::Seconds();
+    const FMcpBridgeWebSocket* Client = Request.Socket.Get();
+    const int32 LaneIndex = (int32)Request.Priority;
+
+    FScopeLock Lock(&Mutex);
+
+    FClientStats* Stats = ClientStats.Find(Client);
+    if (!Stats)
+    {
+        Stats = &ClientStats.Add(Client);
+        Stats->Label = Client ? FString::Printf(TEXT("client-%d"), NextClientIndex++) : TEXT("internal");
+        Stats->Socket = Request.Socket;
+    }
+    Stats->Depth[LaneIndex]++;
+    Stats->Enqueued++;
+
+    FLane& Lane = Lanes[LaneIndex];
+    FClientQueue* Queue = Lane.Clients.FindByPredicate([Client](const FClientQueue& Candidate)
+    {
+        return Candidate.Client == Client;
+    });
+    if (!Queue)
+    {
+        Queue = &Lane.Clients.AddDefaulted_GetRef();
+        Queue->Client = Client;
+    }
+    Queue->Items.Add(MoveTemp(Request));
+    Lane.Count++;
+    TotalQueued++;
+}
+
+double FMcpRequestScheduler::OldestEnqueueSeconds(const FLane& Lane) const
+{
+    double Oldest = TNumericLimits<double>::Max();
+    for (const FClientQueue& Queue : Lane.Clients)
+    {
+        if (Queue.Num() > 0)
+        {
+            Oldest = FMath::Min(Oldest, Queue.Items[Queue.Head].EnqueueSeconds);
+        }
+    }
+    return Oldest;
+}
+
+bool FMcpRequestScheduler::DequeueFromLane(FLane& Lane, FMcpScheduledRequest& OutRequest)
+{
+    if (Lane.Count == 0 || Lane.Clients.Num() == 0)
+    {
+        return false;
+    }
+
+    // Empty client queues are removed eagerly, so the cursor always lands on work.
+    Lane.Cursor %= Lane.Clients.Num();
+    FClientQueue& Queue = Lane.Clients[Lane.Cursor];
+    OutRequest = MoveTemp(Queue.Items[Queue.Head++]);
+    Lane.Count--;
+
+    if (Queue.Num() == 0)
+    {
+        Lane.Clients.RemoveAt(Lane.Cursor);
+    }
+    else
+    {
+        if (Queue.Head >= McpSchedulerCompactThreshold && Queue.Head * 2 >= Queue.Items.Num())
+        {
+            Queue.Items.RemoveAt(0, Queue.Head);
+            Queue.Head = 0;
+        }
+        ++Lane.Cursor;
+    }
+    return true;
+}
+
+bool FMcpRequestScheduler::Dequeue(FMcpScheduledRequest& OutRequest)
+{
+    FScopeLock Lock(&Mutex);
+    if (TotalQueued == 0)
+    {
+        return false;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+
+    // Aged lower lanes first (oldest-waiting lane wins), then strict priority.
+    int32 LaneIndex = INDEX_NONE;
+    double LongestOverdue = 0.0;
+    for (int32 Index = 1; Index < (int32)EMcpRequestPriority::Count; ++Index)
+    {
+        if (Lanes[Index].Count == 0 || AgingSeconds[Index] <= 0.0)
+        {
+            continue;
+        }
+        const double Overdue = (Now - OldestEnqueueSeconds(Lanes[Index])) - AgingSeconds[Index];
+        if (Overdue > LongestOverdue)
+        {
+            LongestOverdue = Overdue;
+            LaneIndex = Index;
+        }
+    }
+    if (LaneIndex == INDEX_NONE)
+    {
+        for (int32 Index = 0; Index < (int32)EMcpRequestPriority::Count; ++Index)
+        {
+            if (Lanes[Index].Count > 0)
+            {
+                LaneIndex = Index;
+                break;
+            }
+        }
+    }
+    if (LaneIndex == INDEX_NONE || !DequeueFromLane(Lanes[LaneIndex], OutRequest))
+    {
+        return false;
+    }
+    TotalQueued--;
+
+    const double WaitMs = (Now - OutRequest.EnqueueSeconds) * 1000.0;
+    if (FClientStats* Stats = ClientStats.Find(OutRequest.Socket.Get()))
+    {
+        Stats->Depth[LaneIndex]--;
+        Stats->Dispatched++;
+        Stats->TotalWaitMs += WaitMs;
+        Stats->MaxWaitMs = FMath::Max(Stats->MaxWaitMs, WaitMs);
+        Stats->LastWaitMs = WaitMs;
+    }
+    if (TotalQueued == 0)
+    {
+        PruneClientStats();
+    }
+    return true;
+}
+
+void FMcpRequestScheduler::PruneClientStats()
+{
+    for (auto It = ClientStats.CreateIterator(); It; ++It)
+    {
+        if (It.Key() != nullptr && !It.Value().Socket.IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+int32 FMcpRequestScheduler::Num() const
+{
+    FScopeLock Lock(&Mutex);
+    return TotalQueued;
+}
+
+TSharedPtr<FJsonObject> FMcpRequestScheduler::GetStatsJson() const
+{
+    FScopeLock Lock(&Mutex);
+    const double Now = FPlatformTime::Seconds();
+
+    TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetNumberField(TEXT("queued"), TotalQueued);
+
+    TSharedPtr<FJsonObject> LaneJson = MakeShared<FJsonObject>();
+    for (int32 Index = 0; Index < (int32)EMcpRequestPriority::Count; ++Index)
+    {
+        TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetNumberField(TEXT("depth"), Lanes[Index].Count);
+        Entry->SetNumberField(TEXT("clients"), Lanes[Index].Clients.Num());
+        Entry->SetNumberField(TEXT("agingSeconds"), AgingSeconds[Index]);
+        if (Lanes[Index].Count > 0)
+        {
+            Entry->SetNumberField(TEXT("oldestWaitMs"), (Now - OldestEnqueueSeconds(Lanes[Index])) * 1000.0);
+        }
+        LaneJson->SetObjectField(PriorityName((EMcpRequestPriority)Index), Entry);
+    }
+    Json->SetObjectField(TEXT("lanes"), LaneJson);
+
+    TArray<TSharedPtr<FJsonValue>> Clients;
+    for (const TPair<const FMcpBridgeWebSocket*, FClientStats>& Pair : ClientStats)
+    {
+        const FClientStats& Stats = Pair.Value;
+        TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetStringField(TEXT("client"), Stats.Label);
+        Entry->SetBoolField(TEXT("connected"), Pair.Key == nullptr || Stats.Socket.IsValid());
+
+        TSharedPtr<FJsonObject> Depth = MakeShared<FJsonObject>();
+        int32 TotalDepth = 0;
+        for (int32 Index = 0; Index < (int32)EMcpRequestPriority::Count; ++Index)
+        {
+            Depth->SetNumberField(PriorityName((EMcpRequestPriority)Index), Stats.Depth[Index]);
+            TotalDepth += Stats.Depth[Index];
+        }
+        Entry->SetObjectField(TEXT("depth"), Depth);
+        Entry->SetNumberField(TEXT("queued"), TotalDepth);
+        Entry->SetNumberField(TEXT("enqueued"), (double)Stats.Enqueued);
+        Entry->SetNumberField(TEXT("dispatched"), (double)Stats.Dispatched);
+        Entry->SetNumberField(TEXT("avgWaitMs"), Stats.Dispatched > 0 ? Stats.TotalWaitMs / Stats.Dispatched : 0.0);
+        Entry->SetNumberField(TEXT("maxWaitMs"), Stats.MaxWaitMs);
+        Entry->SetNumberField(TEXT("lastWaitMs"), Stats.LastWaitMs);
+        Clients.Add(MakeShared<FJsonValueObject>(Entry));
+    }
+    Json->SetArrayField(TEXT("clients"), Clients);
+    return Json;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+
+class FMcpBridgeWebSocket;
+
+/** Scheduling class of an automation request. Lower values are served first. */
+enum class EMcpRequestPriority : uint8
+{
+    /** Single-object reads and edits an agent is waiting on. */
+    Interactive,
+    /** bulk_* / batch_* style operations over many assets or actors. */
+    Bulk,
+    /** Work nobody is blocked on (thumbnails, reports, cache warmups). */
+    Background,
+    Count
+};
+
+struct FMcpScheduledRequest
+{
+    FString RequestId;
+    FString Action;
+    TSharedPtr<FJsonObject> Payload;
+    TSharedPtr<FMcpBridgeWebSocket> Socket;
+    EMcpRequestPriority Priority = EMcpRequestPriority::Interactive;
+    double EnqueueSeconds = 0.0;
+};
+
+/**
+ * Pending automation request queue.
+ *
+ * Requests are split into priority lanes and, inside each lane, into one FIFO per client
+ * socket. Dequeue serves the highest non-empty lane and round-robins across that lane's
+ * clients, so one client's 500-request bulk job cannot starve another client's interactive
+ * calls. Lower lanes age: once their oldest request has waited longer than the lane's aging
+ * threshold it is served ahead of higher lanes, so bulk and background work still makes
+ * progress under a steady interactive load.
+ *
+ * Enqueue is safe from any thread; everything else is expected on the game thread but is
+ * locked as well so stats can be read from anywhere.
+ */
+class FMcpRequestScheduler
+{
+public:
+    FMcpRequestScheduler();
+
+    /** Pick a lane from an explicit payload "priority" field, else from the action / subAction name. */
+    static EMcpRequestPriority Classify(const FString& Action, const TSharedPtr<FJsonObject>& Payload);
+    static const TCHAR* PriorityName(EMcpRequestPriority Priority);
+
+    /** Wait after which the oldest request of a lane jumps ahead of higher lanes. <= 0 disables aging. */
+    void SetAgingSeconds(EMcpRequestPriority Priority, double Seconds);
+
+    void Enqueue(FMcpScheduledRequest&& Request);
+    bool Dequeue(FMcpScheduledRequest& OutRequest);
+
+    int32 Num() const;
+
+    /** Per-client and per-lane queue depth and wait-time metrics. */
+    TSharedPtr<FJsonObject> GetStatsJson() const;
+
+private:
+    struct FClientQueue
+    {
+        const FMcpBridgeWebSocket* Client = nullptr;
+        TArray<FMcpScheduledRequest> Items;
+        int32 Head = 0;
+
+        int32 Num() const { return Items.Num() - Head; }
+    };
+
+    struct FLane
+    {
+        TArray<FClientQueue> Clients;
+        int32 Cursor = 0;
+        int32 Count = 0;
+    };
+
+    struct FClientStats
+    {
+        FString Label;
+        TWeakPtr<FMcpBridgeWebSocket> Socket;
+        int32 Depth[(int32)EMcpRequestPriority::Count] = {};
+        int64 Enqueued = 0;
+        int64 Dispatched = 0;
+        double TotalWaitMs = 0.0;
+        double MaxWaitMs = 0.0;
+        double LastWaitMs = 0.0;
+    };
+
+    bool DequeueFromLane(FLane& Lane, FMcpScheduledRequest& OutRequest);
+    double OldestEnqueueSeconds(const FLane& Lane) const;
+    void PruneClientStats();
+
+    mutable FCriticalSection Mutex;
+    FLane Lanes[(int32)EMcpRequestPriority::Count];
+    double AgingSeconds[(int32)EMcpRequestPriority::Count] = {};
+    TMap<const FMcpBridgeWebSocket*, FClientStats> ClientStats;
+    int32 NextClientIndex = 1;
+    int32 TotalQueued = 0;
+};
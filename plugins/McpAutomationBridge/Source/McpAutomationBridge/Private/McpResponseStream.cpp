@@ -0,0 +1,129 @@
+#include "McpResponseStream.h"
+
+#include "McpAutomationBridgeSubsystem.h"
+#include "McpAutomationBridgeGlobals.h"
+#include "McpAutomationBridgeHelpers.h"
+#include "McpConnectionManager.h"
+
+namespace
+{
+    /** Default and upper bound for the client-supplied chunkSize. */
+    constexpr int32 McpDefaultStreamChunkSize = 256;
+    constexpr int32 McpMaxStreamChunkSize = 4096;
+}
+
+FMcpResponseStream::FMcpResponseStream(TSharedPtr<FMcpConnectionManager> InConnection, const FString& InRequestId,
+                                       TSharedPtr<FMcpBridgeWebSocket> InSocket, const FString& InField, int32 InChunkSize)
+    : Connection(InConnection)
+    , RequestId(InRequestId)
+    , Socket(InSocket)
+    , Field(InField)
+    , ChunkSize(FMath::Clamp(InChunkSize, 1, McpMaxStreamChunkSize))
+{
+    Buffer.Reserve(ChunkSize);
+}
+
+bool FMcpResponseStream::CheckCancelled()
+{
+    if (!bCancelled && Connection.IsValid() && Connection->IsStreamCancelled(RequestId))
+    {
+        bCancelled = true;
+        bStopped = true;
+    }
+    return bCancelled;
+}
+
+bool FMcpResponseStream::Add(const TSharedPtr<FJsonValue>& Item)
+{
+    if (bStopped)
+    {
+        return false;
+    }
+    Buffer.Add(Item);
+    ++NumItems;
+    return Buffer.Num() < ChunkSize || Flush();
+}
+
+bool FMcpResponseStream::Flush()
+{
+    if (bStopped || CheckCancelled())
+    {
+        Buffer.Reset();
+        return false;
+    }
+    if (Buffer.Num() == 0)
+    {
+        return true;
+    }
+    if (!Connection.IsValid() || !Connection->SendResponseChunk(Socket, RequestId, NextSequence, Field, Buffer))
+    {
+        UE_LOG(LogMcpAutomationBridgeSubsystem, Warning, TEXT("Stream %s: chunk %d could not be delivered, stopping"),
+               *RequestId, NextSequence);
+        bStopped = true;
+    }
+    else
+    {
+        NumDelivered += Buffer.Num();
+    }
+    ++NextSequence;
+    Buffer.Reset();
+    return !bStopped;
+}
+
+void FMcpResponseStream::Close(const TSharedPtr<FJsonObject>& Result)
+{
+    Flush();
+    if (!Result.IsValid())
+    {
+        return;
+    }
+    TSharedPtr<FJsonObject> Info = MakeShared<FJsonObject>();
+    Info->SetStringField(TEXT("field"), Field);
+    Info->SetNumberField(TEXT("chunks"), NextSequence);
+    Info->SetNumberField(TEXT("items"), NumItems);
+    Info->SetNumberField(TEXT("delivered"), NumDelivered);
+    Info->SetNumberField(TEXT("chunkSize"), ChunkSize);
+    Info->SetBoolField(TEXT("cancelled"), bCancelled);
+    Result->SetObjectField(TEXT("stream"), Info);
+}
+
+TSharedPtr<FMcpResponseStream> UMcpAutomationBridgeSubsystem::BeginResponseStream(
+    const FString& RequestId, const TSharedPtr<FJsonObject>& Payload, TSharedPtr<FMcpBridgeWebSocket> RequestingSocket,
+    const FString& Field)
+{
+    if (!ConnectionManager.IsValid() || !GetJsonBoolField(Payload, TEXT("stream"), false))
+    {
+        return nullptr;
+    }
+    // Batch items answer into the aggregated batch response, not the socket.
+    if (IsInGameThread() && BatchItemOwners.Contains(RequestId))
+    {
+        return nullptr;
+    }
+    const int32 ChunkSize = (int32)GetJsonNumberField(Payload, TEXT("chunkSize"), McpDefaultStreamChunkSize);
+    return MakeShared<FMcpResponseStream>(ConnectionManager, RequestId, RequestingSocket, Field, ChunkSize);
+}
+
+void UMcpAutomationBridgeSubsystem::FinishResponseStream(
+    const TSharedPtr<FMcpResponseStream>& Stream, TSharedPtr<FMcpBridgeWebSocket> RequestingSocket,
+    const FString& RequestId, const FString& Message, const TSharedPtr<FJsonObject>& Result)
+{
+    Stream->Close(Result);
+    if (Stream->WasCancelled())
+    {
+        SendAutomationResponse(RequestingSocket, RequestId, false,
+                               FString::Printf(TEXT("Stream cancelled by client after %d item(s)"), Stream->GetNumItems()),
+                               Result, TEXT("CANCELLED"));
+        return;
+    }
+    if (Stream->IsStopped())
+    {
+        // A chunk went missing; the items the client holds are incomplete.
+        SendAutomationResponse(RequestingSocket, RequestId, false,
+                               FString::Printf(TEXT("Stream stopped: %d of %d item(s) delivered"),
+                                               Stream->GetNumDelivered(), Stream->GetNumItems()),
+                               Result, TEXT("STREAM_DELIVERY_FAILED"));
+        return;
+    }
+    SendAutomationResponse(RequestingSocket, RequestId, true, Message, Result);
+}
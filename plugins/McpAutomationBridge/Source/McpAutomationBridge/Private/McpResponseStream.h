@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+class FMcpBridgeWebSocket;
+class FMcpConnectionManager;
+
+/**
+ * Incremental delivery of one large array in a response.
+ *
+ * Instead of collecting every element into one FJsonObject and one frame, a
+ * handler adds elements as it iterates; every ChunkSize elements go out as an
+ * automation_response_chunk {requestId, seq, field, items}. The terminator is
+ * the ordinary automation_response, whose result carries the summary fields
+ * and "stream": {field, chunks, items, delivered, cancelled}. Only one chunk is buffered
+ * at a time and WebSocket sends block, so memory stays bounded by the chunk.
+ *
+ * Clients opt in with "stream": true (and optionally "chunkSize") in the
+ * request payload and may send {type: "cancel_stream", requestId} at any time;
+ * Add then returns false and the terminator fails with CANCELLED. A chunk
+ * that cannot be delivered stops the stream the same way; the terminator
+ * then fails with STREAM_DELIVERY_FAILED.
+ *
+ * Created through UMcpAutomationBridgeSubsystem::BeginResponseStream. Safe to
+ * use from a worker-dispatched handler.
+ */
+class FMcpResponseStream
+{
+public:
+    FMcpResponseStream(TSharedPtr<FMcpConnectionManager> InConnection, const FString& InRequestId,
+                       TSharedPtr<FMcpBridgeWebSocket> InSocket, const FString& InField, int32 InChunkSize);
+
+    /** Buffers one element, sending a chunk when full. Returns false once cancelled or disconnected. */
+    bool Add(const TSharedPtr<FJsonValue>& Item);
+    bool Add(const TSharedPtr<FJsonObject>& Item) { return Add(MakeShared<FJsonValueObject>(Item)); }
+
+    /** Sends any buffered elements. */
+    bool Flush();
+
+    bool IsStopped() const { return bStopped; }
+    bool WasCancelled() const { return bCancelled; }
+    int32 GetNumItems() const { return NumItems; }
+    /** Elements in chunks that were sent. */
+    int32 GetNumDelivered() const { return NumDelivered; }
+
+    /** Flushes and adds the "stream" summary object to the terminator's result. */
+    void Close(const TSharedPtr<FJsonObject>& Result);
+
+private:
+    bool CheckCancelled();
+
+    TSharedPtr<FMcpConnectionManager> Connection;
+    FString RequestId;
+    TSharedPtr<FMcpBridgeWebSocket> Socket;
+    FString Field;
+    int32 ChunkSize = 256;
+
+    TArray<TSharedPtr<FJsonValue>> Buffer;
+    int32 NextSequence = 0;
+    int32 NumItems = 0;
+    int32 NumDelivered = 0;
+    bool bStopped = false;
+    bool bCancelled = false;
+};
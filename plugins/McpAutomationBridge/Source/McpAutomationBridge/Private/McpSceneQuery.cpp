@@ -0,0 +1,1199 @@
+#include "McpSceneQuery.h"
+
+#include "Components/ActorComponent.h"
+#include "Components/SceneComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "McpAutomationBridgeHelpers.h"
+#include "McpReflectionIndex.h"
+#include "Misc/Base64.h"
+#include "Misc/PackageName.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_EDITOR
+#include "Editor.h"
+#include "WorldPartition/DataLayer/DataLayerInstance.h"
+#if __has_include("Subsystems/UnrealEditorSubsystem.h")
+#include "Subsystems/UnrealEditorSubsystem.h"
+#define MCP_SCENE_QUERY_HAS_VIEWPORT_CAMERA 1
+#elif __has_include("UnrealEditorSubsystem.h")
+#include "UnrealEditorSubsystem.h"
+#define MCP_SCENE_QUERY_HAS_VIEWPORT_CAMERA 1
+#endif
+#endif
+
+#ifndef MCP_SCENE_QUERY_HAS_VIEWPORT_CAMERA
+#define MCP_SCENE_QUERY_HAS_VIEWPORT_CAMERA 0
+#endif
+
+namespace
+{
+    /** Grid cell edge in cm. A 5 m radius query touches at most eight cells. */
+    constexpr double McpSpatialCellSize = 2000.0;
+    /** Actors spanning more cells than this go to the oversized list. */
+    constexpr int64 McpMaxCellsPerActor = 64;
+    constexpr int32 McpDefaultQueryLimit = 500;
+
+    FBox McpGetActorBounds(const AActor* Actor)
+    {
+        FBox Bounds = Actor->GetComponentsBoundingBox(true);
+        if (!Bounds.IsValid)
+        {
+            // Components without render/collision bounds (empty actors, pure logic actors).
+            const FVector Location = Actor->GetActorLocation();
+            Bounds = FBox(Location, Location);
+        }
+        return Bounds;
+    }
+
+    bool McpIsQueryableActor(const AActor* Actor)
+    {
+        return IsValid(Actor) && !Actor->IsTemplate() && Actor->GetWorld() != nullptr;
+    }
+
+    FString McpJsonValueToString(const TSharedPtr<FJsonValue>& Value)
+    {
+        if (!Value.IsValid())
+        {
+            return FString();
+        }
+        switch (Value->Type)
+        {
+        case EJson::String:
+            return Value->AsString();
+        case EJson::Number:
+            return FString::SanitizeFloat(Value->AsNumber());
+        case EJson::Boolean:
+            return Value->AsBool() ? TEXT("true") : TEXT("false");
+        case EJson::Null:
+        case EJson::None:
+            return FString();
+        default:
+            break;
+        }
+        FString Out;
+        const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+            TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Out);
+        FJsonSerializer::Serialize(Value, FString(), Writer);
+        return Out;
+    }
+
+    /** Case-insensitive; enum values also match their unqualified name ("Movable" for "EComponentMobility::Movable"). */
+    bool McpStringValueEquals(const FString& Actual, const FString& Expected)
+    {
+        if (Actual.Equals(Expected, ESearchCase::IgnoreCase))
+        {
+            return true;
+        }
+        int32 Separator = INDEX_NONE;
+        if (Actual.FindLastChar(TEXT(':'), Separator))
+        {
+            return Actual.Mid(Separator + 1).Equals(Expected, ESearchCase::IgnoreCase);
+        }
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> McpVectorJson(const FVector& V)
+    {
+        TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+        Obj->SetNumberField(TEXT("x"), V.X);
+        Obj->SetNumberField(TEXT("y"), V.Y);
+        Obj->SetNumberField(TEXT("z"), V.Z);
+        return Obj;
+    }
+
+    /** Reads {min, max} as a box; false when either corner is missing. */
+    bool McpReadBox(const TSharedPtr<FJsonObject>& Obj, FBox& OutBox)
+    {
+        if (!Obj.IsValid() || !Obj->HasField(TEXT("min")) || !Obj->HasField(TEXT("max")))
+        {
+            return false;
+        }
+        const FVector Min = ExtractVectorField(Obj, TEXT("min"), FVector::ZeroVector);
+        const FVector Max = ExtractVectorField(Obj, TEXT("max"), FVector::ZeroVector);
+        OutBox = FBox(Min.ComponentMin(Max), Min.ComponentMax(Max));
+        return true;
+    }
+
+    struct FMcpQueryMatch
+    {
+        AActor* Actor = nullptr;
+        FBox Bounds = FBox(ForceInit);
+        double Distance = 0.0;
+        FString Key;
+    };
+}
+
+// ---------------------------------------------------------------------------
+// FMcpActorSpatialIndex
+// ---------------------------------------------------------------------------
+
+FMcpActorSpatialIndex& FMcpActorSpatialIndex::Get()
+{
+    static FMcpActorSpatialIndex Instance;
+    return Instance;
+}
+
+void FMcpActorSpatialIndex::Startup()
+{
+    if (GEngine && !ActorAddedHandle.IsValid())
+    {
+        ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FMcpActorSpatialIndex::HandleActorChanged);
+        ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FMcpActorSpatialIndex::HandleActorDeleted);
+#if WITH_EDITOR
+        ActorMovedHandle = GEngine->OnActorMoved().AddRaw(this, &FMcpActorSpatialIndex::HandleActorChanged);
+#endif
+    }
+#if WITH_EDITOR
+    if (!PropertyChangedHandle.IsValid())
+    {
+        PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(
+            this, &FMcpActorSpatialIndex::HandleObjectPropertyChanged);
+    }
+    if (!UndoRedoHandle.IsValid())
+    {
+        // Undo restores transforms without move notifications.
+        UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FMcpActorSpatialIndex::Invalidate);
+    }
+    if (!MapChangeHandle.IsValid())
+    {
+        MapChangeHandle = FEditorDelegates::MapChange.AddLambda([this](uint32)
+        {
+            Invalidate();
+        });
+    }
+#endif
+    if (!WorldCleanupHandle.IsValid())
+    {
+        WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddLambda([this](UWorld* World, bool, bool)
+        {
+            if (IndexedWorld.Get() == World)
+            {
+                Invalidate();
+            }
+        });
+    }
+}
+
+void FMcpActorSpatialIndex::Shutdown()
+{
+    if (ActorAddedHandle.IsValid())
+    {
+        if (GEngine)
+        {
+            GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+            GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+#if WITH_EDITOR
+            GEngine->OnActorMoved().Remove(ActorMovedHandle);
+#endif
+        }
+        ActorAddedHandle.Reset();
+        ActorDeletedHandle.Reset();
+        ActorMovedHandle.Reset();
+    }
+#if WITH_EDITOR
+    if (PropertyChangedHandle.IsValid())
+    {
+        FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+        PropertyChangedHandle.Reset();
+    }
+    if (UndoRedoHandle.IsValid())
+    {
+        FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+        UndoRedoHandle.Reset();
+    }
+    if (MapChangeHandle.IsValid())
+    {
+        FEditorDelegates::MapChange.Remove(MapChangeHandle);
+        MapChangeHandle.Reset();
+    }
+#endif
+    if (WorldCleanupHandle.IsValid())
+    {
+        FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+        WorldCleanupHandle.Reset();
+    }
+    Invalidate();
+}
+
+void FMcpActorSpatialIndex::Invalidate()
+{
+    for (TPair<TObjectKey<AActor>, FEntry>& Pair : Entries)
+    {
+        Unbind(Pair.Value);
+    }
+    IndexedWorld.Reset();
+    Entries.Empty();
+    Cells.Empty();
+    Oversized.Empty();
+}
+
+bool FMcpActorSpatialIndex::IsBuiltFor(const UWorld* World) const
+{
+    return World && IndexedWorld.Get() == World;
+}
+
+FIntVector FMcpActorSpatialIndex::ToCell(const FVector& Location) const
+{
+    return FIntVector(
+        FMath::FloorToInt32(Location.X / McpSpatialCellSize),
+        FMath::FloorToInt32(Location.Y / McpSpatialCellSize),
+        FMath::FloorToInt32(Location.Z / McpSpatialCellSize));
+}
+
+void FMcpActorSpatialIndex::Build(UWorld* World)
+{
+    Invalidate();
+    IndexedWorld = World;
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        Insert(*It);
+    }
+}
+
+void FMcpActorSpatialIndex::Insert(AActor* Actor)
+{
+    if (!McpIsQueryableActor(Actor))
+    {
+        return;
+    }
+    const TObjectKey<AActor> Key(Actor);
+    FEntry& Entry = Entries.Add(Key);
+    if (USceneComponent* Root = Actor->GetRootComponent())
+    {
+        Entry.Root = Root;
+        Entry.TransformHandle = Root->TransformUpdated.AddLambda(
+            [this](USceneComponent* Component, EUpdateTransformFlags, ETeleportType)
+            {
+                HandleActorChanged(Component ? Component->GetOwner() : nullptr);
+            });
+    }
+    Place(Key, Actor, Entry);
+}
+
+void FMcpActorSpatialIndex::Place(const TObjectKey<AActor>& Key, AActor* Actor, FEntry& Entry)
+{
+    const FBox Bounds = McpGetActorBounds(Actor);
+    Entry.MinCell = ToCell(Bounds.Min);
+    Entry.MaxCell = ToCell(Bounds.Max);
+    const FIntVector Span = Entry.MaxCell - Entry.MinCell + FIntVector(1);
+    Entry.bOversized = int64(Span.X) * Span.Y * Span.Z > McpMaxCellsPerActor;
+    if (Entry.bOversized)
+    {
+        Oversized.Add(Key);
+        return;
+    }
+    for (int32 X = Entry.MinCell.X; X <= Entry.MaxCell.X; ++X)
+    {
+        for (int32 Y = Entry.MinCell.Y; Y <= Entry.MaxCell.Y; ++Y)
+        {
+            for (int32 Z = Entry.MinCell.Z; Z <= Entry.MaxCell.Z; ++Z)
+            {
+                Cells.FindOrAdd(FIntVector(X, Y, Z)).Add(Key);
+            }
+        }
+    }
+}
+
+void FMcpActorSpatialIndex::Remove(AActor* Actor)
+{
+    const TObjectKey<AActor> Key(Actor);
+    FEntry Entry;
+    if (!Entries.RemoveAndCopyValue(Key, Entry))
+    {
+        return;
+    }
+    Unbind(Entry);
+    Unplace(Key, Entry);
+}
+
+void FMcpActorSpatialIndex::Unplace(const TObjectKey<AActor>& Key, const FEntry& Entry)
+{
+    if (Entry.bOversized)
+    {
+        Oversized.Remove(Key);
+        return;
+    }
+    for (int32 X = Entry.MinCell.X; X <= Entry.MaxCell.X; ++X)
+    {
+        for (int32 Y = Entry.MinCell.Y; Y <= Entry.MaxCell.Y; ++Y)
+        {
+            for (int32 Z = Entry.MinCell.Z; Z <= Entry.MaxCell.Z; ++Z)
+            {
+                const FIntVector Cell(X, Y, Z);
+                if (TArray<TObjectKey<AActor>>* Keys = Cells.Find(Cell))
+                {
+                    Keys->RemoveSingleSwap(Key);
+                    if (Keys->Num() == 0)
+                    {
+                        Cells.Remove(Cell);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void FMcpActorSpatialIndex::Unbind(FEntry& Entry)
+{
+    if (USceneComponent* Root = Entry.Root.Get())
+    {
+        Root->TransformUpdated.Remove(Entry.TransformHandle);
+    }
+    Entry.Root.Reset();
+    Entry.TransformHandle.Reset();
+}
+
+void FMcpActorSpatialIndex::Update(AActor* Actor)
+{
+    const TObjectKey<AActor> Key(Actor);
+    FEntry* Entry = Entries.Find(Key);
+    // A new or replaced root component needs a fresh binding.
+    if (!Entry || !McpIsQueryableActor(Actor) || Entry->Root.Get() != Actor->GetRootComponent())
+    {
+        Remove(Actor);
+        Insert(Actor);
+        return;
+    }
+    Unplace(Key, *Entry);
+    Place(Key, Actor, *Entry);
+}
+
+void FMcpActorSpatialIndex::HandleActorChanged(AActor* Actor)
+{
+    if (Actor && IsBuiltFor(Actor->GetWorld()))
+    {
+        Update(Actor);
+    }
+}
+
+void FMcpActorSpatialIndex::HandleActorDeleted(AActor* Actor)
+{
+    if (Actor && IsBuiltFor(Actor->GetWorld()))
+    {
+        Remove(Actor);
+    }
+}
+
+void FMcpActorSpatialIndex::HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent&)
+{
+    if (!IndexedWorld.IsValid())
+    {
+        return;
+    }
+    if (AActor* Actor = Cast<AActor>(Object))
+    {
+        HandleActorChanged(Actor);
+    }
+    else if (USceneComponent* Component = Cast<USceneComponent>(Object))
+    {
+        HandleActorChanged(Component->GetOwner());
+    }
+}
+
+void FMcpActorSpatialIndex::Query(UWorld* World, const FBox& QueryBox, TArray<AActor*>& OutActors)
+{
+    if (!World || !QueryBox.IsValid)
+    {
+        return;
+    }
+    if (!IsBuiltFor(World))
+    {
+        Build(World);
+    }
+
+    TSet<TObjectKey<AActor>> Seen;
+    auto AddKey = [&Seen, &OutActors](const TObjectKey<AActor>& Key)
+    {
+        bool bAlreadySeen = false;
+        Seen.Add(Key, &bAlreadySeen);
+        if (!bAlreadySeen)
+        {
+            if (AActor* Actor = Key.ResolveObjectPtr())
+            {
+                OutActors.Add(Actor);
+            }
+        }
+    };
+
+    for (const TObjectKey<AActor>& Key : Oversized)
+    {
+        AddKey(Key);
+    }
+
+    const FIntVector MinCell = ToCell(QueryBox.Min);
+    const FIntVector MaxCell = ToCell(QueryBox.Max);
+    const FIntVector Span = MaxCell - MinCell + FIntVector(1);
+    if (int64(Span.X) * Span.Y * Span.Z > Cells.Num())
+    {
+        // Query covers more cells than are occupied: walk the occupied ones.
+        for (const TPair<FIntVector, TArray<TObjectKey<AActor>>>& Pair : Cells)
+        {
+            const FIntVector& Cell = Pair.Key;
+            if (Cell.X >= MinCell.X && Cell.X <= MaxCell.X && Cell.Y >= MinCell.Y && Cell.Y <= MaxCell.Y &&
+                Cell.Z >= MinCell.Z && Cell.Z <= MaxCell.Z)
+            {
+                for (const TObjectKey<AActor>& Key : Pair.Value)
+                {
+                    AddKey(Key);
+                }
+            }
+        }
+        return;
+    }
+    for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+    {
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+        {
+            for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+            {
+                if (const TArray<TObjectKey<AActor>>* Keys = Cells.Find(FIntVector(X, Y, Z)))
+                {
+                    for (const TObjectKey<AActor>& Key : *Keys)
+                    {
+                        AddKey(Key);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// FMcpSceneQuery
+// ---------------------------------------------------------------------------
+
+bool FMcpSceneQuery::Parse(const TSharedPtr<FJsonObject>& Payload, FString& OutError, FString& OutErrorCode)
+{
+    OutErrorCode = TEXT("INVALID_ARGUMENT");
+    if (!Payload.IsValid())
+    {
+        return true;
+    }
+
+    FString ClassName = GetJsonStringField(Payload, TEXT("class"));
+    if (ClassName.IsEmpty())
+    {
+        ClassName = GetJsonStringField(Payload, TEXT("className"));
+    }
+    if (!ClassName.IsEmpty())
+    {
+        ActorClass = FMcpReflectionIndex::Get().FindClass(ClassName, AActor::StaticClass());
+        if (!ActorClass)
+        {
+            OutError = FString::Printf(TEXT("Actor class not found: %s"), *ClassName);
+            OutErrorCode = TEXT("CLASS_NOT_FOUND");
+            return false;
+        }
+    }
+    bIncludeSubclasses = GetJsonBoolField(Payload, TEXT("includeSubclasses"), true);
+    ClassPathSubstring = GetJsonStringField(Payload, TEXT("classPathContains"));
+
+    const FString ComponentName = GetJsonStringField(Payload, TEXT("hasComponent"));
+    if (!ComponentName.IsEmpty())
+    {
+        ComponentClass = FMcpReflectionIndex::Get().FindClass(ComponentName, UActorComponent::StaticClass());
+        if (!ComponentClass)
+        {
+            OutError = FString::Printf(TEXT("Component class not found: %s"), *ComponentName);
+            OutErrorCode = TEXT("CLASS_NOT_FOUND");
+            return false;
+        }
+    }
+
+    NamePattern = GetJsonStringField(Payload, TEXT("name"));
+    LabelPattern = GetJsonStringField(Payload, TEXT("label"));
+    FolderPrefix = GetJsonStringField(Payload, TEXT("folder"));
+    DataLayer = GetJsonStringField(Payload, TEXT("dataLayer"));
+    LevelName = GetJsonStringField(Payload, TEXT("level"));
+
+    const TArray<TSharedPtr<FJsonValue>>* TagArray = nullptr;
+    if (Payload->TryGetArrayField(TEXT("tags"), TagArray))
+    {
+        for (const TSharedPtr<FJsonValue>& Tag : *TagArray)
+        {
+            if (Tag.IsValid() && !Tag->AsString().IsEmpty())
+            {
+                Tags.Add(FName(*Tag->AsString()));
+            }
+        }
+    }
+    else
+    {
+        const FString Tag = GetJsonStringField(Payload, TEXT("tag"));
+        if (!Tag.IsEmpty())
+        {
+            Tags.Add(FName(*Tag));
+        }
+    }
+    bAllTags = GetJsonStringField(Payload, TEXT("tagMatch")).Equals(TEXT("all"), ESearchCase::IgnoreCase);
+
+    const TSharedPtr<FJsonObject>* BoundsObj = nullptr;
+    if (Payload->TryGetObjectField(TEXT("bounds"), BoundsObj))
+    {
+        if (!McpReadBox(*BoundsObj, Box))
+        {
+            OutError = TEXT("bounds requires min and max");
+            return false;
+        }
+        bHasBox = true;
+    }
+
+    if (Payload->HasField(TEXT("center")))
+    {
+        Center = ExtractVectorField(Payload, TEXT("center"), FVector::ZeroVector);
+        bHasCenter = true;
+    }
+    CenterActorName = GetJsonStringField(Payload, TEXT("near"));
+    if (Payload->HasField(TEXT("radius")))
+    {
+        Radius = GetJsonNumberField(Payload, TEXT("radius"));
+        if (Radius < 0.0 || (!bHasCenter && CenterActorName.IsEmpty()))
+        {
+            OutError = TEXT("radius requires a non-negative value and center or near");
+            return false;
+        }
+        bHasRadius = true;
+    }
+
+    const TSharedPtr<FJsonObject>* FrustumObj = nullptr;
+    if (Payload->TryGetObjectField(TEXT("frustum"), FrustumObj) && FrustumObj->IsValid())
+    {
+        const TSharedPtr<FJsonObject>& Frustum = *FrustumObj;
+        FVector Origin = ExtractVectorField(Frustum, TEXT("origin"), FVector::ZeroVector);
+        FRotator Rotation = ExtractRotatorField(Frustum, TEXT("rotation"), FRotator::ZeroRotator);
+        if (!Frustum->HasField(TEXT("origin")))
+        {
+#if WITH_EDITOR && MCP_SCENE_QUERY_HAS_VIEWPORT_CAMERA
+            UUnrealEditorSubsystem* EditorSubsystem =
+                GEditor ? GEditor->GetEditorSubsystem<UUnrealEditorSubsystem>() : nullptr;
+            if (!EditorSubsystem || !EditorSubsystem->GetLevelViewportCameraInfo(Origin, Rotation))
+#endif
+            {
+                OutError = TEXT("frustum requires origin/rotation when no level viewport is available");
+                return false;
+            }
+        }
+        const double HalfFov = FMath::DegreesToRadians(
+            FMath::Clamp(GetJsonNumberField(Frustum, TEXT("fov"), 90.0), 1.0, 179.0) * 0.5);
+        const double Aspect = FMath::Max(0.01, GetJsonNumberField(Frustum, TEXT("aspectRatio"), 16.0 / 9.0));
+        const double HalfVertical = FMath::Atan(FMath::Tan(HalfFov) / Aspect);
+        const double NearClip = FMath::Max(0.0, GetJsonNumberField(Frustum, TEXT("nearClip"), 10.0));
+        const double FarClip = FMath::Max(NearClip + 1.0, GetJsonNumberField(Frustum, TEXT("farClip"), 100000.0));
+
+        const FRotationMatrix Axes(Rotation);
+        const FVector Forward = Axes.GetUnitAxis(EAxis::X);
+        const FVector Right = Axes.GetUnitAxis(EAxis::Y);
+        const FVector Up = Axes.GetUnitAxis(EAxis::Z);
+
+        // Outward-facing planes; a box is outside when it lies fully in front of any of them.
+        auto SidePlane = [&Origin](const FVector& Normal)
+        {
+            return FPlane(Origin, Normal.GetSafeNormal());
+        };
+        FrustumPlanes.Add(SidePlane(Right * FMath::Cos(HalfFov) - Forward * FMath::Sin(HalfFov)));
+        FrustumPlanes.Add(SidePlane(-Right * FMath::Cos(HalfFov) - Forward * FMath::Sin(HalfFov)));
+        FrustumPlanes.Add(SidePlane(Up * FMath::Cos(HalfVertical) - Forward * FMath::Sin(HalfVertical)));
+        FrustumPlanes.Add(SidePlane(-Up * FMath::Cos(HalfVertical) - Forward * FMath::Sin(HalfVertical)));
+        FrustumPlanes.Add(FPlane(Origin + Forward * NearClip, -Forward));
+        FrustumPlanes.Add(FPlane(Origin + Forward * FarClip, Forward));
+
+        const double TanH = FMath::Tan(HalfFov);
+        const double TanV = FMath::Tan(HalfVertical);
+        for (const double Depth : {NearClip, FarClip})
+        {
+            for (const double SignX : {-1.0, 1.0})
+            {
+                for (const double SignY : {-1.0, 1.0})
+                {
+                    FrustumBox += Origin + Forward * Depth + Right * (SignX * Depth * TanH) + Up * (SignY * Depth * TanV);
+                }
+            }
+        }
+        if (!bHasCenter && CenterActorName.IsEmpty())
+        {
+            // Distance sorting inside a frustum is from the eye.
+            Center = Origin;
+            bHasCenter = true;
+        }
+        bHasFrustum = true;
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* WhereArray = nullptr;
+    if (Payload->TryGetArrayField(TEXT("where"), WhereArray))
+    {
+        for (const TSharedPtr<FJsonValue>& Item : *WhereArray)
+        {
+            const TSharedPtr<FJsonObject>* ItemObj = nullptr;
+            if (!Item.IsValid() || !Item->TryGetObject(ItemObj))
+            {
+                OutError = TEXT("where entries must be objects {path, op, value}");
+                return false;
+            }
+            FPredicate Predicate;
+            Predicate.Path = GetJsonStringField(*ItemObj, TEXT("path"));
+            Predicate.Op = GetJsonStringField(*ItemObj, TEXT("op"), TEXT("eq")).ToLower();
+            Predicate.Value = (*ItemObj)->TryGetField(TEXT("value"));
+            static const TSet<FString> Ops = {TEXT("eq"), TEXT("ne"), TEXT("lt"), TEXT("le"), TEXT("gt"),
+                                              TEXT("ge"), TEXT("contains"), TEXT("exists")};
+            if (Predicate.Path.IsEmpty() || !Ops.Contains(Predicate.Op) ||
+                (Predicate.Op != TEXT("exists") && !Predicate.Value.IsValid()))
+            {
+                OutError = FString::Printf(TEXT("Invalid where predicate on '%s'"), *Predicate.Path);
+                return false;
+            }
+            Predicates.Add(MoveTemp(Predicate));
+        }
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* FieldArray = nullptr;
+    if (Payload->TryGetArrayField(TEXT("fields"), FieldArray))
+    {
+        for (const TSharedPtr<FJsonValue>& Field : *FieldArray)
+        {
+            if (Field.IsValid() && !Field->AsString().IsEmpty())
+            {
+                Fields.Add(Field->AsString());
+            }
+        }
+        bFieldsGiven = Fields.Num() > 0;
+    }
+
+    SortField = GetJsonStringField(Payload, TEXT("sort"));
+    if (SortField.StartsWith(TEXT("-")))
+    {
+        bSortDescending = true;
+        SortField.RightChopInline(1);
+    }
+    SortField.ToLowerInline();
+    if (SortField == TEXT("distance") && !bHasCenter && CenterActorName.IsEmpty())
+    {
+        OutError = TEXT("sort by distance requires center, near or frustum");
+        return false;
+    }
+
+    if (Payload->HasField(TEXT("limit")))
+    {
+        Limit = FMath::Max(0, GetJsonIntField(Payload, TEXT("limit")));
+        bLimitGiven = true;
+    }
+    else
+    {
+        Limit = McpDefaultQueryLimit;
+    }
+    bRefreshIndex = GetJsonBoolField(Payload, TEXT("refreshIndex"), false);
+
+    // Everything except paging, so a cursor only resumes the query that issued it.
+    TSharedPtr<FJsonObject> Canonical = MakeShared<FJsonObject>();
+    Canonical->Values = Payload->Values;
+    Canonical->RemoveField(TEXT("cursor"));
+    Canonical->RemoveField(TEXT("limit"));
+    Canonical->RemoveField(TEXT("refreshIndex"));
+    CanonicalQuery = McpJsonValueToString(MakeShared<FJsonValueObject>(Canonical));
+
+    Cursor = GetJsonStringField(Payload, TEXT("cursor"));
+    if (!Cursor.IsEmpty())
+    {
+        FString Decoded;
+        FString OffsetText;
+        FString Hash;
+        if (!FBase64::Decode(Cursor, Decoded) || !Decoded.Split(TEXT("|"), &OffsetText, &Hash) ||
+            !OffsetText.IsNumeric() || Hash != GetQueryHash())
+        {
+            OutError = TEXT("cursor does not belong to this query");
+            OutErrorCode = TEXT("INVALID_CURSOR");
+            return false;
+        }
+        Offset = FMath::Max(0, FCString::Atoi(*OffsetText));
+    }
+    return true;
+}
+
+void FMcpSceneQuery::SetCenter(const FVector& InCenter)
+{
+    Center = InCenter;
+    bHasCenter = true;
+}
+
+void FMcpSceneQuery::SetDefaultFields(const TArray<FString>& InFields)
+{
+    if (!bFieldsGiven)
+    {
+        Fields = InFields;
+    }
+}
+
+void FMcpSceneQuery::SetDefaultLimit(int32 InLimit)
+{
+    if (!bLimitGiven)
+    {
+        Limit = FMath::Max(0, InLimit);
+    }
+}
+
+FString FMcpSceneQuery::GetQueryHash() const
+{
+    return FString::Printf(TEXT("%08x"), GetTypeHash(CanonicalQuery));
+}
+
+bool FMcpSceneQuery::MatchesPredicate(AActor* Actor, const FPredicate& Predicate) const
+{
+    void* Container = nullptr;
+    FString ResolveError;
+    FProperty* Property = ResolveNestedPropertyPath(Actor, Predicate.Path, Container, ResolveError);
+    if (Predicate.Op == TEXT("exists"))
+    {
+        return Property != nullptr;
+    }
+    if (!Property)
+    {
+        return false;
+    }
+    const TSharedPtr<FJsonValue> Actual = ExportPropertyToJsonValue(Container, Property);
+    if (!Actual.IsValid())
+    {
+        return false;
+    }
+
+    if (Predicate.Op == TEXT("contains"))
+    {
+        const FString Expected = McpJsonValueToString(Predicate.Value);
+        if (Actual->Type == EJson::Array)
+        {
+            for (const TSharedPtr<FJsonValue>& Element : Actual->AsArray())
+            {
+                if (McpStringValueEquals(McpJsonValueToString(Element), Expected))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+        return McpJsonValueToString(Actual).Contains(Expected, ESearchCase::IgnoreCase);
+    }
+
+    int32 Comparison = 0;
+    double ActualNumber = 0.0;
+    double ExpectedNumber = 0.0;
+    if (Predicate.Value->Type == EJson::Number && Actual->TryGetNumber(ActualNumber))
+    {
+        ExpectedNumber = Predicate.Value->AsNumber();
+        Comparison = ActualNumber < ExpectedNumber ? -1 : (ActualNumber > ExpectedNumber ? 1 : 0);
+    }
+    else if (Predicate.Value->Type == EJson::Boolean && Actual->Type == EJson::Boolean)
+    {
+        Comparison = int32(Actual->AsBool()) - int32(Predicate.Value->AsBool());
+    }
+    else
+    {
+        const FString ActualText = McpJsonValueToString(Actual);
+        const FString ExpectedText = McpJsonValueToString(Predicate.Value);
+        Comparison = McpStringValueEquals(ActualText, ExpectedText)
+                         ? 0
+                         : ActualText.Compare(ExpectedText, ESearchCase::IgnoreCase);
+    }
+
+    if (Predicate.Op == TEXT("eq"))
+    {
+        return Comparison == 0;
+    }
+    if (Predicate.Op == TEXT("ne"))
+    {
+        return Comparison != 0;
+    }
+    if (Predicate.Op == TEXT("lt"))
+    {
+        return Comparison < 0;
+    }
+    if (Predicate.Op == TEXT("le"))
+    {
+        return Comparison <= 0;
+    }
+    if (Predicate.Op == TEXT("gt"))
+    {
+        return Comparison > 0;
+    }
+    return Comparison >= 0;
+}
+
+bool FMcpSceneQuery::Matches(AActor* Actor, const FBox& Bounds) const
+{
+    if (ActorClass && (bIncludeSubclasses ? !Actor->IsA(ActorClass) : Actor->GetClass() != ActorClass))
+    {
+        return false;
+    }
+    if (!ClassPathSubstring.IsEmpty() && !Actor->GetClass()->GetPathName().Contains(ClassPathSubstring))
+    {
+        return false;
+    }
+    if (ComponentClass && !Actor->FindComponentByClass(ComponentClass))
+    {
+        return false;
+    }
+    if (!NamePattern.IsEmpty() && !Actor->GetName().MatchesWildcard(NamePattern))
+    {
+        return false;
+    }
+    if (!LevelName.IsEmpty())
+    {
+        const ULevel* Level = Actor->GetLevel();
+        const UPackage* Package = Level ? Level->GetOutermost() : nullptr;
+        if (!Package || !(Package->GetName().Equals(LevelName, ESearchCase::IgnoreCase) ||
+                          FPackageName::GetShortName(Package->GetName()).Equals(LevelName, ESearchCase::IgnoreCase)))
+        {
+            return false;
+        }
+    }
+    if (Tags.Num() > 0)
+    {
+        int32 Found = 0;
+        for (const FName& Tag : Tags)
+        {
+            Found += Actor->ActorHasTag(Tag) ? 1 : 0;
+        }
+        if (Found == 0 || (bAllTags && Found != Tags.Num()))
+        {
+            return false;
+        }
+    }
+#if WITH_EDITOR
+    if (!LabelPattern.IsEmpty() && !Actor->GetActorLabel().MatchesWildcard(LabelPattern))
+    {
+        return false;
+    }
+    if (!FolderPrefix.IsEmpty())
+    {
+        const FString Folder = Actor->GetFolderPath().ToString();
+        if (!Folder.StartsWith(FolderPrefix, ESearchCase::IgnoreCase) ||
+            (Folder.Len() > FolderPrefix.Len() && !FolderPrefix.EndsWith(TEXT("/")) && Folder[FolderPrefix.Len()] != TEXT('/')))
+        {
+            return false;
+        }
+    }
+    if (!DataLayer.IsEmpty())
+    {
+        bool bInLayer = false;
+        for (const UDataLayerInstance* Layer : Actor->GetDataLayerInstances())
+        {
+            if (Layer && (Layer->GetDataLayerShortName().Equals(DataLayer, ESearchCase::IgnoreCase) ||
+                          Layer->GetDataLayerFullName().Equals(DataLayer, ESearchCase::IgnoreCase)))
+            {
+                bInLayer = true;
+                break;
+            }
+        }
+        if (!bInLayer)
+        {
+            return false;
+        }
+    }
+#endif
+    if (bHasBox && !Box.Intersect(Bounds))
+    {
+        return false;
+    }
+    if (bHasRadius && FMath::Square(Radius) < ComputeSquaredDistanceFromBoxToPoint(Bounds.Min, Bounds.Max, Center))
+    {
+        return false;
+    }
+    if (bHasFrustum)
+    {
+        const FVector BoxCenter = Bounds.GetCenter();
+        const FVector Extent = Bounds.GetExtent();
+        for (const FPlane& Plane : FrustumPlanes)
+        {
+            const double PushOut = FMath::Abs(Plane.X * Extent.X) + FMath::Abs(Plane.Y * Extent.Y) +
+                                   FMath::Abs(Plane.Z * Extent.Z);
+            if (Plane.PlaneDot(BoxCenter) > PushOut)
+            {
+                return false;
+            }
+        }
+    }
+    for (const FPredicate& Predicate : Predicates)
+    {
+        if (!MatchesPredicate(Actor, Predicate))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+TSharedPtr<FJsonObject> FMcpSceneQuery::Project(AActor* Actor, const FBox& Bounds) const
+{
+    TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+    TSharedPtr<FJsonObject> Properties;
+    for (const FString& Field : Fields)
+    {
+        if (Field == TEXT("name"))
+        {
+            Obj->SetStringField(Field, Actor->GetName());
+        }
+        else if (Field == TEXT("path"))
+        {
+            Obj->SetStringField(Field, Actor->GetPathName());
+        }
+        else if (Field == TEXT("class"))
+        {
+            Obj->SetStringField(Field, Actor->GetClass()->GetName());
+        }
+        else if (Field == TEXT("location"))
+        {
+            Obj->SetObjectField(Field, McpVectorJson(Actor->GetActorLocation()));
+        }
+        else if (Field == TEXT("rotation"))
+        {
+            const FRotator Rotation = Actor->GetActorRotation();
+            TSharedPtr<FJsonObject> Rot = MakeShared<FJsonObject>();
+            Rot->SetNumberField(TEXT("pitch"), Rotation.Pitch);
+            Rot->SetNumberField(TEXT("yaw"), Rotation.Yaw);
+            Rot->SetNumberField(TEXT("roll"), Rotation.Roll);
+            Obj->SetObjectField(Field, Rot);
+        }
+        else if (Field == TEXT("scale"))
+        {
+            Obj->SetObjectField(Field, McpVectorJson(Actor->GetActorScale3D()));
+        }
+        else if (Field == TEXT("bounds"))
+        {
+            TSharedPtr<FJsonObject> BoundsObj = MakeShared<FJsonObject>();
+            BoundsObj->SetObjectField(TEXT("min"), McpVectorJson(Bounds.Min));
+            BoundsObj->SetObjectField(TEXT("max"), McpVectorJson(Bounds.Max));
+            Obj->SetObjectField(Field, BoundsObj);
+        }
+        else if (Field == TEXT("tags"))
+        {
+            TArray<TSharedPtr<FJsonValue>> TagValues;
+            for (const FName& Tag : Actor->Tags)
+            {
+                TagValues.Add(MakeShared<FJsonValueString>(Tag.ToString()));
+            }
+            Obj->SetArrayField(Field, TagValues);
+        }
+        else if (Field == TEXT("components"))
+        {
+            TArray<TSharedPtr<FJsonValue>> ComponentValues;
+            for (const UActorComponent* Component : Actor->GetComponents())
+            {
+                if (Component)
+                {
+                    TSharedPtr<FJsonObject> ComponentObj = MakeShared<FJsonObject>();
+                    ComponentObj->SetStringField(TEXT("name"), Component->GetName());
+                    ComponentObj->SetStringField(TEXT("class"), Component->GetClass()->GetName());
+                    ComponentValues.Add(MakeShared<FJsonValueObject>(ComponentObj));
+                }
+            }
+            Obj->SetArrayField(Field, ComponentValues);
+        }
+        else if (Field == TEXT("distance"))
+        {
+            if (bHasCenter)
+            {
+                Obj->SetNumberField(Field, FVector::Dist(Center, Actor->GetActorLocation()));
+            }
+        }
+#if WITH_EDITOR
+        else if (Field == TEXT("label"))
+        {
+            Obj->SetStringField(Field, Actor->GetActorLabel());
+        }
+        else if (Field == TEXT("folder"))
+        {
+            Obj->SetStringField(Field, Actor->GetFolderPath().ToString());
+        }
+        else if (Field == TEXT("dataLayers"))
+        {
+            TArray<TSharedPtr<FJsonValue>> LayerValues;
+            for (const UDataLayerInstance* Layer : Actor->GetDataLayerInstances())
+            {
+                if (Layer)
+                {
+                    LayerValues.Add(MakeShared<FJsonValueString>(Layer->GetDataLayerShortName()));
+                }
+            }
+            Obj->SetArrayField(Field, LayerValues);
+        }
+#endif
+        else
+        {
+            // Any other field is a property path on the actor.
+            void* Container = nullptr;
+            FString ResolveError;
+            if (FProperty* Property = ResolveNestedPropertyPath(Actor, Field, Container, ResolveError))
+            {
+                if (TSharedPtr<FJsonValue> Value = ExportPropertyToJsonValue(Container, Property))
+                {
+                    if (!Properties.IsValid())
+                    {
+                        Properties = MakeShared<FJsonObject>();
+                        Obj->SetObjectField(TEXT("properties"), Properties);
+                    }
+                    Properties->SetField(Field, Value);
+                }
+            }
+        }
+    }
+    return Obj;
+}
+
+bool FMcpSceneQuery::Execute(UWorld* World, const FString& ArrayField, const TSharedPtr<FJsonObject>& OutResult,
+                             FString& OutError, FString& OutErrorCode)
+{
+    if (!World)
+    {
+        OutError = TEXT("No world available");
+        OutErrorCode = TEXT("WORLD_NOT_FOUND");
+        return false;
+    }
+    if (bHasRadius && !bHasCenter)
+    {
+        OutError = TEXT("radius query has no center");
+        OutErrorCode = TEXT("INVALID_ARGUMENT");
+        return false;
+    }
+    if (Fields.Num() == 0)
+    {
+        Fields = {TEXT("name"), TEXT("path"), TEXT("class")};
+    }
+
+    // Candidate set: the spatial index when a region is given, else the class's object list, else every actor.
+    bool bSpatial = false;
+    FBox Region(ForceInit);
+    auto Narrow = [&bSpatial, &Region](const FBox& Other)
+    {
+        Region = bSpatial ? Region.Overlap(Other) : Other;
+        bSpatial = true;
+    };
+    if (bHasBox)
+    {
+        Narrow(Box);
+    }
+    if (bHasRadius)
+    {
+        Narrow(FBox(Center - FVector(Radius), Center + FVector(Radius)));
+    }
+    if (bHasFrustum)
+    {
+        Narrow(FrustumBox);
+    }
+
+    TArray<AActor*> Candidates;
+    FMcpActorSpatialIndex& Index = FMcpActorSpatialIndex::Get();
+    if (bSpatial)
+    {
+        if (bRefreshIndex)
+        {
+            Index.Invalidate();
+        }
+        Index.Query(World, Region, Candidates);
+    }
+    else
+    {
+        for (TActorIterator<AActor> It(World, ActorClass ? ActorClass : AActor::StaticClass()); It; ++It)
+        {
+            Candidates.Add(*It);
+        }
+    }
+
+    TArray<FMcpQueryMatch> Matched;
+    for (AActor* Actor : Candidates)
+    {
+        if (!McpIsQueryableActor(Actor) || Actor->GetWorld() != World)
+        {
+            continue;
+        }
+        const FBox Bounds = McpGetActorBounds(Actor);
+        if (!Matches(Actor, Bounds))
+        {
+            continue;
+        }
+        FMcpQueryMatch& Match = Matched.AddDefaulted_GetRef();
+        Match.Actor = Actor;
+        Match.Bounds = Bounds;
+        if (bHasCenter)
+        {
+            Match.Distance = FVector::Dist(Center, Actor->GetActorLocation());
+        }
+    }
+
+    FString EffectiveSort = SortField;
+    if (EffectiveSort.IsEmpty())
+    {
+        EffectiveSort = bHasCenter ? TEXT("distance") : TEXT("name");
+    }
+    const bool bByDistance = EffectiveSort == TEXT("distance");
+    for (FMcpQueryMatch& Match : Matched)
+    {
+        if (EffectiveSort == TEXT("name"))
+        {
+            Match.Key = Match.Actor->GetName();
+        }
+        else if (EffectiveSort == TEXT("class"))
+        {
+            Match.Key = Match.Actor->GetClass()->GetName();
+        }
+#if WITH_EDITOR
+        else if (EffectiveSort == TEXT("label"))
+        {
+            Match.Key = Match.Actor->GetActorLabel();
+        }
+        else if (EffectiveSort == TEXT("folder"))
+        {
+            Match.Key = Match.Actor->GetFolderPath().ToString();
+        }
+#endif
+        else if (!bByDistance)
+        {
+            Match.Key = Match.Actor->GetPathName();
+        }
+    }
+    // Ties break on path so pages are stable between calls.
+    const bool bDescending = bSortDescending;
+    Matched.Sort([bByDistance, bDescending](const FMcpQueryMatch& A, const FMcpQueryMatch& B)
+    {
+        int32 Order = 0;
+        if (bByDistance)
+        {
+            Order = A.Distance < B.Distance ? -1 : (A.Distance > B.Distance ? 1 : 0);
+        }
+        else
+        {
+            Order = A.Key.Compare(B.Key, ESearchCase::IgnoreCase);
+        }
+        if (Order == 0)
+        {
+            return A.Actor->GetPathName() < B.Actor->GetPathName();
+        }
+        return bDescending ? Order > 0 : Order < 0;
+    });
+
+    const int32 Total = Matched.Num();
+    const int32 Start = FMath::Min(Offset, Total);
+    const int32 End = Limit > 0 ? FMath::Min(Total, Start + Limit) : Total;
+    TArray<TSharedPtr<FJsonValue>> Page;
+    Page.Reserve(End - Start);
+    for (int32 i = Start; i < End; ++i)
+    {
+        Page.Add(MakeShared<FJsonValueObject>(Project(Matched[i].Actor, Matched[i].Bounds)));
+    }
+
+    OutResult->SetArrayField(ArrayField, Page);
+    OutResult->SetNumberField(TEXT("count"), Page.Num());
+    OutResult->SetNumberField(TEXT("total"), Total);
+    OutResult->SetNumberField(TEXT("scanned"), Candidates.Num());
+    OutResult->SetBoolField(TEXT("usedSpatialIndex"), bSpatial);
+    if (End < Total)
+    {
+        OutResult->SetStringField(TEXT("nextCursor"),
+                                  FBase64::Encode(FString::Printf(TEXT("%d|%s"), End, *GetQueryHash())));
+    }
+    return true;
+}
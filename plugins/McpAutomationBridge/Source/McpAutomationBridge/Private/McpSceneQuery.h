@@ -0,0 +1,187 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtr.h"
+
+class AActor;
+class UActorComponent;
+class UClass;
+class UObject;
+class USceneComponent;
+class UWorld;
+struct FPropertyChangedEvent;
+
+/**
+ * Uniform grid over actor bounds for one world, so spatial queries only visit
+ * the cells they overlap instead of every actor.
+ *
+ * Built lazily on the first spatial query against a world and kept current
+ * from the editor's actor added/deleted/moved notifications, property
+ * changes on actors and scene components, and each indexed actor's root
+ * component transform updates (moves made from code, the bridge included,
+ * send no editor notification). Undo/redo, map changes and world
+ * cleanup drop it; the next query rebuilds. Actors whose bounds cover too many
+ * cells (landscapes, sky spheres, huge volumes) sit in an oversized list that
+ * every query visits.
+ *
+ * Candidates are a superset: callers still test each actor's live bounds.
+ * Game thread only.
+ */
+class FMcpActorSpatialIndex
+{
+public:
+    static FMcpActorSpatialIndex& Get();
+
+    /** Binds the update delegates. Called from the subsystem's Initialize. */
+    void Startup();
+    /** Unbinds the delegates and frees the index. */
+    void Shutdown();
+
+    /**
+     * Adds every indexed actor of World whose cells overlap Box to OutActors.
+     * Rebuilds the index first if it covers another world or was dropped.
+     */
+    void Query(UWorld* World, const FBox& Box, TArray<AActor*>& OutActors);
+
+    /** Drops the index; the next query rebuilds it. */
+    void Invalidate();
+
+    bool IsBuiltFor(const UWorld* World) const;
+    int32 GetNumActors() const { return Entries.Num(); }
+
+private:
+    struct FEntry
+    {
+        FIntVector MinCell = FIntVector::ZeroValue;
+        FIntVector MaxCell = FIntVector::ZeroValue;
+        bool bOversized = false;
+        TWeakObjectPtr<USceneComponent> Root;
+        FDelegateHandle TransformHandle;
+    };
+
+    void Build(UWorld* World);
+    void Insert(AActor* Actor);
+    void Remove(AActor* Actor);
+    void Update(AActor* Actor);
+    /** Adds or removes Entry's cells (or its oversized slot). */
+    void Place(const TObjectKey<AActor>& Key, AActor* Actor, FEntry& Entry);
+    void Unplace(const TObjectKey<AActor>& Key, const FEntry& Entry);
+    void Unbind(FEntry& Entry);
+
+    void HandleActorChanged(AActor* Actor);
+    void HandleActorDeleted(AActor* Actor);
+    void HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+
+    FIntVector ToCell(const FVector& Location) const;
+
+    TWeakObjectPtr<UWorld> IndexedWorld;
+    TMap<TObjectKey<AActor>, FEntry> Entries;
+    TMap<FIntVector, TArray<TObjectKey<AActor>>> Cells;
+    TSet<TObjectKey<AActor>> Oversized;
+
+    FDelegateHandle ActorAddedHandle;
+    FDelegateHandle ActorDeletedHandle;
+    FDelegateHandle ActorMovedHandle;
+    FDelegateHandle PropertyChangedHandle;
+    FDelegateHandle UndoRedoHandle;
+    FDelegateHandle MapChangeHandle;
+    FDelegateHandle WorldCleanupHandle;
+};
+
+/**
+ * One structured actor query (the query_actors payload).
+ *
+ * Filters, all optional and ANDed:
+ *  - class (+ includeSubclasses, default true), classPathContains
+ *    (case-insensitive substring of the class path), hasComponent, name / label
+ *    (wildcards), tags (+ tagMatch "any" | "all"), folder (path prefix),
+ *    dataLayer, level (package name)
+ *  - bounds {min, max}; radius around center (or an actor resolved by the
+ *    caller); frustum {origin, rotation, fov, aspectRatio, nearClip, farClip}
+ *  - where: [{path, op, value}] property predicates, op one of eq, ne, lt, le,
+ *    gt, ge, contains, exists
+ * Output: fields projection (name, label, path, class, location, rotation,
+ * scale, bounds, tags, folder, dataLayers, components, distance; anything else
+ * is read as a property path), sort ("name", "-distance", ...), limit and an
+ * opaque cursor from the previous page's nextCursor.
+ *
+ * Spatial filters take their candidates from FMcpActorSpatialIndex; a class
+ * filter alone walks that class's object list; otherwise every actor is
+ * visited.
+ */
+class FMcpSceneQuery
+{
+public:
+    /** Reads the query from Payload. Returns false with an error message and code. */
+    bool Parse(const TSharedPtr<FJsonObject>& Payload, FString& OutError, FString& OutErrorCode);
+
+    /** Radius queries around an actor: the handler resolves the actor and sets its location. */
+    void SetCenter(const FVector& InCenter);
+    bool NeedsCenterActor() const { return !CenterActorName.IsEmpty(); }
+    const FString& GetCenterActorName() const { return CenterActorName; }
+
+    /** Fields used when the payload has no "fields" array. */
+    void SetDefaultFields(const TArray<FString>& InFields);
+    /** Limit used when the payload has no "limit" (500 otherwise); 0 means unlimited. */
+    void SetDefaultLimit(int32 InLimit);
+
+    /**
+     * Runs the query against World and fills OutResult with the projected page
+     * under ArrayField, plus count, total, scanned, usedSpatialIndex and
+     * nextCursor when more matches remain.
+     */
+    bool Execute(UWorld* World, const FString& ArrayField, const TSharedPtr<FJsonObject>& OutResult,
+                 FString& OutError, FString& OutErrorCode);
+
+private:
+    struct FPredicate
+    {
+        FString Path;
+        FString Op;
+        TSharedPtr<FJsonValue> Value;
+    };
+
+    bool Matches(AActor* Actor, const FBox& Bounds) const;
+    bool MatchesPredicate(AActor* Actor, const FPredicate& Predicate) const;
+    TSharedPtr<FJsonObject> Project(AActor* Actor, const FBox& Bounds) const;
+    FString GetQueryHash() const;
+
+    UClass* ActorClass = nullptr;
+    bool bIncludeSubclasses = true;
+    FString ClassPathSubstring;
+    UClass* ComponentClass = nullptr;
+    FString NamePattern;
+    FString LabelPattern;
+    TArray<FName> Tags;
+    bool bAllTags = false;
+    FString FolderPrefix;
+    FString DataLayer;
+    FString LevelName;
+
+    bool bHasBox = false;
+    FBox Box = FBox(ForceInit);
+    bool bHasRadius = false;
+    bool bHasCenter = false;
+    FVector Center = FVector::ZeroVector;
+    double Radius = 0.0;
+    FString CenterActorName;
+    bool bHasFrustum = false;
+    TArray<FPlane> FrustumPlanes;
+    FBox FrustumBox = FBox(ForceInit);
+
+    TArray<FPredicate> Predicates;
+    TArray<FString> Fields;
+    bool bFieldsGiven = false;
+    FString SortField;
+    bool bSortDescending = false;
+    int32 Limit = 0;
+    bool bLimitGiven = false;
+    int32 Offset = 0;
+    FString Cursor;
+    bool bRefreshIndex = false;
+
+    /** The payload minus cursor and limit, hashed into cursors so they only resume the same query. */
+    FString CanonicalQuery;
+};
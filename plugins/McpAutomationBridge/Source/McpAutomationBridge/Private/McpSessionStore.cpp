@@ -0,0 +1,420 @@
+#include "McpSessionStore.h"
+
+#include "HAL/PlatformTime.h"
+#include "McpBridgeWebSocket.h"
+#include "Misc/Guid.h"
+#include "Misc/ScopeLock.h"
+
+void FMcpSessionStore::Configure(double InResumeWindowSeconds, double InReplayWindowSeconds, int32 InMaxResponses,
+                                 int64 InMaxBytes)
+{
+    FScopeLock Lock(&Mutex);
+    ResumeWindowSeconds = FMath::Max(0.0, InResumeWindowSeconds);
+    ReplayWindowSeconds = FMath::Max(0.0, InReplayWindowSeconds);
+    MaxResponses = FMath::Max(0, InMaxResponses);
+    MaxBytes = FMath::Max<int64>(0, InMaxBytes);
+}
+
+FString FMcpSessionStore::Attach(const TSharedPtr<FMcpBridgeWebSocket>& Socket, const FString& ResumeId,
+                                 bool& bOutResumed, TArray<FString>& OutUndelivered, TArray<FString>& OutRunning,
+                                 TArray<FString>& OutNotReplayable)
+{
+    bOutResumed = false;
+    if (!Socket.IsValid())
+    {
+        return FString();
+    }
+    const double Now = FPlatformTime::Seconds();
+    FScopeLock Lock(&Mutex);
+
+    // A new socket may reuse the address of one that is gone; requests that
+    // socket sent must not resolve to it.
+    if (!SocketSessions.Contains(Socket.Get()))
+    {
+        for (TPair<FString, FRequestOwner>& Pair : RequestSessions)
+        {
+            if (Pair.Value.Socket == Socket.Get())
+            {
+                Pair.Value.Socket = nullptr;
+            }
+        }
+    }
+
+    // A second bridge_hello on the same socket starts over.
+    if (const FString* Previous = SocketSessions.Find(Socket.Get()))
+    {
+        if (FSession* Session = Sessions.Find(*Previous))
+        {
+            Session->Socket.Reset();
+            Session->SocketPtr = nullptr;
+            Session->DetachedSeconds = Now;
+        }
+        SocketSessions.Remove(Socket.Get());
+    }
+
+    FSession* Resumed = ResumeId.IsEmpty() ? nullptr : Sessions.Find(ResumeId);
+    if (Resumed && Resumed->DetachedSeconds > 0.0 && Now - Resumed->DetachedSeconds > ResumeWindowSeconds)
+    {
+        // Expired but not yet collected by Tick.
+        Resumed = nullptr;
+    }
+    if (Resumed)
+    {
+        // The old socket may not have noticed the drop yet; the new one wins.
+        if (Resumed->SocketPtr && Resumed->SocketPtr != Socket.Get())
+        {
+            SocketSessions.Remove(Resumed->SocketPtr);
+        }
+        Resumed->Socket = Socket;
+        Resumed->SocketPtr = Socket.Get();
+        Resumed->DetachedSeconds = 0.0;
+        SocketSessions.Add(Socket.Get(), ResumeId);
+
+        TrimResponses(*Resumed, Now);
+        for (FResponse& Response : Resumed->Responses)
+        {
+            if (!Response.bDelivered)
+            {
+                OutUndelivered.Add(Response.Serialized);
+                Response.bDelivered = true;
+                if (Response.bStreamed)
+                {
+                    OutNotReplayable.Add(Response.RequestId);
+                }
+            }
+        }
+        OutRunning = Resumed->Running.Array();
+        OutNotReplayable.Append(Resumed->Streamed.Array());
+        ++ResumedSessions;
+        bOutResumed = true;
+        return ResumeId;
+    }
+
+    const FString SessionId = FGuid::NewGuid().ToString(EGuidFormats::Digits);
+    FSession& Session = Sessions.Add(SessionId);
+    Session.Socket = Socket;
+    Session.SocketPtr = Socket.Get();
+    SocketSessions.Add(Socket.Get(), SessionId);
+    return SessionId;
+}
+
+void FMcpSessionStore::Detach(const FMcpBridgeWebSocket* Socket, bool bClean)
+{
+    FScopeLock Lock(&Mutex);
+    FString SessionId;
+    if (!SocketSessions.RemoveAndCopyValue(Socket, SessionId))
+    {
+        return;
+    }
+    FSession* Session = Sessions.Find(SessionId);
+    if (!Session)
+    {
+        return;
+    }
+    const bool bUndelivered = Session->Responses.ContainsByPredicate(
+        [](const FResponse& Response) { return !Response.bDelivered; });
+    if (bClean && Session->Running.Num() == 0 && !bUndelivered)
+    {
+        // A deliberate close with nothing left to hand over.
+        Sessions.Remove(SessionId);
+        return;
+    }
+    Session->Socket.Reset();
+    Session->SocketPtr = nullptr;
+    Session->DetachedSeconds = FPlatformTime::Seconds();
+}
+
+FMcpSessionStore::EAdmission FMcpSessionStore::Admit(const FMcpBridgeWebSocket* Socket, const FString& RequestId,
+                                                     FString& OutResponse)
+{
+    FScopeLock Lock(&Mutex);
+    const FString* SessionId = SocketSessions.Find(Socket);
+    FSession* Session = SessionId ? Sessions.Find(*SessionId) : nullptr;
+    if (!Session)
+    {
+        return EAdmission::Execute;
+    }
+    if (Session->Running.Contains(RequestId))
+    {
+        ++AttachedDuplicates;
+        return EAdmission::Attach;
+    }
+    TrimResponses(*Session, FPlatformTime::Seconds());
+    for (int32 Index = Session->Responses.Num() - 1; Index >= 0; --Index)
+    {
+        FResponse& Response = Session->Responses[Index];
+        if (Response.bEvent || Response.RequestId != RequestId)
+        {
+            continue;
+        }
+        if (!Response.bStreamed)
+        {
+            OutResponse = Response.Serialized;
+            Response.bDelivered = true;
+            ++ReplayedResponses;
+            return EAdmission::Replay;
+        }
+        // Its chunks are gone; the listing runs again rather than answering
+        // with the terminator alone.
+        break;
+    }
+    Session->Running.Add(RequestId);
+    FRequestOwner Owner;
+    Owner.SessionId = *SessionId;
+    Owner.Socket = Socket;
+    RequestSessions.Add(RequestId, MoveTemp(Owner));
+    return EAdmission::Execute;
+}
+
+const FMcpSessionStore::FRequestOwner* FMcpSessionStore::FindRequest(const FMcpBridgeWebSocket* Requester,
+                                                                     const FString& RequestId) const
+{
+    const FString* RequesterSession = Requester ? SocketSessions.Find(Requester) : nullptr;
+    const FRequestOwner* Only = nullptr;
+    int32 Count = 0;
+    for (auto It = RequestSessions.CreateConstKeyIterator(RequestId); It; ++It)
+    {
+        const FRequestOwner& Owner = It.Value();
+        if (Requester && (Owner.Socket == Requester || (RequesterSession && *RequesterSession == Owner.SessionId)))
+        {
+            return &Owner;
+        }
+        Only = &Owner;
+        ++Count;
+    }
+    return !Requester && Count == 1 ? Only : nullptr;
+}
+
+void FMcpSessionStore::RemoveRequest(const FString& SessionId, const FString& RequestId)
+{
+    for (auto It = RequestSessions.CreateKeyIterator(RequestId); It; ++It)
+    {
+        if (It.Value().SessionId == SessionId)
+        {
+            It.RemoveCurrent();
+            return;
+        }
+    }
+}
+
+bool FMcpSessionStore::ResolveSocket(const FMcpBridgeWebSocket* Requester, const FString& RequestId,
+                                     TSharedPtr<FMcpBridgeWebSocket>& OutSocket, FString& OutSessionId) const
+{
+    FScopeLock Lock(&Mutex);
+    const FRequestOwner* Owner = FindRequest(Requester, RequestId);
+    if (!Owner)
+    {
+        return false;
+    }
+    OutSessionId = Owner->SessionId;
+    const FSession* Session = Sessions.Find(Owner->SessionId);
+    OutSocket = Session ? Session->Socket.Pin() : nullptr;
+    return true;
+}
+
+void FMcpSessionStore::Complete(const FString& SessionId, const FString& RequestId, const FString& Serialized,
+                                bool bDelivered)
+{
+    FScopeLock Lock(&Mutex);
+    RemoveRequest(SessionId, RequestId);
+    FSession* Session = Sessions.Find(SessionId);
+    if (!Session)
+    {
+        return;
+    }
+    if (Session->Running.Remove(RequestId) == 0)
+    {
+        return;
+    }
+    const bool bStreamed = Session->Streamed.Remove(RequestId) > 0;
+    AddResponse(*Session, RequestId, Serialized, bDelivered);
+    Session->Responses.Last().bStreamed = bStreamed;
+    TrimResponses(*Session, FPlatformTime::Seconds());
+}
+
+void FMcpSessionStore::MarkStreamed(const FString& SessionId, const FString& RequestId)
+{
+    FScopeLock Lock(&Mutex);
+    FSession* Session = Sessions.Find(SessionId);
+    if (Session && Session->Running.Contains(RequestId))
+    {
+        Session->Streamed.Add(RequestId);
+    }
+}
+
+FString FMcpSessionStore::FindSession(const FMcpBridgeWebSocket* Socket) const
+{
+    FScopeLock Lock(&Mutex);
+    const FString* SessionId = SocketSessions.Find(Socket);
+    return SessionId ? *SessionId : FString();
+}
+
+bool FMcpSessionStore::ResolveSessionSocket(const FString& SessionId, TSharedPtr<FMcpBridgeWebSocket>& OutSocket) const
+{
+    FScopeLock Lock(&Mutex);
+    const FSession* Session = Sessions.Find(SessionId);
+    if (!Session)
+    {
+        return false;
+    }
+    OutSocket = Session->Socket.Pin();
+    return true;
+}
+
+void FMcpSessionStore::AddEvent(const FString& SessionId, const FString& Serialized, bool bDelivered)
+{
+    FScopeLock Lock(&Mutex);
+    FSession* Session = Sessions.Find(SessionId);
+    if (!Session)
+    {
+        return;
+    }
+    AddResponse(*Session, FString(), Serialized, bDelivered);
+    Session->Responses.Last().bEvent = true;
+    TrimResponses(*Session, FPlatformTime::Seconds());
+}
+
+void FMcpSessionStore::AddResponse(FSession& Session, const FString& RequestId, const FString& Serialized,
+                                   bool bDelivered)
+{
+    FResponse& Response = Session.Responses.AddDefaulted_GetRef();
+    Response.RequestId = RequestId;
+    Response.Serialized = Serialized;
+    Response.CompletedSeconds = FPlatformTime::Seconds();
+    Response.Bytes = Serialized.Len() * sizeof(TCHAR);
+    Response.bDelivered = bDelivered;
+    Session.ResponseBytes += Response.Bytes;
+}
+
+void FMcpSessionStore::Tick(double NowSeconds)
+{
+    FScopeLock Lock(&Mutex);
+    for (auto It = Sessions.CreateIterator(); It; ++It)
+    {
+        FSession& Session = It.Value();
+        if (Session.DetachedSeconds > 0.0 && NowSeconds - Session.DetachedSeconds > ResumeWindowSeconds)
+        {
+            for (const FString& RequestId : Session.Running)
+            {
+                RemoveRequest(It.Key(), RequestId);
+            }
+            ++ExpiredSessions;
+            It.RemoveCurrent();
+            continue;
+        }
+        TrimResponses(Session, NowSeconds);
+    }
+}
+
+void FMcpSessionStore::Reset()
+{
+    FScopeLock Lock(&Mutex);
+    Sessions.Empty();
+    SocketSessions.Empty();
+    RequestSessions.Empty();
+}
+
+void FMcpSessionStore::RemoveResponse(FSession& Session, int32 Index)
+{
+    Session.ResponseBytes -= Session.Responses[Index].Bytes;
+    Session.Responses.RemoveAt(Index);
+}
+
+void FMcpSessionStore::TrimResponses(FSession& Session, double NowSeconds)
+{
+    // Delivered responses only serve duplicates, so they age out with the
+    // replay window; undelivered ones wait for a resume.
+    for (int32 Index = 0; Index < Session.Responses.Num();)
+    {
+        const FResponse& Response = Session.Responses[Index];
+        const double MaxAge = Response.bDelivered ? ReplayWindowSeconds : ResumeWindowSeconds;
+        if (NowSeconds - Response.CompletedSeconds > MaxAge)
+        {
+            RemoveResponse(Session, Index);
+        }
+        else
+        {
+            ++Index;
+        }
+    }
+
+    auto OverBudget = [this, &Session]()
+    {
+        return Session.Responses.Num() > MaxResponses || Session.ResponseBytes > MaxBytes;
+    };
+    for (int32 Index = 0; Index < Session.Responses.Num() && OverBudget();)
+    {
+        if (Session.Responses[Index].bDelivered)
+        {
+            RemoveResponse(Session, Index);
+        }
+        else
+        {
+            ++Index;
+        }
+    }
+    while (Session.Responses.Num() > 0 && OverBudget())
+    {
+        RemoveResponse(Session, 0);
+    }
+}
+
+TSharedPtr<FJsonObject> FMcpSessionStore::GetStatsJson() const
+{
+    FScopeLock Lock(&Mutex);
+    int32 Attached = 0;
+    int32 Detached = 0;
+    int32 Buffered = 0;
+    int32 Undelivered = 0;
+    int64 Bytes = 0;
+    for (const TPair<FString, FSession>& Pair : Sessions)
+    {
+        const FSession& Session = Pair.Value;
+        (Session.SocketPtr ? Attached : Detached)++;
+        Buffered += Session.Responses.Num();
+        Bytes += Session.ResponseBytes;
+        for (const FResponse& Response : Session.Responses)
+        {
+            Undelivered += Response.bDelivered ? 0 : 1;
+        }
+    }
+
+    TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetNumberField(TEXT("attached"), Attached);
+    Json->SetNumberField(TEXT("detached"), Detached);
+    Json->SetNumberField(TEXT("bufferedResponses"), Buffered);
+    Json->SetNumberField(TEXT("bufferedBytes"), static_cast<double>(Bytes));
+    Json->SetNumberField(TEXT("undelivered"), Undelivered);
+    Json->SetNumberField(TEXT("resumed"), static_cast<double>(ResumedSessions));
+    Json->SetNumberField(TEXT("replayed"), static_cast<double>(ReplayedResponses));
+    Json->SetNumberField(TEXT("attachedDuplicates"), static_cast<double>(AttachedDuplicates));
+    Json->SetNumberField(TEXT("expired"), static_cast<double>(ExpiredSessions));
+    return Json;
+}
+
+void FMcpSessionStore::AppendPrometheusText(FString& Out) const
+{
+    const TSharedPtr<FJsonObject> Stats = GetStatsJson();
+    auto Number = [&Stats](const TCHAR* Field) { return static_cast<long long>(Stats->GetNumberField(Field)); };
+
+    Out += TEXT("# HELP mcp_bridge_sessions Client sessions by state.\n");
+    Out += TEXT("# TYPE mcp_bridge_sessions gauge\n");
+    Out += FString::Printf(TEXT("mcp_bridge_sessions{state=\"attached\"} %lld\n"), Number(TEXT("attached")));
+    Out += FString::Printf(TEXT("mcp_bridge_sessions{state=\"detached\"} %lld\n"), Number(TEXT("detached")));
+    Out += TEXT("# HELP mcp_bridge_session_buffered_responses Responses held for replay and resume.\n");
+    Out += TEXT("# TYPE mcp_bridge_session_buffered_responses gauge\n");
+    Out += FString::Printf(TEXT("mcp_bridge_session_buffered_responses{delivered=\"true\"} %lld\n"),
+                           Number(TEXT("bufferedResponses")) - Number(TEXT("undelivered")));
+    Out += FString::Printf(TEXT("mcp_bridge_session_buffered_responses{delivered=\"false\"} %lld\n"),
+                           Number(TEXT("undelivered")));
+    Out += TEXT("# HELP mcp_bridge_session_buffered_bytes Memory held by buffered responses.\n");
+    Out += TEXT("# TYPE mcp_bridge_session_buffered_bytes gauge\n");
+    Out += FString::Printf(TEXT("mcp_bridge_session_buffered_bytes %lld\n"), Number(TEXT("bufferedBytes")));
+    Out += TEXT("# HELP mcp_bridge_session_events_total Resumes, replayed duplicates, attached duplicates and expiries.\n");
+    Out += TEXT("# TYPE mcp_bridge_session_events_total counter\n");
+    Out += FString::Printf(TEXT("mcp_bridge_session_events_total{event=\"resumed\"} %lld\n"), Number(TEXT("resumed")));
+    Out += FString::Printf(TEXT("mcp_bridge_session_events_total{event=\"replayed\"} %lld\n"), Number(TEXT("replayed")));
+    Out += FString::Printf(TEXT("mcp_bridge_session_events_total{event=\"attached\"} %lld\n"),
+                           Number(TEXT("attachedDuplicates")));
+    Out += FString::Printf(TEXT("mcp_bridge_session_events_total{event=\"expired\"} %lld\n"), Number(TEXT("expired")));
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+
+class FMcpBridgeWebSocket;
+
+/**
+ * Resumable client sessions with a per-session replay buffer.
+ *
+ * Every socket that completes bridge_hello is attached to a session; the ack
+ * carries its id as "clientSessionId". A client that reconnects and presents
+ * that id as "resumeSessionId" within the resume window gets the same session
+ * back: requests still running answer on the new socket, and responses that
+ * completed while it was away are sent right after the ack.
+ *
+ * Completed responses are kept per session, keyed by requestId, for the replay
+ * window and within a count and byte budget (oldest first out). A request
+ * whose requestId is already known to the session is not executed again: a
+ * finished one is answered from the buffer, a running one is attached to the
+ * socket that re-sent it.
+ *
+ * Job events outlive their request, so they are addressed to the session
+ * itself and buffered the same way. Streamed chunks are not buffered: a
+ * request that sent chunks is never answered from the buffer (a duplicate
+ * runs it again), and a resume reports it as not replayable.
+ *
+ * Requests, responses and events of a session are delivered to that
+ * session's socket only. Thread-safe.
+ */
+class FMcpSessionStore
+{
+public:
+    /** What to do with an incoming request. */
+    enum class EAdmission : uint8
+    {
+        /** New request; run it. */
+        Execute,
+        /** Already answered; OutResponse holds the serialized response. */
+        Replay,
+        /** Still running; its response will go to this socket. */
+        Attach,
+    };
+
+    void Configure(double InResumeWindowSeconds, double InReplayWindowSeconds, int32 InMaxResponses,
+                   int64 InMaxBytes);
+    double GetResumeWindowSeconds() const { return ResumeWindowSeconds; }
+
+    /**
+     * Attaches Socket to the session ResumeId names, or to a new session when
+     * it is empty, unknown or expired. On resume, OutUndelivered holds the
+     * responses and events that completed while the session was detached,
+     * oldest first, OutRunning the requestIds still executing and
+     * OutNotReplayable those of both whose streamed chunks may be lost.
+     */
+    FString Attach(const TSharedPtr<FMcpBridgeWebSocket>& Socket, const FString& ResumeId, bool& bOutResumed,
+                   TArray<FString>& OutUndelivered, TArray<FString>& OutRunning, TArray<FString>& OutNotReplayable);
+    /**
+     * Keeps the socket's session for the resume window. A clean close drops
+     * it instead when nothing is running or waiting to be delivered.
+     */
+    void Detach(const FMcpBridgeWebSocket* Socket, bool bClean);
+
+    /** Classifies a request from Socket; requests from sockets without a session always execute. */
+    EAdmission Admit(const FMcpBridgeWebSocket* Socket, const FString& RequestId, FString& OutResponse);
+
+    /**
+     * The socket a session request's response goes to. Clients pick their
+     * own requestIds, so the request is told apart by Requester, the socket
+     * it was admitted from (or one its session resumed on); without one only
+     * an id a single session is running resolves. Returns false when the
+     * request does not belong to a session; OutSocket is null while the
+     * session is detached. OutSessionId names the owning session.
+     */
+    bool ResolveSocket(const FMcpBridgeWebSocket* Requester, const FString& RequestId,
+                       TSharedPtr<FMcpBridgeWebSocket>& OutSocket, FString& OutSessionId) const;
+
+    /** Buffers a session request's response; undelivered ones are sent on resume. */
+    void Complete(const FString& SessionId, const FString& RequestId, const FString& Serialized, bool bDelivered);
+
+    /** Notes that a running session request sent chunks, which are not buffered. */
+    void MarkStreamed(const FString& SessionId, const FString& RequestId);
+
+    /** The session Socket is attached to; empty when it has none. */
+    FString FindSession(const FMcpBridgeWebSocket* Socket) const;
+    /**
+     * The socket a session's events go to. Returns false when the session
+     * is no longer held; OutSocket is null while it is detached.
+     */
+    bool ResolveSessionSocket(const FString& SessionId, TSharedPtr<FMcpBridgeWebSocket>& OutSocket) const;
+    /** Buffers an event of the session; undelivered ones are sent on resume. */
+    void AddEvent(const FString& SessionId, const FString& Serialized, bool bDelivered);
+
+    /** Drops expired sessions and responses. */
+    void Tick(double NowSeconds);
+    void Reset();
+
+    /**
+     * {attached, detached, bufferedResponses, bufferedBytes, undelivered,
+     * resumed, replayed, attachedDuplicates, expired}
+     */
+    TSharedPtr<FJsonObject> GetStatsJson() const;
+    void AppendPrometheusText(FString& Out) const;
+
+private:
+    struct FResponse
+    {
+        FString RequestId;
+        FString Serialized;
+        double CompletedSeconds = 0.0;
+        int64 Bytes = 0;
+        bool bDelivered = false;
+        /** A job event; never answers a duplicate request. */
+        bool bEvent = false;
+        /** The request sent chunks, so this terminator alone is not its answer. */
+        bool bStreamed = false;
+    };
+
+    struct FSession
+    {
+        TWeakPtr<FMcpBridgeWebSocket> Socket;
+        const FMcpBridgeWebSocket* SocketPtr = nullptr;
+        double DetachedSeconds = 0.0;
+        /** Completed responses, oldest first. */
+        TArray<FResponse> Responses;
+        int64 ResponseBytes = 0;
+        TSet<FString> Running;
+        /** Running requests that sent chunks. */
+        TSet<FString> Streamed;
+    };
+
+    /** A running session request and the socket that sent it. */
+    struct FRequestOwner
+    {
+        FString SessionId;
+        const FMcpBridgeWebSocket* Socket = nullptr;
+    };
+
+    const FRequestOwner* FindRequest(const FMcpBridgeWebSocket* Requester, const FString& RequestId) const;
+    void RemoveRequest(const FString& SessionId, const FString& RequestId);
+    void AddResponse(FSession& Session, const FString& RequestId, const FString& Serialized, bool bDelivered);
+    void TrimResponses(FSession& Session, double NowSeconds);
+    static void RemoveResponse(FSession& Session, int32 Index);
+
+    mutable FCriticalSection Mutex;
+    TMap<FString, FSession> Sessions;
+    TMap<const FMcpBridgeWebSocket*, FString> SocketSessions;
+    /** Owners of every running session request by requestId; several sessions may use the same id. */
+    TMultiMap<FString, FRequestOwner> RequestSessions;
+
+    double ResumeWindowSeconds = 300.0;
+    double ReplayWindowSeconds = 300.0;
+    int32 MaxResponses = 64;
+    int64 MaxBytes = 16 * 1024 * 1024;
+
+    uint64 ResumedSessions = 0;
+    uint64 ReplayedResponses = 0;
+    uint64 AttachedDuplicates = 0;
+    uint64 ExpiredSessions = 0;
+};
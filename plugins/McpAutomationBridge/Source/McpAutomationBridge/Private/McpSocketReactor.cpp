@@ -0,0 +1,579 @@
+#include "McpSocketReactor.h"
+
+#include "McpAutomationBridgeSubsystem.h"
+#include "McpBridgeWebSocket.h"
+
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#else
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#if PLATFORM_LINUX
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
+namespace
+{
+    /** Wait used when no connection has a deadline; only bounds how long a lost wake could go unnoticed. */
+    constexpr int32 McpReactorIdleWaitMs = 1000;
+    /** Bytes read per readiness event before other handles get a turn. */
+    constexpr int32 McpReactorReadChunk = 64 * 1024;
+    constexpr int32 McpReactorMaxEvents = 64;
+
+#if PLATFORM_WINDOWS
+    using FMcpNativeSocket = SOCKET;
+    using FMcpPollFd = WSAPOLLFD;
+    // WSAPoll rejects POLLPRI, which POLLIN includes on some SDKs.
+    constexpr short McpPollRead = POLLRDNORM;
+    constexpr short McpPollWrite = POLLWRNORM;
+
+    bool McpWouldBlock() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+    bool McpInterrupted() { return WSAGetLastError() == WSAEINTR; }
+    int McpPoll(FMcpPollFd* Fds, int32 Num, int32 TimeoutMs) { return WSAPoll(Fds, static_cast<ULONG>(Num), TimeoutMs); }
+#else
+    using FMcpNativeSocket = int;
+    using FMcpPollFd = pollfd;
+    constexpr short McpPollRead = POLLIN;
+    constexpr short McpPollWrite = POLLOUT;
+
+    bool McpWouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK; }
+    bool McpInterrupted() { return errno == EINTR; }
+    int McpPoll(FMcpPollFd* Fds, int32 Num, int32 TimeoutMs) { return poll(Fds, static_cast<nfds_t>(Num), TimeoutMs); }
+#endif
+
+    FMcpNativeSocket McpToNative(UPTRINT Handle) { return static_cast<FMcpNativeSocket>(Handle); }
+
+    bool McpSetNonBlocking(UPTRINT Handle)
+    {
+#if PLATFORM_WINDOWS
+        u_long NonBlocking = 1;
+        return ioctlsocket(McpToNative(Handle), FIONBIO, &NonBlocking) == 0;
+#else
+        const int Flags = fcntl(McpToNative(Handle), F_GETFL, 0);
+        return Flags >= 0 && fcntl(McpToNative(Handle), F_SETFL, Flags | O_NONBLOCK) == 0;
+#endif
+    }
+
+    void McpConfigureAcceptedSocket(UPTRINT Handle)
+    {
+        int NoDelay = 1;
+        setsockopt(McpToNative(Handle), IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&NoDelay),
+                   sizeof(NoDelay));
+#if PLATFORM_MAC
+        // Linux passes MSG_NOSIGNAL per send; macOS only has the socket option.
+        int NoSigPipe = 1;
+        setsockopt(McpToNative(Handle), SOL_SOCKET, SO_NOSIGPIPE, &NoSigPipe, sizeof(NoSigPipe));
+#endif
+    }
+
+    FString McpDescribePeer(const sockaddr_storage& Address, socklen_t Length)
+    {
+        char Host[NI_MAXHOST] = {};
+        char Service[NI_MAXSERV] = {};
+        if (getnameinfo(reinterpret_cast<const sockaddr*>(&Address), Length, Host, sizeof(Host), Service,
+                        sizeof(Service), NI_NUMERICHOST | NI_NUMERICSERV) != 0)
+        {
+            return TEXT("(unknown peer)");
+        }
+        return FString::Printf(TEXT("%s:%s"), ANSI_TO_TCHAR(Host), ANSI_TO_TCHAR(Service));
+    }
+}
+
+FMcpSocketReactor::FMcpSocketReactor(const TSharedPtr<FMcpBridgeWebSocket>& InServer, int64 InMaxSendQueueBytes)
+    : Server(InServer)
+    , MaxSendQueueBytes(FMath::Max<int64>(InMaxSendQueueBytes, 64 * 1024))
+{
+}
+
+FMcpSocketReactor::~FMcpSocketReactor()
+{
+    Shutdown();
+}
+
+bool FMcpSocketReactor::Start(bool& bOutListenFailed)
+{
+    bOutListenFailed = false;
+    if (Thread)
+    {
+        return true;
+    }
+    bStopping = false;
+    WeakSelf = AsShared();
+    // The wake channel and the listen handle exist before the thread so other
+    // threads never see them change underneath them, and so a listener the
+    // reactor cannot take over is known before Listen commits to it.
+    if (!CreatePoller() || !OpenListener(bOutListenFailed))
+    {
+        CloseListener();
+        DestroyPoller();
+        return false;
+    }
+    Thread = FRunnableThread::Create(this, TEXT("McpBridgeSocketReactor"), 0, TPri_Normal);
+    if (!Thread)
+    {
+        CloseListener();
+        DestroyPoller();
+        return false;
+    }
+    return true;
+}
+
+bool FMcpSocketReactor::OpenListener(bool& bOutListenFailed)
+{
+    TSharedPtr<FMcpBridgeWebSocket> Pinned = Server.Pin();
+    if (!Pinned.IsValid())
+    {
+        return false;
+    }
+    if (!Pinned->OpenListenSocket())
+    {
+        bOutListenFailed = true;
+        return false;
+    }
+    ListenHandle = Pinned->ReleaseListenSocket();
+    Port = Pinned->GetPort();
+    if (ListenHandle == 0 || !McpSetNonBlocking(ListenHandle) || !AddHandle(ListenHandle))
+    {
+        UE_LOG(LogMcpAutomationBridgeSubsystem, Warning,
+               TEXT("Socket reactor could not take over the listen socket on port %d."), Port);
+        return false;
+    }
+    return true;
+}
+
+void FMcpSocketReactor::CloseListener()
+{
+    if (ListenHandle != 0)
+    {
+        RemoveHandle(ListenHandle);
+        CloseNative(ListenHandle);
+        ListenHandle = 0;
+    }
+    if (TSharedPtr<FMcpBridgeWebSocket> Pinned = Server.Pin())
+    {
+        Pinned->bListening = false;
+    }
+}
+
+void FMcpSocketReactor::Shutdown()
+{
+    if (Thread)
+    {
+        Stop();
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+    DestroyPoller();
+}
+
+void FMcpSocketReactor::Stop()
+{
+    bStopping = true;
+    Wake();
+}
+
+void FMcpSocketReactor::Wake()
+{
+    // Coalesce: one pending wake is enough for any number of requests.
+    if (WakeHandle == 0 || bWakePending.exchange(true))
+    {
+        return;
+    }
+#if PLATFORM_LINUX
+    const uint64 One = 1;
+    const ssize_t Written = write(static_cast<int>(WakeHandle), &One, sizeof(One));
+    (void)Written;
+#else
+    const char Byte = 0;
+    send(McpToNative(WakeHandle), &Byte, 1, 0);
+#endif
+}
+
+void FMcpSocketReactor::DrainWake()
+{
+#if PLATFORM_LINUX
+    uint64 Value = 0;
+    while (read(static_cast<int>(WakeHandle), &Value, sizeof(Value)) > 0)
+    {
+    }
+#else
+    char Buffer[64];
+    while (recv(McpToNative(WakeHandle), Buffer, sizeof(Buffer), 0) > 0)
+    {
+    }
+#endif
+    // Cleared after draining: a Wake racing with this still finds its state
+    // change picked up by the pump that follows.
+    bWakePending = false;
+}
+
+void FMcpSocketReactor::GetStats(FMcpSocketReactorStats& Out) const
+{
+    Out.Connections = ConnectionCount.load(std::memory_order_relaxed);
+    Out.QueuedSendBytes = QueuedSendBytes.load(std::memory_order_relaxed);
+    Out.AcceptedConnections = AcceptedConnections.load(std::memory_order_relaxed);
+    Out.BackpressureRejects = BackpressureRejects.load(std::memory_order_relaxed);
+}
+
+FMcpSocketReactor::EIoResult FMcpSocketReactor::SendNative(UPTRINT Handle, const uint8* Data, int32 Length,
+                                                           int32& OutBytesSent)
+{
+    OutBytesSent = 0;
+    for (;;)
+    {
+#if PLATFORM_LINUX
+        const auto Result = send(McpToNative(Handle), Data, Length, MSG_NOSIGNAL);
+#else
+        const auto Result = send(McpToNative(Handle), reinterpret_cast<const char*>(Data), Length, 0);
+#endif
+        if (Result >= 0)
+        {
+            OutBytesSent = static_cast<int32>(Result);
+            return Result > 0 ? EIoResult::Done : EIoResult::WouldBlock;
+        }
+        if (McpInterrupted())
+        {
+            continue;
+        }
+        return McpWouldBlock() ? EIoResult::WouldBlock : EIoResult::Error;
+    }
+}
+
+FMcpSocketReactor::EIoResult FMcpSocketReactor::RecvNative(UPTRINT Handle, uint8* Data, int32 Length,
+                                                           int32& OutBytesRead)
+{
+    OutBytesRead = 0;
+    for (;;)
+    {
+        const auto Result = recv(McpToNative(Handle), reinterpret_cast<char*>(Data), Length, 0);
+        if (Result > 0)
+        {
+            OutBytesRead = static_cast<int32>(Result);
+            return EIoResult::Done;
+        }
+        if (Result == 0)
+        {
+            return EIoResult::Closed;
+        }
+        if (McpInterrupted())
+        {
+            continue;
+        }
+        return McpWouldBlock() ? EIoResult::WouldBlock : EIoResult::Error;
+    }
+}
+
+void FMcpSocketReactor::CloseNative(UPTRINT Handle)
+{
+    if (Handle == 0)
+    {
+        return;
+    }
+#if PLATFORM_WINDOWS
+    closesocket(McpToNative(Handle));
+#else
+    close(McpToNative(Handle));
+#endif
+}
+
+bool FMcpSocketReactor::CreatePoller()
+{
+#if PLATFORM_LINUX
+    EpollHandle = epoll_create1(EPOLL_CLOEXEC);
+    if (EpollHandle < 0)
+    {
+        return false;
+    }
+    const int EventHandle = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (EventHandle < 0)
+    {
+        return false;
+    }
+    WakeHandle = static_cast<UPTRINT>(EventHandle);
+    return AddHandle(WakeHandle);
+#else
+    // No eventfd: a datagram socket connected to its own loopback address.
+    const FMcpNativeSocket WakeSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+#if PLATFORM_WINDOWS
+    if (WakeSocket == INVALID_SOCKET)
+#else
+    if (WakeSocket < 0)
+#endif
+    {
+        return false;
+    }
+    WakeHandle = static_cast<UPTRINT>(WakeSocket);
+
+    sockaddr_in Address = {};
+    Address.sin_family = AF_INET;
+    Address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    Address.sin_port = 0;
+    socklen_t AddressLength = sizeof(Address);
+    if (bind(WakeSocket, reinterpret_cast<const sockaddr*>(&Address), sizeof(Address)) != 0 ||
+        getsockname(WakeSocket, reinterpret_cast<sockaddr*>(&Address), &AddressLength) != 0 ||
+        connect(WakeSocket, reinterpret_cast<const sockaddr*>(&Address), AddressLength) != 0)
+    {
+        return false;
+    }
+    return McpSetNonBlocking(WakeHandle);
+#endif
+}
+
+void FMcpSocketReactor::DestroyPoller()
+{
+#if PLATFORM_LINUX
+    if (WakeHandle != 0)
+    {
+        close(static_cast<int>(WakeHandle));
+    }
+    if (EpollHandle >= 0)
+    {
+        close(EpollHandle);
+        EpollHandle = -1;
+    }
+#else
+    CloseNative(WakeHandle);
+#endif
+    WakeHandle = 0;
+}
+
+bool FMcpSocketReactor::AddHandle(UPTRINT Handle)
+{
+    WriteInterest.Add(Handle, false);
+#if PLATFORM_LINUX
+    epoll_event Event = {};
+    Event.events = EPOLLIN;
+    Event.data.u64 = static_cast<uint64>(Handle);
+    return epoll_ctl(EpollHandle, EPOLL_CTL_ADD, static_cast<int>(Handle), &Event) == 0;
+#else
+    return true;
+#endif
+}
+
+void FMcpSocketReactor::RemoveHandle(UPTRINT Handle)
+{
+    WriteInterest.Remove(Handle);
+#if PLATFORM_LINUX
+    epoll_ctl(EpollHandle, EPOLL_CTL_DEL, static_cast<int>(Handle), nullptr);
+#endif
+}
+
+void FMcpSocketReactor::SetWriteInterest(UPTRINT Handle, bool bWantsWrite)
+{
+    bool* Current = WriteInterest.Find(Handle);
+    if (!Current || *Current == bWantsWrite)
+    {
+        return;
+    }
+    *Current = bWantsWrite;
+#if PLATFORM_LINUX
+    epoll_event Event = {};
+    Event.events = EPOLLIN | (bWantsWrite ? EPOLLOUT : 0);
+    Event.data.u64 = static_cast<uint64>(Handle);
+    epoll_ctl(EpollHandle, EPOLL_CTL_MOD, static_cast<int>(Handle), &Event);
+#endif
+}
+
+void FMcpSocketReactor::WaitForEvents(int32 TimeoutMs, TArray<FReadyHandle>& OutReady)
+{
+    OutReady.Reset();
+#if PLATFORM_LINUX
+    epoll_event Events[McpReactorMaxEvents];
+    const int Count = epoll_wait(EpollHandle, Events, McpReactorMaxEvents, TimeoutMs);
+    for (int Index = 0; Index < Count; ++Index)
+    {
+        FReadyHandle& Ready = OutReady.AddDefaulted_GetRef();
+        Ready.Handle = static_cast<UPTRINT>(Events[Index].data.u64);
+        // Errors and hang-ups surface through the next recv.
+        Ready.bReadable = (Events[Index].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) != 0;
+        Ready.bWritable = (Events[Index].events & EPOLLOUT) != 0;
+    }
+#else
+    TArray<FMcpPollFd, TInlineAllocator<McpReactorMaxEvents>> Fds;
+    Fds.Reserve(WriteInterest.Num() + 1);
+    {
+        FMcpPollFd& Wake = Fds.AddZeroed_GetRef();
+        Wake.fd = McpToNative(WakeHandle);
+        Wake.events = McpPollRead;
+    }
+    for (const TPair<UPTRINT, bool>& Pair : WriteInterest)
+    {
+        FMcpPollFd& Fd = Fds.AddZeroed_GetRef();
+        Fd.fd = McpToNative(Pair.Key);
+        Fd.events = McpPollRead | (Pair.Value ? McpPollWrite : 0);
+    }
+    if (McpPoll(Fds.GetData(), Fds.Num(), TimeoutMs) <= 0)
+    {
+        return;
+    }
+    for (const FMcpPollFd& Fd : Fds)
+    {
+        if (Fd.revents == 0)
+        {
+            continue;
+        }
+        FReadyHandle& Ready = OutReady.AddDefaulted_GetRef();
+        Ready.Handle = static_cast<UPTRINT>(Fd.fd);
+        Ready.bReadable = (Fd.revents & (McpPollRead | POLLERR | POLLHUP | POLLNVAL)) != 0;
+        Ready.bWritable = (Fd.revents & McpPollWrite) != 0;
+    }
+#endif
+}
+
+uint32 FMcpSocketReactor::Run()
+{
+    UE_LOG(LogMcpAutomationBridgeSubsystem, Log,
+           TEXT("Socket reactor serving the listener (%s, send queue cap %lld KB)."),
+           PLATFORM_LINUX ? TEXT("epoll") : TEXT("poll"), static_cast<long long>(MaxSendQueueBytes / 1024));
+
+    TArray<FReadyHandle> Ready;
+    TArray<UPTRINT> Finished;
+    while (!bStopping)
+    {
+        // Give every connection its turn for close requests, handler
+        // deadlines and queued sends before sleeping.
+        double Now = FPlatformTime::Seconds();
+        double WaitSeconds = McpReactorIdleWaitMs / 1000.0;
+        Finished.Reset();
+        for (const TPair<UPTRINT, TSharedPtr<FMcpBridgeWebSocket>>& Pair : Connections)
+        {
+            bool bWantsWrite = false;
+            if (!Pair.Value->PumpReactor(Now, bWantsWrite, WaitSeconds))
+            {
+                Finished.Add(Pair.Key);
+                continue;
+            }
+            SetWriteInterest(Pair.Key, bWantsWrite);
+        }
+        for (const UPTRINT Handle : Finished)
+        {
+            RemoveConnection(Handle);
+        }
+
+        const int32 TimeoutMs = FMath::Clamp(FMath::CeilToInt(WaitSeconds * 1000.0), 0, McpReactorIdleWaitMs);
+        WaitForEvents(TimeoutMs, Ready);
+        if (bStopping)
+        {
+            break;
+        }
+
+        Now = FPlatformTime::Seconds();
+        for (const FReadyHandle& Event : Ready)
+        {
+            if (Event.Handle == WakeHandle)
+            {
+                DrainWake();
+                continue;
+            }
+            if (Event.Handle == ListenHandle)
+            {
+                AcceptPending(Now);
+                continue;
+            }
+            const TSharedPtr<FMcpBridgeWebSocket>* Connection = Connections.Find(Event.Handle);
+            if (!Connection)
+            {
+                continue;
+            }
+            const TSharedPtr<FMcpBridgeWebSocket> Pinned = *Connection;
+            if ((Event.bWritable && !Pinned->HandleReactorWritable()) ||
+                (Event.bReadable && !Pinned->HandleReactorReadable(Now, McpReactorReadChunk)))
+            {
+                RemoveConnection(Event.Handle);
+            }
+        }
+    }
+
+    TearDownAll();
+    CloseListener();
+    return 0;
+}
+
+void FMcpSocketReactor::AcceptPending(double NowSeconds)
+{
+    for (;;)
+    {
+        sockaddr_storage PeerAddress = {};
+        socklen_t PeerLength = sizeof(PeerAddress);
+        const FMcpNativeSocket Accepted =
+            accept(McpToNative(ListenHandle), reinterpret_cast<sockaddr*>(&PeerAddress), &PeerLength);
+#if PLATFORM_WINDOWS
+        if (Accepted == INVALID_SOCKET)
+#else
+        if (Accepted < 0)
+#endif
+        {
+            if (!McpWouldBlock() && !McpInterrupted())
+            {
+                UE_LOG(LogMcpAutomationBridgeSubsystem, Warning, TEXT("Socket reactor accept failed."));
+            }
+            return;
+        }
+
+        const UPTRINT Handle = static_cast<UPTRINT>(Accepted);
+        if (!McpSetNonBlocking(Handle))
+        {
+            CloseNative(Handle);
+            continue;
+        }
+        McpConfigureAcceptedSocket(Handle);
+
+        UE_LOG(LogMcpAutomationBridgeSubsystem, Log, TEXT("Accepted automation client from %s"),
+               *McpDescribePeer(PeerAddress, PeerLength));
+
+        if (!AddHandle(Handle))
+        {
+            RemoveHandle(Handle);
+            CloseNative(Handle);
+            continue;
+        }
+        TSharedPtr<FMcpBridgeWebSocket> Connection =
+            FMcpBridgeWebSocket::CreateReactorConnection(Handle, Port, Server, WeakSelf, NowSeconds);
+        Connections.Add(Handle, Connection);
+        ConnectionCount.fetch_add(1, std::memory_order_relaxed);
+        AcceptedConnections.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void FMcpSocketReactor::RemoveConnection(UPTRINT Handle)
+{
+    TSharedPtr<FMcpBridgeWebSocket> Connection;
+    if (!Connections.RemoveAndCopyValue(Handle, Connection))
+    {
+        return;
+    }
+    RemoveHandle(Handle);
+    CloseNative(Connection->ReleaseReactorHandle());
+    ConnectionCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void FMcpSocketReactor::TearDownAll()
+{
+    TArray<UPTRINT> Handles;
+    Connections.GetKeys(Handles);
+    for (const UPTRINT Handle : Handles)
+    {
+        if (const TSharedPtr<FMcpBridgeWebSocket>* Connection = Connections.Find(Handle))
+        {
+            (*Connection)->TearDownFromReactor(TEXT("Automation bridge server stopped."));
+        }
+        RemoveConnection(Handle);
+    }
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+#include <atomic>
+
+class FMcpBridgeWebSocket;
+class FRunnableThread;
+
+// The reactor takes over native handles with FSocket::ReleaseNativeSocket,
+// which older engines do not have; they keep a worker thread per connection.
+#ifndef MCP_WITH_SOCKET_REACTOR
+  #if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 7)
+    #define MCP_WITH_SOCKET_REACTOR 1
+  #else
+    #define MCP_WITH_SOCKET_REACTOR 0
+  #endif
+#endif
+
+/** Point-in-time counters for one listener's reactor. */
+struct FMcpSocketReactorStats
+{
+    int32 Connections = 0;
+    int64 QueuedSendBytes = 0;
+    uint64 AcceptedConnections = 0;
+    uint64 BackpressureRejects = 0;
+};
+
+/**
+ * One I/O thread that serves a listening socket and every connection it
+ * accepts, instead of a blocking worker thread per connection.
+ *
+ * The thread waits on all handles at once (epoll on Linux, poll/WSAPoll
+ * elsewhere) and only wakes for readiness, a wake request or the nearest
+ * per-connection deadline. Reads, the HTTP upgrade, frame parsing and
+ * teardown all run here; messages still reach the game thread through the
+ * socket's delegates.
+ *
+ * Sends are written straight from the calling thread while the connection's
+ * send queue is empty. Whatever the kernel does not take is queued and
+ * flushed here when the handle becomes writable. A send that would grow a
+ * non-empty queue past the cap is refused and the connection closed, so a
+ * stalled client cannot make the editor buffer without bound; it resumes
+ * its session on reconnect.
+ *
+ * The reactor owns the native handles; connections only borrow them and
+ * hand them back on removal. Connections hold it weakly; the listener that
+ * owns it shuts it down before letting go.
+ */
+class FMcpSocketReactor final : public FRunnable, public TSharedFromThis<FMcpSocketReactor>
+{
+public:
+    enum class EIoResult : uint8
+    {
+        /** Some bytes were transferred. */
+        Done,
+        /** Nothing transferred; wait for readiness. */
+        WouldBlock,
+        /** The peer closed the connection (reads only). */
+        Closed,
+        Error,
+    };
+
+    FMcpSocketReactor(const TSharedPtr<FMcpBridgeWebSocket>& InServer, int64 InMaxSendQueueBytes);
+    virtual ~FMcpSocketReactor() override;
+
+    FMcpSocketReactor(const FMcpSocketReactor&) = delete;
+    FMcpSocketReactor& operator=(const FMcpSocketReactor&) = delete;
+
+    /**
+     * Opens the server's listen socket, takes over its handle and spawns the
+     * I/O thread. On failure the listen socket is closed again so the server
+     * can fall back to worker threads; bOutListenFailed is set when the
+     * socket could not be opened at all, which a worker would hit as well.
+     */
+    bool Start(bool& bOutListenFailed);
+    /** Stops the thread, tears down every connection and closes all handles. */
+    void Shutdown();
+    /** Makes the I/O thread re-check connection state (queued sends, close requests). */
+    void Wake();
+
+    int64 GetMaxSendQueueBytes() const { return MaxSendQueueBytes; }
+    void GetStats(FMcpSocketReactorStats& Out) const;
+
+    /** Bookkeeping for connection send queues. */
+    void AddQueuedSendBytes(int64 Delta) { QueuedSendBytes.fetch_add(Delta, std::memory_order_relaxed); }
+    void CountBackpressureReject() { BackpressureRejects.fetch_add(1, std::memory_order_relaxed); }
+
+    static EIoResult SendNative(UPTRINT Handle, const uint8* Data, int32 Length, int32& OutBytesSent);
+    static EIoResult RecvNative(UPTRINT Handle, uint8* Data, int32 Length, int32& OutBytesRead);
+    static void CloseNative(UPTRINT Handle);
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    struct FReadyHandle
+    {
+        UPTRINT Handle = 0;
+        bool bReadable = false;
+        bool bWritable = false;
+    };
+
+    bool CreatePoller();
+    void DestroyPoller();
+    bool AddHandle(UPTRINT Handle);
+    void RemoveHandle(UPTRINT Handle);
+    void SetWriteInterest(UPTRINT Handle, bool bWantsWrite);
+    void WaitForEvents(int32 TimeoutMs, TArray<FReadyHandle>& OutReady);
+    void DrainWake();
+
+    bool OpenListener(bool& bOutListenFailed);
+    /** Closes the listen handle and tells the server it is no longer listening. */
+    void CloseListener();
+
+    void AcceptPending(double NowSeconds);
+    void RemoveConnection(UPTRINT Handle);
+    void TearDownAll();
+
+    TWeakPtr<FMcpBridgeWebSocket> Server;
+    TWeakPtr<FMcpSocketReactor> WeakSelf;
+    /** Listener port, reported by the connections it accepts. */
+    int32 Port = 0;
+    FRunnableThread* Thread = nullptr;
+    std::atomic<bool> bStopping{false};
+    int64 MaxSendQueueBytes = 0;
+
+    UPTRINT ListenHandle = 0;
+    /** Wake channel: an eventfd on Linux, a loopback datagram socket connected to itself elsewhere. */
+    UPTRINT WakeHandle = 0;
+#if PLATFORM_LINUX
+    int32 EpollHandle = -1;
+#endif
+
+    /** Owned by the I/O thread. */
+    TMap<UPTRINT, TSharedPtr<FMcpBridgeWebSocket>> Connections;
+    TMap<UPTRINT, bool> WriteInterest;
+
+    std::atomic<bool> bWakePending{false};
+    std::atomic<int32> ConnectionCount{0};
+    std::atomic<int64> QueuedSendBytes{0};
+    std::atomic<uint64> AcceptedConnections{0};
+    std::atomic<uint64> BackpressureRejects{0};
+};
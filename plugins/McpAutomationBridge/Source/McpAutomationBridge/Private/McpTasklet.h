@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "McpAutomationBridgeSettings.h"
+
+class FMcpBridgeWebSocket;
+
+/**
+ * A bulk handler's work split into steps that run on the game thread within a
+ * per-frame time budget.
+ *
+ * UMcpAutomationBridgeSubsystem::StartTasklet runs as many steps as fit in the
+ * budget right away (small requests still finish inline) and resumes the rest
+ * from an FTSTicker on following frames, round-robin across running tasklets.
+ * The request stays open meanwhile: progress_update messages keep the client's
+ * timeout alive and Finish sends the final response. See
+ * McpAutomationBridge_Tasklets.cpp.
+ *
+ * Steps must not keep raw UObject pointers across calls; garbage collection
+ * can run between frames.
+ */
+struct FMcpTasklet
+{
+    /** Short label used in progress messages and queue stats (e.g. "bulk_delete"). */
+    FString Name;
+    FString RequestId;
+    TSharedPtr<FMcpBridgeWebSocket> Socket;
+
+    /** Steps to run; Step is called with 0 .. NumSteps-1 in order. */
+    int32 NumSteps = 0;
+    int32 NextStep = 0;
+
+    double StartSeconds = 0.0;
+    double LastProgressSeconds = 0.0;
+
+    /** The requester's undo policy when the tasklet started; later steps run under it. */
+    EMcpTransactionPolicy TransactionPolicy = EMcpTransactionPolicy::Full;
+
+    /** Runs one step. Return false to stop early; Finish still runs. */
+    TFunction<bool(int32 StepIndex)> Step;
+
+    /** Runs once after the last step, an early stop or shutdown. Sends the response. */
+    TFunction<void(bool bAborted)> Finish;
+
+    bool IsDone() const { return NextStep >= NumSteps; }
+    float GetPercent() const { return NumSteps > 0 ? 100.0f * NextStep / NumSteps : 100.0f; }
+
+    TSharedPtr<FJsonObject> ToJson() const;
+};
@@ -0,0 +1,405 @@
+#include "McpTransactionPolicy.h"
+
+#include "McpAutomationBridgeHelpers.h"
+#include "McpAutomationBridgeSubsystem.h"
+
+#if WITH_EDITOR
+#include "Editor.h"
+#include "Editor/TransBuffer.h"
+#include "Editor/Transactor.h"
+#include "ScopedTransaction.h"
+#endif
+
+namespace
+{
+    constexpr uint64 McpBytesPerMB = 1024ull * 1024ull;
+
+#if WITH_EDITOR
+    UTransBuffer* McpGetTransBuffer()
+    {
+        return GEditor ? Cast<UTransBuffer>(GEditor->Trans) : nullptr;
+    }
+#endif
+
+    /**
+     * Handlers that open their own transaction and undo it on failure; an
+     * outer transaction would swallow the rollback, and a cancelled one would
+     * leave nothing to roll back.
+     */
+    bool McpOwnsTransaction(const FString& Action, const TSharedPtr<FJsonObject>& Payload)
+    {
+        // set_transaction_policy may reset the buffer, which needs it idle.
+        if (Action.Equals(TEXT("batch"), ESearchCase::IgnoreCase) ||
+            Action.Equals(TEXT("set_transaction_policy"), ESearchCase::IgnoreCase))
+        {
+            return true;
+        }
+        // for_each_region runs every tile as a batch with its own transaction.
+        if (Action.Equals(TEXT("manage_world_partition"), ESearchCase::IgnoreCase))
+        {
+            return GetJsonStringField(Payload, TEXT("subAction")).Equals(TEXT("for_each_region"), ESearchCase::IgnoreCase);
+        }
+        if (Action.Equals(TEXT("manage_blueprint_graph"), ESearchCase::IgnoreCase))
+        {
+            return GetJsonStringField(Payload, TEXT("subAction")).Equals(TEXT("apply_graph_patch"), ESearchCase::IgnoreCase);
+        }
+        if (Action.StartsWith(TEXT("control_editor"), ESearchCase::IgnoreCase))
+        {
+            const FString SubAction = GetJsonStringField(Payload, TEXT("action")).ToLower();
+            return SubAction == TEXT("undo") || SubAction == TEXT("redo");
+        }
+        return false;
+    }
+}
+
+FMcpTransactionPolicy& FMcpTransactionPolicy::Get()
+{
+    static FMcpTransactionPolicy Instance;
+    return Instance;
+}
+
+void FMcpTransactionPolicy::Configure(EMcpTransactionPolicy InPolicy, int32 UndoBufferMaxMB)
+{
+    DefaultPolicy = InPolicy;
+    SetUndoBufferMaxMB(UndoBufferMaxMB);
+}
+
+void FMcpTransactionPolicy::Shutdown()
+{
+    RestoreEditorLimit();
+    CapBytes = 0;
+    DefaultPolicy = EMcpTransactionPolicy::Full;
+    ClientPolicies.Empty();
+}
+
+EMcpTransactionPolicy FMcpTransactionPolicy::GetPolicy(const FMcpBridgeWebSocket* Client) const
+{
+    const EMcpTransactionPolicy* ClientPolicy = Client ? ClientPolicies.Find(Client) : nullptr;
+    return ClientPolicy ? *ClientPolicy : DefaultPolicy;
+}
+
+void FMcpTransactionPolicy::SetPolicy(const FMcpBridgeWebSocket* Client, EMcpTransactionPolicy InPolicy)
+{
+    if (Client)
+    {
+        ClientPolicies.Add(Client, InPolicy);
+    }
+    else
+    {
+        DefaultPolicy = InPolicy;
+    }
+}
+
+void FMcpTransactionPolicy::ClearClientPolicy(const FMcpBridgeWebSocket* Client)
+{
+    ClientPolicies.Remove(Client);
+}
+
+void FMcpTransactionPolicy::SetUndoBufferMaxMB(int32 UndoBufferMaxMB)
+{
+    CapBytes = static_cast<uint64>(FMath::Max(0, UndoBufferMaxMB)) * McpBytesPerMB;
+    if (CapBytes == 0)
+    {
+        RestoreEditorLimit();
+    }
+    // The editor limit is applied from Tick; the transaction buffer may not
+    // exist yet while the subsystem initializes.
+    CheckedNum = INDEX_NONE;
+    CheckedUndoCount = INDEX_NONE;
+}
+
+void FMcpTransactionPolicy::RestoreEditorLimit()
+{
+#if WITH_EDITOR
+    if (EditorMaxMemory > 0)
+    {
+        if (UTransBuffer* Buffer = McpGetTransBuffer())
+        {
+            Buffer->MaxMemory = static_cast<SIZE_T>(EditorMaxMemory);
+        }
+    }
+#endif
+    EditorMaxMemory = 0;
+}
+
+const TCHAR* FMcpTransactionPolicy::PolicyName(EMcpTransactionPolicy InPolicy)
+{
+    switch (InPolicy)
+    {
+    case EMcpTransactionPolicy::Coalesced:
+        return TEXT("coalesced");
+    case EMcpTransactionPolicy::None:
+        return TEXT("none");
+    default:
+        return TEXT("full");
+    }
+}
+
+bool FMcpTransactionPolicy::ParsePolicy(const FString& Name, EMcpTransactionPolicy& OutPolicy)
+{
+    const FString Lower = Name.TrimStartAndEnd().ToLower();
+    if (Lower == TEXT("full"))
+    {
+        OutPolicy = EMcpTransactionPolicy::Full;
+    }
+    else if (Lower == TEXT("coalesced"))
+    {
+        OutPolicy = EMcpTransactionPolicy::Coalesced;
+    }
+    else if (Lower == TEXT("none"))
+    {
+        OutPolicy = EMcpTransactionPolicy::None;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+void FMcpTransactionPolicy::Tick()
+{
+#if WITH_EDITOR
+    if (CapBytes == 0)
+    {
+        return;
+    }
+    UTransBuffer* Buffer = McpGetTransBuffer();
+    if (!Buffer)
+    {
+        return;
+    }
+    // Let the editor's own trim (when a transaction begins) use the cap too.
+    if (static_cast<uint64>(Buffer->MaxMemory) != CapBytes)
+    {
+        if (EditorMaxMemory == 0)
+        {
+            EditorMaxMemory = static_cast<uint64>(Buffer->MaxMemory);
+        }
+        Buffer->MaxMemory = static_cast<SIZE_T>(CapBytes);
+    }
+    if (Buffer->UndoBuffer.Num() != CheckedNum || Buffer->UndoCount != CheckedUndoCount)
+    {
+        EnforceCap();
+    }
+#endif
+}
+
+int32 FMcpTransactionPolicy::EnforceCap()
+{
+    int32 Evicted = 0;
+#if WITH_EDITOR
+    UTransBuffer* Buffer = McpGetTransBuffer();
+    if (CapBytes == 0 || !Buffer)
+    {
+        return 0;
+    }
+    // Barriers index into the buffer, and an open transaction is its last
+    // entry; try again once both are gone.
+    if (Buffer->IsActive() || Buffer->UndoBarrierStack.Num() > 0)
+    {
+        return 0;
+    }
+
+    uint64 Size = static_cast<uint64>(Buffer->GetUndoSize());
+    uint64 Bytes = 0;
+    // Redo entries and the newest undo entry are always kept.
+    while (Size > CapBytes && Buffer->UndoBuffer.Num() - Buffer->UndoCount > 1)
+    {
+        const uint64 EntryBytes = static_cast<uint64>(Buffer->UndoBuffer[0]->DataSize());
+        Buffer->UndoBuffer.RemoveAt(0);
+        Size -= FMath::Min(Size, EntryBytes);
+        Bytes += EntryBytes;
+        ++Evicted;
+    }
+    if (Evicted > 0)
+    {
+        EvictedTransactions += Evicted;
+        EvictedBytes += Bytes;
+        Buffer->OnUndoBufferChanged().Broadcast();
+        UE_LOG(LogMcpAutomationBridgeSubsystem, Verbose,
+               TEXT("Undo buffer over %llu MB: evicted %d transaction(s), %llu bytes."),
+               CapBytes / McpBytesPerMB, Evicted, Bytes);
+    }
+    CheckedNum = Buffer->UndoBuffer.Num();
+    CheckedUndoCount = Buffer->UndoCount;
+#endif
+    return Evicted;
+}
+
+void FMcpTransactionPolicy::ResetUndoBuffer(const FString& Reason)
+{
+#if WITH_EDITOR
+    if (UTransBuffer* Buffer = McpGetTransBuffer())
+    {
+        if (!Buffer->IsActive())
+        {
+            Buffer->Reset(FText::FromString(Reason));
+        }
+    }
+#endif
+}
+
+TSharedPtr<FJsonObject> FMcpTransactionPolicy::GetStatsJson(const FMcpBridgeWebSocket* Client) const
+{
+    uint64 Bytes = 0;
+    int32 UndoTransactions = 0;
+    int32 RedoTransactions = 0;
+#if WITH_EDITOR
+    if (const UTransBuffer* Buffer = McpGetTransBuffer())
+    {
+        Bytes = static_cast<uint64>(Buffer->GetUndoSize());
+        UndoTransactions = Buffer->UndoBuffer.Num() - Buffer->UndoCount;
+        RedoTransactions = Buffer->UndoCount;
+    }
+#endif
+
+    TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetStringField(TEXT("policy"), PolicyName(GetPolicy(Client)));
+    Json->SetStringField(TEXT("defaultPolicy"), PolicyName(DefaultPolicy));
+    Json->SetNumberField(TEXT("clientPolicies"), ClientPolicies.Num());
+    Json->SetNumberField(TEXT("undoBufferBytes"), static_cast<double>(Bytes));
+    Json->SetNumberField(TEXT("undoTransactions"), UndoTransactions);
+    Json->SetNumberField(TEXT("redoTransactions"), RedoTransactions);
+    Json->SetNumberField(TEXT("undoBufferCapBytes"), static_cast<double>(CapBytes));
+    Json->SetNumberField(TEXT("evictedTransactions"), static_cast<double>(EvictedTransactions));
+    Json->SetNumberField(TEXT("evictedBytes"), static_cast<double>(EvictedBytes));
+    Json->SetNumberField(TEXT("coalescedRequests"), static_cast<double>(CoalescedRequests));
+    Json->SetNumberField(TEXT("discardedRequests"), static_cast<double>(DiscardedRequests));
+    Json->SetNumberField(TEXT("coalescedAsyncSteps"), static_cast<double>(CoalescedAsyncSteps));
+    Json->SetNumberField(TEXT("discardedAsyncSteps"), static_cast<double>(DiscardedAsyncSteps));
+    return Json;
+}
+
+void FMcpTransactionPolicy::AppendPrometheusText(FString& Out) const
+{
+    const TSharedPtr<FJsonObject> Stats = GetStatsJson();
+
+    Out += TEXT("# HELP mcp_undo_buffer_bytes Serialized object state held by the editor undo buffer.\n");
+    Out += TEXT("# TYPE mcp_undo_buffer_bytes gauge\n");
+    Out += FString::Printf(TEXT("mcp_undo_buffer_bytes %.0f\n"), Stats->GetNumberField(TEXT("undoBufferBytes")));
+    Out += TEXT("# HELP mcp_undo_buffer_cap_bytes Undo buffer cap; 0 when the editor's own limit applies.\n");
+    Out += TEXT("# TYPE mcp_undo_buffer_cap_bytes gauge\n");
+    Out += FString::Printf(TEXT("mcp_undo_buffer_cap_bytes %llu\n"), CapBytes);
+    Out += TEXT("# HELP mcp_undo_transactions Transactions in the undo buffer.\n");
+    Out += TEXT("# TYPE mcp_undo_transactions gauge\n");
+    Out += FString::Printf(TEXT("mcp_undo_transactions{kind=\"undo\"} %d\n"),
+                           static_cast<int32>(Stats->GetNumberField(TEXT("undoTransactions"))));
+    Out += FString::Printf(TEXT("mcp_undo_transactions{kind=\"redo\"} %d\n"),
+                           static_cast<int32>(Stats->GetNumberField(TEXT("redoTransactions"))));
+    Out += TEXT("# HELP mcp_undo_evicted_transactions_total Transactions evicted to stay under the cap.\n");
+    Out += TEXT("# TYPE mcp_undo_evicted_transactions_total counter\n");
+    Out += FString::Printf(TEXT("mcp_undo_evicted_transactions_total %llu\n"), EvictedTransactions);
+    Out += TEXT("# HELP mcp_undo_evicted_bytes_total Bytes evicted to stay under the cap.\n");
+    Out += TEXT("# TYPE mcp_undo_evicted_bytes_total counter\n");
+    Out += FString::Printf(TEXT("mcp_undo_evicted_bytes_total %llu\n"), EvictedBytes);
+    Out += TEXT("# HELP mcp_undo_policy_requests_total Requests folded into one transaction or discarded by the policy.\n");
+    Out += TEXT("# TYPE mcp_undo_policy_requests_total counter\n");
+    Out += FString::Printf(TEXT("mcp_undo_policy_requests_total{outcome=\"coalesced\"} %llu\n"), CoalescedRequests);
+    Out += FString::Printf(TEXT("mcp_undo_policy_requests_total{outcome=\"discarded\"} %llu\n"), DiscardedRequests);
+    Out += TEXT("# HELP mcp_undo_policy_async_steps_total Tasklet and job steps folded into one transaction or discarded by the policy.\n");
+    Out += TEXT("# TYPE mcp_undo_policy_async_steps_total counter\n");
+    Out += FString::Printf(TEXT("mcp_undo_policy_async_steps_total{outcome=\"coalesced\"} %llu\n"), CoalescedAsyncSteps);
+    Out += FString::Printf(TEXT("mcp_undo_policy_async_steps_total{outcome=\"discarded\"} %llu\n"), DiscardedAsyncSteps);
+}
+
+FMcpRequestTransactionScope::FMcpRequestTransactionScope(const FString& Action, const TSharedPtr<FJsonObject>& Payload,
+                                                         bool bOutermost, const FMcpBridgeWebSocket* Client)
+    : Policy(FMcpTransactionPolicy::Get().GetPolicy(Client))
+{
+    if (bOutermost && !McpOwnsTransaction(Action, Payload))
+    {
+        Open(Action);
+    }
+}
+
+FMcpRequestTransactionScope::FMcpRequestTransactionScope(const FString& Name, EMcpTransactionPolicy InPolicy)
+    : Policy(InPolicy)
+    , bAsync(true)
+{
+    Open(Name);
+}
+
+void FMcpRequestTransactionScope::Open(const FString& Name)
+{
+#if WITH_EDITOR
+    if (Policy == EMcpTransactionPolicy::Full || !McpGetTransBuffer() || GEditor->IsTransactionActive())
+    {
+        return;
+    }
+    Transaction = MakeUnique<FScopedTransaction>(FText::FromString(FString::Printf(TEXT("MCP: %s"), *Name)));
+    if (!Transaction->IsOutstanding())
+    {
+        // PIE or an editor state that cannot transact.
+        Transaction.Reset();
+    }
+#endif
+}
+
+FMcpRequestTransactionScope::~FMcpRequestTransactionScope()
+{
+#if WITH_EDITOR
+    if (!Transaction.IsValid())
+    {
+        return;
+    }
+    FMcpTransactionPolicy& TransactionPolicy = FMcpTransactionPolicy::Get();
+    UTransBuffer* Buffer = McpGetTransBuffer();
+    // A transaction the handler left open for later frames is still active;
+    // cancelling would discard that one too, so let it absorb this request.
+    const bool bOnlyActive = Buffer && Buffer->ActiveCount == 1 && Buffer->UndoBuffer.Num() > 0;
+    const bool bEmpty = bOnlyActive && Buffer->UndoBuffer.Last()->GetRecordCount() == 0;
+    if (bOnlyActive && (bEmpty || Policy == EMcpTransactionPolicy::None))
+    {
+        // Keeps the changes; only the undo record is dropped.
+        Transaction->Cancel();
+        if (!bEmpty)
+        {
+            ++(bAsync ? TransactionPolicy.DiscardedAsyncSteps : TransactionPolicy.DiscardedRequests);
+        }
+    }
+    else if (!bEmpty)
+    {
+        ++(bAsync ? TransactionPolicy.CoalescedAsyncSteps : TransactionPolicy.CoalescedRequests);
+    }
+    Transaction.Reset();
+#endif
+}
+
+FMcpTransactionSnapshot::FMcpTransactionSnapshot()
+{
+#if WITH_EDITOR
+    Records = MakeUnique<FTransaction>(TEXT("McpSnapshot"), FText::FromString(TEXT("MCP Snapshot")), false);
+#endif
+}
+
+FMcpTransactionSnapshot::~FMcpTransactionSnapshot() = default;
+
+void FMcpTransactionSnapshot::Save(UObject* Object)
+{
+#if WITH_EDITOR
+    if (Object && !Saved.Contains(Object))
+    {
+        Saved.Add(Object);
+        Records->SaveObject(Object);
+    }
+#endif
+}
+
+bool FMcpTransactionSnapshot::Restore()
+{
+#if WITH_EDITOR
+    if (Saved.Num() == 0)
+    {
+        return false;
+    }
+    // As during an editor undo: Modify() calls made while restoring are not
+    // recorded anywhere.
+    TGuardValue<bool> Transacting(GIsTransacting, true);
+    Records->Apply();
+    Saved.Empty();
+    return true;
+#else
+    return false;
+#endif
+}
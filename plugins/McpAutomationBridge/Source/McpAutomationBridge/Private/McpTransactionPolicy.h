@@ -0,0 +1,158 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "McpAutomationBridgeSettings.h"
+
+class FMcpBridgeWebSocket;
+class FScopedTransaction;
+class FTransaction;
+
+/**
+ * Undo policy for automation requests and a cap on the editor's undo buffer.
+ *
+ * The policy is per client: set_transaction_policy changes it for the socket
+ * that sent it, and the settings default applies again once that socket
+ * disconnects (a resumed session starts from the default). Requests without
+ * a socket use the default. The cap is editor-wide.
+ *
+ * Full leaves handlers alone: every Modify()/FScopedTransaction they make is
+ * a separate undo entry. Coalesced opens one transaction around each
+ * outermost request, so the handler's own transactions nest into it and the
+ * request undoes as a unit; batches default to one transaction per envelope.
+ * None opens the same transaction and cancels it once the handler returns,
+ * so the changes stay but nothing is kept for undo.
+ *
+ * With a cap, the oldest transactions are evicted once the buffer grows past
+ * it. The editor only trims its buffer when a new transaction begins; the cap
+ * is also enforced between requests, and GetUndoSize walks every record, so
+ * that check only runs when the buffer has changed.
+ *
+ * Game thread only.
+ */
+class FMcpTransactionPolicy
+{
+public:
+    static FMcpTransactionPolicy& Get();
+
+    /** Applies the default policy and cap (MB, 0 = the editor's own limit). */
+    void Configure(EMcpTransactionPolicy InPolicy, int32 UndoBufferMaxMB);
+    /** Restores the editor's undo limit and drops every client's policy. */
+    void Shutdown();
+
+    /** Client's own policy, or the default for null and clients that set none. */
+    EMcpTransactionPolicy GetPolicy(const FMcpBridgeWebSocket* Client = nullptr) const;
+    /** Sets Client's policy; a null client changes the default. */
+    void SetPolicy(const FMcpBridgeWebSocket* Client, EMcpTransactionPolicy InPolicy);
+    /** Forgets Client's policy; called when its socket disconnects. */
+    void ClearClientPolicy(const FMcpBridgeWebSocket* Client);
+    void SetUndoBufferMaxMB(int32 UndoBufferMaxMB);
+
+    static const TCHAR* PolicyName(EMcpTransactionPolicy InPolicy);
+    /** Accepts "full", "coalesced" and "none" (case-insensitive). */
+    static bool ParsePolicy(const FString& Name, EMcpTransactionPolicy& OutPolicy);
+
+    /** Evicts down to the cap when the buffer changed since the last check. */
+    void Tick();
+    /** Evicts oldest-first until the buffer fits the cap; returns the number evicted. */
+    int32 EnforceCap();
+    /** Empties the undo and redo history. */
+    void ResetUndoBuffer(const FString& Reason);
+
+    /**
+     * {policy (Client's), defaultPolicy, clientPolicies, undoBufferBytes,
+     * undoTransactions, redoTransactions, undoBufferCapBytes,
+     * evictedTransactions, evictedBytes, coalescedRequests,
+     * discardedRequests, coalescedAsyncSteps, discardedAsyncSteps}
+     */
+    TSharedPtr<FJsonObject> GetStatsJson(const FMcpBridgeWebSocket* Client = nullptr) const;
+    /** Appends the same figures as mcp_undo_* gauges and counters. */
+    void AppendPrometheusText(FString& Out) const;
+
+private:
+    friend class FMcpRequestTransactionScope;
+
+    void RestoreEditorLimit();
+
+    EMcpTransactionPolicy DefaultPolicy = EMcpTransactionPolicy::Full;
+    TMap<const FMcpBridgeWebSocket*, EMcpTransactionPolicy> ClientPolicies;
+    uint64 CapBytes = 0;
+    /** The editor's MaxMemory before the cap replaced it; 0 when untouched. */
+    uint64 EditorMaxMemory = 0;
+
+    /** Buffer shape at the last cap check. */
+    int32 CheckedNum = INDEX_NONE;
+    int32 CheckedUndoCount = INDEX_NONE;
+
+    uint64 EvictedTransactions = 0;
+    uint64 EvictedBytes = 0;
+    uint64 CoalescedRequests = 0;
+    uint64 DiscardedRequests = 0;
+    /** Tasklet and job steps run on later frames under their request's policy. */
+    uint64 CoalescedAsyncSteps = 0;
+    uint64 DiscardedAsyncSteps = 0;
+};
+
+/**
+ * Applies the requesting client's policy to one dispatched request. Only
+ * outermost requests are wrapped: batch items and nested dispatches join
+ * whatever transaction is already open, and handlers that open and roll back
+ * their own transaction (batch, for_each_region, apply_graph_patch, editor
+ * undo/redo) are left alone.
+ *
+ * Work a handler leaves for later frames runs after this scope has closed;
+ * tasklets and jobs capture the policy when they start and wrap each later
+ * step in the async form of this scope, so under coalesced each step is one
+ * undo entry. Those steps are counted apart from whole requests.
+ */
+class FMcpRequestTransactionScope
+{
+public:
+    FMcpRequestTransactionScope(const FString& Action, const TSharedPtr<FJsonObject>& Payload, bool bOutermost,
+                                const FMcpBridgeWebSocket* Client);
+    /** One tasklet or job step running under a policy captured earlier. */
+    FMcpRequestTransactionScope(const FString& Name, EMcpTransactionPolicy InPolicy);
+    ~FMcpRequestTransactionScope();
+
+    FMcpRequestTransactionScope(const FMcpRequestTransactionScope&) = delete;
+    FMcpRequestTransactionScope& operator=(const FMcpRequestTransactionScope&) = delete;
+
+private:
+    void Open(const FString& Name);
+
+#if WITH_EDITOR
+    TUniquePtr<FScopedTransaction> Transaction;
+#endif
+    EMcpTransactionPolicy Policy = EMcpTransactionPolicy::Full;
+    bool bAsync = false;
+};
+
+/**
+ * Pre-change state of a known set of objects, for rolling back work done
+ * inside another open transaction. The editor refuses to undo while any
+ * transaction is active, so a nested one cannot be undone on its own; this
+ * keeps a private copy of the records instead. The outer transaction still
+ * records the same objects, so undoing it later is unaffected.
+ *
+ * Game thread only.
+ */
+class FMcpTransactionSnapshot
+{
+public:
+    FMcpTransactionSnapshot();
+    ~FMcpTransactionSnapshot();
+
+    FMcpTransactionSnapshot(const FMcpTransactionSnapshot&) = delete;
+    FMcpTransactionSnapshot& operator=(const FMcpTransactionSnapshot&) = delete;
+
+    /** Records Object as it is now; objects already recorded are skipped. */
+    void Save(UObject* Object);
+    /** Puts every recorded object back; false when nothing was recorded. */
+    bool Restore();
+
+private:
+#if WITH_EDITOR
+    TUniquePtr<FTransaction> Records;
+    TSet<const UObject*> Saved;
+#endif
+};
@@ -20,6 +20,18 @@ enum class EMcpLogVerbosity : uint8
     VeryVerbose   UMETA(DisplayName = "VeryVerbose")
 };
 
+/** How automation requests record undo history. */
+UENUM()
+enum class EMcpTransactionPolicy : uint8
+{
+    /** Handlers record their own transactions (one or more per request). */
+    Full          UMETA(DisplayName = "Full Undo"),
+    /** One transaction per request; batches default to one per envelope. */
+    Coalesced     UMETA(DisplayName = "Coalesced"),
+    /** Requests leave nothing in the undo buffer (trusted bulk jobs). */
+    None          UMETA(DisplayName = "None")
+};
+
 UCLASS(config=Game, defaultconfig, meta = (DisplayName = "MCP Automation Bridge"))
 class MCPAUTOMATIONBRIDGE_API UMcpAutomationBridgeSettings : public UDeveloperSettings
 {
@@ -86,6 +98,23 @@ public:
     UPROPERTY(config, EditAnywhere, Category = "Security", meta = (ClampMin = "0"))
     int32 MaxAutomationRequestsPerMinute;
 
+    // Sessions
+    /** Seconds a disconnected client's session is kept for it to resume (bridge_hello "resumeSessionId"); running requests answer on the new socket and responses that completed meanwhile are sent on resume. */
+    UPROPERTY(config, EditAnywhere, Category = "Sessions", meta = (ClampMin = "0.0"))
+    float SessionResumeWindowSeconds;
+
+    /** Seconds a delivered response is kept so a re-sent request with the same requestId is answered from the buffer instead of running again. */
+    UPROPERTY(config, EditAnywhere, Category = "Sessions", meta = (ClampMin = "0.0"))
+    float ResponseReplayWindowSeconds;
+
+    /** Most responses buffered per session; the oldest are dropped first. */
+    UPROPERTY(config, EditAnywhere, Category = "Sessions", meta = (ClampMin = "0"))
+    int32 MaxReplayResponsesPerSession;
+
+    /** Memory budget for buffered responses per session, in MB. */
+    UPROPERTY(config, EditAnywhere, Category = "Sessions", meta = (ClampMin = "0"))
+    int32 MaxReplayBufferMB;
+
     /** Optional runtime log verbosity override exposed via Project Settings. */
 
     UPROPERTY(config, EditAnywhere, Category = "Debug")
@@ -122,14 +151,73 @@ public:
     UPROPERTY(config, EditAnywhere, Category = "Connection")
     int32 ListenBacklog;
 
-    /** How long (seconds) the server socket thread should sleep when no incoming connection; small values reduce CPU but increase latency. If <= 0, engine default will be used. */
+    /** How long (seconds) the server socket thread should sleep when no incoming connection; small values reduce CPU but increase latency. If <= 0, engine default will be used. Not used by the socket reactor. */
     UPROPERTY(config, EditAnywhere, Category = "Connection", meta = (ClampMin = "0.0"))
     float AcceptSleepSeconds;
 
+    /** Serve the listener and all its client connections from one I/O thread (epoll on Linux, poll elsewhere) instead of a worker thread per connection. TLS listeners and engines before 5.7 always use worker threads. Takes effect on the next listen. */
+    UPROPERTY(config, EditAnywhere, Category = "Connection")
+    bool bUseSocketReactor;
+
+    /** Socket reactor only: KB of outgoing frames a connection may have waiting on a client that is not reading. A send past the cap closes the connection (code 1013) instead of going elsewhere; session responses stay buffered until the client resumes. */
+    UPROPERTY(config, EditAnywhere, Category = "Connection", meta = (ClampMin = "64"))
+    int32 MaxSendQueueKB;
+
     /** Frequency, in seconds, for the subsystem ticker. If <= 0, engine default will be used. */
     UPROPERTY(config, EditAnywhere, Category = "Debug", meta = (ClampMin = "0.0"))
     float TickerIntervalSeconds;
 
+    // Request scheduling
+    /** Game-thread time budget (milliseconds) for draining queued automation requests per frame. At least one request is always dispatched. */
+    UPROPERTY(config, EditAnywhere, Category = "Scheduling", meta = (ClampMin = "1.0"))
+    float RequestDrainBudgetMs;
+
+    /** Seconds a queued bulk request may wait before it is served ahead of interactive requests. <= 0 disables aging. */
+    UPROPERTY(config, EditAnywhere, Category = "Scheduling")
+    float BulkRequestAgingSeconds;
+
+    /** Seconds a queued background request may wait before it is served ahead of higher lanes. <= 0 disables aging. */
+    UPROPERTY(config, EditAnywhere, Category = "Scheduling")
+    float BackgroundRequestAgingSeconds;
+
+    /** Game-thread time budget (milliseconds) per frame for bulk handlers (bulk rename/delete, redirector fixup, reports, foliage painting) that run in slices across frames. */
+    UPROPERTY(config, EditAnywhere, Category = "Scheduling", meta = (ClampMin = "1.0"))
+    float BulkTaskBudgetMs;
+
+    /** Maximum number of thread-safe read requests (asset registry queries, log reads) running on worker threads at once. 0 keeps every request on the game thread. */
+    UPROPERTY(config, EditAnywhere, Category = "Scheduling", meta = (ClampMin = "0"))
+    int32 MaxConcurrentReadRequests;
+
+    /** Maximum number of external tools (manage_pipeline run_ubt / run_process) running at once. Further launches are rejected with BUSY. */
+    UPROPERTY(config, EditAnywhere, Category = "Scheduling", meta = (ClampMin = "1"))
+    int32 MaxConcurrentProcesses;
+
+    // Telemetry export
+    /** When set, per-action latency histograms and traffic counters are written here in Prometheus text format (e.g. for a node_exporter textfile collector). Relative paths resolve against the project's Saved directory. */
+    UPROPERTY(config, EditAnywhere, Category = "Telemetry")
+    FString MetricsExportPath;
+
+    /** Seconds between rewrites of MetricsExportPath. */
+    UPROPERTY(config, EditAnywhere, Category = "Telemetry", meta = (ClampMin = "1.0"))
+    float MetricsExportIntervalSeconds;
+
+    /** Seconds between editor health samples (frame and thread times, memory, streaming) served by get_performance_stats, get_memory_stats and perf subscriptions. 0 disables sampling. */
+    UPROPERTY(config, EditAnywhere, Category = "Telemetry", meta = (ClampMin = "0.0"))
+    float PerfSampleIntervalSeconds;
+
+    /** Seconds of editor health samples kept in memory. */
+    UPROPERTY(config, EditAnywhere, Category = "Telemetry", meta = (ClampMin = "10.0"))
+    float PerfHistorySeconds;
+
+    // Undo
+    /** How automation requests record undo history. Full keeps each handler's own transactions, Coalesced folds every request into one transaction, None discards what requests record. Changeable per session with set_transaction_policy. */
+    UPROPERTY(config, EditAnywhere, Category = "Undo")
+    EMcpTransactionPolicy TransactionPolicy;
+
+    /** Cap on the editor undo buffer in MB; the oldest transactions are evicted first when it is exceeded. 0 keeps the editor's own limit. */
+    UPROPERTY(config, EditAnywhere, Category = "Undo", meta = (ClampMin = "0"))
+    int32 UndoBufferMaxMB;
+
     virtual FName GetCategoryName() const override { return FName(TEXT("Plugins")); }
     virtual FText GetSectionText() const override;
 
@@ -6,6 +6,7 @@
 #include "EditorSubsystem.h"
 #include "HAL/CriticalSection.h"
 #include "Templates/SharedPointer.h"
+#include <atomic>
 #include "Engine/DataAsset.h"
 #include "McpAutomationBridgeSubsystem.generated.h"
 
@@ -24,6 +25,22 @@
 
 // Forward declare USkeleton to avoid including heavy animation headers
 class USkeleton;
+class UMaterial;
+// Defined in Private/McpLevelSnapshot.h
+struct FMcpActorSnapshot;
+// Defined in Private/McpAutomationJob.h
+struct FMcpAutomationJob;
+// Defined in Private/McpTasklet.h
+struct FMcpTasklet;
+// Defined in Private/McpAutomationBridge_BatchHandlers.cpp
+struct FMcpBatchRun;
+// Defined in Private/McpResponseStream.h
+class FMcpResponseStream;
+// Defined in Private/McpAutomationBridge_WorldPartitionHandlers.cpp
+struct FMcpWorldRegion;
+struct FMcpRegionTraversal;
+// Defined in Private/McpProcessRunner.h
+class FMcpProcessRunner;
 
 /**
  * Concrete data asset class for MCP inventory/item operations.
@@ -111,6 +128,11 @@ public:
                            const FString &RequestId, const FString &Message,
                            const FString &ErrorCode);
 
+  /** The bridge's connections; used by in-process tools such as the benchmark. */
+  TSharedPtr<class FMcpConnectionManager> GetConnectionManager() const {
+    return ConnectionManager;
+  }
+
   /**
    * Send a progress update message during long-running operations.
    * This keeps the request alive by extending its timeout on the server side.
@@ -123,6 +145,67 @@ public:
   void SendProgressUpdate(const FString &RequestId, float Percent = -1.0f, 
                           const FString &Message = TEXT(""), bool bStillWorking = true);
 
+  /**
+   * Register a long-running job for RequestId. The caller replies with the
+   * returned job's JobId and either sets FMcpAutomationJob::Poll or calls
+   * CompleteAutomationJob from an engine delegate; a "job_completed"
+   * automation_event is then pushed to the requesting socket.
+   *
+   * @param Kind Short job category reported to clients (e.g. "screenshot")
+   * @param TimeoutSeconds Fail the job with JOB_TIMEOUT after this long; <= 0 disables
+   */
+  TSharedPtr<FMcpAutomationJob>
+  BeginAutomationJob(const FString &Kind, const FString &RequestId,
+                     TSharedPtr<FMcpBridgeWebSocket> Socket,
+                     double TimeoutSeconds = 0.0);
+  void CompleteAutomationJob(const FString &JobId, bool bSuccess,
+                             const FString &Message,
+                             const TSharedPtr<FJsonObject> &Result = nullptr,
+                             const FString &ErrorCode = FString());
+  /**
+   * Push an automation_event for a running job to its requester's client
+   * session (buffered for resume), or to the job's socket when it has none.
+   * Returns false if the event was not delivered now.
+   */
+  bool SendAutomationJobEvent(const FMcpAutomationJob &Job,
+                              const TSharedPtr<FJsonObject> &Event);
+  /**
+   * Run a bulk handler's steps within the per-frame tasklet budget. The first
+   * slice runs inline; the remainder resumes on following frames with
+   * progress_update messages until Finish sends the response.
+   */
+  void StartTasklet(TSharedPtr<FMcpTasklet> Tasklet);
+  /**
+   * Stream the array Field of a response in automation_response_chunk
+   * messages when the request payload asked for "stream": true; returns null
+   * otherwise and the handler builds its result as before. Finish with
+   * FinishResponseStream, which sends the terminating automation_response.
+   */
+  TSharedPtr<FMcpResponseStream>
+  BeginResponseStream(const FString &RequestId,
+                      const TSharedPtr<FJsonObject> &Payload,
+                      TSharedPtr<FMcpBridgeWebSocket> RequestingSocket,
+                      const FString &Field);
+  void FinishResponseStream(const TSharedPtr<FMcpResponseStream> &Stream,
+                            TSharedPtr<FMcpBridgeWebSocket> RequestingSocket,
+                            const FString &RequestId, const FString &Message,
+                            const TSharedPtr<FJsonObject> &Result);
+  /** Job that completes on FEditorDelegates::OnLightingBuildSucceeded/Failed. */
+  TSharedPtr<FMcpAutomationJob>
+  BeginLightingBuildJob(const FString &RequestId,
+                        TSharedPtr<FMcpBridgeWebSocket> Socket);
+  /** Job that completes once World's navigation build is no longer in progress. */
+  TSharedPtr<FMcpAutomationJob>
+  BeginNavigationBuildJob(UWorld *World, const FString &RequestId,
+                          TSharedPtr<FMcpBridgeWebSocket> Socket);
+  /**
+   * Job that completes once Material's shader map has finished compiling,
+   * with compile errors, instruction counts and sampler usage as its result.
+   */
+  TSharedPtr<FMcpAutomationJob>
+  BeginMaterialCompileJob(UMaterial *Material, const FString &RequestId,
+                          TSharedPtr<FMcpBridgeWebSocket> Socket);
+
   bool ExecuteEditorCommands(const TArray<FString> &Commands,
                              FString &OutErrorMessage);
 #if MCP_HAS_CONTROLRIG_FACTORY
@@ -137,12 +220,28 @@ public:
                                             const TSharedPtr<FJsonObject> &,
                                             TSharedPtr<FMcpBridgeWebSocket>)>;
 
+  /**
+   * Dispatch traits a handler declares at registration. Handlers (or
+   * individual subActions of a multiplexed tool) marked thread-safe only read
+   * thread-safe engine state such as the asset registry or files on disk and
+   * never touch UObjects, the editor world or transactions; the dispatcher
+   * runs them on a worker thread instead of queueing them for the game
+   * thread.
+   */
+  struct FHandlerTraits {
+    /** Every request to this action may run off the game thread. */
+    bool bThreadSafe = false;
+    /** Lowercase payload subActions that may run off the game thread. */
+    TSet<FString> ThreadSafeSubActions;
+  };
+
   /**
    * Registers a handler for a specific automation action.
    * This allows for O(1) dispatch of automation requests and runtime
    * extensibility.
    */
-  void RegisterHandler(const FString &Action, FAutomationHandler Handler);
+  void RegisterHandler(const FString &Action, FAutomationHandler Handler,
+                       FHandlerTraits Traits = FHandlerTraits());
 
 private:
   // Telemetry structs moved to McpConnectionManager
@@ -159,20 +258,57 @@ private:
   bool bCurrentBlueprintBusyMarked = false;
   bool bCurrentBlueprintBusyScheduled = false;
 
-  // Pending automation request queue (thread-safe). Inbound socket threads
-  // will enqueue requests here; the queue is drained sequentially on the
-  // game thread to ensure deterministic processing order and avoid
-  // reentrancy issues.
-  struct FPendingAutomationRequest {
-    FString RequestId;
-    FString Action;
-    TSharedPtr<FJsonObject> Payload;
-    TSharedPtr<FMcpBridgeWebSocket> RequestingSocket;
-  };
-  TArray<FPendingAutomationRequest> PendingAutomationRequests;
-  FCriticalSection PendingAutomationRequestsMutex;
-  bool bPendingRequestsScheduled = false;
+  // Pending automation request scheduler (thread-safe). Inbound socket
+  // threads enqueue requests here; the game thread drains them one at a
+  // time in priority order, round-robin across clients, within a per-frame
+  // time budget (see McpRequestScheduler.h).
+  TSharedPtr<class FMcpRequestScheduler> RequestScheduler;
+  // Set while a game-thread drain is queued (AsyncTask or next-frame ticker)
+  std::atomic<bool> bPendingRequestsScheduled{false};
+  float RequestDrainBudgetSeconds = 0.008f;
+  void EnqueueAutomationRequest(const FString &RequestId,
+                                const FString &Action,
+                                const TSharedPtr<FJsonObject> &Payload,
+                                TSharedPtr<FMcpBridgeWebSocket> RequestingSocket);
+  void SchedulePendingAutomationRequests(bool bNextFrame);
   void ProcessPendingAutomationRequests();
+  void DispatchAutomationRequest(const FString &RequestId,
+                                 const FString &Action,
+                                 const TSharedPtr<FJsonObject> &Payload,
+                                 TSharedPtr<FMcpBridgeWebSocket> RequestingSocket);
+
+  // Worker dispatch for handlers registered as thread-safe. Read-only
+  // queries run here in parallel while the game thread keeps draining the
+  // scheduler; responses are marshalled back to the game thread.
+  // Worker requests count themselves in before checking the shutdown flag;
+  // Deinitialize sets it and waits for the count to drain, so a running
+  // worker always has a live subsystem.
+  std::atomic<int32> WorkerRequestsInFlight{0};
+  std::atomic<bool> bWorkersShuttingDown{false};
+  int32 MaxWorkerRequests = 4;
+  // Requests each client has queued or running off the worker path, until
+  // their response is sent, and jobs until they finish. A client's reads go
+  // to a worker only while it has none, so they never overtake its own
+  // mutations.
+  struct FClientMutations {
+    TWeakPtr<FMcpBridgeWebSocket> Socket;
+    TArray<FString> Ids;
+  };
+  TMap<const FMcpBridgeWebSocket *, FClientMutations> ClientMutations;
+  mutable FCriticalSection ClientMutationsMutex;
+  void BeginClientMutation(const TSharedPtr<FMcpBridgeWebSocket> &Socket,
+                           const FString &Id);
+  /** Socket may be null to end Id for whichever client holds it (jobs). */
+  void EndClientMutation(const FMcpBridgeWebSocket *Socket, const FString &Id);
+  bool HasClientMutations(const FMcpBridgeWebSocket *Socket);
+  /** Drops per-client state (undo policy) once a client socket is gone. */
+  void HandleClientDisconnected(const FMcpBridgeWebSocket *Socket);
+  bool CanDispatchOnWorker(const FString &Action,
+                           const TSharedPtr<FJsonObject> &Payload) const;
+  void DispatchAutomationRequestOnWorker(
+      const FString &RequestId, const FString &Action,
+      const TSharedPtr<FJsonObject> &Payload,
+      TSharedPtr<FMcpBridgeWebSocket> RequestingSocket);
 
   void RecordAutomationTelemetry(const FString &RequestId, bool bSuccess,
                                  const FString &Message,
@@ -183,6 +319,8 @@ private:
 
   // Action handlers (implemented in separate translation units)
   TMap<FString, FAutomationHandler> AutomationHandlers;
+  // Only actions registered with non-default traits have an entry.
+  TMap<FString, FHandlerTraits> AutomationHandlerTraits;
   void InitializeHandlers();
 
   /**
@@ -457,6 +595,9 @@ private:
   bool HandleGenerateLODs(const FString &RequestId, const FString &Action,
                           const TSharedPtr<FJsonObject> &Payload,
                           TSharedPtr<FMcpBridgeWebSocket> RequestingSocket);
+  bool HandleBatchBuildMeshes(const FString &RequestId, const FString &Action,
+                              const TSharedPtr<FJsonObject> &Payload,
+                              TSharedPtr<FMcpBridgeWebSocket> RequestingSocket);
   bool HandleBakeLightmap(const FString &RequestId, const FString &Action,
                           const TSharedPtr<FJsonObject> &Payload,
                           TSharedPtr<FMcpBridgeWebSocket> RequestingSocket);
@@ -831,6 +972,24 @@ private:
   bool HandleInsightsAction(const FString &RequestId, const FString &Action,
                             const TSharedPtr<FJsonObject> &Payload,
                             TSharedPtr<FMcpBridgeWebSocket> RequestingSocket);
+  bool HandleJobAction(const FString &RequestId, const FString &Action,
+                       const TSharedPtr<FJsonObject> &Payload,
+                       TSharedPtr<FMcpBridgeWebSocket> RequestingSocket);
+  bool HandleRequestQueueStats(const FString &RequestId, const FString &Action,
+                               const TSharedPtr<FJsonObject> &Payload,
+                               TSharedPtr<FMcpBridgeWebSocket> RequestingSocket);
+  bool HandleBridgeMetrics(const FString &RequestId, const FString &Action,
+                           const TSharedPtr<FJsonObject> &Payload,
+                           TSharedPtr<FMcpBridgeWebSocket> RequestingSocket);
+  bool HandleBridgeEcho(const FString &RequestId, const FString &Action,
+                        const TSharedPtr<FJsonObject> &Payload,
+                        TSharedPtr<FMcpBridgeWebSocket> RequestingSocket);
+  bool HandleTransactionPolicy(const FString &RequestId, const FString &Action,
+                               const TSharedPtr<FJsonObject> &Payload,
+                               TSharedPtr<FMcpBridgeWebSocket> RequestingSocket);
+  bool HandleBatchAction(const FString &RequestId, const FString &Action,
+                         const TSharedPtr<FJsonObject> &Payload,
+                         TSharedPtr<FMcpBridgeWebSocket> RequestingSocket);
 
   // 4. Input, UI, Hotkeys & Dialogs
   bool
@@ -842,6 +1001,96 @@ private:
   // Ticker handle for managing the subsystems tick function
   FTSTicker::FDelegateHandle TickHandle;
 
+  // Job registry (McpAutomationBridge_JobHandlers.cpp). Finished jobs are
+  // retained for get_job_status until the oldest are pruned.
+  TMap<FString, TSharedPtr<FMcpAutomationJob>> AutomationJobs;
+  // Per-frame ticker, only registered while jobs are running
+  FTSTicker::FDelegateHandle JobTickHandle;
+  bool TickAutomationJobs(float DeltaTime);
+  void FinishAutomationJob(TSharedPtr<FMcpAutomationJob> Job);
+  void PruneAutomationJobs();
+  void ShutdownAutomationJobs();
+
+  // Frame-budgeted tasklets (McpAutomationBridge_Tasklets.cpp)
+  TArray<TSharedPtr<FMcpTasklet>> ActiveTasklets;
+  int32 TaskletCursor = 0;
+  float TaskletBudgetSeconds = 0.008f;
+  // Per-frame ticker, only registered while tasklets are running
+  FTSTicker::FDelegateHandle TaskletTickHandle;
+  bool TickTasklets(float DeltaTime);
+  void ShutdownTasklets();
+  TArray<TSharedPtr<FJsonValue>> GetTaskletStatusJson() const;
+
+public:
+  using FBatchCompletion =
+      TFunction<void(bool bSuccess, const FString &Message,
+                     const TSharedPtr<FJsonObject> &Result,
+                     const FString &ErrorCode)>;
+
+private:
+  // Batch envelopes (McpAutomationBridge_BatchHandlers.cpp). Items run as
+  // sub-requests "<batchId>#<index>" whose responses are captured here
+  // instead of being sent.
+  TMap<FString, TSharedPtr<FMcpBatchRun>> ActiveBatches;
+  // Item request id -> batch request id, kept until the item answers
+  TMap<FString, FString> BatchItemOwners;
+  // Transactional batches waiting on an item; holds the request queue
+  int32 OpenBatchTransactions = 0;
+  // Per-frame ticker for item timeouts, only registered while batches wait
+  FTSTicker::FDelegateHandle BatchTickHandle;
+  bool StartBatchRun(const FString &RequestId,
+                     const TSharedPtr<FJsonObject> &Payload,
+                     TSharedPtr<FMcpBridgeWebSocket> RequestingSocket,
+                     const TSharedPtr<FJsonObject> &Context,
+                     FBatchCompletion OnComplete, FString &OutError,
+                     const FString &ProgressRequestId = FString());
+  void RunBatch(TSharedPtr<FMcpBatchRun> Run);
+  void FinishBatch(TSharedPtr<FMcpBatchRun> Run);
+  bool CaptureBatchItemResponse(const FString &RequestId, bool bSuccess,
+                                const FString &Message,
+                                const TSharedPtr<FJsonObject> &Result,
+                                const FString &ErrorCode);
+  bool TickBatches(float DeltaTime);
+  void ShutdownBatches();
+
+  // Managed World Partition regions (McpAutomationBridge_WorldPartitionHandlers.cpp).
+  // Loaded regions are tracked by handle and evicted least-recently-used
+  // when the editor's memory use exceeds the budget.
+  TMap<FString, TSharedPtr<FMcpWorldRegion>> WorldRegions;
+  int32 NextWorldRegionId = 1;
+  // 0 = derive from physical memory
+  double WorldRegionBudgetMB = 0.0;
+  int32 MaxWorldRegions = 64;
+  // The running for_each_region traversal, if any
+  TSharedPtr<FMcpRegionTraversal> ActiveRegionTraversal;
+  TSharedPtr<FMcpWorldRegion> LoadWorldRegion(UWorld *World, const FBox &Bounds,
+                                              const FString &Label, bool bPinned,
+                                              FString &OutError,
+                                              bool *bOutCreated = nullptr);
+  bool UnloadWorldRegion(const FString &RegionId);
+  // IncomingRegions: regions about to be added that the count limit must fit
+  void EnforceWorldRegionBudget(int32 IncomingRegions = 0);
+  void ReleaseTraversalRegion(FMcpRegionTraversal &Traversal);
+  void RunRegionTraversalTile(TSharedPtr<FMcpRegionTraversal> Traversal);
+  void CompleteRegionTraversalTile(TSharedPtr<FMcpRegionTraversal> Traversal,
+                                   bool bSuccess, const FString &Message,
+                                   const TSharedPtr<FJsonObject> &Result,
+                                   const FString &ErrorCode);
+  void FinishRegionTraversal(TSharedPtr<FMcpRegionTraversal> Traversal,
+                             const FString &ErrorCode);
+  void ShutdownWorldRegions();
+
+  // External tools launched by manage_pipeline (McpAutomationBridge_PipelineHandlers.cpp),
+  // keyed by the job id that reports their output and exit code.
+  TMap<FString, TSharedPtr<FMcpProcessRunner>> ManagedProcesses;
+  bool StartManagedProcess(const FString &RequestId,
+                           TSharedPtr<FMcpBridgeWebSocket> RequestingSocket,
+                           const FString &Kind, const FString &Executable,
+                           const FString &Arguments,
+                           const FString &WorkingDirectory,
+                           const TSharedPtr<FJsonObject> &Payload,
+                           const TSharedPtr<FJsonObject> &ResponseFields);
+
   // Sequence helpers
   FString ResolveSequencePath(const TSharedPtr<FJsonObject> &Payload);
   TSharedPtr<FJsonObject> EnsureSequenceEntry(const FString &SeqPath);
@@ -910,6 +1159,9 @@ private:
   bool HandleSequenceAddKeyframe(const FString &RequestId,
                                  const TSharedPtr<FJsonObject> &Payload,
                                  TSharedPtr<FMcpBridgeWebSocket> Socket);
+  bool HandleSequenceAddKeyframes(const FString &RequestId,
+                                  const TSharedPtr<FJsonObject> &Payload,
+                                  TSharedPtr<FMcpBridgeWebSocket> Socket);
 
   // Control handlers
   AActor *FindActorByName(const FString &Target);
@@ -1206,8 +1458,10 @@ private:
                              const TSharedPtr<FJsonObject> &Payload,
                              TSharedPtr<FMcpBridgeWebSocket> Socket);
 
-  // Lightweight snapshot cache for automation requests (e.g., create_snapshot)
-  TMap<FString, FTransform> CachedActorSnapshots;
+  // Actor snapshot cache for create_snapshot/restore_snapshot, keyed by
+  // "<actorPath>::<snapshotName>". Backed by files under Saved/ so entries
+  // can be reloaded after a restart.
+  TMap<FString, TSharedPtr<FMcpActorSnapshot>> CachedActorSnapshots;
 
   /** Guards against reentrant automation request processing */
   bool bProcessingAutomationRequest = false;
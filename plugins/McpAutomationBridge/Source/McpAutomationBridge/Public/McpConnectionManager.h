@@ -3,10 +3,12 @@
 #include "CoreMinimal.h"
 #include "Containers/Ticker.h"
 #include "Dom/JsonObject.h"
+#include "McpLatencyHistogram.h"
 #include "Templates/SharedPointer.h"
 #include "Misc/ScopeLock.h"
 
 class FMcpBridgeWebSocket;
+class FMcpSessionStore;
 class UMcpAutomationBridgeSettings;
 
 /**
@@ -15,6 +17,12 @@ class UMcpAutomationBridgeSettings;
  */
 DECLARE_DELEGATE_FourParams(FMcpMessageReceivedCallback, const FString&, const FString&, const TSharedPtr<FJsonObject>&, TSharedPtr<FMcpBridgeWebSocket>);
 
+/**
+ * Delegate for a client socket that closed or failed; runs on the game thread.
+ * The pointer identifies the socket only and must not be dereferenced.
+ */
+DECLARE_DELEGATE_OneParam(FMcpClientDisconnectedCallback, const FMcpBridgeWebSocket*);
+
 /**
  * Manages WebSocket connections for the MCP Automation Bridge.
  * Handles listening, connecting, reconnecting, heartbeats, and message dispatching.
@@ -37,6 +45,15 @@ public:
     void SendAutomationResponse(TSharedPtr<FMcpBridgeWebSocket> TargetSocket, const FString& RequestId, bool bSuccess, const FString& Message, const TSharedPtr<FJsonObject>& Result, const FString& ErrorCode);
     void SendControlMessage(const TSharedPtr<FJsonObject>& Message);
 
+	/** The client session Socket belongs to; empty before bridge_hello. */
+	FString GetClientSessionId(const FMcpBridgeWebSocket* Socket) const;
+	/**
+	 * Sends an event that outlives its request to the client session's current
+	 * socket, buffering it for resume; without a session it goes to Socket
+	 * only. Returns true when it was sent.
+	 */
+	bool SendSessionEvent(const FString& ClientSessionId, TSharedPtr<FMcpBridgeWebSocket> Socket, const FString& Serialized);
+
     /**
      * Send a progress update message to extend request timeout during long operations.
      * Used for heartbeat/keepalive to prevent timeouts while UE is actively working.
@@ -49,15 +66,45 @@ public:
     void SendProgressUpdate(const FString& RequestId, float Percent = -1.0f, const FString& Message = TEXT(""), bool bStillWorking = true);
 
 	void SetOnMessageReceived(FMcpMessageReceivedCallback InCallback);
+	void SetOnClientDisconnected(FMcpClientDisconnectedCallback InCallback);
 
 	// Request tracking helpers
 	int32 GetActiveSocketCount() const;
 	void RegisterRequestSocket(const FString& RequestId, TSharedPtr<FMcpBridgeWebSocket> Socket);
+	/** Drop a request's socket mapping when its response is consumed locally (batch items). */
+	void UnregisterRequestSocket(const FString& RequestId);
+
+	// Streamed responses (see Private/McpResponseStream.h)
+	bool SendResponseChunk(TSharedPtr<FMcpBridgeWebSocket> TargetSocket, const FString& RequestId, int32 Sequence, const FString& Field, const TArray<TSharedPtr<FJsonValue>>& Items);
+	bool IsStreamCancelled(const FString& RequestId) const;
 
 	// Telemetry helpers
 	void StartRequestTelemetry(const FString& RequestId, const FString& Action);
 	void RecordAutomationTelemetry(const FString& RequestId, bool bSuccess, const FString& Message, const FString& ErrorCode);
 
+	/**
+	 * Per-action latency histograms for each request phase (parse, queue,
+	 * handler, serialize, send, total), byte and message counters,
+	 * per-client traffic, session replay/resume counts and socket reactor
+	 * queues. Served by get_bridge_metrics and, when MetricsExportPath is
+	 * set, written as Prometheus text on the ticker.
+	 */
+	TSharedPtr<FJsonObject> GetMetricsJson(const FString& ActionFilter = FString()) const;
+	FString GetMetricsPrometheusText() const;
+	void ResetMetrics();
+
+	/**
+	 * In-process loopback clients (the bridge benchmark). GetLoopbackUrl is the
+	 * ws:// or wss:// address of the first listening socket, empty when the
+	 * bridge is not listening. Each IssueLoopbackKey key is single-use: the
+	 * first client that sends it as "loopbackKey" in bridge_hello consumes it
+	 * and is authenticated without the capability token and exempt from the
+	 * per-socket rate limits until it disconnects or the key is revoked.
+	 */
+	FString GetLoopbackUrl() const;
+	FString IssueLoopbackKey();
+	void RevokeLoopbackKey(const FString& Key);
+
 	bool Tick(float DeltaTime);
 
 private:
@@ -73,14 +120,23 @@ private:
 	void HandleHeartbeat(TSharedPtr<FMcpBridgeWebSocket> Socket);
 
 	void EmitAutomationTelemetrySummaryIfNeeded(double NowSeconds);
+	void ExportMetricsIfNeeded(double NowSeconds);
+	void NoteRequestReceived(const FString& RequestId, const FString& Action, double ReceivedSeconds, double ParseSeconds, int64 RequestBytes);
+	void RecordRequestTimings(const FString& RequestId, bool bSuccess, double ResponseSeconds, double SerializeSeconds, double SendSeconds, int64 ResponseBytes);
+	void RecordTraffic(const FMcpBridgeWebSocket* SocketPtr, bool bOutgoing, int64 Bytes);
 	bool UpdateRateLimit(FMcpBridgeWebSocket* SocketPtr, bool bIncrementMessage, bool bIncrementAutomation, FString& OutReason);
 
 private:
 	TArray<TSharedPtr<FMcpBridgeWebSocket>> ActiveSockets;
 	TMap<FString, TSharedPtr<FMcpBridgeWebSocket>> PendingRequestsToSockets;
 	TSet<FMcpBridgeWebSocket*> AuthenticatedSockets;
+	// Resumable client sessions and their replay buffers (see Private/McpSessionStore.h)
+	TUniquePtr<FMcpSessionStore> Sessions;
+	// Requests whose client sent cancel_stream; guarded by PendingRequestsMutex
+	TSet<FString> CancelledStreams;
 	FTSTicker::FDelegateHandle TickerHandle;
 	FMcpMessageReceivedCallback OnMessageReceived;
+	FMcpClientDisconnectedCallback OnClientDisconnected;
 
 	// Configuration
 	FString EnvListenHost;
@@ -114,7 +170,13 @@ private:
 	struct FAutomationRequestTelemetry
 	{
 		FString Action;
+		// Dispatch to the handler
 		double StartTimeSeconds = 0.0;
+		// Arrival on the socket thread; 0 for requests raised inside the editor
+		double ReceivedSeconds = 0.0;
+		double ParseSeconds = 0.0;
+		int64 RequestBytes = 0;
+		bool bDispatched = false;
 	};
 
 	struct FAutomationActionStats
@@ -125,6 +187,26 @@ private:
 		double TotalFailureDurationSeconds = 0.0;
 		double LastDurationSeconds = 0.0;
 		double LastUpdatedSeconds = 0.0;
+
+		// Phase histograms: parse -> queue -> handler -> serialize -> send, and end to end
+		FMcpLatencyHistogram ParseLatency;
+		FMcpLatencyHistogram QueueLatency;
+		FMcpLatencyHistogram HandlerLatency;
+		FMcpLatencyHistogram SerializeLatency;
+		FMcpLatencyHistogram SendLatency;
+		FMcpLatencyHistogram TotalLatency;
+		int64 RequestBytes = 0;
+		int64 ResponseBytes = 0;
+	};
+
+	struct FSocketTrafficStats
+	{
+		FString Label;
+		double FirstSeenSeconds = 0.0;
+		int64 MessagesIn = 0;
+		int64 MessagesOut = 0;
+		int64 BytesIn = 0;
+		int64 BytesOut = 0;
 	};
 
 	struct FSocketRateState
@@ -137,9 +219,28 @@ private:
 	TMap<FString, FAutomationRequestTelemetry> ActiveRequestTelemetry;
 	TMap<FString, FAutomationActionStats> AutomationActionTelemetry;
 	TMap<FMcpBridgeWebSocket*, FSocketRateState> SocketRateLimits;
+	// Loopback keys and the sockets that presented one; guarded by RateLimitMutex
+	TSet<FString> LoopbackKeys;
+	TMap<FMcpBridgeWebSocket*, FString> LoopbackSockets;
 	double TelemetrySummaryIntervalSeconds = 120.0;
 	double LastTelemetrySummaryLogSeconds = 0.0;
 
+	TMap<const FMcpBridgeWebSocket*, FSocketTrafficStats> SocketTraffic;
+	int32 NextTrafficClientIndex = 1;
+	int64 TotalMessagesIn = 0;
+	int64 TotalMessagesOut = 0;
+	int64 TotalBytesIn = 0;
+	int64 TotalBytesOut = 0;
+	double MetricsStartSeconds = 0.0;
+	FString MetricsExportPath;
+	double MetricsExportIntervalSeconds = 15.0;
+	double LastMetricsExportSeconds = 0.0;
+
 	mutable FCriticalSection PendingRequestsMutex;
 	mutable FCriticalSection RateLimitMutex;
+	// Guards ActiveRequestTelemetry: worker-dispatched requests start their
+	// telemetry from the socket thread.
+	mutable FCriticalSection TelemetryMutex;
+	// Guards AutomationActionTelemetry and the traffic counters
+	mutable FCriticalSection MetricsMutex;
 };
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * Log-bucketed latency histogram in the style of HdrHistogram.
+ *
+ * Buckets split every power of two of microseconds into four, from 1 us up to
+ * roughly 12 days, so any percentile is reported with at most ~19% relative
+ * error in a fixed 640-byte footprint. Count, sum, min and max are exact.
+ * Not synchronized; owners lock around Record and reads.
+ */
+struct MCPAUTOMATIONBRIDGE_API FMcpLatencyHistogram
+{
+    static constexpr int32 BucketsPerOctave = 4;
+    static constexpr int32 NumBuckets = 40 * BucketsPerOctave;
+
+    void Record(double Seconds);
+    void Reset();
+
+    /** Upper bound (seconds) of the bucket holding the given percentile (0..100). */
+    double Percentile(double Percent) const;
+
+    /** Samples in buckets whose upper bound is <= Seconds (Prometheus "le" buckets). */
+    uint64 CountAtOrBelow(double Seconds) const;
+
+    /** count, meanMs, minMs, maxMs, p50Ms, p90Ms, p99Ms, p999Ms. */
+    TSharedPtr<FJsonObject> ToJson() const;
+
+    static double BucketUpperSeconds(int32 Index);
+
+    uint64 Count = 0;
+    double SumSeconds = 0.0;
+    double MinSeconds = 0.0;
+    double MaxSeconds = 0.0;
+    uint32 Buckets[NumBuckets] = {};
+};